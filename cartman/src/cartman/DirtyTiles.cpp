@@ -0,0 +1,105 @@
+//********************************************************************************************
+//*
+//*    This file is part of Cartman.
+//*
+//*    Cartman is free software: you can redistribute it and/or modify it
+//*    under the terms of the GNU General Public License as published by
+//*    the Free Software Foundation, either version 3 of the License, or
+//*    (at your option) any later version.
+//*
+//*    Cartman is distributed in the hope that it will be useful, but
+//*    WITHOUT ANY WARRANTY; without even the implied warranty of
+//*    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+//*    General Public License for more details.
+//*
+//*    You should have received a copy of the GNU General Public License
+//*    along with Cartman.  If not, see <http://www.gnu.org/licenses/>.
+//*
+//*
+//********************************************************************************************
+
+#include "cartman/DirtyTiles.hpp"
+
+namespace Cartman {
+
+TileRect::TileRect() :
+    xmin(0), ymin(0), xmax(-1), ymax(-1)
+{}
+
+TileRect::TileRect(int xmin, int ymin, int xmax, int ymax) :
+    xmin(xmin), ymin(ymin), xmax(xmax), ymax(ymax)
+{}
+
+bool TileRect::empty() const
+{
+    return xmin > xmax || ymin > ymax;
+}
+
+void TileRect::add(int x, int y)
+{
+    if (empty())
+    {
+        *this = TileRect(x, y, x, y);
+        return;
+    }
+    xmin = std::min(xmin, x);
+    ymin = std::min(ymin, y);
+    xmax = std::max(xmax, x);
+    ymax = std::max(ymax, y);
+}
+
+void TileRect::add(const TileRect& other)
+{
+    if (!other.empty())
+    {
+        add(other.xmin, other.ymin);
+        add(other.xmax, other.ymax);
+    }
+}
+
+uint32_t DirtyTiles::trim(uint16_t fx_bits, uint16_t fx_mask)
+{
+    // The mask is never 0, hence trim keys do not collide with the other keys.
+    return (uint32_t(fx_mask) << 16) | fx_bits;
+}
+
+DirtyTiles::DirtyTiles() :
+    _keys()
+{}
+
+void DirtyTiles::clear()
+{
+    _keys.clear();
+}
+
+void DirtyTiles::add(int x, int y)
+{
+    for (auto& key : _keys)
+    {
+        key.second.add(x, y);
+    }
+}
+
+TileRect DirtyTiles::get(uint32_t key, int tileCountX, int tileCountY) const
+{
+    auto it = _keys.find(key);
+    if (it == _keys.end())
+    {
+        return TileRect(0, 0, tileCountX - 1, tileCountY - 1);
+    }
+    const TileRect& dirty = it->second;
+    if (dirty.empty())
+    {
+        return dirty;
+    }
+    TileRect rect(std::max(dirty.xmin - 1, 0), std::max(dirty.ymin - 1, 0),
+                  std::min(dirty.xmax + 1, tileCountX - 1), std::min(dirty.ymax + 1, tileCountY - 1));
+    return rect.empty() ? TileRect() : rect;
+}
+
+void DirtyTiles::clean(uint32_t key)
+{
+    _keys[key] = TileRect();
+}
+
+} // namespace Cartman
@@ -0,0 +1,101 @@
+//********************************************************************************************
+//*
+//*    This file is part of Cartman.
+//*
+//*    Cartman is free software: you can redistribute it and/or modify it
+//*    under the terms of the GNU General Public License as published by
+//*    the Free Software Foundation, either version 3 of the License, or
+//*    (at your option) any later version.
+//*
+//*    Cartman is distributed in the hope that it will be useful, but
+//*    WITHOUT ANY WARRANTY; without even the implied warranty of
+//*    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+//*    General Public License for more details.
+//*
+//*    You should have received a copy of the GNU General Public License
+//*    along with Cartman.  If not, see <http://www.gnu.org/licenses/>.
+//*
+//*
+//********************************************************************************************
+
+#pragma once
+
+#include "egolib/platform.h"
+
+namespace Cartman {
+
+/**
+ * @brief
+ *  A rectangle of tiles. The bounds are inclusive. The rectangle is empty if a minimum exceeds its maximum.
+ */
+struct TileRect
+{
+    int xmin, ymin, xmax, ymax;
+
+    /// Construct an empty rectangle.
+    TileRect();
+    TileRect(int xmin, int ymin, int xmax, int ymax);
+
+    bool empty() const;
+
+    /// Grow this rectangle to contain a tile.
+    void add(int x, int y);
+    /// Grow this rectangle to contain another rectangle.
+    void add(const TileRect& other);
+};
+
+/**
+ * @brief
+ *  Tracks the tiles changed since the derived data of a mesh was last recomputed.
+ * @remark
+ *  Walls, trims and welded edges are derived from the tiles and their neighbours. Each such pass has a key.
+ *  A pass recomputes the tiles dirty for its key and their one-tile neighbourhood, then cleans its key.
+ *  A key which was never cleaned is dirty everywhere, hence the first pass after a load is a full pass.
+ */
+struct DirtyTiles
+{
+    /// The key of the wall heights.
+    static constexpr uint32_t WALLS = 0;
+    /// The key of the welded edges and corners.
+    static constexpr uint32_t EDGES = 1;
+    /// Get the key of a trim pass.
+    static uint32_t trim(uint16_t fx_bits, uint16_t fx_mask);
+
+    DirtyTiles();
+
+    /**
+     * @brief
+     *  Mark all tiles dirty for all keys.
+     */
+    void clear();
+
+    /**
+     * @brief
+     *  Mark a tile dirty for all keys.
+     */
+    void add(int x, int y);
+
+    /**
+     * @brief
+     *  Get the tiles a pass must recompute.
+     * @param key
+     *  the key of the pass
+     * @param tileCountX, tileCountY
+     *  the size, in tiles, of the mesh
+     * @return
+     *  the dirty tiles and their one-tile neighbourhood, clamped to the mesh
+     */
+    TileRect get(uint32_t key, int tileCountX, int tileCountY) const;
+
+    /**
+     * @brief
+     *  Mark all tiles clean for a key.
+     */
+    void clean(uint32_t key);
+
+private:
+    /// The dirty tiles of the keys which were cleaned at least once.
+    std::unordered_map<uint32_t, TileRect> _keys;
+};
+
+} // namespace Cartman
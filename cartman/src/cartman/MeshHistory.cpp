@@ -0,0 +1,280 @@
+//********************************************************************************************
+//*
+//*    This file is part of Cartman.
+//*
+//*    Cartman is free software: you can redistribute it and/or modify it
+//*    under the terms of the GNU General Public License as published by
+//*    the Free Software Foundation, either version 3 of the License, or
+//*    (at your option) any later version.
+//*
+//*    Cartman is distributed in the hope that it will be useful, but
+//*    WITHOUT ANY WARRANTY; without even the implied warranty of
+//*    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+//*    General Public License for more details.
+//*
+//*    You should have received a copy of the GNU General Public License
+//*    along with Cartman.  If not, see <http://www.gnu.org/licenses/>.
+//*
+//*
+//********************************************************************************************
+
+#include "cartman/MeshHistory.hpp"
+#include "cartman/cartman_map.h"
+
+namespace Cartman {
+
+size_t MeshHistory::Edit::getMemoryUsage() const
+{
+    return vertexChunks.size() * VERTEX_CHUNK_SIZE * sizeof(mpd_vertex_t)
+         + tileChunks.size() * TILE_CHUNK_SIZE * sizeof(cartman_mpd_tile_t);
+}
+
+MeshHistory::MeshHistory() :
+    _undo(), _redo(), _current(), _depth(0), _frame(0),
+    _budget(DEFAULT_MEMORY_BUDGET), _usage(0)
+{}
+
+void MeshHistory::clear()
+{
+    _undo.clear();
+    _redo.clear();
+    _current = nullptr;
+    _depth = 0;
+    _usage = 0;
+}
+
+void MeshHistory::setMemoryBudget(size_t budget)
+{
+    _budget = budget;
+    enforceBudget();
+}
+
+size_t MeshHistory::getMemoryBudget() const
+{
+    return _budget;
+}
+
+size_t MeshHistory::getMemoryUsage() const
+{
+    return _usage;
+}
+
+void MeshHistory::nextFrame()
+{
+    _frame++;
+}
+
+void MeshHistory::begin(const cartman_mpd_t& mesh, const std::string& name, bool coalesce)
+{
+    if (0 < _depth++)
+    {
+        return;
+    }
+    if (coalesce && _redo.empty() && !_undo.empty())
+    {
+        Edit& last = _undo.back();
+        if (last.coalesce && last.name == name && last.frame + 1 >= _frame)
+        {
+            _usage -= last.getMemoryUsage();
+            _current.reset(new Edit(std::move(last)));
+            _undo.pop_back();
+            return;
+        }
+    }
+    _current.reset(new Edit());
+    _current->name = name;
+    _current->coalesce = coalesce;
+    _current->frame = _frame;
+    _current->vrt_free = mesh.vrt_free;
+    _current->vrt_at = mesh.vrt_at;
+}
+
+void MeshHistory::commit(const cartman_mpd_t& mesh)
+{
+    if (0 == _depth || 0 < --_depth)
+    {
+        return;
+    }
+    std::unique_ptr<Edit> edit = std::move(_current);
+    discardUnchanged(mesh, *edit);
+    if (edit->vertexChunks.empty() && edit->tileChunks.empty())
+    {
+        return;
+    }
+    edit->frame = _frame;
+    // A new edit makes the undone edits unreachable.
+    for (const auto& e : _redo)
+    {
+        _usage -= e.getMemoryUsage();
+    }
+    _redo.clear();
+    _usage += edit->getMemoryUsage();
+    _undo.push_back(std::move(*edit));
+    enforceBudget();
+}
+
+bool MeshHistory::isRecording() const
+{
+    return nullptr != _current;
+}
+
+void MeshHistory::touchVertex(const cartman_mpd_t& mesh, int ivrt)
+{
+    if (!_current || !CART_VALID_VERTEX_RANGE(ivrt))
+    {
+        return;
+    }
+    const uint32_t chunk = ivrt / VERTEX_CHUNK_SIZE;
+    if (_current->vertexChunks.count(chunk))
+    {
+        return;
+    }
+    auto begin = mesh.vrt2.begin() + chunk * VERTEX_CHUNK_SIZE;
+    _current->vertexChunks[chunk].assign(begin, begin + VERTEX_CHUNK_SIZE);
+}
+
+void MeshHistory::touchTile(const cartman_mpd_t& mesh, int ifan)
+{
+    if (!_current || !VALID_MPD_TILE_RANGE(ifan))
+    {
+        return;
+    }
+    const uint32_t chunk = ifan / TILE_CHUNK_SIZE;
+    if (!_current->tileChunks.count(chunk))
+    {
+        auto begin = mesh.fan2.begin() + chunk * TILE_CHUNK_SIZE;
+        _current->tileChunks[chunk].assign(begin, begin + TILE_CHUNK_SIZE);
+    }
+    // Touch the vertices of the tile.
+    uint32_t ivrt = mesh.fan2[ifan].vrtstart;
+    for (size_t cnt = 0; cnt < MAP_FAN_VERTICES_MAX && CART_VALID_VERTEX_RANGE(ivrt); ++cnt, ivrt = mesh.vrt2[ivrt].next)
+    {
+        touchVertex(mesh, ivrt);
+    }
+}
+
+void MeshHistory::discardUnchanged(const cartman_mpd_t& mesh, Edit& edit)
+{
+    for (auto it = edit.vertexChunks.begin(); it != edit.vertexChunks.end();)
+    {
+        auto current = mesh.vrt2.begin() + it->first * VERTEX_CHUNK_SIZE;
+        if (std::equal(it->second.begin(), it->second.end(), current,
+                       [](const mpd_vertex_t& a, const mpd_vertex_t& b) { return a.equals(b); }))
+        {
+            it = edit.vertexChunks.erase(it);
+        }
+        else
+        {
+            ++it;
+        }
+    }
+    for (auto it = edit.tileChunks.begin(); it != edit.tileChunks.end();)
+    {
+        auto current = mesh.fan2.begin() + it->first * TILE_CHUNK_SIZE;
+        if (std::equal(it->second.begin(), it->second.end(), current,
+                       [](const cartman_mpd_tile_t& a, const cartman_mpd_tile_t& b) { return a.equals(b); }))
+        {
+            it = edit.tileChunks.erase(it);
+        }
+        else
+        {
+            ++it;
+        }
+    }
+}
+
+void MeshHistory::swap(cartman_mpd_t& mesh, Edit& edit)
+{
+    for (auto& chunk : edit.vertexChunks)
+    {
+        const uint32_t base = chunk.first * VERTEX_CHUNK_SIZE;
+        for (size_t i = 0; i < VERTEX_CHUNK_SIZE; ++i)
+        {
+            const uint32_t ivrt = base + i;
+            mpd_vertex_t& vertex = mesh.vrt2[ivrt];
+            // Keep the spatial index current and mark the tiles of the vertex dirty.
+            mesh.vrt_index.remove(ivrt, vertex.x, vertex.y);
+            if (VERTEXUNUSED != vertex.a)
+            {
+                mesh.mark_dirty_xy(vertex.x, vertex.y);
+            }
+            std::swap(vertex, chunk.second[i]);
+            if (VERTEXUNUSED != vertex.a)
+            {
+                mesh.vrt_index.move(ivrt, vertex.x, vertex.y, vertex.x, vertex.y);
+                mesh.mark_dirty_xy(vertex.x, vertex.y);
+            }
+        }
+    }
+    for (auto& chunk : edit.tileChunks)
+    {
+        std::swap_ranges(chunk.second.begin(), chunk.second.end(), mesh.fan2.begin() + chunk.first * TILE_CHUNK_SIZE);
+        const uint32_t tileCountX = mesh.info.getTileCountX();
+        for (uint32_t ifan = chunk.first * TILE_CHUNK_SIZE; ifan < (chunk.first + 1) * TILE_CHUNK_SIZE && ifan < mesh.info.getTileCount(); ++ifan)
+        {
+            mesh.dirty.add(ifan % tileCountX, ifan / tileCountX);
+        }
+    }
+    std::swap(mesh.vrt_free, edit.vrt_free);
+    std::swap(mesh.vrt_at, edit.vrt_at);
+    // The free list might refer to vertices used again, free vertices are found by the allocator.
+    mesh.vrt_free_list.clear();
+}
+
+bool MeshHistory::canUndo() const
+{
+    return !_undo.empty() && !_current;
+}
+
+bool MeshHistory::canRedo() const
+{
+    return !_redo.empty() && !_current;
+}
+
+bool MeshHistory::undo(cartman_mpd_t& mesh)
+{
+    if (!canUndo())
+    {
+        return false;
+    }
+    _redo.push_back(std::move(_undo.back()));
+    _undo.pop_back();
+    swap(mesh, _redo.back());
+    return true;
+}
+
+bool MeshHistory::redo(cartman_mpd_t& mesh)
+{
+    if (!canRedo())
+    {
+        return false;
+    }
+    _undo.push_back(std::move(_redo.back()));
+    _redo.pop_back();
+    swap(mesh, _undo.back());
+    // Do not merge later edits into a redone edit.
+    _undo.back().coalesce = false;
+    return true;
+}
+
+void MeshHistory::enforceBudget()
+{
+    while (_usage > _budget && _undo.size() > 1)
+    {
+        _usage -= _undo.front().getMemoryUsage();
+        _undo.pop_front();
+    }
+}
+
+MeshEdit::MeshEdit(cartman_mpd_t& mesh, const std::string& name, bool coalesce) :
+    _mesh(mesh)
+{
+    _mesh.history.begin(_mesh, name, coalesce);
+}
+
+MeshEdit::~MeshEdit()
+{
+    _mesh.history.commit(_mesh);
+}
+
+} // namespace Cartman
@@ -0,0 +1,190 @@
+//********************************************************************************************
+//*
+//*    This file is part of Cartman.
+//*
+//*    Cartman is free software: you can redistribute it and/or modify it
+//*    under the terms of the GNU General Public License as published by
+//*    the Free Software Foundation, either version 3 of the License, or
+//*    (at your option) any later version.
+//*
+//*    Cartman is distributed in the hope that it will be useful, but
+//*    WITHOUT ANY WARRANTY; without even the implied warranty of
+//*    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+//*    General Public License for more details.
+//*
+//*    You should have received a copy of the GNU General Public License
+//*    along with Cartman.  If not, see <http://www.gnu.org/licenses/>.
+//*
+//*
+//********************************************************************************************
+
+#pragma once
+
+#include "cartman/Vertex.hpp"
+#include "cartman/Tile.hpp"
+
+struct cartman_mpd_t;
+
+namespace Cartman {
+
+/**
+ * @brief
+ *  The undo/redo history of a mesh.
+ * @remark
+ *  The vertices and the tiles of the mesh are split into fixed-size chunks. An edit stores a copy of
+ *  each chunk it touches, taken before the chunk is first written to (copy-on-write). Undoing or
+ *  redoing an edit swaps its copies with the chunks of the mesh, hence it costs time and memory
+ *  proportional to the number of chunks the edit changed rather than to the size of the mesh.
+ * @remark
+ *  Edits are recorded by MeshEdit. Whoever writes to a vertex or a tile during an edit touches it
+ *  first, usually by cartman_mpd_t::touch_vertex or cartman_mpd_t::touch_tile. The vertex allocator
+ *  and cartman_mpd_t::set_vertex_xy touch the vertices they write to.
+ */
+struct MeshHistory
+{
+    /// The number of vertices in a chunk.
+    static constexpr size_t VERTEX_CHUNK_SIZE = 1024;
+    /// The number of tiles in a chunk.
+    static constexpr size_t TILE_CHUNK_SIZE = 256;
+    /// The default memory budget, in Bytes, of the history.
+    static constexpr size_t DEFAULT_MEMORY_BUDGET = 64 * 1024 * 1024;
+
+    MeshHistory();
+
+    /**
+     * @brief
+     *  Remove all edits.
+     */
+    void clear();
+
+    /**
+     * @brief
+     *  Set the memory budget of this history.
+     * @param budget
+     *  the budget, in Bytes. The oldest edits are removed while the history exceeds its budget.
+     *  The most recent edit is kept regardless of the budget.
+     */
+    void setMemoryBudget(size_t budget);
+    size_t getMemoryBudget() const;
+
+    /**
+     * @brief
+     *  Get the memory used by the edits in this history.
+     * @return
+     *  the memory, in Bytes
+     */
+    size_t getMemoryUsage() const;
+
+    /**
+     * @brief
+     *  Advance the frame counter.
+     * @remark
+     *  Edits which coalesce are merged only if they happen in consecutive frames, e.g. while dragging.
+     */
+    void nextFrame();
+
+    /**
+     * @brief
+     *  Begin recording an edit.
+     * @param name
+     *  the name of the edit
+     * @param coalesce
+     *  if @a true and the most recent edit has the same name, also coalesced and happened in this or the
+     *  previous frame, then this edit is merged into the most recent edit
+     * @remark
+     *  Nested edits are part of the outermost edit.
+     */
+    void begin(const cartman_mpd_t& mesh, const std::string& name, bool coalesce);
+
+    /**
+     * @brief
+     *  End recording an edit.
+     */
+    void commit(const cartman_mpd_t& mesh);
+
+    /**
+     * @brief
+     *  Get if an edit is being recorded.
+     */
+    bool isRecording() const;
+
+    /**
+     * @brief
+     *  Touch a vertex before it is written to.
+     */
+    void touchVertex(const cartman_mpd_t& mesh, int ivrt);
+
+    /**
+     * @brief
+     *  Touch a tile and its vertices before they are written to.
+     */
+    void touchTile(const cartman_mpd_t& mesh, int ifan);
+
+    bool canUndo() const;
+    bool canRedo() const;
+
+    /**
+     * @brief
+     *  Undo the most recent edit.
+     * @return
+     *  @a true if an edit was undone, @a false otherwise
+     */
+    bool undo(cartman_mpd_t& mesh);
+
+    /**
+     * @brief
+     *  Redo the most recently undone edit.
+     * @return
+     *  @a true if an edit was redone, @a false otherwise
+     */
+    bool redo(cartman_mpd_t& mesh);
+
+private:
+    struct Edit
+    {
+        std::string name;
+        bool coalesce;
+        uint64_t frame;
+        /// The vertex allocator state.
+        uint32_t vrt_free, vrt_at;
+        /// The copies of the vertex chunks by chunk index.
+        std::unordered_map<uint32_t, std::vector<mpd_vertex_t>> vertexChunks;
+        /// The copies of the tile chunks by chunk index.
+        std::unordered_map<uint32_t, std::vector<cartman_mpd_tile_t>> tileChunks;
+
+        /// Get the memory, in Bytes, used by the copies.
+        size_t getMemoryUsage() const;
+    };
+
+    /// Swap the copies of an edit with the chunks of the mesh.
+    static void swap(cartman_mpd_t& mesh, Edit& edit);
+    /// Discard the copies of the chunks which did not change.
+    static void discardUnchanged(const cartman_mpd_t& mesh, Edit& edit);
+    /// Remove the oldest edits while the history exceeds its budget.
+    void enforceBudget();
+
+    std::deque<Edit> _undo;
+    std::vector<Edit> _redo;
+    std::unique_ptr<Edit> _current;
+    int _depth;
+    uint64_t _frame;
+    size_t _budget;
+    size_t _usage;
+};
+
+/**
+ * @brief
+ *  Records an edit of a mesh during its lifetime.
+ */
+struct MeshEdit
+{
+    MeshEdit(cartman_mpd_t& mesh, const std::string& name, bool coalesce = false);
+    ~MeshEdit();
+    MeshEdit(const MeshEdit&) = delete;
+    MeshEdit& operator=(const MeshEdit&) = delete;
+
+private:
+    cartman_mpd_t& _mesh;
+};
+
+} // namespace Cartman
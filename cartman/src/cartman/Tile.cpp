@@ -36,6 +36,10 @@ void cartman_mpd_tile_t::reset() {
 	vrtstart = MAP_FAN_ENTRIES_MAX;
 }
 
+bool cartman_mpd_tile_t::equals(const cartman_mpd_tile_t& other) const {
+	return type == other.type && fx == other.fx && tx_bits == other.tx_bits && twist == other.twist && vrtstart == other.vrtstart;
+}
+
 bool cartman_mpd_tile_t::isPassableFloor() const
 {
 	static const uint8_t bits = MAPFX_WALL | MAPFX_IMPASS;
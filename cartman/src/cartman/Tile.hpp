@@ -86,6 +86,12 @@ struct cartman_mpd_tile_t
 	 */
 	void reset();
 
+	/**
+	 * @brief
+	 *  Get if this tile has the same values as another tile.
+	 */
+	bool equals(const cartman_mpd_tile_t& other) const;
+
 	/**
 	 * @brief
 	 *  Get if this tile has its fan rendering turned off.
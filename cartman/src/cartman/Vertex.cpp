@@ -40,4 +40,8 @@ void Cartman::mpd_vertex_t::reset() {
 	next = CHAINEND;
 }
 
+bool mpd_vertex_t::equals(const mpd_vertex_t& other) const {
+	return next == other.next && x == other.x && y == other.y && z == other.z && a == other.a;
+}
+
 } // namespace Cartman
\ No newline at end of file
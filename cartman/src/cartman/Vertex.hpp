@@ -79,5 +79,11 @@ struct mpd_vertex_t {
 	 */
 	void reset();
 
+	/**
+	 * @brief
+	 *  Get if this vertex has the same values as another vertex.
+	 */
+	bool equals(const mpd_vertex_t& other) const;
+
 };
 } // namespace Cartman
\ No newline at end of file
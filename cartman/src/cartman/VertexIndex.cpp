@@ -0,0 +1,101 @@
+//********************************************************************************************
+//*
+//*    This file is part of Cartman.
+//*
+//*    Cartman is free software: you can redistribute it and/or modify it
+//*    under the terms of the GNU General Public License as published by
+//*    the Free Software Foundation, either version 3 of the License, or
+//*    (at your option) any later version.
+//*
+//*    Cartman is distributed in the hope that it will be useful, but
+//*    WITHOUT ANY WARRANTY; without even the implied warranty of
+//*    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+//*    General Public License for more details.
+//*
+//*    You should have received a copy of the GNU General Public License
+//*    along with Cartman.  If not, see <http://www.gnu.org/licenses/>.
+//*
+//*
+//********************************************************************************************
+
+#include "cartman/VertexIndex.hpp"
+#include "egolib/FileFormats/map_file.h"
+#include "egolib/Mesh/Info.hpp"
+#include "egolib/Math/Math.hpp"
+
+namespace Cartman {
+
+VertexIndex::VertexIndex() :
+    _countX((MAP_TILE_MAX_X + CELL_TILES - 1) / CELL_TILES),
+    _countY((MAP_TILE_MAX_Y + CELL_TILES - 1) / CELL_TILES),
+    _cells(_countX * _countY)
+{}
+
+void VertexIndex::clear()
+{
+    for (auto& cell : _cells)
+    {
+        cell.clear();
+    }
+}
+
+int VertexIndex::getCellX(float x) const
+{
+    const int cellX = std::floor(x / (CELL_TILES * Info<float>::Grid::Size()));
+    return Ego::Math::constrain(cellX, 0, _countX - 1);
+}
+
+int VertexIndex::getCellY(float y) const
+{
+    const int cellY = std::floor(y / (CELL_TILES * Info<float>::Grid::Size()));
+    return Ego::Math::constrain(cellY, 0, _countY - 1);
+}
+
+std::vector<uint32_t>& VertexIndex::getCell(float x, float y)
+{
+    return _cells[getCellX(x) + getCellY(y) * _countX];
+}
+
+void VertexIndex::move(uint32_t vertex, float oldX, float oldY, float newX, float newY)
+{
+    std::vector<uint32_t>& oldCell = getCell(oldX, oldY);
+    std::vector<uint32_t>& newCell = getCell(newX, newY);
+    auto it = std::find(oldCell.begin(), oldCell.end(), vertex);
+    if (&oldCell == &newCell && it != oldCell.end())
+    {
+        return;
+    }
+    if (it != oldCell.end())
+    {
+        *it = oldCell.back();
+        oldCell.pop_back();
+    }
+    newCell.push_back(vertex);
+}
+
+void VertexIndex::remove(uint32_t vertex, float x, float y)
+{
+    std::vector<uint32_t>& cell = getCell(x, y);
+    auto it = std::find(cell.begin(), cell.end(), vertex);
+    if (it != cell.end())
+    {
+        *it = cell.back();
+        cell.pop_back();
+    }
+}
+
+void VertexIndex::find(float xmin, float ymin, float xmax, float ymax, std::vector<uint32_t>& vertices) const
+{
+    const int x0 = getCellX(xmin), x1 = getCellX(xmax),
+              y0 = getCellY(ymin), y1 = getCellY(ymax);
+    for (int y = y0; y <= y1; ++y)
+    {
+        for (int x = x0; x <= x1; ++x)
+        {
+            const std::vector<uint32_t>& cell = _cells[x + y * _countX];
+            vertices.insert(vertices.end(), cell.begin(), cell.end());
+        }
+    }
+}
+
+} // namespace Cartman
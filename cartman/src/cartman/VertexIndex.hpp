@@ -0,0 +1,100 @@
+//********************************************************************************************
+//*
+//*    This file is part of Cartman.
+//*
+//*    Cartman is free software: you can redistribute it and/or modify it
+//*    under the terms of the GNU General Public License as published by
+//*    the Free Software Foundation, either version 3 of the License, or
+//*    (at your option) any later version.
+//*
+//*    Cartman is distributed in the hope that it will be useful, but
+//*    WITHOUT ANY WARRANTY; without even the implied warranty of
+//*    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+//*    General Public License for more details.
+//*
+//*    You should have received a copy of the GNU General Public License
+//*    along with Cartman.  If not, see <http://www.gnu.org/licenses/>.
+//*
+//*
+//********************************************************************************************
+
+#pragma once
+
+#include "egolib/platform.h"
+
+namespace Cartman {
+
+/**
+ * @brief
+ *  A uniform grid over the vertices of a mesh.
+ * @remark
+ *  The grid maps cells to the vertices with their x- and y-coordinates in the cell.
+ *  Positions outside of the grid are clamped to the border cells.
+ *  The grid does not store the positions of the vertices: Whoever changes the position of
+ *  a vertex informs the grid about its old and its new position.
+ */
+struct VertexIndex
+{
+    /// The size, in tiles, of a cell along the x- and y-axes.
+    static constexpr int CELL_TILES = 4;
+
+    /**
+     * @brief
+     *  Construct this index for a mesh of the maximum size.
+     */
+    VertexIndex();
+
+    /**
+     * @brief
+     *  Remove all vertices from this index.
+     */
+    void clear();
+
+    /**
+     * @brief
+     *  Update this index after the position of a vertex changed.
+     * @param vertex
+     *  the vertex index
+     * @param oldX, oldY
+     *  the old position of the vertex, ignored if the vertex is not in this index
+     * @param newX, newY
+     *  the new position of the vertex
+     * @post
+     *  The vertex is in this index.
+     */
+    void move(uint32_t vertex, float oldX, float oldY, float newX, float newY);
+
+    /**
+     * @brief
+     *  Remove a vertex from this index.
+     * @param vertex
+     *  the vertex index
+     * @param x, y
+     *  the position of the vertex
+     */
+    void remove(uint32_t vertex, float x, float y);
+
+    /**
+     * @brief
+     *  Get the vertices in the cells overlapping a rectangle.
+     * @param xmin, ymin, xmax, ymax
+     *  the rectangle
+     * @param vertices
+     *  the vertices are appended to this list
+     * @remark
+     *  The vertices are candidates: Their positions must be tested against the rectangle.
+     */
+    void find(float xmin, float ymin, float xmax, float ymax, std::vector<uint32_t>& vertices) const;
+
+private:
+    int getCellX(float x) const;
+    int getCellY(float y) const;
+    std::vector<uint32_t>& getCell(float x, float y);
+
+    /// The number of cells along the x- and y-axes.
+    int _countX, _countY;
+    /// The vertices in each cell.
+    std::vector<std::vector<uint32_t>> _cells;
+};
+
+} // namespace Cartman
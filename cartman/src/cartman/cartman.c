@@ -633,6 +633,7 @@ int vertex_calc_vrta( cartman_mpd_t * pmesh, uint32_t vert )
     // Bounds
     if ( newa < -ambicut ) newa = -ambicut;
     newa += ambi;
+    pmesh->touch_vertex( vert );
     pmesh->vrt2[vert].a = Ego::Math::constrain( newa, 1, 255 );
 
     // Edge fade
@@ -682,6 +683,10 @@ void mesh_calc_vrta(cartman_mpd_t *self)
 {
     if (NULL == self) self = &mesh;
 
+    // The lighting is recalculated every frame while it is being edited:
+    // Coalesce these edits and mark only the tiles whose lighting changed.
+    Cartman::MeshEdit edit(*self, "calculate lighting", true);
+    Cartman::DerivedPass pass(*self);
     for (auto it = self->info.begin(); it != self->info.end(); ++it) {
             int fan = self->get_ifan(*it);
 
@@ -1293,6 +1298,21 @@ bool cartman_check_keys( const char * modname, cartman_mpd_t * pmesh )
 
     if ( NULL == pmesh ) pmesh = &mesh;
 
+    // Undo and redo. Ctrl+Z and Ctrl+Y must not trigger the z and y actions.
+    if ( CART_KEYMOD( KMOD_CTRL ) && ( CART_KEYDOWN( SDLK_z ) || CART_KEYDOWN( SDLK_y ) ) )
+    {
+        if ( CART_KEYDOWN( SDLK_y ) || CART_KEYMOD( KMOD_SHIFT ) )
+        {
+            pmesh->history.redo(*pmesh);
+        }
+        else
+        {
+            pmesh->history.undo(*pmesh);
+        }
+        Input::get()._keyboard.delay = KEYDELAY;
+        return true;
+    }
+
     // Hurt
     if ( CART_KEYDOWN( SDLK_h ) )
     {
@@ -1892,6 +1912,9 @@ void cartman_create_mesh( cartman_mpd_t * pmesh )
     }
 
     fix_mesh( pmesh != nullptr ? *pmesh : mesh );
+
+    // A new mesh can not be undone.
+    ( pmesh != nullptr ? *pmesh : mesh ).history.clear();
 }
 
 //--------------------------------------------------------------------------------------------
@@ -1936,6 +1959,7 @@ void cartman_check_input( const char * modulename, cartman_mpd_t * pmesh )
     debugy = -1;
 
     Cartman::Input::get().checkInput();
+    pmesh->history.nextFrame();
 
     cartman_check_mouse( modulename, pmesh );
     cartman_check_keys( modulename, pmesh );
@@ -25,6 +25,7 @@
 #include "cartman/cartman_math.h"
 #include "cartman/View.hpp"
 #include "egolib/FileFormats/Globals.hpp"
+#include "egolib/Core/ThreadPool.hpp"
 
 //--------------------------------------------------------------------------------------------
 
@@ -71,34 +72,180 @@ int dist_from_edge( cartman_mpd_t& mesh, Index2D index2d )
 
 //--------------------------------------------------------------------------------------------
 
-void fix_corners( cartman_mpd_t& mesh )
+namespace {
+
+/// The minimum number of rows in a band of a banded pass.
+const int BAND_ROWS_MIN = 16;
+
+ThreadPool& get_band_pool()
+{
+    static ThreadPool pool(std::max(1u, std::thread::hardware_concurrency()));
+    return pool;
+}
+
+/**
+ * @brief
+ *  Invoke a function for the tiles in a rectangle.
+ * @remark
+ *  The rows of the rectangle are split into bands which are processed in parallel. The function must only
+ *  read from the neighbours of a tile and only write to the tile and its vertices, which must be touched beforehand.
+ */
+template <typename Function>
+void for_each_tile_banded(const Cartman::TileRect& rect, Function function)
+{
+    if (rect.empty()) return;
+
+    const int rows = rect.ymax - rect.ymin + 1;
+    const int bands = std::min(int(std::thread::hardware_concurrency()), rows / BAND_ROWS_MIN);
+    if (bands < 2)
+    {
+        for (int y = rect.ymin; y <= rect.ymax; ++y)
+        {
+            for (int x = rect.xmin; x <= rect.xmax; ++x)
+            {
+                function(Index2D(x, y));
+            }
+        }
+        return;
+    }
+
+    std::vector<std::future<void>> futures;
+    for (int band = 0; band < bands; ++band)
+    {
+        const int ymin = rect.ymin + rows * band / bands;
+        const int ymax = rect.ymin + rows * (band + 1) / bands - 1;
+        futures.push_back(get_band_pool().submit([&rect, &function, ymin, ymax]()
+        {
+            for (int y = ymin; y <= ymax; ++y)
+            {
+                for (int x = rect.xmin; x <= rect.xmax; ++x)
+                {
+                    function(Index2D(x, y));
+                }
+            }
+        }));
+    }
+    for (auto& future : futures)
+    {
+        future.get();
+    }
+}
+
+/// Grow a rectangle by one tile in each direction.
+Cartman::TileRect grow(const Cartman::TileRect& rect)
+{
+    return Cartman::TileRect(rect.xmin - 1, rect.ymin - 1, rect.xmax + 1, rect.ymax + 1);
+}
+
+#if defined(CARTMAN_DEBUG)
+/**
+ * @brief
+ *  Checks a pass which recomputes only the dirty tiles against the same pass recomputing all tiles.
+ * @remark
+ *  On construction, the pass is run on a copy of the mesh on which all tiles are dirty. On destruction,
+ *  i.e. after the pass ran on the mesh, a warning is logged for each tile the results differ in.
+ */
+struct IncrementalCheck
+{
+    template <typename Pass>
+    IncrementalCheck(cartman_mpd_t& mesh, const char *name, Pass pass) :
+        _mesh(mesh), _name(name), _copy()
+    {
+        // The copy runs the same pass, which must not check itself.
+        static bool checking = false;
+        if (checking) return;
+        checking = true;
+        _copy = std::make_unique<cartman_mpd_t>();
+        _copy->vrt_free = mesh.vrt_free;
+        _copy->vrt_at = mesh.vrt_at;
+        _copy->vrt_free_list = mesh.vrt_free_list;
+        _copy->vrt2 = mesh.vrt2;
+        _copy->vrt_index = mesh.vrt_index;
+        _copy->info = mesh.info;
+        _copy->fan2 = mesh.fan2;
+        _copy->fanstart2 = mesh.fanstart2;
+        pass(*_copy);
+        checking = false;
+    }
+
+    ~IncrementalCheck()
+    {
+        if (!_copy) return;
+        for (int y = 0; y < _mesh.info.getTileCountY(); ++y)
+        {
+            for (int x = 0; x < _mesh.info.getTileCountX(); ++x)
+            {
+                const int ifan = _mesh.get_ifan(Index2D(x, y));
+                bool equal = _mesh.fan2[ifan].equals(_copy->fan2[ifan]);
+                uint32_t ivrt = _mesh.fan2[ifan].vrtstart;
+                for (size_t cnt = 0; equal && cnt < MAP_FAN_VERTICES_MAX && CART_VALID_VERTEX_RANGE(ivrt); ++cnt, ivrt = _mesh.vrt2[ivrt].next)
+                {
+                    equal = _mesh.vrt2[ivrt].equals(_copy->vrt2[ivrt]);
+                }
+                if (!equal)
+                {
+                    Log::get() << Log::Entry::create(Log::Level::Warning, __FILE__, __LINE__, _name, ": tile ", x, ", ", y,
+                                                     " differs from the result of a full pass", Log::EndOfEntry);
+                }
+            }
+        }
+    }
+
+private:
+    cartman_mpd_t& _mesh;
+    const char *_name;
+    std::unique_ptr<cartman_mpd_t> _copy;
+};
+#endif
+
+} // namespace
+
+void fix_corners( cartman_mpd_t& mesh, const Cartman::TileRect& rect )
 {
     // ZZ> This function corrects corners across entire mesh
+    if (rect.empty()) return;
+    Cartman::MeshEdit edit(mesh, "fix corners");
+    Cartman::DerivedPass pass(mesh);
+    mesh.touch_tiles(grow(rect));
 
     // weld the corners in a checkerboard pattern
-    for (size_t y = 0; y < mesh.info.getTileCountY(); y += 2 )
+    for (int y = rect.ymin + (rect.ymin & 1); y <= rect.ymax; y += 2 )
     {
-        for ( size_t x = y & 1; x < mesh.info.getTileCountX(); x += 2 )
+        for (int x = rect.xmin + (rect.xmin & 1); x <= rect.xmax; x += 2 )
         {
             weld_corner_verts(mesh, Index2D(x, y));
         }
     }
 }
 
-void fix_edges(cartman_mpd_t& mesh) {
+void fix_edges(cartman_mpd_t& mesh, const Cartman::TileRect& rect) {
     // ZZ> This function seals the tile edges across the entire mesh
+    if (rect.empty()) return;
+    Cartman::MeshEdit edit(mesh, "fix edges");
+    Cartman::DerivedPass pass(mesh);
+    mesh.touch_tiles(grow(rect));
 
     // weld the edges of all tiles
-    for (auto it = mesh.info.begin(); it != mesh.info.end(); ++it) {
-            fix_vertices(mesh, *it);
+    for (int y = rect.ymin; y <= rect.ymax; ++y) {
+        for (int x = rect.xmin; x <= rect.xmax; ++x) {
+            fix_vertices(mesh, Index2D(x, y));
+        }
     }
 }
 
 void fix_mesh( cartman_mpd_t& mesh )
 {
     // ZZ> This function corrects corners across entire mesh
-    fix_corners( mesh );
-    fix_edges( mesh );
+    //     Only the tiles changed since the last fix are welded.
+    const Cartman::TileRect rect = mesh.dirty.get(Cartman::DirtyTiles::EDGES, mesh.info.getTileCountX(), mesh.info.getTileCountY());
+#if defined(CARTMAN_DEBUG)
+    IncrementalCheck check(mesh, "fix mesh", [](cartman_mpd_t& copy) { fix_mesh(copy); });
+#endif
+    Cartman::MeshEdit edit(mesh, "fix mesh");
+    Cartman::DerivedPass pass(mesh);
+    fix_corners( mesh, rect );
+    fix_edges( mesh, rect );
+    mesh.dirty.clean(Cartman::DirtyTiles::EDGES);
 }
 
 void fix_vertices( cartman_mpd_t& mesh, Index2D index2d )
@@ -109,6 +256,11 @@ void fix_vertices( cartman_mpd_t& mesh, Index2D index2d )
 	tile_definition_t *pdef = tile_dict.get(pfan->type);
     if ( NULL == pdef ) return;
 
+    // The edge vertices are welded to the vertices of the neighbouring tiles.
+    Cartman::MeshEdit edit(mesh, "fix vertices");
+    Cartman::DerivedPass pass(mesh);
+    mesh.touch_tiles(grow(Cartman::TileRect(index2d.x(), index2d.y(), index2d.x(), index2d.y())));
+
     for ( int cnt = 4; cnt < pdef->numvertices; cnt++ )
     {
         weld_edge_verts( mesh, pfan, pdef, cnt, index2d );
@@ -447,8 +599,7 @@ int select_lst_add_fan_vertex( select_lst_t& plst, Index2D index2d, int grid_ix,
 			Vector3f vtmp;
             if ( interpolate_coord(plst.get_mesh(), pfan, grid_ix, grid_iy, vtmp, vert_lst ) )
             {
-                pvrt->x = vtmp[kX];
-                pvrt->y = vtmp[kY];
+                plst.get_mesh()->set_vertex_xy(ivrt, vtmp[kX], vtmp[kY]);
                 pvrt->z = vtmp[kZ];
             }
         }
@@ -565,8 +716,6 @@ void select_lst_add_rect( select_lst_t& plst, const Vector3f& a, const Vector3f&
 {
     // ZZ> This function checks the rectangular selection
 
-    uint32_t ivrt;
-
     float xmin, ymin, zmin;
     float xmax, ymax, zmax;
 
@@ -584,35 +733,13 @@ void select_lst_add_rect( select_lst_t& plst, const Vector3f& a, const Vector3f&
     std::tie(ymin, ymax) = std::minmax(a.y(), b.y());
     std::tie(zmin, zmax) = std::minmax(a.z(), b.z());
 
-    if ( mode == WINMODE_VERTEX )
+    if ( mode == WINMODE_VERTEX || mode == WINMODE_SIDE )
     {
-        for ( ivrt = 0; ivrt < MAP_VERTICES_MAX; ivrt++)
+        std::vector<uint32_t> vertices;
+        pmesh->find_vertices(xmin, ymin, zmin, xmax, ymax, zmax, vertices);
+        for (uint32_t ivrt : vertices)
         {
-            Cartman::mpd_vertex_t& pvrt = pmesh->vrt2[ivrt];
-            if (VERTEXUNUSED == pvrt.a) continue;
-
-            
-            if (pvrt.x >= xmin && pvrt.x <= xmax &&
-                pvrt.y >= ymin && pvrt.y <= ymax &&
-                pvrt.z >= zmin && pvrt.z <= zmax)
-            {
-                plst.add( ivrt );
-            }
-        }
-    }
-    else if ( mode == WINMODE_SIDE )
-    {
-        for (ivrt = 0; ivrt < MAP_VERTICES_MAX; ivrt++)
-        {
-            Cartman::mpd_vertex_t& pvrt = pmesh->vrt2[ivrt];
-            if (VERTEXUNUSED == pvrt.a) continue;
-
-            if (pvrt.x >= xmin && pvrt.x <= xmax &&
-                pvrt.y >= ymin && pvrt.y <= ymax &&
-                pvrt.z >= zmin && pvrt.z <= zmax )
-            {
-                plst.add( ivrt );
-            }
+            plst.add( ivrt );
         }
     }
 }
@@ -637,36 +764,13 @@ void select_lst_remove_rect( select_lst_t& plst, const Vector3f& a, const Vector
     std::tie(ymin, ymax) = std::minmax(a.y(), b.y());
     std::tie(zmin, zmax) = std::minmax(a.z(), b.z());
 
-    if ( mode == WINMODE_VERTEX )
-    {
-		uint32_t ivrt;
-        for ( ivrt = 0; ivrt < MAP_VERTICES_MAX; ivrt++)
-        {
-            Cartman::mpd_vertex_t& pvrt = pmesh->vrt2[ivrt];
-            if ( VERTEXUNUSED == pvrt.a ) continue;
-
-            if ( pvrt.x >= xmin && pvrt.x <= xmax &&
-                 pvrt.y >= ymin && pvrt.y <= ymax &&
-                 pvrt.z >= zmin && pvrt.z <= zmax )
-            {
-                plst.remove( ivrt );
-            }
-        }
-    }
-    else if ( mode == WINMODE_SIDE )
+    if ( mode == WINMODE_VERTEX || mode == WINMODE_SIDE )
     {
-		uint32_t ivrt;
-        for ( ivrt = 0; ivrt < MAP_VERTICES_MAX; ivrt++)
+        std::vector<uint32_t> vertices;
+        pmesh->find_vertices(xmin, ymin, zmin, xmax, ymax, zmax, vertices);
+        for (uint32_t ivrt : vertices)
         {
-            Cartman::mpd_vertex_t& pvrt = pmesh->vrt2[ivrt];
-            if ( VERTEXUNUSED == pvrt.a ) continue;
-
-            if ( pvrt.x >= xmin && pvrt.x <= xmax &&
-                 pvrt.y >= ymin && pvrt.y <= ymax &&
-                 pvrt.z >= zmin && pvrt.z <= zmax )
-            {
-                plst.remove( ivrt );
-            }
+            plst.remove( ivrt );
         }
     }
 }
@@ -733,6 +837,7 @@ void mesh_select_move( select_lst_t& plst, float x, float y, float z )
     if (nullptr == pmesh) {
         throw id::runtime_error(__FILE__, __LINE__, "selection list has no mesh");
     }
+    Cartman::MeshEdit edit(*pmesh, "move selection", true);
 
     // limit the movement by the bounds of the mesh
     for ( int cnt = 0; cnt < plst.count(); cnt++ )
@@ -754,6 +859,7 @@ void mesh_select_move( select_lst_t& plst, float x, float y, float z )
     for ( int cnt = 0; cnt < plst.count(); cnt++ )
     {
         int ivrt = select_lst_t::at(plst, cnt);
+        pmesh->touch_vertex(ivrt);
 
         float newx = pmesh->vrt2[ivrt].x + x;
         float newy = pmesh->vrt2[ivrt].y + y;
@@ -763,8 +869,7 @@ void mesh_select_move( select_lst_t& plst, float x, float y, float z )
 		newy = Ego::Math::constrain(newy, 0.0f, pmesh->info.getEdgeY());
 		newz = Ego::Math::constrain(newz, 0.0f, pmesh->info.getEdgeZ());
 
-        pmesh->vrt2[ivrt].x = newx;
-        pmesh->vrt2[ivrt].y = newy;
+        pmesh->set_vertex_xy(ivrt, newx, newy);
         pmesh->vrt2[ivrt].z = newz;
     }
 }
@@ -777,12 +882,14 @@ void mesh_select_set_z_no_bound( select_lst_t& plst, float z )
     if (nullptr == pmesh) {
         throw id::runtime_error(__FILE__, __LINE__, "selection list has no mesh");
     }
+    Cartman::MeshEdit edit(*pmesh, "set selection z");
 
     for ( int cnt = 0; cnt < plst.count(); cnt++ )
     {
         uint32_t vert = select_lst_t::at(plst, cnt);
         if ( vert > pmesh->info.getVertexCount() ) continue;
 
+        pmesh->touch_vertex(vert);
         pmesh->vrt2[vert].z = z;
     }
 }
@@ -793,6 +900,7 @@ void mesh_select_jitter(select_lst_t& plst) {
     if (nullptr == pmesh)         {
         throw id::runtime_error(__FILE__, __LINE__, "selection list has no mesh");
     }
+    Cartman::MeshEdit edit(*pmesh, "jitter selection");
 	for (int i = 0; i < plst.count(); ++i) {
 		int vertex = select_lst_t::at(plst, i);
         MeshEditor::move_vert(*pmesh,  vertex, Random::next(2) - 1, Random::next(2) - 1, 0);
@@ -824,13 +932,10 @@ void mesh_select_verts_connected(select_lst_t& plst) {
                   cnt < pdef->numvertices;
                   cnt++, vert = pmesh->vrt2[vert].next)
             {
-                for ( int tnc = 0; tnc < plst.count(); tnc++ )
+                if ( plst.contains(vert) )
                 {
-                    if ( select_lst_t::at(plst,tnc) == vert )
-                    {
-                        select_vertsfan = true;
-                        break;
-                    }
+                    select_vertsfan = true;
+                    break;
                 }
             }
 
@@ -856,6 +961,7 @@ void mesh_select_weld(select_lst_t& plst)
 
     if ( plst.count() > 1 )
     {
+        Cartman::MeshEdit edit(*pmesh, "weld selection");
 		float sum_x, sum_y, sum_z, sum_a;
         sum_x = 0.0f;
         sum_y = 0.0f;
@@ -894,8 +1000,8 @@ void mesh_select_weld(select_lst_t& plst)
             int vertex = select_lst_t::at(plst, cnt);
             if (CHAINEND == vertex) break;
 
-            pmesh->vrt2[vertex].x = avg_x;
-            pmesh->vrt2[vertex].y = avg_y;
+            pmesh->touch_vertex(vertex);
+            pmesh->set_vertex_xy(vertex, avg_x, avg_y);
             pmesh->vrt2[vertex].z = avg_z;
             pmesh->vrt2[vertex].a = Ego::Math::constrain(avg_a, 1.0f, 255.0f);
         }
@@ -906,6 +1012,7 @@ void mesh_select_weld(select_lst_t& plst)
 void MeshEditor::mesh_set_tile( cartman_mpd_t& mesh, uint16_t tiletoset, uint8_t upper, uint16_t presser, uint8_t tx )
 {
     // ZZ> This function sets one tile type to another
+    Cartman::MeshEdit edit(mesh, "set tile");
     for (auto it = mesh.info.begin(); it != mesh.info.end(); ++it) {
             cartman_mpd_tile_t *pfan = mesh.get_pfan(*it);
             if ( NULL == pfan ) continue;
@@ -938,6 +1045,7 @@ void MeshEditor::mesh_set_tile( cartman_mpd_t& mesh, uint16_t tiletoset, uint8_t
                     default:
                         tx_bits = pfan->tx_bits;
                 }
+                mesh.touch_tile(mesh.get_ifan(*it));
                 pfan->tx_bits = tx_bits;
             }
     }
@@ -947,6 +1055,7 @@ void MeshEditor::mesh_set_tile( cartman_mpd_t& mesh, uint16_t tiletoset, uint8_t
 void MeshEditor::move_mesh_z( cartman_mpd_t& mesh, int z, uint16_t tiletype, uint16_t tileand )
 {
     tiletype = tiletype & tileand;
+    Cartman::MeshEdit edit(mesh, "move mesh z", true);
 
     for (auto it = mesh.info.begin(); it != mesh.info.end(); ++it) {
             cartman_mpd_tile_t *pfan = mesh.get_pfan(*it);
@@ -957,6 +1066,7 @@ void MeshEditor::move_mesh_z( cartman_mpd_t& mesh, int z, uint16_t tiletype, uin
 
             if ( tiletype == ( pfan->tx_bits & tileand ) )
             {
+                mesh.touch_tile(mesh.get_ifan(*it));
                 int vert = pfan->vrtstart;
                 for ( int cnt = 0; cnt < pdef->numvertices; cnt++ )
                 {
@@ -973,6 +1083,9 @@ void MeshEditor::move_mesh_z( cartman_mpd_t& mesh, int z, uint16_t tiletype, uin
 //--------------------------------------------------------------------------------------------
 void MeshEditor::move_vert( cartman_mpd_t& mesh, int vert, float x, float y, float z )
 {
+    Cartman::MeshEdit edit(mesh, "move vertex");
+    mesh.touch_vertex(vert);
+
     int newx = mesh.vrt2[vert].x + x;
     int newy = mesh.vrt2[vert].y + y;
     int newz = mesh.vrt2[vert].z + z;
@@ -981,8 +1094,7 @@ void MeshEditor::move_vert( cartman_mpd_t& mesh, int vert, float x, float y, flo
 	newy = Ego::Math::constrain(newy, 0, (int)mesh.info.getEdgeY());
 	newz = Ego::Math::constrain(newz, -(int)mesh.info.getEdgeZ(), +(int)mesh.info.getEdgeZ());
 
-    mesh.vrt2[vert].x = newx;
-    mesh.vrt2[vert].y = newy;
+    mesh.set_vertex_xy(vert, newx, newy);
     mesh.vrt2[vert].z = newz;
 }
 
@@ -990,6 +1102,7 @@ void MeshEditor::move_vert( cartman_mpd_t& mesh, int vert, float x, float y, flo
 void MeshEditor::raise_mesh( cartman_mpd_t& mesh, uint32_t point_lst[], size_t point_cnt, float x, float y, int amount, int size )
 {
     if ( NULL == point_lst || 0 == point_cnt ) return;
+    Cartman::MeshEdit edit(mesh, "raise mesh", true);
 
     for ( size_t cnt = 0; cnt < point_cnt; cnt++ )
     {
@@ -1011,6 +1124,7 @@ void MeshEditor::raise_mesh( cartman_mpd_t& mesh, uint32_t point_lst[], size_t p
 //--------------------------------------------------------------------------------------------
 void MeshEditor::level_vrtz( cartman_mpd_t& mesh )
 {
+    Cartman::MeshEdit edit(mesh, "level mesh");
     for (auto it = mesh.info.begin(); it != mesh.info.end(); ++it) {
             cartman_mpd_tile_t *pfan = mesh.get_pfan(*it);
             if ( NULL == pfan ) continue;
@@ -1018,6 +1132,7 @@ void MeshEditor::level_vrtz( cartman_mpd_t& mesh )
 			tile_definition_t *pdef = tile_dict.get(pfan->type);
             if ( NULL == pdef ) continue;
 
+            mesh.touch_tile(mesh.get_ifan(*it));
             uint32_t vert = pfan->vrtstart;
             for ( int cnt = 0; cnt < pdef->numvertices; cnt++ )
             {
@@ -1030,6 +1145,7 @@ void MeshEditor::level_vrtz( cartman_mpd_t& mesh )
 //--------------------------------------------------------------------------------------------
 void MeshEditor::jitter_mesh( cartman_mpd_t& mesh )
 {
+    Cartman::MeshEdit edit(mesh, "jitter mesh");
 	select_lst_t loc_lst;
 
     // initialize the local selection
@@ -1067,6 +1183,7 @@ void MeshEditor::flatten_mesh( cartman_mpd_t& mesh, int y0 )
 {
     int height = ( 780 - ( y0 ) ) * 4;
 	height = int(Ego::Math::constrain(float(height), 0.0f, mesh.info.getEdgeZ()));
+    Cartman::MeshEdit edit(mesh, "flatten mesh");
 
     for (auto it = mesh.info.begin(); it != mesh.info.end(); ++it) {
             cartman_mpd_tile_t *pfan = mesh.get_pfan(*it);
@@ -1077,6 +1194,7 @@ void MeshEditor::flatten_mesh( cartman_mpd_t& mesh, int y0 )
 
             int num = pdef->numvertices;
 
+            mesh.touch_tile(mesh.get_ifan(*it));
             uint32_t vert = pfan->vrtstart;
             for ( int cnt = 0; cnt < num; cnt++ )
             {
@@ -1100,11 +1218,13 @@ void MeshEditor::clear_mesh( cartman_mpd_t& mesh, uint8_t upper, uint16_t presse
 
     if ( !TILE_IS_FANOFF( TILE_SET_BITS( upper, tx ) ) )
     {
+        Cartman::MeshEdit edit(mesh, "clear mesh");
         for (auto it = mesh.info.begin(); it != mesh.info.end(); ++it)
         {
                 cartman_mpd_tile_t *pfan = mesh.get_pfan(*it);
                 if ( NULL == pfan ) continue;
 
+                mesh.touch_tile(mesh.get_ifan(*it));
                 mesh.remove_pfan(pfan);
 
                 int tx_bits = TILE_SET_UPPER_BITS( upper );
@@ -1146,6 +1266,7 @@ void MeshEditor::three_e_mesh( cartman_mpd_t& mesh, uint8_t upper, uint8_t tx )
     {
         return;
     }
+    Cartman::MeshEdit edit(mesh, "replace 3F tiles");
 
     for (auto it = mesh.info.begin(); it != mesh.info.end(); ++it) {
             cartman_mpd_tile_t *pfan = mesh.get_pfan(*it);
@@ -1153,6 +1274,7 @@ void MeshEditor::three_e_mesh( cartman_mpd_t& mesh, uint8_t upper, uint8_t tx )
 
             if ( 0x3F == pfan->tx_bits )
             {
+                mesh.touch_tile(mesh.get_ifan(*it));
                 pfan->tx_bits = 0x3E;
             }
     }
@@ -1362,25 +1484,44 @@ void MeshEditor::set_barrier_height( cartman_mpd_t& mesh, const Index2D& index2d
 //--------------------------------------------------------------------------------------------
 void MeshEditor::fix_walls( cartman_mpd_t& mesh )
 {
+    // only the tiles changed since the last fix and their neighbours
+#if defined(CARTMAN_DEBUG)
+    IncrementalCheck check(mesh, "fix walls", [](cartman_mpd_t& copy) { fix_walls(copy); });
+#endif
+    const Cartman::TileRect rect = mesh.dirty.get(Cartman::DirtyTiles::WALLS, mesh.info.getTileCountX(), mesh.info.getTileCountY());
+    if (rect.empty()) return;
+    Cartman::MeshEdit edit(mesh, "fix walls");
+    Cartman::DerivedPass pass(mesh);
+
     // make sure the corners are correct
-    fix_corners( mesh );
+    fix_corners( mesh, rect );
 
     // adjust the wall-icity of all non-corner vertices
-    for (auto it = mesh.info.begin(); it != mesh.info.end(); ++it) {
-            set_barrier_height(mesh, *it);
-    }
+    // a tile only writes to its own vertices, hence the rows are processed in parallel
+    mesh.touch_tiles(rect);
+    for_each_tile_banded(rect, [&mesh](const Index2D& index2d) { set_barrier_height(mesh, index2d); });
+
+    mesh.dirty.clean(Cartman::DirtyTiles::WALLS);
 }
 
 //--------------------------------------------------------------------------------------------
 void MeshEditor::impass_edges( cartman_mpd_t& mesh, int amount )
 {
-    for (auto it = mesh.info.begin(); it != mesh.info.end(); ++it) {
-            if (dist_from_edge(mesh, *it) < amount)
+    Cartman::MeshEdit edit(mesh, "impassable edges");
+    const int countX = mesh.info.getTileCountX(), countY = mesh.info.getTileCountY();
+    for (int y = 0; y < countY; ++y) {
+        for (int x = 0; x < countX; ++x) {
+            if (dist_from_edge(mesh, Index2D(x, y)) >= amount)
             {
-                cartman_mpd_tile_t *tile = mesh.get_pfan(*it);
-                if (!tile) continue;
-				tile->setImpassable();
+                // only visit the tiles near the edges: skip to the tiles near the far edge of this row
+                x = std::max(x, countX - amount - 1);
+                continue;
             }
+            cartman_mpd_tile_t *tile = mesh.get_pfan(Index2D(x, y));
+            if (!tile) continue;
+            mesh.touch_tile(mesh.get_ifan(Index2D(x, y)));
+			tile->setImpassable();
+        }
     }
 }
 
@@ -1391,6 +1532,7 @@ void MeshEditor::mesh_replace_fx( cartman_mpd_t& mesh, uint16_t fx_bits, uint16_
 
     // trim away any bits that can't be matched
     fx_bits &= fx_mask;
+    Cartman::MeshEdit edit(mesh, "replace fx");
 
     for (auto it = mesh.info.begin(); it != mesh.info.end(); ++it) {
             cartman_mpd_tile_t *pfan = mesh.get_pfan(*it);
@@ -1398,6 +1540,7 @@ void MeshEditor::mesh_replace_fx( cartman_mpd_t& mesh, uint16_t fx_bits, uint16_
 
             if ( fx_bits == ( pfan->tx_bits&fx_mask ) )
             {
+                mesh.touch_tile(mesh.get_ifan(*it));
                 pfan->fx = fx_new;
             }
     }
@@ -1607,28 +1750,60 @@ void trim_mesh_tile( cartman_mpd_t& mesh, uint16_t fx_bits, uint16_t fx_mask )
     // ZZ> This function trims walls and floors and tops automagically
     fx_bits = fx_bits & fx_mask;
 
-    for (auto it = mesh.info.begin(); it != mesh.info.end(); ++it) {
-            cartman_mpd_tile_t *pfan = mesh.get_pfan(*it);
-            if ( NULL == pfan ) continue;
+    // only the tiles changed since the last trim and their neighbours
+    const uint32_t key = Cartman::DirtyTiles::trim(fx_bits, fx_mask);
+    const Cartman::TileRect rect = mesh.dirty.get(key, mesh.info.getTileCountX(), mesh.info.getTileCountY());
+    if (rect.empty()) return;
+    Cartman::MeshEdit edit(mesh, "trim tiles");
+    Cartman::DerivedPass pass(mesh);
 
-            if ( fx_bits == ( pfan->tx_bits&fx_mask ) )
-            {
-				int code;
-                if ( fx_mask == 0xC0 )
-                {
-                    code = wall_code(mesh, *it, fx_bits);
-                }
-                else
+    if ( fx_mask == 0xC0 )
+    {
+        // wall codes are random and depend on the tiles trimmed before, keep the row order
+        for (int y = rect.ymin; y <= rect.ymax; ++y) {
+            for (int x = rect.xmin; x <= rect.xmax; ++x) {
+                cartman_mpd_tile_t *pfan = mesh.get_pfan(Index2D(x, y));
+                if ( NULL == pfan ) continue;
+
+                if ( fx_bits == ( pfan->tx_bits&fx_mask ) )
                 {
-                    code = trim_code(mesh, *it, fx_bits);
+                    int code = wall_code(mesh, Index2D(x, y), fx_bits);
+                    if ( code != 255 )
+                    {
+                        mesh.touch_tile(mesh.get_ifan(Index2D(x, y)));
+                        pfan->tx_bits = fx_bits + code;
+                    }
                 }
-
+            }
+        }
+    }
+    else
+    {
+        // trim codes only depend on the upper bits of the neighbours, which are not changed:
+        // compute the codes of the rows in parallel, then apply them
+        const int width = rect.xmax - rect.xmin + 1;
+        std::vector<uint16_t> codes(width * (rect.ymax - rect.ymin + 1), 255);
+        for_each_tile_banded(rect, [&mesh, &rect, &codes, width, fx_bits, fx_mask](const Index2D& index2d)
+        {
+            cartman_mpd_tile_t *pfan = mesh.get_pfan(index2d);
+            if ( NULL != pfan && fx_bits == ( pfan->tx_bits&fx_mask ) )
+            {
+                codes[(index2d.y() - rect.ymin) * width + (index2d.x() - rect.xmin)] = trim_code(mesh, index2d, fx_bits);
+            }
+        });
+        for (int y = rect.ymin; y <= rect.ymax; ++y) {
+            for (int x = rect.xmin; x <= rect.xmax; ++x) {
+                const uint16_t code = codes[(y - rect.ymin) * width + (x - rect.xmin)];
                 if ( code != 255 )
                 {
-                    pfan->tx_bits = fx_bits + code;
+                    mesh.touch_tile(mesh.get_ifan(Index2D(x, y)));
+                    mesh.get_pfan(Index2D(x, y))->tx_bits = fx_bits + code;
                 }
             }
+        }
     }
+
+    mesh.dirty.clean(key);
 }
 
 //--------------------------------------------------------------------------------------------
@@ -1639,6 +1814,8 @@ void MeshEditor::mesh_replace_tile(cartman_mpd_t& mesh, int _xfan, int _yfan, in
 
 	cartman_mpd_tile_t *pfan = CART_MPD_FAN_PTR(&mesh, _onfan);
     if ( NULL == pfan ) return;
+    Cartman::MeshEdit edit(mesh, "replace tile");
+    mesh.touch_tile(_onfan);
 
     if ( !tx_only )
     {
@@ -1701,23 +1878,19 @@ void MeshEditor::mesh_replace_tile(cartman_mpd_t& mesh, int _xfan, int _yfan, in
 			int vert;
             // Return corner positions
             vert = pfan->vrtstart;
-            mesh.vrt2[vert].x = pos[CORNER_TL][kX];
-            mesh.vrt2[vert].y = pos[CORNER_TL][kY];
+            mesh.set_vertex_xy(vert, pos[CORNER_TL][kX], pos[CORNER_TL][kY]);
             mesh.vrt2[vert].z = pos[CORNER_TL][kZ];
 
             vert = mesh.vrt2[vert].next;
-            mesh.vrt2[vert].x = pos[CORNER_TR][kX];
-            mesh.vrt2[vert].y = pos[CORNER_TR][kY];
+            mesh.set_vertex_xy(vert, pos[CORNER_TR][kX], pos[CORNER_TR][kY]);
             mesh.vrt2[vert].z = pos[CORNER_TR][kZ];
 
             vert = mesh.vrt2[vert].next;
-            mesh.vrt2[vert].x = pos[CORNER_BR][kX];
-            mesh.vrt2[vert].y = pos[CORNER_BR][kY];
+            mesh.set_vertex_xy(vert, pos[CORNER_BR][kX], pos[CORNER_BR][kY]);
             mesh.vrt2[vert].z = pos[CORNER_BR][kZ];
 
             vert = mesh.vrt2[vert].next;
-            mesh.vrt2[vert].x = pos[CORNER_BL][kX];
-            mesh.vrt2[vert].y = pos[CORNER_BL][kY];
+            mesh.set_vertex_xy(vert, pos[CORNER_BL][kX], pos[CORNER_BL][kY]);
             mesh.vrt2[vert].z = pos[CORNER_BL][kZ];
         }
     }
@@ -1729,6 +1902,8 @@ void MeshEditor::setFX( cartman_mpd_t& mesh, int ifan, uint8_t fx )
 {
     cartman_mpd_tile_t *tile = mesh.get_pfan(ifan);
     if (!tile) return;
+    Cartman::MeshEdit edit(mesh, "set fx");
+    mesh.touch_tile(ifan);
 	tile->setFX(fx);
 }
 
@@ -1741,6 +1916,7 @@ void MeshEditor::mesh_move( cartman_mpd_t& mesh, float dx, float dy, float dz )
     cartman_mpd_tile_t * pfan   = NULL;
     tile_definition_t  * pdef    = NULL;
 
+    Cartman::MeshEdit edit(mesh, "move mesh", true);
     for (auto it = mesh.info.begin(); it != mesh.info.end(); ++it) {
             int count;
 
@@ -23,6 +23,7 @@
 #pragma once
 
 #include "cartman/cartman_typedef.h"
+#include "cartman/DirtyTiles.hpp"
 #include "egolib/Mesh/Info.hpp"
 
 //--------------------------------------------------------------------------------------------
@@ -40,9 +41,11 @@ float dist_from_border( cartman_mpd_t& mesh, float x, float y );
 int dist_from_edge( cartman_mpd_t& mesh, Index2D index2d );
 int nearest_edge_vertex( cartman_mpd_t& mesh, Index2D index2d, float nearx, float neary );
 
+// Weld the corners and edges of the tiles changed since the last fix.
 void fix_mesh( cartman_mpd_t& mesh );
-void fix_corners( cartman_mpd_t& mesh );
-void fix_edges( cartman_mpd_t& mesh );
+// Weld the corners and edges of the tiles in a rectangle.
+void fix_corners( cartman_mpd_t& mesh, const Cartman::TileRect& rect );
+void fix_edges( cartman_mpd_t& mesh, const Cartman::TileRect& rect );
 void fix_vertices( cartman_mpd_t& mesh, Index2D index2d );
 
 void weld_TL(cartman_mpd_t& mesh, Index2D index2d);
@@ -82,6 +85,7 @@ struct MeshEditor {
 	static bool fan_isPassableFloor(cartman_mpd_t& mesh, const Index2D& index2d);
 	static bool isImpassableWall(cartman_mpd_t& mesh, const Index2D& index2d);
 	static void set_barrier_height(cartman_mpd_t& mesh, const Index2D& index2d);
+	// Recompute the wall heights of the tiles changed since the last recomputation.
 	static void fix_walls(cartman_mpd_t& mesh);
 	static void impass_edges(cartman_mpd_t& mesh, int amount);
 
@@ -95,4 +99,5 @@ struct MeshEditor {
 uint8_t  tile_is_different( cartman_mpd_t& mesh, Index2D index2d, uint16_t fx_bits, uint16_t fx_mask );
 uint16_t trim_code( cartman_mpd_t& mesh, const Index2D& index2d, uint16_t fx_bits );
 uint16_t wall_code( cartman_mpd_t& mesh, const Index2D& index2d, uint16_t fx_bits );
+// Trim the tiles changed since the last trim with the same bits and mask.
 void   trim_mesh_tile( cartman_mpd_t& mesh, uint16_t fx_bits, uint16_t fx_mask );
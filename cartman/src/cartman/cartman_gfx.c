@@ -346,11 +346,9 @@ void draw_top_fan( select_lst_t& plst, int fan, float zoom_hrz, float zoom_vrt )
 
         if ( point_size > 0 )
         {
-            int select_rv;
             std::shared_ptr<Ego::Texture> tx_tmp;
 
-            select_rv = plst.find(vert);
-            if ( select_rv < 0 )
+            if ( !plst.contains(vert) )
             {
                 tx_tmp = Resources::get().tx_point;
             }
@@ -439,13 +437,11 @@ void draw_side_fan( select_lst_t& plst, int fan, float zoom_hrz, float zoom_vrt
 
     for ( cnt = 0; cnt < pdef->numvertices; cnt++ )
     {
-        int select_rv;
         std::shared_ptr<Ego::Texture> tx_tmp = NULL;
 
         vert = faketoreal[cnt];
 
-        select_rv = plst.find( vert );
-        if ( select_rv < 0 )
+        if ( !plst.contains( vert ) )
         {
             tx_tmp = Resources::get().tx_point;
         }
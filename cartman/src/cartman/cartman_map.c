@@ -18,6 +18,7 @@
 //********************************************************************************************
 
 #include "egolib/FileFormats/Globals.hpp"
+#include "egolib/Mesh/CookedMesh.hpp"
 #include "cartman/cartman_map.h"
 #include "cartman/cartman.h"
 #include "cartman/cartman_math.h"
@@ -61,8 +62,9 @@ uint8_t cartman_mpd_calc_twist( int dx, int dy )
 //--------------------------------------------------------------------------------------------
 
 cartman_mpd_t::cartman_mpd_t() :
-    vrt2(), vrt_free(MAP_VERTICES_MAX), vrt_at(0), info(),
-    fan2(), fanstart2()
+    vrt_free(MAP_VERTICES_MAX), vrt_at(0), vrt_free_list(), vrt2(), vrt_index(), info(),
+    fan2(), fanstart2(), history(), dirty(),
+    derived_depth(0), derived_vertices(), derived_tiles()
 {
 }
 
@@ -78,6 +80,8 @@ cartman_mpd_t *cartman_mpd_t::reset()
     }
     vrt_free = MAP_VERTICES_MAX;
     vrt_at = 0;
+    vrt_free_list.clear();
+    vrt_index.clear();
 
     info.reset();
 
@@ -91,6 +95,12 @@ cartman_mpd_t *cartman_mpd_t::reset()
         e = 0;
     }
 
+    history.clear();
+    dirty.clear();
+    derived_depth = 0;
+    derived_vertices.clear();
+    derived_tiles.clear();
+
     return this;
 }
 
@@ -284,6 +294,10 @@ void cartman_mpd_free_vertices(cartman_mpd_t *self)
 
     self->vrt_at = 0;
     self->vrt_free = MAP_VERTICES_MAX;
+    self->vrt_free_list.clear();
+    self->vrt_index.clear();
+    self->history.clear();
+    self->dirty.clear();
 }
 
 Cartman::mpd_vertex_t *cartman_mpd_t::get_vertex(int ivrt)
@@ -332,28 +346,198 @@ int cartman_mpd_t::find_free_vertex()
         return -1;
     }
 
-    for (int cnt = 0;
-         cnt < MAP_VERTICES_MAX && VERTEXUNUSED != vrt2[vrt_at].a;
-         cnt++)
+    // Reuse the most recently freed vertex. The list might contain vertices used again.
+    while (!vrt_free_list.empty())
+    {
+        uint32_t ivrt = vrt_free_list.back();
+        vrt_free_list.pop_back();
+        if (VERTEXUNUSED == vrt2[ivrt].a)
+        {
+            touch_vertex(ivrt);
+            vrt2[ivrt].a = 1;
+            return ivrt;
+        }
+    }
+
+    // Take the next vertex not allocated since the last reset.
+    // If all were allocated, vertices were freed without the free list: Search them once more.
+    for (int pass = 0; pass < 2; ++pass)
+    {
+        for (; vrt_at < MAP_VERTICES_MAX; ++vrt_at)
+        {
+            if (VERTEXUNUSED == vrt2[vrt_at].a)
+            {
+                touch_vertex(vrt_at);
+                vrt2[vrt_at].a = 1;
+                return vrt_at++;
+            }
+        }
+        vrt_at = 0;
+    }
+
+    return -1;
+}
+
+void cartman_mpd_t::free_vertex(int ivrt)
+{
+    Cartman::mpd_vertex_t *pvrt = get_vertex(ivrt);
+    if (!pvrt)
+    {
+        return;
+    }
+    touch_vertex(ivrt);
+    vrt_index.remove(ivrt, pvrt->x, pvrt->y);
+    pvrt->a = VERTEXUNUSED;
+    vrt_free_list.push_back(ivrt);
+}
+
+void cartman_mpd_t::set_vertex_xy(int ivrt, float x, float y)
+{
+    Cartman::mpd_vertex_t *pvrt = get_vertex(ivrt);
+    if (!pvrt)
+    {
+        return;
+    }
+    touch_vertex(ivrt);
+    mark_dirty_xy(x, y);
+    vrt_index.move(ivrt, pvrt->x, pvrt->y, x, y);
+    pvrt->x = x;
+    pvrt->y = y;
+}
+
+void cartman_mpd_t::find_vertices(float xmin, float ymin, float zmin, float xmax, float ymax, float zmax, std::vector<uint32_t>& vertices) const
+{
+    std::vector<uint32_t> candidates;
+    vrt_index.find(xmin, ymin, xmax, ymax, candidates);
+    for (uint32_t ivrt : candidates)
+    {
+        const Cartman::mpd_vertex_t& vrt = vrt2[ivrt];
+        if (VERTEXUNUSED == vrt.a) continue;
+
+        if (vrt.x >= xmin && vrt.x <= xmax &&
+            vrt.y >= ymin && vrt.y <= ymax &&
+            vrt.z >= zmin && vrt.z <= zmax)
+        {
+            vertices.push_back(ivrt);
+        }
+    }
+    // Report the vertices in the order of their indices.
+    std::sort(vertices.begin(), vertices.end());
+}
+
+void cartman_mpd_t::touch_vertex(int ivrt)
+{
+    history.touchVertex(*this, ivrt);
+    const Cartman::mpd_vertex_t *pvrt = get_vertex(ivrt);
+    if (pvrt && 0 < derived_depth)
+    {
+        // Keep the value from before the vertex was first touched.
+        derived_vertices.emplace(ivrt, *pvrt);
+        return;
+    }
+    // The position of an unused vertex is meaningless.
+    if (pvrt && VERTEXUNUSED != pvrt->a)
+    {
+        mark_dirty_xy(pvrt->x, pvrt->y);
+    }
+}
+
+void cartman_mpd_t::touch_tile(int ifan)
+{
+    if (!VALID_MPD_TILE_RANGE(ifan) || 0 == info.getTileCountX())
+    {
+        return;
+    }
+    history.touchTile(*this, ifan);
+    if (0 < derived_depth)
     {
-        vrt_at++;
+        derived_tiles.emplace(ifan, fan2[ifan]);
+        uint32_t ivrt = fan2[ifan].vrtstart;
+        for (size_t cnt = 0; cnt < MAP_FAN_VERTICES_MAX && CART_VALID_VERTEX_RANGE(ivrt); ++cnt, ivrt = vrt2[ivrt].next)
+        {
+            derived_vertices.emplace(ivrt, vrt2[ivrt]);
+        }
+        return;
+    }
+    dirty.add(ifan % info.getTileCountX(), ifan / info.getTileCountX());
+}
 
-        if (!CART_VALID_VERTEX_RANGE(vrt_at))
+void cartman_mpd_t::touch_tiles(const Cartman::TileRect& rect)
+{
+    for (int y = rect.ymin; y <= rect.ymax; ++y)
+    {
+        for (int x = rect.xmin; x <= rect.xmax; ++x)
         {
-            vrt_at = 0;
+            touch_tile(get_ifan(Index2D(x, y)));
         }
     }
+}
 
-    bool found = false;
-    if (VERTEXUNUSED == vrt2[vrt_at].a)
+void cartman_mpd_t::mark_dirty_xy(float x, float y)
+{
+    // During a derived pass, end_derived marks the tiles which changed.
+    if (0 < derived_depth)
     {
-        vrt2[vrt_at].a = 1;
-        found = true;
+        return;
     }
+    dirty.add(std::floor(x / Info<float>::Grid::Size()), std::floor(y / Info<float>::Grid::Size()));
+}
 
-    return found ? vrt_at : -1;
+void cartman_mpd_t::begin_derived()
+{
+    derived_depth++;
 }
 
+void cartman_mpd_t::end_derived()
+{
+    if (0 == derived_depth || 0 < --derived_depth)
+    {
+        return;
+    }
+    const int tileCountX = info.getTileCountX();
+    for (const auto& tile : derived_tiles)
+    {
+        if (!tile.second.equals(fan2[tile.first]))
+        {
+            dirty.add(tile.first % tileCountX, tile.first / tileCountX);
+        }
+    }
+    for (const auto& vertex : derived_vertices)
+    {
+        const Cartman::mpd_vertex_t& current = vrt2[vertex.first];
+        if (vertex.second.equals(current))
+        {
+            continue;
+        }
+        // Both the tile the vertex left and the tile it entered changed.
+        if (VERTEXUNUSED != vertex.second.a)
+        {
+            mark_dirty_xy(vertex.second.x, vertex.second.y);
+        }
+        if (VERTEXUNUSED != current.a)
+        {
+            mark_dirty_xy(current.x, current.y);
+        }
+    }
+    derived_tiles.clear();
+    derived_vertices.clear();
+}
+
+namespace Cartman {
+
+DerivedPass::DerivedPass(cartman_mpd_t& mesh) :
+    _mesh(mesh)
+{
+    _mesh.begin_derived();
+}
+
+DerivedPass::~DerivedPass()
+{
+    _mesh.end_derived();
+}
+
+} // namespace Cartman
+
 uint8_t cartman_mpd_get_fan_twist( cartman_mpd_t * pmesh, uint32_t fan )
 {
     int vt0 = pmesh->fan2[fan].vrtstart;
@@ -449,7 +633,7 @@ int cartman_mpd_free_vertex_list(cartman_mpd_t *self, int list[], size_t size)
         {
             break;
         }
-        self->vrt2[ivrt].a = VERTEXUNUSED;
+        self->free_vertex(ivrt);
         self->vrt2[ivrt].next = CHAINEND;
     }
     return size;
@@ -496,7 +680,11 @@ int cartman_mpd_allocate_vertex_list(cartman_mpd_t * pmesh, int list[], size_t s
         pmesh->vrt_free = vrt_free_old;
         for ( cnt = 0; cnt < valid_verts; cnt++ )
         {
+            // reset() moves the vertex to the origin, so remove it from the index at its old position
+            const Cartman::mpd_vertex_t& vrt = pmesh->vrt2[list[cnt]];
+            pmesh->vrt_index.remove(list[cnt], vrt.x, vrt.y);
             pmesh->vrt2[list[cnt]].reset();
+            pmesh->vrt_free_list.push_back(list[cnt]);
         }
 
         // tell the caller we failed
@@ -642,8 +830,8 @@ int cartman_mpd_t::add_pfan(cartman_mpd_tile_t *pfan, float x, float y)
     {
         pvrt = get_vertex(vertex);
 
-        pvrt->x = x + GRID_TO_POS( pdef->vertices[cnt].grid_ix );
-        pvrt->y = y + GRID_TO_POS( pdef->vertices[cnt].grid_iy );
+        set_vertex_xy(vertex, x + GRID_TO_POS( pdef->vertices[cnt].grid_ix ),
+                              y + GRID_TO_POS( pdef->vertices[cnt].grid_iy ));
         pvrt->z = 0.0f;
     }
 
@@ -668,7 +856,7 @@ void cartman_mpd_t::remove_pfan(cartman_mpd_tile_t *pfan)
          cnt < numvert && CHAINEND != vert;
          cnt++, vert = this->vrt2[vert].next )
     {
-        this->vrt2[vert].a = VERTEXUNUSED;
+        this->free_vertex(vert);
         this->vrt_free++;
     }
 
@@ -823,8 +1011,7 @@ cartman_mpd_t * cartman_mpd_convert(cartman_mpd_t *dst, map_t *src)
             const map_vertex_t& pvrt_src = mem_src.vertices[ivrt_src];
             pvrt_dst = &(dst->vrt2[ivrt_dst]);
 
-            pvrt_dst->x = pvrt_src.pos[kX];
-            pvrt_dst->y = pvrt_src.pos[kY];
+            dst->set_vertex_xy(ivrt_dst, pvrt_src.pos[kX], pvrt_src.pos[kY]);
             pvrt_dst->z = pvrt_src.pos[kZ];
             pvrt_dst->a = std::max(pvrt_src.a, (uint8_t)(VERTEXUNUSED+1));  // force a != VERTEXUNUSED
         };
@@ -1065,6 +1252,18 @@ cartman_mpd_t *cartman_mpd_save_vfs(cartman_mpd_t *self)
         return nullptr;
     }
 
+    // Re-cook the map such that the game does not have to import the edited map.
+    auto cooked = Ego::CookedMesh::cook(local, tile_dict, Ego::CookedMesh::stampSources({"mp_data/level.mpd", "mp_data/fans.txt"}));
+    auto target = vfs_resolveWriteFilename("mp_data/level.mpc");
+    if (!cooked || !target.first || !cooked->save(target.second))
+    {
+        Log::get() << Log::Entry::create(Log::Level::Warning, __FILE__, __LINE__, "unable to cook ", "`",
+                                         "mp_data/level.mpd", "`", Log::EndOfEntry);
+        // Do not leave a stale cooked mesh behind.
+        vfs_delete_file("mp_data/level.mpc");
+    }
+    vfs_invalidateCache();
+
     return self;
 }
 
@@ -20,6 +20,9 @@
 #pragma once
 
 #include "cartman/Vertex.hpp"
+#include "cartman/VertexIndex.hpp"
+#include "cartman/MeshHistory.hpp"
+#include "cartman/DirtyTiles.hpp"
 #include "cartman/cartman_typedef.h"
 #include "cartman/Tile.hpp"
 #include "egolib/FileFormats/map_tile_dictionary.h"
@@ -198,8 +201,10 @@ struct cartman_mpd_t
      *  <tt>MAP_VERTICES_MAX</tt>
      */
     uint32_t vrt_free;
-    uint32_t vrt_at;                          // Current vertex check for new
+    uint32_t vrt_at;                          // Vertices at and above this index were not allocated since the last reset
+    std::vector<uint32_t> vrt_free_list;      // Vertices freed since the last reset, reused first
     std::array<Cartman::mpd_vertex_t, MAP_VERTICES_MAX> vrt2;
+    Cartman::VertexIndex vrt_index;           // Spatial index over the vertex positions
 
     cartman_mpd_info_t   info;
     std::array<cartman_mpd_tile_t,MAP_TILE_MAX> fan2;
@@ -212,6 +217,27 @@ struct cartman_mpd_t
      */
     std::array<uint32_t,MAP_TILE_MAX_Y> fanstart2;
 
+    /**
+     * @brief
+     *  The undo/redo history of this mesh.
+     */
+    Cartman::MeshHistory history;
+
+    /**
+     * @brief
+     *  The tiles changed since the walls, trims and edges of this mesh were last recomputed.
+     */
+    Cartman::DirtyTiles dirty;
+
+    /**
+     * @brief
+     *  The number of running derived passes and the values of the vertices and tiles they touched,
+     *  taken when they were first touched.
+     */
+    int derived_depth;
+    std::unordered_map<int, Cartman::mpd_vertex_t> derived_vertices;
+    std::unordered_map<int, cartman_mpd_tile_t> derived_tiles;
+
     /**
      * @brief
      *  Construct this mesh.
@@ -325,6 +351,87 @@ struct cartman_mpd_t
      */
     int find_free_vertex();
 
+    /**
+     * @brief
+     *  Mark a vertex as unused.
+     * @param ivrt
+     *  the vertex index
+     * @remark
+     *  The vertex is removed from the spatial index and is reused by find_free_vertex.
+     *  The number of free vertices is not changed.
+     */
+    void free_vertex(int ivrt);
+
+    /**
+     * @brief
+     *  Set the position of a vertex along the x- and y-axes.
+     * @param ivrt
+     *  the vertex index
+     * @param x, y
+     *  the position in world coordinates
+     * @remark
+     *  Keeps the spatial index current, positions must not be changed otherwise.
+     */
+    void set_vertex_xy(int ivrt, float x, float y);
+
+    /**
+     * @brief
+     *  Get the used vertices in a box.
+     * @param xmin, ymin, zmin, xmax, ymax, zmax
+     *  the box in world coordinates
+     * @param vertices
+     *  the vertex indices are appended to this list
+     */
+    void find_vertices(float xmin, float ymin, float zmin, float xmax, float ymax, float zmax, std::vector<uint32_t>& vertices) const;
+
+    /**
+     * @brief
+     *  Touch a vertex before it is written to.
+     * @remark
+     *  The vertex is recorded by the history and, if it is used, its tile is marked dirty.
+     *  During a derived pass, the tile is marked dirty by end_derived if the vertex changed.
+     */
+    void touch_vertex(int ivrt);
+
+    /**
+     * @brief
+     *  Touch a tile and its vertices before they are written to.
+     * @remark
+     *  The tile is recorded by the history and marked dirty.
+     *  During a derived pass, the tile is marked dirty by end_derived if the tile or its vertices changed.
+     */
+    void touch_tile(int ifan);
+
+    /**
+     * @brief
+     *  Touch the tiles in a rectangle and their vertices before they are written to.
+     */
+    void touch_tiles(const Cartman::TileRect& rect);
+
+    /**
+     * @brief
+     *  Mark the tile containing a point dirty.
+     * @param x, y
+     *  the point in world coordinates
+     */
+    void mark_dirty_xy(float x, float y);
+
+    /**
+     * @brief
+     *  Begin a pass recomputing walls, trims or welded edges.
+     * @remark
+     *  Such a pass touches all tiles it might write to, but usually changes few of them. While a pass runs,
+     *  touching does not mark tiles dirty: when the outermost pass ends, only the tiles whose values or
+     *  vertices changed are. Otherwise passes repeating each other would grow the dirty tiles every time.
+     */
+    void begin_derived();
+
+    /**
+     * @brief
+     *  End a pass recomputing walls, trims or welded edges.
+     */
+    void end_derived();
+
     /**
      * @brief
      *  Get the elevation at a point.
@@ -427,6 +534,25 @@ protected:
     void free_vertex_count();
 };
 
+namespace Cartman {
+
+/**
+ * @brief
+ *  Runs a pass recomputing walls, trims or welded edges of a mesh during its lifetime.
+ * @see cartman_mpd_t::begin_derived
+ */
+struct DerivedPass
+{
+    DerivedPass(cartman_mpd_t& mesh);
+    ~DerivedPass();
+    DerivedPass(const DerivedPass&) = delete;
+    DerivedPass& operator=(const DerivedPass&) = delete;
+
+private:
+    cartman_mpd_t& _mesh;
+};
+
+} // namespace Cartman
 
 
 /// @todo Removet his, use cartman_mpd_t::get_vertex(int).
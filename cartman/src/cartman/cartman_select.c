@@ -48,8 +48,25 @@ void select_lst_t::init(cartman_mpd_t *pmesh)
 
 void select_lst_t::clear()
 {
+    for (uint32_t vertex : _which)
+    {
+        _selected[vertex] = false;
+    }
+    _which.clear();
     _count = 0;
-    _which[0] = CHAINEND;
+    _stale = false;
+}
+
+void select_lst_t::compact() const
+{
+    if (!_stale)
+    {
+        return;
+    }
+    // Stable, such that the points remain in the order they were selected.
+    auto end = std::remove_if(_which.begin(), _which.end(), [this](uint32_t vertex) { return !_selected[vertex]; });
+    _which.erase(end, _which.end());
+    _stale = false;
 }
 
 bool select_lst_t::add(int vertex)
@@ -58,70 +75,55 @@ bool select_lst_t::add(int vertex)
 		throw id::runtime_error(__FILE__, __LINE__, "vertex index out of bounds");
 	}
 
-    // Is the vertex index in the list?
-    int index = find(vertex);
-	if (-1 != index)
+    if (_selected.empty())
+    {
+        _selected.resize(MAP_VERTICES_MAX, false);
+    }
+	if (_selected[vertex])
 	{
 		// The vertex is already in the list. => Do nothing and return false.
 		return false;
 	}
-	else
-	{
-		// The vertex index is not in the list. => Append it and return true.
-        _which[_count] = vertex;
-        _count++;
-
-        if (_count < MAP_VERTICES_MAX)
-        {
-			_which[_count] = CHAINEND;
-        }
-		return true;
-    }
+	// The vertex index is not in the list. => Append it and return true.
+    // The vertex might have an old entry, remove the old entries first.
+    compact();
+    _selected[vertex] = true;
+    _which.push_back(vertex);
+    _count++;
+	return true;
 }
 
 bool select_lst_t::remove(int vertex)
 {
-    int index = find(vertex);
-	if (-1 == index)
+	if (!contains(vertex))
 	{
 		// The vertex is not in the list. => Do nothing and return false.
 		return false;
 	}
-	else
-	{
-        // The vertex is in the list. => Remove it and return true.
-        if (_count > 1 )
-        {
-            for (int i = index; i < _count - 1; ++i)
-            {
-				_which[i] = _which[i-1];
-            }
-        }
-
-        // blank out the last vertex
-		_which[_count] = CHAINEND;
-
-        // shorten the chain
-        _count--;
-		return true;
-    }
+    // The vertex is in the list. => Remove it and return true.
+    // Its entry in the list of indices is removed by the next compaction.
+    _selected[vertex] = false;
+    _stale = true;
+    _count--;
+	return true;
 }
 
 int select_lst_t::find(int vertex) const
 {
-	if (!CART_VALID_VERTEX_RANGE(vertex)) {
-		throw id::runtime_error(__FILE__, __LINE__, "vertex index out of bounds");
-	}
-
-    for (int i = 0; i < _count; ++i)
+    if (!contains(vertex))
     {
-        if (vertex == _which[i])
-        {
-            return i;
-        }
+        return -1;
     }
+    compact();
+    return std::find(_which.begin(), _which.end(), (uint32_t)vertex) - _which.begin();
+}
 
-    return -1;
+bool select_lst_t::contains(int vertex) const
+{
+	if (!CART_VALID_VERTEX_RANGE(vertex)) {
+		throw id::runtime_error(__FILE__, __LINE__, "vertex index out of bounds");
+	}
+    return !_selected.empty() && _selected[vertex];
 }
 
 int select_lst_t::count() const
@@ -26,23 +26,30 @@
 
 struct select_lst_t
 {
-	/// The maximum number of points that can be selected.
-	static constexpr size_t MAXSELECT = 2560;
 private:
 	/// The mesh to to which the selection applies.
     cartman_mpd_t *_pmesh;
-	/// The actualnumber of points selected.
+	/// The actual number of points selected.
     int _count;
-	/// An array of indices of selected points.
-    uint32_t _which[MAXSELECT];
+	/// The indices of the selected points in the order they were selected.
+	/// Points removed since the last compaction are still in this list.
+    mutable std::vector<uint32_t> _which;
+	/// Bit @a i is set if the vertex of index @a i is selected.
+	/// Empty until the first point is selected.
+    std::vector<bool> _selected;
+	/// If points were removed since the last compaction.
+    mutable bool _stale;
+	/// Remove the points no longer selected from the list of indices.
+    void compact() const;
 public:
 	select_lst_t()
-		: _pmesh(nullptr), _count(0), _which{ CHAINEND } {
+		: _pmesh(nullptr), _count(0), _which(), _selected(), _stale(false) {
 	}
 	static int at(select_lst_t& self, int index) {
 		if (index < 0 || index >= self.count()) {
 			throw id::runtime_error(__FILE__, __LINE__, "index out of bounds");
 		}
+		self.compact();
 		return self._which[index];
 	}
 
@@ -81,6 +88,15 @@ public:
 	 *  the index of the vertex in the selection list if it was found, -1 otherwise
 	 */
 	int find(int vertex) const;
+	/**
+	 * @brief
+	 *  Get if a vertex is in this selection list.
+	 * @param vertex
+	 *  the vertex index
+	 * @return
+	 *  @a true if the vertex is in this selection list, @a false otherwise
+	 */
+	bool contains(int vertex) const;
 	/**
 	 * @brief
 	 *  Get the number of vertices in this selection list.
@@ -64,9 +64,11 @@ static const std::array<const char*, GSND_COUNT> wavenames =
 AudioSystem::AudioSystem() :
     _musicLoaded(),
     _musicIDToNameMap(),
-    _soundsLoaded(),
+    _soundBank(),
+    _voices(),
     _globalSounds(),
     _loopingSounds(),
+    _loopingSoundsByChannel(),
     _currentSongPlaying(),
     _maxSoundDistance(DEFAULT_MAX_DISTANCE)
 {
@@ -89,7 +91,8 @@ AudioSystem::AudioSystem() :
         else
         {
             setMusicVolume(egoboo_config_t::get().sound_music_volume.getValue());
-            Mix_AllocateChannels(egoboo_config_t::get().sound_channel_count.getValue());
+            _soundBank.setDecodedBudget(size_t(egoboo_config_t::get().sound_decodedBudget_megabytes.getValue()) * 1024 * 1024);
+            allocateChannels(egoboo_config_t::get().sound_channel_count.getValue());
 
             // Check if we can load OGG Vorbis music (this is non-fatal, game runs fine without music).
             Log::get() << Log::Entry::create(Log::Level::Info, __FILE__, __LINE__, "initializing SDL mixer OGG audio services", Log::EndOfEntry);
@@ -138,6 +141,12 @@ void AudioSystem::loadGlobalSounds()
             _globalSounds[cnt] = sound;
         }
     }
+
+    // User interface and progression feedback must not be drowned out by combat sounds.
+    for (GlobalSound sound : { GSND_BUTTON_CLICK, GSND_GUI_HOVER, GSND_GAME_READY, GSND_LEVELUP, GSND_PERK_SELECT })
+    {
+        setSoundPriority(_globalSounds[sound], SoundPriority::High);
+    }
 }
 
 AudioSystem::~AudioSystem()
@@ -148,12 +157,17 @@ AudioSystem::~AudioSystem()
     _musicLoaded.clear();
     _musicIDToNameMap.clear();
 
-    for (Mix_Chunk *chunk : _soundsLoaded)
-    {
-        Mix_FreeChunk(chunk);
-    }
-    _soundsLoaded.clear();
+    const SoundBankStatistics& statistics = _soundBank.getStatistics();
+    Log::get() << Log::Entry::create(Log::Level::Info, __FILE__, __LINE__, "sound bank: ", statistics.sounds, " distinct sounds, ",
+                                     statistics.duplicates, " of ", statistics.requests, " loaded sounds were duplicates, ",
+                                     statistics.encodedBytes, " bytes encoded, ", statistics.decodedBytes, " bytes decoded, ",
+                                     statistics.decodes, " decodes, ", statistics.evictions, " evictions", Log::EndOfEntry);
     _loopingSounds.clear();
+    _loopingSoundsByChannel.clear();
+
+    // Release the decoded sounds while the mixer is still open.
+    Mix_HaltChannel(-1);
+    _soundBank.releaseDecoded();
 
 	Mix_CloseAudio();
 }
@@ -162,13 +176,14 @@ void AudioSystem::download(egoboo_config_t& cfg)
 {
     // Clear all data.
     _loopingSounds.clear();
+    _loopingSoundsByChannel.assign(_loopingSoundsByChannel.size(), nullptr);
 
     // Restore audio if needed
     if (egoboo_config_t::get().sound_effects_enable.getValue() || egoboo_config_t::get().sound_music_enable.getValue())
     {
         if (-1 != Mix_OpenAudio(egoboo_config_t::get().sound_highQuality_enable.getValue() ? MIX_HIGH_QUALITY : MIX_DEFAULT_FREQUENCY, MIX_DEFAULT_FORMAT, MIX_DEFAULT_CHANNELS, egoboo_config_t::get().sound_outputBuffer_size.getValue()))
         {
-            Mix_AllocateChannels(egoboo_config_t::get().sound_channel_count.getValue());
+            allocateChannels(egoboo_config_t::get().sound_channel_count.getValue());
         }
         else
         {
@@ -179,6 +194,8 @@ void AudioSystem::download(egoboo_config_t& cfg)
     //Reset max hearing distance to default
     _maxSoundDistance = DEFAULT_MAX_DISTANCE;
 
+    _soundBank.setDecodedBudget(size_t(egoboo_config_t::get().sound_decodedBudget_megabytes.getValue()) * 1024 * 1024);
+
     // Do we restart the music?
     if (egoboo_config_t::get().sound_music_enable.getValue())
     {
@@ -218,43 +235,14 @@ SoundID AudioSystem::loadSound(const std::string &fileName)
         return INVALID_SOUND_ID;
     }
 
-    // blank out the data
-    std::string fullFileName;
-    Mix_Chunk* loadedSound = nullptr;
-    bool fileExists = false;
-
-    // try an ogg file
-    fullFileName = fileName + ".ogg";
-    if (vfs_exists(fullFileName.c_str()))
-    {
-        fileExists = true;
-        loadedSound = Mix_LoadWAV_RW(vfs_openRWopsRead(fullFileName.c_str()), 1);
-    }
-
-    //OGG failed, try WAV instead
-    if (nullptr == loadedSound)
-    {
-        fullFileName = fileName + ".wav";
-        if (vfs_exists(fullFileName.c_str()))
-        {
-            fileExists = true;
-            loadedSound = Mix_LoadWAV_RW(vfs_openRWopsRead(fullFileName.c_str()), 1);
-        }
-    }
-
-    if (nullptr == loadedSound)
-    {
-        // there is an error only if the file exists and can't be loaded
-        if (fileExists) {
-			Log::get() << Log::Entry::create(Log::Level::Warning, __FILE__, __LINE__, "unable to load sound file ", "`", fileName, "`: ", Mix_GetError(), Log::EndOfEntry);
-        }
-
-        return INVALID_SOUND_ID;
-    }
+    // The sound bank reads the file and shares it with identical sounds,
+    // the sound is decoded when it is played for the first time.
+    return _soundBank.load(fileName);
+}
 
-    //Sound loaded!
-    _soundsLoaded.push_back(loadedSound);
-    return _soundsLoaded.size() - 1;
+const SoundBankStatistics& AudioSystem::getSoundBankStatistics() const
+{
+    return _soundBank.getStatistics();
 }
 
 MusicID AudioSystem::loadMusic(const std::string &fileName)
@@ -347,7 +335,87 @@ void AudioSystem::loadAllMusic()
     }
 }
 
-void AudioSystem::updateLoopingSound(const std::shared_ptr<LoopingSound> &sound)
+void AudioSystem::allocateChannels(int count)
+{
+    count = Mix_AllocateChannels(count);
+    _voices.setChannelCount(count);
+    _loopingSoundsByChannel.assign(count, nullptr);
+}
+
+int AudioSystem::playChannel(const SoundID soundID, const float distance, const std::shared_ptr<LoopingSound>& loop)
+{
+    // Forget the channels which have stopped playing.
+    collectChannels();
+
+    // Ask the voice manager for a channel.
+    VoiceManager::Allocation allocation = _voices.allocate(soundID, distance);
+    if (VoiceManager::INVALID_CHANNEL == allocation.channel) {
+        return INVALID_SOUND_CHANNEL;
+    }
+
+    // Decode the sound if required.
+    Mix_Chunk *chunk = _soundBank.acquire(soundID);
+    if (!chunk) {
+        return INVALID_SOUND_CHANNEL;
+    }
+
+    // Take the channel from the sound playing on it.
+    if (allocation.stolen) {
+        stopChannel(allocation.channel);
+    }
+
+    int channel = Mix_PlayChannel(allocation.channel, chunk, loop ? -1 : 0);
+    if (INVALID_SOUND_CHANNEL == channel) {
+        return INVALID_SOUND_CHANNEL;
+    }
+
+    _voices.bind(channel, soundID, distance, nullptr != loop, allocation.stolen);
+    detachLoopingSound(channel);
+    _loopingSoundsByChannel[channel] = loop;
+    return channel;
+}
+
+void AudioSystem::stopChannel(const int channel)
+{
+    if (channel < 0 || static_cast<size_t>(channel) >= _loopingSoundsByChannel.size()) {
+        return;
+    }
+    Mix_HaltChannel(channel);
+    _voices.release(channel);
+    detachLoopingSound(channel);
+}
+
+void AudioSystem::collectChannels()
+{
+    for (int channel : _voices.collect([](int channel) { return 0 != Mix_Playing(channel); })) {
+        detachLoopingSound(channel);
+    }
+}
+
+void AudioSystem::detachLoopingSound(const int channel)
+{
+    if (channel < 0 || static_cast<size_t>(channel) >= _loopingSoundsByChannel.size()) {
+        return;
+    }
+    // If the channel was playing a looping sound, it lost its channel.
+    std::shared_ptr<LoopingSound> loop = std::move(_loopingSoundsByChannel[channel]);
+    _loopingSoundsByChannel[channel] = nullptr;
+    if (loop && channel == loop->getChannel()) {
+        loop->setChannel(INVALID_SOUND_CHANNEL);
+    }
+}
+
+void AudioSystem::setSoundPriority(const SoundID soundID, const SoundPriority priority)
+{
+    _voices.setPriority(soundID, priority);
+}
+
+void AudioSystem::setSoundMaxInstances(const SoundID soundID, const size_t maxInstances)
+{
+    _voices.setMaxInstances(soundID, maxInstances);
+}
+
+bool AudioSystem::updateLoopingSound(const std::shared_ptr<LoopingSound> &sound)
 {
     int channel = sound->getChannel();
 
@@ -356,11 +424,10 @@ void AudioSystem::updateLoopingSound(const std::shared_ptr<LoopingSound> &sound)
 
         //Stop loop if we just died
         if (channel != INVALID_SOUND_CHANNEL) {
-            Mix_HaltChannel(channel);
-            sound->setChannel(INVALID_SOUND_CHANNEL);
+            stopChannel(channel);
         }
 
-        return;
+        return false;
     }
 
     const Vector3f soundPosition = _currentModule->getObjectHandler().get(sound->getOwnerRef())->getPosition();
@@ -369,14 +436,15 @@ void AudioSystem::updateLoopingSound(const std::shared_ptr<LoopingSound> &sound)
     //Sound is close enough to be heard?
     if (distance < _maxSoundDistance)
     {
-        //No channel allocated to this sound yet? try to allocate a free one
+        //No channel allocated to this sound yet? try to allocate one
         if (channel == INVALID_SOUND_CHANNEL) {
-            channel = Mix_PlayChannel(-1, _soundsLoaded[sound->getSoundID()], -1);
+            channel = playChannel(sound->getSoundID(), distance, sound);
         }
 
         //Update sound effects
         if (channel != INVALID_SOUND_CHANNEL) {
             mixAudioPosition3D(channel, distance, soundPosition);
+            _voices.setDistance(channel, distance);
             sound->setChannel(channel);
         }
     }
@@ -384,21 +452,35 @@ void AudioSystem::updateLoopingSound(const std::shared_ptr<LoopingSound> &sound)
     {
         //We are too far away to hear sound, stop it and free 
         //channel until we come closer again
-        Mix_HaltChannel(channel);
-        sound->setChannel(INVALID_SOUND_CHANNEL);
+        stopChannel(channel);
     }
+
+    return true;
 }
 
 void AudioSystem::updateLoopingSounds()
 {
-    for (const std::shared_ptr<LoopingSound> &sound : _loopingSounds)
+    for (auto it = _loopingSounds.begin(); it != _loopingSounds.end();)
     {
-        updateLoopingSound(sound);
+        bool alive = false;
+        for (const std::shared_ptr<LoopingSound> &sound : it->second)
+        {
+            alive = updateLoopingSound(sound);
+        }
+
+        // Forget the looping sounds of owners which no longer exist.
+        if (!alive) {
+            it = _loopingSounds.erase(it);
+        } else {
+            ++it;
+        }
     }
 }
 
 void AudioSystem::update()
 {
+    // Looping sounds whose channels were faded out or halted are restarted.
+    collectChannels();
     updateLoopingSounds();
 }
 
@@ -406,24 +488,29 @@ size_t AudioSystem::stopObjectLoopingSounds(ObjectRef ownerRef, const SoundID so
 	if (!_currentModule->getObjectHandler().exists(ownerRef)) {
 		return 0;
 	}
-	size_t removedLoopCount = 0;
-    std::forward_list<std::shared_ptr<LoopingSound>> removeLoops;
-    for (const std::shared_ptr<LoopingSound> &sound : _loopingSounds) {
-        // Either the sound ID must match or if INVALID_SOUND_ID is given,
-        // stop all sounds that this character owns.
-        if (soundID != INVALID_SOUND_ID && sound->getSoundID() != soundID) {
+    auto it = _loopingSounds.find(ownerRef);
+    if (it == _loopingSounds.end()) {
+        return 0;
+    }
+
+    // Either the sound ID must match or if INVALID_SOUND_ID is given,
+    // stop all sounds that this character owns.
+    std::vector<std::shared_ptr<LoopingSound>>& sounds = it->second;
+    size_t removedLoopCount = 0;
+    for (auto sound = sounds.begin(); sound != sounds.end();) {
+        if (soundID != INVALID_SOUND_ID && (*sound)->getSoundID() != soundID) {
+            ++sound;
             continue;
         }
-        if (sound->getOwnerRef() == ownerRef) {
-            removeLoops.push_front(sound);
-			removedLoopCount++;
+        if ((*sound)->getChannel() != INVALID_SOUND_CHANNEL) {
+            stopChannel((*sound)->getChannel());
         }
+        sound = sounds.erase(sound);
+        removedLoopCount++;
     }
 
-    // Remove all looping sounds from list.
-    for (const std::shared_ptr<LoopingSound> &sound : removeLoops) {
-        _loopingSounds.remove(sound);
-        Mix_HaltChannel(sound->getChannel());
+    if (sounds.empty()) {
+        _loopingSounds.erase(it);
     }
 
     return removedLoopCount;
@@ -437,7 +524,7 @@ void AudioSystem::fadeAllSounds()
 
 int AudioSystem::playSoundFull(SoundID soundID)
 {
-    if (soundID < 0 || soundID >= _soundsLoaded.size())
+    if (!_soundBank.isValid(soundID))
     {
         return INVALID_SOUND_CHANNEL;
     }
@@ -447,8 +534,8 @@ int AudioSystem::playSoundFull(SoundID soundID)
         return INVALID_SOUND_CHANNEL;
     }
 
-    // play the sound
-    int channel = Mix_PlayChannel(-1, _soundsLoaded[soundID], 0);
+    // play the sound, it is not positional so it is as close as possible
+    int channel = playChannel(soundID, 0.0f, nullptr);
 
     if (channel != INVALID_SOUND_CHANNEL) {
         //remove any 3D positional mixing effects
@@ -511,14 +598,15 @@ void AudioSystem::playSoundLooped(const SoundID soundID, ObjectRef ownerRef)
     }
 
     // Check for invalid sounds
-    if (soundID < 0 || soundID >= _soundsLoaded.size()) {
+    if (!_soundBank.isValid(soundID)) {
         return;
     }
 
     //Only allow one looping sound instance per character
-    for (const std::shared_ptr<LoopingSound> &sound : _loopingSounds)
+    std::vector<std::shared_ptr<LoopingSound>>& sounds = _loopingSounds[ownerRef];
+    for (const std::shared_ptr<LoopingSound> &sound : sounds)
     {
-        if (sound->getOwnerRef() == ownerRef && sound->getSoundID() == soundID) {
+        if (sound->getSoundID() == soundID) {
             return;
         }
     }
@@ -526,8 +614,8 @@ void AudioSystem::playSoundLooped(const SoundID soundID, ObjectRef ownerRef)
     //Create new looping sound
     std::shared_ptr<LoopingSound> sound = std::make_shared<LoopingSound>(ownerRef, soundID);
 
-    // add the sound to the LoopedList
-    _loopingSounds.push_front(sound);
+    // add the sound to the looping sounds of its owner
+    sounds.push_back(sound);
 
     //First time update
     updateLoopingSound(sound);
@@ -536,7 +624,7 @@ void AudioSystem::playSoundLooped(const SoundID soundID, ObjectRef ownerRef)
 int AudioSystem::playSound(const Vector3f& snd_pos, const SoundID soundID)
 {
     // If the sound ID is not valid ...
-    if (soundID < 0 || soundID >= _soundsLoaded.size())
+    if (!_soundBank.isValid(soundID))
     {
         // ... return invalid channel.
         return INVALID_SOUND_CHANNEL;
@@ -559,9 +647,9 @@ int AudioSystem::playSound(const Vector3f& snd_pos, const SoundID soundID)
     }
 
     // Play the sound once
-    int channel = Mix_PlayChannel(-1, _soundsLoaded[soundID], 0);
+    int channel = playChannel(soundID, distance, nullptr);
 
-    // could fail if no free channels are available.
+    // could fail if no channel could be taken from a less important sound.
     if (INVALID_SOUND_CHANNEL != channel)
     {
         // Apply 3D positional sound effect.
@@ -25,12 +25,12 @@
 #include "egolib/egoboo_setup.h"
 #include "egolib/Math/_Include.hpp"
 #include "egolib/Core/Singleton.hpp"
+#include "egolib/Audio/SoundBank.hpp"
+#include "egolib/Audio/VoiceManager.hpp"
 
 typedef int MusicID;
-typedef int SoundID;
 
 static constexpr int INVALID_SOUND_CHANNEL = -1;
-static constexpr SoundID INVALID_SOUND_ID = -1;
 
 /// Data needed to store and manipulate a looped sound
 class LoopingSound
@@ -148,8 +148,24 @@ public:
     **/
     void playMusic(const std::string& songName, const uint16_t fadetime = 0);
 
+    /**
+     * @brief
+     *  Load a sound effect.
+     * @param fileName
+     *  the file name of the sound without extension
+     * @return
+     *  the sound ID, INVALID_SOUND_ID on failure
+     * @remark
+     *  Identical sound files share one sound ID. The sound is decoded when it is played first.
+     */
     SoundID loadSound(const std::string &fileName);
 
+    /**
+     * @brief
+     *  Get the memory usage and activity of the sound bank.
+     */
+    const SoundBankStatistics& getSoundBankStatistics() const;
+
     /// @author ZF
     /// @details This function loads all of the music sounds
     void loadAllMusic();
@@ -212,6 +228,26 @@ public:
     /// @details This function plays a specified sound at full possible volume and returns which channel it's using
     int playSoundFull(SoundID soundID);
 
+    /**
+     * @brief
+     *  Set the priority of a sound. A sound may take the channel of a sound with a lower priority.
+     * @param soundID
+     *  the sound ID
+     * @param priority
+     *  the priority. The default priority is SoundPriority::Normal.
+     */
+    void setSoundPriority(const SoundID soundID, const SoundPriority priority);
+
+    /**
+     * @brief
+     *  Set the upper bound of instances of a sound playing at the same time.
+     * @param soundID
+     *  the sound ID
+     * @param maxInstances
+     *  the upper bound. The default is VoiceManager::DEFAULT_MAX_INSTANCES.
+     */
+    void setSoundMaxInstances(const SoundID soundID, const size_t maxInstances);
+
     inline SoundID getGlobalSound(GlobalSound id) const
     {
         return _globalSounds[id];
@@ -277,16 +313,60 @@ private:
      *  Updates one looping sound effect.
      * @param sound
      *  the looping sound effect
+     * @return
+     *  @a false if the owner of the looping sound effect no longer exists, @a true otherwise
+     */
+    bool updateLoopingSound(const std::shared_ptr<LoopingSound>& sound);
+
+    /**
+     * @brief
+     *  Allocate mixer channels and reset the voice management.
      */
-    void updateLoopingSound(const std::shared_ptr<LoopingSound>& sound);
+    void allocateChannels(int count);
+
+    /**
+     * @brief
+     *  Play a sound on the channel selected by the voice manager.
+     * @param soundID
+     *  the sound ID
+     * @param distance
+     *  the distance between the sound origin and the listener
+     * @param loop
+     *  the looping sound if the sound should be looped, a null pointer otherwise
+     * @return
+     *  the channel the sound is played over, INVALID_SOUND_CHANNEL if it is not played
+     */
+    int playChannel(const SoundID soundID, const float distance, const std::shared_ptr<LoopingSound>& loop);
+
+    /**
+     * @brief
+     *  Halt a channel and forget about the sound playing on it.
+     */
+    void stopChannel(const int channel);
+
+    /**
+     * @brief
+     *  Forget the sounds on the channels which stopped playing, e.g. because they were faded out.
+     *  Looping sounds which lost their channel are restarted by the next update.
+     */
+    void collectChannels();
+
+    /**
+     * @brief
+     *  Detach the looping sound from a channel, if any. The looping sound no longer has a channel.
+     */
+    void detachLoopingSound(const int channel);
 
 private:
     std::unordered_map<std::string, Mix_Music*> _musicLoaded;    //Maps song names to music data
     std::unordered_map<MusicID, std::string> _musicIDToNameMap;   //Maps MusicID to song names
-    std::vector<Mix_Chunk*> _soundsLoaded;
+    SoundBank _soundBank;                                             ///< All loaded sound effects
+    VoiceManager _voices;                                             ///< Decides which channel a sound is played on
     std::array<SoundID, GSND_COUNT> _globalSounds;
 
-    std::forward_list<std::shared_ptr<LoopingSound>> _loopingSounds;
+
+    std::unordered_map<ObjectRef, std::vector<std::shared_ptr<LoopingSound>>> _loopingSounds;   ///< Looping sounds by owner
+    std::vector<std::shared_ptr<LoopingSound>> _loopingSoundsByChannel;                         ///< Looping sounds by channel
     std::string _currentSongPlaying;
     float _maxSoundDistance;                                            ///< How far away can we hear sound effects?
 };
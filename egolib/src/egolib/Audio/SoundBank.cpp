@@ -0,0 +1,283 @@
+//********************************************************************************************
+//*
+//*    This file is part of Egoboo.
+//*
+//*    Egoboo is free software: you can redistribute it and/or modify it
+//*    under the terms of the GNU General Public License as published by
+//*    the Free Software Foundation, either version 3 of the License, or
+//*    (at your option) any later version.
+//*
+//*    Egoboo is distributed in the hope that it will be useful, but
+//*    WITHOUT ANY WARRANTY; without even the implied warranty of
+//*    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+//*    General Public License for more details.
+//*
+//*    You should have received a copy of the GNU General Public License
+//*    along with Egoboo.  If not, see <http://www.gnu.org/licenses/>.
+//*
+//********************************************************************************************
+
+/// @file egolib/Audio/SoundBank.cpp
+/// @brief A deduplicated bank of sound effects which are decoded on demand.
+
+#include "egolib/Audio/SoundBank.hpp"
+
+#include "egolib/vfs.h"
+#include "egolib/Log/_Include.hpp"
+
+SoundBank::SoundBank() :
+    _sounds(),
+    _index(),
+    _lru(),
+    _statistics()
+{
+    _statistics.decodedBudget = DEFAULT_DECODED_BUDGET;
+}
+
+SoundBank::~SoundBank()
+{
+    for (Sound& sound : _sounds)
+    {
+        if (sound.decoded)
+        {
+            Mix_FreeChunk(sound.decoded);
+            sound.decoded = nullptr;
+        }
+    }
+    _sounds.clear();
+    _index.clear();
+    _lru.clear();
+}
+
+SoundID SoundBank::load(const std::string& fileName)
+{
+    // Read the contents of the file, try an ogg file first and a wav file second.
+    char *data = nullptr;
+    size_t size = 0;
+    std::string fullFileName = fileName + ".ogg";
+    if (!readFile(fullFileName, &data, &size))
+    {
+        fullFileName = fileName + ".wav";
+        if (!readFile(fullFileName, &data, &size))
+        {
+            return INVALID_SOUND_ID;
+        }
+    }
+    std::unique_ptr<char, decltype(&std::free)> guard(data, &std::free);
+
+    _statistics.requests++;
+
+    // Is an identical sound already in the bank?
+    const uint64_t contentHash = hash(data, size);
+    SoundID soundID = find(contentHash, data, size);
+    if (INVALID_SOUND_ID != soundID)
+    {
+        _statistics.duplicates++;
+        return soundID;
+    }
+
+    // Add a new sound to the bank.
+    Sound sound;
+    sound.fileName = fullFileName;
+    sound.encoded.assign(data, data + size);
+    sound.decoded = nullptr;
+    sound.broken = false;
+    sound.lru = _lru.end();
+
+    soundID = static_cast<SoundID>(_sounds.size());
+    _sounds.push_back(std::move(sound));
+    _index.emplace(contentHash, soundID);
+
+    _statistics.sounds = _sounds.size();
+    _statistics.encodedBytes += size;
+
+    return soundID;
+}
+
+Mix_Chunk *SoundBank::acquire(const SoundID soundID)
+{
+    if (!isValid(soundID))
+    {
+        return nullptr;
+    }
+
+    Sound& sound = _sounds[soundID];
+
+    // Already decoded? Move it to the front of the LRU list.
+    if (sound.decoded)
+    {
+        _lru.splice(_lru.begin(), _lru, sound.lru);
+        return sound.decoded;
+    }
+    // Do not try again (and warn again) if the sound could not be decoded before.
+    if (sound.broken)
+    {
+        return nullptr;
+    }
+
+    // Decode it, the fallback if the sound fell back to it before.
+    sound.decoded = decode(sound.fallback.empty() ? sound.encoded : sound.fallback);
+    if (!sound.decoded && sound.fallback.empty())
+    {
+        Log::get() << Log::Entry::create(Log::Level::Warning, __FILE__, __LINE__, "unable to load sound file ", "`", sound.fileName, "`: ", Mix_GetError(), Log::EndOfEntry);
+        // An ogg file which can not be decoded falls back to the wav file of the same name.
+        static const std::string ogg = ".ogg";
+        if (sound.fileName.size() >= ogg.size() && 0 == sound.fileName.compare(sound.fileName.size() - ogg.size(), ogg.size(), ogg))
+        {
+            const std::string fallbackFileName = sound.fileName.substr(0, sound.fileName.size() - ogg.size()) + ".wav";
+            char *data = nullptr;
+            size_t size = 0;
+            if (readFile(fallbackFileName, &data, &size))
+            {
+                std::unique_ptr<char, decltype(&std::free)> guard(data, &std::free);
+                std::vector<char> fallback(data, data + size);
+                sound.decoded = decode(fallback);
+                if (sound.decoded)
+                {
+                    // Keep the wav file for later decodes. The ogg file is kept as well: The sound is
+                    // identified by the contents of the ogg file when the same file is loaded again.
+                    _statistics.encodedBytes += fallback.size();
+                    sound.fallback.swap(fallback);
+                }
+                else
+                {
+                    Log::get() << Log::Entry::create(Log::Level::Warning, __FILE__, __LINE__, "unable to load sound file ", "`", fallbackFileName, "`: ", Mix_GetError(), Log::EndOfEntry);
+                }
+            }
+        }
+    }
+    if (!sound.decoded)
+    {
+        sound.broken = true;
+        return nullptr;
+    }
+
+    _statistics.decodes++;
+    _statistics.decodedBytes += sound.decoded->alen;
+    _lru.push_front(soundID);
+    sound.lru = _lru.begin();
+
+    // Make room if required.
+    enforceBudget(soundID);
+
+    return sound.decoded;
+}
+
+bool SoundBank::isValid(const SoundID soundID) const
+{
+    return soundID >= 0 && static_cast<size_t>(soundID) < _sounds.size();
+}
+
+void SoundBank::setDecodedBudget(const size_t budget)
+{
+    _statistics.decodedBudget = budget;
+    enforceBudget(INVALID_SOUND_ID);
+}
+
+void SoundBank::releaseDecoded()
+{
+    for (auto it = _lru.begin(); it != _lru.end();)
+    {
+        Sound& sound = _sounds[*it++];
+        if (!isPlaying(sound.decoded))
+        {
+            release(sound);
+        }
+    }
+}
+
+const SoundBankStatistics& SoundBank::getStatistics() const
+{
+    return _statistics;
+}
+
+SoundID SoundBank::find(const uint64_t hash, const char *data, const size_t size) const
+{
+    auto range = _index.equal_range(hash);
+    for (auto it = range.first; it != range.second; ++it)
+    {
+        const Sound& sound = _sounds[it->second];
+        // Guard against hash collisions.
+        if (sound.encoded.size() == size && 0 == std::memcmp(sound.encoded.data(), data, size))
+        {
+            return it->second;
+        }
+    }
+    return INVALID_SOUND_ID;
+}
+
+void SoundBank::release(Sound& sound)
+{
+    if (!sound.decoded)
+    {
+        return;
+    }
+    _statistics.decodedBytes -= sound.decoded->alen;
+    Mix_FreeChunk(sound.decoded);
+    sound.decoded = nullptr;
+    _lru.erase(sound.lru);
+    sound.lru = _lru.end();
+}
+
+void SoundBank::enforceBudget(const SoundID keep)
+{
+    // Walk from the least recently used sound to the most recently used sound.
+    auto it = _lru.end();
+    while (_statistics.decodedBytes > _statistics.decodedBudget && it != _lru.begin())
+    {
+        --it;
+        Sound& sound = _sounds[*it];
+        if (*it == keep || isPlaying(sound.decoded))
+        {
+            continue;
+        }
+        // Erasing invalidates the iterator, so step over it first.
+        it = std::next(it);
+        release(sound);
+        _statistics.evictions++;
+    }
+}
+
+bool SoundBank::isPlaying(const Mix_Chunk *chunk)
+{
+    const int channels = Mix_AllocateChannels(-1);
+    for (int channel = 0; channel < channels; ++channel)
+    {
+        if (Mix_Playing(channel) && Mix_GetChunk(channel) == chunk)
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+bool SoundBank::readFile(const std::string& fileName, char **data, size_t *size)
+{
+    if (vfs_readEntireFile(fileName, data, size))
+    {
+        return true;
+    }
+    // There is an error only if the file exists and can't be read.
+    if (vfs_exists(fileName))
+    {
+        Log::get() << Log::Entry::create(Log::Level::Warning, __FILE__, __LINE__, "unable to load sound file ", "`", fileName, "`", Log::EndOfEntry);
+    }
+    return false;
+}
+
+Mix_Chunk *SoundBank::decode(const std::vector<char>& encoded)
+{
+    SDL_RWops *rw = SDL_RWFromConstMem(encoded.data(), static_cast<int>(encoded.size()));
+    return (nullptr != rw) ? Mix_LoadWAV_RW(rw, 1) : nullptr;
+}
+
+uint64_t SoundBank::hash(const char *data, const size_t size)
+{
+    uint64_t value = 14695981039346656037ULL;
+    for (size_t i = 0; i < size; ++i)
+    {
+        value ^= static_cast<uint8_t>(data[i]);
+        value *= 1099511628211ULL;
+    }
+    return value;
+}
@@ -0,0 +1,164 @@
+//********************************************************************************************
+//*
+//*    This file is part of Egoboo.
+//*
+//*    Egoboo is free software: you can redistribute it and/or modify it
+//*    under the terms of the GNU General Public License as published by
+//*    the Free Software Foundation, either version 3 of the License, or
+//*    (at your option) any later version.
+//*
+//*    Egoboo is distributed in the hope that it will be useful, but
+//*    WITHOUT ANY WARRANTY; without even the implied warranty of
+//*    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+//*    General Public License for more details.
+//*
+//*    You should have received a copy of the GNU General Public License
+//*    along with Egoboo.  If not, see <http://www.gnu.org/licenses/>.
+//*
+//********************************************************************************************
+
+/// @file egolib/Audio/SoundBank.hpp
+/// @brief A deduplicated bank of sound effects which are decoded on demand.
+
+#pragma once
+
+#include <SDL_mixer.h>
+#include "egolib/platform.h"
+
+typedef int SoundID;
+
+static constexpr SoundID INVALID_SOUND_ID = -1;
+
+/// Memory usage and activity of a sound bank.
+struct SoundBankStatistics
+{
+    SoundBankStatistics() :
+        requests(0),
+        duplicates(0),
+        sounds(0),
+        encodedBytes(0),
+        decodedBytes(0),
+        decodedBudget(0),
+        decodes(0),
+        evictions(0)
+    {
+        //ctor
+    }
+
+    size_t requests;      ///< number of sound files loaded into the bank
+    size_t duplicates;    ///< number of loaded sound files which were identical to a sound already in the bank
+    size_t sounds;        ///< number of distinct sounds in the bank
+    size_t encodedBytes;  ///< bytes of encoded (file) data held by the bank
+    size_t decodedBytes;  ///< bytes of decoded PCM data held by the bank
+    size_t decodedBudget; ///< upper bound of decoded PCM data the bank tries to keep
+    size_t decodes;       ///< number of times a sound was decoded
+    size_t evictions;     ///< number of times decoded PCM data was released to stay within the budget
+};
+
+/**
+ * @brief
+ *  A bank of sound effects.
+ * @remark
+ *  The bank stores the encoded file contents of every sound and identifies
+ *  sounds by their contents, so the same sound file shipped by many object
+ *  profiles is held only once and yields the same sound ID.
+ *  The PCM data is decoded when a sound is played for the first time. Decoded
+ *  sounds are kept in least-recently-used order and released when the decoded
+ *  data exceeds the budget. Sounds which are currently playing are never released.
+ * @remark
+ *  The bank is not thread-safe. It must only be used by the thread which drives the audio system.
+ */
+class SoundBank : private id::non_copyable
+{
+public:
+    /// The default budget of decoded PCM data (64 MiB).
+    static constexpr size_t DEFAULT_DECODED_BUDGET = 64 * 1024 * 1024;
+
+    SoundBank();
+    ~SoundBank();
+
+    /**
+     * @brief
+     *  Load a sound into the bank.
+     * @param fileName
+     *  the file name of the sound without extension. A @a .ogg file is preferred over a @a .wav file.
+     * @return
+     *  the sound ID, INVALID_SOUND_ID if no such file exists or it could not be read
+     */
+    SoundID load(const std::string& fileName);
+
+    /**
+     * @brief
+     *  Get the decoded data of a sound, decoding it if necessary.
+     * @param soundID
+     *  the sound ID
+     * @return
+     *  the decoded data, a null pointer if the sound ID is invalid or the sound can not be decoded
+     * @remark
+     *  If an @a .ogg file can not be decoded, the @a .wav file of the same name is used instead.
+     * @remark
+     *  The returned chunk remains valid as long as it is playing on some channel or until the
+     *  next call to this method.
+     */
+    Mix_Chunk *acquire(const SoundID soundID);
+
+    /**
+     * @brief
+     *  Get if a sound ID refers to a sound in this bank.
+     */
+    bool isValid(const SoundID soundID) const;
+
+    /**
+     * @brief
+     *  Set the budget of decoded PCM data.
+     * @param budget
+     *  the budget in bytes
+     */
+    void setDecodedBudget(const size_t budget);
+
+    /**
+     * @brief
+     *  Release the decoded data of all sounds which are not playing.
+     */
+    void releaseDecoded();
+
+    const SoundBankStatistics& getStatistics() const;
+
+private:
+    struct Sound
+    {
+        std::string fileName;                ///< the name of the file the sound was loaded from first
+        std::vector<char> encoded;           ///< the encoded data, identifies the sound
+        std::vector<char> fallback;          ///< the wav data decoded instead of an ogg file which can not be decoded
+        Mix_Chunk *decoded;                  ///< the decoded data or a null pointer
+        bool broken;                         ///< if the sound could not be decoded
+        std::list<SoundID>::iterator lru;    ///< the position in the LRU list if decoded
+    };
+
+    /// Find a sound with the given contents.
+    SoundID find(const uint64_t hash, const char *data, const size_t size) const;
+
+    /// Release the decoded data of a sound.
+    void release(Sound& sound);
+
+    /// Release decoded data in least-recently-used order until the budget is met.
+    void enforceBudget(const SoundID keep);
+
+    /// Read a sound file, warn if it exists but can not be read.
+    static bool readFile(const std::string& fileName, char **data, size_t *size);
+
+    /// Decode a sound file.
+    static Mix_Chunk *decode(const std::vector<char>& encoded);
+
+    /// Get if a decoded chunk is playing on any channel.
+    static bool isPlaying(const Mix_Chunk *chunk);
+
+    /// Compute the 64-bit FNV-1a hash of some data.
+    static uint64_t hash(const char *data, const size_t size);
+
+private:
+    std::vector<Sound> _sounds;
+    std::unordered_multimap<uint64_t, SoundID> _index;   ///< maps content hashes to sound IDs
+    std::list<SoundID> _lru;                             ///< decoded sounds, most recently used first
+    SoundBankStatistics _statistics;
+};
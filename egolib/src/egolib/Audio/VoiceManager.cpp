@@ -0,0 +1,218 @@
+//********************************************************************************************
+//*
+//*    This file is part of Egoboo.
+//*
+//*    Egoboo is free software: you can redistribute it and/or modify it
+//*    under the terms of the GNU General Public License as published by
+//*    the Free Software Foundation, either version 3 of the License, or
+//*    (at your option) any later version.
+//*
+//*    Egoboo is distributed in the hope that it will be useful, but
+//*    WITHOUT ANY WARRANTY; without even the implied warranty of
+//*    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+//*    General Public License for more details.
+//*
+//*    You should have received a copy of the GNU General Public License
+//*    along with Egoboo.  If not, see <http://www.gnu.org/licenses/>.
+//*
+//********************************************************************************************
+
+/// @file egolib/Audio/VoiceManager.cpp
+/// @brief Assignment of sound effects to mixer channels.
+
+#include "egolib/Audio/VoiceManager.hpp"
+
+VoiceManager::VoiceManager() :
+    _voices(),
+    _properties(),
+    _instances(),
+    _defaultProperties{SoundPriority::Normal, DEFAULT_MAX_INSTANCES},
+    _stolenCount(0),
+    _rejectedCount(0)
+{
+    //ctor
+}
+
+void VoiceManager::setChannelCount(const size_t channelCount)
+{
+    _voices.assign(channelCount, Voice{INVALID_SOUND_ID, SoundPriority::Low, 0.0f, false});
+    _instances.clear();
+}
+
+size_t VoiceManager::getChannelCount() const
+{
+    return _voices.size();
+}
+
+void VoiceManager::setPriority(const SoundID soundID, const SoundPriority priority)
+{
+    if (soundID < 0) return;
+    getProperties(soundID).priority = priority;
+}
+
+SoundPriority VoiceManager::getPriority(const SoundID soundID) const
+{
+    return getProperties(soundID).priority;
+}
+
+void VoiceManager::setMaxInstances(const SoundID soundID, const size_t maxInstances)
+{
+    if (soundID < 0) return;
+    getProperties(soundID).maxInstances = std::max<size_t>(1, maxInstances);
+}
+
+size_t VoiceManager::getMaxInstances(const SoundID soundID) const
+{
+    return getProperties(soundID).maxInstances;
+}
+
+const VoiceManager::SoundProperties& VoiceManager::getProperties(const SoundID soundID) const
+{
+    if (soundID < 0 || static_cast<size_t>(soundID) >= _properties.size())
+    {
+        return _defaultProperties;
+    }
+    return _properties[soundID];
+}
+
+VoiceManager::SoundProperties& VoiceManager::getProperties(const SoundID soundID)
+{
+    if (static_cast<size_t>(soundID) >= _properties.size())
+    {
+        _properties.resize(soundID + 1, _defaultProperties);
+    }
+    return _properties[soundID];
+}
+
+bool VoiceManager::mayReplace(const Voice& voice, const SoundPriority priority, const float distance)
+{
+    if (voice.priority != priority)
+    {
+        return voice.priority < priority;
+    }
+    return voice.distance > distance;
+}
+
+VoiceManager::Allocation VoiceManager::allocate(const SoundID soundID, const float distance)
+{
+    const SoundProperties& properties = getProperties(soundID);
+
+    // If the sound has reached its upper bound of instances, it may only replace its farthest instance.
+    if (getInstanceCount(soundID) >= properties.maxInstances)
+    {
+        int farthest = INVALID_CHANNEL;
+        for (size_t i = 0; i < _voices.size(); ++i)
+        {
+            const Voice& voice = _voices[i];
+            if (voice.soundID != soundID || voice.looping) continue;
+            if (INVALID_CHANNEL == farthest || voice.distance > _voices[farthest].distance)
+            {
+                farthest = static_cast<int>(i);
+            }
+        }
+        if (INVALID_CHANNEL != farthest && _voices[farthest].distance > distance)
+        {
+            return Allocation{farthest, true};
+        }
+        _rejectedCount++;
+        return Allocation{INVALID_CHANNEL, false};
+    }
+
+    // Take a free channel, otherwise find the least important voice.
+    int victim = INVALID_CHANNEL;
+    for (size_t i = 0; i < _voices.size(); ++i)
+    {
+        const Voice& voice = _voices[i];
+        if (INVALID_SOUND_ID == voice.soundID)
+        {
+            return Allocation{static_cast<int>(i), false};
+        }
+        if (INVALID_CHANNEL == victim || mayReplace(voice, _voices[victim].priority, _voices[victim].distance))
+        {
+            victim = static_cast<int>(i);
+        }
+    }
+
+    if (INVALID_CHANNEL != victim && mayReplace(_voices[victim], properties.priority, distance))
+    {
+        return Allocation{victim, true};
+    }
+
+    _rejectedCount++;
+    return Allocation{INVALID_CHANNEL, false};
+}
+
+void VoiceManager::bind(const int channel, const SoundID soundID, const float distance, const bool looping, const bool stolen)
+{
+    if (channel < 0 || static_cast<size_t>(channel) >= _voices.size())
+    {
+        return;
+    }
+    release(channel);
+    _voices[channel] = Voice{soundID, getProperties(soundID).priority, distance, looping};
+    _instances[soundID]++;
+    if (stolen)
+    {
+        _stolenCount++;
+    }
+}
+
+void VoiceManager::release(const int channel)
+{
+    if (!isBound(channel))
+    {
+        return;
+    }
+    Voice& voice = _voices[channel];
+    auto it = _instances.find(voice.soundID);
+    if (it != _instances.end() && 0 == --it->second)
+    {
+        _instances.erase(it);
+    }
+    voice.soundID = INVALID_SOUND_ID;
+    voice.looping = false;
+}
+
+void VoiceManager::setDistance(const int channel, const float distance)
+{
+    if (isBound(channel))
+    {
+        _voices[channel].distance = distance;
+    }
+}
+
+bool VoiceManager::isBound(const int channel) const
+{
+    return channel >= 0 && static_cast<size_t>(channel) < _voices.size()
+        && INVALID_SOUND_ID != _voices[channel].soundID;
+}
+
+std::vector<int> VoiceManager::collect(const std::function<bool(int)>& isPlaying)
+{
+    std::vector<int> released;
+    for (size_t i = 0; i < _voices.size(); ++i)
+    {
+        if (INVALID_SOUND_ID != _voices[i].soundID && !isPlaying(static_cast<int>(i)))
+        {
+            release(static_cast<int>(i));
+            released.push_back(static_cast<int>(i));
+        }
+    }
+    return released;
+}
+
+size_t VoiceManager::getInstanceCount(const SoundID soundID) const
+{
+    auto it = _instances.find(soundID);
+    return (it != _instances.end()) ? it->second : 0;
+}
+
+size_t VoiceManager::getStolenCount() const
+{
+    return _stolenCount;
+}
+
+size_t VoiceManager::getRejectedCount() const
+{
+    return _rejectedCount;
+}
@@ -0,0 +1,167 @@
+//********************************************************************************************
+//*
+//*    This file is part of Egoboo.
+//*
+//*    Egoboo is free software: you can redistribute it and/or modify it
+//*    under the terms of the GNU General Public License as published by
+//*    the Free Software Foundation, either version 3 of the License, or
+//*    (at your option) any later version.
+//*
+//*    Egoboo is distributed in the hope that it will be useful, but
+//*    WITHOUT ANY WARRANTY; without even the implied warranty of
+//*    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+//*    General Public License for more details.
+//*
+//*    You should have received a copy of the GNU General Public License
+//*    along with Egoboo.  If not, see <http://www.gnu.org/licenses/>.
+//*
+//********************************************************************************************
+
+/// @file egolib/Audio/VoiceManager.hpp
+/// @brief Assignment of sound effects to mixer channels.
+
+#pragma once
+
+#include "egolib/Audio/SoundBank.hpp"
+
+/// The priority of a sound effect. A sound effect may take the channel of a sound effect with a lower priority.
+enum class SoundPriority : uint8_t
+{
+    Low,
+    Normal,
+    High,
+    Critical
+};
+
+/**
+ * @brief
+ *  The voice manager decides which mixer channel a sound effect is played on.
+ * @remark
+ *  Every sound has a priority and an upper bound of instances playing at the same time.
+ *  If a sound reached its upper bound, the farthest instance of that sound is replaced
+ *  if the new instance is closer. If no channel is free, the channel playing the sound
+ *  with the lowest priority is taken, farther sounds are taken before closer sounds.
+ *  A sound never takes the channel of a sound with a higher priority.
+ * @remark
+ *  The voice manager only does the bookkeeping, it does not talk to the mixer.
+ *  The caller halts the channel of a stolen voice, plays the sound and reports back.
+ */
+class VoiceManager : private id::non_copyable
+{
+public:
+    /// The default upper bound of instances of one sound playing at the same time.
+    static constexpr size_t DEFAULT_MAX_INSTANCES = 4;
+
+    /// The result of a channel allocation.
+    struct Allocation
+    {
+        int channel;    ///< the channel to play the sound on, INVALID_CHANNEL if the sound should not be played
+        bool stolen;    ///< if the channel is playing another sound which must be halted first
+    };
+
+    static constexpr int INVALID_CHANNEL = -1;
+
+    VoiceManager();
+
+    /**
+     * @brief
+     *  Set the number of mixer channels. This forgets all voices.
+     */
+    void setChannelCount(const size_t channelCount);
+
+    size_t getChannelCount() const;
+
+    void setPriority(const SoundID soundID, const SoundPriority priority);
+    SoundPriority getPriority(const SoundID soundID) const;
+
+    void setMaxInstances(const SoundID soundID, const size_t maxInstances);
+    size_t getMaxInstances(const SoundID soundID) const;
+
+    /**
+     * @brief
+     *  Select a channel for a new instance of a sound.
+     * @param soundID
+     *  the sound ID
+     * @param distance
+     *  the distance of the sound to the listener
+     * @return
+     *  the allocation
+     * @remark
+     *  The allocation must be followed by a call to VoiceManager::bind or VoiceManager::release.
+     */
+    Allocation allocate(const SoundID soundID, const float distance);
+
+    /**
+     * @brief
+     *  Record that a sound is playing on a channel.
+     * @param stolen
+     *  VoiceManager::Allocation::stolen of the allocation of the channel,
+     *  the voice is counted as stolen only once the new sound actually plays
+     */
+    void bind(const int channel, const SoundID soundID, const float distance, const bool looping, const bool stolen);
+
+    /**
+     * @brief
+     *  Record that a channel is no longer playing.
+     */
+    void release(const int channel);
+
+    /**
+     * @brief
+     *  Update the distance of the sound playing on a channel.
+     */
+    void setDistance(const int channel, const float distance);
+
+    /**
+     * @brief
+     *  Get if a channel is playing a sound.
+     */
+    bool isBound(const int channel) const;
+
+    /**
+     * @brief
+     *  Release all channels which have stopped playing.
+     * @param isPlaying
+     *  a function which returns if a channel is still playing
+     * @return
+     *  the released channels
+     */
+    std::vector<int> collect(const std::function<bool(int)>& isPlaying);
+
+    /// Get the number of instances of a sound currently playing.
+    size_t getInstanceCount(const SoundID soundID) const;
+
+    /// Get the number of voices that were stolen.
+    size_t getStolenCount() const;
+
+    /// Get the number of sounds that were not played because no suitable channel was available.
+    size_t getRejectedCount() const;
+
+private:
+    struct Voice
+    {
+        SoundID soundID;
+        SoundPriority priority;
+        float distance;
+        bool looping;
+    };
+
+    struct SoundProperties
+    {
+        SoundPriority priority;
+        size_t maxInstances;
+    };
+
+    const SoundProperties& getProperties(const SoundID soundID) const;
+    SoundProperties& getProperties(const SoundID soundID);
+
+    /// Get if a voice may be replaced by a sound of the given priority and distance.
+    static bool mayReplace(const Voice& voice, const SoundPriority priority, const float distance);
+
+    std::vector<Voice> _voices;                      ///< the voice of every channel, soundID is INVALID_SOUND_ID for free channels
+    std::vector<SoundProperties> _properties;        ///< the properties indexed by sound ID
+    std::unordered_map<SoundID, size_t> _instances;  ///< the number of instances playing per sound
+    SoundProperties _defaultProperties;
+    size_t _stolenCount;
+    size_t _rejectedCount;
+};
@@ -0,0 +1,158 @@
+//********************************************************************************************
+//*
+//*    This file is part of Egoboo.
+//*
+//*    Egoboo is free software: you can redistribute it and/or modify it
+//*    under the terms of the GNU General Public License as published by
+//*    the Free Software Foundation, either version 3 of the License, or
+//*    (at your option) any later version.
+//*
+//*    Egoboo is distributed in the hope that it will be useful, but
+//*    WITHOUT ANY WARRANTY; without even the implied warranty of
+//*    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+//*    General Public License for more details.
+//*
+//*    You should have received a copy of the GNU General Public License
+//*    along with Egoboo.  If not, see <http://www.gnu.org/licenses/>.
+//*
+//********************************************************************************************
+
+/// @file   egolib/Core/LruCache.hpp
+/// @brief  A fixed-capacity cache with least-recently-used eviction.
+
+#pragma once
+
+#include "egolib/platform.h"
+
+namespace Ego
+{
+namespace Core
+{
+
+/**
+ * @brief
+ *  A cache of at most @a capacity entries. Lookup, insertion and eviction are O(1):
+ *  a hash map indexes a list of entries kept in most-recently-used-first order.
+ * @tparam KeyType
+ *  the key type, must be equality comparable and hashable by @a HashType
+ * @tparam ValueType
+ *  the value type
+ */
+template <typename KeyType, typename ValueType, typename HashType = std::hash<KeyType>>
+class LruCache : private id::non_copyable
+{
+public:
+    /**
+     * @brief
+     *  Construct this cache.
+     * @param capacity
+     *  the maximum number of entries, 0 disables caching
+     */
+    explicit LruCache(const size_t capacity) :
+        _capacity(capacity),
+        _entries(),
+        _index()
+    {
+        _index.reserve(capacity);
+    }
+
+    /**
+     * @brief
+     *  Find the value of a key and mark it as the most recently used entry.
+     * @return
+     *  a pointer to the value, a null pointer if the key is not in the cache
+     * @remark
+     *  The pointer remains valid until the entry is evicted or the cache is cleared.
+     */
+    ValueType *find(const KeyType& key)
+    {
+        auto it = _index.find(key);
+        if (it == _index.end())
+        {
+            return nullptr;
+        }
+        _entries.splice(_entries.begin(), _entries, it->second);
+        return &(it->second->second);
+    }
+
+    /**
+     * @brief
+     *  Insert or replace the value of a key and mark it as the most recently used entry.
+     *  If the cache is full, the least recently used entry is evicted.
+     * @return
+     *  a reference to the stored value
+     * @remark
+     *  If the capacity is 0, the value is stored in a single scratch entry which is
+     *  replaced by the next insertion.
+     */
+    ValueType& insert(const KeyType& key, ValueType value)
+    {
+        auto it = _index.find(key);
+        if (it != _index.end())
+        {
+            _entries.splice(_entries.begin(), _entries, it->second);
+            it->second->second = std::move(value);
+            return it->second->second;
+        }
+        if (0 == _capacity)
+        {
+            _entries.clear();
+            _entries.emplace_front(key, std::move(value));
+            return _entries.front().second;
+        }
+        if (_index.size() >= _capacity)
+        {
+            // Recycle the least recently used entry.
+            auto last = std::prev(_entries.end());
+            _index.erase(last->first);
+            last->first = key;
+            last->second = std::move(value);
+            _entries.splice(_entries.begin(), _entries, last);
+        }
+        else
+        {
+            _entries.emplace_front(key, std::move(value));
+        }
+        _index.emplace(key, _entries.begin());
+        return _entries.front().second;
+    }
+
+    /**
+     * @brief
+     *  Remove all entries.
+     */
+    void clear()
+    {
+        _index.clear();
+        _entries.clear();
+    }
+
+    /**
+     * @brief
+     *  Get the number of entries.
+     */
+    size_t size() const
+    {
+        return _index.size();
+    }
+
+    /**
+     * @brief
+     *  Get the maximum number of entries.
+     */
+    size_t getCapacity() const
+    {
+        return _capacity;
+    }
+
+private:
+    using Entry = std::pair<KeyType, ValueType>;
+    using EntryList = std::list<Entry>;
+
+    size_t _capacity;
+    EntryList _entries;                                                         ///< the entries, most recently used first
+    std::unordered_map<KeyType, typename EntryList::iterator, HashType> _index; ///< maps keys to entries
+};
+
+} // namespace Core
+} // namespace Ego
@@ -0,0 +1,177 @@
+//********************************************************************************************
+//*
+//*    This file is part of Egoboo.
+//*
+//*    Egoboo is free software: you can redistribute it and/or modify it
+//*    under the terms of the GNU General Public License as published by
+//*    the Free Software Foundation, either version 3 of the License, or
+//*    (at your option) any later version.
+//*
+//*    Egoboo is distributed in the hope that it will be useful, but
+//*    WITHOUT ANY WARRANTY; without even the implied warranty of
+//*    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+//*    General Public License for more details.
+//*
+//*    You should have received a copy of the GNU General Public License
+//*    along with Egoboo.  If not, see <http://www.gnu.org/licenses/>.
+//*
+//********************************************************************************************
+
+
+/// @file   egolib/Core/RingBuffer.hpp
+/// @brief  A fixed-capacity, lock-free multi-producer queue.
+
+#pragma once
+
+#include "egolib/platform.h"
+
+namespace Ego
+{
+namespace Core
+{
+
+/**
+ * @brief
+ *  A queue of at most @a capacity elements. Any number of threads may push elements concurrently
+ *  while a single thread pops them. Neither operation blocks or takes a lock: each slot carries a
+ *  sequence number which tells producers and the consumer whether the slot is free or filled.
+ * @tparam ValueType
+ *  the value type, must be default constructible and move assignable
+ */
+template <typename ValueType>
+class RingBuffer : private id::non_copyable
+{
+public:
+    /**
+     * @brief
+     *  Construct this ring buffer.
+     * @param capacity
+     *  the maximum number of elements, rounded up to a power of two
+     */
+    explicit RingBuffer(size_t capacity) :
+        _mask(),
+        _slots(),
+        _pushPosition(0),
+        _popPosition(0)
+    {
+        size_t size = 1;
+        while (size < capacity)
+        {
+            size <<= 1;
+        }
+        _mask = size - 1;
+        _slots = std::unique_ptr<Slot[]>(new Slot[size]);
+        for (size_t i = 0; i < size; ++i)
+        {
+            _slots[i].sequence.store(i, std::memory_order_relaxed);
+        }
+    }
+
+    /**
+     * @brief
+     *  Push an element.
+     * @return
+     *  @a true if the element was pushed, @a false if this ring buffer is full
+     * @remark
+     *  May be invoked by any thread.
+     */
+    bool push(ValueType&& value)
+    {
+        size_t position = _pushPosition.load(std::memory_order_relaxed);
+        while (true)
+        {
+            Slot& slot = _slots[position & _mask];
+            const size_t sequence = slot.sequence.load(std::memory_order_acquire);
+            const std::ptrdiff_t difference = static_cast<std::ptrdiff_t>(sequence) - static_cast<std::ptrdiff_t>(position);
+            if (0 == difference)
+            {
+                // The slot is free: Claim it.
+                if (_pushPosition.compare_exchange_weak(position, position + 1, std::memory_order_relaxed))
+                {
+                    slot.value = std::move(value);
+                    slot.sequence.store(position + 1, std::memory_order_release);
+                    return true;
+                }
+            }
+            else if (difference < 0)
+            {
+                // The slot was not popped yet.
+                return false;
+            }
+            else
+            {
+                // Another producer claimed the slot.
+                position = _pushPosition.load(std::memory_order_relaxed);
+            }
+        }
+    }
+
+    /**
+     * @brief
+     *  Pop an element.
+     * @return
+     *  @a true if an element was popped, @a false if this ring buffer is empty
+     * @remark
+     *  Must only be invoked by one thread at a time.
+     */
+    bool pop(ValueType& value)
+    {
+        const size_t position = _popPosition.load(std::memory_order_relaxed);
+        Slot& slot = _slots[position & _mask];
+        if (slot.sequence.load(std::memory_order_acquire) != position + 1)
+        {
+            return false;
+        }
+        value = std::move(slot.value);
+        slot.value = ValueType();
+        _popPosition.store(position + 1, std::memory_order_relaxed);
+        slot.sequence.store(position + _mask + 1, std::memory_order_release);
+        return true;
+    }
+
+    /**
+     * @brief
+     *  Invoke a function on each element in the order they would be popped without popping them.
+     * @param visitor
+     *  the function, invoked with a const reference to each element
+     * @remark
+     *  Must only be invoked by the thread which pops elements. Neither allocates nor takes a lock.
+     */
+    template <typename Visitor>
+    void visit(Visitor&& visitor) const
+    {
+        for (size_t position = _popPosition.load(std::memory_order_relaxed); ; ++position)
+        {
+            const Slot& slot = _slots[position & _mask];
+            if (slot.sequence.load(std::memory_order_acquire) != position + 1)
+            {
+                return;
+            }
+            visitor(static_cast<const ValueType&>(slot.value));
+        }
+    }
+
+    /**
+     * @brief
+     *  Get the maximum number of elements.
+     */
+    size_t getCapacity() const
+    {
+        return _mask + 1;
+    }
+
+private:
+    struct Slot
+    {
+        std::atomic<size_t> sequence; ///< the position of the slot if it is free, the position plus one if it is filled
+        ValueType value;
+    };
+
+    size_t _mask;
+    std::unique_ptr<Slot[]> _slots;
+    std::atomic<size_t> _pushPosition;
+    std::atomic<size_t> _popPosition;
+};
+
+} // namespace Core
+} // namespace Ego
@@ -0,0 +1,316 @@
+//********************************************************************************************
+//*
+//*    This file is part of Egoboo.
+//*
+//*    Egoboo is free software: you can redistribute it and/or modify it
+//*    under the terms of the GNU General Public License as published by
+//*    the Free Software Foundation, either version 3 of the License, or
+//*    (at your option) any later version.
+//*
+//*    Egoboo is distributed in the hope that it will be useful, but
+//*    WITHOUT ANY WARRANTY; without even the implied warranty of
+//*    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+//*    General Public License for more details.
+//*
+//*    You should have received a copy of the GNU General Public License
+//*    along with Egoboo.  If not, see <http://www.gnu.org/licenses/>.
+//*
+//********************************************************************************************
+
+/// @file   egolib/Core/SlotMap.hpp
+/// @brief  A container of values addressed by generational handles.
+
+#pragma once
+
+#include "egolib/platform.h"
+
+namespace Ego
+{
+namespace Core
+{
+
+/**
+ * @brief
+ *  A container which assigns each inserted value a handle. Insertion, removal and lookup are O(1)
+ *  and do not hash: a handle encodes the index of a slot and the generation of that slot. Removing a
+ *  value increments the generation of its slot, so handles of removed values never resolve again,
+ *  even after the slot was reused.
+ * @remark
+ *  The values are stored contiguously. Removal moves the last value into the gap, hence pointers to
+ *  values and the order of iteration are only stable as long as no value is removed.
+ * @remark
+ *  The lower half of the bits of a handle is the slot index, the upper half is the generation. A slot
+ *  whose generation is exhausted is retired and never reused.
+ * @tparam ValueType
+ *  the value type, must be move assignable
+ */
+template <typename ValueType>
+class SlotMap : private id::non_copyable
+{
+public:
+    using Handle = size_t;
+
+    /// @brief The handle which is never assigned to a value.
+    static constexpr Handle InvalidHandle = std::numeric_limits<Handle>::max();
+
+    /// @brief The number of bits of a handle storing the slot index.
+    static constexpr size_t IndexBits = std::numeric_limits<Handle>::digits / 2;
+
+    /// @brief The mask of the bits of a handle storing the slot index.
+    static constexpr Handle IndexMask = (Handle(1) << IndexBits) - 1;
+
+    /// @brief The exclusive upper bound of the generation of a slot.
+    static constexpr Handle MaximumGeneration = std::numeric_limits<Handle>::max() >> IndexBits;
+
+    using iterator = typename std::vector<ValueType>::iterator;
+    using const_iterator = typename std::vector<ValueType>::const_iterator;
+
+    SlotMap() :
+        _slots(),
+        _values(),
+        _owners(),
+        _free()
+    {}
+
+    /**
+     * @brief
+     *  Reserve storage for the specified number of values.
+     */
+    void reserve(const size_t capacity)
+    {
+        _slots.reserve(capacity);
+        _values.reserve(capacity);
+        _owners.reserve(capacity);
+        _free.reserve(capacity);
+    }
+
+    /**
+     * @brief
+     *  Insert a value.
+     * @return
+     *  the handle of the value
+     * @throw std::overflow_error
+     *  if all slot indices are in use
+     */
+    Handle insert(ValueType value)
+    {
+        size_t index;
+        if (!_free.empty())
+        {
+            index = _free.back();
+            _free.pop_back();
+        }
+        else
+        {
+            if (_slots.size() > IndexMask)
+            {
+                throw std::overflow_error("slot map is full");
+            }
+            index = _slots.size();
+            _slots.push_back({0, npos});
+        }
+        occupy(index, std::move(value));
+        return makeHandle(index, _slots[index].generation);
+    }
+
+    /**
+     * @brief
+     *  Insert a value under a specified handle.
+     * @return
+     *  @a true on success, @a false if the handle is invalid, its slot is occupied or its generation precedes
+     *  the generation of its slot
+     * @remark
+     *  This is O(n) in the number of free slots and meant for restoring handles, not for common insertion.
+     */
+    bool insertAt(const Handle handle, ValueType value)
+    {
+        if (InvalidHandle == handle)
+        {
+            return false;
+        }
+        const size_t index = getIndex(handle);
+        const Handle generation = getGeneration(handle);
+        if (generation >= MaximumGeneration)
+        {
+            return false;
+        }
+        while (_slots.size() <= index)
+        {
+            _free.insert(_free.begin(), _slots.size());
+            _slots.push_back({0, npos});
+        }
+        Slot& slot = _slots[index];
+        if (npos != slot.dense || generation < slot.generation)
+        {
+            return false;
+        }
+        auto it = std::find(_free.begin(), _free.end(), index);
+        if (it == _free.end())
+        {
+            // The slot is retired.
+            return false;
+        }
+        _free.erase(it);
+        slot.generation = generation;
+        occupy(index, std::move(value));
+        return true;
+    }
+
+    /**
+     * @brief
+     *  Remove the value of a handle.
+     * @return
+     *  @a true if the value was removed, @a false if the handle does not resolve to a value
+     */
+    bool erase(const Handle handle)
+    {
+        if (!contains(handle))
+        {
+            return false;
+        }
+        const size_t index = getIndex(handle);
+        const size_t dense = _slots[index].dense;
+        const size_t last = _values.size() - 1;
+        if (dense != last)
+        {
+            _values[dense] = std::move(_values[last]);
+            _owners[dense] = _owners[last];
+            _slots[_owners[dense]].dense = dense;
+        }
+        _values.pop_back();
+        _owners.pop_back();
+        release(index);
+        return true;
+    }
+
+    /**
+     * @brief
+     *  Find the value of a handle.
+     * @return
+     *  a pointer to the value, a null pointer if the handle does not resolve to a value
+     */
+    ValueType *find(const Handle handle)
+    {
+        return contains(handle) ? &_values[_slots[getIndex(handle)].dense] : nullptr;
+    }
+
+    /** @copydoc find */
+    const ValueType *find(const Handle handle) const
+    {
+        return contains(handle) ? &_values[_slots[getIndex(handle)].dense] : nullptr;
+    }
+
+    /**
+     * @brief
+     *  Get if a handle resolves to a value.
+     */
+    bool contains(const Handle handle) const
+    {
+        const size_t index = getIndex(handle);
+        if (index >= _slots.size())
+        {
+            return false;
+        }
+        const Slot& slot = _slots[index];
+        return npos != slot.dense && slot.generation == getGeneration(handle);
+    }
+
+    /**
+     * @brief
+     *  Remove all values.
+     * @remark
+     *  The handles of the removed values remain invalid.
+     */
+    void clear()
+    {
+        _values.clear();
+        _owners.clear();
+        _free.clear();
+        // Push in reverse order such that the lowest slot indices are reused first.
+        for (size_t index = _slots.size(); index-- > 0;)
+        {
+            Slot& slot = _slots[index];
+            if (npos != slot.dense)
+            {
+                slot.dense = npos;
+                slot.generation++;
+            }
+            if (slot.generation < MaximumGeneration)
+            {
+                _free.push_back(index);
+            }
+        }
+    }
+
+    /**
+     * @brief
+     *  Get the number of values.
+     */
+    size_t size() const
+    {
+        return _values.size();
+    }
+
+    /**
+     * @brief
+     *  Get if there are no values.
+     */
+    bool empty() const
+    {
+        return _values.empty();
+    }
+
+    iterator begin() { return _values.begin(); }
+    iterator end() { return _values.end(); }
+    const_iterator begin() const { return _values.begin(); }
+    const_iterator end() const { return _values.end(); }
+
+private:
+    static constexpr size_t npos = std::numeric_limits<size_t>::max();
+
+    struct Slot
+    {
+        Handle generation;  ///< the generation of the slot
+        size_t dense;       ///< the index of the value of the slot or @a npos if the slot is free
+    };
+
+    static size_t getIndex(const Handle handle)
+    {
+        return static_cast<size_t>(handle & IndexMask);
+    }
+
+    static Handle getGeneration(const Handle handle)
+    {
+        return handle >> IndexBits;
+    }
+
+    static Handle makeHandle(const size_t index, const Handle generation)
+    {
+        return (generation << IndexBits) | static_cast<Handle>(index);
+    }
+
+    void occupy(const size_t index, ValueType value)
+    {
+        _slots[index].dense = _values.size();
+        _values.push_back(std::move(value));
+        _owners.push_back(index);
+    }
+
+    void release(const size_t index)
+    {
+        Slot& slot = _slots[index];
+        slot.dense = npos;
+        if (++slot.generation < MaximumGeneration)
+        {
+            _free.push_back(index);
+        }
+    }
+
+    std::vector<Slot> _slots;       ///< the slots, indexed by the index of a handle
+    std::vector<ValueType> _values; ///< the values, densely packed
+    std::vector<size_t> _owners;    ///< the slot index of each value
+    std::vector<size_t> _free;      ///< the indices of the free slots, used as a stack
+};
+
+} // namespace Core
+} // namespace Ego
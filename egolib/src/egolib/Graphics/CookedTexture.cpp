@@ -0,0 +1,195 @@
+//********************************************************************************************
+//*
+//*    This file is part of Egoboo.
+//*
+//*    Egoboo is free software: you can redistribute it and/or modify it
+//*    under the terms of the GNU General Public License as published by
+//*    the Free Software Foundation, either version 3 of the License, or
+//*    (at your option) any later version.
+//*
+//*    Egoboo is distributed in the hope that it will be useful, but
+//*    WITHOUT ANY WARRANTY; without even the implied warranty of
+//*    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+//*    General Public License for more details.
+//*
+//*    You should have received a copy of the GNU General Public License
+//*    along with Egoboo.  If not, see <http://www.gnu.org/licenses/>.
+//*
+//********************************************************************************************
+
+/// @file   egolib/Graphics/CookedTexture.cpp
+/// @brief  A binary texture format holding the pixels of all mipmap levels ready for upload.
+
+#include "egolib/Graphics/CookedTexture.hpp"
+
+#include "egolib/Image/SDL_Image_Extensions.h"
+#include "egolib/Image/ImageProcessing.hpp"
+#include "egolib/Log/_Include.hpp"
+
+namespace Ego {
+
+const char CookedTexture::Magic[8] = {'E', 'G', 'O', 'T', 'E', 'X', '\0', '\0'};
+
+static_assert(sizeof(CookedTextureHeader) == 320, "unexpected padding in CookedTextureHeader");
+static_assert(sizeof(CookedTextureHeader::levels) / sizeof(CookedTextureLevel) == CookedTexture::MaximumLevelCount,
+              "CookedTextureHeader::levels does not match CookedTexture::MaximumLevelCount");
+
+static uint64_t align(uint64_t offset) {
+    return (offset + CookedTexture::Alignment - 1) & ~static_cast<uint64_t>(CookedTexture::Alignment - 1);
+}
+
+CookedTexture::CookedTexture() :
+    _data(nullptr),
+    _size(0),
+    _mapping{nullptr, 0, nullptr},
+    _buffer() {}
+
+CookedTexture::~CookedTexture() {
+    fs_unmapFile(&_mapping);
+}
+
+const PixelFormatDescriptor& CookedTexture::getPixelFormatDescriptor() const {
+    return PixelFormatDescriptor::get(getPixelFormat());
+}
+
+std::shared_ptr<CookedTexture> CookedTexture::cook(const std::shared_ptr<SDL_Surface>& surface, uint64_t sourceHash, bool mipMaps,
+                                                   uint32_t maximumLevelCount) {
+    if (!surface) {
+        throw id::invalid_argument_error(__FILE__, __LINE__, "nullptr == surface");
+    }
+    if (0 == maximumLevelCount) {
+        throw id::invalid_argument_error(__FILE__, __LINE__, "0 == maximumLevelCount");
+    }
+    maximumLevelCount = std::min(maximumLevelCount, MaximumLevelCount);
+    // Convert to RGBA if the image has non-opaque alpha values or alpha modulation and convert to RGB otherwise.
+    const bool hasAlpha = SDL::testAlpha(surface);
+    const auto& pfd = hasAlpha ? PixelFormatDescriptor::get<PixelFormat::R8G8B8A8>()
+                               : PixelFormatDescriptor::get<PixelFormat::R8G8B8>();
+    auto converted = SDL::convertPixelFormat(surface, pfd);
+    if (SDL_MUSTLOCK(converted.get())) {
+        throw id::runtime_error(__FILE__, __LINE__, "unable to access surface");
+    }
+    // Pad to power of two.
+    const uint32_t paddedWidth = Math::powerOfTwo(converted->w),
+                   paddedHeight = Math::powerOfTwo(converted->h);
+
+    // Compute the layout.
+    const size_t bytesPerPixel = pfd.getColourDepth().getDepth() / 8;
+    std::array<CookedTextureLevel, MaximumLevelCount> levels;
+    uint32_t levelCount = 0;
+    uint64_t offset = align(sizeof(CookedTextureHeader));
+    for (uint32_t width = paddedWidth, height = paddedHeight; levelCount < maximumLevelCount; ) {
+        CookedTextureLevel& level = levels[levelCount++];
+        level.offset = static_cast<uint32_t>(offset);
+        level.width = width;
+        level.height = height;
+        level.size = static_cast<uint32_t>(width * height * bytesPerPixel);
+        offset = align(offset + level.size);
+        if (!mipMaps || (1 == width && 1 == height) || levelCount == maximumLevelCount) {
+            break;
+        }
+        if (width > 1) width /= 2;
+        if (height > 1) height /= 2;
+    }
+    if (offset > std::numeric_limits<uint32_t>::max()) {
+        throw id::runtime_error(__FILE__, __LINE__, "image is too big");
+    }
+
+    std::shared_ptr<CookedTexture> texture(new CookedTexture());
+    texture->_buffer.resize((offset + sizeof(uint64_t) - 1) / sizeof(uint64_t), 0);
+    texture->_data = reinterpret_cast<uint8_t *>(texture->_buffer.data());
+    texture->_size = static_cast<size_t>(offset);
+
+    CookedTextureHeader& header = texture->getHeader();
+    std::copy(std::begin(Magic), std::end(Magic), header.magic);
+    header.byteOrder = ByteOrder;
+    header.version = Version;
+    header.headerSize = sizeof(CookedTextureHeader);
+    header.pixelFormat = static_cast<uint32_t>(pfd.getPixelFormat());
+    header.sourceHash = sourceHash;
+    header.hasAlpha = hasAlpha ? 1 : 0;
+    header.width = paddedWidth;
+    header.height = paddedHeight;
+    header.sourceWidth = surface->w;
+    header.sourceHeight = surface->h;
+    header.levelCount = levelCount;
+    std::copy(levels.begin(), levels.begin() + levelCount, header.levels);
+    header.fileSize = static_cast<uint32_t>(offset);
+
+    // Level 0 is the padded image, each further level is box-filtered from its predecessor.
+    ImageProcessing::pad(converted->pixels, converted->pitch, converted->w, converted->h,
+                         texture->getLevelPixels(0), paddedWidth * bytesPerPixel, paddedWidth, paddedHeight, bytesPerPixel);
+    for (uint32_t i = 1; i < levelCount; ++i) {
+        ImageProcessing::downsample(texture->getLevelPixels(i - 1), levels[i - 1].width, levels[i - 1].height,
+                                    bytesPerPixel, texture->getLevelPixels(i));
+    }
+    return texture;
+}
+
+bool CookedTexture::validate(const uint8_t *data, size_t size) {
+    if (size < sizeof(CookedTextureHeader)) {
+        return false;
+    }
+    const CookedTextureHeader& header = *reinterpret_cast<const CookedTextureHeader *>(data);
+    if (!std::equal(std::begin(Magic), std::end(Magic), header.magic) || ByteOrder != header.byteOrder ||
+        Version != header.version || sizeof(CookedTextureHeader) != header.headerSize || size != header.fileSize) {
+        return false;
+    }
+    if (static_cast<uint32_t>(PixelFormat::R8G8B8) != header.pixelFormat &&
+        static_cast<uint32_t>(PixelFormat::R8G8B8A8) != header.pixelFormat) {
+        return false;
+    }
+    if (0 == header.levelCount || header.levelCount > MaximumLevelCount ||
+        header.width != header.levels[0].width || header.height != header.levels[0].height) {
+        return false;
+    }
+    const uint64_t bytesPerPixel = (static_cast<uint32_t>(PixelFormat::R8G8B8A8) == header.pixelFormat) ? 4 : 3;
+    for (uint32_t i = 0; i < header.levelCount; ++i) {
+        const CookedTextureLevel& level = header.levels[i];
+        if (0 != level.offset % Alignment || level.offset < sizeof(CookedTextureHeader) ||
+            static_cast<uint64_t>(level.width) * level.height * bytesPerPixel != level.size ||
+            static_cast<uint64_t>(level.offset) + level.size > size) {
+            return false;
+        }
+    }
+    return true;
+}
+
+std::shared_ptr<CookedTexture> CookedTexture::load(const std::string& pathname, uint64_t sourceHash) {
+    std::shared_ptr<CookedTexture> texture(new CookedTexture());
+    if (!fs_mapFile(pathname, &texture->_mapping)) {
+        return nullptr;
+    }
+    texture->_data = static_cast<uint8_t *>(texture->_mapping.data);
+    texture->_size = texture->_mapping.size;
+    if (!validate(texture->_data, texture->_size)) {
+        Log::get() << Log::Entry::create(Log::Level::Warning, __FILE__, __LINE__, "cooked texture ", "`", pathname, "`",
+                                         " is invalid or of a different version - ignoring it", Log::EndOfEntry);
+        return nullptr;
+    }
+    if (sourceHash != texture->getSourceHash()) {
+        return nullptr;
+    }
+    return texture;
+}
+
+bool CookedTexture::save(const std::string& pathname) const {
+    std::ofstream file(pathname, std::ios::out | std::ios::binary | std::ios::trunc);
+    if (!file) {
+        return false;
+    }
+    file.write(reinterpret_cast<const char *>(_data), _size);
+    return static_cast<bool>(file);
+}
+
+uint64_t CookedTexture::hash(const void *bytes, size_t size, uint64_t hash) {
+    // 64-bit FNV-1a.
+    const uint8_t *p = static_cast<const uint8_t *>(bytes);
+    for (size_t i = 0; i < size; ++i) {
+        hash ^= p[i];
+        hash *= 1099511628211ull;
+    }
+    return hash;
+}
+
+} // namespace Ego
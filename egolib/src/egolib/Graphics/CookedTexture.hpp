@@ -0,0 +1,171 @@
+//********************************************************************************************
+//*
+//*    This file is part of Egoboo.
+//*
+//*    Egoboo is free software: you can redistribute it and/or modify it
+//*    under the terms of the GNU General Public License as published by
+//*    the Free Software Foundation, either version 3 of the License, or
+//*    (at your option) any later version.
+//*
+//*    Egoboo is distributed in the hope that it will be useful, but
+//*    WITHOUT ANY WARRANTY; without even the implied warranty of
+//*    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+//*    General Public License for more details.
+//*
+//*    You should have received a copy of the GNU General Public License
+//*    along with Egoboo.  If not, see <http://www.gnu.org/licenses/>.
+//*
+//********************************************************************************************
+
+/// @file   egolib/Graphics/CookedTexture.hpp
+/// @brief  A binary texture format holding the pixels of all mipmap levels ready for upload.
+
+#pragma once
+
+#include "egolib/file_common.h"
+#include "egolib/Graphics/PixelFormat.hpp"
+
+namespace Ego {
+
+/**
+ * @brief
+ *  A mipmap level in a cooked texture file.
+ */
+struct CookedTextureLevel {
+    uint32_t offset;            ///< the offset of the pixels
+    uint32_t width;             ///< the width, in pixels, of the level
+    uint32_t height;            ///< the height, in pixels, of the level
+    uint32_t size;              ///< the size, in Bytes, of the pixels
+};
+
+/**
+ * @brief
+ *  The header of a cooked texture file.
+ * @remark
+ *  All values are little-endian. Offsets are relative to the beginning of the file and aligned to
+ *  CookedTexture::Alignment Bytes. Pixel rows are tightly packed.
+ */
+struct CookedTextureHeader {
+    char magic[8];              ///< CookedTexture::Magic
+    uint32_t byteOrder;         ///< CookedTexture::ByteOrder, used to reject files of a foreign byte order
+    uint32_t version;           ///< CookedTexture::Version
+    uint32_t headerSize;        ///< <tt>sizeof(CookedTextureHeader)</tt>
+    uint32_t pixelFormat;       ///< Ego::PixelFormat::R8G8B8 or Ego::PixelFormat::R8G8B8A8
+    uint64_t sourceHash;        ///< the hash of the source image file, see CookedTexture::hash
+    uint32_t hasAlpha;          ///< non-zero if the source image has non-opaque pixels
+    uint32_t width;             ///< the width, in pixels, of level 0, a power of two
+    uint32_t height;            ///< the height, in pixels, of level 0, a power of two
+    uint32_t sourceWidth;       ///< the width, in pixels, of the source image
+    uint32_t sourceHeight;      ///< the height, in pixels, of the source image
+    uint32_t levelCount;        ///< the number of mipmap levels, 1 if the texture has no mipmaps
+    CookedTextureLevel levels[16]; ///< the mipmap levels, CookedTexture::MaximumLevelCount
+    uint32_t fileSize;          ///< the size, in Bytes, of the file
+    uint32_t reserved;
+};
+
+/**
+ * @brief
+ *  A texture in the form uploaded to the renderer: Converted to RGB or RGBA, padded to power-of-two
+ *  dimensions and - optionally - with all mipmap levels down to 1 x 1. A cooked texture loaded from a
+ *  file is usable without decoding, conversion or mipmap generation.
+ * @remark
+ *  A cooked texture loaded from a file is memory-mapped copy-on-write.
+ * @remark
+ *  The image files remain the authoritative format: A cooked texture stores a hash of its source file
+ *  and is rejected if the source has changed since, see Ego::TextureCache.
+ */
+class CookedTexture : private id::non_copyable {
+public:
+    static const char Magic[8];
+    static constexpr uint32_t ByteOrder = 0x01020304;
+    static constexpr uint32_t Version = 2;
+    static constexpr uint32_t Alignment = 16;
+    static constexpr uint32_t MaximumLevelCount = 16;
+    static constexpr uint64_t HashBasis = 14695981039346656037ull;
+
+    ~CookedTexture();
+
+    /**
+     * @brief
+     *  Cook an image.
+     * @param surface
+     *  the image
+     * @param sourceHash
+     *  the hash of the source of the image
+     * @param mipMaps
+     *  if @a true, all mipmap levels are generated, otherwise only level 0
+     * @param maximumLevelCount
+     *  the maximum number of levels to generate. Must be positive.
+     * @return
+     *  the cooked texture
+     * @throw id::runtime_error
+     *  if the image can not be converted
+     */
+    static std::shared_ptr<CookedTexture> cook(const std::shared_ptr<SDL_Surface>& surface, uint64_t sourceHash, bool mipMaps,
+                                                uint32_t maximumLevelCount = MaximumLevelCount);
+
+    /**
+     * @brief
+     *  Load a cooked texture.
+     * @param pathname
+     *  the pathname of the file in the native file system
+     * @param sourceHash
+     *  the expected hash of the source
+     * @return
+     *  the cooked texture on success, a null pointer if the file does not exist, is invalid or was cooked from another source
+     */
+    static std::shared_ptr<CookedTexture> load(const std::string& pathname, uint64_t sourceHash);
+
+    /**
+     * @brief
+     *  Save this cooked texture.
+     * @param pathname
+     *  the pathname of the file in the native file system
+     * @return
+     *  @a true on success, @a false on failure
+     */
+    bool save(const std::string& pathname) const;
+
+    /**
+     * @brief
+     *  Compute the hash of Bytes.
+     * @param hash
+     *  the hash of the preceding Bytes if the Bytes are hashed in chunks
+     * @return
+     *  the 64-bit FNV-1a hash of the Bytes
+     */
+    static uint64_t hash(const void *bytes, size_t size, uint64_t hash = HashBasis);
+
+    /// Get if this texture is memory-mapped.
+    bool isMapped() const { return nullptr != _mapping.data; }
+
+    uint64_t getSourceHash() const { return getHeader().sourceHash; }
+    PixelFormat getPixelFormat() const { return static_cast<PixelFormat>(getHeader().pixelFormat); }
+    const PixelFormatDescriptor& getPixelFormatDescriptor() const;
+    bool hasAlpha() const { return 0 != getHeader().hasAlpha; }
+    size_t getWidth() const { return getHeader().width; }
+    size_t getHeight() const { return getHeader().height; }
+    size_t getSourceWidth() const { return getHeader().sourceWidth; }
+    size_t getSourceHeight() const { return getHeader().sourceHeight; }
+    size_t getLevelCount() const { return getHeader().levelCount; }
+    size_t getLevelWidth(size_t level) const { return getHeader().levels[level].width; }
+    size_t getLevelHeight(size_t level) const { return getHeader().levels[level].height; }
+    void *getLevelPixels(size_t level) { return _data + getHeader().levels[level].offset; }
+    const void *getLevelPixels(size_t level) const { return _data + getHeader().levels[level].offset; }
+
+private:
+    CookedTexture();
+
+    const CookedTextureHeader& getHeader() const { return *reinterpret_cast<const CookedTextureHeader *>(_data); }
+    CookedTextureHeader& getHeader() { return *reinterpret_cast<CookedTextureHeader *>(_data); }
+
+    /// Get if the image is a valid cooked texture.
+    static bool validate(const uint8_t *data, size_t size);
+
+    uint8_t *_data;                 ///< the image, either mapped or owned
+    size_t _size;                   ///< the size, in Bytes, of the image
+    fs_mapping_t _mapping;          ///< the mapping if the image is mapped
+    std::vector<uint64_t> _buffer;  ///< the storage if the image is owned
+};
+
+} // namespace Ego
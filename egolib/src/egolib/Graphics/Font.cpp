@@ -26,7 +26,6 @@
 
 #include "egolib/Core/StringUtilities.hpp"
 #include "egolib/Graphics/FontManager.hpp"
-#include "egolib/Core/System.hpp"
 #include "egolib/Renderer/Renderer.hpp"
 #include "egolib/Image/ImageManager.hpp"
 #include "egolib/Image/SDL_Image_Extensions.h"
@@ -37,39 +36,6 @@
 //--------------------------------------------------------------------------------------------
 namespace Ego {
 
-struct Font::RenderedTextCache : private id::non_copyable {
-    std::shared_ptr<Font::LaidTextRenderer> cache;
-    uint32_t lastUseInTicks;
-    std::string text;
-    int width;
-    int height;
-    int spacing;
-
-    bool isEquivalent(const std::string &t, int w, int h, int s) {
-        return w == width && h == height && s == spacing && t == text;
-    }
-
-    static bool isLessThan(const std::shared_ptr<RenderedTextCache> &a, const std::shared_ptr<RenderedTextCache> &b) {
-        return a->lastUseInTicks < b->lastUseInTicks;
-    }
-};
-
-struct Font::SizedTextCache : private id::non_copyable {
-    uint32_t lastUseInTicks;
-    std::string text;
-    int width;
-    int height;
-    int spacing;
-
-    bool isEquivalent(const std::string &t, int s) {
-        return s == spacing && t == text;
-    }
-
-    static bool isLessThan(const std::shared_ptr<SizedTextCache> &a, const std::shared_ptr<SizedTextCache> &b) {
-        return a->lastUseInTicks < b->lastUseInTicks;
-    }
-};
-
 struct Font::FontAtlas {
     std::shared_ptr<Texture> texture;
     std::unordered_map<uint16_t, SDL_Rect> glyphs;
@@ -107,6 +73,12 @@ void Font::LaidTextRenderer::render(int x, int y, const Math::Colour4f &colour)
         const Matrix4f4f matrix;
     };
 
+    auto &batch = FontManager::get().getGlyphBatch();
+    if (batch.isActive()) {
+        batch.add(_atlas, *_vertexBuffer, x, y, colour);
+        return;
+    }
+
     auto &renderer = Renderer::get();
     MatrixStack stack;
 
@@ -123,8 +95,8 @@ void Font::LaidTextRenderer::render(int x, int y, const Math::Colour4f &colour)
 
 Font::Font(const std::string &fileName, int pointSize) :
     _ttfFont(),
-    _renderedCache(),
-    _sizedCache() {
+    _renderedCache(MAX_CACHE_SIZE),
+    _sizedCache(MAX_CACHE_SIZE) {
     _ttfFont = TTF_OpenFontRW(vfs_openRWopsRead(fileName), 1, pointSize);
 
     if (_ttfFont == nullptr) {
@@ -143,56 +115,17 @@ Font::~Font() {
 }
 
 void Font::getTextSize(const std::string &text, int *width, int *height) {
-    bool updateCache = true;
-    std::shared_ptr<SizedTextCache> cache = findInSizedCache(text, 0, &updateCache);
-
-    if (updateCache) {
-        int ourWidth = 0;
-        int ourHeight = 0;
+    TextSize size = getSizedText(TextCacheKey{text, 0, 0, 0, false});
 
-        LayoutOptions options;
-        options.textWidth = &ourWidth;
-        options.textHeight = &ourHeight;
-        options.interpretNewlines = false;
-
-        layout(text, options);
-
-        cache->text = text;
-        cache->width = ourWidth;
-        cache->height = ourHeight;
-        cache->spacing = 0;
-    }
-
-    if (width) *width = cache->width;
-    if (height) *height = cache->height;
-
-    cache->lastUseInTicks = Core::System::get().getSystemService().getTicks();
+    if (width) *width = size.width;
+    if (height) *height = size.height;
 }
 
 void Font::getTextBoxSize(const std::string &text, int spacing, int *width, int *height) {
-    bool updateCache = true;
-    auto cache = findInSizedCache(text, spacing, &updateCache);
-
-    if (updateCache) {
-        int ourWidth = 0;
-        int ourHeight = 0;
-
-        LayoutOptions options;
-        options.textWidth = &ourWidth;
-        options.textHeight = &ourHeight;
-
-        layout(text, options);
+    TextSize size = getSizedText(TextCacheKey{text, 0, 0, spacing, true});
 
-        cache->text = text;
-        cache->width = ourWidth;
-        cache->height = ourHeight;
-        cache->spacing = spacing;
-    }
-
-    if (width) *width = cache->width;
-    if (height) *height = cache->height;
-
-    cache->lastUseInTicks = Core::System::get().getSystemService().getTicks();
+    if (width) *width = size.width;
+    if (height) *height = size.height;
 }
 
 void Font::drawTextToTexture(Texture *tex, const std::string &text, const Math::Colour3f &colour) {
@@ -224,39 +157,13 @@ void Font::drawTextBoxToTexture(Texture *tex, const std::string &text, int width
 void Font::drawText(const std::string &text, int x, int y, const Math::Colour4f &colour) {
     if (text.empty()) return;
 
-    bool updateCache = true;
-    auto cache = findInRenderedCache(text, 0, 0, 0, &updateCache);
-
-    if (updateCache) {
-        cache->cache = layoutText(text, nullptr, nullptr);
-        cache->text = text;
-        cache->width = 0;
-        cache->height = 0;
-        cache->spacing = 0;
-    }
-
-    cache->cache->render(x, y, colour);
-
-    cache->lastUseInTicks = Core::System::get().getSystemService().getTicks();
+    getRenderedText(TextCacheKey{text, 0, 0, 0, false})->render(x, y, colour);
 }
 
 void Font::drawTextBox(const std::string &text, int x, int y, int width, int height, int spacing, const Math::Colour4f &colour) {
     if (text.empty()) return;
 
-    bool updateCache = true;
-    auto cache = findInRenderedCache(text, width, height, spacing, &updateCache);
-
-    if (updateCache) {
-        cache->cache = layoutTextBox(text, width, height, spacing, nullptr, nullptr);
-        cache->text = text;
-        cache->width = width;
-        cache->height = height;
-        cache->spacing = spacing;
-    }
-
-    cache->cache->render(x, y, colour);
-
-    cache->lastUseInTicks = Core::System::get().getSystemService().getTicks();
+    getRenderedText(TextCacheKey{text, width, height, spacing, true})->render(x, y, colour);
 }
 
 std::shared_ptr<Font::LaidTextRenderer> Font::layoutText(const std::string &text, int *textWidth, int *textHeight) {
@@ -630,77 +537,47 @@ Font::FontAtlas Font::createFontAtlas(const std::vector<uint16_t> &codepoints) c
     return retval;
 }
 
-std::shared_ptr<Font::RenderedTextCache> Font::findInRenderedCache(const std::string &text, int width, int height,
-                                                                   int spacing, bool *update) {
-    if (MAX_CACHE_SIZE == 0) {
-        *update = true;
-        return std::make_shared<RenderedTextCache>();
+size_t Font::TextCacheKeyHash::operator()(const TextCacheKey &key) const {
+    size_t value = std::hash<std::string>()(key.text);
+    // Combine the hashes as boost::hash_combine does.
+    for (int x : {key.width, key.height, key.spacing, key.interpretNewlines ? 1 : 0}) {
+        value ^= std::hash<int>()(x) + 0x9e3779b9 + (value << 6) + (value >> 2);
     }
+    return value;
+}
 
-    if (MAX_CACHE_SIZE == 1) {
-        *update = true;
-        if (_renderedCache.empty())
-            _renderedCache.emplace_back(std::make_shared<RenderedTextCache>());
-        return _renderedCache[0];
+std::shared_ptr<Font::LaidTextRenderer> Font::getRenderedText(const TextCacheKey &key) {
+    std::shared_ptr<LaidTextRenderer> *cached = _renderedCache.find(key);
+    if (cached) {
+        return *cached;
     }
 
-    std::shared_ptr<Font::RenderedTextCache> cache;
-    bool updateCache = true;
-
-    auto cacheIterator = std::find_if(_renderedCache.begin(), _renderedCache.end(),
-                                      [&](const std::shared_ptr<Font::RenderedTextCache> &ptr) {
-        return ptr->isEquivalent(text, width, height, spacing);
-    });
-
-    if (cacheIterator != _renderedCache.end()) {
-        cache = *cacheIterator;
-        updateCache = false;
-    } else if (_renderedCache.size() < MAX_CACHE_SIZE) {
-        cache = std::make_shared<RenderedTextCache>();
-        _renderedCache.push_back(cache);
-    } else {
-        std::sort(_renderedCache.begin(), _renderedCache.end(), RenderedTextCache::isLessThan);
-        cache = _renderedCache.at(0);
-    }
+    LayoutOptions options;
+    options.maxWidth = key.width;
+    options.maxHeight = key.height;
+    options.spacing = key.spacing;
+    options.interpretNewlines = key.interpretNewlines;
 
-    if (update) *update = updateCache;
-    return cache;
+    return _renderedCache.insert(key, layoutToBuffer(key.text, options));
 }
 
-std::shared_ptr<Font::SizedTextCache> Font::findInSizedCache(const std::string &text, int spacing, bool *update) {
-    if (MAX_CACHE_SIZE == 0) {
-        *update = true;
-        return std::make_shared<SizedTextCache>();
+Font::TextSize Font::getSizedText(const TextCacheKey &key) {
+    TextSize *cached = _sizedCache.find(key);
+    if (cached) {
+        return *cached;
     }
 
-    if (MAX_CACHE_SIZE == 1) {
-        *update = true;
-        if (_sizedCache.empty())
-            _sizedCache.emplace_back(std::make_shared<SizedTextCache>());
-        return _sizedCache[0];
-    }
-
-    std::shared_ptr<Font::SizedTextCache> cache;
-    bool updateCache = true;
+    TextSize size = {0, 0};
 
-    auto cacheIterator = std::find_if(_sizedCache.begin(), _sizedCache.end(),
-                                      [&](const std::shared_ptr<Font::SizedTextCache> &ptr) {
-        return ptr->isEquivalent(text, spacing);
-    });
+    LayoutOptions options;
+    options.textWidth = &size.width;
+    options.textHeight = &size.height;
+    options.spacing = key.spacing;
+    options.interpretNewlines = key.interpretNewlines;
 
-    if (cacheIterator != _sizedCache.end()) {
-        cache = *cacheIterator;
-        updateCache = false;
-    } else if (_sizedCache.size() < MAX_CACHE_SIZE) {
-        cache = std::make_shared<SizedTextCache>();
-        _sizedCache.push_back(cache);
-    } else {
-        std::sort(_sizedCache.begin(), _sizedCache.end(), SizedTextCache::isLessThan);
-        cache = _sizedCache.at(0);
-    }
+    layout(key.text, options);
 
-    if (update) *update = updateCache;
-    return cache;
+    return _sizedCache.insert(key, size);
 }
 
 uint16_t Font::convertUTF8ToCodepoint(const std::string &string, size_t *pos) {
@@ -25,6 +25,7 @@
 
 #include "egolib/typedef.h"
 #include "egolib/Math/_Include.hpp"
+#include "egolib/Core/LruCache.hpp"
 #include "egolib/Graphics/VertexBuffer.hpp"
 
 namespace Ego {
@@ -54,6 +55,9 @@ public:
          *  The position on screen to render the text at
          * @param colour
          *  The colour of the rendered text; default is white
+         * @remark
+         *  If a glyph batch is open, the text is queued and rendered when the batch is flushed.
+         * @see FontManager::getGlyphBatch
          */
         void render(int x, int y, const Math::Colour4f &colour = Math::Colour4f::white());
 
@@ -71,7 +75,7 @@ public:
 private:
     /// This is the maximum size for the two caches as used by
     /// drawText and getTextSize, set this to 0 for no caching
-    constexpr static size_t MAX_CACHE_SIZE = 20;
+    constexpr static size_t MAX_CACHE_SIZE = 256;
 
 protected:
     Font(const std::string &fileName, int pointSize);
@@ -223,11 +227,6 @@ public:
     int getFontHeight() const;
 
 private:
-    /// Struct for cached text that has been rendered
-    struct RenderedTextCache;
-    /// Struct for cached text that has been sized
-    struct SizedTextCache;
-
     struct FontAtlas;
 
     /// Internal representation of laid out text.
@@ -235,30 +234,49 @@ private:
 
     struct LayoutOptions;
 
+    /// The key of a cached text layout.
+    struct TextCacheKey {
+        std::string text;
+        int width;
+        int height;
+        int spacing;
+        bool interpretNewlines;
+
+        bool operator==(const TextCacheKey &other) const {
+            return width == other.width && height == other.height && spacing == other.spacing
+                && interpretNewlines == other.interpretNewlines && text == other.text;
+        }
+    };
+
+    struct TextCacheKeyHash {
+        size_t operator()(const TextCacheKey &key) const;
+    };
+
+    /// The size of a cached text layout.
+    struct TextSize {
+        int width;
+        int height;
+    };
+
     /**
      * @brief
-     *  Find given values in the rendered text cache
-     * @param text,width,height,spacing
-     *  The values to look for in the cache
-     * @param update[out]
-     *  Is set to @c true when the returned cached struct needs to be updated with the given values, @c false otherwise
+     *  Get the rendered text for the given values from the rendered text cache, laying it out if required.
+     * @param key
+     *  The text and layout constraints
      * @return
-     *  A cached struct that may need to be updated per @a update
+     *  The renderer of the laid out text
      */
-    std::shared_ptr<RenderedTextCache> findInRenderedCache(const std::string &text, int width, int height,
-                                                           int spacing, bool *update);
+    std::shared_ptr<LaidTextRenderer> getRenderedText(const TextCacheKey &key);
 
     /**
      * @brief
-     *  Find given values in the sized text cache
-     * @param text,spacing
-     *  The values to look for in the cache
-     * @param update[out]
-     *  Is @c true when the returned cached struct needs to be updated with the given values, @c false otherwise
+     *  Get the size of the text for the given values from the sized text cache, laying it out if required.
+     * @param key
+     *  The text and layout constraints
      * @return
-     *  A cached struct that may need to be updated per @a update
+     *  The size of the laid out text
      */
-    std::shared_ptr<SizedTextCache> findInSizedCache(const std::string &text, int spacing, bool *update);
+    TextSize getSizedText(const TextCacheKey &key);
 
     /**
      * @brief
@@ -382,8 +400,8 @@ private:
 
     TTF_Font *_ttfFont;
 
-    std::vector<std::shared_ptr<RenderedTextCache>> _renderedCache;
-    std::vector<std::shared_ptr<SizedTextCache>> _sizedCache;
+    Core::LruCache<TextCacheKey, std::shared_ptr<LaidTextRenderer>, TextCacheKeyHash> _renderedCache;
+    Core::LruCache<TextCacheKey, TextSize, TextCacheKeyHash> _sizedCache;
     std::vector<FontAtlas> _atlases;
 };
 
@@ -28,7 +28,8 @@
 
 namespace Ego {
 
-FontManager::FontManager() {
+FontManager::FontManager() :
+    _glyphBatch() {
     Log::get() << Log::Entry::create(Log::Level::Info, __FILE__, __LINE__, "[font manager]: SDL_ttf v", SDL_TTF_MAJOR_VERSION, ".", SDL_TTF_MINOR_VERSION, ".", SDL_TTF_PATCHLEVEL, Log::EndOfEntry);
     if (TTF_Init() < 0) {
         auto e = Log::Entry::create(Log::Level::Warning, __FILE__, __LINE__, "[font manager]: unable to initialized SDL_ttf v", SDL_TTF_MAJOR_VERSION, ".", SDL_TTF_MINOR_VERSION, ".", SDL_TTF_PATCHLEVEL, ": ",
@@ -51,4 +52,8 @@ std::shared_ptr<Font> FontManager::loadFont(const std::string &fileName, int poi
         std::rethrow_exception(std::current_exception());
     }
 }
+
+GlyphBatch& FontManager::getGlyphBatch() {
+    return _glyphBatch;
+}
 } // namespace Ego
\ No newline at end of file
@@ -27,6 +27,7 @@
 #include "egolib/Core/Singleton.hpp"
 #include "egolib/typedef.h"
 #include "egolib/Graphics/Font.hpp"
+#include "egolib/Graphics/GlyphBatch.hpp"
 
 namespace Ego {
 
@@ -34,12 +35,23 @@ class FontManager : public Core::Singleton<FontManager> {
 public:
     std::shared_ptr<Font> loadFont(const std::string &fileName, int pointSize);
 
+    /**
+     * @brief
+     *  Get the glyph batch shared by all fonts.
+     * @remark
+     *  While the batch is open, Font::LaidTextRenderer::render queues text instead of rendering it.
+     */
+    GlyphBatch& getGlyphBatch();
+
 protected:
     friend Core::Singleton<FontManager>::CreateFunctorType;
     friend Core::Singleton<FontManager>::DestroyFunctorType;
 
     FontManager();
     ~FontManager();
+
+private:
+    GlyphBatch _glyphBatch;
 };
 
 } // namespace Ego
@@ -0,0 +1,150 @@
+//********************************************************************************************
+//*
+//*    This file is part of Egoboo.
+//*
+//*    Egoboo is free software: you can redistribute it and/or modify it
+//*    under the terms of the GNU General Public License as published by
+//*    the Free Software Foundation, either version 3 of the License, or
+//*    (at your option) any later version.
+//*
+//*    Egoboo is distributed in the hope that it will be useful, but
+//*    WITHOUT ANY WARRANTY; without even the implied warranty of
+//*    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+//*    General Public License for more details.
+//*
+//*    You should have received a copy of the GNU General Public License
+//*    along with Egoboo.  If not, see <http://www.gnu.org/licenses/>.
+//*
+//********************************************************************************************
+
+/// @file    egolib/Graphics/GlyphBatch.cpp
+/// @brief   Batching of text quads sharing a font atlas.
+
+#include "egolib/Graphics/GlyphBatch.hpp"
+
+#include "egolib/Renderer/Renderer.hpp"
+
+namespace Ego {
+
+GlyphBatch::GlyphBatch() :
+    _depth(0),
+    _projection(Matrix4f4f::identity()),
+    _buckets(),
+    _vertexBuffer(),
+    _drawCallCount(0),
+    _quadCount(0) {}
+
+void GlyphBatch::begin() {
+    if (0 == _depth++) {
+        _projection = Renderer::get().getProjectionMatrix();
+    }
+}
+
+void GlyphBatch::end() {
+    if (_depth == 0) {
+        return;
+    }
+    if (0 == --_depth) {
+        flush();
+    }
+}
+
+bool GlyphBatch::isActive() const {
+    return _depth > 0;
+}
+
+bool GlyphBatch::isEmpty() const {
+    for (const Bucket& bucket : _buckets) {
+        if (!bucket.vertices.empty()) {
+            return false;
+        }
+    }
+    return true;
+}
+
+GlyphBatch::Bucket& GlyphBatch::getBucket(const std::shared_ptr<Texture>& atlas) {
+    for (Bucket& bucket : _buckets) {
+        if (bucket.atlas == atlas) {
+            return bucket;
+        }
+    }
+    _buckets.emplace_back();
+    _buckets.back().atlas = atlas;
+    return _buckets.back();
+}
+
+void GlyphBatch::add(const std::shared_ptr<Texture>& atlas, VertexBuffer& quads, int x, int y, const Math::Colour4f& colour) {
+    struct TextVertex {
+        float x, y, z;
+        float u, v;
+    };
+
+    const size_t numberOfVertices = quads.getNumberOfVertices();
+    if (0 == numberOfVertices) {
+        return;
+    }
+
+    Bucket& bucket = getBucket(atlas);
+    const float dx = static_cast<float>(x), dy = static_cast<float>(y);
+    const float r = colour.get_r(), g = colour.get_g(), b = colour.get_b(), a = colour.get_a();
+
+    BufferScopedLock lock(quads);
+    const TextVertex *source = lock.get<TextVertex>();
+    const size_t offset = bucket.vertices.size();
+    bucket.vertices.resize(offset + numberOfVertices);
+    Vertex *target = bucket.vertices.data() + offset;
+    for (size_t i = 0; i < numberOfVertices; ++i) {
+        target[i] = {source[i].x + dx, source[i].y + dy, source[i].z, r, g, b, a, source[i].u, source[i].v};
+    }
+}
+
+void GlyphBatch::flush() {
+    size_t numberOfVertices = 0;
+    for (const Bucket& bucket : _buckets) {
+        numberOfVertices = std::max(numberOfVertices, bucket.vertices.size());
+    }
+    if (0 == numberOfVertices) {
+        return;
+    }
+
+    const auto& vertexDescriptor = VertexFormatFactory::get(VertexFormat::P3FC4FT2F);
+    if (!_vertexBuffer || _vertexBuffer->getNumberOfVertices() < numberOfVertices) {
+        // Grow geometrically to avoid reallocation every frame.
+        size_t capacity = _vertexBuffer ? _vertexBuffer->getNumberOfVertices() : 1024;
+        while (capacity < numberOfVertices) capacity *= 2;
+        _vertexBuffer = std::make_unique<VertexBuffer>(capacity, vertexDescriptor.getVertexSize());
+    }
+
+    auto& renderer = Renderer::get();
+    const Matrix4f4f projection = renderer.getProjectionMatrix();
+    renderer.setProjectionMatrix(_projection);
+    renderer.setBlendingEnabled(true);
+
+    for (Bucket& bucket : _buckets) {
+        if (bucket.vertices.empty()) {
+            continue;
+        }
+        {
+            BufferScopedLock lock(*_vertexBuffer);
+            std::copy(bucket.vertices.begin(), bucket.vertices.end(), lock.get<Vertex>());
+        }
+        renderer.getTextureUnit().setActivated(bucket.atlas.get());
+        renderer.render(*_vertexBuffer, vertexDescriptor, PrimitiveType::Quadriliterals, 0, bucket.vertices.size());
+        _drawCallCount++;
+        _quadCount += bucket.vertices.size() / 4;
+    }
+    // Do not keep atlases of fonts alive which might be released before the next batch.
+    _buckets.clear();
+
+    renderer.setProjectionMatrix(projection);
+}
+
+size_t GlyphBatch::getDrawCallCount() const {
+    return _drawCallCount;
+}
+
+size_t GlyphBatch::getQuadCount() const {
+    return _quadCount;
+}
+
+} // namespace Ego
@@ -0,0 +1,124 @@
+//********************************************************************************************
+//*
+//*    This file is part of Egoboo.
+//*
+//*    Egoboo is free software: you can redistribute it and/or modify it
+//*    under the terms of the GNU General Public License as published by
+//*    the Free Software Foundation, either version 3 of the License, or
+//*    (at your option) any later version.
+//*
+//*    Egoboo is distributed in the hope that it will be useful, but
+//*    WITHOUT ANY WARRANTY; without even the implied warranty of
+//*    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+//*    General Public License for more details.
+//*
+//*    You should have received a copy of the GNU General Public License
+//*    along with Egoboo.  If not, see <http://www.gnu.org/licenses/>.
+//*
+//********************************************************************************************
+
+/// @file    egolib/Graphics/GlyphBatch.hpp
+/// @brief   Batching of text quads sharing a font atlas.
+
+#pragma once
+
+#include "egolib/typedef.h"
+#include "egolib/Math/_Include.hpp"
+#include "egolib/Graphics/VertexBuffer.hpp"
+
+namespace Ego {
+class Texture;
+} // namespace Ego
+
+namespace Ego {
+
+/**
+ * @brief
+ *  Accumulates the glyph quads of laid out text and renders all quads sharing a font atlas with a single draw call.
+ * @remark
+ *  A batch is opened by GlyphBatch::begin and closed by GlyphBatch::end. Calls may nest, the quads are rendered
+ *  when the outermost batch is closed or when GlyphBatch::flush is called. While a batch is open, text is drawn
+ *  with the projection matrix that was set when the outermost batch was opened.
+ * @remark
+ *  Queued text is drawn after everything else that is drawn before the next flush. Code which draws non-text
+ *  primitives on top of text within a batch must call GlyphBatch::flush first.
+ */
+class GlyphBatch final : private id::non_copyable {
+public:
+    GlyphBatch();
+
+    /**
+     * @brief
+     *  Open a batch.
+     */
+    void begin();
+
+    /**
+     * @brief
+     *  Close a batch. If this closes the outermost batch, the queued quads are rendered.
+     */
+    void end();
+
+    /**
+     * @brief
+     *  Get if a batch is open.
+     */
+    bool isActive() const;
+
+    /**
+     * @brief
+     *  Get if no quads are queued.
+     */
+    bool isEmpty() const;
+
+    /**
+     * @brief
+     *  Queue the glyph quads of laid out text.
+     * @param atlas
+     *  the font atlas
+     * @param quads
+     *  the quads in vertex format VertexFormat::P3FT2F, four vertices per quad
+     * @param x,y
+     *  the position on screen to render the text at
+     * @param colour
+     *  the colour of the text
+     */
+    void add(const std::shared_ptr<Texture>& atlas, VertexBuffer& quads, int x, int y, const Math::Colour4f& colour);
+
+    /**
+     * @brief
+     *  Render and discard all queued quads.
+     */
+    void flush();
+
+    /// Get the number of draw calls issued by this batch.
+    size_t getDrawCallCount() const;
+
+    /// Get the number of quads rendered by this batch.
+    size_t getQuadCount() const;
+
+private:
+    /// A vertex in format VertexFormat::P3FC4FT2F.
+    struct Vertex {
+        float x, y, z;
+        float r, g, b, a;
+        float u, v;
+    };
+
+    /// The queued vertices of one font atlas.
+    struct Bucket {
+        std::shared_ptr<Texture> atlas;
+        std::vector<Vertex> vertices;
+    };
+
+    Bucket& getBucket(const std::shared_ptr<Texture>& atlas);
+
+    int _depth;                                   ///< the nesting depth of open batches
+    Matrix4f4f _projection;                       ///< the projection matrix captured by the outermost GlyphBatch::begin
+    std::vector<Bucket> _buckets;                 ///< a font has only a few atlases, so a linear search is fine
+    std::unique_ptr<VertexBuffer> _vertexBuffer;  ///< the vertex buffer, grown on demand
+    size_t _drawCallCount;
+    size_t _quadCount;
+};
+
+} // namespace Ego
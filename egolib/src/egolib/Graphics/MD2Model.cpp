@@ -108,6 +108,7 @@ void MD2Model::makeEquallyLit()
 	    {
 	        vertex.normal = MD2Model::normalCount -1;
 	    }
+	    std::fill(frame.normalList.begin(), frame.normalList.end(), MD2Model::normalCount - 1);
 	}
 }
 
@@ -169,6 +170,7 @@ std::shared_ptr<MD2Model> MD2Model::loadFromFile(const std::string &fileName)
     for(MD2_Frame &frame : model->_frames)
     {
     	frame.vertexList.resize(md2Header.num_vertices);
+    	frame.normalList.resize(md2Header.num_vertices);
     }
 
     // Load the texture coordinates from the file, normalizing them as we go
@@ -225,8 +227,9 @@ std::shared_ptr<MD2Model> MD2Model::loadFromFile(const std::string &fileName)
 
         // unpack the md2 vertex_lst from this frame
         bool boundingBoxFound = false;
-        for(MD2_Vertex &vertex : frame.vertexList)
+        for(size_t i = 0; i < frame.vertexList.size(); ++i)
         {
+            MD2_Vertex &vertex = frame.vertexList[i];
             oct_vec_v2_t ovec;
             id_md2_vertex_t frame_vert;
 
@@ -243,6 +246,7 @@ std::shared_ptr<MD2Model> MD2Model::loadFromFile(const std::string &fileName)
             if (vertex.normal > MD2_MAX_NORMALS) {
             	vertex.normal = MD2_MAX_NORMALS;
             }
+            frame.normalList[i] = static_cast<uint8_t>(vertex.normal);
 
             // expand the normal index into an actual normal
             vertex.nrm[kX] = MD2_NORMALS[frame_vert.normalIndex][0];
@@ -79,6 +79,7 @@ public:
 		name(),
 #endif
 		vertexList(),
+		normalList(),
 		bb(),
 		framelip(0),
 		framefx(EMPTY_BIT_FIELD)
@@ -89,6 +90,7 @@ public:
     char name[16];
 
     std::vector<MD2_Vertex> vertexList;
+    std::vector<uint8_t> normalList;  ///< the normal index of every vertex, packed for batch lighting
 
     oct_bb_t bb;        ///< axis-aligned octagonal bounding box limits
     int framelip;       ///< the position in the current animation
@@ -0,0 +1,227 @@
+//********************************************************************************************
+//*
+//*    This file is part of Egoboo.
+//*
+//*    Egoboo is free software: you can redistribute it and/or modify it
+//*    under the terms of the GNU General Public License as published by
+//*    the Free Software Foundation, either version 3 of the License, or
+//*    (at your option) any later version.
+//*
+//*    Egoboo is distributed in the hope that it will be useful, but
+//*    WITHOUT ANY WARRANTY; without even the implied warranty of
+//*    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+//*    General Public License for more details.
+//*
+//*    You should have received a copy of the GNU General Public License
+//*    along with Egoboo.  If not, see <http://www.gnu.org/licenses/>.
+//*
+//********************************************************************************************
+
+/// @file egolib/Graphics/ParticleBatch.cpp
+/// @brief Batching of particle sprites sharing a blend mode and a texture.
+
+#include "egolib/Graphics/ParticleBatch.hpp"
+
+#include "egolib/Renderer/Renderer.hpp"
+#include "egolib/Extensions/ogl_extensions.h"
+
+namespace Ego {
+namespace Graphics {
+
+size_t ParticleBatch::drawCallCount = 0;
+size_t ParticleBatch::allocationCount = 0;
+size_t ParticleBatch::quadCount = 0;
+
+class ParticleBatch::RendererSink : public ParticleBatch::Sink
+{
+public:
+    RendererSink() :
+        _vertexBuffer()
+    {}
+
+    void render(const std::vector<Quad>& quads, const std::vector<DrawCall>& drawCalls) override;
+
+private:
+    /// Set the renderer state of a blend mode.
+    static void setState(ParticleBlendMode blendMode);
+
+    std::unique_ptr<VertexBuffer> _vertexBuffer;  ///< the vertex buffer, grown on demand
+};
+
+ParticleBatch::ParticleBatch() :
+    ParticleBatch(std::make_unique<RendererSink>())
+{}
+
+ParticleBatch::ParticleBatch(std::unique_ptr<Sink> sink) :
+    _quads(),
+    _drawCalls(),
+    _sink(std::move(sink))
+{}
+
+void ParticleBatch::add(ParticleBlendMode blendMode, const Texture *texture, const Vector3f& position, const Vector3f& right,
+                        const Vector3f& up, float size, float s0, float t0, float s1, float t1, const Math::Colour4f& colour)
+{
+    if (_quads.size() == _quads.capacity())
+    {
+        allocationCount++;
+    }
+    _quads.emplace_back();
+    Quad& quad = _quads.back();
+    quad.blendMode = blendMode;
+    quad.texture = texture;
+
+    const float r = colour.get_r(), g = colour.get_g(), b = colour.get_b(), a = colour.get_a();
+    const Vector3f dx = right * size, dy = up * size;
+    // Left bottom, right bottom, right top and left top.
+    const Vector3f corners[] =
+    {
+        position - dx - dy,
+        position + dx - dy,
+        position + dx + dy,
+        position - dx + dy,
+    };
+    const float s[] = { s1, s0, s0, s1 };
+    const float t[] = { t1, t1, t0, t0 };
+    for (size_t i = 0; i < 4; ++i)
+    {
+        quad.vertices[i] = { corners[i][kX], corners[i][kY], corners[i][kZ], r, g, b, a, s[i], t[i] };
+    }
+}
+
+void ParticleBatch::RendererSink::setState(ParticleBlendMode blendMode)
+{
+    auto& renderer = Renderer::get();
+    renderer.setDepthTestEnabled(true);
+    renderer.setBlendingEnabled(true);
+    if (ParticleBlendMode::Solid == blendMode)
+    {
+        // Use the depth test to eliminate hidden portions of the particle and write into the depth buffer.
+        renderer.setDepthFunction(CompareFunction::Less);
+        renderer.setDepthWriteEnabled(true);
+    }
+    else
+    {
+        // Transparent sprites do not write into the depth buffer.
+        renderer.setDepthFunction(CompareFunction::LessOrEqual);
+        renderer.setDepthWriteEnabled(false);
+    }
+    switch (blendMode)
+    {
+        case ParticleBlendMode::Solid:
+            // Only display the portion of the particle that is 100% solid.
+            renderer.setAlphaTestEnabled(true);
+            renderer.setAlphaFunction(CompareFunction::Equal, 1.0f);
+            renderer.setBlendFunction(BlendFunction::SourceAlpha, BlendFunction::OneMinusSourceAlpha);
+            break;
+        case ParticleBlendMode::SolidEdge:
+            // Only display the alpha-edge of the particle.
+            renderer.setAlphaTestEnabled(true);
+            renderer.setAlphaFunction(CompareFunction::Less, 1.0f);
+            renderer.setBlendFunction(BlendFunction::SourceAlpha, BlendFunction::OneMinusSourceAlpha);
+            break;
+        case ParticleBlendMode::Light:
+            renderer.setAlphaTestEnabled(false);
+            renderer.setBlendFunction(BlendFunction::One, BlendFunction::One);
+            break;
+        case ParticleBlendMode::Alpha:
+            // Do not display the completely transparent portion.
+            renderer.setAlphaTestEnabled(true);
+            renderer.setAlphaFunction(CompareFunction::Greater, 0.0f);
+            renderer.setBlendFunction(BlendFunction::SourceAlpha, BlendFunction::OneMinusSourceAlpha);
+            break;
+    }
+}
+
+void ParticleBatch::RendererSink::render(const std::vector<Quad>& quads, const std::vector<DrawCall>& drawCalls)
+{
+    const size_t numberOfVertices = quads.size() * 4;
+    const auto& vertexDescriptor = VertexFormatFactory::get(VertexFormat::P3FC4FT2F);
+    if (!_vertexBuffer || _vertexBuffer->getNumberOfVertices() < numberOfVertices)
+    {
+        // Grow geometrically to avoid reallocation every frame.
+        size_t capacity = _vertexBuffer ? _vertexBuffer->getNumberOfVertices() : 1024;
+        while (capacity < numberOfVertices) capacity *= 2;
+        _vertexBuffer = std::make_unique<VertexBuffer>(capacity, vertexDescriptor.getVertexSize());
+        allocationCount++;
+    }
+    {
+        BufferScopedLock lock(*_vertexBuffer);
+        Vertex *vertices = lock.get<Vertex>();
+        for (const Quad& quad : quads)
+        {
+            vertices = std::copy(quad.vertices.begin(), quad.vertices.end(), vertices);
+        }
+    }
+
+    auto& renderer = Renderer::get();
+    OpenGL::PushAttrib pa(GL_ENABLE_BIT | GL_DEPTH_BUFFER_BIT | GL_COLOR_BUFFER_BIT | GL_CURRENT_BIT);
+    renderer.setWorldMatrix(Matrix4f4f::identity());
+    // Draw front-facing and back-facing polygons.
+    renderer.setCullingMode(CullingMode::None);
+
+    for (const DrawCall& drawCall : drawCalls)
+    {
+        setState(drawCall.blendMode);
+        renderer.getTextureUnit().setActivated(drawCall.texture);
+        renderer.render(*_vertexBuffer, vertexDescriptor, PrimitiveType::Quadriliterals, drawCall.first * 4, drawCall.count * 4);
+    }
+}
+
+void ParticleBatch::flush(bool sort)
+{
+    if (_quads.empty())
+    {
+        return;
+    }
+    if (sort)
+    {
+        std::stable_sort(_quads.begin(), _quads.end(), [](const Quad& x, const Quad& y)
+        {
+            return x.blendMode < y.blendMode || (x.blendMode == y.blendMode && std::less<const Texture *>()(x.texture, y.texture));
+        });
+    }
+
+    // Draw each run of consecutive quads sharing a blend mode and a texture.
+    for (size_t first = 0, count = _quads.size(); first < count;)
+    {
+        size_t last = first + 1;
+        while (last < count && _quads[last].blendMode == _quads[first].blendMode && _quads[last].texture == _quads[first].texture)
+        {
+            last++;
+        }
+        _drawCalls.push_back(DrawCall{_quads[first].blendMode, _quads[first].texture, first, last - first});
+        drawCallCount++;
+        quadCount += last - first;
+        first = last;
+    }
+    _sink->render(_quads, _drawCalls);
+
+    // Retain the capacity for the next frame.
+    _quads.clear();
+    _drawCalls.clear();
+}
+
+size_t ParticleBatch::getDrawCallCount()
+{
+    return drawCallCount;
+}
+
+size_t ParticleBatch::getAllocationCount()
+{
+    return allocationCount;
+}
+
+size_t ParticleBatch::getQuadCount()
+{
+    return quadCount;
+}
+
+void ParticleBatch::resetCounts()
+{
+    drawCallCount = 0;
+    allocationCount = 0;
+    quadCount = 0;
+}
+
+} // namespace Graphics
+} // namespace Ego
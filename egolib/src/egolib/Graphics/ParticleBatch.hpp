@@ -0,0 +1,169 @@
+//********************************************************************************************
+//*
+//*    This file is part of Egoboo.
+//*
+//*    Egoboo is free software: you can redistribute it and/or modify it
+//*    under the terms of the GNU General Public License as published by
+//*    the Free Software Foundation, either version 3 of the License, or
+//*    (at your option) any later version.
+//*
+//*    Egoboo is distributed in the hope that it will be useful, but
+//*    WITHOUT ANY WARRANTY; without even the implied warranty of
+//*    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+//*    General Public License for more details.
+//*
+//*    You should have received a copy of the GNU General Public License
+//*    along with Egoboo.  If not, see <http://www.gnu.org/licenses/>.
+//*
+//********************************************************************************************
+
+/// @file egolib/Graphics/ParticleBatch.hpp
+/// @brief Batching of particle sprites sharing a blend mode and a texture.
+
+#pragma once
+
+#include "egolib/typedef.h"
+#include "egolib/Math/_Include.hpp"
+#include "egolib/Graphics/VertexBuffer.hpp"
+
+namespace Ego {
+class Texture;
+} // namespace Ego
+
+namespace Ego {
+namespace Graphics {
+
+/// @brief The blend modes of particle sprites.
+enum class ParticleBlendMode
+{
+    /// @brief The opaque portion of a solid sprite. Writes into the depth buffer.
+    Solid,
+    /// @brief The alpha-blended edge of a solid sprite.
+    SolidEdge,
+    /// @brief A light sprite, blended additively.
+    Light,
+    /// @brief An alpha-blended sprite.
+    Alpha,
+};
+
+/**
+ * @brief
+ *  Accumulates the quads of particle sprites and renders consecutive quads sharing a blend mode and a texture
+ *  with a single draw call.
+ * @remark
+ *  The quads are kept in the order they were added. If the order does not matter, e.g. for sprites writing into
+ *  the depth buffer, ParticleBatch::flush may sort the quads by blend mode and texture first. Otherwise only
+ *  consecutive quads are merged such that back-to-front order of alpha-blended sprites is preserved.
+ * @remark
+ *  Code which draws other primitives between sprites must call ParticleBatch::flush before drawing them.
+ */
+class ParticleBatch final : private id::non_copyable
+{
+public:
+    /// A vertex in format VertexFormat::P3FC4FT2F.
+    struct Vertex
+    {
+        float x, y, z;
+        float r, g, b, a;
+        float s, t;
+    };
+
+    /// A queued quad.
+    struct Quad
+    {
+        ParticleBlendMode blendMode;
+        const Texture *texture;
+        std::array<Vertex, 4> vertices;
+    };
+
+    /// A run of consecutive quads sharing a blend mode and a texture, rendered with a single draw call.
+    struct DrawCall
+    {
+        ParticleBlendMode blendMode;
+        const Texture *texture;
+        size_t first;   ///< the index of the first quad
+        size_t count;   ///< the number of quads
+    };
+
+    /// @brief Renders the quads of a batch when it is flushed.
+    class Sink
+    {
+    public:
+        virtual ~Sink() {}
+
+        /**
+         * @brief
+         *  Render quads.
+         * @param quads
+         *  the quads, in the order they are rendered
+         * @param drawCalls
+         *  the draw calls, covering the quads in order
+         */
+        virtual void render(const std::vector<Quad>& quads, const std::vector<DrawCall>& drawCalls) = 0;
+    };
+
+    /// @brief Construct this batch rendering with the renderer.
+    ParticleBatch();
+
+    /// @brief Construct this batch rendering into a sink.
+    explicit ParticleBatch(std::unique_ptr<Sink> sink);
+
+    /**
+     * @brief
+     *  Queue the quad of a sprite.
+     * @param blendMode
+     *  the blend mode of the sprite
+     * @param texture
+     *  the texture of the sprite
+     * @param position
+     *  the center of the sprite
+     * @param right, up
+     *  the axes of the sprite
+     * @param size
+     *  the half extent of the sprite along its axes
+     * @param s0, t0, s1, t1
+     *  the texture coordinates of the sprite
+     * @param colour
+     *  the colour of the sprite
+     */
+    void add(ParticleBlendMode blendMode, const Texture *texture, const Vector3f& position, const Vector3f& right,
+             const Vector3f& up, float size, float s0, float t0, float s1, float t1, const Math::Colour4f& colour);
+
+    /**
+     * @brief
+     *  Render and discard all queued quads.
+     * @param sort
+     *  if @a true, the quads are sorted by blend mode and texture before they are rendered
+     * @remark
+     *  The depth test, the depth write, the alpha test, blending and the texture are set once per draw call.
+     *  Only sprites of the solid blend mode write into the depth buffer.
+     */
+    void flush(bool sort);
+
+    /// @brief Get the number of draw calls issued by all particle batches since the last call to resetCounts.
+    static size_t getDrawCallCount();
+
+    /// @brief Get the number of buffer allocations of all particle batches since the last call to resetCounts.
+    static size_t getAllocationCount();
+
+    /// @brief Get the number of quads rendered by all particle batches since the last call to resetCounts.
+    static size_t getQuadCount();
+
+    /// @brief Reset the draw call, allocation and quad counts.
+    static void resetCounts();
+
+private:
+    /// The sink rendering with the renderer.
+    class RendererSink;
+
+    std::vector<Quad> _quads;                     ///< the queued quads, the capacity is retained between flushes
+    std::vector<DrawCall> _drawCalls;             ///< the draw calls of a flush, the capacity is retained between flushes
+    std::unique_ptr<Sink> _sink;                  ///< the sink rendering the quads
+
+    static size_t drawCallCount;
+    static size_t allocationCount;
+    static size_t quadCount;
+};
+
+} // namespace Graphics
+} // namespace Ego
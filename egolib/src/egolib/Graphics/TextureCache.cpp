@@ -0,0 +1,181 @@
+//********************************************************************************************
+//*
+//*    This file is part of Egoboo.
+//*
+//*    Egoboo is free software: you can redistribute it and/or modify it
+//*    under the terms of the GNU General Public License as published by
+//*    the Free Software Foundation, either version 3 of the License, or
+//*    (at your option) any later version.
+//*
+//*    Egoboo is distributed in the hope that it will be useful, but
+//*    WITHOUT ANY WARRANTY; without even the implied warranty of
+//*    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+//*    General Public License for more details.
+//*
+//*    You should have received a copy of the GNU General Public License
+//*    along with Egoboo.  If not, see <http://www.gnu.org/licenses/>.
+//*
+//********************************************************************************************
+
+/// @file   egolib/Graphics/TextureCache.cpp
+/// @brief  A persistent cache of cooked textures.
+
+#include "egolib/Graphics/TextureCache.hpp"
+
+#include "egolib/Image/ImageLoader.hpp"
+#include "egolib/Log/_Include.hpp"
+#include "egolib/vfs.h"
+
+namespace Ego {
+
+TextureCache::TextureCache(const std::string& directory, uint64_t capacity) :
+    _directory(directory),
+    _capacity(capacity),
+    _files(),
+    _size(0),
+    _useCount(0),
+    _hitCount(0),
+    _missCount(0),
+    _evictionCount(0) {
+    if (!_directory.empty() && 1 != fs_fileIsDirectory(_directory) && 0 != fs_createDirectory(_directory)) {
+        Log::get() << Log::Entry::create(Log::Level::Warning, __FILE__, __LINE__, "unable to create texture cache directory ",
+                                         "`", _directory, "`", " - cooked textures are not stored", Log::EndOfEntry);
+        _directory.clear();
+    }
+    if (_directory.empty()) {
+        return;
+    }
+    // Order the cooked textures of earlier runs by their modification time.
+    std::vector<std::pair<int64_t, std::string>> found;
+    fs_find_context_t context;
+    for (const char *filename = fs_findFirstFile(_directory.c_str(), "etx", &context); nullptr != filename;
+         filename = fs_findNextFile(&context)) {
+        const std::string pathname = _directory + SLASH_STR + filename;
+        uint64_t size;
+        int64_t modificationTime;
+        if (fs_getFileInfo(pathname, &size, &modificationTime)) {
+            found.emplace_back(modificationTime, pathname);
+            _files[pathname] = CachedFile{size, 0};
+            _size += size;
+        }
+    }
+    fs_findClose(&context);
+    std::sort(found.begin(), found.end());
+    for (const auto& file : found) {
+        _files[file.second].lastUse = _useCount++;
+    }
+    evict(std::string());
+}
+
+std::string TextureCache::getDefaultDirectory() {
+    return fs_getUserDirectory() + std::string(SLASH_STR) + "texturecache";
+}
+
+std::string TextureCache::getCachePathname(const std::string& sourcePathname) const {
+    static const char *digits = "0123456789abcdef";
+    uint64_t key = CookedTexture::hash(sourcePathname.data(), sourcePathname.size());
+    std::string name(16, '0');
+    for (size_t i = 0; i < 16; ++i) {
+        name[15 - i] = digits[key & 0xf];
+        key >>= 4;
+    }
+    return _directory + SLASH_STR + name + ".etx";
+}
+
+void TextureCache::touch(const std::string& cachePathname) {
+    uint64_t size;
+    int64_t modificationTime;
+    if (!fs_getFileInfo(cachePathname, &size, &modificationTime)) {
+        return;
+    }
+    auto it = _files.find(cachePathname);
+    if (it != _files.end()) {
+        _size -= it->second.size;
+    }
+    _files[cachePathname] = CachedFile{size, _useCount++};
+    _size += size;
+}
+
+void TextureCache::evict(const std::string& keep) {
+    if (_size <= _capacity) {
+        return;
+    }
+    std::vector<std::pair<uint64_t, std::string>> files;
+    for (const auto& file : _files) {
+        files.emplace_back(file.second.lastUse, file.first);
+    }
+    std::sort(files.begin(), files.end());
+    for (const auto& file : files) {
+        if (_size <= _capacity) {
+            break;
+        }
+        if (file.second == keep) {
+            continue;
+        }
+        fs_deleteFile(file.second);
+        _size -= _files[file.second].size;
+        _files.erase(file.second);
+        _evictionCount++;
+    }
+}
+
+std::shared_ptr<CookedTexture> TextureCache::get(const std::string& pathname, const ImageLoader& loader) {
+    // Hash the image file.
+    uint64_t sourceHash = CookedTexture::HashBasis;
+    try {
+        vfs_readEntireFile(pathname, [&sourceHash](size_t length, const char *data) {
+            sourceHash = CookedTexture::hash(data, length, sourceHash);
+        });
+    } catch (const id::runtime_error&) {
+        return nullptr;
+    }
+
+    // Map the cooked texture if it exists and is up to date.
+    std::string cachePathname;
+    if (!_directory.empty()) {
+        auto resolved = vfs_resolveReadFilename(pathname);
+        cachePathname = getCachePathname(resolved.first ? resolved.second : pathname);
+        auto cooked = CookedTexture::load(cachePathname, sourceHash);
+        if (cooked) {
+            _hitCount++;
+            touch(cachePathname);
+            return cooked;
+        }
+    }
+
+    // Otherwise decode the image file and cook it.
+    vfs_FILE *file = vfs_openRead(pathname);
+    if (!file) {
+        return nullptr;
+    }
+    std::shared_ptr<CookedTexture> cooked;
+    try {
+        auto surface = loader.load(file);
+        vfs_close(file);
+        file = nullptr;
+        if (!surface) {
+            return nullptr;
+        }
+        // 1D textures have no mipmaps, see Ego::OpenGL::Texture.
+        bool mipMaps = !((1 == surface->h) && (surface->w > 1));
+        cooked = CookedTexture::cook(surface, sourceHash, mipMaps);
+    } catch (...) {
+        if (file) {
+            vfs_close(file);
+        }
+        return nullptr;
+    }
+    _missCount++;
+    if (!cachePathname.empty()) {
+        if (cooked->save(cachePathname)) {
+            touch(cachePathname);
+            evict(cachePathname);
+        } else {
+            Log::get() << Log::Entry::create(Log::Level::Warning, __FILE__, __LINE__, "unable to store cooked texture ",
+                                             "`", cachePathname, "`", Log::EndOfEntry);
+        }
+    }
+    return cooked;
+}
+
+} // namespace Ego
@@ -0,0 +1,113 @@
+//********************************************************************************************
+//*
+//*    This file is part of Egoboo.
+//*
+//*    Egoboo is free software: you can redistribute it and/or modify it
+//*    under the terms of the GNU General Public License as published by
+//*    the Free Software Foundation, either version 3 of the License, or
+//*    (at your option) any later version.
+//*
+//*    Egoboo is distributed in the hope that it will be useful, but
+//*    WITHOUT ANY WARRANTY; without even the implied warranty of
+//*    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+//*    General Public License for more details.
+//*
+//*    You should have received a copy of the GNU General Public License
+//*    along with Egoboo.  If not, see <http://www.gnu.org/licenses/>.
+//*
+//********************************************************************************************
+
+/// @file   egolib/Graphics/TextureCache.hpp
+/// @brief  A persistent cache of cooked textures.
+
+#pragma once
+
+#include "egolib/Graphics/CookedTexture.hpp"
+
+namespace Ego {
+
+// Forward declaration.
+class ImageLoader;
+
+/**
+ * @brief
+ *  A persistent cache of cooked textures. An image file is cooked on its first load and the
+ *  cooked texture is stored in the cache directory. Subsequent loads of the same - unchanged -
+ *  image file map the cooked texture instead of decoding, converting and generating mipmaps.
+ * @remark
+ *  A cooked texture is keyed by the native pathname of its image file and stores the hash of the
+ *  contents of its image file: If the image file has changed, the cooked texture is replaced.
+ * @remark
+ *  The total size of the cooked textures in the cache directory is bounded. If it exceeds the
+ *  capacity, the least recently used cooked textures are removed. Cooked textures stored by
+ *  earlier runs are ordered by their modification time.
+ */
+class TextureCache : private id::non_copyable {
+public:
+    /// The default capacity, in Bytes, of a texture cache.
+    static constexpr uint64_t DefaultCapacity = 256 * 1024 * 1024;
+
+    /**
+     * @brief
+     *  Construct this texture cache.
+     * @param directory
+     *  the native pathname of the cache directory, created if it does not exist.
+     *  If it is the empty string, textures are cooked but not stored.
+     * @param capacity
+     *  the upper bound, in Bytes, of the total size of the cooked textures in the cache directory
+     */
+    TextureCache(const std::string& directory, uint64_t capacity);
+
+    /**
+     * @brief
+     *  Get the cooked texture of an image file.
+     * @param pathname
+     *  the VFS pathname of the image file
+     * @param loader
+     *  the image loader for the image file
+     * @return
+     *  the cooked texture on success, a null pointer on failure
+     */
+    std::shared_ptr<CookedTexture> get(const std::string& pathname, const ImageLoader& loader);
+
+    /// Get the number of textures loaded from the cache.
+    size_t getHitCount() const { return _hitCount; }
+
+    /// Get the number of textures cooked.
+    size_t getMissCount() const { return _missCount; }
+
+    /// Get the number of cooked textures removed from the cache directory to stay within the capacity.
+    size_t getEvictionCount() const { return _evictionCount; }
+
+    /// Get the total size, in Bytes, of the cooked textures in the cache directory.
+    uint64_t getSize() const { return _size; }
+
+    /// Get the native pathname of the default cache directory.
+    static std::string getDefaultDirectory();
+
+private:
+    /// Get the native pathname of the cooked texture of an image file.
+    std::string getCachePathname(const std::string& sourcePathname) const;
+
+    /// Record that a cooked texture in the cache directory was used or stored.
+    void touch(const std::string& cachePathname);
+
+    /// Remove the least recently used cooked textures until the cache is within its capacity.
+    void evict(const std::string& keep);
+
+    struct CachedFile {
+        uint64_t size;      ///< the size of the cooked texture
+        uint64_t lastUse;   ///< greater for more recently used cooked textures
+    };
+
+    std::string _directory;                                 ///< the cache directory or the empty string
+    uint64_t _capacity;                                     ///< the upper bound of the total size of the cooked textures
+    std::unordered_map<std::string, CachedFile> _files;     ///< the cooked textures in the cache directory
+    uint64_t _size;                                         ///< the total size of the cooked textures
+    uint64_t _useCount;                                     ///< the next value of CachedFile::lastUse
+    size_t _hitCount;                                       ///< the number of textures loaded from the cache
+    size_t _missCount;                                      ///< the number of textures cooked
+    size_t _evictionCount;                                  ///< the number of cooked textures removed
+};
+
+} // namespace Ego
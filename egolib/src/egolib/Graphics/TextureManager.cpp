@@ -25,6 +25,7 @@
 #include "egolib/Graphics/TextureManager.hpp"
 #include "egolib/Image/ImageManager.hpp"
 #include "egolib/Image/ImageLoader.hpp"
+#include "egolib/Graphics/TextureCache.hpp"
 
 /**
  * @brief
@@ -33,6 +34,8 @@
  *  the texture to load the image in
  * @param filename
  *  the filename of the image <em>without</em> extension.
+ * @param cache
+ *  the cache of cooked textures
  * @param key
  *  ?
  * @post
@@ -42,9 +45,9 @@
  *  succeeds (i.e. the image was successfully loaded into the texture) or all
  *  combinations failed.
  */
-static bool ego_texture_load_vfs(std::shared_ptr<Ego::Texture> texture, const char *filename);
+static bool ego_texture_load_vfs(std::shared_ptr<Ego::Texture> texture, const char *filename, Ego::TextureCache& cache);
 
-static bool ego_texture_load_vfs(std::shared_ptr<Ego::Texture> texture, const char *filename) {
+static bool ego_texture_load_vfs(std::shared_ptr<Ego::Texture> texture, const char *filename, Ego::TextureCache& cache) {
     // Get rid of any old data.
     texture->release();
 
@@ -57,25 +60,16 @@ static bool ego_texture_load_vfs(std::shared_ptr<Ego::Texture> texture, const ch
             texture->release();
             // Build the full file name.
             std::string fullFilename = filename + extension;
-            // Open the file.
-            vfs_FILE *file = vfs_openRead(fullFilename);
-            if (!file) {
+            if (!vfs_exists(fullFilename)) {
                 continue;
             }
-            // Stream the surface.
-            std::shared_ptr<SDL_Surface> surface = nullptr;
-            try {
-                surface = loader.load(file);
-            } catch (...) {
-                vfs_close(file);
+            // Get the cooked texture, either from the cache or by decoding the image.
+            auto cooked = cache.get(fullFilename, loader);
+            if (!cooked) {
                 continue;
             }
-            vfs_close(file);
-            if (!surface) {
-                continue;
-            }
-            // Create the texture from the surface.
-            retval = texture->load(fullFilename.c_str(), surface);
+            // Create the texture from the cooked texture.
+            retval = texture->load(fullFilename, cooked);
             if (retval) {
                 goto End;
             }
@@ -95,6 +89,7 @@ End:
 
 namespace Ego {
 TextureManager::TextureManager() :
+    _cookedTextures(std::make_unique<TextureCache>(TextureCache::getDefaultDirectory(), TextureCache::DefaultCapacity)),
     _deferredLoadingMutex(),
     _requestedLoadDeferredTextures(),
     _notifyDeferredLoadingComplete()
@@ -132,7 +127,7 @@ void TextureManager::updateDeferredLoading() {
         std::lock_guard<std::mutex> lock(_deferredLoadingMutex);
         for (const std::string &filePath : _requestedLoadDeferredTextures) {
             auto loadTexture = Ego::Renderer::get().createTexture();
-            ego_texture_load_vfs(loadTexture, filePath.c_str());
+            ego_texture_load_vfs(loadTexture, filePath.c_str(), *_cookedTextures);
             _textureCache[filePath] = loadTexture;
         }
         _requestedLoadDeferredTextures.clear();
@@ -150,7 +145,7 @@ const std::shared_ptr<Texture>& TextureManager::getTexture(const std::string &fi
         if (SDL_GL_GetCurrentContext() != nullptr) {
             //We are the main OpenGL context thread so we can load textures
             auto loadTexture = Ego::Renderer::get().createTexture();
-            ego_texture_load_vfs(loadTexture, filePath.c_str());
+            ego_texture_load_vfs(loadTexture, filePath.c_str(), *_cookedTextures);
             _textureCache[filePath] = loadTexture;
         } else {
             //We cannot load textures, wait blocking for main thread to load it for us
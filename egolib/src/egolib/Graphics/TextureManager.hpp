@@ -27,6 +27,9 @@
 
 namespace Ego {
 
+// Forward declaration.
+class TextureCache;
+
 struct TextureManager : public Core::Singleton<TextureManager> {
 protected:
     friend Core::Singleton<TextureManager>::CreateFunctorType;
@@ -81,6 +84,7 @@ public:
     void updateDeferredLoading();
 
 private:
+    std::unique_ptr<TextureCache> _cookedTextures;
     std::forward_list<std::shared_ptr<Texture>> _unload;
     std::unordered_map<std::string, std::shared_ptr<Texture>> _textureCache;
 
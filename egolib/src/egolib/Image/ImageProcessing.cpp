@@ -0,0 +1,345 @@
+//********************************************************************************************
+//*
+//*    This file is part of Egoboo.
+//*
+//*    Egoboo is free software: you can redistribute it and/or modify it
+//*    under the terms of the GNU General Public License as published by
+//*    the Free Software Foundation, either version 3 of the License, or
+//*    (at your option) any later version.
+//*
+//*    Egoboo is distributed in the hope that it will be useful, but
+//*    WITHOUT ANY WARRANTY; without even the implied warranty of
+//*    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+//*    General Public License for more details.
+//*
+//*    You should have received a copy of the GNU General Public License
+//*    along with Egoboo.  If not, see <http://www.gnu.org/licenses/>.
+//*
+//********************************************************************************************
+
+/// @file egolib/Image/ImageProcessing.cpp
+/// @brief Kernels for converting, padding and downsampling pixels.
+
+#include "egolib/Image/ImageProcessing.hpp"
+
+#include <cstring>
+
+#if defined(__AVX2__)
+    #define EGO_IMAGEPROCESSING_AVX2 1
+    #define EGO_IMAGEPROCESSING_SSE2 1
+    #include <immintrin.h>
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+    #define EGO_IMAGEPROCESSING_AVX2 0
+    #define EGO_IMAGEPROCESSING_SSE2 1
+    #include <emmintrin.h>
+#else
+    #define EGO_IMAGEPROCESSING_AVX2 0
+    #define EGO_IMAGEPROCESSING_SSE2 0
+#endif
+
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+    #define EGO_IMAGEPROCESSING_BIG_ENDIAN 1
+#else
+    #define EGO_IMAGEPROCESSING_BIG_ENDIAN 0
+#endif
+
+namespace Ego {
+namespace ImageProcessing {
+
+namespace {
+
+inline uint32_t load(const uint8_t *p, size_t bytesPerPixel)
+{
+    if (4 == bytesPerPixel)
+    {
+        uint32_t v;
+        std::memcpy(&v, p, 4);
+        return v;
+    }
+#if EGO_IMAGEPROCESSING_BIG_ENDIAN
+    return p[0] << 16 | p[1] << 8 | p[2];
+#else
+    return p[0] | p[1] << 8 | p[2] << 16;
+#endif
+}
+
+inline void store(uint8_t *p, size_t bytesPerPixel, uint32_t v)
+{
+    if (4 == bytesPerPixel)
+    {
+        std::memcpy(p, &v, 4);
+        return;
+    }
+#if EGO_IMAGEPROCESSING_BIG_ENDIAN
+    p[0] = (v >> 16) & 0xff;
+    p[1] = (v >> 8) & 0xff;
+    p[2] = v & 0xff;
+#else
+    p[0] = v & 0xff;
+    p[1] = (v >> 8) & 0xff;
+    p[2] = (v >> 16) & 0xff;
+#endif
+}
+
+inline uint32_t convertPixel(uint32_t v, const ChannelLayout& s, const ChannelLayout& t)
+{
+    const uint32_t r = (v >> s.redShift) & 0xff,
+                   g = (v >> s.greenShift) & 0xff,
+                   b = (v >> s.blueShift) & 0xff,
+                   a = s.hasAlpha ? (v >> s.alphaShift) & 0xff : 0xff;
+    return r << t.redShift | g << t.greenShift | b << t.blueShift | (t.hasAlpha ? a << t.alphaShift : 0);
+}
+
+// Average the Bytes of 2 or 4 pixels with rounding.
+inline void average2(const uint8_t *a, const uint8_t *b, size_t bytesPerPixel, uint8_t *t)
+{
+    for (size_t i = 0; i < bytesPerPixel; ++i)
+    {
+        t[i] = static_cast<uint8_t>((a[i] + b[i] + 1) >> 1);
+    }
+}
+
+inline void average4(const uint8_t *a, const uint8_t *b, const uint8_t *c, const uint8_t *d, size_t bytesPerPixel, uint8_t *t)
+{
+    for (size_t i = 0; i < bytesPerPixel; ++i)
+    {
+        t[i] = static_cast<uint8_t>((a[i] + b[i] + c[i] + d[i] + 2) >> 2);
+    }
+}
+
+#if EGO_IMAGEPROCESSING_SSE2
+// Convert 4 pixels.
+inline __m128i convert4(__m128i v, const ChannelLayout& s, const ChannelLayout& t)
+{
+    const __m128i mask = _mm_set1_epi32(0xff);
+    __m128i r = _mm_and_si128(_mm_srl_epi32(v, _mm_cvtsi32_si128(s.redShift)), mask),
+            g = _mm_and_si128(_mm_srl_epi32(v, _mm_cvtsi32_si128(s.greenShift)), mask),
+            b = _mm_and_si128(_mm_srl_epi32(v, _mm_cvtsi32_si128(s.blueShift)), mask);
+    __m128i w = _mm_or_si128(_mm_or_si128(_mm_sll_epi32(r, _mm_cvtsi32_si128(t.redShift)),
+                                          _mm_sll_epi32(g, _mm_cvtsi32_si128(t.greenShift))),
+                             _mm_sll_epi32(b, _mm_cvtsi32_si128(t.blueShift)));
+    if (t.hasAlpha)
+    {
+        __m128i a = s.hasAlpha ? _mm_and_si128(_mm_srl_epi32(v, _mm_cvtsi32_si128(s.alphaShift)), mask) : mask;
+        w = _mm_or_si128(w, _mm_sll_epi32(a, _mm_cvtsi32_si128(t.alphaShift)));
+    }
+    return w;
+}
+
+// Downsample 4 x 2 pixels of 4 Bytes into 2 pixels.
+inline __m128i downsample4(__m128i row0, __m128i row1)
+{
+    const __m128i zero = _mm_setzero_si128();
+    // The sums of the vertical pairs, 2 pixels of 16 Bit channels each.
+    __m128i lo = _mm_add_epi16(_mm_unpacklo_epi8(row0, zero), _mm_unpacklo_epi8(row1, zero)),
+            hi = _mm_add_epi16(_mm_unpackhi_epi8(row0, zero), _mm_unpackhi_epi8(row1, zero));
+    // The sums of the horizontal pairs.
+    lo = _mm_add_epi16(lo, _mm_srli_si128(lo, 8));
+    hi = _mm_add_epi16(hi, _mm_srli_si128(hi, 8));
+    __m128i sum = _mm_unpacklo_epi64(lo, hi);
+    sum = _mm_srli_epi16(_mm_add_epi16(sum, _mm_set1_epi16(2)), 2);
+    return _mm_packus_epi16(sum, zero);
+}
+#endif
+
+#if EGO_IMAGEPROCESSING_AVX2
+// Convert 8 pixels.
+inline __m256i convert8(__m256i v, const ChannelLayout& s, const ChannelLayout& t)
+{
+    const __m256i mask = _mm256_set1_epi32(0xff);
+    __m256i r = _mm256_and_si256(_mm256_srl_epi32(v, _mm_cvtsi32_si128(s.redShift)), mask),
+            g = _mm256_and_si256(_mm256_srl_epi32(v, _mm_cvtsi32_si128(s.greenShift)), mask),
+            b = _mm256_and_si256(_mm256_srl_epi32(v, _mm_cvtsi32_si128(s.blueShift)), mask);
+    __m256i w = _mm256_or_si256(_mm256_or_si256(_mm256_sll_epi32(r, _mm_cvtsi32_si128(t.redShift)),
+                                                _mm256_sll_epi32(g, _mm_cvtsi32_si128(t.greenShift))),
+                                _mm256_sll_epi32(b, _mm_cvtsi32_si128(t.blueShift)));
+    if (t.hasAlpha)
+    {
+        __m256i a = s.hasAlpha ? _mm256_and_si256(_mm256_srl_epi32(v, _mm_cvtsi32_si128(s.alphaShift)), mask) : mask;
+        w = _mm256_or_si256(w, _mm256_sll_epi32(a, _mm_cvtsi32_si128(t.alphaShift)));
+    }
+    return w;
+}
+
+// Downsample 8 x 2 pixels of 4 Bytes into 4 pixels.
+inline __m128i downsample8(__m256i row0, __m256i row1)
+{
+    const __m256i zero = _mm256_setzero_si256();
+    // Unpacking, shifting and packing operate on the 128 Bit lanes independently.
+    __m256i lo = _mm256_add_epi16(_mm256_unpacklo_epi8(row0, zero), _mm256_unpacklo_epi8(row1, zero)),
+            hi = _mm256_add_epi16(_mm256_unpackhi_epi8(row0, zero), _mm256_unpackhi_epi8(row1, zero));
+    lo = _mm256_add_epi16(lo, _mm256_srli_si256(lo, 8));
+    hi = _mm256_add_epi16(hi, _mm256_srli_si256(hi, 8));
+    __m256i sum = _mm256_unpacklo_epi64(lo, hi);
+    sum = _mm256_srli_epi16(_mm256_add_epi16(sum, _mm256_set1_epi16(2)), 2);
+    // The result are the low 64 Bit of each lane.
+    __m256i packed = _mm256_permute4x64_epi64(_mm256_packus_epi16(sum, zero), 0x08);
+    return _mm256_castsi256_si128(packed);
+}
+#endif
+
+} // namespace
+
+const char *getInstructionSet()
+{
+#if EGO_IMAGEPROCESSING_AVX2
+    return "AVX2";
+#elif EGO_IMAGEPROCESSING_SSE2
+    return "SSE2";
+#else
+    return "scalar";
+#endif
+}
+
+bool hasNonOpaquePixel(const void *pixels, size_t width, size_t height, size_t pitch, uint32_t alphaMask)
+{
+    const uint8_t *row = static_cast<const uint8_t *>(pixels);
+    for (size_t y = 0; y < height; ++y, row += pitch)
+    {
+        size_t x = 0;
+    #if EGO_IMAGEPROCESSING_AVX2
+        const __m256i mask8 = _mm256_set1_epi32(alphaMask);
+        for (; x + 8 <= width; x += 8)
+        {
+            __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(row + x * 4));
+            if (-1 != _mm256_movemask_epi8(_mm256_cmpeq_epi32(_mm256_and_si256(v, mask8), mask8)))
+            {
+                return true;
+            }
+        }
+    #endif
+    #if EGO_IMAGEPROCESSING_SSE2
+        const __m128i mask4 = _mm_set1_epi32(alphaMask);
+        for (; x + 4 <= width; x += 4)
+        {
+            __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i *>(row + x * 4));
+            if (0xffff != _mm_movemask_epi8(_mm_cmpeq_epi32(_mm_and_si128(v, mask4), mask4)))
+            {
+                return true;
+            }
+        }
+    #endif
+        for (; x < width; ++x)
+        {
+            if (alphaMask != (load(row + x * 4, 4) & alphaMask))
+            {
+                return true;
+            }
+        }
+    }
+    return false;
+}
+
+void convert(const void *source, size_t sourcePitch, const ChannelLayout& sourceLayout,
+             void *target, size_t targetPitch, const ChannelLayout& targetLayout, size_t targetBytesPerPixel,
+             size_t width, size_t height)
+{
+    const uint8_t *sourceRow = static_cast<const uint8_t *>(source);
+    uint8_t *targetRow = static_cast<uint8_t *>(target);
+    for (size_t y = 0; y < height; ++y, sourceRow += sourcePitch, targetRow += targetPitch)
+    {
+        size_t x = 0;
+        if (4 == targetBytesPerPixel)
+        {
+        #if EGO_IMAGEPROCESSING_AVX2
+            for (; x + 8 <= width; x += 8)
+            {
+                __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(sourceRow + x * 4));
+                _mm256_storeu_si256(reinterpret_cast<__m256i *>(targetRow + x * 4), convert8(v, sourceLayout, targetLayout));
+            }
+        #endif
+        #if EGO_IMAGEPROCESSING_SSE2
+            for (; x + 4 <= width; x += 4)
+            {
+                __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i *>(sourceRow + x * 4));
+                _mm_storeu_si128(reinterpret_cast<__m128i *>(targetRow + x * 4), convert4(v, sourceLayout, targetLayout));
+            }
+        #endif
+        }
+        // Packing into 3 Byte pixels is not vectorized.
+        for (; x < width; ++x)
+        {
+            store(targetRow + x * targetBytesPerPixel, targetBytesPerPixel,
+                  convertPixel(load(sourceRow + x * 4, 4), sourceLayout, targetLayout));
+        }
+    }
+}
+
+void pad(const void *source, size_t sourcePitch, size_t sourceWidth, size_t sourceHeight,
+         void *target, size_t targetPitch, size_t targetWidth, size_t targetHeight, size_t bytesPerPixel)
+{
+    const uint8_t *sourceRow = static_cast<const uint8_t *>(source);
+    uint8_t *targetRow = static_cast<uint8_t *>(target);
+    const size_t sourceRowSize = sourceWidth * bytesPerPixel,
+                 targetRowSize = targetWidth * bytesPerPixel;
+    for (size_t y = 0; y < sourceHeight; ++y, sourceRow += sourcePitch, targetRow += targetPitch)
+    {
+        std::memcpy(targetRow, sourceRow, sourceRowSize);
+        std::memset(targetRow + sourceRowSize, 0, targetRowSize - sourceRowSize);
+    }
+    for (size_t y = sourceHeight; y < targetHeight; ++y, targetRow += targetPitch)
+    {
+        std::memset(targetRow, 0, targetRowSize);
+    }
+}
+
+void downsample(const void *source, size_t width, size_t height, size_t bytesPerPixel, void *target)
+{
+    const uint8_t *s = static_cast<const uint8_t *>(source);
+    uint8_t *t = static_cast<uint8_t *>(target);
+    if (1 == width && 1 == height)
+    {
+        std::memcpy(t, s, bytesPerPixel);
+    }
+    else if (1 == width || 1 == height)
+    {
+        // A row or a column: Average pairs of adjacent pixels.
+        const size_t count = (1 == width) ? height / 2 : width / 2;
+        for (size_t i = 0; i < count; ++i)
+        {
+            average2(s + 2 * i * bytesPerPixel, s + (2 * i + 1) * bytesPerPixel, bytesPerPixel, t + i * bytesPerPixel);
+        }
+    }
+    else
+    {
+        const size_t targetWidth = width / 2,
+                     targetHeight = height / 2,
+                     pitch = width * bytesPerPixel;
+        for (size_t y = 0; y < targetHeight; ++y)
+        {
+            const uint8_t *row0 = s + 2 * y * pitch,
+                          *row1 = row0 + pitch;
+            uint8_t *targetRow = t + y * targetWidth * bytesPerPixel;
+            size_t x = 0;
+            if (4 == bytesPerPixel)
+            {
+            #if EGO_IMAGEPROCESSING_AVX2
+                for (; x + 4 <= targetWidth; x += 4)
+                {
+                    __m256i a = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(row0 + x * 8)),
+                            b = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(row1 + x * 8));
+                    _mm_storeu_si128(reinterpret_cast<__m128i *>(targetRow + x * 4), downsample8(a, b));
+                }
+            #endif
+            #if EGO_IMAGEPROCESSING_SSE2
+                for (; x + 2 <= targetWidth; x += 2)
+                {
+                    __m128i a = _mm_loadu_si128(reinterpret_cast<const __m128i *>(row0 + x * 8)),
+                            b = _mm_loadu_si128(reinterpret_cast<const __m128i *>(row1 + x * 8));
+                    _mm_storel_epi64(reinterpret_cast<__m128i *>(targetRow + x * 4), downsample4(a, b));
+                }
+            #endif
+            }
+            // 3 Byte pixels are not vectorized.
+            for (; x < targetWidth; ++x)
+            {
+                average4(row0 + 2 * x * bytesPerPixel, row0 + (2 * x + 1) * bytesPerPixel,
+                         row1 + 2 * x * bytesPerPixel, row1 + (2 * x + 1) * bytesPerPixel,
+                         bytesPerPixel, targetRow + x * bytesPerPixel);
+            }
+        }
+    }
+}
+
+} // namespace ImageProcessing
+} // namespace Ego
@@ -0,0 +1,83 @@
+//********************************************************************************************
+//*
+//*    This file is part of Egoboo.
+//*
+//*    Egoboo is free software: you can redistribute it and/or modify it
+//*    under the terms of the GNU General Public License as published by
+//*    the Free Software Foundation, either version 3 of the License, or
+//*    (at your option) any later version.
+//*
+//*    Egoboo is distributed in the hope that it will be useful, but
+//*    WITHOUT ANY WARRANTY; without even the implied warranty of
+//*    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+//*    General Public License for more details.
+//*
+//*    You should have received a copy of the GNU General Public License
+//*    along with Egoboo.  If not, see <http://www.gnu.org/licenses/>.
+//*
+//********************************************************************************************
+
+/// @file egolib/Image/ImageProcessing.hpp
+/// @brief Kernels for converting, padding and downsampling pixels.
+/// @remark
+/// The kernels operate on plain memory and do not touch SDL state, hence they can be used from any thread.
+/// They are vectorized with AVX2 or SSE2 if the compiler targets these instruction sets and scalar otherwise.
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+namespace Ego {
+namespace ImageProcessing {
+
+/// @brief The layout of a pixel of 8 Bit channels in a 32 Bit word (w.r.t. the host Byte order).
+struct ChannelLayout
+{
+    /// @brief The shifts of the red, green, blue and alpha channels. Multiples of 8.
+    uint32_t redShift, greenShift, blueShift, alphaShift;
+    /// @brief If the pixel has an alpha channel. If not, the alpha channel is assumed to be opaque.
+    bool hasAlpha;
+};
+
+/// @brief Get the name of the instruction set the kernels were compiled for.
+/// @return @a "AVX2", @a "SSE2" or @a "scalar"
+const char *getInstructionSet();
+
+/// @brief Get if a 32 Bit pixel rectangle has a non-opaque pixel.
+/// @param pixels a pointer to the first pixel
+/// @param width, height the width and height, in pixels, of the rectangle
+/// @param pitch the distance, in Bytes, between two rows
+/// @param alphaMask the mask of the alpha Bits, a pixel is opaque if all of its alpha Bits are set
+/// @return @a true if there is a non-opaque pixel, @a false otherwise
+bool hasNonOpaquePixel(const void *pixels, size_t width, size_t height, size_t pitch, uint32_t alphaMask);
+
+/// @brief Convert a 32 Bit pixel rectangle to another layout of 8 Bit channels.
+/// @param source, sourcePitch, sourceLayout the source pixels, their pitch and their layout
+/// @param target, targetPitch, targetLayout the target pixels, their pitch and their layout
+/// @param targetBytesPerPixel the number of Bytes per target pixel, 3 or 4
+/// @param width, height the width and height, in pixels, of the rectangle
+/// @remark If the target has no alpha channel, the alpha channel of the source is dropped.
+void convert(const void *source, size_t sourcePitch, const ChannelLayout& sourceLayout,
+             void *target, size_t targetPitch, const ChannelLayout& targetLayout, size_t targetBytesPerPixel,
+             size_t width, size_t height);
+
+/// @brief Copy a pixel rectangle into the top left corner of a larger pixel rectangle and fill the remainder with zero Bytes.
+/// @param source, sourcePitch the source pixels and their pitch
+/// @param sourceWidth, sourceHeight the width and height, in pixels, of the source rectangle
+/// @param target, targetPitch the target pixels and their pitch
+/// @param targetWidth, targetHeight the width and height, in pixels, of the target rectangle
+/// @param bytesPerPixel the number of Bytes per pixel
+void pad(const void *source, size_t sourcePitch, size_t sourceWidth, size_t sourceHeight,
+         void *target, size_t targetPitch, size_t targetWidth, size_t targetHeight, size_t bytesPerPixel);
+
+/// @brief Compute the next mipmap level of a tightly packed pixel rectangle by a 2 x 2 box filter.
+/// @param source the source pixels
+/// @param width, height the width and height, in pixels, of the source rectangle, powers of two
+/// @param bytesPerPixel the number of Bytes per pixel, 3 or 4
+/// @param target the target pixels of size <tt>max(1, width / 2) x max(1, height / 2)</tt>, tightly packed
+/// @remark If one of the dimensions is 1, the pixels are averaged along the other dimension only.
+void downsample(const void *source, size_t width, size_t height, size_t bytesPerPixel, void *target);
+
+} // namespace ImageProcessing
+} // namespace Ego
@@ -23,10 +23,46 @@
 
 #include "egolib/Image/SDL_Image_Extensions.h"
 #include "egolib/Image/ImageManager.hpp"
+#include "egolib/Image/ImageProcessing.hpp"
 
 namespace Ego {
 namespace SDL {
 
+/// @brief Get the channel layout of 8 Bit channels for the specified masks and shifts.
+/// @return @a true if the masks describe byte-aligned 8 Bit channels, @a false otherwise
+static bool getChannelLayout(uint32_t redMask, uint32_t greenMask, uint32_t blueMask, uint32_t alphaMask,
+                             uint32_t redShift, uint32_t greenShift, uint32_t blueShift, uint32_t alphaShift,
+                             ImageProcessing::ChannelLayout& layout)
+{
+    auto isByte = [](uint32_t mask, uint32_t shift) { return 0 == shift % 8 && shift < 32 && (uint32_t(0xff) << shift) == mask; };
+    if (!isByte(redMask, redShift) || !isByte(greenMask, greenShift) || !isByte(blueMask, blueShift) ||
+        (0 != alphaMask && !isByte(alphaMask, alphaShift)))
+    {
+        return false;
+    }
+    layout.redShift = redShift;
+    layout.greenShift = greenShift;
+    layout.blueShift = blueShift;
+    layout.alphaShift = alphaShift;
+    layout.hasAlpha = 0 != alphaMask;
+    return true;
+}
+
+/// @brief Get if the pixels of a surface are 32 Bit pixels of 8 Bit channels accessible without locking.
+/// @remark Surfaces with a colour key are excluded as SDL converts their colour key to transparency.
+static bool getChannelLayout(SDL_Surface& surface, ImageProcessing::ChannelLayout& layout)
+{
+    const SDL_PixelFormat& format = *surface.format;
+    uint32_t colorKey;
+    if (nullptr != format.palette || 4 != format.BytesPerPixel || SDL_MUSTLOCK(&surface) ||
+        0 == SDL_GetColorKey(&surface, &colorKey))
+    {
+        return false;
+    }
+    return getChannelLayout(format.Rmask, format.Gmask, format.Bmask, format.Amask,
+                            format.Rshift, format.Gshift, format.Bshift, format.Ashift, layout);
+}
+
 PixelFormatDescriptor getPixelFormat(const SDL_PixelFormat& source)
 {
     if (source.palette)
@@ -148,6 +184,23 @@ std::shared_ptr<SDL_Surface> padSurface(const std::shared_ptr<const SDL_Surface>
     {
         throw id::runtime_error(__FILE__, __LINE__, "SDL_CreateRGBSurface failed");
     }
+    if (nullptr == oldSurface->format->palette && !SDL_MUSTLOCK(oldSurface.get()) && !SDL_MUSTLOCK(newSurface.get()))
+    {
+        // Copy the old surface into the new surface and fill the remainder with transparent black.
+        const size_t bytesPerPixel = oldSurface->format->BytesPerPixel;
+        uint8_t *target = static_cast<uint8_t *>(newSurface->pixels) + padding.top * newSurface->pitch + padding.left * bytesPerPixel;
+        ImageProcessing::pad(oldSurface->pixels, oldSurface->pitch, oldWidth, oldHeight,
+                             target, newSurface->pitch, oldWidth + padding.right, oldHeight + padding.bottom, bytesPerPixel);
+        if (padding.left || padding.top)
+        {
+            // Fill the top and left padding.
+            SDL_Rect top = {0, 0, static_cast<int>(newWidth), static_cast<int>(padding.top)},
+                     left = {0, static_cast<int>(padding.top), static_cast<int>(padding.left), static_cast<int>(newHeight - padding.top)};
+            SDL_FillRect(newSurface.get(), &top, SDL_MapRGBA(newSurface->format, 0, 0, 0, 0));
+            SDL_FillRect(newSurface.get(), &left, SDL_MapRGBA(newSurface->format, 0, 0, 0, 0));
+        }
+        return newSurface;
+    }
     // Fill the copy with transparent black.
     SDL_FillRect(newSurface.get(), nullptr, SDL_MapRGBA(newSurface->format, 0, 0, 0, 0));
     // Copy the old surface into the new surface.
@@ -278,6 +331,29 @@ std::shared_ptr<SDL_Surface> convertPixelFormat(const std::shared_ptr<SDL_Surfac
     {
         throw id::invalid_argument_error(__FILE__, __LINE__, "pixelFormatDescriptor doesn't correspond with a SDL_PixelFormat");
     }
+
+    // Convert 32 Bit pixels of 8 Bit channels to 24 or 32 Bit pixels of 8 Bit channels without SDL.
+    ImageProcessing::ChannelLayout sourceLayout, targetLayout;
+    if ((24 == bpp || 32 == bpp) && getChannelLayout(*surface, sourceLayout) &&
+        getChannelLayout(redMask, greenMask, blueMask, alphaMask,
+                         pixelFormatDescriptor.getRedShift(), pixelFormatDescriptor.getGreenShift(),
+                         pixelFormatDescriptor.getBlueShift(), pixelFormatDescriptor.getAlphaShift(), targetLayout))
+    {
+        auto newSurface = createSurface(surface->w, surface->h, pixelFormatDescriptor);
+        ImageProcessing::convert(surface->pixels, surface->pitch, sourceLayout,
+                                 newSurface->pixels, newSurface->pitch, targetLayout, bpp / 8,
+                                 surface->w, surface->h);
+        // Carry over the surface properties like SDL_ConvertSurfaceFormat.
+        uint8_t r, g, b, a;
+        SDL_BlendMode blendMode;
+        SDL_GetSurfaceColorMod(surface.get(), &r, &g, &b);
+        SDL_SetSurfaceColorMod(newSurface.get(), r, g, b);
+        SDL_GetSurfaceAlphaMod(surface.get(), &a);
+        SDL_SetSurfaceAlphaMod(newSurface.get(), a);
+        SDL_GetSurfaceBlendMode(surface.get(), &blendMode);
+        SDL_SetSurfaceBlendMode(newSurface.get(), blendMode);
+        return newSurface;
+    }
     SDL_Surface *newSurface = SDL_ConvertSurfaceFormat(surface.get(), newFormat, 0);
     if (!newSurface)
     {
@@ -386,6 +462,10 @@ bool testAlpha(const std::shared_ptr<SDL_Surface>& surface)
     // (The image is not palettized and has an alpha channel.)
     // If the image has an alpha channel and has non-opaque pixels,
     // then it is partially transparent.
+    if (4 == format->BytesPerPixel && !SDL_MUSTLOCK(surface.get()))
+    {
+        return ImageProcessing::hasNonOpaquePixel(surface->pixels, surface->w, surface->h, surface->pitch, format->Amask);
+    }
     uint32_t bitMask = format->Rmask | format->Gmask | format->Bmask | format->Amask;
     int bytesPerPixel = format->BytesPerPixel;
     int width = surface->w;
@@ -0,0 +1,255 @@
+//********************************************************************************************
+//*
+//*    This file is part of Egoboo.
+//*
+//*    Egoboo is free software: you can redistribute it and/or modify it
+//*    under the terms of the GNU General Public License as published by
+//*    the Free Software Foundation, either version 3 of the License, or
+//*    (at your option) any later version.
+//*
+//*    Egoboo is distributed in the hope that it will be useful, but
+//*    WITHOUT ANY WARRANTY; without even the implied warranty of
+//*    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+//*    General Public License for more details.
+//*
+//*    You should have received a copy of the GNU General Public License
+//*    along with Egoboo.  If not, see <http://www.gnu.org/licenses/>.
+//*
+//********************************************************************************************
+
+
+/// @file  egolib/Log/AsyncTarget.cpp
+/// @brief Log target writing on a background thread
+
+#include "egolib/Log/AsyncTarget.hpp"
+
+#include <cstring>
+#if defined(_WIN32)
+    #include <io.h>
+    #include <fcntl.h>
+    #define STDOUT_FILENO 1
+#else
+    #include <unistd.h>
+    #include <fcntl.h>
+#endif
+
+namespace Log {
+
+/// Repetitions of a log message within this interval are counted instead of written.
+static const std::chrono::seconds RepeatInterval(1);
+/// The interval in which the background thread looks for queued log messages.
+static const std::chrono::milliseconds WakeInterval(10);
+/// The number of attempts of a signal handler to acquire the queue.
+static const int SignalSpinCount = 1 << 20;
+
+static int openForSignal(const std::string& filename) {
+	try {
+		const auto resolved = vfs_resolveWriteFilename(filename);
+		if (!resolved.first) {
+			return -1;
+		}
+#if defined(_WIN32)
+		return _open(resolved.second.c_str(), _O_WRONLY | _O_APPEND | _O_BINARY);
+#else
+		return open(resolved.second.c_str(), O_WRONLY | O_APPEND);
+#endif
+	} catch (...) {
+		return -1;
+	}
+}
+
+static void writeOnSignal(int file, const char *bytes, size_t size) {
+	if (file < 0) {
+		return;
+	}
+#if defined(_WIN32)
+	_write(file, bytes, static_cast<unsigned int>(size));
+#else
+	while (0 < size) {
+		const ssize_t written = write(file, bytes, size);
+		if (written <= 0) {
+			return;
+		}
+		bytes += written;
+		size -= static_cast<size_t>(written);
+	}
+#endif
+}
+
+AsyncTarget::AsyncTarget(const std::string& filename, Level level, size_t capacity, OverflowPolicy overflowPolicy)
+	: DefaultTarget(filename, level),
+	  _records(capacity),
+	  _overflowPolicy(overflowPolicy),
+	  _dropped(0),
+	  _unreported(0),
+	  _pushed(0),
+	  _popped(0),
+	  _drainLock(),
+	  _signalFile(-1),
+	  _wakeMutex(),
+	  _wake(),
+	  _terminateRequested(false),
+	  _last{Level::Message, std::string()},
+	  _repeated(0),
+	  _lastTime(),
+	  _thread() {
+	_signalFile = openForSignal(filename);
+	_thread = std::thread([this]() { run(); });
+}
+
+AsyncTarget::~AsyncTarget() {
+	_terminateRequested = true;
+	_wake.notify_one();
+	if (_thread.joinable()) {
+		_thread.join();
+	}
+	flush();
+	if (0 <= _signalFile) {
+#if defined(_WIN32)
+		_close(_signalFile);
+#else
+		close(_signalFile);
+#endif
+	}
+}
+
+void AsyncTarget::writev(Level level, const char *format, va_list args) {
+	Record record{level, DefaultTarget::format(format, args)};
+	while (!_records.push(std::move(record))) {
+		switch (_overflowPolicy) {
+		case OverflowPolicy::Block:
+			// The background thread logging (e.g. a file system error) would wait for itself.
+			if (std::this_thread::get_id() == _thread.get_id()) {
+				_unreported++;
+				_dropped++;
+				return;
+			}
+			_wake.notify_one();
+			std::this_thread::yield();
+			continue;
+		case OverflowPolicy::Count:
+			_unreported++;
+			_dropped++;
+			return;
+		default:
+		case OverflowPolicy::Drop:
+			_dropped++;
+			return;
+		}
+	}
+	// Wake the background thread early if the queue is filling up.
+	if (++_pushed - _popped >= _records.getCapacity() / 2) {
+		_wake.notify_one();
+	}
+}
+
+void AsyncTarget::flush() {
+	// If the background thread crashed while writing, the queued log messages are lost.
+	if (std::this_thread::get_id() == _thread.get_id()) {
+		DefaultTarget::flush();
+		return;
+	}
+	// Wait until the log messages queued so far are written.
+	const size_t pushed = _pushed;
+	while (_popped < pushed) {
+		if (0 == drain()) {
+			std::this_thread::yield();
+		}
+	}
+	std::lock_guard<DrainLock> lock(_drainLock);
+	writeRepeated();
+	DefaultTarget::flush();
+}
+
+void AsyncTarget::flushOnSignal() {
+	// The signal might have interrupted the thread popping log messages, so do not wait forever.
+	// Operations on a lock-free atomic flag are async-signal-safe, unlike those on a mutex.
+	bool locked = false;
+	for (int i = 0; i < SignalSpinCount && !locked; ++i) {
+		locked = _drainLock.try_lock();
+	}
+	if (!locked) {
+		return;
+	}
+	// Log messages written so far were flushed by drain(), append the queued log messages.
+	// They are not popped, as popping destroys them and might free memory.
+	_records.visit([this](const Record& record) {
+		const char *prefix = getPrefix(record.level);
+		writeOnSignal(_signalFile, prefix, strlen(prefix));
+		writeOnSignal(_signalFile, record.message.data(), record.message.size());
+		writeOnSignal(STDOUT_FILENO, prefix, strlen(prefix));
+		writeOnSignal(STDOUT_FILENO, record.message.data(), record.message.size());
+	});
+	_drainLock.unlock();
+}
+
+size_t AsyncTarget::getDroppedCount() const {
+	return _dropped;
+}
+
+void AsyncTarget::run() {
+	while (!_terminateRequested) {
+		if (0 == drain()) {
+			std::unique_lock<std::mutex> lock(_wakeMutex);
+			_wake.wait_for(lock, WakeInterval);
+		}
+	}
+}
+
+size_t AsyncTarget::drain() {
+	std::lock_guard<DrainLock> lock(_drainLock);
+	size_t count = 0;
+	Record record;
+	while (_records.pop(record)) {
+		writeRecord(record);
+		count++;
+	}
+	_popped += count;
+	const size_t unreported = _unreported.exchange(0);
+	if (0 < unreported) {
+		writeRepeated();
+		DefaultTarget::write(Level::Warning, std::to_string(unreported) + " log messages dropped\n");
+	}
+	if (0 < _repeated && std::chrono::steady_clock::now() - _lastTime >= RepeatInterval) {
+		writeRepeated();
+	}
+	if (0 < count || 0 < unreported) {
+		DefaultTarget::flush();
+	}
+	return count;
+}
+
+void AsyncTarget::DrainLock::lock() {
+	while (flag.test_and_set(std::memory_order_acquire)) {
+		std::this_thread::yield();
+	}
+}
+
+bool AsyncTarget::DrainLock::try_lock() {
+	return !flag.test_and_set(std::memory_order_acquire);
+}
+
+void AsyncTarget::DrainLock::unlock() {
+	flag.clear(std::memory_order_release);
+}
+
+void AsyncTarget::writeRecord(const Record& record) {
+	const auto now = std::chrono::steady_clock::now();
+	if (record.level == _last.level && record.message == _last.message && now - _lastTime < RepeatInterval) {
+		_repeated++;
+		return;
+	}
+	writeRepeated();
+	DefaultTarget::write(record.level, record.message);
+	_last = record;
+	_lastTime = now;
+}
+
+void AsyncTarget::writeRepeated() {
+	if (0 < _repeated) {
+		DefaultTarget::write(_last.level, "last message repeated " + std::to_string(_repeated) + " times\n");
+		_repeated = 0;
+	}
+}
+
+} // namespace Log
@@ -0,0 +1,141 @@
+//********************************************************************************************
+//*
+//*    This file is part of Egoboo.
+//*
+//*    Egoboo is free software: you can redistribute it and/or modify it
+//*    under the terms of the GNU General Public License as published by
+//*    the Free Software Foundation, either version 3 of the License, or
+//*    (at your option) any later version.
+//*
+//*    Egoboo is distributed in the hope that it will be useful, but
+//*    WITHOUT ANY WARRANTY; without even the implied warranty of
+//*    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+//*    General Public License for more details.
+//*
+//*    You should have received a copy of the GNU General Public License
+//*    along with Egoboo.  If not, see <http://www.gnu.org/licenses/>.
+//*
+//********************************************************************************************
+
+
+/// @file  egolib/Log/AsyncTarget.hpp
+/// @brief Log target writing on a background thread
+
+#pragma once
+
+#include "egolib/Log/DefaultTarget.hpp"
+#include "egolib/Core/RingBuffer.hpp"
+
+namespace Log {
+
+/**
+ * @brief
+ *  What a log target does with a log message if its queue is full.
+ */
+enum class OverflowPolicy {
+	/// The log message is discarded.
+	Drop,
+	/// The writing thread waits until the log message can be queued.
+	Block,
+	/// The log message is discarded and the number of discarded log messages is written to the log.
+	Count,
+};
+
+/**
+ * @brief
+ *  A log target which formats log messages on the writing thread and writes them to the log file and the console on a background thread.
+ * @remark
+ *  Log messages are queued in a lock-free ring buffer. The background thread writes them in batches
+ *  and flushes the log file after each batch. A log message repeated within one second is counted
+ *  instead of written and the count is written once a different message arrives or the second elapsed.
+ *  Log messages queued before the destruction of this target or an invocation of flush() are written
+ *  before the destructor or flush() returns.
+ */
+struct AsyncTarget : DefaultTarget {
+public:
+	/**
+	 * @brief
+	 *  Construct this log target.
+	 * @param filename
+	 *  the filename of the log file
+	 * @param level
+	 *  the log level
+	 * @param capacity
+	 *  the maximum number of queued log messages
+	 * @param overflowPolicy
+	 *  what to do with a log message if the queue is full
+	 */
+	AsyncTarget(const std::string& filename, Level level = Level::Warning, size_t capacity = 4096,
+	            OverflowPolicy overflowPolicy = OverflowPolicy::Count);
+	virtual ~AsyncTarget();
+	void writev(Level level, const char *format, va_list args) override;
+	void flush() override;
+
+	/**
+	 * @brief
+	 *  Write the queued log messages to the log file and the console from a signal handler.
+	 * @remark
+	 *  Unlike flush(), this function is async-signal-safe: it neither allocates, blocks nor takes a
+	 *  lock. The queued log messages are read without popping them and written with the system call
+	 *  @a write. If another thread is popping log messages and does not finish within a bounded
+	 *  number of attempts, nothing is written.
+	 */
+	void flushOnSignal();
+
+	/**
+	 * @brief
+	 *  Get the number of log messages discarded because the queue was full.
+	 */
+	size_t getDroppedCount() const;
+
+private:
+	struct Record {
+		Level level;
+		std::string message;
+	};
+
+	/// @brief The procedure of the background thread.
+	void run();
+
+	/// @brief Write the queued log messages. Returns the number of log messages written.
+	size_t drain();
+
+	/// @brief Write a log message unless it repeats the last log message.
+	void writeRecord(const Record& record);
+
+	/// @brief Write the number of times the last log message was repeated, if any.
+	void writeRepeated();
+
+	Ego::Core::RingBuffer<Record> _records;
+	OverflowPolicy _overflowPolicy;
+	std::atomic<size_t> _dropped;
+	/// @brief The number of log messages discarded and not yet reported.
+	std::atomic<size_t> _unreported;
+	/// @brief The numbers of log messages queued and popped.
+	std::atomic<size_t> _pushed, _popped;
+
+	/// @brief A lock built on an atomic flag rather than a mutex, as a signal handler may try to acquire it.
+	struct DrainLock {
+		std::atomic_flag flag = ATOMIC_FLAG_INIT;
+		void lock();
+		bool try_lock();
+		void unlock();
+	};
+
+	/// @brief Only one thread at a time may pop log messages.
+	DrainLock _drainLock;
+	/// @brief The log file opened for appending by flushOnSignal(), -1 if it could not be opened.
+	int _signalFile;
+	std::mutex _wakeMutex;
+	std::condition_variable _wake;
+	std::atomic<bool> _terminateRequested;
+
+	/// @brief The last log message written, the number of times it was repeated since and when it was written.
+	Record _last;
+	size_t _repeated;
+	std::chrono::steady_clock::time_point _lastTime;
+
+	std::thread _thread;
+};
+
+} // namespace Log
@@ -27,8 +27,6 @@
 
 namespace Log {
 
-static constexpr size_t MAX_LOG_MESSAGE = 1024; ///< Max length of log messages.
-
 DefaultTarget::DefaultTarget(const std::string& filename, Level level)
 	: Target(level) {
 	_file = vfs_openWrite(filename);
@@ -44,55 +42,90 @@ DefaultTarget::~DefaultTarget() {
 	}
 }
 
+std::string DefaultTarget::format(const char *format, va_list args) {
+	char buffer[1024];
+	va_list temporary;
+	va_copy(temporary, args);
+	int length = vsnprintf(buffer, sizeof(buffer), format, temporary);
+	va_end(temporary);
+	if (length < 0) {
+		return std::string();
+	}
+	if (static_cast<size_t>(length) < sizeof(buffer)) {
+		return std::string(buffer, length);
+	}
+	// The message does not fit into the buffer: Format it again into a string of the required length.
+	std::vector<char> message(length + 1);
+	vsnprintf(message.data(), message.size(), format, args);
+	return std::string(message.data(), length);
+}
+
 void DefaultTarget::writev(Level level, const char *format, va_list args) {
-	char logBuffer[MAX_LOG_MESSAGE] = EMPTY_CSTR;
+	write(level, DefaultTarget::format(format, args));
+}
 
-	// Add prefix
-	const char *prefix;
+const char *DefaultTarget::getPrefix(Level level) {
+	switch (level) {
+	case Level::Error:
+		return "FATAL ERROR: ";
+	case Level::Warning:
+		return "WARNING: ";
+	case Level::Info:
+		return "INFO: ";
+	case Level::Debug:
+		return "DEBUG: ";
+	default:
+	case Level::Message:
+		return ""; // no prefix
+	}
+}
+
+void DefaultTarget::write(Level level, const std::string& message) {
 	switch (level) {
 	case Log::Level::Error:
 		setConsoleColor(ConsoleColor::Red);
-		prefix = "FATAL ERROR: ";
 		break;
 
 	case Level::Warning:
 		setConsoleColor(ConsoleColor::Yellow);
-		prefix = "WARNING: ";
 		break;
 
 	case Level::Info:
 		setConsoleColor(ConsoleColor::White);
-		prefix = "INFO: ";
 		break;
 
 	case Level::Debug:
 		setConsoleColor(ConsoleColor::Gray);
-		prefix = "DEBUG: ";
 		break;
 
 	default:
 	case Level::Message:
 		setConsoleColor(ConsoleColor::White);
-		prefix = ""; // no prefix
 		break;
 	}
-
-	// Build log message
-	vsnprintf(logBuffer, MAX_LOG_MESSAGE - 1, format, args);
+	// Add prefix
+	const char *prefix = getPrefix(level);
 
 	if (nullptr != _file)
 	{
 		// Log to file
 		vfs_puts(prefix, _file);
-		vfs_puts(logBuffer, _file);
+		vfs_puts(message.c_str(), _file);
 	}
 
 	// Log to console
 	fputs(prefix, stdout);
-	fputs(logBuffer, stdout);
+	fputs(message.c_str(), stdout);
 
 	// Restore default color
 	setConsoleColor(ConsoleColor::Default);
 }
 
+void DefaultTarget::flush() {
+	if (nullptr != _file) {
+		vfs_flush(_file);
+	}
+	fflush(stdout);
+}
+
 } // namespace Log
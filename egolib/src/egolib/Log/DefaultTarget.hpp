@@ -38,6 +38,38 @@ public:
 	DefaultTarget(const std::string& filename, Level level = Level::Warning);
 	virtual ~DefaultTarget();
 	void writev(Level level, const char *format, va_list args) override;
+	void flush() override;
+
+protected:
+	/**
+	 * @brief
+	 *  Format a printf-style log message. The message is not truncated.
+	 * @param format, args
+	 *  printf-style format string and variadic argument list
+	 * @return
+	 *  the log message
+	 */
+	static std::string format(const char *format, va_list args);
+
+	/**
+	 * @brief
+	 *  Get the prefix of log messages of a log level.
+	 * @param level
+	 *  the log level
+	 * @return
+	 *  the prefix
+	 */
+	static const char *getPrefix(Level level);
+
+	/**
+	 * @brief
+	 *  Write a formatted log message to the log file and the console.
+	 * @param level
+	 *  the log level
+	 * @param message
+	 *  the log message
+	 */
+	void write(Level level, const std::string& message);
 };
 
 } // namespace Log
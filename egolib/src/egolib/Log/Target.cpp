@@ -47,4 +47,6 @@ void Target::log(Level level, const char *format, ...) {
     va_end(args);
 }
 
+void Target::flush() {}
+
 } // namespace Log
@@ -78,6 +78,13 @@ public:
      *  printf-style format string and variadic argument list
      */
     virtual void log(Level level, const char *format, ...) GCC_PRINTF_FUNC(3);
+    /**
+     * @brief
+     *  Write all log messages written so far to the underlying media.
+     * @remark
+     *  The default implementation does nothing.
+     */
+    virtual void flush();
 };
 
 } // namespace Log
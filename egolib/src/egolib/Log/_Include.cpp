@@ -22,9 +22,11 @@
 
 #include "egolib/Log/_Include.hpp"
 
-#include "egolib/Log/DefaultTarget.hpp"
+#include "egolib/Log/AsyncTarget.hpp"
 #include "egolib/Log/ConsoleColor.hpp"
 
+#include <csignal>
+
 namespace Log {
 
 /**
@@ -32,11 +34,36 @@ namespace Log {
  *  The single target of this log system.
  */
 static std::unique_ptr<Log::Target> g_target = nullptr;
+/// The target of this log system if it writes on a background thread.
+static std::atomic<AsyncTarget *> g_asyncTarget{nullptr};
 static bool _atexit_registered = false;
+static std::terminate_handler g_terminate = nullptr;
+
+/// Flush the log if the program terminates due to an uncaught exception.
+static void onTerminate() {
+	flush();
+	if (g_terminate) {
+		g_terminate();
+	}
+	std::abort();
+}
+
+/// Write the queued log messages if the program crashes and re-raise the signal.
+/// flush() is not async-signal-safe, AsyncTarget::flushOnSignal() is.
+static void onSignal(int signal) {
+	std::signal(signal, SIG_DFL);
+	AsyncTarget *target = g_asyncTarget.load();
+	if (target) {
+		target->flushOnSignal();
+	}
+	std::raise(signal);
+}
 
 void initialize(const std::string& filename, Log::Level level) {
 	if (!g_target) {
-		g_target = std::make_unique<DefaultTarget>(filename, level);
+		auto target = std::make_unique<AsyncTarget>(filename, level);
+		g_asyncTarget = target.get();
+		g_target = std::move(target);
 	}
 	if (!_atexit_registered) {
 		if (atexit(Log::uninitialize)) {
@@ -44,15 +71,26 @@ void initialize(const std::string& filename, Log::Level level) {
 			throw std::runtime_error("unable to initialize logging system");
 		}
 		_atexit_registered = true;
+		g_terminate = std::set_terminate(onTerminate);
+		for (int signal : { SIGSEGV, SIGABRT, SIGFPE, SIGILL }) {
+			std::signal(signal, onSignal);
+		}
 	}
 }
 
 void uninitialize() {
 	if (g_target) {
+		g_asyncTarget = nullptr;
 		g_target = nullptr;
 	}
 }
 
+void flush() {
+	if (g_target) {
+		g_target->flush();
+	}
+}
+
 Target& get() {
 	if (!g_target) {
 		throw std::logic_error("logging system is not initialized");
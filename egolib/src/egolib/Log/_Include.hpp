@@ -51,6 +51,15 @@ namespace Log {
 	 */
 	void uninitialize();
 
+	/**
+	 * @brief
+	 *  Write all log messages written so far to the log file.
+	 * @remark
+	 *  Returns if the logging system is not initialized.
+	 *  Invoked if the program terminates due to an uncaught exception or crashes.
+	 */
+	void flush();
+
 	/**
 	 * @brief
 	 *  Get the default target.
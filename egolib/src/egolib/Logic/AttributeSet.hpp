@@ -0,0 +1,146 @@
+//********************************************************************************************
+//*
+//*    This file is part of Egoboo.
+//*
+//*    Egoboo is free software: you can redistribute it and/or modify it
+//*    under the terms of the GNU General Public License as published by
+//*    the Free Software Foundation, either version 3 of the License, or
+//*    (at your option) any later version.
+//*
+//*    Egoboo is distributed in the hope that it will be useful, but
+//*    WITHOUT ANY WARRANTY; without even the implied warranty of
+//*    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+//*    General Public License for more details.
+//*
+//*    You should have received a copy of the GNU General Public License
+//*    along with Egoboo.  If not, see <http://www.gnu.org/licenses/>.
+//*
+//********************************************************************************************
+
+/// @file egolib/Logic/AttributeSet.hpp
+/// @brief The base values and enchantment modifiers of the attributes of an Object
+
+#pragma once
+
+#include "egolib/Logic/Attribute.hpp"
+
+namespace Ego
+{
+
+/**
+ * @brief
+ *  The attributes of an Object: A base value and an optional modifier for each attribute.
+ *  The effective values are cached and recomputed only if a base value or a modifier has changed.
+ * @remark
+ *  If the attribute is a SET type attribute (see Ego::Attribute::isOverrideSetAttribute), a modifier
+ *  overrides the base value. Otherwise, the modifier is added to the base value.
+ */
+class AttributeSet
+{
+public:
+    using AttributeType = Ego::Attribute::AttributeType;
+    static constexpr size_t Count = Ego::Attribute::NR_OF_ATTRIBUTES;
+
+    AttributeSet() :
+        _base(),
+        _modifier(),
+        _hasModifier(),
+        _effective(),
+        _overridden(),
+        _dirty(false)
+    {
+        _base.fill(0.0f);
+        _modifier.fill(0.0f);
+        _effective.fill(0.0f);
+    }
+
+    /// @brief Get the base value of an attribute.
+    float getBase(const AttributeType type) const
+    {
+        return _base[type];
+    }
+
+    /// @brief Set the base value of an attribute.
+    void setBase(const AttributeType type, const float value)
+    {
+        _base[type] = value;
+        _dirty = true;
+    }
+
+    /// @brief Get if an attribute has a modifier.
+    bool hasModifier(const AttributeType type) const
+    {
+        return _hasModifier[type];
+    }
+
+    /// @brief Get the modifier of an attribute, @a 0 if the attribute has no modifier.
+    float getModifier(const AttributeType type) const
+    {
+        return _modifier[type];
+    }
+
+    /// @brief Set the modifier of an attribute.
+    void setModifier(const AttributeType type, const float value)
+    {
+        _modifier[type] = value;
+        _hasModifier[type] = true;
+        _dirty = true;
+    }
+
+    /// @brief Add to the modifier of an attribute. An attribute without a modifier starts at @a 0.
+    void addModifier(const AttributeType type, const float value)
+    {
+        setModifier(type, _modifier[type] + value);
+    }
+
+    /// @brief Remove the modifier of an attribute.
+    void removeModifier(const AttributeType type)
+    {
+        _modifier[type] = 0.0f;
+        _hasModifier[type] = false;
+        _dirty = true;
+    }
+
+    /// @brief Remove the modifiers of all attributes.
+    void clearModifiers()
+    {
+        _modifier.fill(0.0f);
+        _hasModifier.reset();
+        _dirty = true;
+    }
+
+    /// @brief Get the effective value of an attribute i.e. its base value combined with its modifier.
+    float getEffective(const AttributeType type) const
+    {
+        if (_dirty) update();
+        return _effective[type];
+    }
+
+    /// @brief Get if the effective value of an attribute is a SET modifier overriding its base value.
+    bool isOverridden(const AttributeType type) const
+    {
+        if (_dirty) update();
+        return _overridden[type];
+    }
+
+private:
+    void update() const
+    {
+        for (size_t i = 0; i < Count; ++i)
+        {
+            const AttributeType type = static_cast<AttributeType>(i);
+            _overridden[i] = _hasModifier[i] && Ego::Attribute::isOverrideSetAttribute(type);
+            _effective[i] = _overridden[i] ? _modifier[i] : _base[i] + _modifier[i];
+        }
+        _dirty = false;
+    }
+
+    std::array<float, Count> _base;             ///< the base values
+    std::array<float, Count> _modifier;         ///< the modifiers, @a 0 if an attribute has no modifier
+    std::bitset<Count> _hasModifier;            ///< which attributes have a modifier
+    mutable std::array<float, Count> _effective;///< the cached effective values
+    mutable std::bitset<Count> _overridden;     ///< the cached SET overrides
+    mutable bool _dirty;                        ///< if the cached values are out of date
+};
+
+} // namespace Ego
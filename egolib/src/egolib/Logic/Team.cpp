@@ -83,10 +83,15 @@ void Team::callForHelp(const std::shared_ptr<Object> &caller)
     _sissy = caller;
 
     //Notify all other characters who are friendly that this character has called for help
-    for(const std::shared_ptr<Object> &chr : _currentModule->getObjectHandler().iterator())
+    ObjectHandler& objectHandler = _currentModule->getObjectHandler();
+    for(const Team& team : _currentModule->getTeamList())
     {
-        if ( chr != caller && !chr->getTeam().hatesTeam(caller->getTeam()) )
+        if ( team.hatesTeam(caller->getTeam()) ) continue;
+
+        for(ObjectRef member : objectHandler.getTeamMembers(team.toRef()))
         {
+            Object *chr = objectHandler.get(member);
+            if ( nullptr == chr || chr->isTerminated() || chr == caller.get() ) continue;
             SET_BIT( chr->ai.alert, ALERTIF_CALLEDFORHELP );
         }
     }
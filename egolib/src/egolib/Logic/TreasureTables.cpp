@@ -70,7 +70,7 @@ std::string TreasureTables::getRandomTreasure(const std::string& treasureTableNa
         }
 
     	//Pick a random element from the treasure table
-        currentEntry = Random::getRandomElement(result->second);
+        currentEntry = Random::get(Random::Stream::Treasure).getRandomElement(result->second);
 
         // If this is not a reference to yet another treasure table ...
         if ('%' != currentEntry[0]) {
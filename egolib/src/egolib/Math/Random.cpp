@@ -23,29 +23,63 @@
 
 #include "egolib/Math/Random.hpp"
 
-// Static data initializer
-std::random_device rd;
-std::mt19937 Random::generator = std::mt19937(time(nullptr));
+namespace {
 
-void Random::setSeed(const long seed)
+/// The SplitMix64 generator, used to expand and derive seeds.
+uint64_t splitMix64(uint64_t& state)
 {
-    generator.seed(seed);
+    uint64_t z = (state += 0x9E3779B97F4A7C15ULL);
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+    return z ^ (z >> 31);
 }
 
-float Random::nextFloat()
+} // namespace
+
+RandomGenerator::RandomGenerator(const uint64_t seed) :
+    _state()
 {
-    static std::uniform_real_distribution<float> rand(0.0f, std::nextafter(1.0f, std::numeric_limits<float>::max()));
-    return rand(generator);
+    this->seed(seed);
 }
 
-int Random::getPercent()
+void RandomGenerator::seed(const uint64_t seed)
 {
-	static std::uniform_int_distribution<int> rand(1, 100);
-    return rand(generator);
+    uint64_t state = seed;
+    for (uint64_t& x : _state)
+    {
+        x = splitMix64(state);
+    }
 }
 
-bool Random::nextBool()
+// Static data initializer
+uint64_t Random::seed = static_cast<uint64_t>(time(nullptr));
+std::array<RandomStream, static_cast<size_t>(Random::Stream::Count)> Random::streams = []()
+{
+    std::array<RandomStream, static_cast<size_t>(Random::Stream::Count)> streams;
+    for (size_t i = 0; i < streams.size(); ++i)
+    {
+        streams[i].setSeed(Random::deriveSeed(static_cast<Random::Stream>(i), 0));
+    }
+    return streams;
+}();
+
+RandomStream& Random::get(const Stream stream)
+{
+    return streams[static_cast<size_t>(stream)];
+}
+
+uint64_t Random::deriveSeed(const Stream stream, const uint64_t key)
+{
+    uint64_t state = seed ^ (static_cast<uint64_t>(stream) << 56);
+    state = splitMix64(state) ^ key;
+    return splitMix64(state);
+}
+
+void Random::setSeed(const long seed)
 {
-    std::bernoulli_distribution rand(0.5);
-    return rand(generator);
+    Random::seed = static_cast<uint64_t>(seed);
+    for (size_t i = 0; i < streams.size(); ++i)
+    {
+        streams[i].setSeed(deriveSeed(static_cast<Stream>(i), 0));
+    }
 }
@@ -27,32 +27,131 @@
 #include "egolib/Math/Interval.hpp"
 #include "egolib/typedef.h"
 
-class Random
+/**
+ * @brief
+ *  A xoshiro256** pseudo random number generator.
+ *  Small, fast and satisfies the requirements of a uniform random bit generator.
+ */
+class RandomGenerator
 {
 public:
-	/**
-	 * @brief
+    using result_type = uint64_t;
+
+    static constexpr result_type min() { return 0; }
+    static constexpr result_type max() { return std::numeric_limits<result_type>::max(); }
+
+    /**
+     * @brief
+     *  Construct this generator.
+     * @param seed
+     *  the seed
+     */
+    explicit RandomGenerator(const uint64_t seed = 0);
+
+    /**
+     * @brief
+     *  Construct this generator from its state.
+     * @param state
+     *  the state, must not be all zero
+     */
+    explicit RandomGenerator(const std::array<uint64_t, 4>& state) :
+        _state(state)
+    {}
+
+    /**
+     * @brief
+     *  Reset the state of this generator.
+     * @param seed
+     *  the seed. The state is expanded from the seed using SplitMix64.
+     */
+    void seed(const uint64_t seed);
+
+    /**
+     * @brief
+     *  Generate the next random 64 bit number.
+     */
+    result_type operator()()
+    {
+        const uint64_t result = rotl(_state[1] * 5, 7) * 9;
+        const uint64_t t = _state[1] << 17;
+        _state[2] ^= _state[0];
+        _state[3] ^= _state[1];
+        _state[1] ^= _state[2];
+        _state[0] ^= _state[3];
+        _state[2] ^= t;
+        _state[3] = rotl(_state[3], 45);
+        return result;
+    }
+
+private:
+    static uint64_t rotl(const uint64_t x, const int k)
+    {
+        return (x << k) | (x >> (64 - k));
+    }
+
+    std::array<uint64_t, 4> _state;
+};
+
+/**
+ * @brief
+ *  A stream of random numbers.
+ * @remark
+ *  A stream must only be used by a single thread at a time.
+ *  Subsystems running in parallel use separate streams such that they neither contend for
+ *  a stream nor change the numbers drawn by each other.
+ * @remark
+ *  The distributions are implemented here rather than by the standard library such that
+ *  the numbers drawn from a seed are the same on all platforms.
+ */
+class RandomStream
+{
+public:
+    /**
+     * @brief
+     *  Construct this stream.
+     * @param seed
+     *  the seed
+     */
+    explicit RandomStream(const uint64_t seed = 0) :
+        _generator(seed)
+    {}
+
+    /**
+     * @brief
+     *  Reset this stream.
+     * @param seed
+     *  the seed
+     */
+    void setSeed(const uint64_t seed)
+    {
+        _generator.seed(seed);
+    }
+
+    /**
+     * @brief
      *  Generate a random floating point number in the interval <tt>[0,1]</tt>.
      * @return
      *  a random floating point number in the interval <tt>[0,1]</tt>
-	 */
-    static float nextFloat();
+     */
+    float nextFloat()
+    {
+        // 24 random bits, the precision of a float.
+        return static_cast<float>(_generator() >> 40) * (1.0f / static_cast<float>(0xFFFFFF));
+    }
 
     /**
      * @brief Generates a random float within the bounds of a floating-point interval
      * @param interval the interval
      * @return a random floating-point value within the bounds of <c>interval.getLowerbound()</c> (inclusive) and <c>interval.getUpperbound()</c> (inclusive)
      */
-    static float next(const Ego::Math::Interval<float>& interval)
+    float next(const Ego::Math::Interval<float>& interval)
     {
-        float min = interval.getLowerbound();
-        float max = std::nextafter(interval.getUpperbound(), std::numeric_limits<float>::max());
-        std::uniform_real_distribution<float> distribution(min, max);
-        return distribution(generator);
+        const float min = interval.getLowerbound(), max = interval.getUpperbound();
+        return std::min(max, min + (max - min) * nextFloat());
     }
-    
+
     /**
-	 * @brief
+     * @brief
      *  Generate an integer number in the interval <tt>[0,high]</tt>.
      * @param high
      *  the upper bound (inclusive) for the random integer number generated
@@ -60,15 +159,15 @@ public:
      *  a random integer number in the interval <tt>[0,high]</tt>
      * @pre
      *  <tt>high >= 0</tt>
-	 */
+     */
     template<typename T>
-    static T next(const T high)
+    T next(const T high)
     {
         return next<T>(0, high);
     }
 
     /**
-	 * @brief
+     * @brief
      *  Generates an integer number in the interval <tt>[low,high]</tt>.
      * @param low
      *  the lower bound (inclusive) for the integer number returned by this function
@@ -78,9 +177,9 @@ public:
      *  a random integer number in the interval <tt>[low,high]</tt>
      * @pre
      *  <tt>low <= high</tt>
-	 */
+     */
     template<typename T>
-    static T next(const T low, const T high)
+    T next(const T low, const T high)
     {
         static_assert(std::is_same<T, short>::value || std::is_same<T, int>::value ||
                       std::is_same<T, long>::value || std::is_same<T, long long>::value ||
@@ -96,8 +195,173 @@ public:
         {
             return low;
         }
-        std::uniform_int_distribution<T> rand(low, high);
-        return rand(generator);
+        // The number of values in the interval, 0 if it covers all 64 bit numbers.
+        const uint64_t count = static_cast<uint64_t>(high) - static_cast<uint64_t>(low) + 1;
+        uint64_t x = _generator();
+        if (0 != count)
+        {
+            // Reject the values which would make the result biased.
+            const uint64_t limit = RandomGenerator::max() - RandomGenerator::max() % count;
+            while (x >= limit)
+            {
+                x = _generator();
+            }
+            x %= count;
+        }
+        return static_cast<T>(static_cast<uint64_t>(low) + x);
+    }
+
+    /**
+     * @brief
+     *  Randomly returns @a true or @a false.
+     * @return
+     *  @a true or @a false
+     */
+    bool nextBool()
+    {
+        return 0 != (_generator() >> 63);
+    }
+
+    /**
+     * @brief
+     *  Generates a random integer number in the interval <tt>[1,100]</tt>.
+     * @return
+     *  a random integer number in the interval <tt>[1,100]</tt>
+     */
+    int getPercent()
+    {
+        return next<int>(1, 100);
+    }
+
+    /**
+     * @brief
+     *  Returns a reference to a random element in a vector.
+     * @param container
+     *  the container
+     * @return
+     *  a reference to a random element in the container
+     */
+    template<typename T>
+    const T& getRandomElement(const std::vector<T>& container)
+    {
+        assert(!container.empty());
+        return container[next<size_t>(container.size()-1)];
+    }
+
+    /**
+     * @brief
+     *  Returns a reference to a random element in this vector
+     */
+    template<typename T>
+    T& getRandomElement(std::vector<T> &container)
+    {
+        assert(!container.empty());
+        return container[next<size_t>(container.size()-1)];
+    }
+
+private:
+    RandomGenerator _generator;
+};
+
+/**
+ * @brief
+ *  The random number streams of the subsystems.
+ * @remark
+ *  All streams are derived from a single seed, the module seed. The static functions draw from
+ *  the default stream. Subsystems which might run on worker threads draw from their own stream,
+ *  obtained by Random::get(), or from a stream of their own seeded by Random::deriveSeed().
+ */
+class Random
+{
+public:
+    /// The subsystems owning a random number stream.
+    enum class Stream
+    {
+        Default,    ///< Game logic not covered by any other stream
+        Particles,  ///< Particle spawning and particle physics
+        Scripts,    ///< A.I. scripts
+        Treasure,   ///< Treasure tables
+        Weather,    ///< Water and weather
+        Graphics,   ///< Purely visual effects
+
+        Count
+    };
+
+    /**
+     * @brief
+     *  Get the random number stream of a subsystem.
+     * @param stream
+     *  the subsystem
+     * @return
+     *  the stream
+     */
+    static RandomStream& get(const Stream stream);
+
+    /**
+     * @brief
+     *  Derive a seed for a stream of its own e.g. for an object or a particle spawn.
+     * @param stream
+     *  the subsystem the stream belongs to
+     * @param key
+     *  a key identifying the stream within the subsystem e.g. an object reference
+     * @return
+     *  the seed, depends only on the seed set by Random::setSeed, the subsystem and the key
+     */
+    static uint64_t deriveSeed(const Stream stream, const uint64_t key);
+
+	/**
+	 * @brief
+     *  Generate a random floating point number in the interval <tt>[0,1]</tt>.
+     * @return
+     *  a random floating point number in the interval <tt>[0,1]</tt>
+	 */
+    static float nextFloat()
+    {
+        return get(Stream::Default).nextFloat();
+    }
+
+    /**
+     * @brief Generates a random float within the bounds of a floating-point interval
+     * @param interval the interval
+     * @return a random floating-point value within the bounds of <c>interval.getLowerbound()</c> (inclusive) and <c>interval.getUpperbound()</c> (inclusive)
+     */
+    static float next(const Ego::Math::Interval<float>& interval)
+    {
+        return get(Stream::Default).next(interval);
+    }
+    
+    /**
+	 * @brief
+     *  Generate an integer number in the interval <tt>[0,high]</tt>.
+     * @param high
+     *  the upper bound (inclusive) for the random integer number generated
+     * @return
+     *  a random integer number in the interval <tt>[0,high]</tt>
+     * @pre
+     *  <tt>high >= 0</tt>
+	 */
+    template<typename T>
+    static T next(const T high)
+    {
+        return get(Stream::Default).next<T>(high);
+    }
+
+    /**
+	 * @brief
+     *  Generates an integer number in the interval <tt>[low,high]</tt>.
+     * @param low
+     *  the lower bound (inclusive) for the integer number returned by this function
+     * @param high
+     *  the upper bound (inclusive) for the integer number returned by this function
+     * @return
+     *  a random integer number in the interval <tt>[low,high]</tt>
+     * @pre
+     *  <tt>low <= high</tt>
+	 */
+    template<typename T>
+    static T next(const T low, const T high)
+    {
+        return get(Stream::Default).next<T>(low, high);
     }
 
 	/**
@@ -106,19 +370,26 @@ public:
      * @return
      *  @a true or @a false
 	 */
-    static bool nextBool();
+    static bool nextBool()
+    {
+        return get(Stream::Default).nextBool();
+    }
 
 	/**
 	 * @brief
-     *  Generates a random integer number in the interval <tt>[0,1]</tt>.
+     *  Generates a random integer number in the interval <tt>[1,100]</tt>.
      * @return
-     *  a random integer number in the interval <tt>[0,1]</tt>
+     *  a random integer number in the interval <tt>[1,100]</tt>
 	 */
-    static int getPercent();
+    static int getPercent()
+    {
+        return get(Stream::Default).getPercent();
+    }
 
     /**
      * @brief
      *  Sets the random seed used for randomization.
+     *  All streams are reset to seeds derived from this seed.
      * @param seed
      *  the seed
      */
@@ -135,8 +406,7 @@ public:
     template<typename T>
     static const T& getRandomElement(const std::vector<T>& container)
     {
-        assert(!container.empty());
-        return container[ Random::next<size_t>(container.size()-1) ];
+        return get(Stream::Default).getRandomElement(container);
     }
 
     /**
@@ -146,16 +416,13 @@ public:
     template<typename T>
     static T& getRandomElement(std::vector<T> &container)
     {
-        assert(!container.empty());
-        return container[ Random::next<size_t>(container.size()-1) ];
+        return get(Stream::Default).getRandomElement(container);
     }
 
 private:
+    /// The seed set by Random::setSeed.
+    static uint64_t seed;
 
-    /**
-     * @brief
-     *  Mersenne Twister randomizer.
-     */
-    static std::mt19937 generator;
-
+    /// The streams of the subsystems.
+    static std::array<RandomStream, static_cast<size_t>(Stream::Count)> streams;
 };
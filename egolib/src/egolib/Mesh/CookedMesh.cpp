@@ -0,0 +1,433 @@
+//********************************************************************************************
+//*
+//*    This file is part of Egoboo.
+//*
+//*    Egoboo is free software: you can redistribute it and/or modify it
+//*    under the terms of the GNU General Public License as published by
+//*    the Free Software Foundation, either version 3 of the License, or
+//*    (at your option) any later version.
+//*
+//*    Egoboo is distributed in the hope that it will be useful, but
+//*    WITHOUT ANY WARRANTY; without even the implied warranty of
+//*    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+//*    General Public License for more details.
+//*
+//*    You should have received a copy of the GNU General Public License
+//*    along with Egoboo.  If not, see <http://www.gnu.org/licenses/>.
+//*
+//********************************************************************************************
+
+/// @file   egolib/Mesh/CookedMesh.cpp
+/// @brief  A binary mesh format which can be used in place without parsing.
+
+#include "egolib/Mesh/CookedMesh.hpp"
+
+#include "egolib/FileFormats/map_file.h"
+#include "egolib/FileFormats/map_tile_dictionary.h"
+#include "egolib/map_functions.h"
+#include "egolib/bbox.h"
+#include "egolib/vfs.h"
+#include "egolib/Log/_Include.hpp"
+
+namespace Ego {
+
+const char CookedMesh::Magic[8] = {'E', 'G', 'O', 'M', 'E', 'S', 'H', '\0'};
+
+static_assert(sizeof(CookedMeshHeader) % 4 == 0, "unexpected padding in CookedMeshHeader");
+static_assert(sizeof(CookedMeshTile) == 104, "unexpected padding in CookedMeshTile");
+
+static uint64_t align(uint64_t offset) {
+    return (offset + CookedMesh::Alignment - 1) & ~static_cast<uint64_t>(CookedMesh::Alignment - 1);
+}
+
+CookedMesh::CookedMesh() :
+    _data(nullptr),
+    _size(0),
+    _mapping{nullptr, 0, nullptr},
+    _buffer() {}
+
+CookedMesh::~CookedMesh() {
+    fs_unmapFile(&_mapping);
+}
+
+AxisAlignedBox3f CookedMesh::getBounds() const {
+    const CookedMeshHeader& header = getHeader();
+    return AxisAlignedBox3f(Point3f(header.boundsMin[0], header.boundsMin[1], header.boundsMin[2]),
+                            Point3f(header.boundsMax[0], header.boundsMax[1], header.boundsMax[2]));
+}
+
+std::shared_ptr<CookedMesh> CookedMesh::create(size_t vertexCount, size_t tileCountX, size_t tileCountY) {
+    const uint64_t tileCount = static_cast<uint64_t>(tileCountX) * tileCountY;
+    const uint64_t tilesOffset = align(sizeof(CookedMeshHeader));
+    const uint64_t positionsOffset = align(tilesOffset + tileCount * sizeof(CookedMeshTile));
+    const uint64_t texCoordsOffset = align(positionsOffset + vertexCount * sizeof(Float3));
+    const uint64_t normalsOffset = align(texCoordsOffset + vertexCount * sizeof(Float2));
+    const uint64_t fileSize = normalsOffset + tileCount * sizeof(Float3);
+    if (fileSize > std::numeric_limits<uint32_t>::max()) {
+        Log::get() << Log::Entry::create(Log::Level::Error, __FILE__, __LINE__, "mesh of ", tileCountX, "x", tileCountY,
+                                         " tiles and ", vertexCount, " vertices is too big", Log::EndOfEntry);
+        return nullptr;
+    }
+
+    std::shared_ptr<CookedMesh> mesh(new CookedMesh());
+    mesh->_buffer.resize((fileSize + sizeof(uint64_t) - 1) / sizeof(uint64_t), 0);
+    mesh->_data = reinterpret_cast<uint8_t *>(mesh->_buffer.data());
+    mesh->_size = static_cast<size_t>(fileSize);
+
+    CookedMeshHeader& header = mesh->getHeader();
+    std::copy(std::begin(Magic), std::end(Magic), header.magic);
+    header.byteOrder = ByteOrder;
+    header.version = Version;
+    header.headerSize = sizeof(CookedMeshHeader);
+    header.tileSize = sizeof(CookedMeshTile);
+    header.sourceStamp = 0;
+    header.tileCountX = static_cast<uint32_t>(tileCountX);
+    header.tileCountY = static_cast<uint32_t>(tileCountY);
+    header.vertexCount = static_cast<uint32_t>(vertexCount);
+    header.tilesOffset = static_cast<uint32_t>(tilesOffset);
+    header.positionsOffset = static_cast<uint32_t>(positionsOffset);
+    header.texCoordsOffset = static_cast<uint32_t>(texCoordsOffset);
+    header.normalsOffset = static_cast<uint32_t>(normalsOffset);
+    header.fileSize = static_cast<uint32_t>(fileSize);
+    for (size_t i = 0; i < tileCount; ++i) {
+        CookedMeshTile& tile = mesh->getTiles()[i];
+        tile.twist = TWIST_FLAT;
+        tile.octEmpty = 1;
+    }
+    return mesh;
+}
+
+bool CookedMesh::validate(const uint8_t *data, size_t size) {
+    if (size < sizeof(CookedMeshHeader)) {
+        return false;
+    }
+    const CookedMeshHeader& header = *reinterpret_cast<const CookedMeshHeader *>(data);
+    if (!std::equal(std::begin(Magic), std::end(Magic), header.magic) || ByteOrder != header.byteOrder ||
+        Version != header.version || sizeof(CookedMeshHeader) != header.headerSize ||
+        sizeof(CookedMeshTile) != header.tileSize || size != header.fileSize) {
+        return false;
+    }
+    const uint64_t tileCount = static_cast<uint64_t>(header.tileCountX) * header.tileCountY;
+    const uint64_t vertexCount = header.vertexCount;
+    auto isSection = [size](uint32_t offset, uint64_t length) {
+        return 0 == offset % Alignment && offset >= sizeof(CookedMeshHeader) && offset + length <= size;
+    };
+    if (!isSection(header.tilesOffset, tileCount * sizeof(CookedMeshTile)) ||
+        !isSection(header.positionsOffset, vertexCount * sizeof(Float3)) ||
+        !isSection(header.texCoordsOffset, vertexCount * sizeof(Float2)) ||
+        !isSection(header.normalsOffset, tileCount * sizeof(Float3))) {
+        return false;
+    }
+    // Tiles must not reference vertices out of bounds.
+    const CookedMeshTile *tiles = reinterpret_cast<const CookedMeshTile *>(data + header.tilesOffset);
+    for (uint64_t i = 0; i < tileCount; ++i) {
+        if (static_cast<uint64_t>(tiles[i].vertexStart) + tiles[i].vertexCount > vertexCount) {
+            return false;
+        }
+    }
+    return true;
+}
+
+std::shared_ptr<CookedMesh> CookedMesh::load(const std::string& pathname, const std::vector<std::string>& sources) {
+    if (!vfs_exists(pathname)) {
+        return nullptr;
+    }
+    std::shared_ptr<CookedMesh> mesh(new CookedMesh());
+    // Map the file if it resides in a directory, otherwise read it.
+    auto resolved = vfs_resolveReadFilename(pathname);
+    if (resolved.first && fs_mapFile(resolved.second, &mesh->_mapping)) {
+        mesh->_data = static_cast<uint8_t *>(mesh->_mapping.data);
+        mesh->_size = mesh->_mapping.size;
+    } else {
+        std::vector<uint8_t> bytes;
+        try {
+            vfs_readEntireFile(pathname, [&bytes](size_t length, const char *data) {
+                bytes.insert(bytes.end(), data, data + length);
+            });
+        } catch (const id::runtime_error& ex) {
+            Log::get() << Log::Entry::create(Log::Level::Warning, __FILE__, __LINE__, "unable to read cooked mesh ", "`",
+                                             pathname, "`", ": ", ex.what(), Log::EndOfEntry);
+            return nullptr;
+        }
+        mesh->_buffer.resize((bytes.size() + sizeof(uint64_t) - 1) / sizeof(uint64_t));
+        mesh->_data = reinterpret_cast<uint8_t *>(mesh->_buffer.data());
+        mesh->_size = bytes.size();
+        std::copy(bytes.begin(), bytes.end(), mesh->_data);
+    }
+    if (!validate(mesh->_data, mesh->_size)) {
+        Log::get() << Log::Entry::create(Log::Level::Warning, __FILE__, __LINE__, "cooked mesh ", "`", pathname, "`",
+                                         " is invalid or of a different version - ignoring it", Log::EndOfEntry);
+        return nullptr;
+    }
+    for (const auto& source : sources) {
+        if (!vfs_exists(source)) {
+            Log::get() << Log::Entry::create(Log::Level::Info, __FILE__, __LINE__, "source ", "`", source, "`", " of cooked mesh ",
+                                             "`", pathname, "`", " does not exist - ignoring it", Log::EndOfEntry);
+            return nullptr;
+        }
+    }
+    if (stampSources(sources) != mesh->getSourceStamp()) {
+        Log::get() << Log::Entry::create(Log::Level::Info, __FILE__, __LINE__, "cooked mesh ", "`", pathname, "`",
+                                         " is out of date - ignoring it", Log::EndOfEntry);
+        return nullptr;
+    }
+    return mesh;
+}
+
+bool CookedMesh::save(const std::string& pathname) const {
+    std::ofstream file(pathname, std::ios::out | std::ios::binary | std::ios::trunc);
+    if (!file) {
+        return false;
+    }
+    file.write(reinterpret_cast<const char *>(_data), _size);
+    return static_cast<bool>(file);
+}
+
+uint32_t CookedMesh::stampSources(const std::vector<std::string>& pathnames) {
+    // 32-bit FNV-1a.
+    uint32_t hash = 2166136261u;
+    auto update = [&hash](const uint8_t *data, size_t length) {
+        for (size_t i = 0; i < length; ++i) {
+            hash ^= data[i];
+            hash *= 16777619u;
+        }
+    };
+    for (const auto& pathname : pathnames) {
+        // A missing file contributes a size of zero.
+        uint64_t size = 0;
+        uint32_t contents = 2166136261u;
+        if (vfs_exists(pathname)) {
+            try {
+                vfs_readEntireFile(pathname, [&size, &contents](size_t length, const char *data) {
+                    size += length;
+                    for (size_t i = 0; i < length; ++i) {
+                        contents ^= static_cast<uint8_t>(data[i]);
+                        contents *= 16777619u;
+                    }
+                });
+            } catch (const id::runtime_error&) {
+                size = 0;
+            }
+        }
+        // The size precedes the contents such that the boundaries between the files are part of the stamp.
+        for (size_t i = 0; i < sizeof(size); ++i) {
+            const uint8_t byte = static_cast<uint8_t>(size >> (8 * i));
+            update(&byte, 1);
+        }
+        for (size_t i = 0; i < sizeof(contents); ++i) {
+            const uint8_t byte = static_cast<uint8_t>(contents >> (8 * i));
+            update(&byte, 1);
+        }
+    }
+    return hash;
+}
+
+std::shared_ptr<CookedMesh> CookedMesh::cook(const map_t& map, const tile_dictionary_t& dictionary, uint32_t sourceStamp) {
+    const size_t tileCountX = map._info.getTileCountX(),
+                 tileCountY = map._info.getTileCountY(),
+                 tileCount = map._info.getTileCount(),
+                 vertexCount = map._info.getVertexCount();
+    if (map._mem.tiles.size() < tileCount || map._mem.vertices.size() < vertexCount) {
+        Log::get() << Log::Entry::create(Log::Level::Error, __FILE__, __LINE__, "map is not allocated", Log::EndOfEntry);
+        return nullptr;
+    }
+    auto mesh = create(vertexCount, tileCountX, tileCountY);
+    if (!mesh) {
+        return nullptr;
+    }
+    mesh->getHeader().sourceStamp = sourceStamp;
+    CookedMeshTile *tiles = mesh->getTiles();
+    Float3 *positions = mesh->getPositions();
+    Float2 *texCoords = mesh->getTexCoords();
+    Float3 *normals = mesh->getNormals();
+
+    // (1) Copy the tiles, compute the vertex indices and the texture coordinates.
+    size_t vertexIndex = 0;
+    for (size_t i = 0; i < tileCount; ++i) {
+        const tile_info_t& source = map._mem.tiles[i];
+        CookedMeshTile& tile = tiles[i];
+        tile.type = source.type;
+        tile.img = source.img;
+        tile.fx = source.fx;
+        tile.vertexStart = static_cast<uint32_t>(vertexIndex);
+        tile.vertexCount = 0;
+
+        // Throw away any remaining upper bits.
+        const tile_definition_t *definition = dictionary.get(source.type & 0x3F);
+        if (!definition) continue;
+        if (vertexIndex + definition->numvertices > vertexCount) {
+            Log::get() << Log::Entry::create(Log::Level::Error, __FILE__, __LINE__, "wrong number of vertices: tile ",
+                                             i, " exceeds ", vertexCount, " vertices", Log::EndOfEntry);
+            return nullptr;
+        }
+        tile.vertexCount = definition->numvertices;
+        for (size_t j = 0; j < definition->numvertices; ++j) {
+            texCoords[vertexIndex + j][0] = definition->vertices[j].u;
+            texCoords[vertexIndex + j][1] = definition->vertices[j].v;
+        }
+        vertexIndex += definition->numvertices;
+    }
+    if (vertexIndex != vertexCount) {
+        Log::get() << Log::Entry::create(Log::Level::Warning, __FILE__, __LINE__, "wrong number of vertices: received ",
+                                         vertexIndex, ", expected ", vertexCount, Log::EndOfEntry);
+    }
+    for (size_t i = 0; i < vertexCount; ++i) {
+        const map_vertex_t& source = map._mem.vertices[i];
+        positions[i][0] = source.pos[kX];
+        positions[i][1] = source.pos[kY];
+        positions[i][2] = source.pos[kZ];
+    }
+
+    // (2) Take the ambient light from the first vertex of each tile and remove the ambient light common to all tiles.
+    uint8_t minimumAmbient = std::numeric_limits<uint8_t>::max();
+    for (size_t i = 0; i < tileCount; ++i) {
+        CookedMeshTile& tile = tiles[i];
+        tile.a = (tile.vertexStart < vertexCount) ? map._mem.vertices[tile.vertexStart].a : 0;
+        minimumAmbient = std::min(minimumAmbient, tile.a);
+    }
+    for (size_t i = 0; i < tileCount; ++i) {
+        tiles[i].a -= minimumAmbient;
+    }
+
+    // (3) Compute the twist from the elevations of the corners and the tile normal from the twist.
+    for (size_t i = 0; i < tileCount; ++i) {
+        CookedMeshTile& tile = tiles[i];
+        tile.twist = TWIST_FLAT;
+        if (MAP_FANOFF != tile.img && tile.vertexCount >= 4) {
+            const float z0 = positions[tile.vertexStart + 0][2],
+                        z1 = positions[tile.vertexStart + 1][2],
+                        z2 = positions[tile.vertexStart + 2][2],
+                        z3 = positions[tile.vertexStart + 3][2];
+            const float zx = CARTMAN_FIXNUM * (z0 + z3 - z1 - z2) / CARTMAN_SLOPE;
+            const float zy = CARTMAN_FIXNUM * (z2 + z3 - z0 - z1) / CARTMAN_SLOPE;
+            tile.twist = cartman_calc_twist(static_cast<int>(zx), static_cast<int>(zy));
+        }
+        Vector3f normal;
+        twist_to_normal(tile.twist, normal, 1.0f);
+        normals[i][0] = normal[kX];
+        normals[i][1] = normal[kY];
+        normals[i][2] = normal[kZ];
+    }
+
+    // (4) Find an "average" normal for each corner of each tile. Normals are not smoothed across creases,
+    // i.e. between the floor and a wall.
+    auto getNormal = [&](int ix, int iy, Vector3f& normal) {
+        if (ix < 0 || iy < 0 || ix >= static_cast<int>(tileCountX) || iy >= static_cast<int>(tileCountY)) {
+            return false;
+        }
+        const Float3& n = normals[ix + iy * tileCountX];
+        normal = Vector3f(n[0], n[1], n[2]);
+        return true;
+    };
+    for (size_t iy = 0; iy < tileCountY; ++iy) {
+        for (size_t ix = 0; ix < tileCountX; ++ix) {
+            static const int ix_off[4] = {0, 1, 1, 0};
+            static const int iy_off[4] = {0, 0, 1, 1};
+
+            CookedMeshTile& tile = tiles[ix + iy * tileCountX];
+            Vector3f nrm_lst[4];
+            getNormal(static_cast<int>(ix), static_cast<int>(iy), nrm_lst[0]);
+
+            for (int i = 0; i < 4; ++i) {
+                // The offset list needs to be shifted depending on the corner.
+                const size_t shift = (6 - i) % 4;
+                const int dx = (1 == ix_off[(4 - shift) % 4]) ? -1 : 0;
+                const int dy = (1 == iy_off[(4 - shift) % 4]) ? -1 : 0;
+
+                // nrm_lst[0] is already known.
+                for (int j = 1; j < 4; ++j) {
+                    const int jx = static_cast<int>(ix) + ix_off[(4 - shift + j) % 4] + dx;
+                    const int jy = static_cast<int>(iy) + iy_off[(4 - shift + j) % 4] + dy;
+                    if (getNormal(jx, jy, nrm_lst[j])) {
+                        if (nrm_lst[j][kZ] < 0) {
+                            nrm_lst[j] = -nrm_lst[j];
+                        }
+                    } else {
+                        nrm_lst[j] = Vector3f(0.0f, 0.0f, 1.0f);
+                    }
+                }
+
+                // Find the creases.
+                bool edge_is_crease[4];
+                float weight_lst[4];
+                for (int j = 0; j < 4; ++j) {
+                    const int m = (j + 1) % 4;
+                    edge_is_crease[j] = (nrm_lst[j].dot(nrm_lst[m]) < Math::invSqrtTwo<float>());
+                    weight_lst[j] = nrm_lst[j].dot(nrm_lst[0]);
+                }
+                weight_lst[0] = 1.0f;
+                if (edge_is_crease[0]) {
+                    // There is a crease between tile 0 and 1.
+                    weight_lst[1] = 0.0f;
+                }
+                if (edge_is_crease[3]) {
+                    // There is a crease between tile 0 and 3.
+                    weight_lst[3] = 0.0f;
+                }
+                if (edge_is_crease[0] && edge_is_crease[3]) {
+                    // Tile 2 is isolated by creases.
+                    weight_lst[2] = 0.0f;
+                }
+
+                Vector3f sum = nrm_lst[0];
+                for (int j = 1; j < 4; ++j) {
+                    if (weight_lst[j] > 0.0f) {
+                        sum += nrm_lst[j] * weight_lst[j];
+                    }
+                }
+                sum.normalize();
+
+                tile.cornerNormals[i][0] = sum[kX];
+                tile.cornerNormals[i][1] = sum[kY];
+                tile.cornerNormals[i][2] = sum[kZ];
+            }
+        }
+    }
+
+    // (5) Compute the bounding boxes of the tiles and of the mesh.
+    AxisAlignedBox3f bounds;
+    if (vertexCount > 0) {
+        const Point3f first(positions[0][0], positions[0][1], positions[0][2]);
+        bounds = AxisAlignedBox3f(first, first);
+    }
+    for (size_t i = 0; i < tileCount; ++i) {
+        CookedMeshTile& tile = tiles[i];
+        if (0 == tile.vertexCount) continue;
+
+        // Initialize the octagonal bounding box of the tile with the first vertex of the tile,
+        // then add the other vertices of the tile to it.
+        const Float3 *vertex = positions + tile.vertexStart;
+        oct_vec_v2_t ovec(Vector3f(vertex[0][0], vertex[0][1], vertex[0][2]));
+        oct_bb_t oct(ovec);
+        for (size_t j = 1; j < tile.vertexCount; ++j) {
+            oct.join(oct_vec_v2_t(Vector3f(vertex[j][0], vertex[j][1], vertex[j][2])));
+        }
+
+        // Ensure that no tile has zero volume.
+        if (oct._empty || (std::abs(oct._maxs[OCT_X] - oct._mins[OCT_X]) +
+                           std::abs(oct._maxs[OCT_Y] - oct._mins[OCT_Y]) +
+                           std::abs(oct._maxs[OCT_Z] - oct._mins[OCT_Z])) < std::numeric_limits<float>::epsilon()) {
+            ovec[OCT_X] = ovec[OCT_Y] = ovec[OCT_Z] = 0.1f;
+            ovec[OCT_XY] = ovec[OCT_YX] = Math::sqrtTwo<float>() * ovec[OCT_X];
+            oct_bb_t::self_grow(oct, ovec);
+        }
+
+        for (size_t j = 0; j < OCT_COUNT; ++j) {
+            tile.octMins[j] = oct._mins[j];
+            tile.octMaxs[j] = oct._maxs[j];
+        }
+        tile.octEmpty = oct._empty ? 1 : 0;
+
+        // Add the bounds of the tile to the bounds of the mesh.
+        bounds.join(oct.toAxisAlignedBox());
+    }
+    CookedMeshHeader& header = mesh->getHeader();
+    for (size_t j = 0; j < 3; ++j) {
+        header.boundsMin[j] = bounds.getMin()[j];
+        header.boundsMax[j] = bounds.getMax()[j];
+    }
+
+    return mesh;
+}
+
+} // namespace Ego
@@ -0,0 +1,202 @@
+//********************************************************************************************
+//*
+//*    This file is part of Egoboo.
+//*
+//*    Egoboo is free software: you can redistribute it and/or modify it
+//*    under the terms of the GNU General Public License as published by
+//*    the Free Software Foundation, either version 3 of the License, or
+//*    (at your option) any later version.
+//*
+//*    Egoboo is distributed in the hope that it will be useful, but
+//*    WITHOUT ANY WARRANTY; without even the implied warranty of
+//*    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+//*    General Public License for more details.
+//*
+//*    You should have received a copy of the GNU General Public License
+//*    along with Egoboo.  If not, see <http://www.gnu.org/licenses/>.
+//*
+//********************************************************************************************
+
+/// @file   egolib/Mesh/CookedMesh.hpp
+/// @brief  A binary mesh format which can be used in place without parsing.
+
+#pragma once
+
+#include "egolib/file_common.h"
+#include "egolib/Math/_Include.hpp"
+
+// Forward declarations.
+struct map_t;
+struct tile_dictionary_t;
+
+namespace Ego {
+
+/**
+ * @brief
+ *  The header of a cooked mesh file.
+ * @remark
+ *  All values are little-endian. Offsets are relative to the beginning of the file and aligned to
+ *  CookedMesh::Alignment Bytes.
+ */
+struct CookedMeshHeader {
+    char magic[8];              ///< CookedMesh::Magic
+    uint32_t byteOrder;         ///< CookedMesh::ByteOrder, used to reject files of a foreign byte order
+    uint32_t version;           ///< CookedMesh::Version
+    uint32_t headerSize;        ///< <tt>sizeof(CookedMeshHeader)</tt>
+    uint32_t tileSize;          ///< <tt>sizeof(CookedMeshTile)</tt>
+    uint32_t sourceStamp;       ///< the stamp of the sources this mesh was cooked from, see CookedMesh::stampSources
+    uint32_t tileCountX;        ///< the number of tiles along the x-axis
+    uint32_t tileCountY;        ///< the number of tiles along the y-axis
+    uint32_t vertexCount;       ///< the number of vertices
+    float boundsMin[3];         ///< the minimum of the axis-aligned bounding box of the mesh
+    float boundsMax[3];         ///< the maximum of the axis-aligned bounding box of the mesh
+    uint32_t tilesOffset;       ///< the offset of the tile records, <tt>tileCountX * tileCountY</tt> times CookedMeshTile
+    uint32_t positionsOffset;   ///< the offset of the vertex positions, @a vertexCount times 3 floats
+    uint32_t texCoordsOffset;   ///< the offset of the vertex texture coordinates, @a vertexCount times 2 floats
+    uint32_t normalsOffset;     ///< the offset of the tile normals, <tt>tileCountX * tileCountY</tt> times 3 floats
+    uint32_t fileSize;          ///< the size, in Bytes, of the file
+};
+
+/**
+ * @brief
+ *  The record of a tile in a cooked mesh file.
+ */
+struct CookedMeshTile {
+    uint8_t type;               ///< the tile type
+    uint8_t fx;                 ///< the MPD FX flags
+    uint8_t twist;              ///< the twist, computed from the vertex elevations
+    uint8_t a;                  ///< the ambient light with the minimal ambient light of the mesh removed
+    uint16_t img;               ///< the tile image
+    uint8_t vertexCount;        ///< the number of vertices of the tile
+    uint8_t reserved;
+    uint32_t vertexStart;       ///< the index of the first vertex of the tile
+    float cornerNormals[4][3];  ///< the smoothed normals at the corners of the tile
+    float octMins[5];           ///< the minimum of the octagonal bounding box of the tile
+    float octMaxs[5];           ///< the maximum of the octagonal bounding box of the tile
+    uint32_t octEmpty;          ///< non-zero if the octagonal bounding box of the tile is empty
+};
+
+/**
+ * @brief
+ *  A mesh in the layout used by the game at runtime: Tile records followed by the vertex positions,
+ *  vertex texture coordinates and tile normals as flat arrays. Twist, normals and bounding boxes are
+ *  precomputed, so a mesh loaded from a file is usable without any processing.
+ * @remark
+ *  A cooked mesh loaded from a file on disk is memory-mapped copy-on-write. The arrays may be modified,
+ *  the modifications are not written back to the file.
+ * @remark
+ *  ".mpd" files remain the authoritative format: A cooked mesh stores a stamp of its sources and is rejected
+ *  if the sources are missing or their stamp has changed since.
+ */
+class CookedMesh : private id::non_copyable {
+public:
+    static const char Magic[8];
+    static constexpr uint32_t ByteOrder = 0x01020304;
+    static constexpr uint32_t Version = 2;
+    static constexpr uint32_t Alignment = 16;
+
+    using Float3 = float[3];
+    using Float2 = float[2];
+
+    ~CookedMesh();
+
+    /**
+     * @brief
+     *  Create a cooked mesh of the specified size with all tiles and vertices zeroed.
+     * @param vertexCount
+     *  the number of vertices
+     * @param tileCountX, tileCountY
+     *  the number of tiles along the x- and y-axis
+     */
+    static std::shared_ptr<CookedMesh> create(size_t vertexCount, size_t tileCountX, size_t tileCountY);
+
+    /**
+     * @brief
+     *  Cook a map.
+     * @param map
+     *  the map
+     * @param dictionary
+     *  the tile dictionary
+     * @param sourceStamp
+     *  the stamp of the sources of the map
+     * @return
+     *  the cooked mesh on success, a null pointer on failure
+     */
+    static std::shared_ptr<CookedMesh> cook(const map_t& map, const tile_dictionary_t& dictionary, uint32_t sourceStamp);
+
+    /**
+     * @brief
+     *  Load a cooked mesh.
+     * @param pathname
+     *  the VFS pathname of the file
+     * @param sources
+     *  the VFS pathnames of the sources
+     * @return
+     *  the cooked mesh on success, a null pointer if the file does not exist, is invalid or was cooked from other sources
+     * @remark
+     *  The file is memory-mapped if it resides in a directory, otherwise it is read into memory.
+     * @remark
+     *  A cooked mesh is rejected if any of its sources does not exist.
+     */
+    static std::shared_ptr<CookedMesh> load(const std::string& pathname, const std::vector<std::string>& sources);
+
+    /**
+     * @brief
+     *  Save this cooked mesh.
+     * @param pathname
+     *  the pathname of the file in the native file system
+     * @return
+     *  @a true on success, @a false on failure
+     */
+    bool save(const std::string& pathname) const;
+
+    /**
+     * @brief
+     *  Compute the stamp of the sources of a mesh.
+     * @param pathnames
+     *  the VFS pathnames of the sources
+     * @return
+     *  the FNV-1a hash of the sizes and the contents of the files, a missing file contributes a size of zero
+     */
+    static uint32_t stampSources(const std::vector<std::string>& pathnames);
+
+    /// Get if this mesh is memory-mapped.
+    bool isMapped() const { return nullptr != _mapping.data; }
+
+    uint32_t getSourceStamp() const { return getHeader().sourceStamp; }
+    size_t getTileCountX() const { return getHeader().tileCountX; }
+    size_t getTileCountY() const { return getHeader().tileCountY; }
+    size_t getTileCount() const { return getTileCountX() * getTileCountY(); }
+    size_t getVertexCount() const { return getHeader().vertexCount; }
+    AxisAlignedBox3f getBounds() const;
+
+    CookedMeshTile *getTiles() { return get<CookedMeshTile>(getHeader().tilesOffset); }
+    const CookedMeshTile *getTiles() const { return get<CookedMeshTile>(getHeader().tilesOffset); }
+    Float3 *getPositions() { return get<Float3>(getHeader().positionsOffset); }
+    const Float3 *getPositions() const { return get<Float3>(getHeader().positionsOffset); }
+    Float2 *getTexCoords() { return get<Float2>(getHeader().texCoordsOffset); }
+    const Float2 *getTexCoords() const { return get<Float2>(getHeader().texCoordsOffset); }
+    Float3 *getNormals() { return get<Float3>(getHeader().normalsOffset); }
+    const Float3 *getNormals() const { return get<Float3>(getHeader().normalsOffset); }
+
+private:
+    CookedMesh();
+
+    const CookedMeshHeader& getHeader() const { return *reinterpret_cast<const CookedMeshHeader *>(_data); }
+    CookedMeshHeader& getHeader() { return *reinterpret_cast<CookedMeshHeader *>(_data); }
+
+    template <typename Type>
+    Type *get(uint32_t offset) { return reinterpret_cast<Type *>(_data + offset); }
+    template <typename Type>
+    const Type *get(uint32_t offset) const { return reinterpret_cast<const Type *>(_data + offset); }
+
+    /// Get if the image is a valid cooked mesh.
+    static bool validate(const uint8_t *data, size_t size);
+
+    uint8_t *_data;                 ///< the image, either mapped or owned
+    size_t _size;                   ///< the size, in Bytes, of the image
+    fs_mapping_t _mapping;          ///< the mapping if the image is mapped
+    std::vector<uint64_t> _buffer;  ///< the storage if the image is owned
+};
+
+} // namespace Ego
@@ -9,6 +9,11 @@
 
 #include "egolib/file_common.h"
 
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+
 struct s_mac_find_context : Id::NonCopyable
 {
     NSDirectoryEnumerator *dirEnum;
@@ -149,6 +154,63 @@ int fs_fileIsDirectory(const char *filename)
     }
 }
 
+bool fs_mapFile(const std::string& pathname, fs_mapping_t *mapping)
+{
+    if (pathname.empty() || !mapping)
+    {
+        return false;
+    }
+    mapping->data = nullptr;
+    mapping->size = 0;
+    mapping->handle = nullptr;
+
+    int fd = open(pathname.c_str(), O_RDONLY);
+    if (-1 == fd)
+    {
+        return false;
+    }
+    struct stat statBuffer;
+    if (-1 == fstat(fd, &statBuffer) || !S_ISREG(statBuffer.st_mode) || 0 == statBuffer.st_size)
+    {
+        close(fd);
+        return false;
+    }
+    // A private mapping is copy-on-write: The file is never modified.
+    void *data = mmap(nullptr, statBuffer.st_size, PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (MAP_FAILED == data)
+    {
+        return false;
+    }
+    mapping->data = data;
+    mapping->size = statBuffer.st_size;
+    return true;
+}
+
+void fs_unmapFile(fs_mapping_t *mapping)
+{
+    if (!mapping || !mapping->data)
+    {
+        return;
+    }
+    munmap(mapping->data, mapping->size);
+    mapping->data = nullptr;
+    mapping->size = 0;
+    mapping->handle = nullptr;
+}
+
+bool fs_getFileInfo(const std::string& pathname, uint64_t *size, int64_t *modificationTime)
+{
+    struct stat statBuffer;
+    if (pathname.empty() || -1 == stat(pathname.c_str(), &statBuffer) || !S_ISREG(statBuffer.st_mode))
+    {
+        return false;
+    }
+    *size = static_cast<uint64_t>(statBuffer.st_size);
+    *modificationTime = static_cast<int64_t>(statBuffer.st_mtime);
+    return true;
+}
+
 //---------------------------------------------------------------------------------------------
 //Directory Functions--------------------------------------------------------------------------
 //---------------------------------------------------------------------------------------------
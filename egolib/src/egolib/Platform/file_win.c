@@ -193,6 +193,74 @@ bool fs_copyFile(const std::string& source, const std::string& target)
     return (TRUE == CopyFile(source.c_str(), target.c_str(), false));
 }
 
+bool fs_mapFile(const std::string& pathname, fs_mapping_t *mapping)
+{
+    if (pathname.empty() || !mapping)
+    {
+        return false;
+    }
+    mapping->data = nullptr;
+    mapping->size = 0;
+    mapping->handle = nullptr;
+
+    HANDLE file = CreateFile(pathname.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (INVALID_HANDLE_VALUE == file)
+    {
+        return false;
+    }
+    LARGE_INTEGER size;
+    if (!GetFileSizeEx(file, &size) || 0 == size.QuadPart)
+    {
+        CloseHandle(file);
+        return false;
+    }
+    // A copy-on-write mapping: The file is never modified.
+    HANDLE fileMapping = CreateFileMapping(file, nullptr, PAGE_WRITECOPY, 0, 0, nullptr);
+    // The mapping remains valid after the file handle is closed.
+    CloseHandle(file);
+    if (nullptr == fileMapping)
+    {
+        return false;
+    }
+    void *data = MapViewOfFile(fileMapping, FILE_MAP_COPY, 0, 0, 0);
+    if (nullptr == data)
+    {
+        CloseHandle(fileMapping);
+        return false;
+    }
+    mapping->data = data;
+    mapping->size = static_cast<size_t>(size.QuadPart);
+    mapping->handle = fileMapping;
+    return true;
+}
+
+void fs_unmapFile(fs_mapping_t *mapping)
+{
+    if (!mapping || !mapping->data)
+    {
+        return;
+    }
+    UnmapViewOfFile(mapping->data);
+    CloseHandle(static_cast<HANDLE>(mapping->handle));
+    mapping->data = nullptr;
+    mapping->size = 0;
+    mapping->handle = nullptr;
+}
+
+bool fs_getFileInfo(const std::string& pathname, uint64_t *size, int64_t *modificationTime)
+{
+    WIN32_FILE_ATTRIBUTE_DATA data;
+    if (pathname.empty() || !GetFileAttributesEx(pathname.c_str(), GetFileExInfoStandard, &data) ||
+        HAS_ATTRIBS(FILE_ATTRIBUTE_DIRECTORY, data.dwFileAttributes))
+    {
+        return false;
+    }
+    *size = (static_cast<uint64_t>(data.nFileSizeHigh) << 32) | data.nFileSizeLow;
+    *modificationTime = static_cast<int64_t>((static_cast<uint64_t>(data.ftLastWriteTime.dwHighDateTime) << 32) |
+                                             data.ftLastWriteTime.dwLowDateTime);
+    return true;
+}
+
 //--------------------------------------------------------------------------------------------
 // Directory Functions
 //--------------------------------------------------------------------------------------------
@@ -0,0 +1,388 @@
+//********************************************************************************************
+//*
+//*    This file is part of Egoboo.
+//*
+//*    Egoboo is free software: you can redistribute it and/or modify it
+//*    under the terms of the GNU General Public License as published by
+//*    the Free Software Foundation, either version 3 of the License, or
+//*    (at your option) any later version.
+//*
+//*    Egoboo is distributed in the hope that it will be useful, but
+//*    WITHOUT ANY WARRANTY; without even the implied warranty of
+//*    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+//*    General Public License for more details.
+//*
+//*    You should have received a copy of the GNU General Public License
+//*    along with Egoboo.  If not, see <http://www.gnu.org/licenses/>.
+//*
+//********************************************************************************************
+/// @file  egolib/Profiles/CharacterExporter.cpp
+/// @brief Asynchronous, incremental export of player characters into their save directories.
+
+#define EGOLIB_PROFILES_PRIVATE 1
+#include "egolib/Profiles/CharacterExporter.hpp"
+#include "egolib/file_common.h"
+#include "egolib/strutil.h"
+#include "egolib/vfs.h"
+#include "egolib/Log/_Include.hpp"
+
+namespace {
+
+/// Get the native pathname of a file relative to a directory.
+std::string join(const std::string& directory, const std::string& relativePathname) {
+    return directory + SLASH_STR + str_convert_slash_sys(relativePathname);
+}
+
+/// Compute the 64-bit FNV-1a hash and the size of the contents of a file.
+bool hashFile(const std::string& pathname, uint64_t& hash, size_t& size) {
+    FILE *file = fopen(pathname.c_str(), "rb");
+    if (!file) {
+        return false;
+    }
+    hash = 14695981039346656037ULL;
+    size = 0;
+    std::array<uint8_t, 64 * 1024> buffer;
+    size_t count;
+    while (0 < (count = fread(buffer.data(), 1, buffer.size(), file))) {
+        for (size_t i = 0; i < count; ++i) {
+            hash = (hash ^ buffer[i]) * 1099511628211ULL;
+        }
+        size += count;
+    }
+    const bool success = !ferror(file);
+    fclose(file);
+    return success;
+}
+
+/// Get if a file exists and has the specified hash and size.
+bool hasContents(const std::string& pathname, uint64_t hash, size_t size) {
+    uint64_t otherHash;
+    size_t otherSize;
+    return hashFile(pathname, otherHash, otherSize) && otherHash == hash && otherSize == size;
+}
+
+/// Create the directories containing a file relative to a directory.
+void createParentDirectories(const std::string& directory, const std::string& relativePathname) {
+    for (size_t i = relativePathname.find('/'); std::string::npos != i; i = relativePathname.find('/', i + 1)) {
+        const std::string parent = join(directory, relativePathname.substr(0, i));
+        if (1 != fs_fileIsDirectory(parent)) {
+            fs_createDirectory(parent);
+        }
+    }
+}
+
+/// Remove the files in a directory, recursively, which are not in a set of relative pathnames.
+/// Directories left empty are removed as well.
+void removeFilesNotIn(const std::string& directory, const std::string& prefix, const std::unordered_set<std::string>& keep) {
+    std::vector<std::string> filenames;
+    fs_find_context_t context;
+    for (const char *filename = fs_findFirstFile(directory.c_str(), nullptr, &context); nullptr != filename;
+         filename = fs_findNextFile(&context)) {
+        // Ignore files that start with a ., like .svn for example.
+        if ('.' != filename[0]) {
+            filenames.emplace_back(filename);
+        }
+    }
+    fs_findClose(&context);
+
+    for (const auto& filename : filenames) {
+        const std::string pathname = directory + SLASH_STR + filename;
+        if (1 == fs_fileIsDirectory(pathname)) {
+            removeFilesNotIn(pathname, prefix + filename + "/", keep);
+            // Fails if the directory is not empty.
+            fs_removeDirectory(pathname);
+        } else if (0 == keep.count(prefix + filename)) {
+            fs_deleteFile(pathname);
+        }
+    }
+}
+
+} // namespace
+
+const std::string CharacterExporter::ManifestFilename = "export.manifest";
+
+CharacterExporter::CharacterExporter() :
+    _threadPool(1),
+    _reportsMutex(),
+    _reports()
+{}
+
+CharacterExporter::~CharacterExporter()
+{
+    wait();
+}
+
+std::string CharacterExporter::getStagingDirectory(const std::string& directory)
+{
+    return directory + ".staging";
+}
+
+void CharacterExporter::submit(CharacterExport characterExport)
+{
+    logReports();
+    _threadPool.submit([this, characterExport]()
+    {
+        Report report;
+        if (characterExport.failed)
+        {
+            report = discard(characterExport);
+        }
+        else
+        {
+            report = write(characterExport);
+        }
+        std::lock_guard<std::mutex> lock(_reportsMutex);
+        _reports.push_back(report);
+    });
+}
+
+void CharacterExporter::wait()
+{
+    _threadPool.wait();
+    logReports();
+}
+
+void CharacterExporter::logReports()
+{
+    std::vector<Report> reports;
+    {
+        std::lock_guard<std::mutex> lock(_reportsMutex);
+        reports.swap(_reports);
+    }
+    for (const auto& report : reports)
+    {
+        if (report.success)
+        {
+            Log::get() << Log::Entry::create(Log::Level::Info, __FILE__, __LINE__, "exported ", "`", report.name, "`", ": ",
+                                             report.filesWritten, " files written (", report.bytesWritten, " Bytes), ",
+                                             report.filesUnchanged, " files unchanged, ", report.duration.count(), " ms",
+                                             Log::EndOfEntry);
+        }
+        else
+        {
+            Log::get() << Log::Entry::create(Log::Level::Warning, __FILE__, __LINE__, "unable to export ", "`", report.name, "`",
+                                             Log::EndOfEntry);
+        }
+    }
+}
+
+CharacterExporter::Report CharacterExporter::discard(const CharacterExport& characterExport)
+{
+    const auto start = std::chrono::steady_clock::now();
+    // The export may have failed before its save directory was known.
+    if (!characterExport.directory.empty())
+    {
+        fs_removeDirectoryAndContents(getStagingDirectory(characterExport.directory).c_str(), 1);
+        vfs_invalidateCache();
+    }
+
+    Report report;
+    report.name = characterExport.name;
+    report.success = false;
+    report.filesWritten = 0;
+    report.filesUnchanged = 0;
+    report.bytesWritten = 0;
+    report.duration = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - start);
+    return report;
+}
+
+CharacterExporter::Report CharacterExporter::write(const CharacterExport& characterExport)
+{
+    const auto start = std::chrono::steady_clock::now();
+    const std::string& directory = characterExport.directory;
+    const std::string staging = getStagingDirectory(directory);
+
+    Report report;
+    report.name = characterExport.name;
+    report.success = false;
+    report.filesWritten = 0;
+    report.filesUnchanged = 0;
+    report.bytesWritten = 0;
+
+    auto finish = [&report, &start]()
+    {
+        report.duration = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - start);
+        return report;
+    };
+    auto fail = [&staging, &finish]()
+    {
+        fs_removeDirectoryAndContents(staging.c_str(), 1);
+        return finish();
+    };
+
+    if (1 != fs_fileIsDirectory(staging) && 0 != fs_createDirectory(staging))
+    {
+        return finish();
+    }
+
+    std::vector<std::string> manifest;
+    std::unordered_set<std::string> listed;
+
+    // The generated files are already staged: Discard those which did not change.
+    for (const auto& relativePathname : characterExport.generatedFiles)
+    {
+        const std::string stagedPathname = join(staging, relativePathname);
+        uint64_t hash;
+        size_t size;
+        if (!hashFile(stagedPathname, hash, size) || !listed.insert(relativePathname).second)
+        {
+            continue;
+        }
+        manifest.push_back(relativePathname);
+        if (hasContents(join(directory, relativePathname), hash, size))
+        {
+            fs_deleteFile(stagedPathname);
+            report.filesUnchanged++;
+        }
+        else
+        {
+            report.filesWritten++;
+            report.bytesWritten += size;
+        }
+    }
+
+    // Stage the copied files which changed. Generated files take precedence.
+    for (const auto& copiedFile : characterExport.copiedFiles)
+    {
+        const std::string& relativePathname = copiedFile.second;
+        uint64_t hash;
+        size_t size;
+        if (listed.count(relativePathname) || !hashFile(copiedFile.first, hash, size))
+        {
+            continue;
+        }
+        listed.insert(relativePathname);
+        manifest.push_back(relativePathname);
+        if (hasContents(join(directory, relativePathname), hash, size))
+        {
+            report.filesUnchanged++;
+            continue;
+        }
+        createParentDirectories(staging, relativePathname);
+        if (!fs_copyFile(copiedFile.first, join(staging, relativePathname)))
+        {
+            return fail();
+        }
+        report.filesWritten++;
+        report.bytesWritten += size;
+    }
+
+    // Commit: Write the manifest and atomically rename it into place.
+    const std::string temporaryManifest = join(staging, ManifestFilename + ".tmp");
+    FILE *file = fopen(temporaryManifest.c_str(), "wb");
+    if (!file)
+    {
+        return fail();
+    }
+    for (const auto& relativePathname : manifest)
+    {
+        fputs(relativePathname.c_str(), file);
+        fputc('\n', file);
+    }
+    const bool written = !ferror(file);
+    if (0 != fclose(file) || !written)
+    {
+        return fail();
+    }
+    if (0 != std::rename(temporaryManifest.c_str(), join(staging, ManifestFilename).c_str()))
+    {
+        return fail();
+    }
+
+    report.success = commit(directory);
+    return finish();
+}
+
+bool CharacterExporter::commit(const std::string& directory)
+{
+    const std::string staging = getStagingDirectory(directory);
+
+    // Read the manifest.
+    std::vector<std::string> manifest;
+    FILE *file = fopen(join(staging, ManifestFilename).c_str(), "rb");
+    if (!file)
+    {
+        return false;
+    }
+    std::array<char, 1024> line;
+    while (fgets(line.data(), line.size(), file))
+    {
+        std::string relativePathname(line.data());
+        while (!relativePathname.empty() && ('\n' == relativePathname.back() || '\r' == relativePathname.back()))
+        {
+            relativePathname.pop_back();
+        }
+        if (!relativePathname.empty())
+        {
+            manifest.push_back(relativePathname);
+        }
+    }
+    fclose(file);
+
+    // Move the staged files into the save directory. Files moved before an interruption are no longer staged.
+    if (1 != fs_fileIsDirectory(directory) && 0 != fs_createDirectory(directory))
+    {
+        return false;
+    }
+    for (const auto& relativePathname : manifest)
+    {
+        const std::string stagedPathname = join(staging, relativePathname);
+        if (1 != fs_fileExists(stagedPathname))
+        {
+            continue;
+        }
+        const std::string targetPathname = join(directory, relativePathname);
+        createParentDirectories(directory, relativePathname);
+        fs_deleteFile(targetPathname);
+        if (0 != std::rename(stagedPathname.c_str(), targetPathname.c_str()))
+        {
+            return false;
+        }
+    }
+
+    // Remove the files which are no longer part of the export.
+    removeFilesNotIn(directory, "", std::unordered_set<std::string>(manifest.begin(), manifest.end()));
+
+    // Only the manifest and empty directories are left. Until they are removed, repeating the commit is harmless.
+    fs_removeDirectoryAndContents(staging.c_str(), 1);
+
+    // The save directory is read through the VFS.
+    vfs_invalidateCache();
+    return true;
+}
+
+void CharacterExporter::recover(const std::string& directory)
+{
+    const std::string staging = getStagingDirectory(directory);
+    if (1 != fs_fileIsDirectory(staging))
+    {
+        return;
+    }
+    if (1 == fs_fileExists(join(staging, ManifestFilename)))
+    {
+        commit(directory);
+    }
+    else
+    {
+        fs_removeDirectoryAndContents(staging.c_str(), 1);
+        vfs_invalidateCache();
+    }
+}
+
+void CharacterExporter::recoverAll(const std::string& directory)
+{
+    static const std::string suffix = ".staging";
+    std::vector<std::string> directories;
+    fs_find_context_t context;
+    for (const char *filename = fs_findFirstFile(directory.c_str(), "staging", &context); nullptr != filename;
+         filename = fs_findNextFile(&context))
+    {
+        std::string pathname = directory + SLASH_STR + filename;
+        directories.push_back(pathname.substr(0, pathname.size() - suffix.size()));
+    }
+    fs_findClose(&context);
+    for (const auto& saveDirectory : directories)
+    {
+        recover(saveDirectory);
+    }
+}
@@ -0,0 +1,163 @@
+//********************************************************************************************
+//*
+//*    This file is part of Egoboo.
+//*
+//*    Egoboo is free software: you can redistribute it and/or modify it
+//*    under the terms of the GNU General Public License as published by
+//*    the Free Software Foundation, either version 3 of the License, or
+//*    (at your option) any later version.
+//*
+//*    Egoboo is distributed in the hope that it will be useful, but
+//*    WITHOUT ANY WARRANTY; without even the implied warranty of
+//*    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+//*    General Public License for more details.
+//*
+//*    You should have received a copy of the GNU General Public License
+//*    along with Egoboo.  If not, see <http://www.gnu.org/licenses/>.
+//*
+//********************************************************************************************
+/// @file  egolib/Profiles/CharacterExporter.hpp
+/// @brief Asynchronous, incremental export of player characters into their save directories.
+
+#pragma once
+#if !defined(EGOLIB_PROFILES_PRIVATE) || EGOLIB_PROFILES_PRIVATE != 1
+#error(do not include directly, include `egolib/Profiles/_Include.hpp` instead)
+#endif
+
+#include "egolib/typedef.h"
+#include "egolib/Core/Singleton.hpp"
+#include "egolib/Core/ThreadPool.hpp"
+
+/**
+ * @brief
+ *  The export of a player character and its items into a save directory.
+ * @remark
+ *  Pathnames relative to the save directory use slashes as separators e.g. <tt>0.obj/data.txt</tt>.
+ */
+struct CharacterExport
+{
+    /// The name of the export e.g. the name of the character.
+    std::string name;
+    /// The native pathname of the save directory.
+    std::string directory;
+    /// The pathnames, relative to the save directory, of the files generated from the state of the character
+    /// and its items. The generated files are written into the staging directory before the export is submitted.
+    std::vector<std::string> generatedFiles;
+    /// The native pathnames of files to copy, e.g. from the profiles of the character and its items,
+    /// and their pathnames relative to the save directory.
+    std::vector<std::pair<std::string, std::string>> copiedFiles;
+    /// If a part of the export, e.g. one of the items, could not be generated.
+    /// A failed export is discarded such that the save directory is not replaced by an incomplete export.
+    bool failed;
+
+    CharacterExport() :
+        name(),
+        directory(),
+        generatedFiles(),
+        copiedFiles(),
+        failed(false)
+    {}
+};
+
+/**
+ * @brief
+ *  Writes exports of player characters on a background thread.
+ * @remark
+ *  An export is staged in the staging directory of its save directory: Files are written into the staging directory
+ *  only if their contents differ from the files in the save directory. Once staged, a manifest listing all files of
+ *  the export is atomically renamed into the staging directory and the export is committed: The staged files are
+ *  moved into the save directory and files not listed in the manifest are removed from the save directory.
+ *  If the game exits before the manifest was renamed, the staging directory is discarded and the save directory
+ *  remains unchanged. If the game exits after the manifest was renamed, CharacterExporter::recover completes the commit.
+ */
+class CharacterExporter : public Ego::Core::Singleton<CharacterExporter>
+{
+protected:
+    friend Ego::Core::Singleton<CharacterExporter>::CreateFunctorType;
+    friend Ego::Core::Singleton<CharacterExporter>::DestroyFunctorType;
+
+    CharacterExporter();
+
+    /// @brief Destruct this exporter. Pending exports are completed.
+    ~CharacterExporter();
+
+public:
+    /// @brief The filename of the manifest of a staged export.
+    static const std::string ManifestFilename;
+
+    /// @brief The statistics of a completed export.
+    struct Report
+    {
+        std::string name;                   ///< the name of the export
+        bool success;                       ///< if the export was committed
+        size_t filesWritten;                ///< the number of files written
+        size_t filesUnchanged;              ///< the number of files skipped because their contents did not change
+        size_t bytesWritten;                ///< the number of Bytes written
+        std::chrono::milliseconds duration; ///< the time it took to stage and commit the export
+    };
+
+    /**
+     * @brief
+     *  Get the staging directory of a save directory.
+     * @param directory
+     *  the native pathname of the save directory
+     * @return
+     *  the native pathname of the staging directory
+     */
+    static std::string getStagingDirectory(const std::string& directory);
+
+    /**
+     * @brief
+     *  Submit an export.
+     * @param characterExport
+     *  the export
+     * @pre
+     *  The generated files of the export are written into the staging directory of the save directory.
+     * @remark
+     *  If the export failed, its staging directory is removed and the save directory remains unchanged.
+     */
+    void submit(CharacterExport characterExport);
+
+    /**
+     * @brief
+     *  Wait until all submitted exports are completed.
+     * @remark
+     *  Must be invoked before reading from a save directory which an export was submitted for.
+     */
+    void wait();
+
+    /**
+     * @brief
+     *  Recover from an export interrupted by the termination of the game.
+     *  Committed exports are completed, uncommitted exports are discarded.
+     * @param directory
+     *  the native pathname of the save directory
+     */
+    static void recover(const std::string& directory);
+
+    /**
+     * @brief
+     *  Recover from all interrupted exports into save directories in a directory.
+     * @param directory
+     *  the native pathname of the directory
+     */
+    static void recoverAll(const std::string& directory);
+
+private:
+    /// @brief Stage and commit an export. Invoked on the background thread.
+    static Report write(const CharacterExport& characterExport);
+
+    /// @brief Remove the staged files of a failed export. Invoked on the background thread.
+    static Report discard(const CharacterExport& characterExport);
+
+    /// @brief Move the staged files of a committed export into the save directory.
+    static bool commit(const std::string& directory);
+
+    /// @brief Log the reports of the exports completed so far.
+    void logReports();
+
+private:
+    ThreadPool _threadPool;
+    std::mutex _reportsMutex;
+    std::vector<Report> _reports;
+};
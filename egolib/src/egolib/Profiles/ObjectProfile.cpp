@@ -151,6 +151,7 @@ ObjectProfile::ObjectProfile() :
 
     // flags
     _isEquipment(false),
+    _alwaysThinking(false),
     _isItem(false),
     _isMount(false),
     _isStackable(false),
@@ -746,6 +747,10 @@ bool ObjectProfile::loadDataFile(const std::string &filePath)
                 _isEquipment = (0 != ctxt.readIntegerLiteral());
             break;
 
+            case IDSZ2::caseLabel( 'T', 'H', 'N', 'K' ):
+                _alwaysThinking = (0 != ctxt.readIntegerLiteral());
+            break;
+
             case IDSZ2::caseLabel( 'S', 'Q', 'U', 'A' ):
                 _bumpSizeBig = _bumpSize * 2;
             break;
@@ -1348,6 +1353,9 @@ bool ObjectProfile::exportCharacterToFile(const std::string &filePath, const Obj
     if ( profile->_isEquipment )
         vfs_put_expansion( fileWrite, "", IDSZ2( 'E', 'Q', 'U', 'I' ), 1 );
 
+    if ( profile->_alwaysThinking )
+        vfs_put_expansion( fileWrite, "", IDSZ2( 'T', 'H', 'N', 'K' ), 1 );
+
     if ( profile->_bumpSizeBig >= profile->_bumpSize * 2 )
         vfs_put_expansion( fileWrite, "", IDSZ2( 'S', 'Q', 'U', 'A' ), 1 );
 
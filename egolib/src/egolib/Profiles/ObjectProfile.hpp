@@ -286,6 +286,9 @@ public:
 
     inline bool isEquipment() const {return _isEquipment;}
 
+    /// @brief Get if the A.I. script of this profile must run every update, even if it is event-driven.
+    inline bool isAlwaysThinking() const {return _alwaysThinking;}
+
     inline bool isStackable() const {return _isStackable;}
 
     inline PIP_REF getAttackParticleProfile() const {return getParticleProfile(_attackParticle);}
@@ -747,6 +750,7 @@ private:
 
     // flags
     bool       _isEquipment;                   ///< Behave in silly ways
+    bool       _alwaysThinking;                ///< Run the A.I. script every update?
     bool       _isItem;                        ///< Is it an item?
     bool       _isMount;                       ///< Can you ride it?
     bool       _isStackable;                   ///< Is it arrowlike?
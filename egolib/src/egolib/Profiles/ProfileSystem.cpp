@@ -26,6 +26,7 @@
 #include "egolib/Profiles/ProfileSystem.hpp"
 #include "egolib/Profiles/ObjectProfile.hpp"
 #include "egolib/Profiles/ModuleProfile.hpp"
+#include "egolib/Profiles/CharacterExporter.hpp"
 #include "game/GameStates/LoadPlayerElement.hpp"
 #include "game/Entities/_Include.hpp"
 #include "game/game.h"
@@ -45,6 +46,7 @@ ProfileSystem::ProfileSystem() :
     _profilesLoadedByName(),
     _moduleProfilesLoaded(),
     _loadPlayerList(),
+    _invalidSaveGameDirectory(),
     EnchantProfileSystem("enchant", "/debug/enchant_profile_usage.txt"),
     ParticleProfileSystem("particle", "/debug/particle_profile_usage.txt")
 {
@@ -287,6 +289,12 @@ void ProfileSystem::loadAllSavedCharacters(const std::string &saveGameDirectory)
 
     //Clear any old imports
     _loadPlayerList.clear();
+    _invalidSaveGameDirectory.clear();
+
+    //Saved characters might still be written
+    if (CharacterExporter::isInitialized()) {
+        CharacterExporter::get().wait();
+    }
 
     // Search for all objects
     SearchContext *ctxt = new SearchContext(Ego::VfsPath(saveGameDirectory), Ego::Extension("obj"), VFS_SEARCH_DIR);
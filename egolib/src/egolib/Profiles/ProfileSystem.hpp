@@ -132,10 +132,24 @@ public:
     /**
      * @brief
      *  Reload list of all possible characters we might load.
+     * @remark
+     *  Waits for pending exports of characters.
      */
     void loadAllSavedCharacters(const std::string &saveGameDirectory);
 
-    const std::vector<std::shared_ptr<LoadPlayerElement>>& getSavedPlayers() const {
+    /**
+     * @brief
+     *  Reload list of all possible characters we might load when it is requested next.
+     *  Pending exports of characters can complete in the meantime.
+     */
+    void invalidateSavedCharacters(const std::string &saveGameDirectory) {
+        _invalidSaveGameDirectory = saveGameDirectory;
+    }
+
+    const std::vector<std::shared_ptr<LoadPlayerElement>>& getSavedPlayers() {
+        if (!_invalidSaveGameDirectory.empty()) {
+            loadAllSavedCharacters(std::string(_invalidSaveGameDirectory));
+        }
         return _loadPlayerList;
     }
 
@@ -152,6 +166,7 @@ private:
     std::vector<std::shared_ptr<ModuleProfile>> _moduleProfilesLoaded;  // List of all valid game modules loaded
 
     std::vector<std::shared_ptr<LoadPlayerElement>> _loadPlayerList; // List of characters that can be loaded (lightweight)
+    std::string _invalidSaveGameDirectory; // Directory to reload the list of characters from if it is out of date, empty otherwise
 };
 
 // TODO: Remove this.
@@ -10,4 +10,5 @@
 #include "egolib/Profiles/ModuleProfile.hpp"
 #include "egolib/Profiles/ObjectProfile.hpp"
 #include "egolib/Profiles/ProfileSystem.hpp"
+#include "egolib/Profiles/CharacterExporter.hpp"
 #undef EGOLIB_PROFILES_PRIVATE
@@ -28,6 +28,7 @@
 #include "egolib/Renderer/OpenGL/RendererInfo.hpp"
 #include "egolib/Renderer/OpenGL/DefaultTexture.hpp"
 #include "egolib/Image/ImageManager.hpp"
+#include "egolib/Graphics/CookedTexture.hpp"
 
 namespace Ego {
 namespace OpenGL {
@@ -91,16 +92,17 @@ void Texture::load(const std::string& name, const std::shared_ptr<SDL_Surface>&
         throw id::invalid_argument_error(__FILE__, __LINE__, "nullptr == surface");
     }
 
-    std::shared_ptr<SDL_Surface> newSurface = surface;
+    // Convert to RGB(A), convert to power of two and generate the mipmaps if required.
+    bool mipMaps = TextureType::_2D == type && TextureFilter::None != sampler.getMipMapFilter();
+    auto texture = CookedTexture::cook(surface, 0, mipMaps);
 
-    // Convert to RGBA if the image has non-opaque alpha values or alpha modulation and convert to RGB otherwise.
-    bool hasAlpha = SDL::testAlpha(newSurface);
-    const auto& pixelFormatDescriptor = hasAlpha ? PixelFormatDescriptor::get<PixelFormat::R8G8B8A8>()
-        : PixelFormatDescriptor::get<PixelFormat::R8G8B8>();
-    newSurface = SDL::convertPixelFormat(newSurface, pixelFormatDescriptor);
+    load(name, texture, surface, type, sampler);
+}
 
-    // Convert to power of two.
-    newSurface = SDL::convertPowerOfTwo(newSurface);
+void Texture::load(const std::string& name, const std::shared_ptr<CookedTexture>& texture, const std::shared_ptr<SDL_Surface>& source,
+                   TextureType type, const TextureSampler& sampler)
+{
+    const auto& pixelFormatDescriptor = texture->getPixelFormatDescriptor();
 
     // (1)Generate a new OpenGL texture ID.
     Utilities::clearError();
@@ -147,19 +149,19 @@ void Texture::load(const std::string& name, const std::shared_ptr<SDL_Surface>&
     {
         case TextureType::_2D:
         {
-            if (TextureFilter::None != sampler.getMipMapFilter())
-            {
-                Utilities2::upload_2d_mipmap(pixelFormatDescriptor, newSurface->w, newSurface->h, newSurface->pixels);
-            }
-            else
+            size_t levelCount = (TextureFilter::None != sampler.getMipMapFilter()) ? texture->getLevelCount() : 1;
+            for (size_t level = 0; level < levelCount; ++level)
             {
-                Utilities2::upload_2d(pixelFormatDescriptor, newSurface->w, newSurface->h, newSurface->pixels);
+                Utilities2::upload_2d_level(pixelFormatDescriptor, level, texture->getLevelWidth(level), texture->getLevelHeight(level),
+                                            texture->getLevelPixels(level));
             }
+            // The texture is complete even if it has fewer levels than required by the mipmap filter.
+            glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAX_LEVEL, levelCount - 1);
         }
         break;
         case TextureType::_1D:
         {
-            Utilities2::upload_1d(pixelFormatDescriptor, newSurface->w, newSurface->pixels);
+            Utilities2::upload_1d(pixelFormatDescriptor, texture->getWidth(), texture->getLevelPixels(0));
         }
         break;
         default:
@@ -174,27 +176,33 @@ void Texture::load(const std::string& name, const std::shared_ptr<SDL_Surface>&
     m_sampler = sampler;
     m_type = type;
     m_id = id;
-    m_width = newSurface->w;
-    m_height = newSurface->h;
-    m_source = surface;
-    m_sourceWidth = surface->w;
-    m_sourceHeight = surface->h;
-    m_hasAlpha = hasAlpha;
+    m_width = texture->getWidth();
+    m_height = texture->getHeight();
+    m_source = source;
+    m_sourceWidth = texture->getSourceWidth();
+    m_sourceHeight = texture->getSourceHeight();
+    m_hasAlpha = texture->hasAlpha();
     m_name = name;
 }
 
-bool Texture::load(const std::string& name, const std::shared_ptr<SDL_Surface>& source)
+TextureSampler Texture::getDesiredSampler()
 {
     auto info = Ego::Renderer::get().getInfo();
-    // Determine the texture sampler.
-    TextureSampler sampler(info->getDesiredMinimizationFilter(),
-                           info->getDesiredMaximizationFilter(),
-                           info->getDesiredMipMapFilter(),
-                           TextureAddressMode::Repeat, TextureAddressMode::Repeat,
-                           info->getDesiredAnisotropy());
-    // Determine the texture type.
-    auto type = ((1 == source->h) && (source->w > 1)) ? TextureType::_1D : TextureType::_2D;
-    load(name, source, type, sampler);
+    return TextureSampler(info->getDesiredMinimizationFilter(),
+                          info->getDesiredMaximizationFilter(),
+                          info->getDesiredMipMapFilter(),
+                          TextureAddressMode::Repeat, TextureAddressMode::Repeat,
+                          info->getDesiredAnisotropy());
+}
+
+TextureType Texture::getType(int sourceWidth, int sourceHeight)
+{
+    return ((1 == sourceHeight) && (sourceWidth > 1)) ? TextureType::_1D : TextureType::_2D;
+}
+
+bool Texture::load(const std::string& name, const std::shared_ptr<SDL_Surface>& source)
+{
+    load(name, source, getType(source->w, source->h), getDesiredSampler());
     return true;
 }
 
@@ -205,6 +213,34 @@ bool Texture::load(const std::shared_ptr<SDL_Surface>& source)
     return load(stream.str(), source);
 }
 
+bool Texture::load(const std::string& name, const std::shared_ptr<CookedTexture>& texture)
+{
+    // Bind this texture to the backing error texture.
+    release();
+
+    if (!texture)
+    {
+        throw id::invalid_argument_error(__FILE__, __LINE__, "nullptr == texture");
+    }
+
+    // The source is level 0 without the power-of-two padding. It refers to the pixels of the cooked texture,
+    // hence it keeps the cooked texture alive.
+    const auto& pfd = texture->getPixelFormatDescriptor();
+    const int bytesPerPixel = pfd.getColourDepth().getDepth() / 8;
+    SDL_Surface *surface = SDL_CreateRGBSurfaceFrom(texture->getLevelPixels(0),
+                                                    texture->getSourceWidth(), texture->getSourceHeight(),
+                                                    pfd.getColourDepth().getDepth(), texture->getWidth() * bytesPerPixel,
+                                                    pfd.getRedMask(), pfd.getGreenMask(), pfd.getBlueMask(), pfd.getAlphaMask());
+    if (!surface)
+    {
+        throw id::runtime_error(__FILE__, __LINE__, "unable to create surface");
+    }
+    std::shared_ptr<SDL_Surface> source(surface, [texture](SDL_Surface *pointer) { SDL_FreeSurface(pointer); });
+
+    load(name, texture, source, getType(texture->getSourceWidth(), texture->getSourceHeight()), getDesiredSampler());
+    return true;
+}
+
 void  Texture::release()
 {
     if (isDefault())
@@ -50,6 +50,9 @@ public:
     /** @override Ego::Texture::load(const std::shared_ptr<SDL_Surface>&) */
     bool load(const std::shared_ptr<SDL_Surface>& surface) override;
 
+    /** @override Ego::Texture::load(const std::string&, const std::shared_ptr<CookedTexture>&) */
+    bool load(const std::string& name, const std::shared_ptr<CookedTexture>& texture) override;
+
     /** @override Ego::Texture::release */
     void release() override;
 
@@ -70,6 +73,18 @@ public:
     /// @brief Destruct this texture.
     virtual ~Texture();
 
+private:
+    /// @brief Upload a cooked texture.
+    /// @param source the source of the texture
+    void load(const std::string& name, const std::shared_ptr<CookedTexture>& texture, const std::shared_ptr<SDL_Surface>& source,
+              TextureType type, const TextureSampler& sampler);
+
+    /// @brief Get the texture sampler desired by the renderer.
+    static TextureSampler getDesiredSampler();
+
+    /// @brief Get the texture type for a source of the specified size.
+    static TextureType getType(int sourceWidth, int sourceHeight);
+
 public:
     GLuint getId() const;
     void setId(GLuint id);
@@ -71,6 +71,7 @@ void TextureUnit::setActivated(Texture *texture)
         {
             return;
         }
+        m_bindCount++;
         Utilities2::setSampler(m_info, texture->getType(), texture->getSampler());
         if (Utilities::isError())
         {
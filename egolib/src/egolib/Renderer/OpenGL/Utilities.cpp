@@ -251,47 +251,14 @@ void Utilities2::upload_2d(const PixelFormatDescriptor& pfd, GLsizei w, GLsizei
     glTexImage2D(GL_TEXTURE_2D, 0, internalFormat_gl, w, h, 0, format_gl, type_gl, data);
 }
 
-void Utilities2::upload_2d_mipmap(const PixelFormatDescriptor& pfd, GLsizei w, GLsizei h, const void *data)
+void Utilities2::upload_2d_level(const PixelFormatDescriptor& pfd, GLint level, GLsizei w, GLsizei h, const void *data)
 {
     GLenum internalFormat_gl, format_gl, type_gl;
     Utilities2::toOpenGL(pfd, internalFormat_gl, format_gl, type_gl);
     PushClientAttrib pca(GL_CLIENT_PIXEL_STORE_BIT);
 
     glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
-    glTexImage2D(GL_TEXTURE_2D, 0, internalFormat_gl, w, h, 0, format_gl, type_gl, data);
-
-    if (w == 1 && h == 1) return;
-
-    uint32_t alphaMask = pfd.getAlphaMask(),
-        redMask = pfd.getRedMask(),
-        greenMask = pfd.getGreenMask(),
-        blueMask = pfd.getBlueMask();
-    int bpp = pfd.getColourDepth().getDepth();
-
-    SDL_Surface *surf = SDL_CreateRGBSurfaceFrom((void *)data, w, h, bpp, w * bpp / 8, redMask, greenMask, blueMask, alphaMask);
-    SDL_assert(surf != nullptr);
-
-    GLsizei newW = w;
-    GLsizei newH = h;
-    GLint level = 0;
-
-    do
-    {
-        if (newW > 1) newW /= 2;
-        if (newH > 1) newH /= 2;
-        level++;
-
-        SDL_Surface *newSurf = SDL_CreateRGBSurface(0, newW, newH, bpp, redMask, greenMask, blueMask, alphaMask);
-        SDL_assert(newSurf != nullptr);
-
-        /// @todo this is 'low-quality' and not thread-safe
-        SDL_SoftStretch(surf, nullptr, newSurf, nullptr);
-
-        glTexImage2D(GL_TEXTURE_2D, level, internalFormat_gl, newW, newH, 0, format_gl, type_gl, newSurf->pixels);
-        SDL_FreeSurface(newSurf);
-    } while (!(newW == 1 && newH == 1));
-
-    SDL_FreeSurface(surf);
+    glTexImage2D(GL_TEXTURE_2D, level, internalFormat_gl, w, h, 0, format_gl, type_gl, data);
 }
 
 void Utilities2::toOpenGL(TextureFilter minFilter, TextureFilter magFilter, TextureFilter mipMapFilter, GLint& minFilter_gl, GLint& magFilter_gl)
@@ -112,11 +112,12 @@ public:
     /// @param data a pointer to the pixels
     static void upload_2d(const PixelFormatDescriptor& pfd, GLsizei w, GLsizei h, const void *data);
     
-    /// @brief Upload a 2D texture generating the mipmaps.
+    /// @brief Upload a mipmap level of a 2D texture.
     /// @param pdf the pixel descriptor describing the format of a pixels
+    /// @param level the mipmap level
     /// @param w, h the width and height of the pixel rectangle
     /// @param data a pointer to the pixels
-    static void upload_2d_mipmap(const PixelFormatDescriptor& pfd, GLsizei w, GLsizei h, const void *data);
+    static void upload_2d_level(const PixelFormatDescriptor& pfd, GLint level, GLsizei w, GLsizei h, const void *data);
 
     static void toOpenGL(TextureFilter minFilter, TextureFilter magFilter, TextureFilter mipMapFilter, GLint& minFilter_gl, GLint& magFilter_gl);
 
@@ -59,12 +59,23 @@ StencilBuffer::StencilBuffer()
 StencilBuffer::~StencilBuffer()
 {}
 
-TextureUnit::TextureUnit()
+TextureUnit::TextureUnit() :
+    m_bindCount(0)
 {}
 
 TextureUnit::~TextureUnit()
 {}
 
+size_t TextureUnit::getBindCount() const
+{
+    return m_bindCount;
+}
+
+void TextureUnit::resetBindCount()
+{
+    m_bindCount = 0;
+}
+
 Renderer::Renderer()
     : m_projectionMatrix(Math::Transform::perspective(Math::Degrees(45.0f), 4.0f/3.0f, +0.1f, +1.0f)),
       m_viewMatrix(Matrix4f4f::identity()), m_worldMatrix(Matrix4f4f::identity())
@@ -152,6 +152,9 @@ public:
 class TextureUnit
 {
 protected:
+    /// @brief The number of textures bound since the last reset of the count.
+    size_t m_bindCount;
+
     /// @brief Construct this texture unit (facade).
     /// @remark Intentionally protected.
     TextureUnit();
@@ -179,6 +182,20 @@ public:
      */
     virtual void setActivated(const Texture *texture) = 0;
 
+    /**
+     * @brief
+     *  Get the number of textures bound since the last reset of the count.
+     * @return
+     *  the number of textures bound
+     */
+    size_t getBindCount() const;
+
+    /**
+     * @brief
+     *  Reset the number of textures bound to @a 0.
+     */
+    void resetBindCount();
+
 };
 
 class Renderer;
@@ -34,6 +34,9 @@
 
 namespace Ego {
 
+// Forward declaration.
+class CookedTexture;
+
 class Texture
 {
 protected:
@@ -181,6 +184,18 @@ public:
 	virtual bool load(const std::string& name, const std::shared_ptr<SDL_Surface>& surface) = 0;
 	virtual bool load(const std::shared_ptr<SDL_Surface>& image) = 0;
 
+    /**
+     * @brief
+     *  Load a cooked texture: Its pixels and mipmap levels are uploaded as they are.
+     * @param name
+     *  the name of the texture
+     * @param texture
+     *  the cooked texture
+     * @return
+     *  @a true on success, @a false on failure
+     */
+    virtual bool load(const std::string& name, const std::shared_ptr<CookedTexture>& texture) = 0;
+
 	/**
 	 * @brief
 	 *  Delete backing image, delete OpenGL ID, assign OpenGL ID of the error texture, assign no backing image.
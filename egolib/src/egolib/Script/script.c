@@ -135,7 +135,7 @@ void scripting_system_end()
 
 //--------------------------------------------------------------------------------------------
 //--------------------------------------------------------------------------------------------
-void scr_run_chr_script(Object *pchr)
+bool scr_run_chr_script(Object *pchr)
 {
 
     // Make sure that this module is initialized.
@@ -144,7 +144,7 @@ void scr_run_chr_script(Object *pchr)
     // Do not run scripts of terminated entities.
     if (pchr->isTerminated())
     {
-        return;
+        return false;
     }
     ai_state_t& aiState = pchr->ai;
     script_info_t& script = pchr->getProfile()->getAIScript();
@@ -152,7 +152,7 @@ void scr_run_chr_script(Object *pchr)
     // Has the time for this character to die come and gone?
     if (aiState.poof_time >= 0 && aiState.poof_time <= (int32_t)update_wld)
     {
-        return;
+        return false;
     }
 
     // Grab the "changed" value from the last time the script was run.
@@ -239,9 +239,12 @@ void scr_run_chr_script(Object *pchr)
     aiState.terminate = false;
     script.indent = 0;
 
+    // Event-driven scripts have nothing to react to unless one of their wake conditions holds.
+    const bool awake = pchr->getProfile()->isAlwaysThinking() || script.isAwake(aiState);
+
     // Run the AI Script.
     script.set_pos(0);
-    while (!aiState.terminate && script.get_pos() < script._instructions.getNumberOfInstructions())
+    while (awake && !aiState.terminate && script.get_pos() < script._instructions.getNumberOfInstructions())
     {
         // This is used by the Else function
         // it only keeps track of functions.
@@ -287,8 +290,10 @@ void scr_run_chr_script(Object *pchr)
 
     // Clear alerts for next time around
     RESET_BIT_FIELD(aiState.alert);
+
+    return awake;
 }
-void scr_run_chr_script(const ObjectRef character)
+bool scr_run_chr_script(const ObjectRef character)
 {
     /// @author ZZ
     /// @details This function lets one character do AI stuff
@@ -298,7 +303,7 @@ void scr_run_chr_script(const ObjectRef character)
 
     if (!_currentModule->getObjectHandler().exists(character))
     {
-        return;
+        return false;
     }
     Object *pchr = _currentModule->getObjectHandler().get(character);
     return scr_run_chr_script(pchr);
@@ -609,7 +614,7 @@ void script_state_t::run_operand(ai_state_t& aiState, script_info_t& script)
         // Load the variable. 
         auto variableIndex = constant.getAsInteger();
         varname = getVariableName(variableIndex);
-        auto pleader = _currentModule->getTeamList()[pobject->team].getLeader();
+        auto pleader = _currentModule->getTeamList()[pobject->getTeamRef()].getLeader();
         iTmp = loadVariable(variableIndex, aiState, pobject, ptarget, powner, pleader.get());
     }
 
@@ -715,6 +720,107 @@ bool script_info_t::set_pos(size_t position)
     return true;
 }
 
+/// @brief Get the alert bits a condition requires to pass.
+/// @param functionIndex the function index of the condition
+/// @return the alert bits or ALERT_NONE if the condition can pass without an alert bit being set
+static uint32_t get_condition_alerts(uint32_t functionIndex)
+{
+    using namespace Ego::Script;
+    switch (functionIndex)
+    {
+        case IfSpawned: return ALERTIF_SPAWNED;
+        case IfAtWaypoint: return ALERTIF_ATWAYPOINT;
+        case IfAtLastWaypoint: return ALERTIF_ATLASTWAYPOINT;
+        case IfAttacked: return ALERTIF_ATTACKED;
+        case IfBackstabbed: return ALERTIF_ATTACKED;
+        case IfBumped: return ALERTIF_BUMPED;
+        case IfOrdered: return ALERTIF_ORDERED;
+        case IfCalledForHelp: return ALERTIF_CALLEDFORHELP;
+        case IfKilled: return ALERTIF_KILLED;
+        case IfHealed: return ALERTIF_HEALED;
+        case IfGrabbed: return ALERTIF_GRABBED;
+        case IfDropped: return ALERTIF_DROPPED;
+        case IfReaffirmed: return ALERTIF_REAFFIRMED;
+        case IfLeaderKilled: return ALERTIF_LEADERKILLED;
+        case IfUsed: return ALERTIF_USED;
+        case IfCleanedUp: return ALERTIF_CLEANEDUP;
+        case IfScoredAHit: return ALERTIF_SCOREDAHIT;
+        case IfDisaffirmed: return ALERTIF_DISAFFIRMED;
+        case IfChanged: return ALERTIF_CHANGED;
+        case IfInWater: return ALERTIF_INWATER;
+        case IfBored: return ALERTIF_BORED;
+        case IfTooMuchBaggage: return ALERTIF_TOOMUCHBAGGAGE;
+        case IfLevelUp: return ALERTIF_LEVELUP;
+        case IfGrogged: return ALERTIF_CONFUSED;
+        case IfDazed: return ALERTIF_CONFUSED;
+        case IfHitGround: return ALERTIF_HITGROUND;
+        case IfNotDropped: return ALERTIF_NOTDROPPED;
+        case IfBlocked: return ALERTIF_BLOCKED;
+        case IfThrown: return ALERTIF_THROWN;
+        case IfCrushed: return ALERTIF_CRUSHED;
+        case IfNotPutAway: return ALERTIF_NOTPUTAWAY;
+        case IfTakenOut: return ALERTIF_TAKENOUT;
+        case IfHitVulnerable: return ALERTIF_HITVULNERABLE;
+        default: return ALERT_NONE;
+    }
+}
+
+void script_info_t::classify()
+{
+    _polling = false;
+    _wakeAlerts = ALERT_NONE;
+    _wakeOnTimeOut = false;
+
+    size_t index = 0, count = _instructions.getNumberOfInstructions();
+    while (index < count)
+    {
+        auto instruction = _instructions[index];
+        if (instruction.isInv())
+        {
+            // Functions are followed by their jump code.
+            if (0 == instruction.getDataBits())
+            {
+                const auto& constant = _instructions.getConstantPool().getConstant(instruction.getValueBits());
+                uint32_t functionIndex = constant.getAsInteger();
+                uint32_t alerts = get_condition_alerts(functionIndex);
+                if (ALERT_NONE != alerts)
+                {
+                    _wakeAlerts |= alerts;
+                }
+                else if (Ego::Script::IfTimeOut == functionIndex)
+                {
+                    _wakeOnTimeOut = true;
+                }
+                else if (Ego::Script::End != functionIndex)
+                {
+                    // Any other top-level function, including Else, may have an effect in every update.
+                    _polling = true;
+                    return;
+                }
+            }
+            index += 2;
+        }
+        else
+        {
+            // Top-level operations have an effect in every update.
+            if (0 == instruction.getDataBits())
+            {
+                _polling = true;
+                return;
+            }
+            // Operations cover each operand.
+            index += 2 + Ego::Math::clipBits<8>(_instructions[index + 1].getBits());
+        }
+    }
+}
+
+bool script_info_t::isAwake(const ai_state_t& aiState) const
+{
+    return _polling
+        || HAS_SOME_BITS(aiState.alert, _wakeAlerts)
+        || (_wakeOnTimeOut && update_wld > aiState.timer);
+}
+
 //--------------------------------------------------------------------------------------------
 //--------------------------------------------------------------------------------------------
 bool ai_state_t::get_wp(ai_state_t& self)
@@ -899,6 +1005,16 @@ ai_state_t::~ai_state_t()
     _clock = nullptr;
 }
 
+void ai_state_t::setTarget(const ObjectRef& target)
+{
+    const ObjectRef oldTarget = getTarget();
+    AI::State<ObjectRef>::setTarget(target);
+    if (_currentModule && oldTarget != target)
+    {
+        _currentModule->getObjectHandler().onTargetChanged(getSelf(), oldTarget, target);
+    }
+}
+
 void ai_state_t::reset(ai_state_t& self)
 {
     self._clock->reinit();
@@ -908,8 +1024,9 @@ void ai_state_t::reset(ai_state_t& self)
     self.terminate = false;
 
     // who are we related to?
-    self.setSelf(ObjectRef::Invalid);
+    // (The target is reset first, such that it is removed from the reverse target index of "self".)
     self.setTarget(ObjectRef::Invalid);
+    self.setSelf(ObjectRef::Invalid);
     self.setOldTarget(ObjectRef::Invalid);
     self.setBumped(ObjectRef::Invalid);
     self.setLastAttacker(ObjectRef::Invalid);
@@ -36,6 +36,7 @@
 //--------------------------------------------------------------------------------------------
 
 class Object;
+struct ai_state_t;
 
 //--------------------------------------------------------------------------------------------
 //--------------------------------------------------------------------------------------------
@@ -383,7 +384,10 @@ public:
         indent(0),
         indent_last(0),
         _position(0),
-        _instructions()
+        _instructions(),
+        _polling(true),
+        _wakeAlerts(ALERT_NONE),
+        _wakeOnTimeOut(false)
     {
         //ctor
     }
@@ -425,6 +429,43 @@ public:
 	size_t get_pos() const;
 	bool set_pos(size_t position);
 
+    /**
+     * @brief
+     *  If the script must be run every update.
+     * @remark
+     *  A script is event-driven rather than polling if each of its top-level statements is a condition which can only
+     *  pass if an alert bit is set or if the A.I. timer has expired. Scripts which are event-driven can skip updates
+     *  in which none of these conditions holds as the interpretation of the script would have no effect.
+     */
+    bool _polling;
+    /**
+     * @brief
+     *  The alert bits the top-level conditions of an event-driven script test.
+     */
+    uint32_t _wakeAlerts;
+    /**
+     * @brief
+     *  If a top-level condition of an event-driven script tests if the A.I. timer has expired.
+     */
+    bool _wakeOnTimeOut;
+
+    /**
+     * @brief
+     *  Determine the wake conditions of this script from its instructions.
+     *  Must be invoked after the jumps of the script were determined.
+     */
+    void classify();
+
+    /**
+     * @brief
+     *  Get if the interpretation of this script can have an effect in this update.
+     * @param aiState
+     *  the state of the A.I. running this script
+     * @return
+     *  @a true if this script is polling or any of its wake conditions holds, @a false otherwise
+     */
+    bool isAwake(const ai_state_t& aiState) const;
+
 };
 
 //--------------------------------------------------------------------------------------------
@@ -481,6 +522,10 @@ public:
 	ai_state_t();
 	~ai_state_t();
 
+	/// @brief Set the "target" and update the reverse target index of the object handler.
+	/// @param target the "target"
+	void setTarget(const ObjectRef& target);
+
 	static void reset(ai_state_t& self);
 	static bool set_bumplast(ai_state_t& self, const ObjectRef  ichr);
 	static bool get_wp(ai_state_t& self);
@@ -528,8 +573,10 @@ struct script_state_t : private id::non_copyable
 // FUNCTION PROTOTYPES
 //--------------------------------------------------------------------------------------------
 
-void scr_run_chr_script(Object *pchr);
-void scr_run_chr_script(const ObjectRef character);
+/// @brief Run the A.I. script of an object.
+/// @return @a true if the script was interpreted, @a false if it was skipped because it had nothing to react to
+bool scr_run_chr_script(Object *pchr);
+bool scr_run_chr_script(const ObjectRef character);
 
 void issue_order( const ObjectRef character, uint32_t order );
 void issue_special_order( uint32_t order, const IDSZ2& idsz );
@@ -0,0 +1,319 @@
+//********************************************************************************************
+//*
+//*    This file is part of Egoboo.
+//*
+//*    Egoboo is free software: you can redistribute it and/or modify it
+//*    under the terms of the GNU General Public License as published by
+//*    the Free Software Foundation, either version 3 of the License, or
+//*    (at your option) any later version.
+//*
+//*    Egoboo is distributed in the hope that it will be useful, but
+//*    WITHOUT ANY WARRANTY; without even the implied warranty of
+//*    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+//*    General Public License for more details.
+//*
+//*    You should have received a copy of the GNU General Public License
+//*    along with Egoboo.  If not, see <http://www.gnu.org/licenses/>.
+//*
+//********************************************************************************************
+
+/// @file   egolib/VFS/VfsArchive.cpp
+/// @brief  An indexed archive of the files of a directory which is mounted into the VFS in place.
+
+#include "egolib/VFS/VfsArchive.hpp"
+
+#include "egolib/strutil.h"
+#include "egolib/Log/_Include.hpp"
+
+namespace Ego {
+
+const char VfsArchive::Magic[8] = {'E', 'G', 'O', 'P', 'A', 'C', 'K', '\0'};
+
+static_assert(sizeof(VfsArchiveHeader) == 56, "unexpected padding in VfsArchiveHeader");
+static_assert(sizeof(VfsArchiveEntry) == 48, "unexpected padding in VfsArchiveEntry");
+
+static uint64_t align(uint64_t offset) {
+    return (offset + VfsArchive::Alignment - 1) & ~static_cast<uint64_t>(VfsArchive::Alignment - 1);
+}
+
+namespace {
+
+/// Collect the pathnames of the files in a directory, recursively, relative to the archived directory.
+void collect(const std::string& directory, const std::string& prefix, std::vector<std::string>& names) {
+    std::vector<std::string> filenames;
+    fs_find_context_t context;
+    for (const char *filename = fs_findFirstFile(directory.c_str(), nullptr, &context); nullptr != filename;
+         filename = fs_findNextFile(&context)) {
+        // Ignore files that start with a ., like .svn for example.
+        if ('.' != filename[0]) {
+            filenames.emplace_back(filename);
+        }
+    }
+    fs_findClose(&context);
+    for (const auto& filename : filenames) {
+        const std::string pathname = directory + SLASH_STR + filename;
+        if (1 == fs_fileIsDirectory(pathname)) {
+            collect(pathname, prefix + filename + "/", names);
+        } else {
+            names.push_back(prefix + filename);
+        }
+    }
+}
+
+/// Collect the pathnames of the files in a directory like collect, sorted Byte by Byte.
+std::vector<std::string> collectSorted(const std::string& directory) {
+    std::vector<std::string> names;
+    collect(directory, "", names);
+    std::sort(names.begin(), names.end(), [](const std::string& x, const std::string& y) {
+        const int result = std::memcmp(x.data(), y.data(), std::min(x.size(), y.size()));
+        return result < 0 || (0 == result && x.size() < y.size());
+    });
+    return names;
+}
+
+/// Read the contents of a file in the native file system.
+bool readFile(const std::string& pathname, std::vector<char>& contents) {
+    std::ifstream file(pathname, std::ios::in | std::ios::binary);
+    if (!file) {
+        return false;
+    }
+    contents.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+    return !file.bad();
+}
+
+} // namespace
+
+VfsArchive::VfsArchive() :
+    _pathname(),
+    _data(nullptr),
+    _size(0),
+    _mapping{nullptr, 0, nullptr} {}
+
+VfsArchive::~VfsArchive() {
+    fs_unmapFile(&_mapping);
+}
+
+uint64_t VfsArchive::stamp(const std::string& directory) {
+    uint64_t stamp = 14695981039346656037ULL;
+    auto update = [&stamp](const void *data, size_t size) {
+        for (size_t i = 0; i < size; ++i) {
+            stamp = (stamp ^ static_cast<const uint8_t *>(data)[i]) * 1099511628211ULL;
+        }
+    };
+    for (const auto& name : collectSorted(directory)) {
+        uint64_t size = 0;
+        int64_t modificationTime = 0;
+        fs_getFileInfo(directory + SLASH_STR + str_convert_slash_sys(name), &size, &modificationTime);
+        // The terminating zero separates the name from the next name.
+        update(name.c_str(), name.size() + 1);
+        update(&size, sizeof(size));
+        update(&modificationTime, sizeof(modificationTime));
+    }
+    return stamp;
+}
+
+uint64_t VfsArchive::hash(const char *data, size_t size) {
+    uint64_t hash = 14695981039346656037ULL;
+    for (size_t i = 0; i < size; ++i) {
+        hash = (hash ^ static_cast<uint8_t>(data[i])) * 1099511628211ULL;
+    }
+    return hash;
+}
+
+bool VfsArchive::validate(const uint8_t *data, size_t size) {
+    if (size < sizeof(VfsArchiveHeader)) {
+        return false;
+    }
+    const VfsArchiveHeader& header = *reinterpret_cast<const VfsArchiveHeader *>(data);
+    if (!std::equal(std::begin(Magic), std::end(Magic), header.magic) || ByteOrder != header.byteOrder ||
+        Version != header.version || sizeof(VfsArchiveHeader) != header.headerSize ||
+        sizeof(VfsArchiveEntry) != header.entrySize || size != header.fileSize) {
+        return false;
+    }
+    if (0 != header.entriesOffset % alignof(VfsArchiveEntry) || header.entriesOffset < sizeof(VfsArchiveHeader) ||
+        static_cast<uint64_t>(header.entriesOffset) + static_cast<uint64_t>(header.entryCount) * sizeof(VfsArchiveEntry) > size ||
+        static_cast<uint64_t>(header.namesOffset) + header.namesSize > size) {
+        return false;
+    }
+    const VfsArchiveEntry *entries = reinterpret_cast<const VfsArchiveEntry *>(data + header.entriesOffset);
+    const char *names = reinterpret_cast<const char *>(data + header.namesOffset);
+    for (uint32_t i = 0; i < header.entryCount; ++i) {
+        const VfsArchiveEntry& entry = entries[i];
+        // Names must be in bounds, contents must be aligned and in bounds.
+        if (0 == entry.nameLength || static_cast<uint64_t>(entry.nameOffset) + entry.nameLength > header.namesSize ||
+            0 != entry.dataOffset % Alignment || entry.dataOffset > size || entry.storedSize > size - entry.dataOffset) {
+            return false;
+        }
+        if (static_cast<uint32_t>(Compression::Stored) != entry.compression || entry.storedSize != entry.size) {
+            return false;
+        }
+        // Names must be sorted and unique.
+        if (i > 0) {
+            const VfsArchiveEntry& previous = entries[i - 1];
+            const int result = std::memcmp(names + previous.nameOffset, names + entry.nameOffset,
+                                           std::min(previous.nameLength, entry.nameLength));
+            if (result > 0 || (0 == result && previous.nameLength >= entry.nameLength)) {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+std::shared_ptr<VfsArchive> VfsArchive::open(const std::string& pathname) {
+    std::shared_ptr<VfsArchive> archive(new VfsArchive());
+    if (!fs_mapFile(pathname, &archive->_mapping)) {
+        return nullptr;
+    }
+    archive->_pathname = pathname;
+    archive->_data = static_cast<const uint8_t *>(archive->_mapping.data);
+    archive->_size = archive->_mapping.size;
+    if (!validate(archive->_data, archive->_size)) {
+        Log::get() << Log::Entry::create(Log::Level::Warning, __FILE__, __LINE__, "archive ", "`", pathname, "`",
+                                         " is invalid or of a different version - ignoring it", Log::EndOfEntry);
+        return nullptr;
+    }
+    return archive;
+}
+
+bool VfsArchive::pack(const std::string& directory, const std::string& pathname) {
+    const std::vector<std::string> names = collectSorted(directory);
+
+    // The header is followed by the entries and the names.
+    VfsArchiveHeader header;
+    std::copy(std::begin(Magic), std::end(Magic), header.magic);
+    header.byteOrder = ByteOrder;
+    header.version = Version;
+    header.headerSize = sizeof(VfsArchiveHeader);
+    header.entrySize = sizeof(VfsArchiveEntry);
+    header.entryCount = static_cast<uint32_t>(names.size());
+    header.entriesOffset = sizeof(VfsArchiveHeader);
+    header.namesOffset = static_cast<uint32_t>(header.entriesOffset + names.size() * sizeof(VfsArchiveEntry));
+    header.namesSize = 0;
+    // Stamp the directory before reading it, a file modified while it is packed makes the archive stale.
+    header.sourceStamp = stamp(directory);
+    std::vector<VfsArchiveEntry> entries(names.size());
+    for (size_t i = 0; i < names.size(); ++i) {
+        entries[i].nameOffset = header.namesSize;
+        entries[i].nameLength = static_cast<uint32_t>(names[i].size());
+        header.namesSize += entries[i].nameLength;
+    }
+
+    std::ofstream file(pathname, std::ios::out | std::ios::binary | std::ios::trunc);
+    if (!file) {
+        Log::get() << Log::Entry::create(Log::Level::Error, __FILE__, __LINE__, "unable to open archive ", "`",
+                                         pathname, "`", " for writing", Log::EndOfEntry);
+        return false;
+    }
+
+    // Write the contents first, leaving room for the header, the entries and the names.
+    static const char zeroes[Alignment] = {};
+    uint64_t offset = align(header.namesOffset + header.namesSize);
+    for (uint64_t position = 0; position < offset; position += Alignment) {
+        file.write(zeroes, static_cast<std::streamsize>(std::min<uint64_t>(Alignment, offset - position)));
+    }
+    std::vector<char> contents;
+    for (size_t i = 0; i < names.size(); ++i) {
+        const std::string source = directory + SLASH_STR + str_convert_slash_sys(names[i]);
+        if (!readFile(source, contents)) {
+            Log::get() << Log::Entry::create(Log::Level::Error, __FILE__, __LINE__, "unable to read ", "`", source, "`",
+                                             Log::EndOfEntry);
+            return false;
+        }
+        VfsArchiveEntry& entry = entries[i];
+        entry.dataOffset = offset;
+        entry.size = contents.size();
+        entry.storedSize = contents.size();
+        entry.hash = hash(contents.data(), contents.size());
+        entry.compression = static_cast<uint32_t>(Compression::Stored);
+        entry.reserved = 0;
+        file.write(contents.data(), contents.size());
+        offset += contents.size();
+        // Pad to the alignment of the next file.
+        const uint64_t next = align(offset);
+        file.write(zeroes, static_cast<std::streamsize>(next - offset));
+        offset = next;
+    }
+    header.fileSize = offset;
+
+    file.seekp(0);
+    file.write(reinterpret_cast<const char *>(&header), sizeof(VfsArchiveHeader));
+    file.write(reinterpret_cast<const char *>(entries.data()), entries.size() * sizeof(VfsArchiveEntry));
+    for (const auto& name : names) {
+        file.write(name.data(), name.size());
+    }
+    file.close();
+    if (!file) {
+        Log::get() << Log::Entry::create(Log::Level::Error, __FILE__, __LINE__, "unable to write archive ", "`",
+                                         pathname, "`", Log::EndOfEntry);
+        return false;
+    }
+    return true;
+}
+
+int VfsArchive::compare(const VfsArchiveEntry& entry, const char *name, size_t length) const {
+    const char *entryName = reinterpret_cast<const char *>(_data + getHeader().namesOffset + entry.nameOffset);
+    const int result = std::memcmp(entryName, name, std::min<size_t>(entry.nameLength, length));
+    if (0 != result) {
+        return result;
+    }
+    return entry.nameLength < length ? -1 : (entry.nameLength > length ? 1 : 0);
+}
+
+const VfsArchiveEntry *VfsArchive::lowerBound(const std::string& name) const {
+    return std::lower_bound(getEntries(), getEntries() + getEntryCount(), name,
+                            [this](const VfsArchiveEntry& entry, const std::string& name) {
+        return compare(entry, name.data(), name.size()) < 0;
+    });
+}
+
+const VfsArchiveEntry *VfsArchive::find(const std::string& name) const {
+    const VfsArchiveEntry *entry = lowerBound(name);
+    if (entry == getEntries() + getEntryCount() || 0 != compare(*entry, name.data(), name.size())) {
+        return nullptr;
+    }
+    return entry;
+}
+
+bool VfsArchive::isDirectory(const std::string& name) const {
+    if (name.empty()) {
+        return true;
+    }
+    // The first name not less than the prefix starts with the prefix if any name does.
+    const std::string prefix = name + "/";
+    const VfsArchiveEntry *entry = lowerBound(prefix);
+    return entry != getEntries() + getEntryCount() && entry->nameLength > prefix.size() &&
+           0 == getName(*entry).compare(0, prefix.size(), prefix);
+}
+
+std::vector<std::string> VfsArchive::enumerate(const std::string& name) const {
+    std::vector<std::string> children;
+    const std::string prefix = name.empty() ? std::string() : name + "/";
+    // The names with the prefix are consecutive, so are the names of the files in a subdirectory.
+    for (const VfsArchiveEntry *entry = lowerBound(prefix), *end = getEntries() + getEntryCount(); entry != end; ++entry) {
+        const std::string entryName = getName(*entry);
+        if (0 != entryName.compare(0, prefix.size(), prefix)) {
+            break;
+        }
+        std::string child = entryName.substr(prefix.size(), entryName.find('/', prefix.size()) - prefix.size());
+        if (children.empty() || children.back() != child) {
+            children.push_back(std::move(child));
+        }
+    }
+    return children;
+}
+
+bool VfsArchive::verify() const {
+    for (const VfsArchiveEntry *entry = getEntries(), *end = getEntries() + getEntryCount(); entry != end; ++entry) {
+        if (entry->hash != hash(getData(*entry), static_cast<size_t>(entry->size))) {
+            return false;
+        }
+    }
+    return true;
+}
+
+std::string VfsArchive::getName(const VfsArchiveEntry& entry) const {
+    return std::string(reinterpret_cast<const char *>(_data + getHeader().namesOffset + entry.nameOffset), entry.nameLength);
+}
+
+} // namespace Ego
@@ -0,0 +1,216 @@
+//********************************************************************************************
+//*
+//*    This file is part of Egoboo.
+//*
+//*    Egoboo is free software: you can redistribute it and/or modify it
+//*    under the terms of the GNU General Public License as published by
+//*    the Free Software Foundation, either version 3 of the License, or
+//*    (at your option) any later version.
+//*
+//*    Egoboo is distributed in the hope that it will be useful, but
+//*    WITHOUT ANY WARRANTY; without even the implied warranty of
+//*    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+//*    General Public License for more details.
+//*
+//*    You should have received a copy of the GNU General Public License
+//*    along with Egoboo.  If not, see <http://www.gnu.org/licenses/>.
+//*
+//********************************************************************************************
+
+/// @file   egolib/VFS/VfsArchive.hpp
+/// @brief  An indexed archive of the files of a directory which is mounted into the VFS in place.
+
+#pragma once
+
+#include "egolib/file_common.h"
+
+namespace Ego {
+
+/**
+ * @brief
+ *  The header of an archive file.
+ * @remark
+ *  All values are little-endian. Offsets are relative to the beginning of the file.
+ */
+struct VfsArchiveHeader {
+    char magic[8];              ///< VfsArchive::Magic
+    uint32_t byteOrder;         ///< VfsArchive::ByteOrder, used to reject files of a foreign byte order
+    uint32_t version;           ///< VfsArchive::Version
+    uint32_t headerSize;        ///< <tt>sizeof(VfsArchiveHeader)</tt>
+    uint32_t entrySize;         ///< <tt>sizeof(VfsArchiveEntry)</tt>
+    uint32_t entryCount;        ///< the number of entries
+    uint32_t entriesOffset;     ///< the offset of the entries, @a entryCount times VfsArchiveEntry
+    uint32_t namesOffset;       ///< the offset of the names of the entries
+    uint32_t namesSize;         ///< the size, in Bytes, of the names of the entries
+    uint64_t fileSize;          ///< the size, in Bytes, of the file
+    uint64_t sourceStamp;       ///< the stamp of the archived directory, see VfsArchive::stamp
+};
+
+/**
+ * @brief
+ *  The entry of a file in an archive file.
+ * @remark
+ *  The entries are sorted by the Bytes of their names. A name is the pathname of the file relative to the archived
+ *  directory using slashes as separators e.g. <tt>objects/sword.obj/data.txt</tt>. Names are not zero-terminated.
+ */
+struct VfsArchiveEntry {
+    uint64_t dataOffset;        ///< the offset of the contents, aligned to VfsArchive::Alignment Bytes
+    uint64_t size;              ///< the size, in Bytes, of the contents
+    uint64_t storedSize;        ///< the size, in Bytes, of the contents as stored in the archive
+    uint64_t hash;              ///< the 64-bit FNV-1a hash of the contents
+    uint32_t nameOffset;        ///< the offset of the name relative to VfsArchiveHeader::namesOffset
+    uint32_t nameLength;        ///< the length, in Bytes, of the name
+    uint32_t compression;       ///< the VfsArchive::Compression of the contents
+    uint32_t reserved;
+};
+
+/**
+ * @brief
+ *  An archive of the files of a directory e.g. of a module. The entries are sorted such that a file is found by a
+ *  binary search and the contents of the files are aligned to pages such that they can be used in place.
+ * @remark
+ *  An archive is memory-mapped copy-on-write. The contents of its files are not copied when they are read.
+ */
+class VfsArchive : private id::non_copyable {
+public:
+    static const char Magic[8];
+    static constexpr uint32_t ByteOrder = 0x01020304;
+    static constexpr uint32_t Version = 2;
+    static constexpr uint32_t Alignment = 4096;
+
+    /// @brief The compression of the contents of a file.
+    enum class Compression : uint32_t {
+        /// The contents are stored as they are.
+        Stored = 0,
+    };
+
+    ~VfsArchive();
+
+    /**
+     * @brief
+     *  Open an archive.
+     * @param pathname
+     *  the pathname of the file in the native file system
+     * @return
+     *  the archive on success, a null pointer if the file does not exist or is invalid
+     */
+    static std::shared_ptr<VfsArchive> open(const std::string& pathname);
+
+    /**
+     * @brief
+     *  Archive the files of a directory, recursively. Files and directories starting with a <tt>.</tt> are ignored.
+     * @param directory
+     *  the pathname of the directory in the native file system
+     * @param pathname
+     *  the pathname of the archive file in the native file system
+     * @return
+     *  @a true on success, @a false on failure
+     */
+    static bool pack(const std::string& directory, const std::string& pathname);
+
+    /**
+     * @brief
+     *  Compute the stamp of a directory.
+     * @param directory
+     *  the pathname of the directory in the native file system
+     * @return
+     *  the 64-bit FNV-1a hash of the names, sizes and modification times of the files the directory would be
+     *  archived with by VfsArchive::pack
+     * @remark
+     *  Computing the stamp does not read the contents of the files.
+     */
+    static uint64_t stamp(const std::string& directory);
+
+    /**
+     * @brief
+     *  Get if this archive is out of date i.e. if the directory it was packed from has changed since.
+     * @param directory
+     *  the pathname of the directory in the native file system
+     * @return
+     *  @a true if the stamp of the directory differs from the stamp stored in this archive, @a false otherwise
+     */
+    bool isStale(const std::string& directory) const {
+        return stamp(directory) != getHeader().sourceStamp;
+    }
+
+    /**
+     * @brief
+     *  Compute the hash of the contents of a file.
+     * @return
+     *  the 64-bit FNV-1a hash of the contents
+     */
+    static uint64_t hash(const char *data, size_t size);
+
+    /**
+     * @brief
+     *  Find the entry of a file.
+     * @param name
+     *  the name of the file
+     * @return
+     *  the entry if the file exists, a null pointer otherwise
+     */
+    const VfsArchiveEntry *find(const std::string& name) const;
+
+    /**
+     * @brief
+     *  Get if a name denotes a directory i.e. if it is the prefix of the name of a file, up to a slash.
+     * @remark
+     *  The empty name denotes the archived directory itself.
+     */
+    bool isDirectory(const std::string& name) const;
+
+    /**
+     * @brief
+     *  Get the names of the files and directories in a directory.
+     * @param name
+     *  the name of the directory
+     * @return
+     *  the names of the files and directories, relative to the directory
+     */
+    std::vector<std::string> enumerate(const std::string& name) const;
+
+    /**
+     * @brief
+     *  Verify the hashes of the contents of all files.
+     * @return
+     *  @a true if the contents of all files match their hashes, @a false otherwise
+     */
+    bool verify() const;
+
+    /// Get the name of a file.
+    std::string getName(const VfsArchiveEntry& entry) const;
+
+    /// Get the contents of a file.
+    const char *getData(const VfsArchiveEntry& entry) const {
+        return reinterpret_cast<const char *>(_data + entry.dataOffset);
+    }
+
+    /// Get the pathname of the archive file in the native file system.
+    const std::string& getPathname() const { return _pathname; }
+
+    size_t getEntryCount() const { return getHeader().entryCount; }
+    const VfsArchiveEntry *getEntries() const {
+        return reinterpret_cast<const VfsArchiveEntry *>(_data + getHeader().entriesOffset);
+    }
+
+private:
+    VfsArchive();
+
+    const VfsArchiveHeader& getHeader() const { return *reinterpret_cast<const VfsArchiveHeader *>(_data); }
+
+    /// Get the first entry with a name not less than a name.
+    const VfsArchiveEntry *lowerBound(const std::string& name) const;
+
+    /// Compare the name of an entry with a name, Byte by Byte.
+    int compare(const VfsArchiveEntry& entry, const char *name, size_t length) const;
+
+    /// Get if the image is a valid archive.
+    static bool validate(const uint8_t *data, size_t size);
+
+    std::string _pathname;      ///< the pathname of the archive file
+    const uint8_t *_data;       ///< the image
+    size_t _size;               ///< the size, in Bytes, of the image
+    fs_mapping_t _mapping;      ///< the mapping of the image
+};
+
+} // namespace Ego
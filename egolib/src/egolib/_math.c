@@ -46,8 +46,8 @@ const Facing Facing::FACE_SOUTH = Facing(0xC000);
     void getadd_flt( const float min, const float value, const float max, float* valuetoadd );
 
 // random functions
-    int generate_irand_pair( const IPair num );
-    int generate_irand_range( const Ego::Math::Interval<float> num );
+    int generate_irand_pair( const IPair num, RandomStream& stream );
+    int generate_irand_range( const Ego::Math::Interval<float> num, RandomStream& stream );
 
 // matrix functions
 
@@ -124,13 +124,13 @@ void getadd_flt( const float min, const float value, const float max, float* val
 //--------------------------------------------------------------------------------------------
 // RANDOM FUNCTIONS
 //--------------------------------------------------------------------------------------------
-int generate_irand_pair( const IPair num )
+int generate_irand_pair( const IPair num, RandomStream& stream )
 {
     /// @author ZZ
     /// @details This function generates a random number
 
     int tmp;
-    int irand = Random::next(std::numeric_limits<uint16_t>::max());
+    int irand = stream.next(std::numeric_limits<uint16_t>::max());
 
     tmp = num.base;
     if ( num.rand > 1 )
@@ -142,12 +142,12 @@ int generate_irand_pair( const IPair num )
 }
 
 //--------------------------------------------------------------------------------------------
-int generate_irand_range( const Ego::Math::Interval<float> num )
+int generate_irand_range( const Ego::Math::Interval<float> num, RandomStream& stream )
 {
     /// @author ZZ
     /// @details This function generates a random number
 
     IPair loc_pair = range_to_pair(num);
 
-    return generate_irand_pair( loc_pair );
+    return generate_irand_pair( loc_pair, stream );
 }
@@ -343,8 +343,8 @@ extern "C"
     void getadd_flt( const float min, const float value, const float max, float* valuetoadd );
 
 // random functions
-    int generate_irand_pair( const IPair num );
-    int generate_irand_range( const Ego::Math::Interval<float> num );
+    int generate_irand_pair( const IPair num, RandomStream& stream );
+    int generate_irand_range( const Ego::Math::Interval<float> num, RandomStream& stream );
 
 //--------------------------------------------------------------------------------------------
 
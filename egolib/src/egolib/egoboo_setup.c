@@ -24,6 +24,7 @@
 #include "egolib/egoboo_setup.h"
 
 #include "egolib/_math.h"
+#include "egolib/VFS/VfsArchive.hpp"
 #include "game/Graphics/Camera.hpp"
 
 //--------------------------------------------------------------------------------------------
@@ -107,6 +108,8 @@ egoboo_config_t::egoboo_config_t() :
     "Smaller values yield faster response time, but can lead to underflow if the audio buffer is not filled in time"),
     sound_highQuality_enable(false,"sound.highQuality.enable","enable/disable high quality sound"),
     sound_footfallEffects_enable(true,"sound.footfallEffects.enable","enable/disable footfall effects"),
+    sound_decodedBudget_megabytes(64, "sound.decodedBudget.megabytes", "upper bound of decoded sound effect data kept in memory, in megabytes.\n"
+    "Sounds are decoded when played first, the least recently used sounds are released if this bound is exceeded"),
     // Network configuration section.
     network_enable(false,"network.enable","enable/disable networking"),
     network_lagTolerance(10,"network.lagTolerance","tolerance of lag in seconds"),
@@ -311,11 +314,30 @@ bool setup_init_module_vfs_paths(const char *mod_path)
 
     //==== set the module-dependent mount points
 
+    // a packed module "/modules/*.mod.pack" replaces the global module directory unless it is out of date
+    const std::string moduleDirectory = fs_getDataDirectory() + SLASH_STR "modules" SLASH_STR + mod_dir_string;
+    const std::string packPathname = moduleDirectory + ".pack";
+    bool packed = fs_fileExists(packPathname) > 0;
+    if ( packed )
+    {
+        // a pack shipped without its module directory can not be out of date
+        auto archive = Ego::VfsArchive::open( packPathname );
+        if ( !archive || ( fs_fileIsDirectory( moduleDirectory ) && archive->isStale( moduleDirectory ) ) )
+        {
+            Log::get() << Log::Entry::create(Log::Level::Info, __FILE__, __LINE__, "packed module ", "`", packPathname, "`",
+                                             " is invalid or out of date - using ", "`", moduleDirectory, "`", Log::EndOfEntry);
+            packed = false;
+        }
+    }
+
     //---- add the "/modules/*.mod/objects" directories to mp_objects
     snprintf( tmpDir, SDL_arraysize( tmpDir ), "modules" SLASH_STR "%s" SLASH_STR "objects", mod_dir_string );
 
     // mount the user's module objects directory at the beginning of the mount point list
-    vfs_add_mount_point( fs_getDataDirectory(), Ego::FsPath(tmpDir), Ego::VfsPath("mp_objects"), 1 );
+    if ( !packed || !vfs_add_archive_mount_point( packPathname, "objects", Ego::VfsPath("mp_objects") ) )
+    {
+        vfs_add_mount_point( fs_getDataDirectory(), Ego::FsPath(tmpDir), Ego::VfsPath("mp_objects"), 1 );
+    }
 
     // mount the global module objects directory next in the mount point list
     vfs_add_mount_point( fs_getUserDirectory(), Ego::FsPath(tmpDir), Ego::VfsPath("mp_objects"), 1 );
@@ -344,7 +366,10 @@ bool setup_init_module_vfs_paths(const char *mod_path)
     vfs_add_mount_point( fs_getUserDirectory(), Ego::FsPath(tmpDir), Ego::VfsPath("mp_data"), 1 );
 
     // append the global module gamedat directory
-    vfs_add_mount_point( fs_getDataDirectory(), Ego::FsPath(tmpDir), Ego::VfsPath("mp_data"), 1 );
+    if ( !packed || !vfs_add_archive_mount_point( packPathname, "gamedat", Ego::VfsPath("mp_data") ) )
+    {
+        vfs_add_mount_point( fs_getDataDirectory(), Ego::FsPath(tmpDir), Ego::VfsPath("mp_data"), 1 );
+    }
 
     // put the global globalparticles data after the module gamedat data
     vfs_add_mount_point( fs_getDataDirectory(), Ego::FsPath("basicdat" SLASH_STR "globalparticles"), Ego::VfsPath("mp_data"), 1 );
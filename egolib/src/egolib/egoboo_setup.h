@@ -100,6 +100,7 @@ protected:
                 config.sound_outputBuffer_size,
                 config.sound_highQuality_enable,
                 config.sound_footfallEffects_enable,
+                config.sound_decodedBudget_megabytes,
                 //
                 config.network_enable,
                 config.network_lagTolerance,
@@ -348,6 +349,10 @@ public:
     /// @brief Enable/disable footfall effects.
     Ego::Configuration::Variable<bool> sound_footfallEffects_enable;
 
+    /// @brief Upper bound of decoded sound effect data kept in memory, in megabytes.
+    /// @remark Default value is @a 64.
+    Ego::Configuration::Variable<uint16_t> sound_decodedBudget_megabytes;
+
     // Network configuration section.
 
     /// @brief Enable/disable network?
@@ -74,6 +74,16 @@ typedef struct fs_find_context_t
     fs_find_ptr_t  ptr;
 } fs_find_context_t;
 
+//--------------------------------------------------------------------------------------------
+
+/// A view of a file mapped into memory.
+struct fs_mapping_t
+{
+    void  *data;   ///< the first byte of the view or a null pointer if nothing is mapped
+    size_t size;   ///< the size, in Bytes, of the view
+    void  *handle; ///< a platform-specific handle of the mapping
+};
+
 //--------------------------------------------------------------------------------------------
 // GLOBAL FUNCTION PROTOTYPES
 //--------------------------------------------------------------------------------------------
@@ -172,6 +182,44 @@ void fs_removeDirectoryAndContents(const char *pathname, int recursive);
  */
 void fs_copyDirectory(const char *source, const char *target);
 
+/**
+ * @brief
+ *  Map a file into memory.
+ * @param pathname
+ *  the pathname of the file
+ * @param mapping
+ *  a pointer to the mapping receiving the view
+ * @return
+ *  @a true on success, @a false on failure
+ * @remark
+ *  The view is readable and writeable. Writes are private to the process (copy-on-write)
+ *  and are never written back to the file. Empty files can not be mapped.
+ */
+bool fs_mapFile(const std::string& pathname, fs_mapping_t *mapping);
+/**
+ * @brief
+ *  Unmap a file mapped by fs_mapFile.
+ * @param mapping
+ *  the mapping
+ * @post
+ *  The mapping is empty.
+ */
+void fs_unmapFile(fs_mapping_t *mapping);
+
+/**
+ * @brief
+ *  Get the size and the time of the last modification of a file.
+ * @param pathname
+ *  the pathname of the file
+ * @param size
+ *  a pointer to a variable receiving the size, in Bytes, of the file
+ * @param modificationTime
+ *  a pointer to a variable receiving the time of the last modification in platform-specific units
+ * @return
+ *  @a true on success, @a false if the file does not exist or is not a regular file
+ */
+bool fs_getFileInfo(const std::string& pathname, uint64_t *size, int64_t *modificationTime);
+
 /**
  * @brief
  *  Begin a search.
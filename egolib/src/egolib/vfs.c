@@ -32,6 +32,8 @@
 #include "egolib/endian.h"
 #include "egolib/fileutil.h"
 #include "egolib/Core/StringUtilities.hpp"
+#include "egolib/VFS/VfsArchive.hpp"
+#include "egolib/Core/LruCache.hpp"
 
 //--------------------------------------------------------------------------------------------
 //--------------------------------------------------------------------------------------------
@@ -87,14 +89,25 @@ typedef enum vfs_file_type
     VFS_FILE_TYPE_UNKNOWN = 0,
     VFS_FILE_TYPE_CSTDIO,
     VFS_FILE_TYPE_PHYSFS,
+    VFS_FILE_TYPE_ARCHIVE,
 } vfs_file_type;
 
+/// A file in a mounted archive opened for reading.
+struct vfs_archive_file_t
+{
+    std::shared_ptr<Ego::VfsArchive> archive; ///< keeps the archive mapped while the file is open
+    const char *data;                         ///< the contents of the file
+    size_t size;                              ///< the size, in Bytes, of the contents of the file
+    size_t position;                          ///< the read position
+};
+
 /// An anonymized pointer type
 typedef union vfs_fileptr_t
 {
     void *u;
     FILE *c;
     PHYSFS_File *p;
+    vfs_archive_file_t *a;
 } vfs_file_ptr_t;
 
 /// A container holding either a FILE * or a PHYSFS_File *, and translated error states
@@ -111,39 +124,92 @@ struct s_vfs_path_data
     std::string full_path;
     std::string root_path;
     std::string relative_path;
+    int64_t order; ///< the position in the search order, see _vfs_mount_order
 
     s_vfs_path_data()
         : mount(),
           full_path(),
           root_path(),
-          relative_path() {}
+          relative_path(),
+          order(0) {}
 
     s_vfs_path_data(const s_vfs_path_data& other)
         : mount(other.mount),
           full_path(other.full_path),
           root_path(other.root_path),
-          relative_path(other.relative_path) {}
+          relative_path(other.relative_path),
+          order(other.order) {}
     
     s_vfs_path_data& operator=(const s_vfs_path_data& other) {
         mount = other.mount;
         full_path = other.full_path;
         root_path = other.root_path;
         relative_path = other.relative_path;
+        order = other.order;
         return *this;
     }
 };
 
+/// A directory of an archive mounted at a mount point.
+struct vfs_archive_mount_t
+{
+    std::string mount;                        ///< the mount point without leading slashes e.g. <tt>mp_objects</tt>
+    std::string directory;                    ///< the name of the directory in the archive e.g. <tt>objects</tt>
+    std::shared_ptr<Ego::VfsArchive> archive; ///< the archive
+    int64_t order;                            ///< the position in the search order, see _vfs_mount_order
+};
+
+/// The cached metadata of a pathname. A value of @a -1 denotes an unknown value.
+struct vfs_metadata_t
+{
+    int exists;      ///< @a 1 if the pathname denotes a file or directory, @a 0 if not
+    int isDirectory; ///< @a 1 if the pathname denotes a directory, @a 0 if not
+};
+
+/**
+ * @brief
+ *  Caches the results of the queries which search all mount points.
+ * @remark
+ *  The cache is cleared whenever the mount points change or the write directory is modified through the VFS.
+ *  Results computed while the cache was cleared are discarded, see vfs_cache_t::generation.
+ */
+struct vfs_cache_t
+{
+    std::mutex mutex;
+    /// Incremented whenever the cache is cleared.
+    uint64_t generation;
+    /// Maps pathnames as returned by Ego::VfsPath::string to their metadata.
+    Ego::Core::LruCache<std::string, vfs_metadata_t> metadata;
+    /// Maps pathnames as passed to vfs_resolveReadFilename to their resolved pathnames.
+    Ego::Core::LruCache<std::string, std::pair<bool, std::string>> resolved;
+    /// Maps pathnames of directories, as passed to SearchContext::enumerateFiles, to their contents.
+    Ego::Core::LruCache<std::string, std::vector<std::string>> listings;
+
+    vfs_cache_t()
+        : mutex(),
+          generation(0),
+          metadata(16384),
+          resolved(4096),
+          listings(1024) {}
+};
+
 //--------------------------------------------------------------------------------------------
 //--------------------------------------------------------------------------------------------
 
 static std::vector<vfs_path_data_t> _vfs_mount_infos;
+/// The mounted archives in search order.
+static std::vector<vfs_archive_mount_t> _vfs_archive_mounts;
+/// Directories and archives are searched in the order they were mounted in, as PhysFS does: a directory
+/// appended to the search path gets a position after, a directory prepended a position before all others.
+/// Directories of the PhysFS search path not mounted by vfs_add_mount_point come after the archives.
+static struct { int64_t front, back; } _vfs_mount_order = { 0, 0 };
+static vfs_cache_t _vfs_cache;
 static bool _vfs_atexit_registered = false;
 static bool _vfs_initialized = false;
 
 //--------------------------------------------------------------------------------------------
 //--------------------------------------------------------------------------------------------
 
-static void _vfs_exit();
 static int _vfs_ensure_write_directory(const std::string& filename, bool is_directory);
 
 
@@ -158,6 +224,15 @@ static int _vfs_mount_info_search(const std::string& pathname);
 
 static int fake_physfs_vprintf(PHYSFS_File *file, const char *format, va_list args);
 
+static std::pair<bool, std::string> _vfs_archive_name(const vfs_archive_mount_t& mount, const std::string& pathname);
+static const Ego::VfsArchiveEntry *_vfs_archive_find(const std::string& pathname, std::shared_ptr<Ego::VfsArchive>& archive);
+static bool _vfs_archive_isShadowed(const vfs_archive_mount_t& mount, const std::string& name);
+static bool _vfs_archive_isDirectory(const std::string& pathname);
+static size_t _vfs_archive_read(vfs_FILE *file, void *buffer, size_t length);
+
+static std::pair<bool, std::string> _vfs_resolveReadFilename(const std::string& filename);
+static vfs_metadata_t _vfs_metadata(const std::string& pathname, bool isDirectory);
+
 //--------------------------------------------------------------------------------------------
 //--------------------------------------------------------------------------------------------
 int vfs_init(const char *argv0, const char *root_dir)
@@ -221,7 +296,7 @@ int vfs_init(const char *argv0, const char *root_dir)
 
     if (!_vfs_atexit_registered)
     {
-        atexit(_vfs_exit); /// @todo Error handling?
+        atexit(vfs_exit); /// @todo Error handling?
         _vfs_atexit_registered = true;
     }
 
@@ -230,9 +305,18 @@ int vfs_init(const char *argv0, const char *root_dir)
 }
 
 //--------------------------------------------------------------------------------------------
-void _vfs_exit()
+void vfs_exit()
 {
+    if (!_vfs_initialized)
+    {
+        return;
+    }
+    _vfs_mount_infos.clear();
+    _vfs_archive_mounts.clear();
+    _vfs_mount_order = { 0, 0 };
+    vfs_invalidateCache();
     PHYSFS_deinit();
+    _vfs_initialized = false;
 }
 
 //--------------------------------------------------------------------------------------------
@@ -274,6 +358,24 @@ vfs_FILE *vfs_openRead(const std::string& pathname)
         return nullptr;
     }
 
+    // Open the file from a mounted archive unless a directory mounted before the archive contains it.
+    std::shared_ptr<Ego::VfsArchive> archive;
+    const Ego::VfsArchiveEntry *entry = _vfs_archive_find(temporary, archive);
+    if (entry)
+    {
+        vfs_FILE *vfs_file = nullptr;
+        try {
+            vfs_file = new vfs_FILE();
+            vfs_file->ptr.a = new vfs_archive_file_t{archive, archive->getData(*entry), static_cast<size_t>(entry->size), 0};
+        } catch (...) {
+            delete vfs_file;
+            return nullptr;
+        }
+        vfs_file->flags = VFS_FILE_FLAG_READING;
+        vfs_file->type = VFS_FILE_TYPE_ARCHIVE;
+        return vfs_file;
+    }
+
     PHYSFS_File *ftmp = PHYSFS_openRead(temporary.c_str());
     if (!ftmp)
     {
@@ -315,6 +417,7 @@ vfs_FILE *vfs_openWrite(const std::string& pathname)
 
     // Open the PhysFS file.
     PHYSFS_File *ftmp = PHYSFS_openWrite(temporary.c_str());
+    vfs_invalidateCache();
     if (!ftmp)
     {
     #if defined(_DEBUG) && defined(_VFS_DEBUG)
@@ -348,6 +451,7 @@ vfs_FILE *vfs_openAppend(const std::string& pathname)
     }
 
     PHYSFS_File *ftmp = PHYSFS_openAppend(temporary.c_str());
+    vfs_invalidateCache();
     if (!ftmp)
     {
     #if defined(_DEBUG) && defined(_VFS_DEBUG)
@@ -410,6 +514,27 @@ std::pair<bool, std::string> vfs_resolveReadFilename( const std::string& filenam
 {
     BAIL_IF_NOT_INIT();
 
+    uint64_t generation;
+    {
+        std::lock_guard<std::mutex> lock(_vfs_cache.mutex);
+        auto *resolved = _vfs_cache.resolved.find(filename);
+        if (resolved) {
+            return *resolved;
+        }
+        generation = _vfs_cache.generation;
+    }
+    auto resolved = _vfs_resolveReadFilename(filename);
+    {
+        std::lock_guard<std::mutex> lock(_vfs_cache.mutex);
+        if (generation == _vfs_cache.generation) {
+            _vfs_cache.resolved.insert(filename, resolved);
+        }
+    }
+    return resolved;
+}
+
+std::pair<bool, std::string> _vfs_resolveReadFilename( const std::string& filename )
+{
     if (filename.empty()) {
         std::make_pair(false, filename);
     }
@@ -426,6 +551,12 @@ std::pair<bool, std::string> vfs_resolveReadFilename( const std::string& filenam
     // Convert the filename in PhysFS-specific notation.
     filename_specific = vfs_convert_fname(Ego::VfsPath(filename_specific)).string();
 
+    // Files and directories in mounted archives are not in the native file system.
+    std::shared_ptr<Ego::VfsArchive> archive;
+    if (_vfs_archive_find(filename_specific, archive) || _vfs_archive_isDirectory(filename_specific)) {
+        return std::make_pair(false, filename);
+    }
+
     // If the specified filename denotes an existing file or directory, then this file or directory must have a containing directory.
     const char *prefix = PHYSFS_getRealDir(filename_specific.c_str());
     if (nullptr == prefix) {
@@ -553,6 +684,11 @@ int vfs_close(vfs_FILE *file)
         retval = PHYSFS_close(file->ptr.p);
 		delete file;
     }
+    else if (VFS_FILE_TYPE_ARCHIVE == file->type)
+    {
+        delete file->ptr.a;
+        delete file;
+    }
     else
     {
         // corrupted data?
@@ -609,6 +745,10 @@ int vfs_eof( vfs_FILE * pfile )
     {
         retval = PHYSFS_eof( pfile->ptr.p );
     }
+    else if ( VFS_FILE_TYPE_ARCHIVE == pfile->type )
+    {
+        retval = pfile->ptr.a->position >= pfile->ptr.a->size;
+    }
 
     if ( 0 != retval )
     {
@@ -632,7 +772,7 @@ int vfs_error( vfs_FILE * pfile )
     {
         retval = ferror( pfile->ptr.c );
     }
-    else if ( VFS_FILE_TYPE_PHYSFS == pfile->type )
+    else if ( VFS_FILE_TYPE_PHYSFS == pfile->type || VFS_FILE_TYPE_ARCHIVE == pfile->type )
     {
         retval = VFS_FILE_FLAG_ERROR == (pfile->flags & VFS_FILE_FLAG_ERROR);
         //retval = ( NULL != PHYSFS_getLastError() );
@@ -659,6 +799,10 @@ long vfs_tell( vfs_FILE * pfile )
     {
         retval = PHYSFS_tell( pfile->ptr.p );
     }
+    else if ( VFS_FILE_TYPE_ARCHIVE == pfile->type )
+    {
+        retval = static_cast<long>( pfile->ptr.a->position );
+    }
 
     return retval;
 }
@@ -690,6 +834,21 @@ int vfs_seek( vfs_FILE * pfile, long offset )
         if (retval == 0) pfile->flags &= ~VFS_FILE_FLAG_ERROR;
         else             pfile->flags |= VFS_FILE_FLAG_ERROR;
     }
+    else if ( VFS_FILE_TYPE_ARCHIVE == pfile->type )
+    {
+        // reset the flags
+        pfile->flags &= ~(VFS_FILE_FLAG_EOF | VFS_FILE_FLAG_ERROR);
+
+        if ( offset < 0 || static_cast<size_t>( offset ) > pfile->ptr.a->size )
+        {
+            pfile->flags |= VFS_FILE_FLAG_ERROR;
+            retval = -1;
+        }
+        else
+        {
+            pfile->ptr.a->position = static_cast<size_t>( offset );
+        }
+    }
 
     if ( 0 != offset )
     {
@@ -725,6 +884,10 @@ long vfs_fileLength( vfs_FILE * pfile )
     {
         retval = PHYSFS_fileLength( pfile->ptr.p );
     }
+    else if ( VFS_FILE_TYPE_ARCHIVE == pfile->type )
+    {
+        retval = static_cast<long>( pfile->ptr.a->size );
+    }
 
     return retval;
 }
@@ -734,7 +897,9 @@ long vfs_fileLength( vfs_FILE * pfile )
 bool vfs_mkdir(const std::string& pathname) {
     BAIL_IF_NOT_INIT();
     std::string temporary = Ego::VfsPath(pathname).string();
-    if (!PHYSFS_mkdir(temporary.c_str())) {
+    const int result = PHYSFS_mkdir(temporary.c_str());
+    vfs_invalidateCache();
+    if (!result) {
         Log::get() << Log::Entry::create(Log::Level::Debug, __FILE__, __LINE__, "PHYSF_mkdir(", pathname, ") failed: ", vfs_getError());
         return false;
     }
@@ -747,7 +912,9 @@ bool vfs_delete_file(const std::string& pathname)
 
     std::string temporary = Ego::VfsPath(pathname).string();
 
-    if (!PHYSFS_delete(temporary.c_str())) {
+    const int result = PHYSFS_delete(temporary.c_str());
+    vfs_invalidateCache();
+    if (!result) {
         Log::get() << Log::Entry::create(Log::Level::Debug, __FILE__, __LINE__, "PHYSF_delete(", pathname, ") failed: ", vfs_getError(), Log::EndOfEntry);
         return false;
     }
@@ -756,14 +923,62 @@ bool vfs_delete_file(const std::string& pathname)
 
 bool vfs_exists(const std::string& pathname) {
     BAIL_IF_NOT_INIT();
-    std::string temporary = Ego::VfsPath(pathname).string();
-    return (0 != PHYSFS_exists(temporary.c_str()));
+    return 1 == _vfs_metadata(Ego::VfsPath(pathname).string(), false).exists;
 }
 
 bool vfs_isDirectory(const std::string& pathname) {
     BAIL_IF_NOT_INIT();
-    std::string temporary = Ego::VfsPath(pathname).string();
-    return 0 != PHYSFS_isDirectory(temporary.c_str());
+    return 1 == _vfs_metadata(Ego::VfsPath(pathname).string(), true).isDirectory;
+}
+
+/// @brief Get the metadata of a pathname, from the cache if possible.
+/// @param pathname the pathname as returned by Ego::VfsPath::string
+/// @param isDirectory if @a true, vfs_metadata_t::isDirectory is known, otherwise vfs_metadata_t::exists is known
+vfs_metadata_t _vfs_metadata(const std::string& pathname, bool isDirectory) {
+    vfs_metadata_t metadata = {-1, -1};
+    uint64_t generation;
+    {
+        std::lock_guard<std::mutex> lock(_vfs_cache.mutex);
+        auto *cached = _vfs_cache.metadata.find(pathname);
+        if (cached) {
+            metadata = *cached;
+            if (-1 != (isDirectory ? metadata.isDirectory : metadata.exists)) {
+                return metadata;
+            }
+        }
+        generation = _vfs_cache.generation;
+    }
+    // Check the mounted archives and the PhysFS search path.
+    std::shared_ptr<Ego::VfsArchive> archive;
+    if (isDirectory) {
+        metadata.isDirectory = (_vfs_archive_isDirectory(pathname) || 0 != PHYSFS_isDirectory(pathname.c_str())) ? 1 : 0;
+        // A directory exists.
+        if (1 == metadata.isDirectory) {
+            metadata.exists = 1;
+        }
+    } else {
+        metadata.exists = (_vfs_archive_find(pathname, archive) || _vfs_archive_isDirectory(pathname) ||
+                           0 != PHYSFS_exists(pathname.c_str())) ? 1 : 0;
+        // Something which does not exist is not a directory.
+        if (0 == metadata.exists) {
+            metadata.isDirectory = 0;
+        }
+    }
+    {
+        std::lock_guard<std::mutex> lock(_vfs_cache.mutex);
+        if (generation == _vfs_cache.generation) {
+            _vfs_cache.metadata.insert(pathname, metadata);
+        }
+    }
+    return metadata;
+}
+
+void vfs_invalidateCache() {
+    std::lock_guard<std::mutex> lock(_vfs_cache.mutex);
+    _vfs_cache.generation++;
+    _vfs_cache.metadata.clear();
+    _vfs_cache.resolved.clear();
+    _vfs_cache.listings.clear();
 }
 
 //--------------------------------------------------------------------------------------------
@@ -792,6 +1007,11 @@ size_t vfs_read( void * buffer, size_t size, size_t count, vfs_FILE * pfile )
 
         if ( !error ) read_length = retval;
     }
+    else if ( VFS_FILE_TYPE_ARCHIVE == pfile->type )
+    {
+        pfile->flags &= ~VFS_FILE_FLAG_ERROR;
+        if ( 0 != size ) read_length = _vfs_archive_read( pfile, buffer, size * count ) / size;
+    }
 
     if ( error ) _vfs_translate_error( pfile );
 
@@ -822,6 +1042,11 @@ size_t vfs_write( const void * buffer, size_t size, size_t count, vfs_FILE * pfi
         
         if ( !error ) retval = write_length;
     }
+    else if ( VFS_FILE_TYPE_ARCHIVE == pfile->type )
+    {
+        // mounted archives are read-only
+        pfile->flags |= VFS_FILE_FLAG_ERROR;
+    }
     
     if ( error ) _vfs_translate_error( pfile );
 
@@ -852,6 +1077,15 @@ int vfs_read_Sint8( vfs_FILE& file, int8_t * val )
         if (error) file.flags |= VFS_FILE_FLAG_ERROR;
         else       file.flags &= ~VFS_FILE_FLAG_ERROR;
     }
+    else if ( VFS_FILE_TYPE_ARCHIVE == file.type )
+    {
+        retval = _vfs_archive_read( &file, val, sizeof( int8_t ) );
+
+        error = ( 1 != retval );
+
+        if (error) file.flags |= VFS_FILE_FLAG_ERROR;
+        else       file.flags &= ~VFS_FILE_FLAG_ERROR;
+    }
     
     if ( error ) _vfs_translate_error( &file );
     
@@ -882,6 +1116,15 @@ int vfs_read_Uint8( vfs_FILE& file, uint8_t * val )
         if (error) file.flags |= VFS_FILE_FLAG_ERROR;
         else       file.flags &= ~VFS_FILE_FLAG_ERROR;
     }
+    else if ( VFS_FILE_TYPE_ARCHIVE == file.type )
+    {
+        retval = _vfs_archive_read( &file, val, sizeof( uint8_t ) );
+
+        error = ( 1 != retval );
+
+        if (error) file.flags |= VFS_FILE_FLAG_ERROR;
+        else       file.flags &= ~VFS_FILE_FLAG_ERROR;
+    }
     
     if ( error ) _vfs_translate_error( &file );
     
@@ -915,6 +1158,18 @@ int vfs_read_Sint16( vfs_FILE& file, int16_t * val )
         if (error) file.flags |= VFS_FILE_FLAG_ERROR;
         else       file.flags &= ~VFS_FILE_FLAG_ERROR;
     }
+    else if ( VFS_FILE_TYPE_ARCHIVE == file.type )
+    {
+        int16_t tmp;
+        retval = ( sizeof( int16_t ) == _vfs_archive_read( &file, &tmp, sizeof( int16_t ) ) );
+
+        error = ( 0 == retval );
+
+        if (error) file.flags |= VFS_FILE_FLAG_ERROR;
+        else       file.flags &= ~VFS_FILE_FLAG_ERROR;
+
+        if (!error) *val = Endian_FileToHost( tmp );
+    }
 
     if ( error ) _vfs_translate_error( &file );
 
@@ -948,6 +1203,18 @@ int vfs_read_Uint16( vfs_FILE& file, uint16_t * val )
         if (error) file.flags |= VFS_FILE_FLAG_ERROR;
         else       file.flags &= ~VFS_FILE_FLAG_ERROR;
     }
+    else if ( VFS_FILE_TYPE_ARCHIVE == file.type )
+    {
+        uint16_t tmp;
+        retval = ( sizeof( uint16_t ) == _vfs_archive_read( &file, &tmp, sizeof( uint16_t ) ) );
+
+        error = ( 0 == retval );
+
+        if (error) file.flags |= VFS_FILE_FLAG_ERROR;
+        else       file.flags &= ~VFS_FILE_FLAG_ERROR;
+
+        if (!error) *val = Endian_FileToHost( tmp );
+    }
 
     if ( error ) _vfs_translate_error( &file );
 
@@ -981,6 +1248,18 @@ int vfs_read_Sint32( vfs_FILE& file, int32_t * val )
         if (error) file.flags |= VFS_FILE_FLAG_ERROR;
         else       file.flags &= ~VFS_FILE_FLAG_ERROR;
     }
+    else if ( VFS_FILE_TYPE_ARCHIVE == file.type )
+    {
+        int32_t tmp;
+        retval = ( sizeof( int32_t ) == _vfs_archive_read( &file, &tmp, sizeof( int32_t ) ) );
+
+        error = ( 0 == retval );
+
+        if (error) file.flags |= VFS_FILE_FLAG_ERROR;
+        else       file.flags &= ~VFS_FILE_FLAG_ERROR;
+
+        if (!error) *val = Endian_FileToHost( tmp );
+    }
 
     if ( error ) _vfs_translate_error( &file );
 
@@ -1014,6 +1293,18 @@ int vfs_read_Uint32( vfs_FILE& file, uint32_t * val )
         if (error) file.flags |= VFS_FILE_FLAG_ERROR;
         else       file.flags &= ~VFS_FILE_FLAG_ERROR;
     }
+    else if ( VFS_FILE_TYPE_ARCHIVE == file.type )
+    {
+        uint32_t tmp;
+        retval = ( sizeof( uint32_t ) == _vfs_archive_read( &file, &tmp, sizeof( uint32_t ) ) );
+
+        error = ( 0 == retval );
+
+        if (error) file.flags |= VFS_FILE_FLAG_ERROR;
+        else       file.flags &= ~VFS_FILE_FLAG_ERROR;
+
+        if (!error) *val = Endian_FileToHost( tmp );
+    }
 
     if ( error ) _vfs_translate_error( &file );
 
@@ -1047,6 +1338,18 @@ int vfs_read_Sint64( vfs_FILE& file, int64_t * val )
         if (error) file.flags |= VFS_FILE_FLAG_ERROR;
         else       file.flags &= ~VFS_FILE_FLAG_ERROR;
     }
+    else if ( VFS_FILE_TYPE_ARCHIVE == file.type )
+    {
+        int64_t tmp;
+        retval = ( sizeof( int64_t ) == _vfs_archive_read( &file, &tmp, sizeof( int64_t ) ) );
+
+        error = ( 0 == retval );
+
+        if (error) file.flags |= VFS_FILE_FLAG_ERROR;
+        else       file.flags &= ~VFS_FILE_FLAG_ERROR;
+
+        if (!error) *val = Endian_FileToHost( tmp );
+    }
 
     if ( error ) _vfs_translate_error( &file );
 
@@ -1080,6 +1383,18 @@ int vfs_read_Uint64( vfs_FILE& file, uint64_t * val )
         if (error) file.flags |= VFS_FILE_FLAG_ERROR;
         else       file.flags &= ~VFS_FILE_FLAG_ERROR;
     }
+    else if ( VFS_FILE_TYPE_ARCHIVE == file.type )
+    {
+        uint64_t tmp;
+        retval = ( sizeof( uint64_t ) == _vfs_archive_read( &file, &tmp, sizeof( uint64_t ) ) );
+
+        error = ( 0 == retval );
+
+        if (error) file.flags |= VFS_FILE_FLAG_ERROR;
+        else       file.flags &= ~VFS_FILE_FLAG_ERROR;
+
+        if (!error) *val = Endian_FileToHost( tmp );
+    }
 
     if ( error ) _vfs_translate_error( &file );
 
@@ -1116,6 +1431,18 @@ int vfs_read_float( vfs_FILE& file, float * val )
 
         *val = convert.f;
     }
+    else if ( VFS_FILE_TYPE_ARCHIVE == file.type )
+    {
+        float tmp;
+        retval = ( sizeof( float ) == _vfs_archive_read( &file, &tmp, sizeof( float ) ) );
+
+        error = ( 0 == retval );
+
+        if (error) file.flags |= VFS_FILE_FLAG_ERROR;
+        else       file.flags &= ~VFS_FILE_FLAG_ERROR;
+
+        if (!error) *val = Endian_FileToHost( tmp );
+    }
 
     if ( error ) _vfs_translate_error( &file );
 
@@ -1442,6 +1769,12 @@ int vfs_printf( vfs_FILE * pfile, const char *format, ... )
     {
         retval = vfprintf( pfile->ptr.c, format, args );
     }
+    else if ( VFS_FILE_TYPE_ARCHIVE == pfile->type )
+    {
+        // mounted archives are read-only
+        pfile->flags |= VFS_FILE_FLAG_ERROR;
+        retval = 0;
+    }
     else
     {
         retval = fake_physfs_vprintf( pfile->ptr.p, format, args );
@@ -1454,20 +1787,49 @@ int vfs_printf( vfs_FILE * pfile, const char *format, ... )
 //--------------------------------------------------------------------------------------------
 
 std::vector<std::string> SearchContext::enumerateFiles(const Ego::VfsPath& pathname) {
+    uint64_t generation;
+    {
+        std::lock_guard<std::mutex> lock(_vfs_cache.mutex);
+        auto *listing = _vfs_cache.listings.find(pathname.string());
+        if (listing) {
+            return *listing;
+        }
+        generation = _vfs_cache.generation;
+    }
     std::vector<std::string> result;
+    // The contents of the mounted archives and the PhysFS search path are merged.
+    std::unordered_set<std::string> found;
+    for (const auto& mount : _vfs_archive_mounts) {
+        auto name = _vfs_archive_name(mount, pathname.string());
+        if (name.first) {
+            for (auto& file : mount.archive->enumerate(name.second)) {
+                if (found.insert(file).second) {
+                    result.push_back(std::move(file));
+                }
+            }
+        }
+    }
     char **fileList = PHYSFS_enumerateFiles(pathname.string().c_str());
     if (!fileList) {
         throw std::runtime_error("unable to enumerate files");
     }
     for (char **file = fileList; nullptr != *file; ++file) {
         try {
-            result.push_back(*file);
+            if (0 == found.count(*file)) {
+                result.push_back(*file);
+            }
         } catch (...) {
             PHYSFS_freeList(fileList);
             std::rethrow_exception(std::current_exception());
         }
     }
     PHYSFS_freeList(fileList);
+    {
+        std::lock_guard<std::mutex> lock(_vfs_cache.mutex);
+        if (generation == _vfs_cache.generation) {
+            _vfs_cache.listings.insert(pathname.string(), result);
+        }
+    }
     return result;
 }
 
@@ -1630,6 +1992,7 @@ int vfs_removeDirectoryAndContents(const char * dirname, int recursive) {
     if (!fs_fileIsDirectory(resolvedWriteFilename.second.c_str())) return VFS_FALSE;
 
     fs_removeDirectoryAndContents(resolvedWriteFilename.second.c_str(), recursive);
+    vfs_invalidateCache();
 
     return VFS_TRUE;
 }
@@ -1722,6 +2085,21 @@ int vfs_ungetc( int c, vfs_FILE * pfile )
         if (!seeked) pfile->flags |= VFS_FILE_FLAG_ERROR;
         else         pfile->flags &= ~VFS_FILE_FLAG_ERROR;
     }
+    else if ( VFS_FILE_TYPE_ARCHIVE == pfile->type )
+    {
+        // fake it
+        if ( 0 == pfile->ptr.a->position )
+        {
+            pfile->flags |= VFS_FILE_FLAG_ERROR;
+            retval = EOF;
+        }
+        else
+        {
+            pfile->ptr.a->position--;
+            pfile->flags &= ~(VFS_FILE_FLAG_EOF | VFS_FILE_FLAG_ERROR);
+            retval = c;
+        }
+    }
 
     return retval;
 }
@@ -1767,6 +2145,18 @@ int vfs_getc(vfs_FILE *file)
             retval = cTmp;
         }
     }
+    else if (VFS_FILE_TYPE_ARCHIVE == file->type)
+    {
+        unsigned char cTmp;
+        if (0 == _vfs_archive_read(file, &cTmp, sizeof(cTmp)))
+        {
+            retval = EOF;
+        }
+        else
+        {
+            retval = cTmp;
+        }
+    }
 
     return retval;
 }
@@ -1952,6 +2342,12 @@ int vfs_add_mount_point( const std::string& rootPath, const Ego::FsPath& relativ
     if ( _vfs_mount_info_add( mountPoint, rootPath, relativePath.string() ) )
     {
         retval = PHYSFS_mount( loc_dirname.string().c_str(), mountPoint.string().c_str(), append );
+        vfs_invalidateCache();
+        if ( 0 != retval )
+        {
+            // _vfs_mount_info_add appends the mount info
+            _vfs_mount_infos.back().order = append ? ++_vfs_mount_order.back : --_vfs_mount_order.front;
+        }
         if ( 0 == retval )
         {
             // go back and remove the mount info, since PHYSFS rejected the
@@ -1975,6 +2371,13 @@ int vfs_remove_mount_point( const Ego::VfsPath& mountPoint )
     // assume we are going to fail
     int retval = 0;
 
+    // remove the archives mounted at the mount point
+    const std::string mount = Ego::left_trim<char>(mountPoint.string(), [](const char& chr) { return chr == NET_SLASH_CHR || chr == WIN32_SLASH_CHR; });
+    _vfs_archive_mounts.erase(std::remove_if(_vfs_archive_mounts.begin(), _vfs_archive_mounts.end(),
+                                             [&mount](const vfs_archive_mount_t& archiveMount) { return archiveMount.mount == mount; }),
+                              _vfs_archive_mounts.end());
+    vfs_invalidateCache();
+
     // see if we have the mount point
     int cnt = _vfs_mount_info_matches( mountPoint );
 
@@ -1992,10 +2395,134 @@ int vfs_remove_mount_point( const Ego::VfsPath& mountPoint )
 
         cnt = _vfs_mount_info_matches( mountPoint );
     }
+    vfs_invalidateCache();
 
     return retval;
 }
 
+//--------------------------------------------------------------------------------------------
+int vfs_add_archive_mount_point(const std::string& archivePathname, const std::string& directory, const Ego::VfsPath& mountPoint)
+{
+    BAIL_IF_NOT_INIT();
+
+    // If mount point is empty or a slash indicates the PhysFS root directory, not the root of the currently mounted volume.
+    if ( mountPoint.empty() || mountPoint == Ego::VfsPath("/") ) return 0;
+
+    // Share the archive if it is already mounted.
+    std::shared_ptr<Ego::VfsArchive> archive;
+    for (const auto& archiveMount : _vfs_archive_mounts) {
+        if (archiveMount.archive->getPathname() == archivePathname) {
+            archive = archiveMount.archive;
+            break;
+        }
+    }
+    if (!archive) {
+        archive = Ego::VfsArchive::open(archivePathname);
+        if (!archive) {
+            return 0;
+        }
+    }
+    if (!archive->isDirectory(directory)) {
+        Log::get() << Log::Entry::create(Log::Level::Warning, __FILE__, __LINE__, "archive ", "`", archivePathname, "`",
+                                         " has no directory ", "`", directory, "`", Log::EndOfEntry);
+        return 0;
+    }
+
+    vfs_archive_mount_t archiveMount;
+    archiveMount.mount = Ego::left_trim<char>(mountPoint.string(), [](const char& chr) { return chr == NET_SLASH_CHR || chr == WIN32_SLASH_CHR; });
+    archiveMount.directory = directory;
+    archiveMount.archive = archive;
+    // Archives are appended to the search order, hence _vfs_archive_mounts stays sorted by it.
+    archiveMount.order = ++_vfs_mount_order.back;
+    _vfs_archive_mounts.push_back(archiveMount);
+    vfs_invalidateCache();
+
+    return 1;
+}
+
+//--------------------------------------------------------------------------------------------
+/// @brief Get the name of the file or directory in a mounted archive a pathname refers to.
+/// @param mount the mounted archive
+/// @param pathname the pathname in vfs-specific notation e.g. <c>/mp_objects/sword.obj/data.txt</c>
+/// @return <c>(true,name)</c> if the pathname is below the mount point, <c>(false,"")</c> otherwise
+std::pair<bool, std::string> _vfs_archive_name(const vfs_archive_mount_t& mount, const std::string& pathname) {
+    // Strip any starting slashes.
+    std::string path = Ego::left_trim<char>(pathname, [](const char& chr) { return chr == NET_SLASH_CHR; });
+    if (!id::is_prefix(path, mount.mount) || (path.length() > mount.mount.length() && NET_SLASH_CHR != path[mount.mount.length()])) {
+        return std::make_pair(false, std::string());
+    }
+    // Strip the mount point and the separating and trailing slashes.
+    std::string name = Ego::trim<char>(path.substr(mount.mount.length()), [](const char& chr) { return chr == NET_SLASH_CHR; });
+    if (!mount.directory.empty()) {
+        name = name.empty() ? mount.directory : mount.directory + NET_SLASH_STR + name;
+    }
+    return std::make_pair(true, name);
+}
+
+/// @brief Find a file in the mounted archives.
+/// @param pathname the pathname in vfs-specific notation
+/// @param [out] archive the archive containing the file
+/// @return the entry of the file if it was found, a null pointer otherwise
+/// @remark A file is not found in an archive if a directory mounted before the archive contains it e.g.
+/// the module <tt>gamedat</tt> directory of the user directory shadows the one of a packed module.
+const Ego::VfsArchiveEntry *_vfs_archive_find(const std::string& pathname, std::shared_ptr<Ego::VfsArchive>& archive) {
+    for (const auto& mount : _vfs_archive_mounts) {
+        auto name = _vfs_archive_name(mount, pathname);
+        if (name.first) {
+            const Ego::VfsArchiveEntry *entry = mount.archive->find(name.second);
+            if (entry) {
+                if (_vfs_archive_isShadowed(mount, name.second)) {
+                    return nullptr;
+                }
+                archive = mount.archive;
+                return entry;
+            }
+        }
+    }
+    return nullptr;
+}
+
+/// @brief Get if a file in a mounted archive is shadowed by a file in a directory mounted before the archive.
+/// @param mount the mounted archive
+/// @param name the name of the file in the archive as returned by _vfs_archive_name
+/// @remark Only the directories mounted at the same mount point before the archive are checked, in the native file system.
+bool _vfs_archive_isShadowed(const vfs_archive_mount_t& mount, const std::string& name) {
+    // The pathname of the file relative to the mount point.
+    const std::string relative = str_convert_slash_sys(mount.directory.empty() ? name : name.substr(mount.directory.length() + 1));
+    for (const auto& mount_info : _vfs_mount_infos) {
+        if (mount_info.order < mount.order && mount_info.mount == mount.mount &&
+            1 == fs_fileExists(mount_info.full_path + SLASH_STR + relative)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+/// @brief Get if a pathname denotes a directory in the mounted archives.
+/// @param pathname the pathname in vfs-specific notation
+bool _vfs_archive_isDirectory(const std::string& pathname) {
+    for (const auto& mount : _vfs_archive_mounts) {
+        auto name = _vfs_archive_name(mount, pathname);
+        if (name.first && mount.archive->isDirectory(name.second)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+/// @brief Read from a file in a mounted archive.
+/// @return the number of Bytes read. The end-of-file flag is raised if less than @a length Bytes were read.
+size_t _vfs_archive_read(vfs_FILE *file, void *buffer, size_t length) {
+    vfs_archive_file_t *archiveFile = file->ptr.a;
+    const size_t count = std::min(length, archiveFile->size - std::min(archiveFile->position, archiveFile->size));
+    std::memcpy(buffer, archiveFile->data + archiveFile->position, count);
+    archiveFile->position += count;
+    if (count < length) {
+        file->flags |= VFS_FILE_FLAG_EOF;
+    }
+    return count;
+}
+
 //--------------------------------------------------------------------------------------------
 bool SearchContext::hasData() const {
     return this->file_list_iterator_2 != this->file_list_2.cend();
@@ -2177,6 +2704,8 @@ void vfs_set_base_search_paths( void )
     
     // Put config path on search path...
     PHYSFS_addToSearchPath(fs_getConfigDirectory().c_str(), 1);
+
+    vfs_invalidateCache();
 }
 
 //--------------------------------------------------------------------------------------------
@@ -2188,6 +2717,13 @@ void vfs_readEntireFile(const std::string& pathname, std::function<void(size_t,
     if (!file) {
         throw id::runtime_error(__FILE__, __LINE__, "unable to open file `" + pathname + "` for reading");
     }
+    // Files in mounted archives are received in place.
+    if (VFS_FILE_TYPE_ARCHIVE == file->type) {
+        if (0 != file->ptr.a->size) {
+            receive(file->ptr.a->size, file->ptr.a->data);
+        }
+        return;
+    }
     // Read in 2048 Byte chunks.
     char buffer[2048];
     while (!vfs_eof(file.get())) {
@@ -219,6 +219,13 @@ enum e_vfs_serach_bits
  */
 int vfs_init(const char *argv0, const char *root_dir);
 
+/**
+ * @brief
+ *  Uninitialize the VFS before program termination, removing all mount points.
+ *  Does nothing if the VFS is not initialized.
+ */
+void vfs_exit();
+
 /**@{*/
 /**
  * These functions open in "binary mode" this means that they are reading using
@@ -381,6 +388,19 @@ int vfs_add_mount_point(const std::string& rootPath, const Ego::FsPath& relative
 /// @brief Remove every search path related to the given mount point
 /// @param mountPoint the mount point in vfs-specific notation e.g. <c>mp_modules</c>
 int vfs_remove_mount_point(const Ego::VfsPath& mountPoint);
+/// @brief Mount a directory of an archive, see Ego::VfsArchive.
+/// @param archivePathname the pathname of the archive in platform-specific notation e.g. <c>C:\Program Files\Egoboo\data\modules\adventurer.mod.pack</c>
+/// @param directory the name of the directory in the archive e.g. <c>objects</c>, <c>""</c> for the archived directory itself
+/// @param mountPoint the mount point in vfs-specific notation e.g. <c>mp_objects</c>
+/// @return non-zero on success, zero on failure
+/// @remark Mounted archives are read-only. An archive is appended to the search paths of its mount point,
+/// files in directories mounted before the archive shadow the files of the archive. vfs_remove_mount_point unmounts them.
+int vfs_add_archive_mount_point(const std::string& archivePathname, const std::string& directory, const Ego::VfsPath& mountPoint);
+
+/// @brief Clear the cached results of vfs_exists, vfs_isDirectory, vfs_resolveReadFilename and of directory enumerations.
+/// @remark The VFS clears the cache whenever mount points are added or removed or the write directory is modified through the VFS.
+/// Code which modifies mounted directories in the native file system must invoke this function.
+void vfs_invalidateCache();
 
 Ego::VfsPath vfs_convert_fname(const Ego::VfsPath& path);
 Ego::VfsPath vfs_convert_fname(const std::string& pathString);
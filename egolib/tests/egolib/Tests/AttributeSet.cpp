@@ -0,0 +1,76 @@
+//********************************************************************************************
+//*
+//*    This file is part of Egoboo.
+//*
+//*    Egoboo is free software: you can redistribute it and/or modify it
+//*    under the terms of the GNU General Public License as published by
+//*    the Free Software Foundation, either version 3 of the License, or
+//*    (at your option) any later version.
+//*
+//*    Egoboo is distributed in the hope that it will be useful, but
+//*    WITHOUT ANY WARRANTY; without even the implied warranty of
+//*    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+//*    General Public License for more details.
+//*
+//*    You should have received a copy of the GNU General Public License
+//*    along with Egoboo.  If not, see <http://www.gnu.org/licenses/>.
+//*
+//********************************************************************************************
+
+#include "EgoTest/EgoTest.hpp"
+#include "egolib/Logic/AttributeSet.hpp"
+
+namespace Ego {
+namespace Test {
+
+EgoTest_TestCase(AttributeSets) {
+
+    EgoTest_Test(addModifiers) {
+        AttributeSet attributes;
+        attributes.setBase(Attribute::MIGHT, 10.0f);
+        EgoTest_Assert(10.0f == attributes.getEffective(Attribute::MIGHT));
+
+        // ADD type modifiers accumulate on top of the base value.
+        attributes.addModifier(Attribute::MIGHT, 2.0f);
+        attributes.addModifier(Attribute::MIGHT, 3.0f);
+        EgoTest_Assert(15.0f == attributes.getEffective(Attribute::MIGHT));
+        EgoTest_Assert(!attributes.isOverridden(Attribute::MIGHT));
+
+        attributes.addModifier(Attribute::MIGHT, -5.0f);
+        EgoTest_Assert(10.0f == attributes.getEffective(Attribute::MIGHT));
+
+        // Changing the base value invalidates the cache.
+        attributes.setBase(Attribute::MIGHT, 12.0f);
+        EgoTest_Assert(12.0f == attributes.getEffective(Attribute::MIGHT));
+    }
+
+    EgoTest_Test(setModifiers) {
+        AttributeSet attributes;
+        attributes.setBase(Attribute::FLY_TO_HEIGHT, 50.0f);
+        EgoTest_Assert(!attributes.isOverridden(Attribute::FLY_TO_HEIGHT));
+
+        // SET type modifiers replace the base value, even if they are 0.
+        attributes.setModifier(Attribute::FLY_TO_HEIGHT, 0.0f);
+        EgoTest_Assert(attributes.isOverridden(Attribute::FLY_TO_HEIGHT));
+        EgoTest_Assert(0.0f == attributes.getEffective(Attribute::FLY_TO_HEIGHT));
+
+        attributes.removeModifier(Attribute::FLY_TO_HEIGHT);
+        EgoTest_Assert(!attributes.hasModifier(Attribute::FLY_TO_HEIGHT));
+        EgoTest_Assert(50.0f == attributes.getEffective(Attribute::FLY_TO_HEIGHT));
+    }
+
+    EgoTest_Test(clearModifiers) {
+        AttributeSet attributes;
+        attributes.setBase(Attribute::DEFENCE, 4.0f);
+        attributes.addModifier(Attribute::DEFENCE, 4.0f);
+        attributes.setModifier(Attribute::SHEEN, 2.0f);
+        attributes.clearModifiers();
+        EgoTest_Assert(4.0f == attributes.getEffective(Attribute::DEFENCE));
+        EgoTest_Assert(0.0f == attributes.getEffective(Attribute::SHEEN));
+        EgoTest_Assert(!attributes.hasModifier(Attribute::SHEEN));
+    }
+
+};
+
+} // namespace Test
+} // namespace Ego
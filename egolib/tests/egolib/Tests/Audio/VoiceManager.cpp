@@ -0,0 +1,131 @@
+//********************************************************************************************
+//*
+//*    This file is part of Egoboo.
+//*
+//*    Egoboo is free software: you can redistribute it and/or modify it
+//*    under the terms of the GNU General Public License as published by
+//*    the Free Software Foundation, either version 3 of the License, or
+//*    (at your option) any later version.
+//*
+//*    Egoboo is distributed in the hope that it will be useful, but
+//*    WITHOUT ANY WARRANTY; without even the implied warranty of
+//*    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+//*    General Public License for more details.
+//*
+//*    You should have received a copy of the GNU General Public License
+//*    along with Egoboo.  If not, see <http://www.gnu.org/licenses/>.
+//*
+//********************************************************************************************
+
+#include "EgoTest/EgoTest.hpp"
+#include "egolib/Audio/VoiceManager.hpp"
+
+namespace Ego {
+namespace Test {
+
+EgoTest_TestCase(VoiceManagement) {
+
+    static int play(VoiceManager& voices, SoundID soundID, float distance) {
+        VoiceManager::Allocation allocation = voices.allocate(soundID, distance);
+        if (VoiceManager::INVALID_CHANNEL != allocation.channel) {
+            voices.bind(allocation.channel, soundID, distance, false, allocation.stolen);
+        }
+        return allocation.channel;
+    }
+
+    EgoTest_Test(freeChannelsFirst) {
+        VoiceManager voices;
+        voices.setChannelCount(4);
+        for (int i = 0; i < 4; ++i) {
+            EgoTest_Assert(play(voices, i, 100.0f) == i);
+        }
+        EgoTest_Assert(voices.getStolenCount() == 0);
+    }
+
+    EgoTest_Test(maxInstances) {
+        VoiceManager voices;
+        voices.setChannelCount(8);
+        voices.setMaxInstances(0, 2);
+        EgoTest_Assert(play(voices, 0, 100.0f) == 0);
+        EgoTest_Assert(play(voices, 0, 200.0f) == 1);
+        EgoTest_Assert(voices.getInstanceCount(0) == 2);
+
+        // A farther instance is rejected.
+        EgoTest_Assert(play(voices, 0, 300.0f) == VoiceManager::INVALID_CHANNEL);
+        EgoTest_Assert(voices.getRejectedCount() == 1);
+
+        // A closer instance replaces the farthest instance.
+        EgoTest_Assert(play(voices, 0, 50.0f) == 1);
+        EgoTest_Assert(voices.getInstanceCount(0) == 2);
+        EgoTest_Assert(voices.getStolenCount() == 1);
+    }
+
+    EgoTest_Test(stealFailed) {
+        VoiceManager voices;
+        voices.setChannelCount(1);
+        EgoTest_Assert(play(voices, 0, 100.0f) == 0);
+
+        // The channel is taken, but the new sound fails to play and the channel is released.
+        VoiceManager::Allocation allocation = voices.allocate(1, 50.0f);
+        EgoTest_Assert(allocation.channel == 0 && allocation.stolen);
+        voices.release(allocation.channel);
+        EgoTest_Assert(voices.getStolenCount() == 0);
+    }
+
+    EgoTest_Test(stealByPriorityAndDistance) {
+        VoiceManager voices;
+        voices.setChannelCount(3);
+        voices.setPriority(1, SoundPriority::Low);
+        voices.setPriority(2, SoundPriority::High);
+        EgoTest_Assert(play(voices, 0, 100.0f) == 0);
+        EgoTest_Assert(play(voices, 1, 10.0f) == 1);
+        EgoTest_Assert(play(voices, 3, 500.0f) == 2);
+
+        // The low priority sound is taken first, even though it is closest.
+        EgoTest_Assert(play(voices, 2, 1000.0f) == 1);
+
+        // Among equal priorities the farthest sound is taken.
+        EgoTest_Assert(play(voices, 4, 50.0f) == 2);
+
+        // Nothing is taken from closer sounds of equal priority or from higher priorities.
+        EgoTest_Assert(play(voices, 5, 2000.0f) == VoiceManager::INVALID_CHANNEL);
+    }
+
+    EgoTest_Test(collect) {
+        VoiceManager voices;
+        voices.setChannelCount(2);
+        EgoTest_Assert(play(voices, 0, 100.0f) == 0);
+        EgoTest_Assert(play(voices, 0, 100.0f) == 1);
+        voices.collect([](int channel) { return channel != 0; });
+        EgoTest_Assert(!voices.isBound(0));
+        EgoTest_Assert(voices.isBound(1));
+        EgoTest_Assert(voices.getInstanceCount(0) == 1);
+        EgoTest_Assert(play(voices, 1, 100.0f) == 0);
+    }
+
+    EgoTest_Test(collectHaltedLoop) {
+        VoiceManager voices;
+        voices.setChannelCount(2);
+        VoiceManager::Allocation allocation = voices.allocate(0, 100.0f);
+        EgoTest_Assert(allocation.channel == 0);
+        voices.bind(allocation.channel, 0, 100.0f, true, allocation.stolen);
+        EgoTest_Assert(play(voices, 1, 100.0f) == 1);
+
+        // The looping sound on channel 0 was faded out or halted by the mixer.
+        // The channel is reported so that the looping sound can be detached from it.
+        std::vector<int> released = voices.collect([](int channel) { return channel != 0; });
+        EgoTest_Assert(released.size() == 1 && released[0] == 0);
+        EgoTest_Assert(voices.collect([](int channel) { return channel != 0; }).empty());
+
+        // Another sound gets the channel without taking it from the looping sound.
+        allocation = voices.allocate(2, 100.0f);
+        EgoTest_Assert(allocation.channel == 0);
+        EgoTest_Assert(!allocation.stolen);
+        voices.bind(allocation.channel, 2, 100.0f, false, allocation.stolen);
+        EgoTest_Assert(voices.getInstanceCount(0) == 0);
+        EgoTest_Assert(voices.getStolenCount() == 0);
+    }
+};
+
+} // namespace Test
+} // namespace Ego
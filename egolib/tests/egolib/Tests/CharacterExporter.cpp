@@ -0,0 +1,153 @@
+//********************************************************************************************
+//*
+//*    This file is part of Egoboo.
+//*
+//*    Egoboo is free software: you can redistribute it and/or modify it
+//*    under the terms of the GNU General Public License as published by
+//*    the Free Software Foundation, either version 3 of the License, or
+//*    (at your option) any later version.
+//*
+//*    Egoboo is distributed in the hope that it will be useful, but
+//*    WITHOUT ANY WARRANTY; without even the implied warranty of
+//*    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+//*    General Public License for more details.
+//*
+//*    You should have received a copy of the GNU General Public License
+//*    along with Egoboo.  If not, see <http://www.gnu.org/licenses/>.
+//*
+//********************************************************************************************
+
+#include "EgoTest/EgoTest.hpp"
+#include "egolib/egolib.h"
+
+namespace Ego {
+namespace Test {
+
+namespace {
+
+void writeFile(const std::string& pathname, const std::string& contents) {
+    FILE *file = fopen(pathname.c_str(), "wb");
+    fputs(contents.c_str(), file);
+    fclose(file);
+}
+
+std::string readFile(const std::string& pathname) {
+    std::string contents;
+    FILE *file = fopen(pathname.c_str(), "rb");
+    if (file) {
+        int c;
+        while (EOF != (c = fgetc(file))) contents.push_back(static_cast<char>(c));
+        fclose(file);
+    }
+    return contents;
+}
+
+} // namespace
+
+EgoTest_TestCase(CharacterExporters) {
+
+    EgoTest_Test(exportAndCommit) {
+        const std::string root = "CharacterExporterTest";
+        const std::string source = root + SLASH_STR "source.obj", save = root + SLASH_STR "twink.obj";
+        fs_removeDirectoryAndContents(root.c_str(), 1);
+        fs_createDirectory(root);
+        fs_createDirectory(source);
+        writeFile(source + SLASH_STR "tris.md2", "model");
+        writeFile(source + SLASH_STR "script.txt", "script");
+
+        // A file of an old export which is no longer part of the export.
+        fs_createDirectory(save);
+        writeFile(save + SLASH_STR "stale.txt", "stale");
+
+        CharacterExporter::initialize();
+
+        // The generated files are staged before the export is submitted.
+        const std::string staging = CharacterExporter::getStagingDirectory(save);
+        fs_createDirectory(staging);
+        fs_createDirectory(staging + SLASH_STR "0.obj");
+        writeFile(staging + SLASH_STR "data.txt", "data");
+        writeFile(staging + SLASH_STR "0.obj" SLASH_STR "data.txt", "item");
+
+        CharacterExport characterExport;
+        characterExport.name = "twink.obj";
+        characterExport.directory = save;
+        characterExport.generatedFiles = { "data.txt", "0.obj/data.txt" };
+        characterExport.copiedFiles = { { source + SLASH_STR "tris.md2", "tris.md2" },
+                                        { source + SLASH_STR "script.txt", "0.obj/script.txt" } };
+        CharacterExporter::get().submit(characterExport);
+        CharacterExporter::get().wait();
+
+        EgoTest_Assert("data" == readFile(save + SLASH_STR "data.txt"));
+        EgoTest_Assert("item" == readFile(save + SLASH_STR "0.obj" SLASH_STR "data.txt"));
+        EgoTest_Assert("model" == readFile(save + SLASH_STR "tris.md2"));
+        EgoTest_Assert("script" == readFile(save + SLASH_STR "0.obj" SLASH_STR "script.txt"));
+        EgoTest_Assert(0 == fs_fileExists(save + SLASH_STR "stale.txt"));
+        EgoTest_Assert(0 == fs_fileIsDirectory(staging));
+
+        CharacterExporter::uninitialize();
+        fs_removeDirectoryAndContents(root.c_str(), 1);
+    }
+
+    EgoTest_Test(discardFailed) {
+        const std::string root = "CharacterExporterTest";
+        const std::string save = root + SLASH_STR "twink.obj";
+        const std::string staging = CharacterExporter::getStagingDirectory(save);
+        fs_removeDirectoryAndContents(root.c_str(), 1);
+        fs_createDirectory(root);
+        fs_createDirectory(save);
+        writeFile(save + SLASH_STR "data.txt", "old");
+        writeFile(save + SLASH_STR "0.obj.txt", "item");
+
+        CharacterExporter::initialize();
+
+        // The character was staged, but one of its items could not be exported.
+        fs_createDirectory(staging);
+        writeFile(staging + SLASH_STR "data.txt", "new");
+        CharacterExport characterExport;
+        characterExport.name = "twink.obj";
+        characterExport.directory = save;
+        characterExport.generatedFiles = { "data.txt" };
+        characterExport.failed = true;
+        CharacterExporter::get().submit(characterExport);
+        CharacterExporter::get().wait();
+
+        // The save directory is unchanged and nothing remains staged.
+        EgoTest_Assert("old" == readFile(save + SLASH_STR "data.txt"));
+        EgoTest_Assert("item" == readFile(save + SLASH_STR "0.obj.txt"));
+        EgoTest_Assert(0 == fs_fileIsDirectory(staging));
+
+        CharacterExporter::uninitialize();
+        fs_removeDirectoryAndContents(root.c_str(), 1);
+    }
+
+    EgoTest_Test(recover) {
+        const std::string root = "CharacterExporterTest";
+        const std::string save = root + SLASH_STR "twink.obj";
+        const std::string staging = CharacterExporter::getStagingDirectory(save);
+        fs_removeDirectoryAndContents(root.c_str(), 1);
+        fs_createDirectory(root);
+        fs_createDirectory(save);
+        writeFile(save + SLASH_STR "data.txt", "old");
+
+        // An uncommitted export is discarded.
+        fs_createDirectory(staging);
+        writeFile(staging + SLASH_STR "data.txt", "new");
+        CharacterExporter::recoverAll(root);
+        EgoTest_Assert("old" == readFile(save + SLASH_STR "data.txt"));
+        EgoTest_Assert(0 == fs_fileIsDirectory(staging));
+
+        // A committed export is completed.
+        fs_createDirectory(staging);
+        writeFile(staging + SLASH_STR "data.txt", "new");
+        writeFile(staging + SLASH_STR + CharacterExporter::ManifestFilename, "data.txt\n");
+        CharacterExporter::recoverAll(root);
+        EgoTest_Assert("new" == readFile(save + SLASH_STR "data.txt"));
+        EgoTest_Assert(0 == fs_fileIsDirectory(staging));
+
+        fs_removeDirectoryAndContents(root.c_str(), 1);
+    }
+
+};
+
+} // namespace Test
+} // namespace Ego
@@ -0,0 +1,83 @@
+//********************************************************************************************
+//*
+//*    This file is part of Egoboo.
+//*
+//*    Egoboo is free software: you can redistribute it and/or modify it
+//*    under the terms of the GNU General Public License as published by
+//*    the Free Software Foundation, either version 3 of the License, or
+//*    (at your option) any later version.
+//*
+//*    Egoboo is distributed in the hope that it will be useful, but
+//*    WITHOUT ANY WARRANTY; without even the implied warranty of
+//*    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+//*    General Public License for more details.
+//*
+//*    You should have received a copy of the GNU General Public License
+//*    along with Egoboo.  If not, see <http://www.gnu.org/licenses/>.
+//*
+//********************************************************************************************
+
+#include "EgoTest/EgoTest.hpp"
+#include "egolib/egolib.h"
+#include "egolib/Mesh/CookedMesh.hpp"
+#include "egolib/FileFormats/Globals.hpp"
+
+namespace Ego {
+namespace Test {
+
+namespace {
+
+void writeFile(const std::string& pathname, const std::string& contents) {
+    FILE *file = fopen(pathname.c_str(), "wb");
+    fwrite(contents.data(), 1, contents.size(), file);
+    fclose(file);
+}
+
+} // namespace
+
+EgoTest_TestCase(CookedMeshes) {
+
+    EgoTest_Test(staleSources) {
+        const std::string root = "CookedMeshTest";
+        const std::string data = root + SLASH_STR "data";
+        fs_removeDirectoryAndContents(root.c_str(), 1);
+        fs_createDirectory(root);
+        fs_createDirectory(data);
+        // A map larger than a few KiB such that an edit near its end is not in its first Bytes.
+        std::string level(64 * 1024, 'a');
+        writeFile(data + SLASH_STR "level.mpd", level);
+        writeFile(data + SLASH_STR "fans.txt", "fans");
+        const std::vector<std::string> sources = {"mp_test/level.mpd", "mp_test/fans.txt"};
+
+        EgoTest_Assert(0 == vfs_init(nullptr, nullptr));
+        EgoTest_Assert(0 != vfs_add_mount_point(root, Ego::FsPath("data"), Ego::VfsPath("mp_test"), 1));
+        map_t map;
+        auto cooked = CookedMesh::cook(map, tile_dict, CookedMesh::stampSources(sources));
+        EgoTest_Assert(nullptr != cooked);
+        EgoTest_Assert(cooked->save(data + SLASH_STR "level.mpc"));
+        vfs_invalidateCache();
+        EgoTest_Assert(nullptr != CookedMesh::load("mp_test/level.mpc", sources));
+
+        // An edit which keeps the size of the map is detected.
+        level[level.size() - 1] = 'b';
+        writeFile(data + SLASH_STR "level.mpd", level);
+        vfs_invalidateCache();
+        EgoTest_Assert(nullptr == CookedMesh::load("mp_test/level.mpc", sources));
+
+        // A missing source makes the cooked mesh stale.
+        level[level.size() - 1] = 'a';
+        writeFile(data + SLASH_STR "level.mpd", level);
+        vfs_invalidateCache();
+        EgoTest_Assert(nullptr != CookedMesh::load("mp_test/level.mpc", sources));
+        fs_deleteFile(data + SLASH_STR "level.mpd");
+        vfs_invalidateCache();
+        EgoTest_Assert(nullptr == CookedMesh::load("mp_test/level.mpc", sources));
+
+        vfs_remove_mount_point(Ego::VfsPath("mp_test"));
+        fs_removeDirectoryAndContents(root.c_str(), 1);
+    }
+
+};
+
+} // namespace Test
+} // namespace Ego
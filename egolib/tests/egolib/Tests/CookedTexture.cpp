@@ -0,0 +1,107 @@
+//********************************************************************************************
+//*
+//*    This file is part of Egoboo.
+//*
+//*    Egoboo is free software: you can redistribute it and/or modify it
+//*    under the terms of the GNU General Public License as published by
+//*    the Free Software Foundation, either version 3 of the License, or
+//*    (at your option) any later version.
+//*
+//*    Egoboo is distributed in the hope that it will be useful, but
+//*    WITHOUT ANY WARRANTY; without even the implied warranty of
+//*    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+//*    General Public License for more details.
+//*
+//*    You should have received a copy of the GNU General Public License
+//*    along with Egoboo.  If not, see <http://www.gnu.org/licenses/>.
+//*
+//********************************************************************************************
+
+
+#include "EgoTest/EgoTest.hpp"
+#include "egolib/egolib.h"
+#include "egolib/Graphics/CookedTexture.hpp"
+#include "egolib/Image/SDL_Image_Extensions.h"
+
+namespace Ego {
+namespace Test {
+
+namespace {
+
+std::shared_ptr<SDL_Surface> createFilledSurface(int width, int height, uint8_t alpha) {
+    auto surface = SDL::createSurface(width, height);
+    SDL_FillRect(surface.get(), nullptr, SDL_MapRGBA(surface->format, 10, 20, 30, alpha));
+    return surface;
+}
+
+/// Truncate a file to half of its size.
+void truncateFile(const std::string& pathname) {
+    std::vector<char> contents;
+    FILE *file = fopen(pathname.c_str(), "rb");
+    char buffer[1024];
+    size_t count;
+    while (0 < (count = fread(buffer, 1, sizeof(buffer), file))) contents.insert(contents.end(), buffer, buffer + count);
+    fclose(file);
+    file = fopen(pathname.c_str(), "wb");
+    fwrite(contents.data(), 1, contents.size() / 2, file);
+    fclose(file);
+}
+
+} // namespace
+
+EgoTest_TestCase(CookedTextures) {
+
+    EgoTest_Test(cookOpaque) {
+        auto cooked = CookedTexture::cook(createFilledSurface(4, 2, 0xff), 1, true);
+        EgoTest_Assert(nullptr != cooked);
+        EgoTest_Assert(!cooked->hasAlpha());
+        EgoTest_Assert(PixelFormat::R8G8B8 == cooked->getPixelFormat());
+        EgoTest_Assert(4 == cooked->getWidth() && 2 == cooked->getHeight());
+        // 4 x 2, 2 x 1, 1 x 1.
+        EgoTest_Assert(3 == cooked->getLevelCount());
+        EgoTest_Assert(2 == cooked->getLevelWidth(1) && 1 == cooked->getLevelHeight(1));
+        EgoTest_Assert(1 == cooked->getLevelWidth(2) && 1 == cooked->getLevelHeight(2));
+        // The mipmaps of a uniform image are uniform.
+        const uint8_t *pixel = static_cast<const uint8_t *>(cooked->getLevelPixels(2));
+        EgoTest_Assert(10 == pixel[0] && 20 == pixel[1] && 30 == pixel[2]);
+        EgoTest_Assert(!cooked->isMapped());
+    }
+
+    EgoTest_Test(cookTranslucent) {
+        auto cooked = CookedTexture::cook(createFilledSurface(3, 2, 0x80), 1, false);
+        EgoTest_Assert(cooked->hasAlpha());
+        EgoTest_Assert(PixelFormat::R8G8B8A8 == cooked->getPixelFormat());
+        // Padded to power-of-two dimensions, without mipmaps.
+        EgoTest_Assert(4 == cooked->getWidth() && 2 == cooked->getHeight());
+        EgoTest_Assert(3 == cooked->getSourceWidth() && 2 == cooked->getSourceHeight());
+        EgoTest_Assert(1 == cooked->getLevelCount());
+    }
+
+    EgoTest_Test(saveAndLoad) {
+        const std::string pathname = "CookedTextureTest.etx";
+        auto cooked = CookedTexture::cook(createFilledSurface(4, 2, 0xff), 1, true);
+        EgoTest_Assert(cooked->save(pathname));
+
+        // The loaded texture is mapped and equal to the saved texture.
+        auto loaded = CookedTexture::load(pathname, 1);
+        EgoTest_Assert(nullptr != loaded);
+        EgoTest_Assert(loaded->isMapped());
+        EgoTest_Assert(cooked->getLevelCount() == loaded->getLevelCount());
+        for (size_t level = 0; level < cooked->getLevelCount(); ++level) {
+            const size_t size = cooked->getLevelWidth(level) * cooked->getLevelHeight(level) * 3;
+            EgoTest_Assert(0 == memcmp(cooked->getLevelPixels(level), loaded->getLevelPixels(level), size));
+        }
+        loaded = nullptr;
+
+        // A texture cooked from another source, a truncated file and a missing file are rejected.
+        EgoTest_Assert(nullptr == CookedTexture::load(pathname, 2));
+        truncateFile(pathname);
+        EgoTest_Assert(nullptr == CookedTexture::load(pathname, 1));
+        fs_deleteFile(pathname);
+        EgoTest_Assert(nullptr == CookedTexture::load(pathname, 1));
+    }
+
+};
+
+} // namespace Test
+} // namespace Ego
@@ -0,0 +1,103 @@
+//********************************************************************************************
+//*
+//*    This file is part of Egoboo.
+//*
+//*    Egoboo is free software: you can redistribute it and/or modify it
+//*    under the terms of the GNU General Public License as published by
+//*    the Free Software Foundation, either version 3 of the License, or
+//*    (at your option) any later version.
+//*
+//*    Egoboo is distributed in the hope that it will be useful, but
+//*    WITHOUT ANY WARRANTY; without even the implied warranty of
+//*    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+//*    General Public License for more details.
+//*
+//*    You should have received a copy of the GNU General Public License
+//*    along with Egoboo.  If not, see <http://www.gnu.org/licenses/>.
+//*
+//********************************************************************************************
+
+#include "EgoTest/EgoTest.hpp"
+#include "egolib/Image/ImageProcessing.hpp"
+
+namespace Ego {
+namespace Test {
+
+namespace IP = Ego::ImageProcessing;
+
+EgoTest_TestCase(ImageProcessing) {
+
+    EgoTest_Test(testDownsample) {
+        // 8 x 2 RGBA pixels, wide enough to cover the vectorized and the scalar paths.
+        uint8_t source[8 * 2 * 4];
+        for (size_t i = 0; i < sizeof(source); ++i) {
+            source[i] = static_cast<uint8_t>(i * 7);
+        }
+        uint8_t target[4 * 1 * 4];
+        IP::downsample(source, 8, 2, 4, target);
+        for (size_t x = 0; x < 4; ++x) {
+            for (size_t c = 0; c < 4; ++c) {
+                const int sum = source[(2 * x) * 4 + c] + source[(2 * x + 1) * 4 + c]
+                              + source[(8 + 2 * x) * 4 + c] + source[(8 + 2 * x + 1) * 4 + c];
+                EgoTest_Assert(target[x * 4 + c] == (sum + 2) / 4);
+            }
+        }
+        // A column of RGB pixels is averaged vertically, rounding half up.
+        uint8_t column[] = {0, 10, 255, 1, 20, 255};
+        uint8_t pixel[3];
+        IP::downsample(column, 1, 2, 3, pixel);
+        EgoTest_Assert(1 == pixel[0] && 15 == pixel[1] && 255 == pixel[2]);
+    }
+
+    EgoTest_Test(testConvert) {
+        const IP::ChannelLayout bgra = {16, 8, 0, 24, true},
+                            rgba = {0, 8, 16, 24, true},
+                            rgb = {0, 8, 16, 0, false},
+                            bgrx = {16, 8, 0, 0, false};
+        uint32_t source[5];
+        for (size_t i = 0; i < 5; ++i) {
+            source[i] = 0x80000000u | (uint32_t(i) << 16) | 0x0000aa00u | 0x00000011u;
+        }
+        uint32_t target[5];
+        IP::convert(source, sizeof(source), bgra, target, sizeof(target), rgba, 4, 5, 1);
+        for (size_t i = 0; i < 5; ++i) {
+            EgoTest_Assert(target[i] == (0x80000000u | 0x00110000u | 0x0000aa00u | uint32_t(i)));
+        }
+        // A source without alpha channel is opaque.
+        IP::convert(source, sizeof(source), bgrx, target, sizeof(target), rgba, 4, 5, 1);
+        EgoTest_Assert(0xff000000u == (target[4] & 0xff000000u));
+        // The alpha channel is dropped for a target without alpha channel.
+        uint32_t packed[4] = {0, 0, 0, 0};
+        IP::convert(source, sizeof(source), bgra, packed, 15, rgb, 3, 5, 1);
+        const uint8_t *bytes = reinterpret_cast<const uint8_t *>(packed);
+        EgoTest_Assert(0x00 == bytes[0] && 0xaa == bytes[1] && 0x11 == bytes[2]);
+        EgoTest_Assert(0x04 == bytes[4 * 3] && 0xaa == bytes[4 * 3 + 1] && 0x11 == bytes[4 * 3 + 2]);
+    }
+
+    EgoTest_Test(testHasNonOpaquePixel) {
+        uint32_t pixels[2 * 9];
+        for (auto& pixel : pixels) {
+            pixel = 0xff123456u;
+        }
+        EgoTest_Assert(!IP::hasNonOpaquePixel(pixels, 9, 2, 9 * 4, 0xff000000u));
+        pixels[2 * 9 - 1] = 0xfe123456u;
+        EgoTest_Assert(IP::hasNonOpaquePixel(pixels, 9, 2, 9 * 4, 0xff000000u));
+        // Only the rectangle is inspected.
+        EgoTest_Assert(!IP::hasNonOpaquePixel(pixels, 8, 2, 9 * 4, 0xff000000u));
+    }
+
+    EgoTest_Test(testPad) {
+        const uint8_t source[2 * 3] = {1, 2, 3, 4, 5, 6};
+        uint8_t target[4 * 2];
+        for (auto& byte : target) {
+            byte = 0xff;
+        }
+        IP::pad(source, 3, 3, 2, target, 4, 4, 2, 1);
+        const uint8_t expected[4 * 2] = {1, 2, 3, 0, 4, 5, 6, 0};
+        EgoTest_Assert(std::equal(std::begin(expected), std::end(expected), std::begin(target)));
+    }
+
+};
+
+} // namespace Test
+} // namespace Ego
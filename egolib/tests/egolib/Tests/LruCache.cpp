@@ -0,0 +1,73 @@
+//********************************************************************************************
+//*
+//*    This file is part of Egoboo.
+//*
+//*    Egoboo is free software: you can redistribute it and/or modify it
+//*    under the terms of the GNU General Public License as published by
+//*    the Free Software Foundation, either version 3 of the License, or
+//*    (at your option) any later version.
+//*
+//*    Egoboo is distributed in the hope that it will be useful, but
+//*    WITHOUT ANY WARRANTY; without even the implied warranty of
+//*    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+//*    General Public License for more details.
+//*
+//*    You should have received a copy of the GNU General Public License
+//*    along with Egoboo.  If not, see <http://www.gnu.org/licenses/>.
+//*
+//********************************************************************************************
+
+#include "EgoTest/EgoTest.hpp"
+#include "egolib/Core/LruCache.hpp"
+
+namespace Ego {
+namespace Test {
+
+EgoTest_TestCase(LruCaching) {
+
+    EgoTest_Test(findAndInsert) {
+        Core::LruCache<std::string, int> cache(4);
+        EgoTest_Assert(nullptr == cache.find("a"));
+        cache.insert("a", 1);
+        cache.insert("b", 2);
+        EgoTest_Assert(cache.size() == 2);
+        EgoTest_Assert(nullptr != cache.find("a") && 1 == *cache.find("a"));
+        EgoTest_Assert(nullptr != cache.find("b") && 2 == *cache.find("b"));
+
+        // Inserting an existing key replaces its value.
+        cache.insert("a", 3);
+        EgoTest_Assert(cache.size() == 2);
+        EgoTest_Assert(3 == *cache.find("a"));
+    }
+
+    EgoTest_Test(evictLeastRecentlyUsed) {
+        Core::LruCache<int, int> cache(3);
+        cache.insert(1, 1);
+        cache.insert(2, 2);
+        cache.insert(3, 3);
+
+        // Touch 1, so 2 is the least recently used entry.
+        EgoTest_Assert(nullptr != cache.find(1));
+        cache.insert(4, 4);
+        EgoTest_Assert(cache.size() == 3);
+        EgoTest_Assert(nullptr == cache.find(2));
+        EgoTest_Assert(nullptr != cache.find(1));
+        EgoTest_Assert(nullptr != cache.find(3));
+        EgoTest_Assert(nullptr != cache.find(4));
+
+        // Now 1 is the least recently used entry.
+        cache.insert(5, 5);
+        EgoTest_Assert(nullptr == cache.find(1));
+        EgoTest_Assert(5 == *cache.find(5));
+    }
+
+    EgoTest_Test(zeroCapacity) {
+        Core::LruCache<int, int> cache(0);
+        EgoTest_Assert(1 == cache.insert(1, 1));
+        EgoTest_Assert(nullptr == cache.find(1));
+        EgoTest_Assert(cache.size() == 0);
+    }
+};
+
+} // namespace Test
+} // namespace Ego
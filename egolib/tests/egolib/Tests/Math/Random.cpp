@@ -0,0 +1,100 @@
+//********************************************************************************************
+//*
+//*    This file is part of Egoboo.
+//*
+//*    Egoboo is free software: you can redistribute it and/or modify it
+//*    under the terms of the GNU General Public License as published by
+//*    the Free Software Foundation, either version 3 of the License, or
+//*    (at your option) any later version.
+//*
+//*    Egoboo is distributed in the hope that it will be useful, but
+//*    WITHOUT ANY WARRANTY; without even the implied warranty of
+//*    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+//*    General Public License for more details.
+//*
+//*    You should have received a copy of the GNU General Public License
+//*    along with Egoboo.  If not, see <http://www.gnu.org/licenses/>.
+//*
+//********************************************************************************************
+
+
+#include "EgoTest/EgoTest.hpp"
+#include "egolib/Math/Random.hpp"
+
+namespace Ego {
+namespace Math {
+namespace Test {
+
+EgoTest_TestCase(Random) {
+
+EgoTest_Test(knownAnswers) {
+    // The outputs of the reference implementation of xoshiro256** for the state {1, 2, 3, 4}.
+    static const uint64_t outputs[] = {
+        11520ULL, 0ULL, 1509978240ULL, 1215971899390074240ULL,
+        1216172134540287360ULL, 607988272756665600ULL, 16172922978634559625ULL, 8476171486693032832ULL,
+    };
+    RandomGenerator generator({1, 2, 3, 4});
+    for (uint64_t output : outputs) {
+        EgoTest_Assert(output == generator());
+    }
+
+    // The seed 0 is expanded with SplitMix64 to the state
+    // {0xE220A8397B1DCDAF, 0x6E789E6AA1B965F4, 0x06C45D188009454F, 0xF88BB8A8724C81EC}.
+    RandomGenerator seeded(0), expanded({0xE220A8397B1DCDAFULL, 0x6E789E6AA1B965F4ULL, 0x06C45D188009454FULL, 0xF88BB8A8724C81ECULL});
+    for (size_t i = 0; i < 8; ++i) {
+        EgoTest_Assert(expanded() == seeded());
+    }
+
+    // A stream draws the raw outputs of its generator if the interval covers all 64 bit numbers.
+    static const uint64_t streamOutputs[] = {
+        0x99EC5F36CB75F2B4ULL, 0xBF6E1F784956452AULL, 0x1A5F849D4933E6E0ULL, 0x6AA594F1262D2D2CULL,
+        0xBBA5AD4A1F842E59ULL, 0xFFEF8375D9EBCACAULL, 0x6C160DEED2F54C98ULL, 0x8920AD648FC30A3FULL,
+    };
+    RandomStream stream(0);
+    for (uint64_t output : streamOutputs) {
+        EgoTest_Assert(output == stream.next<unsigned long long>(0, std::numeric_limits<unsigned long long>::max()));
+    }
+}
+
+EgoTest_Test(reproducible) {
+    RandomStream a(1234), b(1234);
+    for (size_t i = 0; i < 1000; ++i) {
+        EgoTest_Assert(a.next<int>(-1000, 1000) == b.next<int>(-1000, 1000));
+        EgoTest_Assert(a.nextFloat() == b.nextFloat());
+    }
+}
+
+EgoTest_Test(bounds) {
+    RandomStream random(42);
+    for (size_t i = 0; i < 1000; ++i) {
+        const int x = random.next<int>(-3, 3);
+        EgoTest_Assert(-3 <= x && x <= 3);
+        const int percent = random.getPercent();
+        EgoTest_Assert(1 <= percent && percent <= 100);
+        const float f = random.nextFloat();
+        EgoTest_Assert(0.0f <= f && f <= 1.0f);
+        const float g = random.next(Interval<float>(2.0f, 3.0f));
+        EgoTest_Assert(2.0f <= g && g <= 3.0f);
+    }
+    EgoTest_Assert(7 == random.next<int>(7, 7));
+}
+
+EgoTest_Test(streams) {
+    // The streams of the subsystems are reset by the seed and independent of each other.
+    ::Random::setSeed(5);
+    const int particles = ::Random::get(::Random::Stream::Particles).next<int>(1000000);
+    ::Random::setSeed(5);
+    ::Random::get(::Random::Stream::Scripts).next<int>(1000000);
+    EgoTest_Assert(particles == ::Random::get(::Random::Stream::Particles).next<int>(1000000));
+
+    // Derived seeds depend on the subsystem and the key.
+    EgoTest_Assert(::Random::deriveSeed(::Random::Stream::Particles, 1) == ::Random::deriveSeed(::Random::Stream::Particles, 1));
+    EgoTest_Assert(::Random::deriveSeed(::Random::Stream::Particles, 1) != ::Random::deriveSeed(::Random::Stream::Particles, 2));
+    EgoTest_Assert(::Random::deriveSeed(::Random::Stream::Particles, 1) != ::Random::deriveSeed(::Random::Stream::Scripts, 1));
+}
+
+};
+
+} // namespace Test
+} // namespace Math
+} // namespace Ego
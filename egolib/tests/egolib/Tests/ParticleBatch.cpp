@@ -0,0 +1,109 @@
+//********************************************************************************************
+//*
+//*    This file is part of Egoboo.
+//*
+//*    Egoboo is free software: you can redistribute it and/or modify it
+//*    under the terms of the GNU General Public License as published by
+//*    the Free Software Foundation, either version 3 of the License, or
+//*    (at your option) any later version.
+//*
+//*    Egoboo is distributed in the hope that it will be useful, but
+//*    WITHOUT ANY WARRANTY; without even the implied warranty of
+//*    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+//*    General Public License for more details.
+//*
+//*    You should have received a copy of the GNU General Public License
+//*    along with Egoboo.  If not, see <http://www.gnu.org/licenses/>.
+//*
+//********************************************************************************************
+
+
+#include "EgoTest/EgoTest.hpp"
+#include "egolib/Graphics/ParticleBatch.hpp"
+
+namespace Ego {
+namespace Test {
+
+namespace {
+
+using Ego::Graphics::ParticleBatch;
+using Ego::Graphics::ParticleBlendMode;
+
+/// Records the draw calls of a particle batch instead of rendering them.
+struct RecordingSink : public ParticleBatch::Sink {
+    std::vector<ParticleBatch::DrawCall> drawCalls;
+    size_t quadCount = 0;
+
+    void render(const std::vector<ParticleBatch::Quad>& quads, const std::vector<ParticleBatch::DrawCall>& drawCalls) override {
+        this->drawCalls.insert(this->drawCalls.end(), drawCalls.begin(), drawCalls.end());
+        quadCount += quads.size();
+    }
+};
+
+/// The textures are only compared, never dereferenced.
+const Texture *texture(size_t index) {
+    static const char textures[4] = {};
+    return reinterpret_cast<const Texture *>(&textures[index]);
+}
+
+void add(ParticleBatch& batch, ParticleBlendMode blendMode, const Texture *texture) {
+    batch.add(blendMode, texture, Vector3f(0.0f, 0.0f, 0.0f), Vector3f(1.0f, 0.0f, 0.0f), Vector3f(0.0f, 0.0f, 1.0f),
+              1.0f, 0.0f, 0.0f, 1.0f, 1.0f, Math::Colour4f::white());
+}
+
+} // namespace
+
+EgoTest_TestCase(ParticleBatches) {
+
+    // Sorted quads are drawn with one draw call per blend mode and texture.
+    EgoTest_Test(sorted) {
+        auto sink = std::make_unique<RecordingSink>();
+        RecordingSink& recording = *sink;
+        ParticleBatch batch(std::move(sink));
+        add(batch, ParticleBlendMode::SolidEdge, texture(0));
+        add(batch, ParticleBlendMode::Solid, texture(1));
+        add(batch, ParticleBlendMode::Solid, texture(0));
+        add(batch, ParticleBlendMode::SolidEdge, texture(0));
+        add(batch, ParticleBlendMode::Solid, texture(1));
+        add(batch, ParticleBlendMode::Solid, texture(0));
+        batch.flush(true);
+
+        EgoTest_Assert(6 == recording.quadCount);
+        EgoTest_Assert(3 == recording.drawCalls.size());
+        for (size_t i = 0; i < recording.drawCalls.size(); ++i) {
+            const auto& drawCall = recording.drawCalls[i];
+            EgoTest_Assert(2 == drawCall.count);
+            for (size_t j = 0; j < i; ++j) {
+                EgoTest_Assert(drawCall.blendMode != recording.drawCalls[j].blendMode ||
+                               drawCall.texture != recording.drawCalls[j].texture);
+            }
+        }
+    }
+
+    // Unsorted quads keep their order, only consecutive quads are merged.
+    EgoTest_Test(unsorted) {
+        auto sink = std::make_unique<RecordingSink>();
+        RecordingSink& recording = *sink;
+        ParticleBatch batch(std::move(sink));
+        add(batch, ParticleBlendMode::Alpha, texture(0));
+        add(batch, ParticleBlendMode::Alpha, texture(0));
+        add(batch, ParticleBlendMode::Light, texture(0));
+        add(batch, ParticleBlendMode::Alpha, texture(0));
+        add(batch, ParticleBlendMode::Alpha, texture(1));
+        batch.flush(false);
+
+        EgoTest_Assert(4 == recording.drawCalls.size());
+        EgoTest_Assert(0 == recording.drawCalls[0].first && 2 == recording.drawCalls[0].count);
+        EgoTest_Assert(ParticleBlendMode::Light == recording.drawCalls[1].blendMode && 2 == recording.drawCalls[1].first);
+        EgoTest_Assert(3 == recording.drawCalls[2].first && texture(0) == recording.drawCalls[2].texture);
+        EgoTest_Assert(4 == recording.drawCalls[3].first && texture(1) == recording.drawCalls[3].texture);
+
+        // A flush without quads draws nothing.
+        batch.flush(false);
+        EgoTest_Assert(4 == recording.drawCalls.size());
+    }
+
+};
+
+} // namespace Test
+} // namespace Ego
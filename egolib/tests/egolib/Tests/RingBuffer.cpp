@@ -0,0 +1,99 @@
+//********************************************************************************************
+//*
+//*    This file is part of Egoboo.
+//*
+//*    Egoboo is free software: you can redistribute it and/or modify it
+//*    under the terms of the GNU General Public License as published by
+//*    the Free Software Foundation, either version 3 of the License, or
+//*    (at your option) any later version.
+//*
+//*    Egoboo is distributed in the hope that it will be useful, but
+//*    WITHOUT ANY WARRANTY; without even the implied warranty of
+//*    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+//*    General Public License for more details.
+//*
+//*    You should have received a copy of the GNU General Public License
+//*    along with Egoboo.  If not, see <http://www.gnu.org/licenses/>.
+//*
+//********************************************************************************************
+
+
+#include "EgoTest/EgoTest.hpp"
+#include "egolib/Core/RingBuffer.hpp"
+
+namespace Ego {
+namespace Test {
+
+EgoTest_TestCase(RingBuffers) {
+
+    EgoTest_Test(pushAndPop) {
+        Core::RingBuffer<std::string> buffer(3);
+        // The capacity is rounded up to a power of two.
+        EgoTest_Assert(4 == buffer.getCapacity());
+        std::string value;
+        EgoTest_Assert(!buffer.pop(value));
+
+        EgoTest_Assert(buffer.push("a"));
+        EgoTest_Assert(buffer.push("b"));
+        EgoTest_Assert(buffer.pop(value) && "a" == value);
+        EgoTest_Assert(buffer.push("c"));
+        EgoTest_Assert(buffer.push("d"));
+        EgoTest_Assert(buffer.push("e"));
+
+        // The buffer is full: The element is not pushed and not moved from.
+        std::string overflow = "f";
+        EgoTest_Assert(!buffer.push(std::move(overflow)));
+        EgoTest_Assert("f" == overflow);
+
+        // Visiting does not pop.
+        std::string visited;
+        buffer.visit([&visited](const std::string& element) { visited += element; });
+        EgoTest_Assert("bcde" == visited);
+
+        EgoTest_Assert(buffer.pop(value) && "b" == value);
+        EgoTest_Assert(buffer.pop(value) && "c" == value);
+        EgoTest_Assert(buffer.pop(value) && "d" == value);
+        EgoTest_Assert(buffer.pop(value) && "e" == value);
+        EgoTest_Assert(!buffer.pop(value));
+    }
+
+    EgoTest_Test(concurrentPush) {
+        static const int producers = 4, count = 10000;
+        Core::RingBuffer<int> buffer(64);
+        std::vector<std::thread> threads;
+        for (int i = 0; i < producers; ++i) {
+            threads.emplace_back([&buffer, i]() {
+                for (int j = 0; j < count; ++j) {
+                    while (!buffer.push(i * count + j)) {
+                        std::this_thread::yield();
+                    }
+                }
+            });
+        }
+        // Each element is popped exactly once and the elements of each producer are popped in order.
+        // Assert only after the producers are joined: a failing assertion must not leave them running.
+        std::vector<int> next(producers, 0);
+        bool ordered = true;
+        for (int popped = 0; popped < producers * count;) {
+            int value;
+            if (buffer.pop(value)) {
+                ordered = ordered && value % count == next[value / count];
+                next[value / count]++;
+                popped++;
+            } else {
+                std::this_thread::yield();
+            }
+        }
+        for (auto& thread : threads) {
+            thread.join();
+        }
+        EgoTest_Assert(ordered);
+        for (int i = 0; i < producers; ++i) {
+            EgoTest_Assert(count == next[i]);
+        }
+    }
+
+};
+
+} // namespace Test
+} // namespace Ego
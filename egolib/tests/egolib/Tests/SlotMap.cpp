@@ -0,0 +1,118 @@
+//********************************************************************************************
+//*
+//*    This file is part of Egoboo.
+//*
+//*    Egoboo is free software: you can redistribute it and/or modify it
+//*    under the terms of the GNU General Public License as published by
+//*    the Free Software Foundation, either version 3 of the License, or
+//*    (at your option) any later version.
+//*
+//*    Egoboo is distributed in the hope that it will be useful, but
+//*    WITHOUT ANY WARRANTY; without even the implied warranty of
+//*    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+//*    General Public License for more details.
+//*
+//*    You should have received a copy of the GNU General Public License
+//*    along with Egoboo.  If not, see <http://www.gnu.org/licenses/>.
+//*
+//********************************************************************************************
+
+#include "EgoTest/EgoTest.hpp"
+#include "egolib/Core/SlotMap.hpp"
+
+namespace Ego {
+namespace Test {
+
+EgoTest_TestCase(SlotMapping) {
+
+    EgoTest_Test(insertFindErase) {
+        Core::SlotMap<int> map;
+        auto a = map.insert(1);
+        auto b = map.insert(2);
+        auto c = map.insert(3);
+        EgoTest_Assert(map.size() == 3);
+        EgoTest_Assert(nullptr != map.find(a) && 1 == *map.find(a));
+        EgoTest_Assert(nullptr != map.find(b) && 2 == *map.find(b));
+        EgoTest_Assert(nullptr != map.find(c) && 3 == *map.find(c));
+
+        // Removing a value moves the last value into its place, the other handles remain valid.
+        EgoTest_Assert(map.erase(a));
+        EgoTest_Assert(!map.erase(a));
+        EgoTest_Assert(map.size() == 2);
+        EgoTest_Assert(nullptr == map.find(a));
+        EgoTest_Assert(2 == *map.find(b));
+        EgoTest_Assert(3 == *map.find(c));
+        EgoTest_Assert(nullptr == map.find(Core::SlotMap<int>::InvalidHandle));
+    }
+
+    EgoTest_Test(staleHandles) {
+        Core::SlotMap<int> map;
+        auto a = map.insert(1);
+        map.erase(a);
+
+        // The slot is reused, the stale handle does not resolve to the new value.
+        auto b = map.insert(2);
+        EgoTest_Assert(a != b);
+        EgoTest_Assert((a & Core::SlotMap<int>::IndexMask) == (b & Core::SlotMap<int>::IndexMask));
+        EgoTest_Assert(nullptr == map.find(a));
+        EgoTest_Assert(!map.erase(a));
+        EgoTest_Assert(2 == *map.find(b));
+
+        // Clearing invalidates all handles.
+        map.clear();
+        EgoTest_Assert(map.empty());
+        EgoTest_Assert(nullptr == map.find(b));
+        auto c = map.insert(3);
+        EgoTest_Assert(b != c);
+        EgoTest_Assert(nullptr == map.find(b));
+        EgoTest_Assert(3 == *map.find(c));
+    }
+
+    EgoTest_Test(insertAt) {
+        Core::SlotMap<int> map;
+        auto a = map.insert(1);
+        EgoTest_Assert(!map.insertAt(a, 2));
+
+        // A handle of a slot not yet allocated.
+        const Core::SlotMap<int>::Handle b = 7;
+        EgoTest_Assert(map.insertAt(b, 2));
+        EgoTest_Assert(2 == *map.find(b));
+        EgoTest_Assert(1 == *map.find(a));
+
+        // A handle preceding the generation of its slot is rejected.
+        map.erase(a);
+        EgoTest_Assert(!map.insertAt(a, 3));
+
+        // The slots skipped by insertAt are free.
+        for (int i = 0; i < 8; ++i)
+        {
+            map.insert(i);
+        }
+        EgoTest_Assert(map.size() == 9);
+        EgoTest_Assert(2 == *map.find(b));
+    }
+
+    EgoTest_Test(iterate) {
+        Core::SlotMap<int> map;
+        std::vector<Core::SlotMap<int>::Handle> handles;
+        for (int i = 0; i < 10; ++i)
+        {
+            handles.push_back(map.insert(i));
+        }
+        for (size_t i = 0; i < handles.size(); i += 2)
+        {
+            map.erase(handles[i]);
+        }
+        int sum = 0;
+        for (int value : map)
+        {
+            EgoTest_Assert(1 == value % 2);
+            sum += value;
+        }
+        EgoTest_Assert(25 == sum);
+    }
+
+};
+
+} // namespace Test
+} // namespace Ego
@@ -0,0 +1,157 @@
+//********************************************************************************************
+//*
+//*    This file is part of Egoboo.
+//*
+//*    Egoboo is free software: you can redistribute it and/or modify it
+//*    under the terms of the GNU General Public License as published by
+//*    the Free Software Foundation, either version 3 of the License, or
+//*    (at your option) any later version.
+//*
+//*    Egoboo is distributed in the hope that it will be useful, but
+//*    WITHOUT ANY WARRANTY; without even the implied warranty of
+//*    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+//*    General Public License for more details.
+//*
+//*    You should have received a copy of the GNU General Public License
+//*    along with Egoboo.  If not, see <http://www.gnu.org/licenses/>.
+//*
+//********************************************************************************************
+
+
+#include "EgoTest/EgoTest.hpp"
+#include "egolib/egolib.h"
+#include "egolib/VFS/VfsArchive.hpp"
+
+namespace Ego {
+namespace Test {
+
+namespace {
+
+void writeFile(const std::string& pathname, const std::string& contents) {
+    FILE *file = fopen(pathname.c_str(), "wb");
+    fputs(contents.c_str(), file);
+    fclose(file);
+}
+
+std::string readVfsFile(const std::string& pathname) {
+    std::string contents;
+    vfs_FILE *file = vfs_openRead(pathname);
+    if (file) {
+        char buffer[64];
+        size_t count;
+        while (0 < (count = vfs_read(buffer, 1, sizeof(buffer), file))) contents.append(buffer, count);
+        vfs_close(file);
+    }
+    return contents;
+}
+
+} // namespace
+
+EgoTest_TestCase(VfsArchives) {
+
+    EgoTest_Test(packAndOpen) {
+        const std::string root = "VfsArchiveTest";
+        const std::string module = root + SLASH_STR "test.mod";
+        fs_removeDirectoryAndContents(root.c_str(), 1);
+        fs_createDirectory(root);
+        fs_createDirectory(module);
+        fs_createDirectory(module + SLASH_STR "objects");
+        fs_createDirectory(module + SLASH_STR "objects" SLASH_STR "sword.obj");
+        fs_createDirectory(module + SLASH_STR ".svn");
+        writeFile(module + SLASH_STR "objects" SLASH_STR "sword.obj" SLASH_STR "data.txt", "data");
+        writeFile(module + SLASH_STR "objects" SLASH_STR "sword.txt", "sword");
+        writeFile(module + SLASH_STR ".svn" SLASH_STR "entries", "ignored");
+
+        EgoTest_Assert(VfsArchive::pack(module, module + ".pack"));
+        auto archive = VfsArchive::open(module + ".pack");
+        EgoTest_Assert(nullptr != archive);
+        EgoTest_Assert(2 == archive->getEntryCount());
+        EgoTest_Assert(archive->verify());
+
+        // Files are found by their names and their contents are aligned.
+        const VfsArchiveEntry *entry = archive->find("objects/sword.obj/data.txt");
+        EgoTest_Assert(nullptr != entry);
+        EgoTest_Assert(0 == entry->dataOffset % VfsArchive::Alignment);
+        EgoTest_Assert("data" == std::string(archive->getData(*entry), entry->size));
+        EgoTest_Assert(nullptr == archive->find("objects/sword.obj"));
+        EgoTest_Assert(nullptr == archive->find(".svn/entries"));
+
+        // Directories are the prefixes of the names.
+        EgoTest_Assert(archive->isDirectory("objects"));
+        EgoTest_Assert(archive->isDirectory("objects/sword.obj"));
+        EgoTest_Assert(!archive->isDirectory("objects/sword.txt"));
+        const std::vector<std::string> children = archive->enumerate("objects");
+        EgoTest_Assert(2 == children.size() && "sword.obj" == children[0] && "sword.txt" == children[1]);
+
+        archive = nullptr;
+        fs_removeDirectoryAndContents(root.c_str(), 1);
+    }
+
+    EgoTest_Test(staleness) {
+        const std::string root = "VfsArchiveStalenessTest";
+        const std::string module = root + SLASH_STR "test.mod";
+        fs_removeDirectoryAndContents(root.c_str(), 1);
+        fs_createDirectory(root);
+        fs_createDirectory(module);
+        fs_createDirectory(module + SLASH_STR "gamedat");
+        writeFile(module + SLASH_STR "gamedat" SLASH_STR "menu.txt", "menu");
+        EgoTest_Assert(VfsArchive::pack(module, module + ".pack"));
+        auto archive = VfsArchive::open(module + ".pack");
+        EgoTest_Assert(nullptr != archive);
+        EgoTest_Assert(!archive->isStale(module));
+
+        // Modifying, adding or removing a file makes the archive stale.
+        writeFile(module + SLASH_STR "gamedat" SLASH_STR "menu.txt", "modified");
+        EgoTest_Assert(archive->isStale(module));
+        writeFile(module + SLASH_STR "gamedat" SLASH_STR "menu.txt", "menu");
+        writeFile(module + SLASH_STR "gamedat" SLASH_STR "level.txt", "level");
+        EgoTest_Assert(archive->isStale(module));
+        fs_deleteFile(module + SLASH_STR "gamedat" SLASH_STR "level.txt");
+        fs_deleteFile(module + SLASH_STR "gamedat" SLASH_STR "menu.txt");
+        EgoTest_Assert(archive->isStale(module));
+
+        archive = nullptr;
+        fs_removeDirectoryAndContents(root.c_str(), 1);
+    }
+
+    EgoTest_Test(mountOrder) {
+        const std::string root = "VfsArchiveMountOrderTest";
+        const std::string module = root + SLASH_STR "test.mod";
+        fs_removeDirectoryAndContents(root.c_str(), 1);
+        fs_createDirectory(root);
+        fs_createDirectory(module);
+        fs_createDirectory(module + SLASH_STR "gamedat");
+        writeFile(module + SLASH_STR "gamedat" SLASH_STR "menu.txt", "packed");
+        writeFile(module + SLASH_STR "gamedat" SLASH_STR "level.txt", "packed");
+        EgoTest_Assert(VfsArchive::pack(module, module + ".pack"));
+        // A directory mounted before the archive, like the module directory of the user directory.
+        fs_createDirectory(root + SLASH_STR "user");
+        writeFile(root + SLASH_STR "user" SLASH_STR "menu.txt", "user");
+        // A directory mounted after the archive.
+        fs_createDirectory(root + SLASH_STR "data");
+        writeFile(root + SLASH_STR "data" SLASH_STR "level.txt", "data");
+        writeFile(root + SLASH_STR "data" SLASH_STR "other.txt", "data");
+
+        EgoTest_Assert(0 == vfs_init(nullptr, nullptr));
+        EgoTest_Assert(0 != vfs_add_mount_point(root, Ego::FsPath("user"), Ego::VfsPath("mp_test"), 1));
+        EgoTest_Assert(0 != vfs_add_archive_mount_point(module + ".pack", "gamedat", Ego::VfsPath("mp_test")));
+        EgoTest_Assert(0 != vfs_add_mount_point(root, Ego::FsPath("data"), Ego::VfsPath("mp_test"), 1));
+
+        // Files are found in the order the directories and the archive were mounted in.
+        EgoTest_Assert("user" == readVfsFile("mp_test/menu.txt"));
+        EgoTest_Assert("packed" == readVfsFile("mp_test/level.txt"));
+        EgoTest_Assert("data" == readVfsFile("mp_test/other.txt"));
+
+        // Written files shadow the archive once the cache is invalidated.
+        writeFile(root + SLASH_STR "user" SLASH_STR "level.txt", "user");
+        vfs_invalidateCache();
+        EgoTest_Assert("user" == readVfsFile("mp_test/level.txt"));
+
+        vfs_remove_mount_point(Ego::VfsPath("mp_test"));
+        fs_removeDirectoryAndContents(root.c_str(), 1);
+    }
+
+};
+
+} // namespace Test
+} // namespace Ego
@@ -0,0 +1,109 @@
+//********************************************************************************************
+//*
+//*    This file is part of Egoboo.
+//*
+//*    Egoboo is free software: you can redistribute it and/or modify it
+//*    under the terms of the GNU General Public License as published by
+//*    the Free Software Foundation, either version 3 of the License, or
+//*    (at your option) any later version.
+//*
+//*    Egoboo is distributed in the hope that it will be useful, but
+//*    WITHOUT ANY WARRANTY; without even the implied warranty of
+//*    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+//*    General Public License for more details.
+//*
+//*    You should have received a copy of the GNU General Public License
+//*    along with Egoboo.  If not, see <http://www.gnu.org/licenses/>.
+//*
+//********************************************************************************************
+
+
+#include "EgoTest/EgoTest.hpp"
+#include "egolib/egolib.h"
+
+namespace Ego {
+namespace Test {
+
+namespace {
+
+bool writeVfsFile(const std::string& pathname, const std::string& contents) {
+    vfs_FILE *file = vfs_openWrite(pathname);
+    if (!file) {
+        return false;
+    }
+    vfs_puts(contents.c_str(), file);
+    vfs_close(file);
+    return true;
+}
+
+std::vector<std::string> listVfsFiles(const std::string& pathname) {
+    std::vector<std::string> names;
+    SearchContext context(Ego::VfsPath(pathname), VFS_SEARCH_FILE | VFS_SEARCH_BARE);
+    for (; context.hasData(); context.nextData()) {
+        names.push_back(context.getData().string());
+    }
+    return names;
+}
+
+bool contains(const std::vector<std::string>& names, const std::string& name) {
+    return names.end() != std::find(names.begin(), names.end(), name);
+}
+
+} // namespace
+
+EgoTest_TestCase(VfsCache) {
+
+    // Writing through the VFS invalidates cached probes and listings.
+    EgoTest_Test(writes) {
+        const std::string root = fs_getUserDirectory() + SLASH_STR "VfsCacheTest";
+        EgoTest_Assert(0 == vfs_init(nullptr, nullptr));
+        fs_removeDirectoryAndContents(root.c_str(), 1);
+        EgoTest_Assert(vfs_mkdir("/VfsCacheTest"));
+        EgoTest_Assert(0 != vfs_add_mount_point(fs_getUserDirectory(), Ego::FsPath("VfsCacheTest"), Ego::VfsPath("mp_test"), 1));
+
+        // Cache a negative probe and a listing, then create the file.
+        EgoTest_Assert(!vfs_exists("mp_test/file.txt"));
+        EgoTest_Assert(!contains(listVfsFiles("mp_test"), "file.txt"));
+        EgoTest_Assert(writeVfsFile("/VfsCacheTest/file.txt", "file"));
+        EgoTest_Assert(vfs_exists("mp_test/file.txt"));
+        EgoTest_Assert(contains(listVfsFiles("mp_test"), "file.txt"));
+
+        // Cache a negative directory probe, then create the directory.
+        EgoTest_Assert(!vfs_isDirectory("mp_test/directory"));
+        EgoTest_Assert(vfs_mkdir("/VfsCacheTest/directory"));
+        EgoTest_Assert(vfs_isDirectory("mp_test/directory"));
+
+        // Cache a positive probe and a listing, then delete the file.
+        EgoTest_Assert(vfs_exists("mp_test/file.txt"));
+        EgoTest_Assert(vfs_delete_file("/VfsCacheTest/file.txt"));
+        EgoTest_Assert(!vfs_exists("mp_test/file.txt"));
+        EgoTest_Assert(!contains(listVfsFiles("mp_test"), "file.txt"));
+
+        vfs_remove_mount_point(Ego::VfsPath("mp_test"));
+        fs_removeDirectoryAndContents(root.c_str(), 1);
+    }
+
+    // Adding or removing a mount point invalidates cached probes and listings.
+    EgoTest_Test(mountPoints) {
+        const std::string root = fs_getUserDirectory() + SLASH_STR "VfsCacheMountTest";
+        EgoTest_Assert(0 == vfs_init(nullptr, nullptr));
+        fs_removeDirectoryAndContents(root.c_str(), 1);
+        EgoTest_Assert(writeVfsFile("/VfsCacheMountTest/file.txt", "file"));
+
+        EgoTest_Assert(!vfs_exists("mp_test/file.txt"));
+        EgoTest_Assert(!contains(listVfsFiles("mp_test"), "file.txt"));
+        EgoTest_Assert(0 != vfs_add_mount_point(fs_getUserDirectory(), Ego::FsPath("VfsCacheMountTest"), Ego::VfsPath("mp_test"), 1));
+        EgoTest_Assert(vfs_exists("mp_test/file.txt"));
+        EgoTest_Assert(contains(listVfsFiles("mp_test"), "file.txt"));
+
+        vfs_remove_mount_point(Ego::VfsPath("mp_test"));
+        EgoTest_Assert(!vfs_exists("mp_test/file.txt"));
+        EgoTest_Assert(!contains(listVfsFiles("mp_test"), "file.txt"));
+
+        fs_removeDirectoryAndContents(root.c_str(), 1);
+    }
+
+};
+
+} // namespace Test
+} // namespace Ego
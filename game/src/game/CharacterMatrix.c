@@ -26,9 +26,9 @@
 
 static int get_grip_verts( uint16_t grip_verts[], const ObjectRef imount, int vrt_offset );
 
-static egolib_rv matrix_cache_needs_update( Object * pchr, matrix_cache_t& pmc );
+static egolib_rv matrix_cache_needs_update( Object * pchr, matrix_cache_t& pmc, bool update_dependencies );
 static bool apply_matrix_cache( Object * pchr, matrix_cache_t& mc_tmp );
-static bool chr_get_matrix_cache( Object * pchr, matrix_cache_t& mc_tmp );
+static bool chr_get_matrix_cache( Object * pchr, matrix_cache_t& mc_tmp, bool update_dependencies );
 
 static bool apply_one_character_matrix( Object * pchr, matrix_cache_t& mcache );
 static bool apply_one_weapon_matrix( Object * pweap, matrix_cache_t& mcache );
@@ -36,6 +36,7 @@ static bool apply_one_weapon_matrix( Object * pweap, matrix_cache_t& mcache );
 static int convert_grip_to_local_points( Object * pholder, uint16_t grip_verts[], Vector4f   dst_point[] );
 static int convert_grip_to_global_points( const ObjectRef iholder, uint16_t grip_verts[], Vector4f   dst_point[] );
 
+transform_counters_t g_transform_counters;
 
 bool matrix_cache_t::isValid() const {
     return valid && matrix_valid;
@@ -59,8 +60,7 @@ bool matrix_cache_t::isValid() const {
 
     //---- check for differences in the MAT_WEAPON data
     if (HAS_SOME_BITS(this->type_bits, MAT_WEAPON)) {
-        itmp = (signed)REF_TO_INT(this->grip_chr.get()) - (signed)REF_TO_INT(rhs.grip_chr.get());
-        if (0 != itmp) return false;
+        if (this->grip_chr.get() != rhs.grip_chr.get()) return false;
 
         itmp = (signed)this->grip_slot - (signed)rhs.grip_slot;
         if (0 != itmp) return false;
@@ -166,10 +166,12 @@ int get_grip_verts( uint16_t grip_verts[], const ObjectRef imount, int vrt_offse
 }
 
 //--------------------------------------------------------------------------------------------
-bool chr_get_matrix_cache( Object * pchr, matrix_cache_t& mc_tmp )
+bool chr_get_matrix_cache( Object * pchr, matrix_cache_t& mc_tmp, bool update_dependencies )
 {
     /// @author BB
     /// @details grab the matrix cache data for a given character and put it into mc_tmp.
+    ///     If @a update_dependencies is @a false, the matrices of the mount or the overlaid
+    ///     character are assumed to be up to date.
     if ( nullptr == pchr ) return false;
     auto ichr = GET_INDEX_PCHR( pchr );
 
@@ -190,7 +192,7 @@ bool chr_get_matrix_cache( Object * pchr, matrix_cache_t& mc_tmp )
         Object * ptarget = _currentModule->getObjectHandler().get( pchr->ai.getTarget() );
 
         // make sure we have the latst info from the target
-        chr_update_matrix( ptarget, true );
+        if ( update_dependencies ) chr_update_matrix( ptarget, true );
 
         // grab the matrix cache into from the character we are overlaying
         mc_tmp = ptarget->inst.matrix_cache;
@@ -212,7 +214,7 @@ bool chr_get_matrix_cache( Object * pchr, matrix_cache_t& mc_tmp )
             Object * pmount = _currentModule->getObjectHandler().get( pchr->attachedto );
 
             // make sure we have the latst info from the target
-            chr_update_matrix( pmount, true );
+            if ( update_dependencies ) chr_update_matrix( pmount, true );
 
             // just in case the mounts's matrix cannot be corrected
             // then treat it as if it is not mounted... yuck
@@ -375,7 +377,7 @@ bool apply_one_weapon_matrix( Object * pweap, matrix_cache_t& mc_tmp )
         pweap->setPosition(Vector3f(nupoint[0][kX],nupoint[0][kY],nupoint[0][kZ]));
 
         // make sure we have the right data
-        chr_get_matrix_cache( pweap, mc_tmp );
+        chr_get_matrix_cache( pweap, mc_tmp, false );
 
         // add in the appropriate mods
         // this is a hybrid character and weapon matrix
@@ -484,7 +486,7 @@ bool apply_matrix_cache( Object * pchr, matrix_cache_t& mc_tmp )
 }
 
 //--------------------------------------------------------------------------------------------
-egolib_rv matrix_cache_needs_update( Object * pchr, matrix_cache_t& pmc )
+egolib_rv matrix_cache_needs_update( Object * pchr, matrix_cache_t& pmc, bool update_dependencies )
 {
     /// @author BB
     /// @details determine whether a matrix cache has become invalid and needs to be updated
@@ -492,7 +494,7 @@ egolib_rv matrix_cache_needs_update( Object * pchr, matrix_cache_t& pmc )
     if ( nullptr == pchr ) return rv_error;
 
     // get the matrix data that is supposed to be used to make the matrix
-    chr_get_matrix_cache( pchr, pmc );
+    chr_get_matrix_cache( pchr, pmc, update_dependencies );
 
     // compare that data to the actual data used to make the matrix
     return !(pmc == pchr->inst.matrix_cache) ? rv_success : rv_fail;
@@ -507,8 +509,6 @@ egolib_rv chr_update_matrix( Object * pchr, bool update_size )
     ///
     ///     Return true if a new matrix is applied to the character, false otherwise.
 
-    bool         needs_update = false;
-
     // recursively make sure that any mount matrices are updated
     const std::shared_ptr<Object> &holder = pchr->getHolder();
 
@@ -531,9 +531,23 @@ egolib_rv chr_update_matrix( Object * pchr, bool update_size )
         }
     }
 
+    return chr_update_own_matrix( pchr, update_size, true );
+}
+
+//--------------------------------------------------------------------------------------------
+egolib_rv chr_update_own_matrix( Object * pchr, bool update_size, bool update_dependencies )
+{
+    /// @details Set the current matrix for this character without going down the list of its mounts.
+    ///     If @a update_dependencies is @a false, the matrices and the grip vertices of the mount or
+    ///     the overlaid character must be up to date, see Ego::Physics::TransformSystem.
+    ///
+    ///     Return rv_success if a new matrix is applied to the character, rv_fail otherwise.
+
+    bool         needs_update = false;
+
     // does the matrix cache need an update at all?
     matrix_cache_t mc_tmp;
-    egolib_rv retval = matrix_cache_needs_update( pchr, mc_tmp );
+    egolib_rv retval = matrix_cache_needs_update( pchr, mc_tmp, update_dependencies );
     if ( rv_error == retval ) return rv_error;
     needs_update = ( rv_success == retval );
 
@@ -542,7 +556,7 @@ egolib_rv chr_update_matrix( Object * pchr, bool update_size )
     if ( HAS_SOME_BITS(mc_tmp.type_bits, MAT_WEAPON) && heldItem)
     {
         // has that character changes its animation?
-        if(heldItem->inst.updateGripVertices(mc_tmp.grip_verts.data(), GRIP_VERTS)) {
+        if(!update_dependencies || heldItem->inst.updateGripVertices(mc_tmp.grip_verts.data(), GRIP_VERTS)) {
             needs_update = true;
         }
     }
@@ -554,6 +568,7 @@ egolib_rv chr_update_matrix( Object * pchr, bool update_size )
         pchr->inst.matrix_cache.matrix_valid = false;
 
         if(apply_matrix_cache(pchr, mc_tmp)) {
+            g_transform_counters.matrices++;
             if(update_size) {
                 // call chr_update_collision_size() but pass in a false value to prevent a recursize call
                 pchr->getObjectPhysics().updateCollisionSize(false);
@@ -904,4 +919,6 @@ void make_one_character_matrix( const ObjectRef ichr )
 
         pchr->inst.matrix_cache.pos = pchr->getPosition();
     }
+
+    g_transform_counters.matrices++;
 }
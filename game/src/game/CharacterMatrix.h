@@ -95,9 +95,24 @@ struct matrix_cache_t : public id::equal_to_expr<matrix_cache_t>
     bool equal_to(const matrix_cache_t& other) const;
 };
 
+/// Counters of the matrix and vertex recomputations of objects, see Ego::Physics::TransformSystem
+struct transform_counters_t
+{
+    transform_counters_t() :
+        matrices(0),
+        vertices(0)
+    {}
+
+    size_t matrices;    ///< the number of character and weapon matrices recomputed
+    size_t vertices;    ///< the number of vertex range interpolations of object models
+};
+
+extern transform_counters_t g_transform_counters;
+
 //Function prototypes
 bool    chr_matrix_valid( const Object * pchr );
 egolib_rv chr_update_matrix( Object * pchr, bool update_size );
+egolib_rv chr_update_own_matrix( Object * pchr, bool update_size, bool update_dependencies );
 bool set_weapongrip( const ObjectRef iitem, const ObjectRef iholder, uint16_t vrt_off );
 bool chr_getMatUp(Object *object_ptr, Vector3f& up);
 bool chr_getMatForward(Object *object_ptr, Vector3f& forward);
@@ -32,6 +32,7 @@
 #include "game/game.h"
 #include "game/Entities/_Include.hpp"
 #include "game/Physics/CollisionSystem.hpp"
+#include "game/Physics/TransformSystem.hpp"
 
 //Global singelton
 std::unique_ptr<GameEngine> _gameEngine;
@@ -359,9 +360,16 @@ bool GameEngine::initialize()
     // Initialize the profile system.
     ProfileSystem::initialize();
 
+    // Initialize the character exporter and complete exports interrupted by the last termination of the game.
+    CharacterExporter::initialize();
+    CharacterExporter::recoverAll(fs_getUserDirectory() + SLASH_STR "players");
+
     // Initialize the collision system.
     Ego::Physics::CollisionSystem::initialize();
 
+    // Initialize the transform system.
+    Ego::Physics::TransformSystem::initialize();
+
     // Load all modules
     renderPreloadText("Loading modules...");
     ProfileSystem::get().loadModuleProfiles();
@@ -438,12 +446,18 @@ void GameEngine::uninitialize()
     // @todo This should be 'UIManager::uninitialize'.
     _uiManager.reset(nullptr);
 
+    // Uninitialize the transform system.
+    Ego::Physics::TransformSystem::uninitialize();
+
     // Uninitialize the collision system.
     Ego::Physics::CollisionSystem::uninitialize();
 
     // Uninitialize the scripting system.
     scripting_system_end();
 
+    // Uninitialize the character exporter. Pending exports are completed.
+    CharacterExporter::uninitialize();
+
     // Uninitialize the profile system.
     ProfileSystem::uninitialize();
 
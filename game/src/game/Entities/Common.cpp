@@ -1,7 +1,6 @@
 #include "game/Entities/Common.hpp"
 
 PhysicsData::PhysicsData() :
-    phys(),
     targetplatform_level(0.0f),
     targetplatform_ref(),
     onwhichplatform_ref(),
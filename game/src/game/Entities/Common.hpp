@@ -122,8 +122,6 @@ public:
 
 struct PhysicsData
 {
-    /// @brief The entity's physics data.
-    phys_data_t phys;
     /// @brief What is the height of the target platform?
     float targetplatform_level;  
     /// @brief Am I trying to attach to a platform?
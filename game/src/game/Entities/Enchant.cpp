@@ -169,11 +169,11 @@ Enchantment::~Enchantment()
             }
             else if(Ego::Attribute::isOverrideSetAttribute(modifier._type)) {
                 //remove effect completely
-                target->getTempAttributes().erase(modifier._type);
+                target->getAttributeSet().removeModifier(modifier._type);
             }
             else {
                 //remove cumulative bonus/penality
-                target->getTempAttributes()[modifier._type] -= modifier._value;
+                target->getAttributeSet().addModifier(modifier._type, -modifier._value);
             }
         }
     }
@@ -181,8 +181,8 @@ Enchantment::~Enchantment()
     //Remove boost effects from owner
     std::shared_ptr<Object> owner = _owner.lock();
     if(owner != nullptr && !owner->isTerminated()) {
-        owner->getTempAttributes()[Ego::Attribute::MANA_REGEN] -= _ownerManaSustain;
-        owner->getTempAttributes()[Ego::Attribute::LIFE_REGEN] -= _ownerLifeSustain;
+        owner->getAttributeSet().addModifier(Ego::Attribute::MANA_REGEN, -_ownerManaSustain);
+        owner->getAttributeSet().addModifier(Ego::Attribute::LIFE_REGEN, -_ownerLifeSustain);
     }
 }
 
@@ -349,7 +349,7 @@ void Enchantment::applyEnchantment(std::shared_ptr<Object> target)
     // Create an overlay character?
     if (_enchantProfile->spawn_overlay)
     {
-        std::shared_ptr<Object> overlay = _currentModule->spawnObject(target->getPosition(), _spawnerProfileID, target->team, 0, target->ori.facing_z, "", ObjectRef::Invalid );
+        std::shared_ptr<Object> overlay = _currentModule->spawnObject(target->getPosition(), _spawnerProfileID, target->getTeamRef(), 0, target->ori.facing_z, "", ObjectRef::Invalid );
         if (overlay)
         {
             _overlay = overlay;                             //Kill this character on end...
@@ -379,7 +379,7 @@ void Enchantment::applyEnchantment(std::shared_ptr<Object> target)
         }
 
         //Is there no conflict?
-        if(target->getTempAttributes().find(modifier._type) == target->getTempAttributes().end()) {
+        if(!target->getAttributeSet().hasModifier(modifier._type)) {
             return false;
         }
 
@@ -436,7 +436,7 @@ void Enchantment::applyEnchantment(std::shared_ptr<Object> target)
         //Morph is special and handled differently than others
         if(modifier._type == Ego::Attribute::MORPH) {
             //Store target's original armor
-            target->getTempAttributes()[Ego::Attribute::MORPH] = target->skin;
+            target->getAttributeSet().setModifier(Ego::Attribute::MORPH, target->skin);
 
             //Transform the object
             target->polymorphObject(ObjectProfileRef(_spawnerProfileID), 0);
@@ -444,20 +444,20 @@ void Enchantment::applyEnchantment(std::shared_ptr<Object> target)
 
         //Is it a set type?
         else if(Ego::Attribute::isOverrideSetAttribute(modifier._type)) {
-            target->getTempAttributes()[modifier._type] = modifier._value;
+            target->getAttributeSet().setModifier(modifier._type, modifier._value);
         }
 
         //It's a cumulative addition
         else {
-            target->getTempAttributes()[modifier._type] += modifier._value;            
+            target->getAttributeSet().addModifier(modifier._type, modifier._value);            
         }
     }
 
     //Finally apply boost values to owner as well
     std::shared_ptr<Object> owner = _owner.lock();
     if(owner != nullptr && !owner->isTerminated()) {
-        owner->getTempAttributes()[Ego::Attribute::MANA_REGEN] += _ownerManaSustain;
-        owner->getTempAttributes()[Ego::Attribute::LIFE_REGEN] += _ownerLifeSustain;
+        owner->getAttributeSet().addModifier(Ego::Attribute::MANA_REGEN, _ownerManaSustain);
+        owner->getAttributeSet().addModifier(Ego::Attribute::LIFE_REGEN, _ownerLifeSustain);
     }
 
     //Insert this enchantment into the Objects list of active enchants
@@ -488,10 +488,10 @@ void Enchantment::setBoostValues(float ownerManaSustain, float ownerLifeSustain,
     //Update boost effects to owner
     std::shared_ptr<Object> owner = _owner.lock();
     if(owner && !owner->isTerminated()) {
-        owner->getTempAttributes()[Ego::Attribute::MANA_REGEN] -= _ownerManaSustain;
-        owner->getTempAttributes()[Ego::Attribute::LIFE_REGEN] -= _ownerLifeSustain;
-        owner->getTempAttributes()[Ego::Attribute::MANA_REGEN] += ownerManaSustain;
-        owner->getTempAttributes()[Ego::Attribute::LIFE_REGEN] += ownerLifeSustain;
+        owner->getAttributeSet().addModifier(Ego::Attribute::MANA_REGEN, -_ownerManaSustain);
+        owner->getAttributeSet().addModifier(Ego::Attribute::LIFE_REGEN, -_ownerLifeSustain);
+        owner->getAttributeSet().addModifier(Ego::Attribute::MANA_REGEN, ownerManaSustain);
+        owner->getAttributeSet().addModifier(Ego::Attribute::LIFE_REGEN, ownerLifeSustain);
     }
     _ownerManaSustain = ownerManaSustain;
     _ownerLifeSustain = ownerLifeSustain;
@@ -501,14 +501,14 @@ void Enchantment::setBoostValues(float ownerManaSustain, float ownerLifeSustain,
     if(target != nullptr) {
         for(EnchantModifier &modifier : _modifiers) {
             if(modifier._type == Ego::Attribute::MANA_REGEN) {
-                target->getTempAttributes()[Ego::Attribute::MANA_REGEN] -= modifier._value;
+                target->getAttributeSet().addModifier(Ego::Attribute::MANA_REGEN, -modifier._value);
                 modifier._value = -targetManaDrain;
-                target->getTempAttributes()[Ego::Attribute::MANA_REGEN] += modifier._value;
+                target->getAttributeSet().addModifier(Ego::Attribute::MANA_REGEN, modifier._value);
             }
             else if(modifier._type == Ego::Attribute::LIFE_REGEN) {
-                target->getTempAttributes()[Ego::Attribute::LIFE_REGEN] -= modifier._value;
+                target->getAttributeSet().addModifier(Ego::Attribute::LIFE_REGEN, -modifier._value);
                 modifier._value = -targetLifeDrain;
-                target->getTempAttributes()[Ego::Attribute::LIFE_REGEN] += modifier._value;            
+                target->getAttributeSet().addModifier(Ego::Attribute::LIFE_REGEN, modifier._value);            
             }
         }        
     }  
@@ -53,7 +53,10 @@ constexpr float Object::DROPZVEL;
 /// @todo Remove this if GCC & Clang are fixed.
 constexpr float Object::DISMOUNTZVEL;
 
-Object::Object(ObjectProfileRef proRef, ObjectRef objRef) : 
+Object::Object(ObjectProfileRef proRef, ObjectRef objRef, const std::shared_ptr<ObjectHotStateStore>& hotStates) : 
+    _hotStates(hotStates),
+    _hotState(hotStates->allocate(*this)),
+    phys(_hotState.phys),
     spawn_data(),
     ai(),
     gender(Gender::Male),
@@ -63,7 +66,7 @@ Object::Object(ObjectProfileRef proRef, ObjectRef objRef) :
     ammo(0),
     holdingwhich(),
     equipment(),
-    team(Team::TEAM_NULL),
+    _team(Team::TEAM_NULL),
     team_base(Team::TEAM_NULL),
     fat_stt(0.0f),
     fat(0.0f),
@@ -115,9 +118,9 @@ Object::Object(ObjectProfileRef proRef, ObjectRef objRef) :
     bump_stt(),
     bump(),
     bump_save(),
-    bump_1(),      
-    chr_max_cv(),  
-    chr_min_cv(),  
+    bump_1(),
+    chr_max_cv(),
+    chr_min_cv(),
     slot_cv(),
 
     stoppedby(0),
@@ -125,6 +128,7 @@ Object::Object(ObjectProfileRef proRef, ObjectRef objRef) :
     ori(),
     ori_old(),
     bumplist_next(),
+    passageTiles(Index2D(0, 0), Index2D(-1, -1)),
 
     turnmode(TURNMODE_VELOCITY),
 
@@ -142,8 +146,7 @@ Object::Object(ObjectProfileRef proRef, ObjectRef objRef) :
 
     _currentLife(0.0f),
     _currentMana(0.0f),
-    _baseAttribute(),
-    _tempAttribute(),
+    _attributes(),
 
     _inventory(),
     _money(0),
@@ -173,9 +176,6 @@ Object::Object(ObjectProfileRef proRef, ObjectRef objRef) :
     // Grip info
     holdingwhich.fill(ObjectRef::Invalid);
 
-    //Clear initial base attributes
-    _baseAttribute.fill(0.0f);
-
     // pack/inventory info
     equipment.fill(ObjectRef::Invalid);
 
@@ -186,7 +186,7 @@ Object::Object(ObjectProfileRef proRef, ObjectRef objRef) :
     //Initialize primary attributes
     for(size_t i = 0; i < Ego::Attribute::NR_OF_PRIMARY_ATTRIBUTES; ++i) {
         const Ego::Math::Interval<float>& baseRange = _profile->getAttributeBase(static_cast<Ego::Attribute::AttributeType>(i));
-        _baseAttribute[i] = Random::next(baseRange);
+        _attributes.setBase(static_cast<Ego::Attribute::AttributeType>(i), Random::next(baseRange));
     }
 
     //Initialize timer to a random value
@@ -214,14 +214,16 @@ Object::~Object()
             _currentModule->getTeamList()[team_base].decreaseMorale();
         }
 
-        if ( _currentModule->getTeamList()[team].getLeader().get() == this )
+        if ( _currentModule->getTeamList()[_team].getLeader().get() == this )
         {
-            _currentModule->getTeamList()[team].setLeader(INVALID_OBJECT);
+            _currentModule->getTeamList()[_team].setLeader(INVALID_OBJECT);
         }
 
         // remove any attached particles
         disaffirm_attached_particles(getObjRef());    
     }
+
+    _hotStates->release(_hotState);
 }
 
 bool Object::setSkin(const size_t skinNumber)
@@ -233,15 +235,15 @@ bool Object::setSkin(const size_t skinNumber)
 
     //Damage resistance and modifiers from Armour
     for(size_t i = 0; i < DAMAGE_COUNT; ++i) {
-        _baseAttribute[Ego::Attribute::resistFromDamageType(static_cast<DamageType>(i))] = newSkin.damageResistance[i];
-        _baseAttribute[Ego::Attribute::modifierFromDamageType(static_cast<DamageType>(i))] = newSkin.damageModifier[i];
+        _attributes.setBase(Ego::Attribute::resistFromDamageType(static_cast<DamageType>(i)), newSkin.damageResistance[i]);
+        _attributes.setBase(Ego::Attribute::modifierFromDamageType(static_cast<DamageType>(i)), newSkin.damageModifier[i]);
     }
 
     //Armour movement speed
-    _baseAttribute[Ego::Attribute::ACCELERATION] = newSkin.maxAccel;
+    _attributes.setBase(Ego::Attribute::ACCELERATION, newSkin.maxAccel);
 
     //Defence from Armour
-    _baseAttribute[Ego::Attribute::DEFENCE] = newSkin.defence;
+    _attributes.setBase(Ego::Attribute::DEFENCE, newSkin.defence);
 
     //Set new skin
     this->skin = skinNumber;
@@ -884,13 +886,13 @@ void Object::update()
 
             //Danger Sense reveals enemies on the minimap
             if(hasPerk(Ego::Perks::DANGER_SENSE)) {
-                local_stats.sense_enemies_team = this->team;
+                local_stats.sense_enemies_team = _team;
                 local_stats.sense_enemies_idsz = IDSZ2::None;     //Reveal all
             }
 
             //Danger Sense reveals enemies on the minimap
             else if(hasPerk(Ego::Perks::SENSE_UNDEAD)) {
-                local_stats.sense_enemies_team = this->team;
+                local_stats.sense_enemies_team = _team;
                 local_stats.sense_enemies_idsz = IDSZ2('U','N','D','E');     //Reveal only undead
             }
         }        
@@ -1215,11 +1217,11 @@ bool Object::detatchFromHolder(const bool ignoreKurse, const bool doShop)
     // Reset the team if it is a mount
     if ( pholder->isMount() )
     {
-        pholder->team = pholder->team_base;
+        pholder->assignTeam(pholder->team_base);
         SET_BIT( pholder->ai.alert, ALERTIF_DROPPED );
     }
 
-    team = team_base;
+    assignTeam(team_base);
     SET_BIT( ai.alert, ALERTIF_DROPPED );
 
     // Reset transparency
@@ -1363,7 +1365,8 @@ void Object::checkLevelUp()
 
             //Primary Attribute increase
             for(size_t i = 0; i < Ego::Attribute::NR_OF_PRIMARY_ATTRIBUTES; ++i) {
-                _baseAttribute[i] += Random::next(getProfile()->getAttributeGain(static_cast<Ego::Attribute::AttributeType>(i)));
+                const auto type = static_cast<Ego::Attribute::AttributeType>(i);
+                _attributes.setBase(type, _attributes.getBase(type) + Random::next(getProfile()->getAttributeGain(type)));
             }
 
             //Grab random Perk? (ZF> just uncomment if we want to do this for AI characters as well)
@@ -1435,6 +1438,7 @@ void Object::kill(const std::shared_ptr<Object> &originalKiller, bool ignoreInvi
     _currentLife    = -1.0f;
     platform        = true;
     canuseplatforms = true;
+    _currentModule->getObjectHandler().updateCategories(*this);
     phys.bumpdampen = phys.bumpdampen * 0.5f;
     setBumpWidth(bump_stt.size * 0.5f);
 
@@ -1489,28 +1493,44 @@ void Object::kill(const std::shared_ptr<Object> &originalKiller, bool ignoreInvi
     //and distribute experience to whoever needs it
     SET_BIT(ai.alert, ALERTIF_KILLED);
 
-    for(const std::shared_ptr<Object> &listener : _currentModule->getObjectHandler().iterator())
-    {
-        if (!listener->isAlive()) continue;
+    ObjectHandler& objectHandler = _currentModule->getObjectHandler();
 
-        // All allies get team experience, but only if they also hate the dead guy's team
-        if (actualKiller && listener != actualKiller && !listener->getTeam().hatesTeam(actualKiller->getTeam()) && listener->getTeam().hatesTeam(getTeam()) )
+    // All allies get team experience, but only if they also hate the dead guy's team
+    if (actualKiller)
+    {
+        for (const Team& team : _currentModule->getTeamList())
         {
-            listener->giveExperience(experience, XP_TEAMKILL, false);
+            if (team.hatesTeam(actualKiller->getTeam()) || !team.hatesTeam(getTeam())) continue;
+
+            // Copy the members, giving experience must not invalidate the iteration
+            const std::vector<ObjectRef> members = objectHandler.getTeamMembers(team.toRef());
+            for (ObjectRef member : members)
+            {
+                Object *listener = objectHandler.get(member);
+                if (nullptr == listener || listener->isTerminated() || !listener->isAlive() || listener == actualKiller.get()) continue;
+                listener->giveExperience(experience, XP_TEAMKILL, false);
+            }
         }
+    }
 
-        // Check if we were a leader
-        if ( getTeam().getLeader().get() == this && listener->getTeam() == getTeam() )
+    // Check if we were a leader
+    if ( getTeam().getLeader().get() == this )
+    {
+        // All folks on the leaders team get the alert
+        for (ObjectRef member : objectHandler.getTeamMembers(_team))
         {
-            // All folks on the leaders team get the alert
+            Object *listener = objectHandler.get(member);
+            if (nullptr == listener || listener->isTerminated() || !listener->isAlive()) continue;
             SET_BIT( listener->ai.alert, ALERTIF_LEADERKILLED );
         }
+    }
 
-        // Let the other characters know it died
-        if ( listener->ai.getTarget() == getObjRef() )
-        {
-            SET_BIT( listener->ai.alert, ALERTIF_TARGETKILLED );
-        }
+    // Let the other characters know it died
+    for (ObjectRef targeter : objectHandler.getTargetedBy(getObjRef()))
+    {
+        Object *listener = objectHandler.get(targeter);
+        if (nullptr == listener || listener->isTerminated() || !listener->isAlive()) continue;
+        SET_BIT( listener->ai.alert, ALERTIF_TARGETKILLED );
     }
 
     // Detach the character from the game
@@ -1671,13 +1691,13 @@ void Object::removeFromGame(Object *obj)
 	obj->sparkle = NOSPARKLE;
 
 	// Remove it from the team
-	obj->team = obj->team_base;
-	_currentModule->getTeamList()[obj->team].decreaseMorale();
+	obj->assignTeam(obj->team_base);
+	_currentModule->getTeamList()[obj->getTeamRef()].decreaseMorale();
 
-	if (_currentModule->getTeamList()[obj->team].getLeader().get() == obj)
+	if (_currentModule->getTeamList()[obj->getTeamRef()].getLeader().get() == obj)
 	{
 		// The team now has no leader if the character is the leader
-		_currentModule->getTeamList()[obj->team].setLeader(Object::INVALID_OBJECT);
+		_currentModule->getTeamList()[obj->getTeamRef()].setLeader(Object::INVALID_OBJECT);
 	}
 
 	// Clear all shop passages that it owned..
@@ -1863,7 +1883,7 @@ void Object::respawn()
     _currentMana = getAttribute(Ego::Attribute::MAX_MANA);
     setPosition(getSpawnPosition());
     setVelocity(Vector3f::zero());
-    team = team_base;
+    assignTeam(team_base);
     canbecrushed = false;
     ori.map_twist_facing_y = orientation_t::MAP_TURN_OFFSET;  // These two mean on level surface
     ori.map_twist_facing_x = orientation_t::MAP_TURN_OFFSET;
@@ -1891,7 +1911,8 @@ void Object::respawn()
 
     platform        = profile->isPlatform();
     canuseplatforms = profile->canUsePlatforms();
-    _baseAttribute[Ego::Attribute::FLY_TO_HEIGHT] = profile->getFlyHeight();
+    _currentModule->getObjectHandler().updateCategories(*this);
+    _attributes.setBase(Ego::Attribute::FLY_TO_HEIGHT, profile->getFlyHeight());
     phys.bumpdampen = profile->getBumpDampen();
 
     ai.alert = ALERTIF_CLEANEDUP;
@@ -2013,34 +2034,25 @@ float Object::getDamageReduction(const DamageType type, const bool includeArmor)
 
 float Object::getBaseAttribute(const Ego::Attribute::AttributeType type) const
 {
-    EGOBOO_ASSERT(type < _baseAttribute.size() && type != Ego::Attribute::NR_OF_PRIMARY_ATTRIBUTES);
-    return _baseAttribute[type];
+    EGOBOO_ASSERT(type < Ego::AttributeSet::Count && type != Ego::Attribute::NR_OF_PRIMARY_ATTRIBUTES);
+    return _attributes.getBase(type);
 }
 
 void Object::setBaseAttribute(const Ego::Attribute::AttributeType type, float value)
 {
-    EGOBOO_ASSERT(type < _baseAttribute.size() && type != Ego::Attribute::NR_OF_PRIMARY_ATTRIBUTES);
-    _baseAttribute[type] = value;
+    EGOBOO_ASSERT(type < Ego::AttributeSet::Count && type != Ego::Attribute::NR_OF_PRIMARY_ATTRIBUTES);
+    _attributes.setBase(type, value);
 }
 
 float Object::getAttribute(const Ego::Attribute::AttributeType type) const 
 { 
-    EGOBOO_ASSERT(type < _baseAttribute.size() && type != Ego::Attribute::NR_OF_PRIMARY_ATTRIBUTES);
-
-    float attributeValue = _baseAttribute[type];
+    EGOBOO_ASSERT(type < Ego::AttributeSet::Count && type != Ego::Attribute::NR_OF_PRIMARY_ATTRIBUTES);
 
-    //Try to find temp value in map, but don't create it if it doesn't already exist
-    const auto& result = _tempAttribute.find(type);
-    if(result != _tempAttribute.end()) {
-
-        //Is this a SET type attribute or a cumulative ADD type attribute?
-        if(isOverrideSetAttribute(type)) {
-            return (*result).second;
-        }
-        else {
-            //Total value is base plus temp bonuses from enchants
-            attributeValue += (*result).second;
-        }
+    //Base value with the enchant modifiers applied, either overridden by a SET type modifier
+    //or plus the cumulative ADD type modifiers
+    float attributeValue = _attributes.getEffective(type);
+    if(_attributes.isOverridden(type)) {
+        return attributeValue;
     }
 
     switch(type) {
@@ -2097,8 +2109,8 @@ float Object::getAttribute(const Ego::Attribute::AttributeType type) const
 
 void Object::increaseBaseAttribute(const Ego::Attribute::AttributeType type, float value)
 {
-    EGOBOO_ASSERT(type < _baseAttribute.size() && type != Ego::Attribute::NR_OF_PRIMARY_ATTRIBUTES);
-    _baseAttribute[type] = Ego::Math::constrain(_baseAttribute[type] + value, 0.0f, 255.0f);
+    EGOBOO_ASSERT(type < Ego::AttributeSet::Count && type != Ego::Attribute::NR_OF_PRIMARY_ATTRIBUTES);
+    _attributes.setBase(type, Ego::Math::constrain(_attributes.getBase(type) + value, 0.0f, 255.0f));
 
     //Handle current life and mana increase as well
     if(type == Ego::Attribute::MAX_LIFE) {
@@ -2225,9 +2237,9 @@ bool Object::disenchant()
     return oneRemoved;
 }
 
-std::unordered_map<Ego::Attribute::AttributeType, float, std::hash<uint8_t>>& Object::getTempAttributes()
+Ego::AttributeSet& Object::getAttributeSet()
 {
-    return _tempAttribute;
+    return _attributes;
 }
 
 bool Object::isFlying() const
@@ -2356,6 +2368,7 @@ void Object::polymorphObject(ObjectProfileRef profileID, const SKIN_T newSkin)
     canuseplatforms = _profile->canUsePlatforms();
     isitem          = _profile->isItem();
     invictus        = _profile->isInvincible();
+    _currentModule->getObjectHandler().updateCategories(*this);
     jump_timer      = JUMPDELAY;
     reaffirm_damagetype = _profile->getReaffirmDamageType();
 
@@ -2670,7 +2683,7 @@ void Object::setTeam(TEAM_REF team_new, bool permanent)
     const bool canHaveTeam = !isItem() && isAlive() && !isInvincible();
 
     // take the character off of its old team
-    if ( VALID_TEAM_RANGE(this->team) )
+    if ( VALID_TEAM_RANGE(_team) )
     {
         // remove the character from the old team
         if ( canHaveTeam )
@@ -2691,11 +2704,11 @@ void Object::setTeam(TEAM_REF team_new, bool permanent)
     }
 
     // place the character onto its new team
-    this->team = team_new;
+    assignTeam(team_new);
 
     // switch the base team only if required
     if (permanent) {
-        team_base = this->team;
+        team_base = _team;
     }
 
     // add the character to the new team
@@ -2724,6 +2737,15 @@ void Object::setTeam(TEAM_REF team_new, bool permanent)
     }
 }
 
+void Object::assignTeam(TEAM_REF team)
+{
+    const TEAM_REF oldTeam = _team;
+    _team = team;
+    if(_currentModule && oldTeam != team) {
+        _currentModule->getObjectHandler().onTeamChanged(getObjRef(), oldTeam, team);
+    }
+}
+
 bool Object::hasSkillIDSZ(const IDSZ2& whichskill) const
 {
     if (isTerminated()) return false;
@@ -2867,7 +2889,7 @@ void Object::dropKeys()
         pkey->hitready               = true;
         pkey->isequipped             = false;
         pkey->ori.facing_z           = Facing(FACING_T(direction + Facing::ATK_BEHIND));
-        pkey->team                   = pkey->team_base;
+        pkey->assignTeam(pkey->team_base);
 
         // fix the current velocity
         pkey->setVelocity(pkey->getVelocity() + 
@@ -2923,7 +2945,7 @@ void Object::dropAllItems()
         // fix some flags
         pitem->hitready               = true;
         pitem->ori.facing_z           = Facing(FACING_T(Facing(direction) + Facing::ATK_BEHIND));
-        pitem->team                   = pitem->team_base;
+        pitem->assignTeam(pitem->team_base);
 
         // fix the current velocity
         pitem->setVelocity(pitem->getVelocity() +
@@ -28,6 +28,7 @@
 
 #include "egolib/Script/script.h"
 #include "egolib/Logic/Team.hpp"
+#include "egolib/Logic/AttributeSet.hpp"
 #include "egolib/InputControl/InputDevice.hpp"
 
 #include "game/egoboo.h"
@@ -35,6 +36,7 @@
 #include "game/physics.h"
 #include "game/graphic_mad.h"
 #include "game/Entities/Common.hpp"
+#include "game/Entities/ObjectHotState.hpp"
 #include "game/Graphics/BillboardSystem.hpp"
 #include "game/Inventory.hpp"
 #include "game/Physics/Collidable.hpp"
@@ -118,8 +120,10 @@ public:
      *  the profile reference of the profile this object should be spawned with
      * @param objRef
      *  the unique object reference of this object
+     * @param hotStates
+     *  the store to allocate the hot state of this object from
      */
-    Object(ObjectProfileRef proRef, ObjectRef objRef);
+    Object(ObjectProfileRef proRef, ObjectRef objRef, const std::shared_ptr<ObjectHotStateStore>& hotStates);
 
     /**
      * @brief
@@ -162,7 +166,12 @@ public:
     /**
     * @return the current team this object is on. This can change in-game (mounts or pets for example)
     **/
-    Team& getTeam() const { return _currentModule->getTeamList()[team]; }
+    Team& getTeam() const { return _currentModule->getTeamList()[_team]; }
+
+    /**
+    * @return the index of the current team this object is on
+    **/
+    TEAM_REF getTeamRef() const { return _team; }
 
     /**
     * @brief
@@ -681,7 +690,11 @@ public:
     **/
     bool setSkin(const size_t skinNumber);
 
-    std::unordered_map<Ego::Attribute::AttributeType, float, std::hash<uint8_t>>& getTempAttributes();
+    /**
+    * @brief
+    *   Get the base values and enchantment modifiers of the attributes of this Object.
+    **/
+    Ego::AttributeSet& getAttributeSet();
 
     std::shared_ptr<Ego::Enchantment> getLastEnchantmentSpawned() const;
 
@@ -754,6 +767,13 @@ public:
     **/
     void setTeam(TEAM_REF team, bool permanent = true);
 
+    /**
+    * @brief
+    *   Move this Object to another team without changing team morale or leadership.
+    *   The team index of the ObjectHandler is updated accordingly.
+    **/
+    void assignTeam(TEAM_REF team);
+
     /**
     * @brief
     *   checks if the object has a matching skill IDSZ. This function also maps between the old skill IDSZ
@@ -847,7 +867,14 @@ private:
 
     void updateLatchButtons();
 
+private:
+    // Declared before the references into the hot state below.
+    std::shared_ptr<ObjectHotStateStore> _hotStates; ///< The store owning the hot state
+    ObjectHotState& _hotState;                       ///< The physics accumulators of this object
+
 public:
+    phys_data_t& phys;                               ///< The physics accumulators
+
     chr_spawn_data_t  spawn_data;
 
     // character state
@@ -867,7 +894,9 @@ public:
     std::array<ObjectRef, INVEN_COUNT> equipment;   ///< != ObjectRef::Invalid if character has equipped something
 
     // team stuff
-    TEAM_REF       team;            ///< Character's team
+private:
+    TEAM_REF       _team;           ///< Character's team, see assignTeam()
+public:
     TEAM_REF       team_base;        ///< Character's starting team
 
     float          fat_stt;                       ///< Character's initial size
@@ -955,6 +984,7 @@ public:
 
 
     ObjectRef bumplist_next;                      ///< Next character on fanblock
+    IndexRect passageTiles;                       ///< The tiles this character was last registered in as a passage occupant
 
     // movement properties
     turn_mode_t  turnmode;                        ///< Turning mode
@@ -986,8 +1016,7 @@ private:
     //Attributes
     float _currentLife;
     float _currentMana;
-    std::array<float, Ego::Attribute::NR_OF_ATTRIBUTES> _baseAttribute; ///< Character attributes
-    std::unordered_map<Ego::Attribute::AttributeType, float, std::hash<uint8_t>> _tempAttribute; ///< Character attributes with enchants
+    Ego::AttributeSet _attributes;                       ///< Character attributes and their modifiers from enchants
 
     Inventory _inventory;
     uint16_t  _money;                                    ///< Money
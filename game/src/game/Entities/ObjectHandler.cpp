@@ -21,6 +21,27 @@
 #include "game/Entities/ObjectHandler.hpp"
 #include "egolib/Profiles/_Include.hpp"
 #include "game/Entities/Object.hpp"
+#include "game/Module/Module.hpp"
+
+namespace {
+
+void addUnique(std::vector<ObjectRef>& list, ObjectRef ref)
+{
+    if (std::find(list.begin(), list.end(), ref) == list.end()) {
+        list.push_back(ref);
+    }
+}
+
+void removeUnordered(std::vector<ObjectRef>& list, ObjectRef ref)
+{
+    auto it = std::find(list.begin(), list.end(), ref);
+    if (it != list.end()) {
+        *it = list.back();
+        list.pop_back();
+    }
+}
+
+}
 
 ObjectRef GET_INDEX_PCHR(const Object *pobj) {
     return (nullptr == pobj) ? ObjectRef::Invalid : pobj->getObjRef();
@@ -35,16 +56,20 @@ bool INGAME_PCHR(const Object *pobj)
 
 ObjectHandler::ObjectHandler() :
 	_internalCharacterList(),
+    _hotStates(std::make_shared<ObjectHotStateStore>()),
     _iteratorList(),
     _allocateList(),
 
     _semaphore(0),
     _deletedCharacters(0),
-    _totalCharactersSpawned(0),
+    _teamMembers(),
+    _targetedBy(),
+    _categories(),
     _dynamicObjects(),
     _staticObjects(),
     _updateStaticTreeClock(0)
 {
+    _internalCharacterList.reserve(OBJECTS_MAX);
     _iteratorList.reserve(OBJECTS_MAX);
 }
 
@@ -57,32 +82,62 @@ bool ObjectHandler::remove(ObjectRef ref) {
 	chr_log_script_time(ref.get());
 #endif
 
+	const std::shared_ptr<Object> object = *_internalCharacterList.find(ref.get());
+
 	//Remove us from any holder first
-	_internalCharacterList[ref]->detatchFromHolder(true, false);
+	object->detatchFromHolder(true, false);
 
 	// If we are inside a list loop, do not actually change the length of the
 	// list. Else this can cause some problems later.
-	_internalCharacterList[ref]->_terminateRequested = true; //bad: private access
+	object->_terminateRequested = true; //bad: private access
 	_deletedCharacters++;
 
+	// Make sure everyone knows it died.
+	auto targeters = _targetedBy.find(ref);
+	if (targeters != _targetedBy.end()) {
+		for (ObjectRef targeter : targeters->second) {
+			Object *chr = get(targeter);
+			if (nullptr != chr && !chr->isTerminated()) {
+				SET_BIT(chr->ai.alert, ALERTIF_TARGETKILLED);
+			}
+		}
+		_targetedBy.erase(targeters);
+	}
+	for (const Team& team : _currentModule->getTeamList()) {
+		if (team.getLeader() != object) continue;
+		for (ObjectRef member : _teamMembers[team.toRef()]) {
+			Object *chr = get(member);
+			if (nullptr != chr && !chr->isTerminated()) {
+				SET_BIT(chr->ai.alert, ALERTIF_LEADERKILLED);
+			}
+		}
+	}
+
+	// Remove us from the secondary indices.
+	removeUnordered(_teamMembers[object->getTeamRef()], ref);
+	const ObjectRef target = object->ai.getTarget();
+	if (target != ref) {
+		onTargetChanged(ref, target, ObjectRef::Invalid);
+	}
+	for (std::vector<ObjectRef>& category : _categories) {
+		removeUnordered(category, ref);
+	}
+	_currentModule->removePassageOccupant(*object);
+
 	// We can safely modify the map, it is not iterable from the outside.
-	_internalCharacterList.erase(ref);
+	_internalCharacterList.erase(ref.get());
 
 	return true;
 }
 
 bool ObjectHandler::exists(ObjectRef ref) const {
-	if (ref == ObjectRef::Invalid || ref.get() >= _totalCharactersSpawned) {
+	// Check if object exists in map, stale references of removed objects do not resolve.
+	const auto result = _internalCharacterList.find(ref.get());
+	if (nullptr == result || nullptr == *result) {
 		return false;
 	}
 
-	// Check if object exists in map.
-	const auto& result = _internalCharacterList.find(ref);
-	if (result == _internalCharacterList.end()) {
-		return false;
-	}
-
-	return !(*result).second->isTerminated();
+	return !(*result)->isTerminated();
 }
 
 std::shared_ptr<Object> ObjectHandler::insert(ObjectProfileRef profileRef, ObjectRef overrideRef)
@@ -99,77 +154,136 @@ std::shared_ptr<Object> ObjectHandler::insert(ObjectProfileRef profileRef, Objec
 		return nullptr;
 	}
 
+	// Reserve a slot first, the object needs its reference upon construction.
 	ObjectRef objRef = ObjectRef::Invalid;
 
 	if (ObjectRef::Invalid != overrideRef) {
-		if (!exists(overrideRef)) {
-			objRef = overrideRef;
-		} else {
+		if (exists(overrideRef)) {
 			Log::get() << Log::Entry::create(Log::Level::Warning, __FILE__, __LINE__, "failed to override a object ", overrideRef.get(), ": object already spawned", Log::EndOfEntry);
 			return nullptr;
 		}
+		// A terminated object still occupying the slot is replaced below.
+		if (!_internalCharacterList.contains(overrideRef.get()) && !_internalCharacterList.insertAt(overrideRef.get(), nullptr)) {
+			Log::get() << Log::Entry::create(Log::Level::Warning, __FILE__, __LINE__, "failed to override a object ", overrideRef.get(), ": stale object reference", Log::EndOfEntry);
+			return nullptr;
+		}
+		objRef = overrideRef;
 	}
 	// No override specified, generate new reference.
 	else
 	{
-		// Increment counter.
-		objRef = ObjectRef(_totalCharactersSpawned++);
+		objRef = ObjectRef(_internalCharacterList.insert(nullptr));
 	}
 
-	if (ObjectRef::Invalid != objRef) {
-		const std::shared_ptr<Object> objPtr = std::make_shared<Object>(profileRef, objRef);
-		if (!objPtr) {
-            Log::get() << Log::Entry::create(Log::Level::Warning, __FILE__, __LINE__, "unable to create object", Log::EndOfEntry);
-			return nullptr;
-		}
-
-		// Allocate the new one (we can safely modify the internal map, it isn't iterable from outside).
-		_internalCharacterList[objRef] = objPtr;
-
-		// Wait to adding it to the iterable list.
-		_allocateList.push_back(objPtr);
-		return objPtr;
+	std::shared_ptr<Object> objPtr;
+	try {
+		objPtr = std::make_shared<Object>(profileRef, objRef, _hotStates);
+	} catch (...) {
+		_internalCharacterList.erase(objRef.get());
+		throw;
 	}
 
-	return nullptr;
+	// Allocate the new one (we can safely modify the internal map, it isn't iterable from outside).
+	*_internalCharacterList.find(objRef.get()) = objPtr;
+	_teamMembers[objPtr->getTeamRef()].push_back(objRef);
+
+	// Wait to adding it to the iterable list.
+	_allocateList.push_back(objPtr);
+	return objPtr;
 }
 
 Object *ObjectHandler::get(ObjectRef ref) const {
-	if (ref == ObjectRef::Invalid || ref.get() >= _totalCharactersSpawned) {
-		return nullptr;
-	}
-
 	// Check if object exists in map.
-	const auto& result = _internalCharacterList.find(ref);
-	if (result == _internalCharacterList.end()) {
+	const auto result = _internalCharacterList.find(ref.get());
+	if (nullptr == result) {
 		return nullptr;
 	}
 
-	return (*result).second.get();
+	return result->get();
 }
 
 const std::shared_ptr<Object>& ObjectHandler::operator[] (ObjectRef ref)
 {
-	if (ref == ObjectRef::Invalid || ref.get() >= _totalCharactersSpawned) {
-		return Object::INVALID_OBJECT;
-	}
-
 	// Check if object exists in map.
-	const auto& result = _internalCharacterList.find(ref);
-	if (result == _internalCharacterList.end()) {
+	const auto result = _internalCharacterList.find(ref.get());
+	if (nullptr == result || nullptr == *result) {
 		return Object::INVALID_OBJECT;
 	}
 
-	return (*result).second;
+	return *result;
 }
 
 void ObjectHandler::clear()
 {
 	_internalCharacterList.clear();
 	_iteratorList.clear();
+	for (std::vector<ObjectRef>& members : _teamMembers) {
+		members.clear();
+	}
+	_targetedBy.clear();
+	for (std::vector<ObjectRef>& category : _categories) {
+		category.clear();
+	}
     _dynamicObjects.clear(0, 0, 0, 0);
     _deletedCharacters = 0;
-    _totalCharactersSpawned = 0;
+}
+
+const std::vector<ObjectRef>& ObjectHandler::getTeamMembers(TEAM_REF team) const
+{
+	return _teamMembers[team];
+}
+
+const std::vector<ObjectRef>& ObjectHandler::getTargetedBy(ObjectRef target) const
+{
+	static const std::vector<ObjectRef> empty;
+	const auto result = _targetedBy.find(target);
+	return (result != _targetedBy.end()) ? result->second : empty;
+}
+
+const std::vector<ObjectRef>& ObjectHandler::getCategory(ObjectCategory category) const
+{
+	return _categories[static_cast<size_t>(category)];
+}
+
+void ObjectHandler::onTeamChanged(ObjectRef ref, TEAM_REF oldTeam, TEAM_REF newTeam)
+{
+	// Objects under construction are indexed by insert().
+	const auto result = _internalCharacterList.find(ref.get());
+	if (nullptr == result || nullptr == *result || (*result)->isTerminated()) {
+		return;
+	}
+	removeUnordered(_teamMembers[oldTeam], ref);
+	_teamMembers[newTeam].push_back(ref);
+}
+
+void ObjectHandler::onTargetChanged(ObjectRef ref, ObjectRef oldTarget, ObjectRef newTarget)
+{
+	if (ObjectRef::Invalid != oldTarget) {
+		auto result = _targetedBy.find(oldTarget);
+		if (result != _targetedBy.end()) {
+			removeUnordered(result->second, ref);
+			if (result->second.empty()) {
+				_targetedBy.erase(result);
+			}
+		}
+	}
+	// Targets of removed objects are never resolved again.
+	if (ObjectRef::Invalid != newTarget && exists(ref) && exists(newTarget)) {
+		addUnique(_targetedBy[newTarget], ref);
+	}
+}
+
+void ObjectHandler::updateCategories(const Object& object)
+{
+	const ObjectRef ref = object.getObjRef();
+	const bool flags[] = { object.isItem(), object.platform, object.isPlayer() };
+	for (size_t i = 0; i < _categories.size(); ++i) {
+		if (flags[i] && !object.isTerminated()) {
+			addUnique(_categories[i], ref);
+		} else {
+			removeUnordered(_categories[i], ref);
+		}
+	}
 }
 
 void ObjectHandler::lock()
@@ -238,29 +352,8 @@ void ObjectHandler::maybeRunDeferred()
 
                 if (element->isTerminated())
                 {
-                    //Delete this character
+                    //Delete this character, remove() has already alerted its targeters and team
                     _deletedCharacters--;
-
-                    // Make sure everyone knows it died
-                    for (const std::shared_ptr<Object>& chr : _iteratorList)
-                    {
-                        // std::remove_if results in temporary nullptrs in _iteratorList.
-                        if (nullptr == chr) continue;
-                        
-                        //Don't do ourselves or terminated characters
-                        if (chr->isTerminated() || chr == element) continue;
-						ai_state_t *ai = &(chr->ai);
-
-                        if (ai->getTarget() == element->getObjRef())
-                        {
-                            SET_BIT(ai->alert, ALERTIF_TARGETKILLED);
-                        }
-
-                        if (chr->getTeam().getLeader() == element)
-                        {
-                            SET_BIT(ai->alert, ALERTIF_LEADERKILLED);
-                        }
-                    }
                     return true;
                 }
 
@@ -28,10 +28,21 @@
 
 #include "game/egoboo.h"
 #include "egolib/Core/QuadTree.hpp"
+#include "egolib/Core/SlotMap.hpp"
+#include "egolib/Logic/Team.hpp"
 
 //Forward declarations
 class Object;
 
+/// Categories of objects indexed by the ObjectHandler.
+enum class ObjectCategory : uint8_t
+{
+    Item,       ///< Objects which can be grabbed, see Object::isItem()
+    Platform,   ///< Objects which can be stood on
+    Player,     ///< Objects controlled by a local player, see Object::isPlayer()
+    Count       //Always last
+};
+
 //ZF> Some macros from C Egoboo (TODO: remove these macros)
 ObjectRef GET_INDEX_PCHR(const Object *pobj);
 ObjectRef GET_INDEX_PCHR(const std::shared_ptr<Object> pobj);
@@ -144,6 +155,45 @@ public:
 	 */
 	void clear();
 
+	/**
+	 * @brief Get the hot state of all objects, for passes which do not need the objects themselves.
+	 * @remark The store includes objects which were removed from the game but are not destructed yet.
+	 */
+	ObjectHotStateStore& getHotStates() { return *_hotStates; }
+
+	/**
+	 * @brief Get the objects on a team.
+	 * @remark The index is maintained by Object::assignTeam().
+	 */
+	const std::vector<ObjectRef>& getTeamMembers(TEAM_REF team) const;
+
+	/**
+	 * @brief Get the objects whose AI currently targets an object.
+	 * @remark The index is maintained by ai_state_t::setTarget().
+	 */
+	const std::vector<ObjectRef>& getTargetedBy(ObjectRef target) const;
+
+	/**
+	 * @brief Get the objects of a category.
+	 * @remark The index is maintained by updateCategories().
+	 */
+	const std::vector<ObjectRef>& getCategory(ObjectCategory category) const;
+
+	/**
+	 * @brief Update the team index after the team of an object has changed.
+	 */
+	void onTeamChanged(ObjectRef ref, TEAM_REF oldTeam, TEAM_REF newTeam);
+
+	/**
+	 * @brief Update the reverse target index after the target of an object has changed.
+	 */
+	void onTargetChanged(ObjectRef ref, ObjectRef oldTarget, ObjectRef newTarget);
+
+	/**
+	 * @brief Update the category index after the item, platform or player flags of an object have changed.
+	 */
+	void updateCategories(const Object& object);
+
 	/**
 	 * @brief Return a raw pointer to the object referenced by the object reference
 	 * @return a raw pointer referenced by the object reference
@@ -227,7 +277,8 @@ private:
 	Ego::QuadTree<Object> _staticObjects;			//Objects that rarely move - if ever (Trees, pillars, chairs)
 	int _updateStaticTreeClock;
 
-	std::unordered_map<ObjectRef, std::shared_ptr<Object>> _internalCharacterList; ///< Maps object references to shared pointers to objects
+	Ego::Core::SlotMap<std::shared_ptr<Object>> _internalCharacterList;	///< Maps object references (slot map handles) to shared pointers to objects
+	std::shared_ptr<ObjectHotStateStore> _hotStates;						///< The hot state of the objects, shared with the objects
 	std::vector<std::shared_ptr<Object>> _iteratorList;					///< For iterating, contains only valid objects (unsorted)
 
 	std::vector<std::shared_ptr<Object>> _allocateList;					///< List of all objects that should be added
@@ -235,7 +286,10 @@ private:
 	size_t _semaphore;
 	size_t _deletedCharacters;
 
-	size_t _totalCharactersSpawned;										///< Total count of characters spawned (includes removed)
+	//Secondary indices, objects are removed from these when they are removed from the game
+	std::array<std::vector<ObjectRef>, Team::TEAM_MAX> _teamMembers;				///< The objects on each team
+	std::unordered_map<ObjectRef, std::vector<ObjectRef>> _targetedBy;				///< The objects targeting each object
+	std::array<std::vector<ObjectRef>, static_cast<size_t>(ObjectCategory::Count)> _categories;	///< The objects of each category
 
 	friend class ObjectIterator;
 };
@@ -0,0 +1,144 @@
+//********************************************************************************************
+//*
+//*    This file is part of Egoboo.
+//*
+//*    Egoboo is free software: you can redistribute it and/or modify it
+//*    under the terms of the GNU General Public License as published by
+//*    the Free Software Foundation, either version 3 of the License, or
+//*    (at your option) any later version.
+//*
+//*    Egoboo is distributed in the hope that it will be useful, but
+//*    WITHOUT ANY WARRANTY; without even the implied warranty of
+//*    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+//*    General Public License for more details.
+//*
+//*    You should have received a copy of the GNU General Public License
+//*    along with Egoboo.  If not, see <http://www.gnu.org/licenses/>.
+//*
+//********************************************************************************************
+
+/// @file game/Entities/ObjectHotState.hpp
+/// @brief The physics accumulators of objects, stored contiguously.
+
+#pragma once
+
+#include "game/physics.h"
+
+//Forward declarations
+class Object;
+
+/**
+ * @brief
+ *  The physics accumulators of an Object. They are kept apart from the Object itself such that
+ *  the reset of the accumulators in Ego::Physics::CollisionSystem::update strides over the store
+ *  instead of chasing the objects.
+ * @remark
+ *  The bumpers and collision volumes stay in Object: the passes reading them (move_all_objects,
+ *  ObjectHandler::updateQuadTree and ObjectPhysics::updatePhysics) iterate the objects as they
+ *  read the position, velocity and flags of the Object as well.
+ */
+struct ObjectHotState
+{
+    phys_data_t phys;       ///< the physics accumulators
+    Object *owner;          ///< the Object owning this state, @a nullptr if this state is unused
+
+    ObjectHotState() :
+        phys(),
+        owner(nullptr)
+    {}
+};
+
+/**
+ * @brief
+ *  Storage of ObjectHotState objects in fixed-size blocks. The address of a state remains stable
+ *  as long as the state is allocated, so Object can refer to its state directly.
+ * @remark
+ *  A state is released when its Object is destructed, not when the Object is removed from the game:
+ *  Removed objects may linger in deferred lists and must not share their state with a new Object.
+ */
+class ObjectHotStateStore : private id::non_copyable
+{
+public:
+    static constexpr size_t BlockSize = 64;
+
+    ObjectHotStateStore() :
+        _blocks(),
+        _free(),
+        _size(0)
+    {}
+
+    /**
+     * @brief
+     *  Allocate a state.
+     * @param owner
+     *  the object owning the state
+     * @return
+     *  the state, in its default state
+     */
+    ObjectHotState& allocate(Object& owner)
+    {
+        if (_free.empty())
+        {
+            _blocks.emplace_back(std::make_unique<Block>());
+            // Push in reverse order such that the states of a block are allocated front to back.
+            for (size_t i = BlockSize; i-- > 0;)
+            {
+                _free.push_back(&_blocks.back()->states[i]);
+            }
+        }
+        ObjectHotState& state = *_free.back();
+        _free.pop_back();
+        state.owner = &owner;
+        _size++;
+        return state;
+    }
+
+    /**
+     * @brief
+     *  Release a state allocated by this store.
+     */
+    void release(ObjectHotState& state)
+    {
+        state = ObjectHotState();
+        _free.push_back(&state);
+        _size--;
+    }
+
+    /**
+     * @brief
+     *  Get the number of allocated states.
+     */
+    size_t size() const
+    {
+        return _size;
+    }
+
+    /**
+     * @brief
+     *  Invoke a function for each allocated state in storage order.
+     */
+    template <typename Function>
+    void forEach(Function function)
+    {
+        for (const auto& block : _blocks)
+        {
+            for (ObjectHotState& state : block->states)
+            {
+                if (nullptr != state.owner)
+                {
+                    function(state);
+                }
+            }
+        }
+    }
+
+private:
+    struct Block
+    {
+        std::array<ObjectHotState, BlockSize> states;
+    };
+
+    std::vector<std::unique_ptr<Block>> _blocks;    ///< the blocks, never released before the store
+    std::vector<ObjectHotState *> _free;            ///< the unused states, used as a stack
+    size_t _size;                                   ///< the number of allocated states
+};
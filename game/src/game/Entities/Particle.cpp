@@ -63,6 +63,7 @@ void prt_environment_t::reset()
 const std::shared_ptr<Particle> Particle::INVALID_PARTICLE = nullptr;
 
 Particle::Particle() :
+    phys(),
     _particleID(),
     _particlePhysics(*this),
     _collidedObjects(),
@@ -104,6 +105,7 @@ void Particle::reset(ParticleRef ref)
     offset = Vector3f::zero();
 
     PhysicsData::reset(this);
+    phys = phys_data_t();
 
     rotate = Facing(0);
     rotate_add = Facing(0);
@@ -849,9 +851,9 @@ bool Particle::initialize(const ParticleRef particleID, const Vector3f& spawnPos
     // Targeting...
     vel.z() = 0;
 
-    offset.z() = generate_irand_pair(getProfile()->getSpawnPositionOffsetZ()) - (getProfile()->getSpawnPositionOffsetZ().rand / 2);
+    offset.z() = generate_irand_pair(getProfile()->getSpawnPositionOffsetZ(), Random::get(Random::Stream::Particles)) - (getProfile()->getSpawnPositionOffsetZ().rand / 2);
     tmp_pos.z() += offset.z();
-    const int velocity = generate_irand_pair(getProfile()->getSpawnVelocityOffsetXY());
+    const int velocity = generate_irand_pair(getProfile()->getSpawnVelocityOffsetXY(), Random::get(Random::Stream::Particles));
 
     //Set target
     _target = spawnTarget;
@@ -899,7 +901,7 @@ bool Particle::initialize(const ParticleRef particleID, const Vector3f& spawnPos
                     aimError -= (0.5f/PERFECT_AIM) * attackerAgility;
                 }
 
-                offsetfacing = Random::next(getProfile()->getSpawnFacing().rand) - (getProfile()->getSpawnFacing().rand / 2);
+                offsetfacing = Random::get(Random::Stream::Particles).next(getProfile()->getSpawnFacing().rand) - (getProfile()->getSpawnFacing().rand / 2);
                 offsetfacing *= aimError;
             }
 
@@ -948,14 +950,14 @@ bool Particle::initialize(const ParticleRef particleID, const Vector3f& spawnPos
     else
     {
         // Correct loc_facing for randomness
-        offsetfacing = generate_irand_pair(getProfile()->getSpawnFacing()) - (getProfile()->getSpawnFacing().base + getProfile()->getSpawnFacing().rand / 2);
+        offsetfacing = generate_irand_pair(getProfile()->getSpawnFacing(), Random::get(Random::Stream::Particles)) - (getProfile()->getSpawnFacing().base + getProfile()->getSpawnFacing().rand / 2);
     }
     loc_facing += Facing(offsetfacing);
     facing = Facing(loc_facing);
 
     // this is actually pointing in the opposite direction?
     // Location data from arguments
-    newrand = generate_irand_pair(getProfile()->getSpawnPositionOffsetXY());
+    newrand = generate_irand_pair(getProfile()->getSpawnPositionOffsetXY(), Random::get(Random::Stream::Particles));
     offset[kX] = -std::cos(loc_facing) * newrand;
     offset[kY] = -std::sin(loc_facing) * newrand;
 
@@ -977,7 +979,7 @@ bool Particle::initialize(const ParticleRef particleID, const Vector3f& spawnPos
     // Velocity data
     vel.x() = -std::cos(loc_facing) * velocity;
     vel.y() = -std::sin(loc_facing) * velocity;
-    vel.z() += generate_irand_pair(getProfile()->getSpawnVelocityOffsetZ()) - (getProfile()->getSpawnVelocityOffsetZ().rand / 2);
+    vel.z() += generate_irand_pair(getProfile()->getSpawnVelocityOffsetZ(), Random::get(Random::Stream::Particles)) - (getProfile()->getSpawnVelocityOffsetZ().rand / 2);
     this->setVelocity(vel);
     this->setOldVelocity(vel);
     this->vel_stt = vel;
@@ -987,14 +989,14 @@ bool Particle::initialize(const ParticleRef particleID, const Vector3f& spawnPos
     type = getProfile()->type;
 
     // Image data
-    rotate = Facing((FACING_T)generate_irand_pair(getProfile()->rotate_pair));
+    rotate = Facing((FACING_T)generate_irand_pair(getProfile()->rotate_pair, Random::get(Random::Stream::Particles)));
     rotate_add = Facing(getProfile()->rotate_add);
 
     size_stt = getProfile()->size_base;
     size_add = getProfile()->size_add;
 
     _image._start = (getProfile()->image_stt)*EGO_ANIMATION_MULTIPLIER;
-    _image._add = generate_irand_pair(getProfile()->image_add);
+    _image._add = generate_irand_pair(getProfile()->image_add, Random::get(Random::Stream::Particles));
     _image._count = (getProfile()->image_max)*EGO_ANIMATION_MULTIPLIER;
 
     // a particle can EITHER end_lastframe or end_time.
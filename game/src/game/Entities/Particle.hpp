@@ -342,6 +342,8 @@ public:
 
     static const std::shared_ptr<Particle> INVALID_PARTICLE;
 
+    phys_data_t phys;                    ///< the physics accumulators
+
     // links
     /**
      * @brief
@@ -53,22 +53,22 @@ std::shared_ptr<Ego::Particle> ParticleHandler::spawnLocalParticle
 
 const std::shared_ptr<Ego::Particle>& ParticleHandler::operator[] (const ParticleRef index)
 {
-    auto result = _particleMap.find(index);
+    auto result = _particleMap.find(index.get());
     
     // If the referenced particle does not exist ...
-    if(result == _particleMap.end()) {
+    if(nullptr == result) {
         // ... return the null pointer.
         return Ego::Particle::INVALID_PARTICLE;
     }
 
     // Check if particle was marked as terminated
-    if((*result).second->isTerminated() || (*result).second->getParticleID() != index) {
-        _particleMap.erase(index);
+    if((*result)->isTerminated() || (*result)->getParticleID() != index) {
+        _particleMap.erase(index.get());
         return Ego::Particle::INVALID_PARTICLE;        
     }
 
     // All good!
-    return (*result).second;
+    return *result;
 }
 
 std::shared_ptr<Ego::Particle> ParticleHandler::spawnGlobalParticle(const Vector3f& spawnPos, const Facing& spawnFacing,
@@ -105,14 +105,15 @@ std::shared_ptr<Ego::Particle> ParticleHandler::spawnParticle(const Vector3f& sp
     std::shared_ptr<Ego::Particle> particle = getFreeParticle(ppip->force);
     if(particle) {
         //Initialize particle and add it into the game
-        if(particle->initialize(ParticleRef(_totalParticlesSpawned++), spawnPos, spawnFacing, spawnProfile, particleProfile, spawnAttach, vrt_offset, 
+        const ParticleRef particleRef(_particleMap.insert(particle));
+        if(particle->initialize(particleRef, spawnPos, spawnFacing, spawnProfile, particleProfile, spawnAttach, vrt_offset, 
                                 spawnTeam, spawnOrigin, ParticleRef(spawnParticleOrigin), multispawn, spawnTarget, onlyOverWater)) 
         {
             _pendingParticles.push_back(particle);
-            _particleMap[particle->getParticleID()] = particle;
         }
         else {
             //If we failed to spawn somehow, put it back to the unused pool
+            _particleMap.erase(particleRef.get());
             _unusedPool.push_back(particle);
         }        
     }
@@ -238,7 +239,7 @@ void ParticleHandler::unlock()
 
             //Free to be used by another instance again
             _unusedPool.push_back(particle);
-            _particleMap.erase(particle->getParticleID());
+            _particleMap.erase(particle->getParticleID().get());
 
             return true;
         };
@@ -275,7 +276,6 @@ void ParticleHandler::clear()
     _activeParticles.clear();
     _unusedPool.clear();
     _particleMap.clear();
-    _totalParticlesSpawned = 0;
 }
 
 std::shared_ptr<const Ego::Texture> ParticleHandler::getLightParticleTexture()
@@ -294,7 +294,7 @@ void ParticleHandler::spawnPoof(const std::shared_ptr<Object> &object)
     for (int cnt = 0; cnt < object->getProfile()->getParticlePoofAmount(); cnt++)
     {
         ParticleHandler::get().spawnParticle(object->getOldPosition(), facing_z, object->getProfile()->getSlotNumber(), object->getProfile()->getParticlePoofProfile(),
-                                             ObjectRef::Invalid, GRIP_LAST, object->team, object->ai.owner, ParticleRef::Invalid, cnt);
+                                             ObjectRef::Invalid, GRIP_LAST, object->getTeamRef(), object->ai.owner, ParticleRef::Invalid, cnt);
 
         facing_z += Facing(object->getProfile()->getParticlePoofFacingAdd());
     }
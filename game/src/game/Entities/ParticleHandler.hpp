@@ -27,6 +27,7 @@
 
 #include "game/egoboo.h"
 #include "game/Entities/Particle.hpp"
+#include "egolib/Core/SlotMap.hpp"
 
 class ParticleHandler : public Ego::Core::Singleton<ParticleHandler>
 {
@@ -88,7 +89,6 @@ public:
     ParticleHandler() :
         _maxParticles(0),
         _semaphoreLock(0),
-        _totalParticlesSpawned(0),
         _unusedPool(),
         _activeParticles(),
         _particleMap(),
@@ -239,13 +239,12 @@ private:
 
     size_t _maxParticles;   ///< Maximum allowed active particles to be alive at the same time
     std::atomic<size_t> _semaphoreLock;
-    std::atomic<size_t> _totalParticlesSpawned;
 
     std::vector<std::shared_ptr<Ego::Particle>> _unusedPool;         //Particles currently unused
     std::vector<std::shared_ptr<Ego::Particle>> _activeParticles;    //List of all particles that are active ingame
     std::vector<std::shared_ptr<Ego::Particle>> _pendingParticles;   //Particles that will be added to the active list as soon as it is unlocked
 
-    std::unordered_map<ParticleRef, std::shared_ptr<Ego::Particle>> _particleMap; //Mapping from PRT_REF to Particle
+    Ego::Core::SlotMap<std::shared_ptr<Ego::Particle>> _particleMap;  //Mapping from PRT_REF (slot map handles) to Particle
 
     Ego::DeferredTexture _transparentParticleTexture;
     Ego::DeferredTexture _lightParticleTexture;
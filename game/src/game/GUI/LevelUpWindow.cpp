@@ -25,8 +25,8 @@ public:
 
         //Apply shake effect when mouse is over
         if (_mouseOver) {
-            shakeEffectX += Random::next(1, 4) - 2;
-            shakeEffectY += Random::next(1, 4) - 2;
+            shakeEffectX += Random::get(Random::Stream::Graphics).next(1, 4) - 2;
+            shakeEffectY += Random::get(Random::Stream::Graphics).next(1, 4) - 2;
         }
 
         if (_mouseOver && _hoverFadeEffect < 2.0f) {
@@ -184,15 +184,15 @@ LevelUpWindow::LevelUpWindow(const std::shared_ptr<Object> &object)
     //No perk by default
     setHoverPerk(Perks::NR_OF_PERKS);
 
-    //Set random seed for deterministic level ups (no aborting or re-loading game for better results)
-    Random::setSeed(_character->getLevelUpSeed());
+    //Use a stream seeded by the character for deterministic level ups (no aborting or re-loading game for better results)
+    RandomStream random(_character->getLevelUpSeed());
 
     //Perk buttons (Jack of All Trades gives +2 perks)
     const size_t NR_OF_PERKS = _character->hasPerk(Perks::JACK_OF_ALL_TRADES) ? 5 : 3;
     const int PERK_BUTTON_SIZE = (getWidth() - 40 - 10 * NR_OF_PERKS) / NR_OF_PERKS;
     for (size_t i = 0; i < NR_OF_PERKS; ++i) {
         //Select a random perk
-        const size_t randomIndex = Random::next(perkPool.size() - 1);
+        const size_t randomIndex = random.next(perkPool.size() - 1);
         std::shared_ptr<PerkButton> perkButton = std::make_shared<PerkButton>(perkPool[randomIndex]);
         perkButton->setSize(Vector2f(PERK_BUTTON_SIZE, PERK_BUTTON_SIZE));
         perkButton->setPosition(Point2f(20 + i * (perkButton->getWidth() + 10), selectPerkLabel->getY() + selectPerkLabel->getHeight()));
@@ -219,14 +219,14 @@ LevelUpWindow::LevelUpWindow(const std::shared_ptr<Object> &object)
 LevelUpWindow::~LevelUpWindow() {}
 
 void LevelUpWindow::doLevelUp(PerkButton *selectedPerk) {
-    //Set random seed for deterministic level ups (no aborting or re-loading game for better results)
-    Random::setSeed(_character->getLevelUpSeed());
+    //Use a stream seeded by the character for deterministic level ups (no aborting or re-loading game for better results)
+    RandomStream random(_character->getLevelUpSeed());
 
     //Calculate attribute improvements
     std::array<float, Attribute::NR_OF_PRIMARY_ATTRIBUTES> increase;
     for (uint8_t i = 0; i < Attribute::NR_OF_PRIMARY_ATTRIBUTES; ++i) {
         const Attribute::AttributeType type = static_cast<Attribute::AttributeType>(i);
-        increase[i] = Random::next(_character->getProfile()->getAttributeGain(type));
+        increase[i] = random.next(_character->getProfile()->getAttributeGain(type));
     }
 
     //Gain new Perk
@@ -66,13 +66,18 @@ void MiniMap::draw(DrawingContext& drawingContext) {
 
     // If one of the players can sense enemies via ESP, draw them as blips on the map
     if (Team::TEAM_MAX != local_stats.sense_enemies_team) {
-        for (const std::shared_ptr<Object> &pchr : _currentModule->getObjectHandler().iterator()) {
-            if (pchr->isTerminated()) continue;
+        ObjectHandler& objectHandler = _currentModule->getObjectHandler();
+        const Team& senseTeam = _currentModule->getTeamList()[local_stats.sense_enemies_team];
+        for (const Team& team : _currentModule->getTeamList()) {
+            // Show only teams that will attack the player
+            if (!team.hatesTeam(senseTeam)) continue;
 
-            const std::shared_ptr<ObjectProfile> &profile = pchr->getProfile();
+            for (ObjectRef member : objectHandler.getTeamMembers(team.toRef())) {
+                const Object *pchr = objectHandler.get(member);
+                if (nullptr == pchr || pchr->isTerminated()) continue;
+
+                const std::shared_ptr<ObjectProfile> &profile = pchr->getProfile();
 
-            // Show only teams that will attack the player
-            if (pchr->getTeam().hatesTeam(_currentModule->getTeamList()[local_stats.sense_enemies_team])) {
                 // Only if they match the required IDSZ ([NONE] always works)
                 if (local_stats.sense_enemies_idsz == IDSZ2::None ||
                     local_stats.sense_enemies_idsz == profile->getIDSZ(IDSZ_PARENT) ||
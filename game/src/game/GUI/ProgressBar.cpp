@@ -15,6 +15,8 @@ void ProgressBar::draw(DrawingContext& drawingContext) {
         float x, y;
     };
 
+    _gameEngine->getUIManager()->flushText();
+
     auto &renderer = Renderer::get();
     const auto &vd = _gameEngine->getUIManager()->_vertexDescriptor;
     const auto &vb = _gameEngine->getUIManager()->_vertexBuffer;
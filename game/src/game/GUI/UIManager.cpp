@@ -102,6 +102,9 @@ void UIManager::beginRenderUI() {
     renderer.setProjectionMatrix(projection);
     renderer.setViewMatrix(Matrix4f4f::identity());
     renderer.setWorldMatrix(Matrix4f4f::identity());
+
+    // Batch all text of this pass by font atlas.
+    FontManager::get().getGlyphBatch().begin();
 }
 
 void UIManager::endRenderUI() {
@@ -111,11 +114,17 @@ void UIManager::endRenderUI() {
         return;
     }
 
+    FontManager::get().getGlyphBatch().end();
+
     // Re-enable any states disabled by gui_beginFrame
     // do not use the ATTRIB_POP macro, since the glPushAttrib() is in a different function
     GL_DEBUG(glPopAttrib)();
 }
 
+void UIManager::flushText() {
+    FontManager::get().getGlyphBatch().flush();
+}
+
 int UIManager::getScreenWidth() const {
     return GraphicsSystem::get().window->getSize().width();
 }
@@ -316,6 +325,7 @@ void UIManager::drawBitmapGlyph(int fonttype, const Vector2f& position, const fl
 }
 
 void UIManager::drawQuad2D(const Rectangle2f& scr_rect, const Rectangle2f& tx_rect, const std::shared_ptr<const Material>& material) {
+    flushText();
     material->apply();
     drawQuad2d(scr_rect, tx_rect);
 }
@@ -328,6 +338,7 @@ void UIManager::drawQuad2D(const Rectangle2f& scr_rect, const ego_frect_t& tx_re
 
 void UIManager::fillRectangle(const Rectangle2f& rectangle, const bool useAlpha, const Math::Colour4f& tint) {
     auto material = std::make_shared<Material>(nullptr, tint, useAlpha);
+    flushText();
     material->apply();
     drawQuad2d(rectangle);
 }
@@ -337,6 +348,13 @@ void UIManager::drawQuad2d(const Rectangle2f& target, const Rectangle2f& source)
         float x, y;
         float s, t;
     };
+    // Callers set up texture and colour before calling this function. Text queued before the quad
+    // must be rendered first, so flush it without clobbering the state set up by the caller.
+    if (!FontManager::get().getGlyphBatch().isEmpty()) {
+        GL_DEBUG(glPushAttrib)(GL_CURRENT_BIT | GL_ENABLE_BIT | GL_TEXTURE_BIT | GL_COLOR_BUFFER_BIT);
+        flushText();
+        GL_DEBUG(glPopAttrib)();
+    }
     auto& renderer = Renderer::get();
     {
         VertexBufferScopedLock vblck(_textureQuadVertexBuffer);
@@ -89,6 +89,13 @@ public:
      */
     void endRenderUI();
 
+    /**
+     * @brief
+     *  Render the text queued since the last flush. Text drawn between beginRenderUI and endRenderUI
+     *  is batched, call this before drawing over text with the renderer directly.
+     */
+    void flushText();
+
     /**
      * @brief
      *  Convinience function to draw a 2D image
@@ -145,6 +152,7 @@ public:
     /// Draw a 2D quad.
     /// @param target the target rectangle in screen coordinates
     /// @param source the source rectangle in texture coordinates
+    /// @remark Text queued before is rendered first, the render state of the caller is preserved.
     void drawQuad2d(const Rectangle2f& target, const Rectangle2f& source);
     /// Draw a 2D quadriliteral.
     /// @param target the target rectangle in screen coordinates
@@ -104,7 +104,7 @@ void MapEditorState::update()
 
 void MapEditorState::drawContainer(Ego::GUI::DrawingContext& drawingContext)
 {
-    CameraSystem::get().renderAll(gfx_system_render_world);
+    CameraSystem::get().renderAll(gfx_system_prepare_world, gfx_system_render_world);
     draw_hud();
 
     //Draw passages?
@@ -83,8 +83,8 @@ PlayingState::~PlayingState()
         // export the players
         export_all_players(false);
 
-        //Reload list of loadable characters
-        ProfileSystem::get().loadAllSavedCharacters("mp_players");
+        //Reload list of loadable characters once the exports are needed
+        ProfileSystem::get().invalidateSavedCharacters("mp_players");
     }
 
     //Stop music
@@ -132,7 +132,7 @@ void PlayingState::update()
 
 void PlayingState::drawContainer(Ego::GUI::DrawingContext& drawingContext)
 {
-    CameraSystem::get().renderAll(gfx_system_render_world);
+    CameraSystem::get().renderAll(gfx_system_prepare_world, gfx_system_render_world);
     draw_hud();
 }
 
@@ -61,18 +61,19 @@ std::shared_ptr<Billboard> BillboardSystem::makeBillboard(::Time::Seconds lifeti
 {
     auto billboard = std::make_shared<Billboard>(::Time::now<::Time::Unit::Ticks>() + lifetime_secs * TICKS_PER_SEC, texture, size);
     billboard->_tint = tint;
+    RandomStream& random = Random::get(Random::Stream::Graphics);
 
     if (HAS_SOME_BITS(options, Billboard::Flags::RandomPosition))
     {
         // make a random offset from the character
-        billboard->_offset = Vector3f(Random::nextFloat() * 2 - 1, Random::nextFloat() * 2 - 1, Random::nextFloat() * 2 - 1)
+        billboard->_offset = Vector3f(random.nextFloat() * 2 - 1, random.nextFloat() * 2 - 1, random.nextFloat() * 2 - 1)
             * (Info<float>::Grid::Size() / 5.0f);
     }
 
     if (HAS_SOME_BITS(options, Billboard::Flags::RandomVelocity))
     {
         // make the text fly away in a random direction
-        billboard->_offset_add += Vector3f(Random::nextFloat() * 2 - 1, Random::nextFloat() * 2 - 1, Random::nextFloat() * 2 - 1)
+        billboard->_offset_add += Vector3f(random.nextFloat() * 2 - 1, random.nextFloat() * 2 - 1, random.nextFloat() * 2 - 1)
             * (2.0f * Info<float>::Grid::Size() / lifetime_secs / GameEngine::GAME_TARGET_UPS);
     }
 
@@ -103,9 +103,10 @@ void CameraSystem::resetAllTargets( const ego_mesh_t * mesh )
     }
 }
 
-egolib_rv CameraSystem::renderAll(std::function<void(std::shared_ptr<Camera>, std::shared_ptr<Ego::Graphics::TileList>, std::shared_ptr<Ego::Graphics::EntityList>)> renderFunction)
+egolib_rv CameraSystem::renderAll(std::function<void(const std::vector<std::shared_ptr<Camera>>&)> prepareFunction,
+                                 std::function<void(std::shared_ptr<Camera>, std::shared_ptr<Ego::Graphics::TileList>, std::shared_ptr<Ego::Graphics::EntityList>)> renderFunction)
 {
-    if ( NULL == renderFunction ) {
+    if ( NULL == prepareFunction || NULL == renderFunction ) {
         return rv_error;
     }
 
@@ -113,19 +114,31 @@ egolib_rv CameraSystem::renderAll(std::function<void(std::shared_ptr<Camera>, st
         return rv_fail;
     }
 
+    // collect the cameras which have not already rendered this frame
+    std::vector<std::shared_ptr<Camera>> cameras;
+    for(const std::shared_ptr<Camera> &camera : _cameraList)
+    {
+        if ( camera->getLastFrame() >= 0 && static_cast<uint32_t>(camera->getLastFrame()) >= _gameEngine->getNumberOfFramesRendered()) {
+            continue;
+        }
+        cameras.push_back(camera);
+    }
+    if (cameras.empty()) {
+        return rv_success;
+    }
+
     //Store main camera to restore
     std::shared_ptr<Camera> storeMainCam = _mainCamera;
 
-    for(const std::shared_ptr<Camera> &camera : _cameraList) 
+    // do the work shared by all cameras once
+    _mainCamera = cameras.front();
+    prepareFunction(cameras);
+
+    for(const std::shared_ptr<Camera> &camera : cameras) 
     {
         // set the "global" camera pointer to this camera
         _mainCamera = camera;
 
-	    // has this camera already rendered this frame?
-        if ( camera->getLastFrame() >= 0 && static_cast<uint32_t>(camera->getLastFrame()) >= _gameEngine->getNumberOfFramesRendered()) {
-            continue;
-        }
-
         // set up everything for this camera
         beginCameraMode(camera);
 
@@ -56,7 +56,16 @@ public:
 	void updateAll( const ego_mesh_t * mesh );
 	void resetAllTargets( const ego_mesh_t * mesh );
 
-	egolib_rv renderAll(std::function<void(std::shared_ptr<Camera>, std::shared_ptr<Ego::Graphics::TileList>, std::shared_ptr<Ego::Graphics::EntityList>)> renderFunction);
+	/**
+	 * @brief
+	 *  Render the world for each camera which has not been rendered this frame.
+	 * @param prepareFunction
+	 *  invoked once with the cameras to be rendered before any of them is rendered
+	 * @param renderFunction
+	 *  invoked for each of the cameras to be rendered
+	 */
+	egolib_rv renderAll(std::function<void(const std::vector<std::shared_ptr<Camera>>&)> prepareFunction,
+	                    std::function<void(std::shared_ptr<Camera>, std::shared_ptr<Ego::Graphics::TileList>, std::shared_ptr<Ego::Graphics::EntityList>)> renderFunction);
 
 	/**
 	 * @brief
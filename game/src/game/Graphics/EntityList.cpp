@@ -61,10 +61,8 @@ size_t EntityList::add(::Camera& camera, Object& object) {
 size_t EntityList::add(::Camera& camera, Ego::Particle& particle) {
     size_t count = 0;
     if (!test(camera, particle)) {
-        particle.inst.indolist = false;
         return count;
     }
-    particle.inst.indolist = true;
 
     list.emplace_back(ObjectRef::Invalid, particle.getParticleID());
     set.emplace((void *)(&particle));
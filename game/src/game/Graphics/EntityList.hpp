@@ -121,9 +121,9 @@ public:
      * @brief Add a particle entity if it is eligible for addition.
      * @param obj the particle entity to add
      * @return the total number of entities added
-     * @remark A (legacy) occlusion test is performed. If the particle is occluded,
-     * then particle.getInstance().isOccluded() is set to @a true, otherwise it is
-     * set to @a false.
+     * @remark The particle is not modified such that the entity lists of several
+     * cameras can be built concurrently. Whether a particle is in any entity list
+     * (Ego::Graphics::ParticleGraphics::indolist) is determined afterwards.
      */
     size_t add(::Camera& camera, Ego::Particle& particle);
 };
@@ -2,6 +2,7 @@
 #include "game/Entities/_Include.hpp"
 #include "game/graphic.h"
 #include "game/game.h" //only for character_swipe()
+#include "game/CharacterMatrix.h"
 
 namespace Ego
 {
@@ -25,6 +26,8 @@ ObjectGraphics::ObjectGraphics(Object &object) :
 
     _object(object),
     _vertexList(),
+    _vertexHeights(),
+    _vertexLighting(),
     _matrix(Matrix4f4f::identity()),
     _reflectionMatrix(Matrix4f4f::identity()),
 
@@ -88,33 +91,77 @@ void ObjectGraphics::updateLighting()
     //_ambientColour = (loc_light.hgh._lighting[LVEC_AMB] + loc_light.low._lighting[LVEC_AMB]) * 0.5f;
     _ambientColour = get_ambient_level();
 
+    const auto& frameList = getModelDescriptor()->getMD2()->getFrames();
+    const size_t vertexCount = _vertexList.size();
+
+    // the batch lighting needs the normal indices of both frames for every vertex
+    const bool framesMatch = _targetFrameIndex < frameList.size() && _sourceFrameIndex < frameList.size() &&
+                             frameList[_targetFrameIndex].normalList.size() == vertexCount &&
+                             frameList[_sourceFrameIndex].normalList.size() == vertexCount;
+
     _maxLight = -0xFF;
-    for (size_t cnt = 0; cnt < _vertexList.size(); cnt++ )
+    if (framesMatch)
     {
-        float lite = 0.0f;
+        const MD2_Frame& nextFrame = frameList[_targetFrameIndex];
+        const MD2_Frame& lastFrame = frameList[_sourceFrameIndex];
+
+        // evaluate the lighting once for each distinct normal used by the frames
+        lighting_normal_table_t normal_light;
+        lighting_normal_table_t::evaluate(normal_light, loc_light, lastFrame.normalList.data(),
+                                          nextFrame.normalList.data(), vertexCount);
+
+        // gather a simple "height" measurement for every vertex
+        _vertexHeights.resize(vertexCount);
+        _vertexLighting.resize(vertexCount);
+        for (size_t cnt = 0; cnt < vertexCount; cnt++)
+        {
+            _vertexHeights[cnt] = _vertexList[cnt].pos[ZZ] * _matrix(3, 3) + _matrix(3, 3);
+        }
 
-        GLvertex *pvert = &_vertexList[cnt];
+        // fix the flip for objects that are not animating
+        const float flip = (_targetFrameIndex == _sourceFrameIndex) ? 0.0f : _animationProgress;
 
-        // a simple "height" measurement
-        float hgt = pvert->pos[ZZ] * _matrix(3, 3) + _matrix(3, 3);
+        lighting_normal_table_t::evaluateBatch(normal_light, _currentModule->getMeshPointer()->_tmem._bbox,
+                                               lastFrame.normalList.data(), nextFrame.normalList.data(),
+                                               _vertexHeights.data(), flip, vertexCount, _vertexLighting.data());
 
-        if (pvert->nrm[0] == 0.0f && pvert->nrm[1] == 0.0f && pvert->nrm[2] == 0.0f)
+        for (size_t cnt = 0; cnt < vertexCount; cnt++)
         {
-            // this is the "ambient only" index, but it really means to sum up all the light
-            lite  = lighting_cache_t::lighting_evaluate_cache(loc_light, Vector3f(+1.0f,+1.0f,+1.0f), hgt, _currentModule->getMeshPointer()->_tmem._bbox, nullptr, nullptr);
-            lite += lighting_cache_t::lighting_evaluate_cache(loc_light, Vector3f(-1.0f,-1.0f,-1.0f), hgt, _currentModule->getMeshPointer()->_tmem._bbox, nullptr, nullptr);
+            _vertexList[cnt].color_dir = _vertexLighting[cnt];
 
-            // average all the directions
-            lite /= 6.0f;
+            _maxLight = std::max(_maxLight, _vertexList[cnt].color_dir);
         }
-        else
+    }
+    else
+    {
+        // evaluate the lighting for the interpolated normal of every vertex
+        for (size_t cnt = 0; cnt < vertexCount; cnt++)
         {
-            lite = lighting_cache_t::lighting_evaluate_cache(loc_light, Vector3f(pvert->nrm[0],pvert->nrm[1],pvert->nrm[2]), hgt, _currentModule->getMeshPointer()->_tmem._bbox, nullptr, nullptr);
-        }
+            float lite = 0.0f;
+
+            GLvertex *pvert = &_vertexList[cnt];
 
-        pvert->color_dir = lite;
+            // a simple "height" measurement
+            float hgt = pvert->pos[ZZ] * _matrix(3, 3) + _matrix(3, 3);
 
-        _maxLight = std::max(_maxLight, pvert->color_dir);
+            if (pvert->nrm[0] == 0.0f && pvert->nrm[1] == 0.0f && pvert->nrm[2] == 0.0f)
+            {
+                // this is the "ambient only" index, but it really means to sum up all the light
+                lite  = lighting_cache_t::lighting_evaluate_cache(loc_light, Vector3f(+1.0f,+1.0f,+1.0f), hgt, _currentModule->getMeshPointer()->_tmem._bbox, nullptr, nullptr);
+                lite += lighting_cache_t::lighting_evaluate_cache(loc_light, Vector3f(-1.0f,-1.0f,-1.0f), hgt, _currentModule->getMeshPointer()->_tmem._bbox, nullptr, nullptr);
+
+                // average all the directions
+                lite /= 6.0f;
+            }
+            else
+            {
+                lite = lighting_cache_t::lighting_evaluate_cache(loc_light, Vector3f(pvert->nrm[0],pvert->nrm[1],pvert->nrm[2]), hgt, _currentModule->getMeshPointer()->_tmem._bbox, nullptr, nullptr);
+            }
+
+            pvert->color_dir = lite;
+
+            _maxLight = std::max(_maxLight, pvert->color_dir);
+        }
     }
 
     // ??coerce this to reasonable values in the presence of negative light??
@@ -343,12 +390,14 @@ gfx_rv ObjectGraphics::updateVertices(int vmin, int vmax, bool force)
     if ( vdirty1_min >= 0 && vdirty1_max >= 0 )
     {
 		interpolateVerticesRaw(lastFrame.vertexList, nextFrame.vertexList, vdirty1_min, vdirty1_max, loc_flip);
+        g_transform_counters.vertices++;
     }
 
     // interpolate the 2nd dirty region
     if ( vdirty2_min >= 0 && vdirty2_max >= 0 )
     {
 		interpolateVerticesRaw(lastFrame.vertexList, nextFrame.vertexList, vdirty2_min, vdirty2_max, loc_flip);
+        g_transform_counters.vertices++;
     }
 
     // update the saved parameters
@@ -1210,7 +1259,7 @@ void ObjectGraphics::updateAnimationRate()
                 SET_BIT( _object.ai.alert, ALERTIF_BORED );
 
                 // set the action to "bored", which is ACTION_DB, ACTION_DC, or ACTION_DD
-                int rand_val   = Random::next(std::numeric_limits<uint16_t>::max());
+                int rand_val   = Random::get(Random::Stream::Graphics).next(std::numeric_limits<uint16_t>::max());
                 ModelAction tmp_action = getModelDescriptor()->getAction(ACTION_DB + ( rand_val % 3 ));
                 _object.inst.startAnimation(tmp_action, true, true );
             }
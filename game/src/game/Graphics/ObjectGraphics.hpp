@@ -317,6 +317,8 @@ private:
 private:
     Object& _object;
     std::vector<GLvertex> _vertexList;
+    std::vector<float> _vertexHeights;      ///< scratch space for the batch lighting: the vertex heights
+    std::vector<float> _vertexLighting;     ///< scratch space for the batch lighting: the vertex lighting
     Matrix4f4f _matrix;                     ///< Character's matrix
     Matrix4f4f _reflectionMatrix;           ///< Character's matrix reflecter (on the floor)
 
@@ -36,6 +36,7 @@
 #include "game/egoboo.h"
 #include "game/mesh.h"
 #include "game/Graphics/CameraSystem.hpp"
+#include "game/Graphics/TextureAtlasManager.hpp"
 #include "egolib/FileFormats/Globals.hpp"
 #include "game/Module/Module.hpp"
 #include "game/Entities/_Include.hpp"
@@ -94,6 +95,16 @@ bool ElementV2::compare(const ElementV2& x, const ElementV2& y) {
 	}
 }
 
+size_t TileListV2::bindCount = 0;
+
+size_t TileListV2::getBindCount() {
+    return bindCount;
+}
+
+void TileListV2::resetBindCount() {
+    bindCount = 0;
+}
+
 void TileListV2::render(ego_mesh_t& mesh, const std::vector<ClippingEntry>& tiles)
 {
 	size_t tcnt = mesh._tmem.getInfo().getTileCount();
@@ -102,6 +113,9 @@ void TileListV2::render(ego_mesh_t& mesh, const std::vector<ClippingEntry>& tile
 		return;
 	}
 
+	// if all tiles share the texture atlas, the tiles are sorted by distance only
+	const bool useAtlas = nullptr != TextureAtlasManager::get().getAtlas();
+
 	// insert the rlst values into lst_vals
 	std::vector<ElementV2> lst_vals(tiles.size());
 	for (size_t i = 0; i < tiles.size(); ++i)
@@ -111,6 +125,10 @@ void TileListV2::render(ego_mesh_t& mesh, const std::vector<ClippingEntry>& tile
 		{
 			textureIndex = std::numeric_limits<uint32_t>::max();
 		}
+		else if (useAtlas)
+		{
+			textureIndex = 0;
+		}
 		else
 		{
 			const ego_tile_info_t& tile = mesh._tmem.get(tiles[i].getIndex());
@@ -131,6 +149,9 @@ void TileListV2::render(ego_mesh_t& mesh, const std::vector<ClippingEntry>& tile
 	// restart the mesh texture code
 	TileRenderer::invalidate();
 
+	auto& textureUnit = Ego::Renderer::get().getTextureUnit();
+	const size_t oldBindCount = textureUnit.getBindCount();
+
 	for (size_t i = 0; i < tiles.size(); ++i)
 	{
 		Index1D tmp_itile = lst_vals[i].getTileIndex();
@@ -142,6 +163,8 @@ void TileListV2::render(ego_mesh_t& mesh, const std::vector<ClippingEntry>& tile
 		}
 	}
 
+	bindCount += textureUnit.getBindCount() - oldBindCount;
+
 	// let the mesh texture code know that someone else is in control now
 	TileRenderer::invalidate();
 }
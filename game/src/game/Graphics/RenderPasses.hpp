@@ -61,7 +61,17 @@ public:
     /// @param tiles the list of tiles
     static void render_heightmap(ego_mesh_t& mesh, const std::vector<ClippingEntry>& tiles);
 
+    /// @brief Get the number of texture binds by render since the last call to resetBindCount.
+    /// @return the number of texture binds
+    static size_t getBindCount();
+
+    /// @brief Reset the number of texture binds by render.
+    static void resetBindCount();
+
 private:
+    /// @brief The number of texture binds by render since the last call to resetBindCount.
+    static size_t bindCount;
+
     /// @brief Draw a fan.
     /// @param mesh the mesh
     /// @param tileIndex the tile index
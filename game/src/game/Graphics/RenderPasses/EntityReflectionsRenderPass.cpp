@@ -1,6 +1,7 @@
 #include "game/Graphics/RenderPasses/EntityReflectionsRenderPass.hpp"
 #include "game/Module/Module.hpp"
 #include "game/graphic.h"
+#include "game/graphic_prt.h"
 #include "game/Entities/_Include.hpp"
 #include "game/graphic_fan.h"
 
@@ -8,7 +9,8 @@ namespace Ego {
 namespace Graphics {
 
 EntityReflectionsRenderPass::EntityReflectionsRenderPass() :
-    RenderPass("entity reflections")
+    RenderPass("entity reflections"),
+    _particleBatch()
 {}
 
 void EntityReflectionsRenderPass::doRun(::Camera& camera, const TileList& tl, const EntityList& el)
@@ -63,6 +65,9 @@ void EntityReflectionsRenderPass::doRun(::Camera& camera, const TileList& tl, co
 
                 if (mesh->grid_is_valid(itile) && (0 != mesh->test_fx(itile, MAPFX_REFLECTIVE)))
                 {
+                    // Render the reflected sprites behind the object first.
+                    _particleBatch.flush(false);
+
                     renderer.setColour(Math::Colour4f::white());
 
                     ObjectGraphicsRenderer::render_ref(camera, object);
@@ -70,24 +75,16 @@ void EntityReflectionsRenderPass::doRun(::Camera& camera, const TileList& tl, co
             }
             else if (ObjectRef::Invalid == el.get(i).iobj && ParticleRef::Invalid != el.get(i).iprt)
             {
-                // draw draw front and back faces of polygons
-                renderer.setCullingMode(CullingMode::None);
-
-                // render_one_prt_ref() actually sets its own blend function, but just to be safe
-                // allow transparent objects
-                renderer.setBlendingEnabled(true);
-                // set the default particle blending
-                renderer.setBlendFunction(BlendFunction::SourceAlpha, BlendFunction::OneMinusSourceAlpha);
                 ParticleRef iprt = el.get(i).iprt;
                 Index1D itile = ParticleHandler::get()[iprt]->getTile();
 
                 if (mesh->grid_is_valid(itile) && (0 != mesh->test_fx(itile, MAPFX_REFLECTIVE)))
                 {
-                    renderer.setColour(Math::Colour4f::white());
-                    ParticleGraphicsRenderer::render_one_prt_ref(iprt);
+                    ParticleGraphicsRenderer::render_one_prt_ref(_particleBatch, iprt);
                 }
             }
         }
+        _particleBatch.flush(false);
     }
 }
 
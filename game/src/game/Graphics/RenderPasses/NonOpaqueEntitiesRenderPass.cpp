@@ -8,7 +8,8 @@ namespace Ego {
 namespace Graphics {
 
 NonOpaqueEntitiesRenderPass::NonOpaqueEntitiesRenderPass() :
-    RenderPass("non opaque entities")
+    RenderPass("non opaque entities"),
+    _particleBatch()
 {}
 
 void NonOpaqueEntitiesRenderPass::doRun(::Camera& camera, const TileList& tl, const EntityList& el)
@@ -39,14 +40,17 @@ void NonOpaqueEntitiesRenderPass::doRun(::Camera& camera, const TileList& tl, co
             // A character.
             if (ParticleRef::Invalid == el.get(j).iprt && ObjectRef::Invalid != el.get(j).iobj)
             {
+                // Render the sprites behind the object first.
+                _particleBatch.flush(false);
                 ObjectGraphicsRenderer::render_trans(camera, _currentModule->getObjectHandler()[el.get(j).iobj]);
             }
             // A particle.
             else if (ObjectRef::Invalid == el.get(j).iobj && ParticleRef::Invalid != el.get(j).iprt)
             {
-                ParticleGraphicsRenderer::render_one_prt_trans(el.get(j).iprt);
+                ParticleGraphicsRenderer::render_one_prt_trans(_particleBatch, el.get(j).iprt);
             }
         }
+        _particleBatch.flush(false);
     }
 }
 
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "game/Graphics/RenderPass.hpp"
+#include "egolib/Graphics/ParticleBatch.hpp"
 
 namespace Ego {
 namespace Graphics {
@@ -12,6 +13,9 @@ public:
     NonOpaqueEntitiesRenderPass();
 protected:
 	void doRun(::Camera& cam, const TileList& tl, const EntityList& el) override;
+private:
+    /// @brief The batch of the sprites of particles, flushed before each object to keep the back-to-front order.
+    ParticleBatch _particleBatch;
 };
 	
 } // namespace Graphics
@@ -8,7 +8,8 @@ namespace Ego {
 namespace Graphics {
 
 OpaqueEntitiesRenderPass::OpaqueEntitiesRenderPass() :
-    RenderPass("opaque entities")
+    RenderPass("opaque entities"),
+    _particleBatch()
 {}
 
 void OpaqueEntitiesRenderPass::doRun(::Camera& camera, const TileList& tl, const EntityList& el)
@@ -35,12 +36,12 @@ void OpaqueEntitiesRenderPass::doRun(::Camera& camera, const TileList& tl, const
             }
             else if (ObjectRef::Invalid == el.get(i).iobj && ParticleHandler::get()[el.get(i).iprt] != nullptr)
             {
-                // draw draw front and back faces of polygons
-                renderer.setCullingMode(CullingMode::None);
-
-                ParticleGraphicsRenderer::render_one_prt_solid(el.get(i).iprt);
+                ParticleGraphicsRenderer::render_one_prt_solid(_particleBatch, el.get(i).iprt);
             }
         }
+
+        // Solid sprites write into the depth buffer, their order does not matter.
+        _particleBatch.flush(true);
     }
 }
 
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "game/Graphics/RenderPass.hpp"
+#include "egolib/Graphics/ParticleBatch.hpp"
 
 namespace Ego {
 namespace Graphics {
@@ -12,6 +13,9 @@ public:
 	OpaqueEntitiesRenderPass();
 protected:
 	void doRun(::Camera& cam, const TileList& tl, const EntityList& el) override;
+private:
+    /// @brief The batch of the solid sprites of particles, rendered after all objects.
+    ParticleBatch _particleBatch;
 };
 	
 } // namespace Graphics
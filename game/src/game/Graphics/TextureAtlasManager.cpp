@@ -2,13 +2,56 @@
 #include "game/Core/GameEngine.hpp"
 #include "game/Module/Module.hpp"
 #include "game/graphic.h" //only for MESH_IMG_COUNT constant
+#include "egolib/Graphics/CookedTexture.hpp"
 
 namespace Ego {
 namespace Graphics {
 
+namespace {
+
+// The number of tiled textures of a mesh.
+static constexpr int TILE_TEXTURES = 4;
+// The number of tiles along each axis of a tiled texture.
+static constexpr int SUB_TEXTURES = 8;
+// The number of tiles of each size.
+static constexpr int TILES = TILE_TEXTURES * SUB_TEXTURES * SUB_TEXTURES;
+
+// The layout of the texture atlas in multiples of the small tile size.
+// Every tile is surrounded by a gutter of half the small tile size which continues the tile periodically.
+// Mipmap levels are generated only as long as a cell is covered by whole texels, so a texel never mixes
+// two tiles and the sampled gutter is never thinner than half a texel.
+static constexpr int ATLAS_SIZE = 64;
+static constexpr int BIG_CELL = 3;
+static constexpr int BIG_CELLS_PER_ROW = ATLAS_SIZE / BIG_CELL;
+static constexpr int BIG_ROWS = (TILES + BIG_CELLS_PER_ROW - 1) / BIG_CELLS_PER_ROW;
+static constexpr int SMALL_CELL = 2;
+static constexpr int SMALL_CELLS_PER_ROW = ATLAS_SIZE / SMALL_CELL;
+static constexpr int SMALL_ROWS = (TILES + SMALL_CELLS_PER_ROW - 1) / SMALL_CELLS_PER_ROW;
+static_assert(BIG_ROWS * BIG_CELL + SMALL_ROWS * SMALL_CELL <= ATLAS_SIZE, "tiles do not fit into the atlas");
+
+// Get the position of the upper left corner of a tile (excluding the gutter) in multiples of half the small tile size.
+void getCell(int image, bool big, int& x, int& y) {
+    if (big) {
+        x = (image % BIG_CELLS_PER_ROW) * BIG_CELL * 2 + 1;
+        y = (image / BIG_CELLS_PER_ROW) * BIG_CELL * 2 + 1;
+    } else {
+        x = (image % SMALL_CELLS_PER_ROW) * SMALL_CELL * 2 + 1;
+        y = (BIG_ROWS * BIG_CELL + (image / SMALL_CELLS_PER_ROW) * SMALL_CELL) * 2 + 1;
+    }
+}
+
+int wrap(int x, int n) {
+    return ((x % n) + n) % n;
+}
+
+} // namespace
+
 TextureAtlasManager::TextureAtlasManager() :
     _smallTiles(),
-    _bigTiles() {
+    _bigTiles(),
+    _atlas(),
+    _atlasImage(),
+    _atlasTileSize(0) {
     //ctor        
 }
 
@@ -30,8 +73,24 @@ std::shared_ptr<Ego::Texture> TextureAtlasManager::getBig(int index) const {
     return _bigTiles[index];
 }
 
+std::shared_ptr<Ego::Texture> TextureAtlasManager::getAtlas() const {
+    return _atlas;
+}
+
+void TextureAtlasManager::mapTexCoord(int image, bool big, float& s, float& t) const {
+    if (!_atlas || image < 0 || image >= TILES) {
+        return;
+    }
+    int x, y;
+    getCell(image, big, x, y);
+    const float halfTileSize = 0.5f * _atlasTileSize,
+                tileSize = big ? 2.0f * _atlasTileSize : _atlasTileSize,
+                atlasSize = ATLAS_SIZE * _atlasTileSize;
+    s = (x * halfTileSize + s * tileSize) / atlasSize;
+    t = (y * halfTileSize + t * tileSize) / atlasSize;
+}
+
 void TextureAtlasManager::decimate(const std::shared_ptr<const Ego::Texture>& sourceTexture, std::vector<std::shared_ptr<Ego::Texture>>& targetTextureList, int minification) {
-    static constexpr size_t SUB_TEXTURES = 8;
 
     if (!sourceTexture || !sourceTexture->m_source) {
         return;
@@ -80,23 +139,130 @@ void TextureAtlasManager::decimate(const std::shared_ptr<const Ego::Texture>& so
     }
 }
 
+bool TextureAtlasManager::buildAtlas() {
+    const auto& pfd = Ego::PixelFormatDescriptor::get<Ego::PixelFormat::R8G8B8A8>();
+
+    // All tiled textures must be square and of the same size, a power of two.
+    std::array<std::shared_ptr<SDL_Surface>, TILE_TEXTURES> sourceImages;
+    int sourceSize = 0;
+    bool hasAlpha = false;
+    for (size_t i = 0; i < TILE_TEXTURES; ++i) {
+        auto sourceTexture = _currentModule->getTileTexture(i);
+        if (!sourceTexture || !sourceTexture->m_source) {
+            continue;
+        }
+        const auto& sourceImage = sourceTexture->m_source;
+        if (0 == sourceSize) {
+            sourceSize = sourceImage->w;
+        }
+        if (sourceSize != sourceImage->w || sourceSize != sourceImage->h) {
+            return false;
+        }
+        hasAlpha = hasAlpha || SDL::testAlpha(sourceImage);
+        sourceImages[i] = SDL::convertPixelFormat(sourceImage, pfd);
+        if (SDL_MUSTLOCK(sourceImages[i].get())) {
+            return false;
+        }
+    }
+    const int tileSize = sourceSize / SUB_TEXTURES;
+    if (tileSize < 2 || tileSize * SUB_TEXTURES != sourceSize || Math::powerOfTwo(tileSize) != tileSize) {
+        return false;
+    }
+    const int atlasSize = ATLAS_SIZE * tileSize;
+    if (atlasSize > Ego::Renderer::get().getInfo()->getMaximumTextureSize()) {
+        return false;
+    }
+    auto atlasImage = ImageManager::get().createImage(atlasSize, atlasSize, pfd);
+    if (!atlasImage || SDL_MUSTLOCK(atlasImage.get())) {
+        return false;
+    }
+
+    // Pixels outside of the tiled textures are black, and opaque unless some tile is non-opaque.
+    const uint32_t background = SDL_MapRGBA(atlasImage->format, 0, 0, 0, hasAlpha ? 0 : 0xff);
+    SDL_FillRect(atlasImage.get(), nullptr, background);
+
+    auto pixel = [](const std::shared_ptr<SDL_Surface>& surface, int x, int y) -> uint32_t& {
+        return *reinterpret_cast<uint32_t *>(static_cast<uint8_t *>(surface->pixels) + y * surface->pitch + x * 4);
+    };
+    const int gutter = tileSize / 2;
+    for (int image = 0; image < TILES; ++image) {
+        const auto& sourceImage = sourceImages[image / (SUB_TEXTURES * SUB_TEXTURES)];
+        if (!sourceImage) {
+            continue;
+        }
+        const int sourceX = (image % SUB_TEXTURES) * tileSize,
+                  sourceY = ((image / SUB_TEXTURES) % SUB_TEXTURES) * tileSize;
+        for (int big = 0; big < 2; ++big) {
+            // A big tile covers 2 x 2 small tiles, clipped at the boundary of the tiled texture.
+            const int extent = big ? 2 * tileSize : tileSize;
+            int cellX, cellY;
+            getCell(image, 0 != big, cellX, cellY);
+            cellX *= gutter;
+            cellY *= gutter;
+            for (int y = -gutter; y < extent + gutter; ++y) {
+                const int sy = sourceY + wrap(y, extent);
+                for (int x = -gutter; x < extent + gutter; ++x) {
+                    const int sx = sourceX + wrap(x, extent);
+                    if (sx < sourceSize && sy < sourceSize) {
+                        pixel(atlasImage, cellX + x, cellY + y) = pixel(sourceImage, sx, sy);
+                    }
+                }
+            }
+        }
+    }
+
+    const uint32_t levelCount = static_cast<uint32_t>(std::log2(tileSize)) + 1;
+    auto cookedImage = CookedTexture::cook(atlasImage, 0, true, levelCount);
+    auto atlas = Ego::Renderer::get().createTexture();
+    if (!atlas->load("<tile atlas>", cookedImage)) {
+        return false;
+    }
+    _atlas = atlas;
+    _atlasImage = cookedImage;
+    _atlasTileSize = tileSize;
+    return true;
+}
+
 void TextureAtlasManager::loadTileSet() {
     //Clear any old loaded data
     _smallTiles.clear();
     _bigTiles.clear();
+    _atlas = nullptr;
+    _atlasImage = nullptr;
+    _atlasTileSize = 0;
+
+    // Prefer a single texture atlas.
+    bool hasAtlas = false;
+    try {
+        hasAtlas = buildAtlas();
+    } catch (const id::exception& ex) {
+        Log::get() << Log::Entry::create(Log::Level::Warning, __FILE__, __LINE__, "unable to build tile atlas (", ex.to_string(), ")", Log::EndOfEntry);
+    }
 
-    // Do the "small" textures.
-    for (size_t i = 0; i < 4; ++i) {
-        decimate(_currentModule->getTileTexture(i), _smallTiles, 1);
+    if (!hasAtlas) {
+        // Do the "small" textures.
+        for (size_t i = 0; i < TILE_TEXTURES; ++i) {
+            decimate(_currentModule->getTileTexture(i), _smallTiles, 1);
+        }
+
+        // Do the "big" textures.
+        for (size_t i = 0; i < TILE_TEXTURES; ++i) {
+            decimate(_currentModule->getTileTexture(i), _bigTiles, 2);
+        }
     }
 
-    // Do the "big" textures.
-    for (size_t i = 0; i < 4; ++i) {
-        decimate(_currentModule->getTileTexture(i), _bigTiles, 2);
+    // Map the texture coordinates of the mesh into the atlas or back to the separate textures.
+    auto mesh = _currentModule->getMeshPointer();
+    if (mesh) {
+        mesh->update_textures();
     }
 }
 
 void TextureAtlasManager::reupload() {
+    if (_atlas) {
+        _atlas->load("<tile atlas>", _atlasImage);
+    }
+
     for (std::shared_ptr<Ego::Texture>& texture : _smallTiles) {
         auto surface = texture->m_source;
         texture->load(surface);
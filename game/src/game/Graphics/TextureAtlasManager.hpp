@@ -24,6 +24,29 @@ public:
 
     std::shared_ptr<Ego::Texture> getBig(int which) const;
 
+    /**
+     * @brief
+     *  Get the texture atlas holding all small and big tiles.
+     * @return
+     *  the texture atlas, a null pointer if the tiles are stored in separate textures
+     * @remark
+     *  If the atlas is present, the texture coordinates of the mesh must be mapped into the atlas by mapTexCoord.
+     */
+    std::shared_ptr<Ego::Texture> getAtlas() const;
+
+    /**
+     * @brief
+     *  Map the texture coordinates of a tile into the texture atlas.
+     * @param image
+     *  the index of the tile image i.e. the lower bits of the tile image
+     * @param big
+     *  if the tile is a big tile
+     * @param [in,out] s, t
+     *  the texture coordinates relative to the tile, mapped to texture coordinates relative to the atlas
+     * @remark
+     *  If the atlas is not present, the texture coordinates are not modified.
+     */
+    void mapTexCoord(int image, bool big, float& s, float& t) const;
 
     /// @brief Reupload all textures.
     void reupload();
@@ -33,10 +56,15 @@ public:
      *  Decmiate all tiled textures of the current mesh.
      *  This turns a big texture tilemap into many smaller textures
      *  for each tile type (tile0.bmp, tile1.bmp etc.)
+     *  If all tiled textures are of the same size, the tiles are packed into a single texture atlas
+     *  instead such that the mesh can be rendered without switching textures.
      */
     void loadTileSet();
 
 private:
+    // pack all tiled textures of the current mesh into a texture atlas
+    bool buildAtlas();
+
     // decimate one tiled texture of a mesh
     void decimate(const std::shared_ptr<const Ego::Texture>& src_tx, std::vector<std::shared_ptr<Ego::Texture>>& targetTextureList, int minification);
 
@@ -46,6 +74,15 @@ private:
 
     // the "large" textures
     std::vector<std::shared_ptr<Ego::Texture>> _bigTiles;
+
+    // the texture atlas
+    std::shared_ptr<Ego::Texture> _atlas;
+
+    // the cooked image of the texture atlas
+    std::shared_ptr<Ego::CookedTexture> _atlasImage;
+
+    // the size of a small tile in the texture atlas, in pixels
+    int _atlasTileSize;
 };
 
 } //namespace Graphics
@@ -38,7 +38,8 @@ TileList::TileList() :
 	_water(),
 
 	_renderTiles(),
-	_lastRenderTiles()
+	_lastRenderTiles(),
+	_enteredTiles()
 {
     try
     {
@@ -74,6 +75,7 @@ void TileList::reset()
 	// Clear out the "in render list" flag for the old mesh.
 	_lastRenderTiles = _renderTiles;
 	_renderTiles.reset();
+	_enteredTiles.clear();
 
 	// Re-initialize the renderlist.
 	init();
@@ -134,9 +136,7 @@ gfx_rv TileList::add(const Index1D& index, ::Camera& camera)
 
 	// if the tile was not in the renderlist last frame, then we need to force a lighting update of this tile
 	if(!_lastRenderTiles[index.i()]) {
-		ego_tile_info_t& tile = getMesh()->_tmem.get(index);
-		tile._lightingCache.setNeedUpdate(true);
-		tile._lightingCache.setLastFrame(-1);
+		_enteredTiles.push_back(index);
 	}
 
 	if (gfx_error == insert(index, camera))
@@ -147,6 +147,17 @@ gfx_rv TileList::add(const Index1D& index, ::Camera& camera)
 	return gfx_success;
 }
 
+void TileList::invalidateEnteredTiles()
+{
+	auto mesh = getMesh();
+	for (const Index1D& index : _enteredTiles) {
+		ego_tile_info_t& tile = mesh->_tmem.get(index);
+		tile._lightingCache.setNeedUpdate(true);
+		tile._lightingCache.setLastFrame(-1);
+	}
+	_enteredTiles.clear();
+}
+
 bool TileList::inRenderList(const Index1D& index) const
 {
 	if(index == Index1D::Invalid) return false;
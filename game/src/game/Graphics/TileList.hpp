@@ -105,8 +105,14 @@ struct TileList
 	/// @brief Insert a tile into this render list.
 	/// @param the index of the tile to insert
 	/// @param camera the camera
+	/// @remark If the tile was not in the render list last frame, it is remembered as an entered tile.
+	///         Its lighting is not invalidated before invalidateEnteredTiles() is invoked such that
+	///         the render lists of several cameras can be built concurrently.
 	gfx_rv add(const Index1D& index, ::Camera& camera);
 
+	/// @brief Force a lighting update of the tiles which entered this render list since the last invocation.
+	void invalidateEnteredTiles();
+
 	/// @brief check wheter a tile was rendered this render frame.
 	/// @param index the index number of the tile
 	/// @return true if the specified tile is currently in the render list for this render frame
@@ -115,6 +121,7 @@ struct TileList
 private:
 	std::bitset<MAP_TILE_MAX> _renderTiles;		//index of all tiles to be rendered
 	std::bitset<MAP_TILE_MAX> _lastRenderTiles; //index of all tiles that were rendered last frame
+	std::vector<Index1D> _enteredTiles;         //index of all tiles that were not rendered last frame
 };
 
 }
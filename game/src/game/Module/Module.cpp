@@ -55,6 +55,8 @@ GameModule::GameModule(const std::shared_ptr<ModuleProfile> &profile, const uint
     _damageTile(),
 
     _passages(),
+    _passageMapStart(),
+    _passageMap(),
     _mesh(std::make_shared<ego_mesh_t>()),
     _tileTextures(),
     _waterTextures(),
@@ -226,6 +228,103 @@ void GameModule::loadAllPassages()
         //finished loading this one!
         _passages.push_back(passage);
     }
+
+    buildPassageMap();
+}
+
+void GameModule::buildPassageMap()
+{
+    const size_t tileCount = _mesh->_info.getTileCount();
+
+    // Count the passages covering each tile.
+    std::vector<uint32_t> start(tileCount + 1, 0);
+    for (const std::shared_ptr<Passage>& passage : _passages) {
+        for (const Index1D& tile : passage->getTiles()) {
+            start[tile.i() + 1]++;
+        }
+    }
+    for (size_t i = 0; i < tileCount; ++i) {
+        start[i + 1] += start[i];
+    }
+
+    // Store the passage IDs of each tile. Passages are visited in order, hence the IDs are ascending.
+    std::vector<uint16_t> map(start[tileCount]);
+    std::vector<uint32_t> next(start.begin(), start.end() - 1);
+    for (size_t id = 0; id < _passages.size(); ++id) {
+        for (const Index1D& tile : _passages[id]->getTiles()) {
+            map[next[tile.i()]++] = static_cast<uint16_t>(id);
+        }
+    }
+
+    _passageMapStart.swap(start);
+    _passageMap.swap(map);
+}
+
+IndexRect GameModule::getPassageTiles(const AxisAlignedBox2f& box) const
+{
+    const float size = Info<float>::Grid::Size();
+    // Tile x spans [x * size, (x + 1) * size] and passages include their boundary.
+    const int x0 = std::max(0, static_cast<int>(std::ceil(box.getMin().x() / size)) - 1),
+              y0 = std::max(0, static_cast<int>(std::ceil(box.getMin().y() / size)) - 1),
+              x1 = std::min(static_cast<int>(_mesh->_info.getTileCountX()) - 1, static_cast<int>(std::floor(box.getMax().x() / size))),
+              y1 = std::min(static_cast<int>(_mesh->_info.getTileCountY()) - 1, static_cast<int>(std::floor(box.getMax().y() / size)));
+    if (x0 > x1 || y0 > y1) {
+        return IndexRect(Index2D(0, 0), Index2D(-1, -1));
+    }
+    return IndexRect(Index2D(x0, y0), Index2D(x1, y1));
+}
+
+std::vector<uint16_t> GameModule::getPassageIDs(const IndexRect& tiles) const
+{
+    std::vector<uint16_t> ids;
+    if (_passageMap.empty()) {
+        return ids;
+    }
+    for (int y = tiles.min().y(); y <= tiles.max().y(); ++y) {
+        for (int x = tiles.min().x(); x <= tiles.max().x(); ++x) {
+            const Index1D tile = _mesh->getTileIndex(Index2D(x, y));
+            ids.insert(ids.end(), _passageMap.begin() + _passageMapStart[tile.i()],
+                                  _passageMap.begin() + _passageMapStart[tile.i() + 1]);
+        }
+    }
+    std::sort(ids.begin(), ids.end());
+    ids.erase(std::unique(ids.begin(), ids.end()), ids.end());
+    return ids;
+}
+
+void GameModule::updatePassageOccupancy(Object& object)
+{
+    if (_passageMap.empty()) {
+        return;
+    }
+    const IndexRect tiles = getPassageTiles(object.getAxisAlignedBox2D());
+    if (tiles == object.passageTiles) {
+        return;
+    }
+
+    const std::vector<uint16_t> oldIDs = getPassageIDs(object.passageTiles),
+                                newIDs = getPassageIDs(tiles);
+    object.passageTiles = tiles;
+
+    // Only visit the passages which were entered or left.
+    std::vector<uint16_t> changed;
+    std::set_difference(oldIDs.begin(), oldIDs.end(), newIDs.begin(), newIDs.end(), std::back_inserter(changed));
+    for (uint16_t id : changed) {
+        _passages[id]->removeOccupant(object.getObjRef());
+    }
+    changed.clear();
+    std::set_difference(newIDs.begin(), newIDs.end(), oldIDs.begin(), oldIDs.end(), std::back_inserter(changed));
+    for (uint16_t id : changed) {
+        _passages[id]->addOccupant(object.getObjRef());
+    }
+}
+
+void GameModule::removePassageOccupant(Object& object)
+{
+    for (uint16_t id : getPassageIDs(object.passageTiles)) {
+        _passages[id]->removeOccupant(object.getObjRef());
+    }
+    object.passageTiles = IndexRect(Index2D(0, 0), Index2D(-1, -1));
 }
 
 void GameModule::checkPassageMusic()
@@ -241,10 +340,10 @@ void GameModule::checkPassageMusic()
         // Don't do items in hands or inventory.
         if(pchr->isBeingHeld()) continue;
 
-        //Loop through every passage
-        for (const std::shared_ptr<Passage>& passage : _passages)
+        //Loop through every passage the player might be inside
+        for (uint16_t id : getPassageIDs(pchr->passageTiles))
         {
-            if (passage->checkPassageMusic(pchr))
+            if (_passages[id]->checkPassageMusic(pchr))
             {
                 return;
             }
@@ -253,8 +352,10 @@ void GameModule::checkPassageMusic()
 }
 
 ObjectRef GameModule::getShopOwner(const float x, const float y) {
-    // Loop through every passage.
-    for(const std::shared_ptr<Passage>& passage : _passages) {
+    // Loop through every passage covering the point.
+    const Point2f point(x, y);
+    for(uint16_t id : getPassageIDs(getPassageTiles(AxisAlignedBox2f(point, point)))) {
+        const std::shared_ptr<Passage>& passage = _passages[id];
         // Only check actual shops.
         if(!passage->isShop()) {
             continue;
@@ -429,6 +530,7 @@ std::shared_ptr<Object> GameModule::spawnObject(const Vector3f& pos, ObjectProfi
     pchr->canuseplatforms = ppro->canUsePlatforms();
     pchr->isitem          = ppro->isItem();
     pchr->invictus        = ppro->isInvincible();
+    getObjectHandler().updateCategories(*pchr);
 
     // Jumping
     pchr->setBaseAttribute(Ego::Attribute::JUMP_POWER, ppro->getJumpPower());
@@ -501,7 +603,7 @@ std::shared_ptr<Object> GameModule::spawnObject(const Vector3f& pos, ObjectProfi
     ai_state_t::spawn( pchr->ai, pchr->getObjRef(), pchr->getProfileID().get(), getTeamList()[team].getMorale() );
 
     // Team stuff
-    pchr->team     = team;
+    pchr->assignTeam(team);
     pchr->team_base = team;
     if ( !pchr->isInvincible() )  getTeamList()[team].increaseMorale();
 
@@ -564,7 +666,7 @@ std::shared_ptr<Object> GameModule::spawnObject(const Vector3f& pos, ObjectProfi
     for ( uint8_t tnc = 0; tnc < ppro->getAttachedParticleAmount(); tnc++ )
     {
         ParticleHandler::get().spawnParticle( pchr->getPosition(), pchr->ori.facing_z, ppro->getSlotNumber(), ppro->getAttachedParticleProfile(),
-                                              pchr->getObjRef(), GRIP_LAST + tnc, pchr->team, pchr->getObjRef(), ParticleRef::Invalid, tnc);
+                                              pchr->getObjRef(), GRIP_LAST + tnc, pchr->getTeamRef(), pchr->getObjRef(), ParticleRef::Invalid, tnc);
     }
 
     // is the object part of a shop's inventory?
@@ -602,7 +704,7 @@ std::shared_ptr<Object> GameModule::spawnObject(const Vector3f& pos, ObjectProfi
     ppro->_spawnCount++;
 
 #if defined(DEBUG_OBJECT_SPAWN) && defined(_DEBUG)
-    log_debug( "spawnObject() - slot: %i, index: %i, name: %s, class: %s\n", REF_TO_INT( profile ), REF_TO_INT( pchr->getCharacterID() ), name.c_str(), ppro->getClassName().c_str() );
+    log_debug( "spawnObject() - slot: %i, index: %" PRIuZ ", name: %s, class: %s\n", REF_TO_INT( profile ), pchr->getCharacterID().get(), name.c_str(), ppro->getClassName().c_str() );
 #endif
 
     return pchr;
@@ -681,6 +783,7 @@ bool GameModule::addPlayer(const std::shared_ptr<Object>& object, const Ego::Inp
     //Local player added
     local_stats.noplayers = false;
     object->islocalplayer = true;
+    getObjectHandler().updateCategories(*object);
     local_stats.player_count++;
 
     return true;
@@ -123,6 +123,20 @@ public:
      */
     void removeShopOwner(ObjectRef owner);
 
+    /**
+     * @brief
+     *  Update the passages an object might be inside after its bounding box changed.
+     * @remark
+     *  The object is an occupant of every passage having a tile its bounding box overlaps.
+     */
+    void updatePassageOccupancy(Object& object);
+
+    /**
+     * @brief
+     *  Remove an object from the occupants of all passages.
+     */
+    void removePassageOccupant(Object& object);
+
     /**
      * @return
      *  number of passages currently loaded
@@ -243,6 +257,28 @@ private:
     **/
     void loadAllPassages();
 
+    /**
+    * @brief
+    *   Build the map from tiles to the passages covering them
+    **/
+    void buildPassageMap();
+
+    /**
+    * @brief
+    *   Get the tiles overlapped by a box, including the tiles it only touches
+    * @return
+    *   the tiles, the rectangle is empty if the box is outside the mesh
+    **/
+    IndexRect getPassageTiles(const AxisAlignedBox2f& box) const;
+
+    /**
+    * @brief
+    *   Get the IDs of the passages covering any of the specified tiles
+    * @return
+    *   the passage IDs in ascending order
+    **/
+    std::vector<uint16_t> getPassageIDs(const IndexRect& tiles) const;
+
     /**
     * @brief
     *   Load alliance.txt which tells which teams like which teams
@@ -281,6 +317,8 @@ private:
 
     const std::shared_ptr<ModuleProfile> _moduleProfile;
     std::vector<std::shared_ptr<Passage>> _passages;    ///< All passages in this module
+    std::vector<uint32_t> _passageMapStart;              ///< For each tile, the offset of its first passage ID in _passageMap
+    std::vector<uint16_t> _passageMap;                   ///< The IDs of the passages covering each tile, in ascending order
     std::vector<Team> _teamList;
     ObjectHandler _gameObjects;
     std::list<std::string> _playerNameList;     ///< List of all import players
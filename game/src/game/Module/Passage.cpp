@@ -37,7 +37,8 @@ Passage::Passage(GameModule &module, const int x0, const int y0, const int x1, c
     _open(true),
     _isShop(false),
     _shopOwner(SHOP_NOOWNER),
-    _passageFans()
+    _passageFans(),
+    _occupants()
 {
     //Build the list of all tiles contained within this passage
     for (int y = y0; y <= y1; ++y) {
@@ -84,8 +85,13 @@ bool Passage::close()
         std::vector<std::shared_ptr<Object>> crushedCharacters;
 
         // Make sure it isn't blocked
-        for(const std::shared_ptr<Object> &object : _module.getObjectHandler().iterator())
+        for(ObjectRef occupant : _occupants)
         {
+            const std::shared_ptr<Object> &object = _module.getObjectHandler()[occupant];
+            if(!object) {
+                continue;
+            }
+
             //Scenery can neither be crushed nor prevents doors from closing
             if(object->isScenery()) {
                 continue;
@@ -135,10 +141,11 @@ ObjectRef Passage::whoIsBlockingPassage( ObjectRef objRef, const IDSZ2& idsz, co
     if ( !_module.getObjectHandler().exists(objRef) ) return ObjectRef::Invalid;
     Object *psrc = _module.getObjectHandler().get(objRef);
 
-    // Look at each character
-    for(const std::shared_ptr<Object> &pchr : _module.getObjectHandler().iterator())
+    // Look at each character which might be inside
+    for(ObjectRef occupant : _occupants)
     {
-        if(pchr->isTerminated()) {
+        const std::shared_ptr<Object> &pchr = _module.getObjectHandler()[occupant];
+        if(!pchr || pchr->isTerminated()) {
             continue;
         }
 
@@ -249,20 +256,19 @@ void Passage::makeShop(ObjectRef owner)
     _shopOwner = owner;
 
     // flag every item in the shop as a shop item
-    for(const std::shared_ptr<Object> &object : _module.getObjectHandler().iterator())
+    ObjectHandler& objectHandler = _module.getObjectHandler();
+    for(ObjectRef item : objectHandler.getCategory(ObjectCategory::Item))
     {
-        if (object->isTerminated()) continue;
+        const std::shared_ptr<Object> &object = objectHandler[item];
+        if (!object || object->isTerminated()) continue;
 
-        if ( object->isitem )
+        if (objectIsInPassage(object))
         {
-            if (objectIsInPassage(object))
-            {
-                object->isshopitem = true;               // Full value
-                object->iskursed   = false;              // Shop items are never kursed
-                object->nameknown  = true;               // Identify it!
-            }
+            object->isshopitem = true;               // Full value
+            object->iskursed   = false;              // Shop items are never kursed
+            object->nameknown  = true;               // Identify it!
         }
-    }    
+    }
 }
 
 void Passage::removeShop()
@@ -279,3 +285,29 @@ const AxisAlignedBox2f& Passage::getAxisAlignedBox2f() const
 {
     return _area;
 }
+
+const std::vector<Index1D>& Passage::getTiles() const
+{
+    return _passageFans;
+}
+
+const std::vector<ObjectRef>& Passage::getOccupants() const
+{
+    return _occupants;
+}
+
+void Passage::addOccupant(ObjectRef objRef)
+{
+    if (std::find(_occupants.begin(), _occupants.end(), objRef) == _occupants.end()) {
+        _occupants.push_back(objRef);
+    }
+}
+
+void Passage::removeOccupant(ObjectRef objRef)
+{
+    auto it = std::find(_occupants.begin(), _occupants.end(), objRef);
+    if (it != _occupants.end()) {
+        *it = _occupants.back();
+        _occupants.pop_back();
+    }
+}
@@ -128,6 +128,33 @@ public:
     **/
     const AxisAlignedBox2f& getAxisAlignedBox2f() const;
 
+    /**
+    * @brief
+    *   Get the tiles covered by this passage.
+    **/
+    const std::vector<Index1D>& getTiles() const;
+
+    /**
+    * @brief
+    *   Get the objects which might be inside this passage.
+    * @remark
+    *   The occupants are all objects whose bounding box overlaps a tile of this passage.
+    *   objectIsInPassage() decides if an occupant is actually inside this passage.
+    **/
+    const std::vector<ObjectRef>& getOccupants() const;
+
+    /**
+    * @brief
+    *   Add an object to the occupants of this passage.
+    **/
+    void addOccupant(ObjectRef objRef);
+
+    /**
+    * @brief
+    *   Remove an object from the occupants of this passage.
+    **/
+    void removeOccupant(ObjectRef objRef);
+
 private:
     GameModule& _module;			   ///< Reference to the module we are inside
 
@@ -139,4 +166,5 @@ private:
     bool _isShop;					   ///< True if this passage is a shop
     ObjectRef _shopOwner;			   ///< object reference of the owner of this shop
     std::vector<Index1D> _passageFans; //List of all tile indexes contained in this passage
+    std::vector<ObjectRef> _occupants; //List of all objects overlapping the tiles of this passage
 };
@@ -163,7 +163,7 @@ bool upload_water_layer_data(water_instance_layer_t inst[], const wawalite_water
     // set the frame
     for (int layer = 0; layer < layer_count; layer++)
     {
-        inst[layer]._frame = Random::next<uint16_t>(WATERFRAMEAND);
+        inst[layer]._frame = Random::get(Random::Stream::Weather).next<uint16_t>(WATERFRAMEAND);
     }
 
     if (nullptr != data)
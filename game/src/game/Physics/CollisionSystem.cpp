@@ -43,11 +43,11 @@ CollisionSystem::~CollisionSystem()
 
 void CollisionSystem::update()
 {
-    // blank the accumulators
-    for(const std::shared_ptr<Object> &object : _currentModule->getObjectHandler().iterator())
+    // blank the accumulators, the object accumulators are cleared with a linear scan over their store
+    _currentModule->getObjectHandler().getHotStates().forEach([](ObjectHotState& state)
     {
-        object->phys.clear();
-    }
+        state.phys.clear();
+    });
     for(const std::shared_ptr<Ego::Particle> &particle : ParticleHandler::get().iterator())
     {
         particle->phys.clear();
@@ -906,7 +906,7 @@ bool ObjectPhysics::attachToObject(const std::shared_ptr<Object> &holder, grip_o
     // Set the team
     if (_object.isItem())
     {
-        _object.team = holder->team;
+        _object.assignTeam(holder->getTeamRef());
 
         // Set the alert
         if (_object.isAlive()) {
@@ -923,7 +923,7 @@ bool ObjectPhysics::attachToObject(const std::shared_ptr<Object> &holder, grip_o
 
     if (holder->isMount())
     {
-        holder->team = _object.team;
+        holder->assignTeam(_object.getTeamRef());
 
         // Set the alert
         if (!holder->isItem() && holder->isAlive())
@@ -1035,6 +1035,11 @@ void ObjectPhysics::updateCollisionSize(bool update_matrix)
                                _object.getPosY() + _object.chr_min_cv.getMin()[OCT_Y]),
                                Point2f(_object.getPosX() + _object.chr_min_cv.getMax()[OCT_X],
                                _object.getPosY() + _object.chr_min_cv.getMax()[OCT_Y]));
+
+    //Keep track of the passages this object might be inside
+    if(_currentModule) {
+        _currentModule->updatePassageOccupancy(_object);
+    }
 }
 
 bool ObjectPhysics::floorIsSlippy() const
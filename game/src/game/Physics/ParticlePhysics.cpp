@@ -339,13 +339,13 @@ void ParticlePhysics::updateHoming()
     Vector3f vdither;
     int ival;
 
-    ival = Random::next(std::numeric_limits<uint16_t>::max());
+    ival = Random::get(Random::Stream::Particles).next(std::numeric_limits<uint16_t>::max());
     vdither.x() = (((float)ival / 0x8000) - 1.0f)  * uncertainty;
 
-    ival = Random::next(std::numeric_limits<uint16_t>::max());
+    ival = Random::get(Random::Stream::Particles).next(std::numeric_limits<uint16_t>::max());
     vdither.y() = (((float)ival / 0x8000) - 1.0f)  * uncertainty;
 
-    ival = Random::next(std::numeric_limits<uint16_t>::max());
+    ival = Random::get(Random::Stream::Particles).next(std::numeric_limits<uint16_t>::max());
     vdither.z() = (((float)ival / 0x8000) - 1.0f)  * uncertainty;
 
     // take away any dithering along the direction of motion of the particle
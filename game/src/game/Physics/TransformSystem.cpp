@@ -0,0 +1,114 @@
+//********************************************************************************************
+//*
+//*    This file is part of Egoboo.
+//*
+//*    Egoboo is free software: you can redistribute it and/or modify it
+//*    under the terms of the GNU General Public License as published by
+//*    the Free Software Foundation, either version 3 of the License, or
+//*    (at your option) any later version.
+//*
+//*    Egoboo is distributed in the hope that it will be useful, but
+//*    WITHOUT ANY WARRANTY; without even the implied warranty of
+//*    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+//*    General Public License for more details.
+//*
+//*    You should have received a copy of the GNU General Public License
+//*    along with Egoboo.  If not, see <http://www.gnu.org/licenses/>.
+//*
+//********************************************************************************************
+#include "TransformSystem.hpp"
+#include "game/Entities/_Include.hpp"
+#include "game/CharacterMatrix.h"
+
+namespace Ego
+{
+namespace Physics
+{
+
+TransformSystem::TransformSystem() :
+    _levels(),
+    _matrixUpdateCount(0),
+    _vertexUpdateCount(0)
+{
+
+}
+
+TransformSystem::~TransformSystem()
+{
+
+}
+
+Object *TransformSystem::getParent(const Object &object)
+{
+    ObjectHandler &objectHandler = _currentModule->getObjectHandler();
+
+    // held items and riders depend on their holder/mount
+    if (objectHandler.exists(object.attachedto)) {
+        return objectHandler.get(object.attachedto);
+    }
+
+    // overlays copy the matrix of the object they are overlaying
+    const ObjectRef overlaid = object.ai.getTarget();
+    if (object.is_overlay && overlaid != object.getObjRef() && objectHandler.exists(overlaid)) {
+        return objectHandler.get(overlaid);
+    }
+
+    return nullptr;
+}
+
+size_t TransformSystem::getDepth(const Object &object)
+{
+    size_t depth = 0;
+    for (const Object *parent = getParent(object); nullptr != parent && depth < MaximumDepth; parent = getParent(*parent)) {
+        depth++;
+    }
+    return depth;
+}
+
+void TransformSystem::update()
+{
+    // sort the objects by their attachment depth
+    for (std::vector<Object*> &level : _levels) {
+        level.clear();
+    }
+    const auto &mesh = _currentModule->getMeshPointer();
+    for (const std::shared_ptr<Object> &object : _currentModule->getObjectHandler().iterator()) {
+        //Dont do terminated characters or characters which are not drawn
+        if (object->isTerminated() || object->isInsideInventory()) continue;
+
+        //Skip objects outside the map
+        if (!mesh->grid_is_valid(object->getTile())) continue;
+
+        _levels[getDepth(*object)].push_back(object.get());
+    }
+
+    // process the levels top-down, the holders/mounts of a level are up to date when it is processed
+    for (const std::vector<Object*> &level : _levels) {
+        for (Object *object : level) {
+            // make sure that the vertices are interpolated, this includes the grip vertices of held items
+            if (gfx_error == object->inst.updateVertices(-1, -1, true)) {
+                continue;
+            }
+
+            // the instance has changed, refresh the matrix and the collision bound
+            if (rv_error == chr_update_own_matrix(object, false, false)) {
+                continue;
+            }
+            object->getObjectPhysics().updateCollisionSize(false);
+        }
+    }
+
+    // keep particles with whomever they are attached to
+    for (const std::shared_ptr<Ego::Particle> &particle : ParticleHandler::get().iterator()) {
+        if (particle->isTerminated() || particle->isHidden() || !particle->isAttached()) continue;
+        particle->placeAtVertex(particle->getAttachedObject(), particle->attachedto_vrt_off);
+    }
+
+    // publish and reset the counters
+    _matrixUpdateCount = g_transform_counters.matrices;
+    _vertexUpdateCount = g_transform_counters.vertices;
+    g_transform_counters = transform_counters_t();
+}
+
+} //namespace Physics
+} //namespace Ego
@@ -0,0 +1,97 @@
+//********************************************************************************************
+//*
+//*    This file is part of Egoboo.
+//*
+//*    Egoboo is free software: you can redistribute it and/or modify it
+//*    under the terms of the GNU General Public License as published by
+//*    the Free Software Foundation, either version 3 of the License, or
+//*    (at your option) any later version.
+//*
+//*    Egoboo is distributed in the hope that it will be useful, but
+//*    WITHOUT ANY WARRANTY; without even the implied warranty of
+//*    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+//*    General Public License for more details.
+//*
+//*    You should have received a copy of the GNU General Public License
+//*    along with Egoboo.  If not, see <http://www.gnu.org/licenses/>.
+//*
+//********************************************************************************************
+#pragma once
+
+/// @file game/Physics/TransformSystem.hpp
+/// @brief Per-update recomputation of object matrices in the order of their attachments.
+
+#include "egolib/egolib.h"
+
+//Forward declarations
+class Object;
+
+namespace Ego
+{
+namespace Physics
+{
+
+/**
+ * @brief
+ *  Recomputes the matrices, vertices and collision sizes of all objects once per update.
+ *  Objects are processed in the order of their attachment depth (mount, rider, held item,
+ *  overlay), then attached particles are placed. The matrix of an object only depends on
+ *  objects of lower depth, so no object is recomputed twice in one pass.
+ * @remark
+ *  Objects of the same depth are independent of each other and could be processed in parallel.
+ *  This is not done as updating the collision size and logging are not thread-safe.
+ */
+class TransformSystem : public Core::Singleton<TransformSystem>
+{
+public:
+    /// The maximum attachment depth, deeper attachments are processed at this depth.
+    static constexpr size_t MaximumDepth = 8;
+
+    /**
+    * @brief
+    *   Recompute the transforms of all objects and attached particles.
+    **/
+    void update();
+
+    /**
+    * @brief
+    *   Get the number of matrices recomputed during the last update, including recomputations
+    *   requested outside of the pass.
+    **/
+    size_t getMatrixUpdateCount() const { return _matrixUpdateCount; }
+
+    /**
+    * @brief
+    *   Get the number of vertex interpolations during the last update, including interpolations
+    *   requested outside of the pass.
+    **/
+    size_t getVertexUpdateCount() const { return _vertexUpdateCount; }
+
+private:
+    /**
+    * @brief
+    *   Get the object the matrix of an object depends on.
+    * @return
+    *   the holder/mount or the overlaid object, @a nullptr if the object does not depend on another object
+    **/
+    static Object *getParent(const Object &object);
+
+    /**
+    * @brief
+    *   Get the attachment depth of an object i.e. the number of objects its matrix depends on.
+    **/
+    static size_t getDepth(const Object &object);
+
+private:
+    friend Core::Singleton<TransformSystem>::CreateFunctorType;
+    friend Core::Singleton<TransformSystem>::DestroyFunctorType;
+    TransformSystem();
+    ~TransformSystem();
+
+    std::array<std::vector<Object*>, MaximumDepth + 1> _levels;    ///< the objects of each attachment depth
+    size_t _matrixUpdateCount;                                      ///< matrices recomputed during the last update
+    size_t _vertexUpdateCount;                                      ///< vertex interpolations during the last update
+};
+
+} //namespace Physics
+} //namespace Ego
@@ -507,7 +507,7 @@ bool do_chr_prt_collision_deflect(chr_prt_collision_data_t& pdata)
                 pdata.pprt->phys.avel -= pdata.vdiff * 2.0f;
 
                 // Change the owner of the missile
-                pdata.pprt->team       = pdata.pchr->team;
+                pdata.pprt->team       = pdata.pchr->getTeamRef();
                 pdata.pprt->owner_ref  = pdata.pchr->getObjRef();
             }
         }
@@ -566,7 +566,7 @@ bool do_chr_prt_collision_deflect(chr_prt_collision_data_t& pdata)
                 total_block_rating += 2 * pdata.pchr->getAttribute(Ego::Attribute::MIGHT);
 
                 // Now determine the result of the block
-                if ( Random::getPercent() <= total_block_rating )
+                if ( Random::get(Random::Stream::Particles).getPercent() <= total_block_rating )
                 {
                     // Defender won, the block holds
                     // Add a small stun to the attacker = 40/50 (0.8 seconds)
@@ -742,7 +742,7 @@ bool do_chr_prt_collision_damage( chr_prt_collision_data_t& pdata )
 
                     //Disintegrate perk deals +100 ZAP damage at 0.025% chance per Intellect!
                     if(pdata.pprt->damagetype == DAMAGE_ZAP && powner->hasPerk(Ego::Perks::DISINTEGRATE)) {
-                        if(Random::nextFloat()*100.0f <= powner->getAttribute(Ego::Attribute::INTELLECT) * 0.025f) {
+                        if(Random::get(Random::Stream::Particles).nextFloat()*100.0f <= powner->getAttribute(Ego::Attribute::INTELLECT) * 0.025f) {
                             modifiedDamage.base += FLOAT_TO_FP8(100.0f);
                             GFX::get().getBillboardSystem().makeBillboard(pdata.pchr->getObjRef(), "Disintegrated!", Ego::Math::Colour4f::white(), Ego::Math::Colour4f::purple(), 6, Ego::Graphics::Billboard::Flags::All);
 
@@ -791,7 +791,7 @@ bool do_chr_prt_collision_damage( chr_prt_collision_data_t& pdata )
                 if(spawnerProfile != nullptr && powner->hasPerk(Ego::Perks::GRIM_REAPER)) {
 
                     //Is it a Scythe?
-                    if(spawnerProfile->getIDSZ(IDSZ_TYPE).equals('S','C','Y','T') && Random::getPercent() <= 5) {
+                    if(spawnerProfile->getIDSZ(IDSZ_TYPE).equals('S','C','Y','T') && Random::get(Random::Stream::Particles).getPercent() <= 5) {
 
                         //Make sure they can be damaged by EVIL first
                         if(pdata.pchr->getAttribute(Ego::Attribute::EVIL_MODIFIER) == NONE) {
@@ -808,7 +808,7 @@ bool do_chr_prt_collision_damage( chr_prt_collision_data_t& pdata )
                 //Deadly Strike perk (1% chance per character level to trigger vs non undead)
                 if(meleeAttack && !pdata.pchr->getProfile()->getIDSZ(IDSZ_PARENT).equals('U','N','D','E'))
                 {
-                    if(powner->hasPerk(Ego::Perks::DEADLY_STRIKE) && powner->getExperienceLevel() >= Random::getPercent() && DamageType_isPhysical(pdata.pprt->damagetype)){
+                    if(powner->hasPerk(Ego::Perks::DEADLY_STRIKE) && powner->getExperienceLevel() >= Random::get(Random::Stream::Particles).getPercent() && DamageType_isPhysical(pdata.pprt->damagetype)){
                         //Gain +0.25 damage per Agility
                         modifiedDamage.base += FLOAT_TO_FP8(powner->getAttribute(Ego::Attribute::AGILITY) * 0.25f);
                         GFX::get().getBillboardSystem().makeBillboard(powner->getObjRef(), "Deadly Strike", Ego::Math::Colour4f::white(), Ego::Math::Colour4f::blue(), 3, Ego::Graphics::Billboard::Flags::All);
@@ -843,7 +843,7 @@ bool do_chr_prt_collision_damage( chr_prt_collision_data_t& pdata )
                     critChance += 10.0f;
                 }
 
-                if(Random::getPercent() <= critChance) {
+                if(Random::get(Random::Stream::Particles).getPercent() <= critChance) {
                     modifiedDamage.base += modifiedDamage.rand;
                     modifiedDamage.rand = 0;
                     GFX::get().getBillboardSystem().makeBillboard(powner->getObjRef(), "Critical Hit!", Ego::Math::Colour4f::white(), Ego::Math::Colour4f::red(), 3, Ego::Graphics::Billboard::Flags::All);
@@ -898,19 +898,19 @@ bool do_chr_prt_collision_bump( chr_prt_collision_data_t& pdata )
     }
 
     // does the particle team hate the character's team
-    bool prt_hates_chr = team_hates_team( pdata.pprt->team, pdata.pchr->team );
+    bool prt_hates_chr = team_hates_team( pdata.pprt->team, pdata.pchr->getTeamRef() );
 
     // Only bump into hated characters?
     bool valid_onlydamagehate = prt_hates_chr && pdata.pprt->getProfile()->hateonly;
 
     // allow neutral particles to attack anything
     bool prt_attacks_chr = false;
-    if(prt_hates_chr || ((Team::TEAM_NULL != pdata.pchr->team) && (Team::TEAM_NULL == pdata.pprt->team)) ) {
+    if(prt_hates_chr || ((Team::TEAM_NULL != pdata.pchr->getTeamRef()) && (Team::TEAM_NULL == pdata.pprt->team)) ) {
         prt_attacks_chr = (maxDamage > 0);
     }
 
     // this is the onlydamagefriendly condition from the particle search code
-    bool valid_onlydamagefriendly = (pdata.ppip->onlydamagefriendly && pdata.pprt->team == pdata.pchr->team)
+    bool valid_onlydamagefriendly = (pdata.ppip->onlydamagefriendly && pdata.pprt->team == pdata.pchr->getTeamRef())
 		                         || (!pdata.ppip->onlydamagefriendly && prt_attacks_chr);
 
     // I guess "friendly fire" does not mean "self fire", which is a bit unfortunate.
@@ -1050,7 +1050,7 @@ void do_chr_prt_collision_knockback(chr_prt_collision_data_t &pdata)
 
             //+3% chance per owner Intellect and -1% per target Might
             float chance = attacker->getAttribute(Ego::Attribute::INTELLECT) * 0.03f - pdata.pchr->getAttribute(Ego::Attribute::MIGHT)*0.01f;
-            if(Random::nextFloat() <= chance) {
+            if(Random::get(Random::Stream::Particles).nextFloat() <= chance) {
                 knockbackFactor += 5.0f;
                 GFX::get().getBillboardSystem().makeBillboard(attacker->getObjRef(), "Telekinetic Staff!", Ego::Math::Colour4f::white(), Ego::Math::Colour4f::purple(), 2, Ego::Graphics::Billboard::Flags::All);
             }
@@ -1219,7 +1219,7 @@ bool do_chr_prt_collision(const std::shared_ptr<Object> &object, const std::shar
             }
 
             //1% dodge chance per Agility
-            if(Random::getPercent() <= dodgeChance) 
+            if(Random::get(Random::Stream::Particles).getPercent() <= dodgeChance) 
             {
                 dodged = true;
             }
@@ -1350,7 +1350,7 @@ int spawn_bump_particles(ObjectRef character, const ParticleRef particle)
         //check if we resisted the attack, we could resist some of the particles or none
         for (int cnt = 0; cnt < amount; cnt++)
         {
-            if (Random::nextFloat() <= pchr->getDamageReduction(pprt->damagetype)) amount--;
+            if (Random::get(Random::Stream::Particles).nextFloat() <= pchr->getDamageReduction(pprt->damagetype)) amount--;
         }
 
         if (amount > 0 && !pchr->getProfile()->hasResistBumpSpawn() && !pchr->invictus)
@@ -36,6 +36,7 @@
 #include "game/Module/Passage.hpp"
 #include "game/Module/Module.hpp"
 #include "game/Physics/CollisionSystem.hpp"
+#include "game/Physics/TransformSystem.hpp"
 #include "game/physics.h"
 #include "game/Physics/PhysicalConstants.hpp"
 #include "game/Entities/_Include.hpp"
@@ -84,16 +85,18 @@ static void game_reset_players();
 //--------------------------------------------------------------------------------------------
 // Random Things
 //--------------------------------------------------------------------------------------------
-egolib_rv export_one_character( ObjectRef character, ObjectRef owner, int chr_obj_index, bool is_local )
+egolib_rv export_one_character( ObjectRef character, ObjectRef owner, int chr_obj_index, bool is_local, CharacterExport& characterExport )
 {
     /// @author ZZ
-    /// @details This function exports a character
+    /// @details This function stages the export of a character. The generated files are written
+    ///          into the staging directory, the profile files are added to the export and copied
+    ///          by the CharacterExporter.
     std::string fromdir;
     std::string todir;
     std::string fromfile;
     std::string tofile;
     std::string todirname;
-    std::string todirfullname;
+    std::string relativedir;
 
     const std::shared_ptr<Object> &object = _currentModule->getObjectHandler()[character];
     if(!object) {
@@ -108,39 +111,42 @@ egolib_rv export_one_character( ObjectRef character, ObjectRef owner, int chr_ob
     // TWINK_BO.OBJ
     todirname = str_encode_path(_currentModule->getObjectHandler()[owner]->getName());
 
+    // players/twink.obj.staging
+    std::string savedir = ( is_local ? "/players/" : "/remote/" ) + todirname;
+    std::string stagingdir = CharacterExporter::getStagingDirectory(savedir);
+
     // Is it a character or an item?
     if ( chr_obj_index < 0 )
     {
         // Character directory
-        todirfullname = todirname;
+        todir = stagingdir;
     }
     else
     {
         // Item is a subdirectory of the owner directory...
         std::stringstream stringStream;
-        stringStream << todirname << "/" << chr_obj_index << ".obj";
-        todirfullname = stringStream.str();
-    }
-
-    // players/twink.obj or players/twink.obj/0.obj
-    if ( is_local )
-    {
-        todir = "/players/" + todirfullname;
-    }
-    else
-    {
-        todir = "/remote/" + todirfullname;
+        stringStream << chr_obj_index << ".obj";
+        todir = stagingdir + "/" + stringStream.str();
+        relativedir = stringStream.str() + "/";
     }
 
-    // Remove all the original info
+    // Start with an empty staging directory
     if ( chr_obj_index < 0 )
     {
-        vfs_removeDirectoryAndContents( todir.c_str(), VFS_TRUE );
-        if ( !vfs_mkdir( todir ) )
+        auto resolved = vfs_resolveWriteFilename( savedir );
+        if ( !resolved.first )
         {
-			Log::get() << Log::Entry::create(Log::Level::Warning, __FILE__, __LINE__, "unable to create object directory ", "`", todir, "`", Log::EndOfEntry);
             return rv_error;
         }
+        CharacterExporter::recover( resolved.second );
+        vfs_removeDirectoryAndContents( stagingdir.c_str(), VFS_TRUE );
+        characterExport.name = todirname;
+        characterExport.directory = resolved.second;
+    }
+    if ( !vfs_mkdir( todir ) )
+    {
+        Log::get() << Log::Entry::create(Log::Level::Warning, __FILE__, __LINE__, "unable to create object directory ", "`", todir, "`", Log::EndOfEntry);
+        return rv_error;
     }
 
     // modules/advent.mod/objects/advent.obj
@@ -159,22 +165,34 @@ egolib_rv export_one_character( ObjectRef character, ObjectRef owner, int chr_ob
     // Build the QUEST.TXT file
     export_one_character_quest_vfs( todir.c_str(), character );
 
-    // copy every file that does not already exist in the todir
+    // the generated files are already staged
+    {
+        SearchContext ctxt(Ego::VfsPath(todir), VFS_SEARCH_FILE | VFS_SEARCH_BARE );
+        while (ctxt.hasData()) {
+            characterExport.generatedFiles.push_back(relativedir + ctxt.getData().string());
+            ctxt.nextData();
+        }
+    }
+
+    // copy every file that was not generated
     {
-        SearchContext *ctxt = new SearchContext(Ego::VfsPath(fromdir), VFS_SEARCH_FILE | VFS_SEARCH_BARE );
-        if (!ctxt) return rv_success;
-        while (ctxt->hasData()) {
-            auto searchResult = ctxt->getData();
+        SearchContext ctxt(Ego::VfsPath(fromdir), VFS_SEARCH_FILE | VFS_SEARCH_BARE );
+        while (ctxt.hasData()) {
+            auto searchResult = ctxt.getData();
             fromfile = fromdir + "/" + searchResult.string();
             tofile = todir + "/" + searchResult.string();
             if (!vfs_exists(tofile)) {
-                vfs_copyFile(fromfile, tofile);
+                auto resolved = vfs_resolveReadFilename(fromfile);
+                if (resolved.first) {
+                    characterExport.copiedFiles.emplace_back(resolved.second, relativedir + searchResult.string());
+                } else {
+                    // the file is not in the native file system: stage it right away
+                    vfs_copyFile(fromfile, tofile);
+                    characterExport.generatedFiles.push_back(relativedir + searchResult.string());
+                }
             }
-            ctxt->nextData();
+            ctxt.nextData();
         }
-
-        delete ctxt;
-        ctxt = nullptr;
     }
 
     return rv_success;
@@ -185,7 +203,8 @@ egolib_rv export_all_players( bool require_local )
 {
     /// @author ZZ
     /// @details This function saves all the local players in the
-    ///    PLAYERS directory
+    ///    PLAYERS directory. The exports are written by the CharacterExporter
+    ///    in the background, CharacterExporter::wait() waits for them.
 
     egolib_rv export_chr_rv;
     egolib_rv retval;
@@ -194,12 +213,16 @@ egolib_rv export_all_players( bool require_local )
     // Stop if export isnt valid
     if ( !_currentModule->isExportValid() ) return rv_fail;
 
+    // Previous exports must be completed before their staging directories are reused
+    CharacterExporter::get().wait();
+
     // assume the best
     retval = rv_success;
 
     // Check each player
     for(const std::shared_ptr<Ego::Player> &player : _currentModule->getPlayerList()) {
         ObjectRef item;
+        CharacterExport characterExport;
 
         // Is it alive?
         std::shared_ptr<Object> pchr = player->getObject();
@@ -211,20 +234,28 @@ egolib_rv export_all_players( bool require_local )
         if ( !pchr->isAlive() ) continue;
 
         // Export the character
-        export_chr_rv = export_one_character( character, character, -1, true );
-        if ( rv_error == export_chr_rv )
+        export_chr_rv = export_one_character( character, character, -1, true, characterExport );
+        if ( rv_success != export_chr_rv )
         {
-            retval = rv_error;
+            if ( rv_error == export_chr_rv )
+            {
+                // Discard what was staged
+                retval = rv_error;
+                characterExport.failed = true;
+                CharacterExporter::get().submit( characterExport );
+            }
+            continue;
         }
 
         // Export the left hand item
         item = pchr->holdingwhich[SLOT_LEFT];
         if ( _currentModule->getObjectHandler().exists( item ) )
         {
-            export_chr_rv = export_one_character( item, character, SLOT_LEFT, true );
+            export_chr_rv = export_one_character( item, character, SLOT_LEFT, true, characterExport );
             if ( rv_error == export_chr_rv )
             {
                 retval = rv_error;
+                characterExport.failed = true;
             }
         }
 
@@ -232,10 +263,11 @@ egolib_rv export_all_players( bool require_local )
         item = pchr->holdingwhich[SLOT_RIGHT];
         if ( _currentModule->getObjectHandler().exists( item ) )
         {
-            export_chr_rv = export_one_character( item, character, SLOT_RIGHT, true );
+            export_chr_rv = export_one_character( item, character, SLOT_RIGHT, true, characterExport );
             if ( rv_error == export_chr_rv )
             {
                 retval = rv_error;
+                characterExport.failed = true;
             }
         }
 
@@ -245,16 +277,21 @@ egolib_rv export_all_players( bool require_local )
         {
             if ( number >= pchr->getInventory().getMaxItems() ) break;
 
-            export_chr_rv = export_one_character( pitem->getObjRef(), character, number + SLOT_COUNT, true);
+            export_chr_rv = export_one_character( pitem->getObjRef(), character, number + SLOT_COUNT, true, characterExport );
             if ( rv_error == export_chr_rv )
             {
                 retval = rv_error;
+                characterExport.failed = true;
             }
             else if ( rv_success == export_chr_rv )
             {
                 number++;
             }
         }
+
+        // Write and commit the export in the background, a failed export is discarded
+        // rather than replacing the save with a character missing some of its items
+        CharacterExporter::get().submit( characterExport );
     }
 
     return retval;
@@ -410,6 +447,7 @@ int MainLoop::update_game()
     update_all_objects();
     move_all_objects();                            //movement
     Ego::Physics::CollisionSystem::get().update(); //collisions
+    Ego::Physics::TransformSystem::get().update(); //matrices, vertices and attached particles
     //---- end the code for updating in-game objects
 
     // put the camera movement inside here
@@ -693,7 +731,7 @@ void MainLoop::readPlayerInput()
             if (!pchr->isAlive() && 0 == local_stats.revivetimer)
             {
                 pchr->respawn();
-                _currentModule->getTeamList()[pchr->team].setLeader(pchr);
+                _currentModule->getTeamList()[pchr->getTeamRef()].setLeader(pchr);
                 SET_BIT(pchr->ai.alert, ALERTIF_CLEANEDUP);
 
                 // cost some experience for doing this...  never lose a level
@@ -1071,10 +1109,15 @@ bool game_finish_module()
 }
 
 //--------------------------------------------------------------------------------------------
+size_t MainLoop::scriptsExecuted = 0;
+size_t MainLoop::scriptsSkipped = 0;
+
 void MainLoop::let_all_characters_think()
 {
     /// @author ZZ
     /// @details This function funst the ai scripts for all eligible objects
+    scriptsExecuted = 0;
+    scriptsSkipped = 0;
     for(const std::shared_ptr<Object> &object : _currentModule->getObjectHandler().iterator())
     {
         if(object->isTerminated()) {
@@ -1108,7 +1151,11 @@ void MainLoop::let_all_characters_think()
                 object->ai.timer = update_wld + 1;  //Prevents IfTimeOut from triggering
             }
 
-            scr_run_chr_script(object.get());
+            if (scr_run_chr_script(object.get())) {
+                scriptsExecuted++;
+            } else {
+                scriptsSkipped++;
+            }
         }
     }
 }
@@ -1747,6 +1794,9 @@ egolib_rv game_copy_imports( import_list_t * imp_lst )
 
     if ( 0 == imp_lst->count ) return rv_success;
 
+    // the imports are copied from the players directory
+    CharacterExporter::get().wait();
+
     // assume the best
     retval = rv_success;
 
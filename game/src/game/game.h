@@ -35,6 +35,7 @@
 //--------------------------------------------------------------------------------------------
 
 struct prt_bundle_t;
+struct CharacterExport;
 
 
 //--------------------------------------------------------------------------------------------
@@ -95,8 +96,17 @@ private:
     static void let_all_characters_think();
     static void readPlayerInput();
     static void check_stats();
+
+    /// The numbers of A.I. scripts interpreted and skipped in the last update.
+    static size_t scriptsExecuted;
+    static size_t scriptsSkipped;
 public:
     static int update_game();
+
+    /// @brief Get the number of A.I. scripts interpreted in the last update.
+    static size_t getScriptsExecuted() { return scriptsExecuted; }
+    /// @brief Get the number of A.I. scripts skipped in the last update because they had nothing to react to.
+    static size_t getScriptsSkipped() { return scriptsSkipped; }
 };
 
 struct Upload
@@ -192,7 +202,7 @@ bool game_begin_module(const std::shared_ptr<ModuleProfile> &module);
 void game_load_module_profiles(const std::string& modname);
 
 /// Exporting stuff
-egolib_rv export_one_character( ObjectRef character, ObjectRef owner, int chr_obj_index, bool is_local );
+egolib_rv export_one_character( ObjectRef character, ObjectRef owner, int chr_obj_index, bool is_local, CharacterExport& characterExport );
 egolib_rv export_all_players( bool require_local );
 
 // save character functions
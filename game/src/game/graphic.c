@@ -53,6 +53,7 @@
 #include "game/Graphics/TextureAtlasManager.hpp"
 #include "game/Module/Passage.hpp"
 #include "game/GUI/Material.hpp"
+#include "egolib/Core/ThreadPool.hpp"
 
 //--------------------------------------------------------------------------------------------
 
@@ -73,8 +74,7 @@ Clock<ClockPolicy::NonRecursive> sortDoListReflected_timer("render.sortDoListRef
 Clock<ClockPolicy::NonRecursive>  render_scene_init_timer("render.scene.init", 512);
 Clock<ClockPolicy::NonRecursive>  render_scene_mesh_timer("render.scene.mesh", 512);
 
-Clock<ClockPolicy::NonRecursive>  gfx_make_tileList_timer("gfx.make.tileList", 512);
-Clock<ClockPolicy::NonRecursive>  gfx_make_entityList_timer("gfx.make.entityList", 512);
+Clock<ClockPolicy::NonRecursive>  render_scene_cull_timer("render.scene.cull", 512);
 Clock<ClockPolicy::NonRecursive>  do_grid_lighting_timer("do.grid.lighting", 512);
 Clock<ClockPolicy::NonRecursive>  light_fans_timer("light.fans", 512);
 
@@ -94,11 +94,11 @@ void reinitClocks() {
 	render_scene_init_timer.reinit();
 	render_scene_mesh_timer.reinit();
 
-	gfx_make_tileList_timer.reinit();
-	gfx_make_entityList_timer.reinit();
+	render_scene_cull_timer.reinit();
 	do_grid_lighting_timer.reinit();
 	light_fans_timer.reinit();
 	GFX::get().update_object_instances_timer.reinit();
+	GFX::get().update_object_lighting_timer.reinit();
 	GFX::get().update_particle_instances_timer.reinit();
 
 	GFX::get().getEntityReflections().clock.reinit();
@@ -113,7 +113,8 @@ void reinitClocks() {
     GFX::get().getBackground().clock.reinit();
 }
 
-static gfx_rv render_scene_init(Ego::Graphics::TileList& tl, Ego::Graphics::EntityList& el, dynalist_t& dyl, Camera& cam);
+static gfx_rv render_scene_cull(Ego::Graphics::TileList& tl, Ego::Graphics::EntityList& el, Camera& cam);
+static gfx_rv render_scene_init(const std::vector<std::shared_ptr<Camera>>& cameras, dynalist_t& dyl);
 static gfx_rv render_scene(Camera& cam, Ego::Graphics::TileList& tl, Ego::Graphics::EntityList& el);
 
 /**
@@ -129,13 +130,24 @@ static gfx_rv gfx_make_tileList(Ego::Graphics::TileList& tl, Camera& camera);
 static gfx_rv gfx_make_dynalist(dynalist_t& dyl, Camera& camera);
 
 static float draw_fps(float y);
+
+/// The number of texture binds in the last frame, in total and in the tile passes.
+static size_t lastFrameTextureBinds = 0;
+static size_t lastFrameTileTextureBinds = 0;
+static size_t lastFrameParticleDrawCalls = 0;
+static size_t lastFrameParticleQuads = 0;
+static size_t lastFrameParticleAllocations = 0;
+/// The number of cameras and tiles lit in the last frame and the number of tiles which would have been lit per camera.
+static size_t lastFrameCameras = 0;
+static size_t lastFrameLitTiles = 0;
+static size_t lastFrameCameraTiles = 0;
 static float draw_help(float y);
 static float draw_debug(float y);
 static float draw_timer(float y);
 static float draw_game_status(float y);
 
 
-static gfx_rv gfx_update_flashing(Ego::Graphics::EntityList& el);
+static gfx_rv gfx_update_flashing(const std::vector<ObjectRef>& objects);
 
 static bool sum_global_lighting(std::array<float, LIGHTING_VEC_SIZE> &lighting);
 
@@ -146,6 +158,7 @@ static bool sum_global_lighting(std::array<float, LIGHTING_VEC_SIZE> &lighting);
 GFX::GFX() :
     GameApp<GFX>("Egoboo", GameEngine::GAME_VERSION),
     update_object_instances_timer("update.object.instances", 512),
+    update_object_lighting_timer("update.object.lighting", 512),
     update_particle_instances_timer("update.particle.instances", 512),
     nonOpaqueEntities(std::make_unique<Ego::Graphics::NonOpaqueEntitiesRenderPass>()),
     opaqueEntities(std::make_unique<Ego::Graphics::OpaqueEntitiesRenderPass>()),
@@ -163,6 +176,66 @@ GFX::GFX() :
 GFX::~GFX()
 {}
 
+//--------------------------------------------------------------------------------------------
+namespace {
+
+/// The threads building the tile and entity lists of all but one camera.
+ThreadPool& getCullingPool()
+{
+    static ThreadPool pool(std::max<size_t>(1, MAX_CAMERAS - 1));
+    return pool;
+}
+
+} // namespace
+
+void gfx_system_prepare_world(const std::vector<std::shared_ptr<Camera>>& cameras)
+{
+    if (cameras.empty())
+    {
+        return;
+    }
+
+    ClockScope<ClockPolicy::NonRecursive> clockScope(render_scene_init_timer);
+    {
+        ClockScope<ClockPolicy::NonRecursive> scope(render_scene_cull_timer);
+        // Keep the particle list locked while the cameras are culled
+        // such that the concurrent iterations do not compact it when they release it.
+        auto particles = ParticleHandler::get().iterator();
+        // The cameras only write to their own tile and entity lists.
+        std::vector<std::future<gfx_rv>> futures;
+        for (size_t i = 1; i < cameras.size(); ++i)
+        {
+            std::shared_ptr<Camera> camera = cameras[i];
+            futures.push_back(getCullingPool().submit([camera]()
+            {
+                return render_scene_cull(*camera->getTileList(), *camera->getEntityList(), *camera);
+            }));
+        }
+        std::exception_ptr exception;
+        try
+        {
+            render_scene_cull(*cameras.front()->getTileList(), *cameras.front()->getEntityList(), *cameras.front());
+        }
+        catch (...)
+        {
+            exception = std::current_exception();
+        }
+        for (auto& future : futures)
+        {
+            future.wait();
+        }
+        if (exception)
+        {
+            std::rethrow_exception(exception);
+        }
+        for (auto& future : futures)
+        {
+            future.get();
+        }
+    }
+    render_scene_init(cameras, GFX::get().getDynalist());
+}
+
 //--------------------------------------------------------------------------------------------
 void gfx_system_render_world(std::shared_ptr<Camera> camera, std::shared_ptr<Ego::Graphics::TileList> tileList, std::shared_ptr<Ego::Graphics::EntityList> entityList)
 {
@@ -403,6 +476,23 @@ float draw_fps(float y)
         if (egoboo_config_t::get().debug_developerMode_enable.getValue())
         {
 			/** @todo This should be made available through the GUI. Too much information just to print out things on screen. */
+            std::ostringstream os;
+            os << lastFrameTextureBinds << " texture binds, " << lastFrameTileTextureBinds << " in tile passes";
+            y = _gameEngine->getUIManager()->drawBitmapFontString(Vector2f(0, y), os.str(), 0.0f, 1.0f);
+
+            std::ostringstream os2;
+            os2 << MainLoop::getScriptsExecuted() << " scripts run, " << MainLoop::getScriptsSkipped() << " skipped";
+            y = _gameEngine->getUIManager()->drawBitmapFontString(Vector2f(0, y), os2.str(), 0.0f, 1.0f);
+
+            std::ostringstream particleStats;
+            particleStats << lastFrameParticleQuads << " particle sprites in " << lastFrameParticleDrawCalls << " draws, "
+                << lastFrameParticleAllocations << " allocations";
+            y = _gameEngine->getUIManager()->drawBitmapFontString(Vector2f(0, y), particleStats.str(), 0.0f, 1.0f);
+
+            std::ostringstream lightingStats;
+            lightingStats << lastFrameLitTiles << " tiles lit for " << lastFrameCameras << " cameras, "
+                << lastFrameCameraTiles << " without sharing";
+            y = _gameEngine->getUIManager()->drawBitmapFontString(Vector2f(0, y), lightingStats.str(), 0.0f, 1.0f);
         }
     }
 
@@ -671,42 +761,98 @@ void draw_mouse_cursor()
 //--------------------------------------------------------------------------------------------
 // render_scene FUNCTIONS
 //--------------------------------------------------------------------------------------------
-gfx_rv render_scene_init(Ego::Graphics::TileList& tl, Ego::Graphics::EntityList& el, dynalist_t& dyl, Camera& cam)
+gfx_rv render_scene_cull(Ego::Graphics::TileList& tl, Ego::Graphics::EntityList& el, Camera& cam)
 {
     // assume the best;
     gfx_rv retval = gfx_success;
 
+    // Which tiles can be displayed
+    if (gfx_error == gfx_make_tileList(tl, cam))
     {
-		ClockScope<ClockPolicy::NonRecursive> scope(gfx_make_tileList_timer);
-        // Which tiles can be displayed
-        if (gfx_error == gfx_make_tileList(tl, cam))
-        {
-            retval = gfx_error;
-        }
+        retval = gfx_error;
     }
 
-    auto mesh = tl.getMesh();
+    // determine which objects are visible
+    if (gfx_error == gfx_make_entityList(el, cam))
+    {
+        retval = gfx_error;
+    }
+
+    // put off sorting the entity list until later
+    // because it has to be sorted differently for reflected and non-reflected objects
+
+    return retval;
+}
+
+gfx_rv render_scene_init(const std::vector<std::shared_ptr<Camera>>& cameras, dynalist_t& dyl)
+{
+    // assume the best;
+    gfx_rv retval = gfx_success;
+
+    auto mesh = _currentModule->getMeshPointer();
     if (!mesh)
     {
 		throw id::runtime_error(__FILE__, __LINE__, "tile list is not attached to a mesh");
     }
 
+    // The first camera is used where a single view is required.
+    Camera& cam = *cameras.front();
+
+    // Collect the union of the tiles and the objects visible to any camera.
+    static std::bitset<MAP_TILE_MAX> visibleTiles;
+    std::vector<Index1D> tiles;
+    std::unordered_set<ObjectRef> visibleObjects;
+    std::vector<ObjectRef> objects;
+    size_t cameraTiles = 0;
+    visibleTiles.reset();
+    for (const auto& camera : cameras)
     {
-		ClockScope<ClockPolicy::NonRecursive> scope(gfx_make_entityList_timer);
-        // determine which objects are visible
-        if (gfx_error == gfx_make_entityList(el, cam))
+        auto& tl = *camera->getTileList();
+        tl.invalidateEnteredTiles();
+        cameraTiles += tl._all.size();
+        for (const auto& entry : tl._all)
         {
-            retval = gfx_error;
+            if (!visibleTiles[entry.getIndex().i()])
+            {
+                visibleTiles[entry.getIndex().i()] = true;
+                tiles.push_back(entry.getIndex());
+            }
+        }
+        auto& el = *camera->getEntityList();
+        for (size_t i = 0, n = el.getSize(); i < n; ++i)
+        {
+            ObjectRef iobj = el.get(i).iobj;
+            if (ObjectRef::Invalid != iobj && visibleObjects.insert(iobj).second)
+            {
+                objects.push_back(iobj);
+            }
         }
     }
+    lastFrameCameras = cameras.size();
+    lastFrameLitTiles = tiles.size();
+    lastFrameCameraTiles = cameraTiles;
 
-    // put off sorting the entity list until later
-    // because it has to be sorted differently for reflected and non-reflected objects
+    // A particle is in the entity list if it is in the entity list of any camera.
+    for (const std::shared_ptr<Ego::Particle> &particle : ParticleHandler::get().iterator())
+    {
+        particle->inst.indolist = false;
+    }
+    for (const auto& camera : cameras)
+    {
+        auto& el = *camera->getEntityList();
+        for (size_t i = 0, n = el.getSize(); i < n; ++i)
+        {
+            ParticleRef iprt = el.get(i).iprt;
+            if (ParticleRef::Invalid == iprt) continue;
+            const std::shared_ptr<Ego::Particle>& particle = ParticleHandler::get()[iprt];
+            if (particle) particle->inst.indolist = true;
+        }
+    }
 
     {
 		ClockScope<ClockPolicy::NonRecursive> scope(do_grid_lighting_timer);
         // figure out the terrain lighting
-		if (gfx_error == GridIllumination::do_grid_lighting(tl, dyl, cam))
+		if (gfx_error == GridIllumination::do_grid_lighting(mesh, tiles, dyl, cam))
         {
             retval = gfx_error;
         }
@@ -715,7 +861,7 @@ gfx_rv render_scene_init(Ego::Graphics::TileList& tl, Ego::Graphics::EntityList&
     {
 		ClockScope<ClockPolicy::NonRecursive> scope(light_fans_timer);
         // apply the lighting to the characters and particles
-		GridIllumination::light_fans(tl);
+		GridIllumination::light_fans(mesh, tiles);
     }
 
     {
@@ -737,11 +883,14 @@ gfx_rv render_scene_init(Ego::Graphics::TileList& tl, Ego::Graphics::EntityList&
     }
 
     // do the flashing for kursed objects
-    if (gfx_error == gfx_update_flashing(el))
+    if (gfx_error == gfx_update_flashing(objects))
     {
         retval = gfx_error;
     }
 
+    // Advance the animation of animated tiles.
+    animate_all_tiles(*mesh);
+
     return retval;
 }
 
@@ -751,13 +900,6 @@ gfx_rv render_scene(Camera& cam, Ego::Graphics::TileList& tl, Ego::Graphics::Ent
 {
     // assume the best
     gfx_rv retval = gfx_success;
-    {
-		ClockScope<ClockPolicy::NonRecursive> clockScope(render_scene_init_timer);
-        if (gfx_error == render_scene_init(tl, el, GFX::get().getDynalist(), cam))
-        {
-            retval = gfx_error;
-        }
-    }
     {
 		ClockScope<ClockPolicy::NonRecursive> clockScope(render_scene_mesh_timer);
         {
@@ -765,8 +907,6 @@ gfx_rv render_scene(Camera& cam, Ego::Graphics::TileList& tl, Ego::Graphics::Ent
 			ClockScope<ClockPolicy::NonRecursive> clockScope2(sortDoListReflected_timer);
 			el.sort(cam, true);
         }
-        // Advance the animation of animated tiles.
-        animate_all_tiles(*tl.getMesh());
         // Render non-reflective tiles.
         GFX::get().getNonReflective().run(cam, tl, el);
         // Reflective tiles first pass.
@@ -1153,6 +1293,19 @@ void gfx_do_flip_pages()
 {
     Ego::Core::ConsoleHandler::get().draw_all();
     SDL_GL_SwapWindow(Ego::GraphicsSystem::get().window->get());
+
+    // Record the texture binds of the completed frame.
+    auto& textureUnit = Ego::Renderer::get().getTextureUnit();
+    lastFrameTextureBinds = textureUnit.getBindCount();
+    lastFrameTileTextureBinds = Ego::Graphics::Internal::TileListV2::getBindCount();
+    textureUnit.resetBindCount();
+    Ego::Graphics::Internal::TileListV2::resetBindCount();
+
+    // Record the particle draws of the completed frame.
+    lastFrameParticleDrawCalls = Ego::Graphics::ParticleBatch::getDrawCallCount();
+    lastFrameParticleQuads = Ego::Graphics::ParticleBatch::getQuadCount();
+    lastFrameParticleAllocations = Ego::Graphics::ParticleBatch::getAllocationCount();
+    Ego::Graphics::ParticleBatch::resetCounts();
 }
 
 //--------------------------------------------------------------------------------------------
@@ -1192,7 +1345,7 @@ gfx_rv GridIllumination::light_fans_throttle_update(ego_mesh_t * mesh, ego_tile_
 }
 
 //--------------------------------------------------------------------------------------------
-void GridIllumination::light_fans_update_lcache(Ego::Graphics::TileList& tl)
+void GridIllumination::light_fans_update_lcache(const std::shared_ptr<ego_mesh_t>& mesh, const std::vector<Index1D>& tiles)
 {
 	const int frame_skip = 1 << 2; // 1 << 2 ~ 2^2 ~ 4. 
 #if defined(CLIP_ALL_LIGHT_FANS)
@@ -1209,7 +1362,6 @@ void GridIllumination::light_fans_update_lcache(Ego::Graphics::TileList& tl)
 	
 	bool is_valid;
 
-	auto mesh = tl.getMesh();
 	if (!mesh)
 	{
 		throw id::runtime_error(__FILE__, __LINE__, "tile list not attached to a mesh");
@@ -1231,10 +1383,10 @@ void GridIllumination::light_fans_update_lcache(Ego::Graphics::TileList& tl)
 #endif
 
     // cache the grid lighting
-    for (size_t entry = 0; entry < tl._all.size(); entry++)
+    for (size_t entry = 0; entry < tiles.size(); entry++)
     {
         // which tile?
-        Index1D fan = tl._all[entry].getIndex();
+        Index1D fan = tiles[entry];
 
         // grab a pointer to the tile
 		ego_tile_info_t& ptile = mesh->getTileInfo(fan);
@@ -1353,11 +1505,10 @@ float GridIllumination::ego_mesh_interpolate_vertex(const ego_tile_info_t& info,
     return light;
 }
 
-void GridIllumination::light_fans_update_clst(Ego::Graphics::TileList& tl)
+void GridIllumination::light_fans_update_clst(const std::shared_ptr<ego_mesh_t>& mesh, const std::vector<Index1D>& tiles)
 {
     /// @author BB
     /// @details update the tile's color list, if needed
-    auto mesh = tl.getMesh();
     if (!mesh)
     {
 		throw id::runtime_error(__FILE__, __LINE__, "tile list is not attached to a mesh");
@@ -1367,9 +1518,9 @@ void GridIllumination::light_fans_update_clst(Ego::Graphics::TileList& tl)
 	tile_mem_t& ptmem = mesh->_tmem;
 
     // use the grid to light the tiles
-    for (size_t entry = 0; entry < tl._all.size(); entry++)
+    for (size_t entry = 0; entry < tiles.size(); entry++)
     {
-        Index1D fan = tl._all[entry].getIndex();
+        Index1D fan = tiles[entry];
         if (Index1D::Invalid == fan) continue;
 
         // valid tile?
@@ -1423,10 +1574,10 @@ void GridIllumination::light_fans_update_clst(Ego::Graphics::TileList& tl)
 }
 
 //--------------------------------------------------------------------------------------------
-void GridIllumination::light_fans(Ego::Graphics::TileList& tl)
+void GridIllumination::light_fans(const std::shared_ptr<ego_mesh_t>& mesh, const std::vector<Index1D>& tiles)
 {
-	light_fans_update_lcache(tl);
-	light_fans_update_clst(tl);
+	light_fans_update_lcache(mesh, tiles);
+	light_fans_update_clst(mesh, tiles);
 }
 
 //--------------------------------------------------------------------------------------------
@@ -1602,7 +1753,7 @@ gfx_rv gfx_make_dynalist(dynalist_t& dyl, Camera& cam)
 }
 
 //--------------------------------------------------------------------------------------------
-gfx_rv GridIllumination::do_grid_lighting(Ego::Graphics::TileList& tl, dynalist_t& dyl, Camera& cam)
+gfx_rv GridIllumination::do_grid_lighting(const std::shared_ptr<ego_mesh_t>& mesh, const std::vector<Index1D>& tiles, dynalist_t& dyl, Camera& cam)
 {
     /// @author ZZ
     /// @details Do all tile lighting, dynamic and global
@@ -1622,7 +1773,6 @@ gfx_rv GridIllumination::do_grid_lighting(Ego::Graphics::TileList& tl, dynalist_
     ego_frect_t mesh_bound, light_bound;
     dynalight_data_t fake_dynalight;
 
-	auto mesh = tl.getMesh();
     if (!mesh)
     {
 		throw id::runtime_error(__FILE__, __LINE__, "tile list not attached to a mesh");
@@ -1636,9 +1786,9 @@ gfx_rv GridIllumination::do_grid_lighting(Ego::Graphics::TileList& tl, dynalist_
     mesh_bound.xmax = 0;
     mesh_bound.ymin = tmem._edge_y;
     mesh_bound.ymax = 0;
-    for (size_t entry = 0; entry < tl._all.size(); entry++)
+    for (size_t entry = 0; entry < tiles.size(); entry++)
     {
-        Index1D fan = tl._all[entry].getIndex();
+        Index1D fan = tiles[entry];
         if (fan.i() >= pinfo.getTileCount()) continue;
 
 		const oct_bb_t& poct = tmem.get(fan)._oct;
@@ -1773,12 +1923,12 @@ gfx_rv GridIllumination::do_grid_lighting(Ego::Graphics::TileList& tl, dynalist_
     local_keep = 0.0f; //std::pow(DYNALIGHT_KEEP, 4); //const static float DYNALIGHT_KEEP = 0.9f;
 
     // Add to base light level in normal mode
-    for (size_t entry = 0; entry < tl._all.size(); entry++)
+    for (size_t entry = 0; entry < tiles.size(); entry++)
     {
         bool resist_lighting_calculation = true;
 
         // grab each grid box in the "frustum"
-        Index1D fan = tl._all[entry].getIndex();
+        Index1D fan = tiles[entry];
 
         // a valid tile?
         ego_tile_info_t& ptile = mesh->getTileInfo(fan);
@@ -2003,25 +2153,15 @@ float calc_light_global(int rotation, int normal, float lx, float ly, float lz)
 #endif
 
 //--------------------------------------------------------------------------------------------
-gfx_rv gfx_update_flashing(Ego::Graphics::EntityList& el)
+gfx_rv gfx_update_flashing(const std::vector<ObjectRef>& objects)
 {
     gfx_rv retval;
 
-    if (el.getSize() >= Ego::Graphics::EntityList::CAPACITY)
-    {
-        Log::Entry e(Log::Level::Error, __FILE__, __LINE__);
-        e << "invalid entity list size" << Log::EndOfEntry;
-        Log::get() << e;
-        return gfx_error;
-    }
-
     retval = gfx_success;
-    for (size_t i = 0, n = el.getSize(); i < n; ++i)
+    for (ObjectRef iobj : objects)
     {
         float tmp_seekurse_level;
 
-        ObjectRef iobj = el.get(i).iobj;
-
         const std::shared_ptr<Object> &object = _currentModule->getObjectHandler()[iobj];
         if (!object) continue;
 
@@ -2053,11 +2193,6 @@ gfx_rv gfx_update_flashing(Ego::Graphics::EntityList& el)
 //--------------------------------------------------------------------------------------------
 gfx_rv GFX::update_object_instances(Camera& cam)
 {
-    gfx_rv retval;
-
-    // assume the best
-    retval = gfx_success;
-
     for (const std::shared_ptr<Object> &pchr : _currentModule->getObjectHandler().iterator())
     {
         //Dont do terminated characters
@@ -2069,21 +2204,16 @@ gfx_rv GFX::update_object_instances(Camera& cam)
 		auto mesh = _currentModule->getMeshPointer();
         if (!mesh->grid_is_valid(pchr->getTile())) continue;
 
-        // make sure that the vertices are interpolated
-        if(pchr->inst.updateVertices(-1, -1, true) == gfx_error) {
-            retval = gfx_error;
-        }
-
-        // the instance has changed, refresh the collision bound
-        else {
-            pchr->getObjectPhysics().updateCollisionSize(true);            
-        }
+        // the vertices, matrices and collision bounds are refreshed by the Ego::Physics::TransformSystem each update
 
         // do the basic lighting
-        pchr->inst.updateLighting();
+        {
+            ClockScope<ClockPolicy::NonRecursive> scope(update_object_lighting_timer);
+            pchr->inst.updateLighting();
+        }
     }
 
-    return retval;
+    return gfx_success;
 }
 
 // variables to optimize calls to bind the textures
@@ -2093,6 +2223,10 @@ uint8_t TileRenderer::size = 0xFF;
 
 std::shared_ptr<Ego::Texture> TileRenderer::get_texture(uint8_t image, uint8_t size)
 {
+    auto atlas = Ego::Graphics::TextureAtlasManager::get().getAtlas();
+    if (atlas) {
+        return atlas;
+    }
 	if (0 == size) {
 		return Ego::Graphics::TextureAtlasManager::get().getSmall(image);
 	} else if (1 == size) {
@@ -2122,8 +2256,17 @@ void TileRenderer::bind(const ego_tile_info_t& tile)
 	}
 	else
 	{
-		newImage = TILE_GET_LOWER_BITS(tile._img);
-		newSize = (tile._type < tile_dict.offset) ? 0 : 1;
+		if (Ego::Graphics::TextureAtlasManager::get().getAtlas())
+		{
+			// All tiles share the texture atlas.
+			newImage = 0;
+			newSize = 0;
+		}
+		else
+		{
+			newImage = TILE_GET_LOWER_BITS(tile._img);
+			newSize = (tile._type < tile_dict.offset) ? 0 : 1;
+		}
 
 		if ((image != newImage) || (size != newSize))
 		{
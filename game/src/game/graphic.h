@@ -201,6 +201,7 @@ private:
 public:
     Ego::Time::Clock<Ego::Time::ClockPolicy::NonRecursive> update_object_instances_timer;
     gfx_rv update_object_instances(Camera& cam);
+    Ego::Time::Clock<Ego::Time::ClockPolicy::NonRecursive> update_object_lighting_timer;
     Ego::Time::Clock<Ego::Time::ClockPolicy::NonRecursive> update_particle_instances_timer;
     gfx_rv update_particle_instances(Camera& cam);
 
@@ -277,7 +278,10 @@ void gfx_system_init_all_graphics();
 void gfx_system_release_all_graphics();
 void gfx_system_load_assets();
 
-// the render engine callback
+// the render engine callbacks
+/// @brief Build the tile and entity lists of the cameras and do the lighting and instance updates
+///        for the union of their views once per frame.
+void gfx_system_prepare_world(const std::vector<std::shared_ptr<Camera>>& cameras);
 void gfx_system_render_world(const std::shared_ptr<Camera> camera, std::shared_ptr<Ego::Graphics::TileList> tl, std::shared_ptr<Ego::Graphics::EntityList> el);
 
 void gfx_do_clear_screen();
@@ -305,12 +309,12 @@ private:
 	static bool test_corners(const ego_mesh_t& mesh, ego_tile_info_t& tile, float threshold);
 	static void light_one_corner(ego_mesh_t& mesh, ego_tile_info_t& tile, const bool reflective, const Vector3f& pos, const Vector3f& nrm, float& plight);
 	static float grid_lighting_test(const ego_mesh_t& mesh, GLXvector3f pos, float& low_diff, float& hgh_diff);
-	static void light_fans_update_clst(Ego::Graphics::TileList& tl);
+	static void light_fans_update_clst(const std::shared_ptr<ego_mesh_t>& mesh, const std::vector<Index1D>& tiles);
 	static gfx_rv light_fans_throttle_update(ego_mesh_t * mesh, ego_tile_info_t& tile, const Index1D& tileIndex, float threshold);
-	static void light_fans_update_lcache(Ego::Graphics::TileList& tl);
+	static void light_fans_update_lcache(const std::shared_ptr<ego_mesh_t>& mesh, const std::vector<Index1D>& tiles);
 public:
-	static gfx_rv do_grid_lighting(Ego::Graphics::TileList& tl, dynalist_t& dyl, Camera& cam);
-	static void light_fans(Ego::Graphics::TileList& tl);
+	static gfx_rv do_grid_lighting(const std::shared_ptr<ego_mesh_t>& mesh, const std::vector<Index1D>& tiles, dynalist_t& dyl, Camera& cam);
+	static void light_fans(const std::shared_ptr<ego_mesh_t>& mesh, const std::vector<Index1D>& tiles);
 	static float light_corners(ego_mesh_t& mesh, ego_tile_info_t& tile, bool reflective, float mesh_lighting_keep);
 	static bool grid_lighting_interpolate(const ego_mesh_t& mesh, lighting_cache_t& dst, const Vector2f& pos);
 	static bool light_corner(ego_mesh_t& mesh, const Index1D& fan, float height, float nrm[], float& plight);
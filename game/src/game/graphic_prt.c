@@ -29,6 +29,7 @@
 #include "game/Graphics/CameraSystem.hpp"
 #include "game/Entities/_Include.hpp"
 #include "game/CharacterMatrix.h"
+#include "egolib/Graphics/ParticleBatch.hpp"
 
 float ParticleGraphicsRenderer::CALCULATE_PRT_U0(const Ego::Texture& texture, int CNT) {
     float w = texture.getSourceWidth();
@@ -56,7 +57,7 @@ float ParticleGraphicsRenderer::CALCULATE_PRT_V1(const Ego::Texture& texture, in
     return (((.95f + ((CNT) >> 4)) / 16.0f) * (w / h)*hscale);
 }
 
-gfx_rv ParticleGraphicsRenderer::render_one_prt_solid(const ParticleRef iprt)
+gfx_rv ParticleGraphicsRenderer::render_one_prt_solid(Ego::Graphics::ParticleBatch& batch, const ParticleRef iprt)
 {
     /// @author BB
     /// @details Render the solid version of the particle
@@ -80,49 +81,16 @@ gfx_rv ParticleGraphicsRenderer::render_one_prt_solid(const ParticleRef iprt)
     // only render solid sprites
     if (SPRITE_SOLID != pprt->type) return gfx_fail;
 
-    auto& renderer = Ego::Renderer::get();
-    renderer.setWorldMatrix(Matrix4f4f::identity());
-    {
-        Ego::OpenGL::PushAttrib pa(GL_ENABLE_BIT | GL_DEPTH_BUFFER_BIT | GL_COLOR_BUFFER_BIT | GL_CURRENT_BIT);
-        {
-            std::shared_ptr<const Ego::Texture> texture = nullptr;
-            // Use the depth test to eliminate hidden portions of the particle
-            renderer.setDepthTestEnabled(true);
-            renderer.setDepthFunction(Ego::CompareFunction::Less);                                   // GL_DEPTH_BUFFER_BIT
-
-            // enable the depth mask for the solid portion of the particles
-            renderer.setDepthWriteEnabled(true);
-
-            // draw draw front and back faces of polygons
-            renderer.setCullingMode(Ego::CullingMode::None);
-
-            // Since the textures are probably mipmapped or minified with some kind of
-            // interpolation, we can never really turn blending off.
-            renderer.setBlendingEnabled(true);
-            renderer.setBlendFunction(Ego::BlendFunction::SourceAlpha, Ego::BlendFunction::OneMinusSourceAlpha);
-
-            // only display the portion of the particle that is 100% solid
-            renderer.setAlphaTestEnabled(true);
-            renderer.setAlphaFunction(Ego::CompareFunction::Equal, 1.0f);
-
-            texture = ParticleHandler::get().getTransparentParticleTexture();
-            renderer.getTextureUnit().setActivated(texture.get());
-
-            renderer.setColour(Ego::Math::Colour4f(pinst.fintens, pinst.fintens, pinst.fintens, 1.0f));
-
-            // billboard for the particle
-            auto vd = Ego::VertexFormatFactory::get<Ego::VertexFormat::P3FT2F>();
-            auto vb = std::make_shared<Ego::VertexBuffer>(4, vd.getVertexSize());
-            calc_billboard_verts(*texture, *vb, pinst, pinst.size, false);
-
-            renderer.render(*vb, vd, Ego::PrimitiveType::TriangleFan, 0, 4);
-        }
-    }
+    // Since the textures are probably mipmapped or minified with some kind of
+    // interpolation, we can never really turn blending off.
+    const auto& texture = ParticleHandler::get().getTransparentParticleTexture();
+    add_billboard(batch, Ego::Graphics::ParticleBlendMode::Solid, *texture, pinst,
+                  Ego::Math::Colour4f(pinst.fintens, pinst.fintens, pinst.fintens, 1.0f), false);
 
     return gfx_success;
 }
 
-gfx_rv ParticleGraphicsRenderer::render_one_prt_trans(const ParticleRef iprt)
+gfx_rv ParticleGraphicsRenderer::render_one_prt_trans(Ego::Graphics::ParticleBatch& batch, const ParticleRef iprt)
 {
     /// @author BB
     /// @details do all kinds of transparent sprites next
@@ -142,108 +110,58 @@ gfx_rv ParticleGraphicsRenderer::render_one_prt_trans(const ParticleRef iprt)
 
     // if the particle instance data is not valid, do not continue
     if (!pprt->inst.valid) return gfx_fail;
-    auto& renderer = Ego::Renderer::get();
     auto& inst = pprt->inst;
 
+    switch(pprt->type)
     {
-        renderer.setWorldMatrix(Matrix4f4f::identity());
-        Ego::OpenGL::PushAttrib pa(GL_ENABLE_BIT | GL_DEPTH_BUFFER_BIT | GL_COLOR_BUFFER_BIT | GL_CURRENT_BIT);
+        // Solid sprites.
+        case SPRITE_SOLID:
         {
-            // Do not write into the depth buffer.
-            renderer.setDepthWriteEnabled(false);
-
-            // Enable depth test: Incoming fragment's depth value must be less or equal.
-            renderer.setDepthTestEnabled(true);
-            renderer.setDepthFunction(Ego::CompareFunction::LessOrEqual);
-
-            // Draw front-facing and back-facing polygons.
-            renderer.setCullingMode(Ego::CullingMode::None);
-
-            Ego::Math::Colour4f particleColour;
-            std::shared_ptr<const Ego::Texture> texture = nullptr;
-
-            switch(pprt->type)
-            {
-                // Solid sprites.
-                case SPRITE_SOLID:
-                {
-                    // Do the alpha blended edge ("anti-aliasing") of the solid particle.
-                    // Only display the alpha-edge of the particle.
-                    renderer.setAlphaTestEnabled(true);
-                    renderer.setAlphaFunction(Ego::CompareFunction::Less, 1.0f);
-
-                    renderer.setBlendingEnabled(true);
-                    renderer.setBlendFunction(Ego::BlendFunction::SourceAlpha, Ego::BlendFunction::OneMinusSourceAlpha);
-
-                    particleColour = Ego::Math::Colour4f(inst.fintens, inst.fintens, inst.fintens, 1.0f);
-
-                    texture = ParticleHandler::get().getTransparentParticleTexture();
-                    renderer.getTextureUnit().setActivated(texture.get());
-                }
-                break;
-
-                // Light sprites.
-                case SPRITE_LIGHT:
-                {
-                    //Is particle invisible?
-                    if(inst.fintens * inst.falpha <= 0.0f) {
-                        return gfx_success;
-                    }
-
-                    renderer.setAlphaTestEnabled(false);
-                    renderer.setBlendingEnabled(true);
-                    renderer.setBlendFunction(Ego::BlendFunction::One, Ego::BlendFunction::One);
-
-                    particleColour = Ego::Math::Colour4f(1.0f, 1.0f, 1.0f, inst.fintens * inst.falpha);
-
-                    texture = ParticleHandler::get().getLightParticleTexture();
-                    renderer.getTextureUnit().setActivated(texture.get());
-                }
-                break;
-
-                // Transparent sprites.
-                case SPRITE_ALPHA:
-                {
-                    //Is particle invisible?
-                    if(inst.falpha <= 0.0f) {
-                        return gfx_success;
-                    }
-
-                    // do not display the completely transparent portion
-                    renderer.setAlphaTestEnabled(true);
-                    renderer.setAlphaFunction(Ego::CompareFunction::Greater, 0.0f);
-
-                    renderer.setBlendingEnabled(true);
-                    renderer.setBlendFunction(Ego::BlendFunction::SourceAlpha, Ego::BlendFunction::OneMinusSourceAlpha);
-
-                    particleColour = Ego::Math::Colour4f(inst.fintens, inst.fintens, inst.fintens, inst.falpha);
-
-                    texture = ParticleHandler::get().getTransparentParticleTexture();
-                    renderer.getTextureUnit().setActivated(texture.get());
-                }
-                break;
+            // Do the alpha blended edge ("anti-aliasing") of the solid particle.
+            const auto& texture = ParticleHandler::get().getTransparentParticleTexture();
+            add_billboard(batch, Ego::Graphics::ParticleBlendMode::SolidEdge, *texture, inst,
+                          Ego::Math::Colour4f(inst.fintens, inst.fintens, inst.fintens, 1.0f), false);
+        }
+        break;
 
-                // unknown type
-                default:
-                    return gfx_error;
-                break;
+        // Light sprites.
+        case SPRITE_LIGHT:
+        {
+            //Is particle invisible?
+            if(inst.fintens * inst.falpha <= 0.0f) {
+                return gfx_success;
             }
 
-            auto vd = Ego::VertexFormatFactory::get<Ego::VertexFormat::P3FT2F>();
-            auto vb = std::make_shared<Ego::VertexBuffer>(4, vd.getVertexSize());
-            calc_billboard_verts(*texture, *vb, inst, inst.size, false);
+            const auto& texture = ParticleHandler::get().getLightParticleTexture();
+            add_billboard(batch, Ego::Graphics::ParticleBlendMode::Light, *texture, inst,
+                          Ego::Math::Colour4f(1.0f, 1.0f, 1.0f, inst.fintens * inst.falpha), false);
+        }
+        break;
 
-            renderer.setColour(particleColour);
+        // Transparent sprites.
+        case SPRITE_ALPHA:
+        {
+            //Is particle invisible?
+            if(inst.falpha <= 0.0f) {
+                return gfx_success;
+            }
 
-            // Go on and draw it
-            renderer.render(*vb, vd, Ego::PrimitiveType::TriangleFan, 0, 4);
+            const auto& texture = ParticleHandler::get().getTransparentParticleTexture();
+            add_billboard(batch, Ego::Graphics::ParticleBlendMode::Alpha, *texture, inst,
+                          Ego::Math::Colour4f(inst.fintens, inst.fintens, inst.fintens, inst.falpha), false);
         }
+        break;
+
+        // unknown type
+        default:
+            return gfx_error;
+        break;
     }
 
     return gfx_success;
 }
 
-gfx_rv ParticleGraphicsRenderer::render_one_prt_ref(const ParticleRef iprt)
+gfx_rv ParticleGraphicsRenderer::render_one_prt_ref(Ego::Graphics::ParticleBatch& batch, const ParticleRef iprt)
 {
     /// @author BB
     /// @details render one particle
@@ -266,172 +184,69 @@ gfx_rv ParticleGraphicsRenderer::render_one_prt_ref(const ParticleRef iprt)
     fadeoff *= 0.5f;
     fadeoff = Ego::Math::constrain(fadeoff*INV_FF<float>(), 0.0f, 1.0f);
 
-    auto& renderer = Ego::Renderer::get();
     if (fadeoff > 0.0f)
     {
-        renderer.setWorldMatrix(Matrix4f4f::identity());
+        // Reflections of all sprites are alpha-blended.
+        switch(pprt->type) 
         {
-            Ego::OpenGL::PushAttrib pa(GL_ENABLE_BIT | GL_DEPTH_BUFFER_BIT | GL_CURRENT_BIT);
+            case SPRITE_LIGHT:
             {
-                Ego::Math::Colour4f particle_colour;
-                std::shared_ptr<const Ego::Texture> texture = nullptr;
-
-                // don't write into the depth buffer (disable glDepthMask for transparent objects)
-                renderer.setDepthWriteEnabled(false); // ENABLE_BIT
+                // do the light sprites
+                float alpha = fadeoff * inst.falpha;
 
-                // do not draw hidden surfaces
-                renderer.setDepthTestEnabled(true);
-                renderer.setDepthFunction(Ego::CompareFunction::LessOrEqual);
-
-                // draw draw front and back faces of polygons
-                renderer.setCullingMode(Ego::CullingMode::None);
-
-                // do not display the completely transparent portion
-                renderer.setAlphaTestEnabled(true);
-                renderer.setAlphaFunction(Ego::CompareFunction::Greater, 0.0f);
-
-                renderer.setBlendingEnabled(true);
-                renderer.setBlendFunction(Ego::BlendFunction::SourceAlpha, Ego::BlendFunction::OneMinusSourceAlpha);
-
-                switch(pprt->type) 
-                {
-                    case SPRITE_LIGHT:
-                    {
-                        // do the light sprites
-                        float alpha = fadeoff * inst.falpha;
-
-                        //Nothing to draw?
-                        if(alpha <= 0.0f) {
-                            return gfx_fail;
-                        }
-
-                        particle_colour = Ego::Math::Colour4f(1.0f, 1.0f, 1.0f, alpha);
-
-                        texture = ParticleHandler::get().getLightParticleTexture();
-                        renderer.getTextureUnit().setActivated(texture.get());
-                    }
-                    break;
-
-                    case SPRITE_SOLID:
-                    case SPRITE_ALPHA:
-                    {
-                        float alpha = fadeoff;
-                        if (SPRITE_ALPHA == pprt->type) {
-                            alpha *= inst.falpha;
-
-                            //Nothing to draw?
-                            if(alpha <= 0.0f) {
-                                return gfx_fail;
-                            }
-                        }
+                //Nothing to draw?
+                if(alpha <= 0.0f) {
+                    return gfx_fail;
+                }
 
-                        particle_colour = Ego::Math::Colour4f(inst.fintens, inst.fintens, inst.fintens, alpha);
+                const auto& texture = ParticleHandler::get().getLightParticleTexture();
+                add_billboard(batch, Ego::Graphics::ParticleBlendMode::Alpha, *texture, inst,
+                              Ego::Math::Colour4f(1.0f, 1.0f, 1.0f, alpha), true);
+            }
+            break;
 
-                        texture = ParticleHandler::get().getTransparentParticleTexture();
-                        renderer.getTextureUnit().setActivated(texture.get());
-                    }
-                    break;
+            case SPRITE_SOLID:
+            case SPRITE_ALPHA:
+            {
+                float alpha = fadeoff;
+                if (SPRITE_ALPHA == pprt->type) {
+                    alpha *= inst.falpha;
 
-                    // unknown type
-                    default:
+                    //Nothing to draw?
+                    if(alpha <= 0.0f) {
                         return gfx_fail;
-                    break;
+                    }
                 }
 
-                // Calculate the position of the four corners of the billboard
-                // used to display the particle.
-                auto vd = Ego::VertexFormatFactory::get<Ego::VertexFormat::P3FT2F>();
-                auto vb = std::make_shared<Ego::VertexBuffer>(4, vd.getVertexSize());
-                calc_billboard_verts(*texture, *vb, inst, inst.size, true);
-
-                renderer.setColour(particle_colour); // GL_CURRENT_BIT
-
-                renderer.render(*vb, vd, Ego::PrimitiveType::TriangleFan, 0, 4);
+                const auto& texture = ParticleHandler::get().getTransparentParticleTexture();
+                add_billboard(batch, Ego::Graphics::ParticleBlendMode::Alpha, *texture, inst,
+                              Ego::Math::Colour4f(inst.fintens, inst.fintens, inst.fintens, alpha), true);
             }
+            break;
+
+            // unknown type
+            default:
+                return gfx_fail;
+            break;
         }
     }
 
     return gfx_success;
 }
 
-void ParticleGraphicsRenderer::calc_billboard_verts(const Ego::Texture& texture, Ego::VertexBuffer& vb, Ego::Graphics::ParticleGraphics& inst, float size, bool do_reflect)
+void ParticleGraphicsRenderer::add_billboard(Ego::Graphics::ParticleBatch& batch, Ego::Graphics::ParticleBlendMode blendMode, const Ego::Texture& texture,
+                                             const Ego::Graphics::ParticleGraphics& inst, const Ego::Math::Colour4f& colour, bool do_reflect)
 {
-    // Calculate the position and texture coordinates of the four corners of the billboard used to display the particle.
-
-    if (vb.getNumberOfVertices() < 4)
-    {
-        throw std::runtime_error("vertex buffer too small");
-    }
-    /// @todo Add a compare by equality for vertex format descriptors and assert the vertex buffer has the required format.
-    struct Vertex
-    {
-        float x, y, z;
-        float s, t;
-    };
-
-    int i;
-	Vector3f prt_pos, prt_up, prt_right;
-
-    // use the pre-computed reflection parameters
-    if (do_reflect)
-    {
-        prt_pos = inst.ref_pos;
-        prt_up = inst.ref_up;
-        prt_right = inst.ref_right;
-    }
-    else
-    {
-        prt_pos = inst.pos;
-        prt_up = inst.up;
-        prt_right = inst.right;
-    }
-
-    Vertex *v = static_cast<Vertex *>(vb.lock());
-
-    for (i = 0; i < 4; i++)
-    {
-        v[i].x = prt_pos[kX];
-        v[i].y = prt_pos[kY];
-        v[i].z = prt_pos[kZ];
-    }
-
-    // Considered as left bottom.
-    // Hence expand to the left and the bottom.
-    v[0].x += (-prt_right[kX] - prt_up[kX]) * size;
-    v[0].y += (-prt_right[kY] - prt_up[kY]) * size;
-    v[0].z += (-prt_right[kZ] - prt_up[kZ]) * size;
-
-    // Considered as right bottom.
-    // Hence expand to the right and the bottom.
-    v[1].x += (prt_right[kX] - prt_up[kX]) * size;
-    v[1].y += (prt_right[kY] - prt_up[kY]) * size;
-    v[1].z += (prt_right[kZ] - prt_up[kZ]) * size;
-
-    // Considered as right top.
-    // Hence expand to the right and the top.
-    v[2].x += (prt_right[kX] + prt_up[kX]) * size;
-    v[2].y += (prt_right[kY] + prt_up[kY]) * size;
-    v[2].z += (prt_right[kZ] + prt_up[kZ]) * size;
-
-    // Considered as left top.
-    // Hence expand to the left and the top.
-    v[3].x += (-prt_right[kX] + prt_up[kX]) * size;
-    v[3].y += (-prt_right[kY] + prt_up[kY]) * size;
-    v[3].z += (-prt_right[kZ] + prt_up[kZ]) * size;
-
-    v[0].s = CALCULATE_PRT_U1(texture, inst.image_ref);
-    v[0].t = CALCULATE_PRT_V1(texture, inst.image_ref);
-
-    v[1].s = CALCULATE_PRT_U0(texture, inst.image_ref);
-    v[1].t = CALCULATE_PRT_V1(texture, inst.image_ref);
-
-    v[2].s = CALCULATE_PRT_U0(texture, inst.image_ref);
-    v[2].t = CALCULATE_PRT_V0(texture, inst.image_ref);
-
-    v[3].s = CALCULATE_PRT_U1(texture, inst.image_ref);
-    v[3].t = CALCULATE_PRT_V0(texture, inst.image_ref);
-
-    vb.unlock();
+    // Queue the billboard used to display the particle.
+    // Use the pre-computed reflection parameters for reflections.
+    batch.add(blendMode, &texture,
+              do_reflect ? inst.ref_pos : inst.pos,
+              do_reflect ? inst.ref_right : inst.right,
+              do_reflect ? inst.ref_up : inst.up,
+              inst.size,
+              CALCULATE_PRT_U0(texture, inst.image_ref), CALCULATE_PRT_V0(texture, inst.image_ref),
+              CALCULATE_PRT_U1(texture, inst.image_ref), CALCULATE_PRT_V1(texture, inst.image_ref),
+              colour);
 }
 
 void ParticleGraphicsRenderer::render_all_prt_attachment()
@@ -32,6 +32,8 @@ class Particle;
 namespace Graphics { 
 struct ParticleGraphics;
 class ObjectGraphics;
+class ParticleBatch;
+enum class ParticleBlendMode;
 } }
 
 //--------------------------------------------------------------------------------------------
@@ -46,15 +48,17 @@ struct ParticleGraphicsRenderer
     static float CALCULATE_PRT_U1(const Ego::Texture& texture, int CNT);
     static float CALCULATE_PRT_V0(const Ego::Texture& texture, int CNT);
     static float CALCULATE_PRT_V1(const Ego::Texture& texture, int CNT);
-    static gfx_rv render_one_prt_solid(const ParticleRef iprt);
-    static gfx_rv render_one_prt_trans(const ParticleRef iprt);
-    static gfx_rv render_one_prt_ref(const ParticleRef iprt);
+    // queue the sprites of particles into a batch
+    static gfx_rv render_one_prt_solid(Ego::Graphics::ParticleBatch& batch, const ParticleRef iprt);
+    static gfx_rv render_one_prt_trans(Ego::Graphics::ParticleBatch& batch, const ParticleRef iprt);
+    static gfx_rv render_one_prt_ref(Ego::Graphics::ParticleBatch& batch, const ParticleRef iprt);
     static void render_all_prt_bbox();
     static void render_prt_bbox(const std::shared_ptr<Ego::Particle> &bdl_prt);
     static void render_all_prt_attachment();
     static void prt_draw_attached_point(const std::shared_ptr<Ego::Particle> &bdl_prt);
 private:
     static void draw_one_attachment_point(Ego::Graphics::ObjectGraphics& inst, int vrt_offset);
-    static void calc_billboard_verts(const Ego::Texture& texture, Ego::VertexBuffer& vb, Ego::Graphics::ParticleGraphics& pinst, float size, bool do_reflect);
+    static void add_billboard(Ego::Graphics::ParticleBatch& batch, Ego::Graphics::ParticleBlendMode blendMode, const Ego::Texture& texture,
+                              const Ego::Graphics::ParticleGraphics& inst, const Ego::Math::Colour4f& colour, bool do_reflect);
 };
 
@@ -484,6 +484,64 @@ float lighting_cache_t::lighting_evaluate_cache( const lighting_cache_t& src, co
     return light_tot;
 }
 
+//--------------------------------------------------------------------------------------------
+void lighting_normal_table_t::evaluate(lighting_normal_table_t& self, const lighting_cache_t& src,
+                                       const uint8_t *lst, const uint8_t *nxt, const size_t count)
+{
+    float amb;
+
+    // a model with few vertices only uses a few of the normals
+    std::bitset<MD2Model::normalCount> used;
+    for (size_t i = 0; i < count; ++i)
+    {
+        used.set(lst[i]);
+        used.set(nxt[i]);
+    }
+
+    for (size_t i = 0; i < MD2_MAX_NORMALS; ++i)
+    {
+        if (!used.test(i)) continue;
+
+        const Vector3f nrm(MD2Model::getMD2Normal(i, 0), MD2Model::getMD2Normal(i, 1), MD2Model::getMD2Normal(i, 2));
+
+        self.low[i] = lighting_cache_base_t::evaluate(src.low, nrm, amb);
+        self.hgh[i] = lighting_cache_base_t::evaluate(src.hgh, nrm, amb);
+    }
+
+    if (used.test(MD2_MAX_NORMALS))
+    {
+        // this is the "ambient only" index, but it really means to sum up all the light
+        // and average all the directions
+        self.low[MD2_MAX_NORMALS] = (lighting_cache_base_t::evaluate(src.low, Vector3f(+1.0f, +1.0f, +1.0f), amb) +
+                                     lighting_cache_base_t::evaluate(src.low, Vector3f(-1.0f, -1.0f, -1.0f), amb)) / 6.0f;
+        self.hgh[MD2_MAX_NORMALS] = (lighting_cache_base_t::evaluate(src.hgh, Vector3f(+1.0f, +1.0f, +1.0f), amb) +
+                                     lighting_cache_base_t::evaluate(src.hgh, Vector3f(-1.0f, -1.0f, -1.0f), amb)) / 6.0f;
+    }
+}
+
+void lighting_normal_table_t::evaluateBatch(const lighting_normal_table_t& self, const AxisAlignedBox3f& bbox,
+                                            const uint8_t *lst, const uint8_t *nxt, const float *hgt,
+                                            const float flip, const size_t count, float *dst)
+{
+    const float zmin = bbox.getMin()[kZ];
+    const float zscale = 1.0f / (bbox.getMax()[kZ] - zmin);
+    const float *low = self.low.data();
+    const float *hgh = self.hgh.data();
+
+    for (size_t i = 0; i < count; ++i)
+    {
+        // determine the weighting
+        float hgh_wt = (hgt[i] - zmin) * zscale;
+        hgh_wt = std::min(std::max(hgh_wt, 0.0f), 1.0f);
+
+        // interpolate the table entries between the source and the target frame
+        const float low_lite = low[lst[i]] + (low[nxt[i]] - low[lst[i]]) * flip;
+        const float hgh_lite = hgh[lst[i]] + (hgh[nxt[i]] - hgh[lst[i]]) * flip;
+
+        dst[i] = low_lite + (hgh_lite - low_lite) * hgh_wt;
+    }
+}
+
 //--------------------------------------------------------------------------------------------
 //--------------------------------------------------------------------------------------------
 float dyna_lighting_intensity( const dynalight_data_t * pdyna, const Vector3f& diff )
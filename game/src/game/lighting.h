@@ -22,6 +22,7 @@
 #pragma once
 
 #include "game/egoboo.h"
+#include "egolib/Graphics/MD2Model.hpp"
 
 //--------------------------------------------------------------------------------------------
 //--------------------------------------------------------------------------------------------
@@ -114,6 +115,57 @@ struct lighting_cache_t
 
 };
 
+//--------------------------------------------------------------------------------------------
+/**
+ * @brief
+ *  A lighting cache evaluated for every MD2 normal.
+ * @remark
+ *  An MD2 model only ever uses the MD2Model::normalCount distinct normals,
+ *  so the lighting of a vertex is the evaluation of the low and high layers
+ *  of the cache for its normal index, blended by the height of the vertex.
+ *  Evaluating the layers once per normal index instead of once per vertex
+ *  turns the per-vertex lighting into two table reads and a linear blend.
+ */
+struct lighting_normal_table_t
+{
+    lighting_normal_table_t() :
+        low{},
+        hgh{}
+    {
+        low.fill(0.0f);
+        hgh.fill(0.0f);
+    }
+
+    std::array<float, MD2Model::normalCount> low;   ///< the low layer evaluated for each normal index
+    std::array<float, MD2Model::normalCount> hgh;   ///< the high layer evaluated for each normal index
+
+    /// Evaluate both layers of a lighting cache for the normal indices used by a batch of vertices.
+    /// The entries of the other normal indices are left unchanged.
+    /// The "equal light" normal index averages the light from all directions.
+    /// @param lst, nxt the normal indices of the vertices in the source and the target frame
+    /// @param count the number of vertices
+    static void evaluate(lighting_normal_table_t& self, const lighting_cache_t& src,
+                         const uint8_t *lst, const uint8_t *nxt, const size_t count);
+
+    /**
+     * @brief
+     *  Evaluate the lighting of a batch of vertices.
+     * @param self the lighting table
+     * @param bbox the bounding box used to compute the low/high blend weight from the height
+     * @param lst, nxt the normal indices of the vertices in the source and the target frame
+     * @param hgt the heights of the vertices
+     * @param flip the interpolation between the source and the target frame
+     * @param count the number of vertices
+     * @param [out] dst the lighting of the vertices
+     * @remark
+     *  All arrays are contiguous and hold @a count elements. The loop body is branch-free
+     *  so that the compiler can vectorize it.
+     */
+    static void evaluateBatch(const lighting_normal_table_t& self, const AxisAlignedBox3f& bbox,
+                              const uint8_t *lst, const uint8_t *nxt, const float *hgt,
+                              const float flip, const size_t count, float *dst);
+};
+
 //--------------------------------------------------------------------------------------------
 #define MAXDYNADIST                     2700        // Leeway for offscreen lights
 #define TOTAL_MAX_DYNA                    64          // Absolute max number of dynamic lights
@@ -29,6 +29,7 @@
 #include "egolib/FileFormats/Globals.hpp"
 #include "game/game.h"
 #include "game/Module/Module.hpp"
+#include "game/Graphics/TextureAtlasManager.hpp"
 
 //--------------------------------------------------------------------------------------------
 //--------------------------------------------------------------------------------------------
@@ -52,116 +53,64 @@ static void warnNumberOfVertices(const char *file, int line, size_t numberOfVert
 //--------------------------------------------------------------------------------------------
 
 tile_mem_t::tile_mem_t(const Ego::MeshInfo& info)
-	: _tileList(info.getTileCount()), _info(info), _bbox() {
+	: tile_mem_t(Ego::CookedMesh::create(info.getVertexCount(), info.getTileCountX(), info.getTileCountY())) {
+}
+
+tile_mem_t::tile_mem_t(const std::shared_ptr<Ego::CookedMesh>& cooked)
+	: _tileList(cooked->getTileCount()),
+	  _info(cooked->getVertexCount(), cooked->getTileCountX(), cooked->getTileCountY()),
+	  _bbox(cooked->getBounds()), _cooked(cooked) {
 	// If the number of vertices exceeds the limits ...
-	if (info.getVertexCount() > MAP_VERTICES_MAX) {
+	if (_info.getVertexCount() > MAP_VERTICES_MAX) {
 		// ... emit a warning.
-		warnNumberOfVertices(__FILE__, __LINE__, info.getVertexCount());
+		warnNumberOfVertices(__FILE__, __LINE__, _info.getVertexCount());
 	}
 	// Set the mesh edge info.
-	_edge_x = (info.getTileCountX() + 1) * Info<int>::Grid::Size();
-	_edge_y = (info.getTileCountY() + 1) * Info<int>::Grid::Size();
-	// Allocate the arrays.
-	_plst = std::make_unique<GLXvector3f[]>(info.getVertexCount());
-	_tlst = std::make_unique<GLXvector2f[]>(info.getVertexCount());
-	_clst = std::make_unique<GLXvector3f[]>(info.getVertexCount());
-	_nlst = std::make_unique<GLXvector3f[]>(info.getVertexCount());
+	_edge_x = (_info.getTileCountX() + 1) * Info<int>::Grid::Size();
+	_edge_y = (_info.getTileCountY() + 1) * Info<int>::Grid::Size();
+	// Use the vertex arrays of the cooked mesh in place.
+	_plst = _cooked->getPositions();
+	_tlst = _cooked->getTexCoords();
+	_nlst = _cooked->getNormals();
+	_clst = std::make_unique<GLXvector3f[]>(_info.getVertexCount());
+	// Copy the per-tile info.
+	const Ego::CookedMeshTile *tiles = _cooked->getTiles();
+	for (size_t i = 0; i < _tileList.size(); ++i) {
+		const Ego::CookedMeshTile& source = tiles[i];
+		ego_tile_info_t& target = _tileList[i];
+		target._itile = i;
+		target._type = source.type;
+		target._img = source.img;
+		target._vrtstart = source.vertexStart;
+		target._base_fx = source.fx;
+		target._pass_fx = source.fx;
+		target._twist = source.twist;
+		target._a = source.a;
+		target._l = 0;
+		for (size_t j = 0; j < 4; ++j) {
+			target._ncache[j][XX] = source.cornerNormals[j][0];
+			target._ncache[j][YY] = source.cornerNormals[j][1];
+			target._ncache[j][ZZ] = source.cornerNormals[j][2];
+		}
+		for (size_t j = 0; j < OCT_COUNT; ++j) {
+			target._oct._mins[j] = source.octMins[j];
+			target._oct._maxs[j] = source.octMaxs[j];
+		}
+		target._oct._empty = (0 != source.octEmpty);
+	}
 }
 
 tile_mem_t::~tile_mem_t() {
 }
 
-void tile_mem_t::computeVertexIndices(const tile_dictionary_t& dict)
-{
-	size_t vertexIndex = 0;
-	for (size_t i = 0; i < _info.getTileCount(); ++i) {
-		get(i)._vrtstart = vertexIndex;
-
-		uint8_t type = get(i)._type;
-
-		// Throw away any remaining upper bits.
-		type &= 0x3F;
-
-		const tile_definition_t *def = dict.get(type);
-		if (!def) continue;
-
-		vertexIndex += def->numvertices;
-	}
-
-	if (vertexIndex != _info.getVertexCount()) {
-		Log::get() << Log::Entry::create(Log::Level::Warning, __FILE__, __LINE__, "wrong number of vertices: received ",
-                                         vertexIndex, ", expected ", _info.getVertexCount(), Log::EndOfEntry);
-	}
-}
-
 //--------------------------------------------------------------------------------------------
 
-std::shared_ptr<ego_mesh_t> MeshLoader::convert(const map_t& source) const
-{
-    // Create a mesh.
-    auto target = std::make_shared<ego_mesh_t>(Ego::MeshInfo(source._info.getVertexCount(), source._info.getTileCountX(), source._info.getTileCountY()));
-	tile_mem_t& tmem_dst = target->_tmem;
-	Ego::MeshInfo& info_dst = target->_info;
-
-    // copy all the per-tile info
-    for (Index1D cnt = 0; cnt < info_dst.getTileCount(); cnt++)
-    {
-        const tile_info_t& ptile_src = source._mem.tiles[cnt.i()];
-        ego_tile_info_t& ptile_dst = tmem_dst.get(cnt);
-
-        // do not BLANK_STRUCT_PTR() here, since these were constructed when they were allocated
-        ptile_dst._type = ptile_src.type;
-        ptile_dst._img  = ptile_src.img;
-
-        // do not BLANK_STRUCT_PTR() here, since these were constructed when they were allocated
-		ptile_dst._base_fx = ptile_src.fx;
-		ptile_dst._twist   = ptile_src.twist;
-
-        // set the local fx flags
-		ptile_dst._pass_fx = ptile_dst._base_fx;
-
-        // lcache is set in the constructor
-        // nlst is set in the constructor
-    }
-
-    // copy all the per-vertex info
-    for (size_t cnt = 0; cnt < source._info.getVertexCount(); cnt++ )
-    {
-		GLXvector3f& ppos_dst = tmem_dst._plst[cnt];
-        GLXvector3f& pcol_dst = tmem_dst._clst[cnt];
-        const map_vertex_t& pvrt_src = source._mem.vertices[cnt];
-
-        // copy all info from map_mem_t
-        ppos_dst[XX] = pvrt_src.pos[kX];
-        ppos_dst[YY] = pvrt_src.pos[kY];
-        ppos_dst[ZZ] = pvrt_src.pos[kZ];
-
-        // default color
-        pcol_dst[RR] = pcol_dst[GG] = pcol_dst[BB] = 0.0f;
-
-        // tlist is set below
-    }
-
-    // copy some of the pre-calculated grid lighting
-    for (uint32_t cnt = 0; cnt < info_dst.getTileCount(); cnt++ )
-    {
-        size_t vertex = tmem_dst.get(cnt)._vrtstart;
-        ego_tile_info_t& ptile_dst = tmem_dst.get(cnt);
-        const map_vertex_t& pvrt_src = source._mem.vertices[vertex];
-
-		ptile_dst._a = pvrt_src.a;
-		ptile_dst._l = 0.0f;
-    }
-
-	return target;
-}
+const std::vector<std::string> MeshLoader::Sources = {"mp_data/level.mpd", "mp_data/fans.txt"};
 
-//--------------------------------------------------------------------------------------------
-std::shared_ptr<ego_mesh_t> MeshLoader::operator()(const std::string& moduleName) const
+std::shared_ptr<Ego::CookedMesh> MeshLoader::import(const std::string& moduleName) const
 {
 	map_t map;
 	// Load the map data.
-	tile_dictionary_load_vfs("mp_data/fans.txt", tile_dict);
 	if (!map.load("mp_data/level.mpd"))
 	{
         Log::Entry entry(Log::Level::Error, __FILE__, __LINE__);
@@ -169,15 +118,29 @@ std::shared_ptr<ego_mesh_t> MeshLoader::operator()(const std::string& moduleName
         Log::get() << entry;
 		throw id::runtime_error(__FILE__, __LINE__, entry.getText());
 	}
-	// Create the mesh from map.
-	std::shared_ptr<ego_mesh_t> mesh = convert(map);
-	if (!mesh)
+	// Cook the map.
+	std::shared_ptr<Ego::CookedMesh> cooked = Ego::CookedMesh::cook(map, tile_dict, Ego::CookedMesh::stampSources(MeshLoader::Sources));
+	if (!cooked)
 	{
         auto e = Log::Entry::create(Log::Level::Error, __FILE__, __LINE__, "unable to convert mesh of module ", "`",
                                     moduleName, "`", Log::EndOfEntry);
         Log::get() << e;
 		throw id::runtime_error(__FILE__, __LINE__, e.getText());
 	}
+	return cooked;
+}
+
+//--------------------------------------------------------------------------------------------
+std::shared_ptr<ego_mesh_t> MeshLoader::operator()(const std::string& moduleName) const
+{
+	tile_dictionary_load_vfs("mp_data/fans.txt", tile_dict);
+	// Use the cooked mesh if it was cooked from the current sources, otherwise import the map.
+	std::shared_ptr<Ego::CookedMesh> cooked = Ego::CookedMesh::load("mp_data/level.mpc", Sources);
+	if (!cooked)
+	{
+		cooked = import(moduleName);
+	}
+	auto mesh = std::make_shared<ego_mesh_t>(cooked);
 	mesh->finalize();
 	return mesh;
 }
@@ -222,199 +185,6 @@ MeshLookupTables::MeshLookupTables() {
 	}
 }
 
-//--------------------------------------------------------------------------------------------
-void ego_mesh_t::make_bbox()
-{
-    _tmem._bbox = AxisAlignedBox3f(Point3f(_tmem._plst[0][XX], _tmem._plst[0][YY], _tmem._plst[0][ZZ]),
-		                           Point3f(_tmem._plst[0][XX], _tmem._plst[0][YY], _tmem._plst[0][ZZ]));
-
-	for (Index1D cnt = 0; cnt < _info.getTileCount(); cnt++)
-	{
-        ego_tile_info_t& ptile = _tmem.get(cnt);
-        oct_bb_t& poct = ptile._oct;
-
-
-        ptile._itile = cnt.i();
-
-		tile_definition_t *pdef = tile_dict.get(ptile._type & 0x3F);
-		if (NULL == pdef) continue;
-
-		// Initialize the octagonal bounding box of the tile with the first vertex of the tile ...
-        size_t mesh_vrt = _tmem.get(cnt)._vrtstart;
-        oct_vec_v2_t ovec = oct_vec_v2_t(Vector3f(_tmem._plst[mesh_vrt][0], _tmem._plst[mesh_vrt][1],_tmem._plst[mesh_vrt][2]));
-        poct = oct_bb_t(ovec);
-        mesh_vrt++;
-        
-        // ... then add the other vertex of the tile to it.
-        for (uint8_t i = 1, n = pdef->numvertices; i < n; i++, mesh_vrt++ )
-        {
-            ovec = oct_vec_v2_t(Vector3f(_tmem._plst[mesh_vrt][0],_tmem._plst[mesh_vrt][1],_tmem._plst[mesh_vrt][2]));
-            poct.join(ovec);
-        }
-
-		/// @todo: This test is not up-2-date anymore.
-		///        If you join a bbox with an ovec, the box is never(!) empty.
-		///        However, it still might be desirable not to have boxes with
-		///        width, height and depth of one. Should be evaluated asap.
-        // ensure that NO tile has zero volume.
-        // if a tile is declared to have all the same height, it will accidentally be called "empty".
-        if (poct._empty || (std::abs(poct._maxs[OCT_X] - poct._mins[OCT_X]) +
-                            std::abs(poct._maxs[OCT_Y] - poct._mins[OCT_Y]) +
-                            std::abs(poct._maxs[OCT_Z] - poct._mins[OCT_Z])) < std::numeric_limits<float>::epsilon())
-        {
-            ovec[OCT_X] = ovec[OCT_Y] = ovec[OCT_Z] = 0.1;
-            ovec[OCT_XY] = ovec[OCT_YX] = Ego::Math::sqrtTwo<float>() * ovec[OCT_X];
-            oct_bb_t::self_grow(poct, ovec);
-        }
-
-        // Add the bounds of the tile to the bounds of the mesh.
-        _tmem._bbox.join(poct.toAxisAlignedBox());
-    }
-}
-
-//--------------------------------------------------------------------------------------------
-void ego_mesh_t::make_normals()
-{
-    // test for mesh
-
-    // set the default normal for each fan, based on the calculated twist value
-    for (Index1D fan0 = 0; fan0 < _tmem.getInfo().getTileCount(); fan0++ )
-    {
-        uint8_t twist = _tmem.get(fan0)._twist;
-
-        _tmem._nlst[fan0.i()][XX] = g_meshLookupTables.twist_nrm[twist][kX];
-        _tmem._nlst[fan0.i()][YY] = g_meshLookupTables.twist_nrm[twist][kY];
-        _tmem._nlst[fan0.i()][ZZ] = g_meshLookupTables.twist_nrm[twist][kZ];
-    }
-
-	int      edge_is_crease[4];
-	Vector3f nrm_lst[4], vec_sum;
-	float    weight_lst[4];
-
-    // find an "average" normal of each corner of the tile
-    for (size_t iy = 0; iy < _info.getTileCountY(); iy++ )
-    {
-        for (size_t ix = 0; ix < _info.getTileCountX(); ix++ )
-        {
-            constexpr int ix_off[4] = {0, 1, 1, 0};
-            constexpr int iy_off[4] = {0, 0, 1, 1};
-
-            Index1D fan0 = getTileIndex(Index2D(ix, iy));
-			if (!grid_is_valid(fan0)) {
-				continue;
-			}
-
-            nrm_lst[0][kX] = _tmem._nlst[fan0.i()][XX];
-            nrm_lst[0][kY] = _tmem._nlst[fan0.i()][YY];
-            nrm_lst[0][kZ] = _tmem._nlst[fan0.i()][ZZ];
-
-            // for each corner of this tile
-            for (int i = 0; i < 4; i++ )
-            {
-                // the offset list needs to be shifted depending on what i is
-                int dx, dy;
-                size_t shift = ( 6 - i ) % 4;
-                if ( 1 == ix_off[(4-shift) % 4] ){
-                  dx = -1;  
-                }  
-                else {
-                  dx = 0;  
-                } 
-                if ( 1 == iy_off[(4-shift) % 4] ){
-                  dy = -1;  
-                }  
-                else{
-                    dy = 0;
-                } 
-
-                int loc_ix_off[4];
-                int loc_iy_off[4];
-                for (int k = 0; k < 4; k++ )
-                {
-                    loc_ix_off[k] = ix_off[( 4-shift + k ) % 4 ] + dx;
-                    loc_iy_off[k] = iy_off[( 4-shift + k ) % 4 ] + dy;
-                }
-
-                // cache the normals
-                // nrm_lst[0] is already known.
-                for (int j = 1; j < 4; j++ )
-                {
-                    int jx = static_cast<int>(ix) + loc_ix_off[j];
-                    int jy = static_cast<int>(iy) + loc_iy_off[j];
-
-                    Index1D fan1 = getTileIndex(Index2D(jx, jy));
-
-                    if ( grid_is_valid( fan1 ) )
-                    {
-                        nrm_lst[j][kX] = _tmem._nlst[fan1.i()][XX];
-                        nrm_lst[j][kY] = _tmem._nlst[fan1.i()][YY];
-                        nrm_lst[j][kZ] = _tmem._nlst[fan1.i()][ZZ];
-
-                        if ( nrm_lst[j][kZ] < 0 )
-                        {
-                            nrm_lst[j] = -nrm_lst[j];
-                        }
-                    }
-                    else
-                    {
-                        nrm_lst[j] = Vector3f(0.0f, 0.0f, 1.0f);
-                    }
-                }
-
-                // find the creases
-                for (int j = 0; j < 4; j++ )
-                {
-                    float vdot;
-                    int m = ( j + 1 ) % 4;
-
-                    vdot = nrm_lst[j].dot(nrm_lst[m]);
-
-                    edge_is_crease[j] = (vdot < Ego::Math::invSqrtTwo<float>());
-
-                    weight_lst[j] = nrm_lst[j].dot(nrm_lst[0]);
-                }
-
-                weight_lst[0] = 1.0f;
-                if ( edge_is_crease[0] )
-                {
-                    // this means that there is a crease between tile 0 and 1
-                    weight_lst[1] = 0.0f;
-                }
-
-                if ( edge_is_crease[3] )
-                {
-                    // this means that there is a crease between tile 0 and 3
-                    weight_lst[3] = 0.0f;
-                }
-
-                if ( edge_is_crease[0] && edge_is_crease[3] )
-                {
-                    // this means that there is a crease between tile 0 and 1
-                    // and a crease between tile 0 and 3, isolating tile 2
-                    weight_lst[2] = 0.0f;
-                }
-
-                vec_sum = nrm_lst[0];
-                for (int j = 1; j < 4; j++ )
-                {
-                    if ( weight_lst[j] > 0.0f )
-                    {
-                        vec_sum[kX] += nrm_lst[j][kX] * weight_lst[j];
-                        vec_sum[kY] += nrm_lst[j][kY] * weight_lst[j];
-                        vec_sum[kZ] += nrm_lst[j][kZ] * weight_lst[j];
-                    }
-                }
-
-				vec_sum.normalize();
-
-                _tmem.get(fan0)._ncache[i][XX] = vec_sum[kX];
-                _tmem.get(fan0)._ncache[i][YY] = vec_sum[kY];
-                _tmem.get(fan0)._ncache[i][ZZ] = vec_sum[kZ];
-            }
-        }
-    }
-}
-
 //--------------------------------------------------------------------------------------------
 
 BIT_FIELD ego_mesh_t::test_wall(const BIT_FIELD bits, const mesh_wall_data_t& data) const
@@ -1275,26 +1045,11 @@ ego_mesh_t::ego_mesh_t(const Ego::MeshInfo& mesh_info)
 	: _info(mesh_info), _tmem(mesh_info), _fxlists(mesh_info) {
 }
 
-ego_mesh_t::~ego_mesh_t() {
-}
-
-void ego_mesh_t::remove_ambient() {
-	/// @brief Remove ambient.
-	uint8_t min_vrt_a = 255;
-	for (Index1D i = 0; i < _info.getTileCount(); ++i) {
-		min_vrt_a = std::min(min_vrt_a, _tmem.get(i)._a);
-	}
-	for (Index1D i = 0; i < _info.getTileCount(); ++i) {
-		_tmem.get(i)._a = _tmem.get(i)._a - min_vrt_a;
-	}
+ego_mesh_t::ego_mesh_t(const std::shared_ptr<Ego::CookedMesh>& cooked)
+	: _info(cooked->getVertexCount(), cooked->getTileCountX(), cooked->getTileCountY()), _tmem(cooked), _fxlists(_info) {
 }
 
-void ego_mesh_t::recalc_twist() {
-	// @brief recalculate the twist.
-	for (Index1D i = 0; i < _info.getTileCount(); ++i) {
-		uint8_t twist = get_fan_twist(i);
-		_tmem.get(i)._twist = twist;
-	}
+ego_mesh_t::~ego_mesh_t() {
 }
 
 bool ego_mesh_t::set_texture(const Index1D& index1D, uint16_t image)
@@ -1326,32 +1081,38 @@ bool ego_mesh_t::update_texture(const Index1D& i)
 	tile_definition_t *pdef = tile_dict.get(type);
 	if (!pdef) return false;
 
+	// If the tiles are packed into a texture atlas, map the texture coordinates into the atlas.
+	const Ego::Graphics::TextureAtlasManager *atlasManager = nullptr;
+	if (Ego::Graphics::TextureAtlasManager::isInitialized() && Ego::Graphics::TextureAtlasManager::get().getAtlas()) {
+		atlasManager = &Ego::Graphics::TextureAtlasManager::get();
+	}
+	const int image = TILE_GET_LOWER_BITS(tile._img);
+	const bool big = tile._type >= tile_dict.offset;
+
 	size_t mesh_vrt = tile._vrtstart;
 	for (uint16_t tile_vrt = 0; tile_vrt < pdef->numvertices; tile_vrt++, mesh_vrt++) {
-		_tmem._tlst[mesh_vrt][SS] = pdef->vertices[tile_vrt].u;
-		_tmem._tlst[mesh_vrt][TT] = pdef->vertices[tile_vrt].v;
+		float s = pdef->vertices[tile_vrt].u,
+			  t = pdef->vertices[tile_vrt].v;
+		if (atlasManager) {
+			atlasManager->mapTexCoord(image, big, s, t);
+		}
+		_tmem._tlst[mesh_vrt][SS] = s;
+		_tmem._tlst[mesh_vrt][TT] = t;
 	}
 
 	return true;
 }
 
-void ego_mesh_t::make_texture() {
-	/// @brief Set the texture coordinate for every vertex.
-	for (Index1D i = 0; i < _info.getTileCount(); ++i) {
+void ego_mesh_t::update_textures()
+{
+	for (size_t i = 0; i < _info.getTileCount(); ++i) {
 		update_texture(i);
 	}
 }
 
 void ego_mesh_t::finalize()
 {
-	// (1) (Re)compute the vertex indices.
-	_tmem.computeVertexIndices(tile_dict);
-	remove_ambient();
-	recalc_twist();
-	make_normals();
-	make_bbox();
-	make_texture();
-
+	// Vertex indices, twist, normals, bounding boxes and texture coordinates are precomputed by Ego::CookedMesh.
 	// create some lists to make searching the mesh tiles easier
 	_fxlists.synch(_tmem, true);
 }
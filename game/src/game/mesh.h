@@ -24,6 +24,7 @@
 #include "game/egoboo.h"
 #include "game/lighting.h"
 #include "egolib/Mesh/Info.hpp"
+#include "egolib/Mesh/CookedMesh.hpp"
 
 //--------------------------------------------------------------------------------------------
 // external types
@@ -265,19 +266,26 @@ public:
 	float _edge_y;
     AxisAlignedBox3f _bbox;                 ///< bounding box for the entire mesh
 
-	std::unique_ptr<GLXvector3f[]> _plst;                 ///< the position list
-    std::unique_ptr<GLXvector2f[]> _tlst;                 ///< the texture coordinate list
-    std::unique_ptr<GLXvector3f[]> _nlst;                 ///< the normal list
-    std::unique_ptr<GLXvector3f[]> _clst;                 ///< the color list (for lighting the mesh)
+private:
+	std::shared_ptr<Ego::CookedMesh> _cooked;            ///< the cooked mesh the position, texture coordinate and normal lists point into
+public:
+	GLXvector3f *_plst;                                   ///< the position list
+	GLXvector2f *_tlst;                                   ///< the texture coordinate list
+	GLXvector3f *_nlst;                                   ///< the normal list, one normal per tile
+	std::unique_ptr<GLXvector3f[]> _clst;                 ///< the color list (for lighting the mesh)
 
+	/**
+	 * @brief Construct this tile memory for a blank mesh.
+	 * @param info the mesh info
+	 */
 	tile_mem_t(const Ego::MeshInfo& info);
-	~tile_mem_t();
-
 	/**
-	 * @brief (Re)compute the vertex indices of the tiles infos.
-	 * @param dict the tile dictionary to compute the vertex indices over 
+	 * @brief Construct this tile memory from a cooked mesh.
+	 * @param cooked the cooked mesh
+	 * @remark The position, texture coordinate and normal lists are used in place.
 	 */
-	void computeVertexIndices(const tile_dictionary_t& dict);
+	tile_mem_t(const std::shared_ptr<Ego::CookedMesh>& cooked);
+	~tile_mem_t();
 
 public:
 	ego_tile_info_t& get(const Index1D& i) {
@@ -383,6 +391,14 @@ public:
 	 */
     ego_mesh_t(const Ego::MeshInfo& info = Ego::MeshInfo());
 
+	/**
+	 * @brief
+	 *  Construct a mesh from a cooked mesh.
+	 * @param cooked
+	 *  the cooked mesh
+	 */
+	ego_mesh_t(const std::shared_ptr<Ego::CookedMesh>& cooked);
+
     ~ego_mesh_t();
 
     Ego::MeshInfo _info;
@@ -391,9 +407,6 @@ public:
 
     Vector3f get_diff(const Vector3f& pos, float radius, float center_pressure, const BIT_FIELD bits);
     float get_pressure(const Vector3f& pos, float radius, const BIT_FIELD bits) const;
-	/// @brief Remove extra ambient light in the lightmap.
-    void remove_ambient();
-	void recalc_twist();
     void finalize();
 
     /// @brief Get the grid index of the grid at a given point (world coordinates).
@@ -462,24 +475,15 @@ public:
 
 	bool tile_has_bits(const Index2D& i, const BIT_FIELD bits) const;
 
-	void make_texture();
 	bool set_texture(const Index1D& i, uint16_t image);
 	bool update_texture(const Index1D& i);
+	/// @brief Update the texture coordinates of all tiles e.g. after the tile textures have been reloaded.
+	void update_textures();
 
 	uint8_t get_fan_twist(const Index1D& i) const;
 	float get_max_vertex_0(const Index2D& i) const;
 	float get_max_vertex_1(const Index2D& i, float xmin, float ymin, float xmax, float ymax) const;
 
-private:
-	// mesh initialization - not accessible by scripts
-	/// Calculate a set of normals for the 4 corner of a given tile.
-	/// It is supposed to generate smooth normals for most tiles, but where there is a creas
-	/// (i.e. between the floor and a wall) the normals should not be smoothed.
-	// some twist/normal functions
-	void make_normals();
-	/// Set the bounding box for each tile, and for the entire mesh
-	void make_bbox();
-
 };
 
 /// Some look-up tables for meshes (and independent of the particular mesh).
@@ -522,8 +526,11 @@ extern MeshStats g_meshStats;
 //--------------------------------------------------------------------------------------------
 
 /// loading/saving
+/// The cooked mesh "level.mpc" is used if it is up to date, otherwise "level.mpd" is imported.
 struct MeshLoader {
+    /// The sources a cooked mesh is validated against, see Ego::CookedMesh::load.
+    static const std::vector<std::string> Sources;
     std::shared_ptr<ego_mesh_t> operator()(const std::string& moduleName) const;
 private:
-    std::shared_ptr<ego_mesh_t> convert(const map_t& source) const;
+    std::shared_ptr<Ego::CookedMesh> import(const std::string& moduleName) const;
 };
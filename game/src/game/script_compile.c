@@ -1068,6 +1068,9 @@ egolib_rv load_ai_script_vfs0(parser_state_t& ps, const std::string& loadname, O
 
         // determine the correct jumps
         parser_state_t::parse_jumps(script);
+
+        // determine when the script must be run
+        script.classify();
     } catch (...) {
         return rv_fail;
     }
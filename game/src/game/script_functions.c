@@ -673,7 +673,7 @@ uint8_t scr_JoinTargetTeam( script_state_t& state, ai_state_t& self )
     returncode = false;
     if ( _currentModule->getObjectHandler().exists( self.getTarget() ) )
     {
-        pchr->setTeam(pself_target->team);
+        pchr->setTeam(pself_target->getTeamRef());
         returncode = true;
     }
 
@@ -805,7 +805,7 @@ uint8_t scr_SetTargetToWhoeverCalledForHelp( script_state_t& state, ai_state_t&
 
     SCRIPT_FUNCTION_BEGIN();
 
-    if ( VALID_TEAM_RANGE( pchr->team ) )
+    if ( VALID_TEAM_RANGE( pchr->getTeamRef() ) )
     {
         std::shared_ptr<Object> sissy = pchr->getTeam().getSissy();
 
@@ -1567,7 +1567,7 @@ uint8_t scr_DamageTarget( script_state_t& state, ai_state_t& self )
     tmp_damage.rand = 1;
 
     target->damage(Facing::ATK_FRONT, tmp_damage, static_cast<DamageType>(pchr->damagetarget_damagetype), 
-                   pchr->team, _currentModule->getObjectHandler()[self.getSelf()], false, false, true);
+                   pchr->getTeamRef(), _currentModule->getObjectHandler()[self.getSelf()], false, false, true);
 
     SCRIPT_FUNCTION_END();
 }
@@ -1709,9 +1709,9 @@ uint8_t scr_SetTargetToTargetOfLeader( script_state_t& state, ai_state_t& self )
 
     SCRIPT_FUNCTION_BEGIN();
 
-    if ( VALID_TEAM_RANGE( pchr->team ) )
+    if ( VALID_TEAM_RANGE( pchr->getTeamRef() ) )
     {
-        const std::shared_ptr<Object> &leader = _currentModule->getTeamList()[pchr->team].getLeader();
+        const std::shared_ptr<Object> &leader = _currentModule->getTeamList()[pchr->getTeamRef()].getLeader();
 
         if ( leader )
         {
@@ -1762,7 +1762,7 @@ uint8_t scr_BecomeLeader( script_state_t& state, ai_state_t& self )
 
     SCRIPT_FUNCTION_BEGIN();
 
-    _currentModule->getTeamList()[pchr->team].setLeader(_currentModule->getObjectHandler()[self.getSelf()]);
+    _currentModule->getTeamList()[pchr->getTeamRef()].setLeader(_currentModule->getObjectHandler()[self.getSelf()]);
 
     SCRIPT_FUNCTION_END();
 }
@@ -1844,7 +1844,7 @@ uint8_t scr_IfLeaderIsAlive( script_state_t& state, ai_state_t& self )
 
     SCRIPT_FUNCTION_BEGIN();
 
-    returncode = ( _currentModule->getTeamList()[pchr->team].getLeader() != nullptr );
+    returncode = ( _currentModule->getTeamList()[pchr->getTeamRef()].getLeader() != nullptr );
 
     SCRIPT_FUNCTION_END();
 }
@@ -1874,9 +1874,9 @@ uint8_t scr_SetTargetToLeader( script_state_t& state, ai_state_t& self )
     SCRIPT_FUNCTION_BEGIN();
 
     returncode = false;
-    if ( VALID_TEAM_RANGE( pchr->team ) )
+    if ( VALID_TEAM_RANGE( pchr->getTeamRef() ) )
     {
-        const std::shared_ptr<Object> &leader = _currentModule->getTeamList()[pchr->team].getLeader();
+        const std::shared_ptr<Object> &leader = _currentModule->getTeamList()[pchr->getTeamRef()].getLeader();
         if ( leader )
         {
             self.setTarget(leader->getObjRef());
@@ -1903,7 +1903,7 @@ uint8_t scr_SpawnCharacter( script_state_t& state, ai_state_t& self )
 
 	Vector3f pos = Vector3f(static_cast<float>(state.x), static_cast<float>(state.y), pchr->getPosZ());
 
-    std::shared_ptr<Object> pchild = _currentModule->spawnObject(pos, pchr->getProfileID(), pchr->team, 0, Facing(Ego::Math::clipBits<16>( state.turn )), "", ObjectRef::Invalid);
+    std::shared_ptr<Object> pchild = _currentModule->spawnObject(pos, pchr->getProfileID(), pchr->getTeamRef(), 0, Facing(Ego::Math::clipBits<16>( state.turn )), "", ObjectRef::Invalid);
     returncode = pchild != nullptr;
 
     if ( !returncode )
@@ -2069,9 +2069,11 @@ uint8_t scr_CleanUp( script_state_t& state, ai_state_t& self )
 
     SCRIPT_FUNCTION_BEGIN();
 
-    for(const std::shared_ptr<Object> &listener : _currentModule->getObjectHandler().iterator())
+    ObjectHandler& objectHandler = _currentModule->getObjectHandler();
+    for(ObjectRef member : objectHandler.getTeamMembers(pchr->getTeamRef()))
     {
-        if ( pchr->getTeam() != listener->getTeam() ) continue;
+        Object *listener = objectHandler.get(member);
+        if ( nullptr == listener || listener->isTerminated() ) continue;
 
         if ( !listener->isAlive() )
         {
@@ -2193,7 +2195,7 @@ uint8_t scr_SpawnParticle( script_state_t& state, ai_state_t& self )
                                                    Facing(uint16_t(pchr->ori.facing_z)), 
                                                    ObjectProfileRef(pchr->getProfileID()),
                                                    LocalParticleProfileRef(state.argument), self.getSelf(),
-                                                   state.distance, pchr->team, ichr, ParticleRef::Invalid, 0,
+                                                   state.distance, pchr->getTeamRef(), ichr, ParticleRef::Invalid, 0,
                                                    ObjectRef::Invalid );
 
     returncode = (particle != nullptr);
@@ -3710,7 +3712,7 @@ uint8_t scr_IfHoldingRangedWeapon( script_state_t& state, ai_state_t& self )
     }
 
     //50% chance to check left hand even though we have already found one in our right hand
-    if ( !returncode || Random::nextBool() )
+    if ( !returncode || Random::get(Random::Stream::Scripts).nextBool() )
     {
         // Check left hand
         const std::shared_ptr<Object> &leftHandItem = _currentModule->getObjectHandler()[pchr->holdingwhich[SLOT_LEFT]];
@@ -4031,7 +4033,7 @@ uint8_t scr_SpawnAttachedParticle( script_state_t& state, ai_state_t& self )
 
     returncode = nullptr != ParticleHandler::get().spawnLocalParticle(pchr->getPosition(), Facing(uint16_t(pchr->ori.facing_z)), ObjectProfileRef(pchr->getProfileID()),
                                                                       LocalParticleProfileRef(state.argument), self.getSelf(),
-                                                                      state.distance, pchr->team, iself, ParticleRef::Invalid, 0,
+                                                                      state.distance, pchr->getTeamRef(), iself, ParticleRef::Invalid, 0,
                                                                       ObjectRef::Invalid);
     SCRIPT_FUNCTION_END();
 }
@@ -4062,7 +4064,7 @@ uint8_t scr_SpawnExactParticle( script_state_t& state, ai_state_t& self )
 
         returncode = nullptr != ParticleHandler::get().spawnLocalParticle(vtmp, Facing(uint16_t(pchr->ori.facing_z)), ObjectProfileRef(pchr->getProfileID()),
                                                                           LocalParticleProfileRef(state.argument),
-                                                                          ObjectRef::Invalid, 0, pchr->team, ichr,
+                                                                          ObjectRef::Invalid, 0, pchr->getTeamRef(), ichr,
                                                                           ParticleRef::Invalid, 0, ObjectRef::Invalid);
     }
 
@@ -4547,7 +4549,7 @@ uint8_t scr_SpawnAttachedSizedParticle( script_state_t& state, ai_state_t& self
 
     std::shared_ptr<Ego::Particle> particle = ParticleHandler::get().spawnLocalParticle(pchr->getPosition(), Facing(uint16_t(pchr->ori.facing_z)), 
                                                                                         ObjectProfileRef(pchr->getProfileID()), LocalParticleProfileRef(state.argument), self.getSelf(),
-                                                                                        state.distance, pchr->team, ichr, ParticleRef::Invalid, 0,
+                                                                                        state.distance, pchr->getTeamRef(), ichr, ParticleRef::Invalid, 0,
                                                                                         ObjectRef::Invalid);
 
     returncode = (particle != nullptr);
@@ -4657,7 +4659,7 @@ uint8_t scr_SpawnAttachedFacedParticle( script_state_t& state, ai_state_t& self
 
     returncode = nullptr != ParticleHandler::get().spawnLocalParticle(pchr->getPosition(), Facing(Ego::Math::clipBits<16>( state.turn )),
                                                                       ObjectProfileRef(pchr->getProfileID()), LocalParticleProfileRef(state.argument),
-                                                                      self.getSelf(), state.distance, pchr->team, ichr, ParticleRef::Invalid,
+                                                                      self.getSelf(), state.distance, pchr->getTeamRef(), ichr, ParticleRef::Invalid,
                                                                       0, ObjectRef::Invalid);
 
     SCRIPT_FUNCTION_END();
@@ -4988,7 +4990,7 @@ uint8_t scr_SpawnAttachedHolderParticle( script_state_t& state, ai_state_t& self
 
     returncode = nullptr != ParticleHandler::get().spawnLocalParticle(pchr->getPosition(), Facing(uint16_t(pchr->ori.facing_z)), ObjectProfileRef(pchr->getProfileID()),
                                                                       LocalParticleProfileRef(state.argument), ichr,
-                                                                      state.distance, pchr->team, ichr, ParticleRef::Invalid, 0,
+                                                                      state.distance, pchr->getTeamRef(), ichr, ParticleRef::Invalid, 0,
                                                                       ObjectRef::Invalid);
 
     SCRIPT_FUNCTION_END();
@@ -5129,12 +5131,12 @@ uint8_t scr_CorrectActionForHand( script_state_t& state, ai_state_t& self )
         if ( pchr->inwhich_slot == SLOT_LEFT )
         {
             // A or B
-            state.argument += Random::next(1);
+            state.argument += Random::get(Random::Stream::Scripts).next(1);
         }
         else
         {
             // C or D
-            state.argument += 2 + Random::next(1);
+            state.argument += 2 + Random::get(Random::Stream::Scripts).next(1);
         }
     }
 
@@ -5361,7 +5363,7 @@ uint8_t scr_SpawnCharacterXYZ( script_state_t& state, ai_state_t& self )
 
 	Vector3f pos = Vector3f(float(state.x), float(state.y), float(state.distance));
 
-    std::shared_ptr<Object> pchild = _currentModule->spawnObject( pos, pchr->getProfileID(), pchr->team, 0, Facing(Ego::Math::clipBits<16>( state.turn )), "", ObjectRef::Invalid );
+    std::shared_ptr<Object> pchild = _currentModule->spawnObject( pos, pchr->getProfileID(), pchr->getTeamRef(), 0, Facing(Ego::Math::clipBits<16>( state.turn )), "", ObjectRef::Invalid );
     if (pchild == nullptr)
     {
 		Log::get() << Log::Entry::create(Log::Level::Warning, __FILE__, __LINE__, "object ", "`", pchr->getName(), "`", " failed to spawn a copy of itself", Log::EndOfEntry );
@@ -5403,7 +5405,7 @@ uint8_t scr_SpawnExactCharacterXYZ( script_state_t& state, ai_state_t& self )
             Ego::Script::Interpreter::safeCast<float>(state.distance)
         );
 
-    const std::shared_ptr<Object> pchild = _currentModule->spawnObject(pos, ObjectProfileRef(static_cast<PRO_REF>(state.argument)), pchr->team, 0, Facing(Ego::Math::clipBits<16>(state.turn)), "", ObjectRef::Invalid);
+    const std::shared_ptr<Object> pchild = _currentModule->spawnObject(pos, ObjectProfileRef(static_cast<PRO_REF>(state.argument)), pchr->getTeamRef(), 0, Facing(Ego::Math::clipBits<16>(state.turn)), "", ObjectRef::Invalid);
 
     if ( !pchild )
     {
@@ -5503,7 +5505,7 @@ uint8_t scr_SpawnExactChaseParticle( script_state_t& state, ai_state_t& self )
 
         particle = ParticleHandler::get().spawnLocalParticle(vtmp, Facing(uint16_t(pchr->ori.facing_z)), ObjectProfileRef(pchr->getProfileID()),
                                                              LocalParticleProfileRef(state.argument),
-                                                             ObjectRef::Invalid, 0, pchr->team, ichr, ParticleRef::Invalid,
+                                                             ObjectRef::Invalid, 0, pchr->getTeamRef(), ichr, ParticleRef::Invalid,
                                                              0, ObjectRef::Invalid);
     }
 
@@ -5855,6 +5857,7 @@ uint8_t scr_NotAnItem( script_state_t& state, ai_state_t& self )
     SCRIPT_FUNCTION_BEGIN();
 
     pchr->isitem = false;
+    _currentModule->getObjectHandler().updateCategories(*pchr);
 
     SCRIPT_FUNCTION_END();
 }
@@ -6676,7 +6679,7 @@ uint8_t scr_SpawnExactParticleEndSpawn( script_state_t& state, ai_state_t& self
 
         particle = ParticleHandler::get().spawnLocalParticle(vtmp, Facing(uint16_t(pchr->ori.facing_z)), ObjectProfileRef(pchr->getProfileID()),
                                                              LocalParticleProfileRef(state.argument),
-                                                             ObjectRef::Invalid, 0, pchr->team, ichr, ParticleRef::Invalid,
+                                                             ObjectRef::Invalid, 0, pchr->getTeamRef(), ichr, ParticleRef::Invalid,
                                                              0, ObjectRef::Invalid);
     }
 
@@ -6719,18 +6722,18 @@ uint8_t scr_SpawnPoofSpeedSpacingDamage( script_state_t& state, ai_state_t& self
         for (int cnt = 0; cnt < pchr->getProfile()->getParticlePoofAmount(); cnt++)
         {
             auto poofParticle = ParticleHandler::get().spawnParticle(pchr->getOldPosition(), facing_z, pchr->getProfile()->getSlotNumber(), ipip,
-                                                                     ObjectRef::Invalid, GRIP_LAST, pchr->team, pchr->ai.owner, ParticleRef::Invalid, cnt);
+                                                                     ObjectRef::Invalid, GRIP_LAST, pchr->getTeamRef(), pchr->ai.owner, ParticleRef::Invalid, cnt);
 
             // set some values
             if(poofParticle) {
 
                 //Add random horizontal velocity offset
-                Vector2f xyVelOffset = Vector2f(velOffsetBase + Random::next(ppip->getSpawnVelocityOffsetXY().rand), velOffsetBase + Random::next(ppip->getSpawnVelocityOffsetXY().rand));
+                Vector2f xyVelOffset = Vector2f(velOffsetBase + Random::get(Random::Stream::Scripts).next(ppip->getSpawnVelocityOffsetXY().rand), velOffsetBase + Random::get(Random::Stream::Scripts).next(ppip->getSpawnVelocityOffsetXY().rand));
                 poofParticle->setVelocity(poofParticle->getVelocity() +
                                           Vector3f(xyVelOffset.x(), xyVelOffset.y(), 0.0f));
 
                 //Add random horizontal position offset
-                Vector2f xyPosOffset = Vector2f(posOffsetBase + Random::next(ppip->getSpawnPositionOffsetXY().rand), posOffsetBase + Random::next(ppip->getSpawnPositionOffsetXY().rand));
+                Vector2f xyPosOffset = Vector2f(posOffsetBase + Random::get(Random::Stream::Scripts).next(ppip->getSpawnPositionOffsetXY().rand), posOffsetBase + Random::get(Random::Stream::Scripts).next(ppip->getSpawnPositionOffsetXY().rand));
                 poofParticle->setPosition(poofParticle->getPosX() + xyPosOffset.x(), poofParticle->getPosY() + xyPosOffset.y(), poofParticle->getPosZ());
 
                 //Adjust damage
@@ -7333,7 +7336,7 @@ uint8_t scr_SpawnAttachedCharacter( script_state_t& state, ai_state_t& self )
 
 	Vector3f pos = Vector3f(float(state.x), float(state.y), float(state.distance));
 
-    std::shared_ptr<Object> pchild = _currentModule->spawnObject(pos, ObjectProfileRef((PRO_REF)state.argument), pchr->team, 0, Facing::FACE_NORTH, "", ObjectRef::Invalid);
+    std::shared_ptr<Object> pchild = _currentModule->spawnObject(pos, ObjectProfileRef((PRO_REF)state.argument), pchr->getTeamRef(), 0, Facing::FACE_NORTH, "", ObjectRef::Invalid);
     returncode = pchild != nullptr;
 
     if ( !returncode )
@@ -501,10 +501,14 @@ ObjectRef FindWeapon( Object * pchr, float max_distance, const IDSZ2& weap_idsz,
     los.z0 = pchr->getPosZ();
     los.stopped_by = pchr->stoppedby;
 
-    for(const std::shared_ptr<Object> &pweapon : _currentModule->getObjectHandler().iterator())
+    ObjectHandler& objectHandler = _currentModule->getObjectHandler();
+    for(ObjectRef item : objectHandler.getCategory(ObjectCategory::Item))
     {
+        Object *pweapon = objectHandler.get(item);
+        if ( nullptr == pweapon || pweapon->isTerminated() ) continue;
+
         //only do items on the ground
-        if ( _currentModule->getObjectHandler().exists( pweapon->attachedto ) || !pweapon->isitem ) continue;
+        if ( objectHandler.exists( pweapon->attachedto ) ) continue;
         const std::shared_ptr<ObjectProfile> &weaponProfile = pweapon->getProfile();
 
         // only target those with a the given IDSZ
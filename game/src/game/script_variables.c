@@ -32,7 +32,7 @@ int32_t load_VARTMPARGUMENT(script_state_t& scriptState, ai_state_t& aiState, Ob
 
 int32_t load_VARRAND(script_state_t& scriptState, ai_state_t& aiState, Object *pobject, Object *ptarget, Object *powner, Object *pleader)
 {
-    return Random::next(std::numeric_limits<uint16_t>::max());
+    return Random::get(Random::Stream::Scripts).next(std::numeric_limits<uint16_t>::max());
 }
 
 int32_t load_VARSELFX(script_state_t& scriptState, ai_state_t& aiState, Object *pobject, Object *ptarget, Object *powner, Object *pleader)
@@ -468,7 +468,7 @@ int32_t load_VARTARGETMAXLIFE(script_state_t& scriptState, ai_state_t& aiState,
 
 int32_t load_VARTARGETTEAM(script_state_t& scriptState, ai_state_t& aiState, Object *pobject, Object *ptarget, Object *powner, Object *pleader)
 {
-    return (nullptr == ptarget) ? 0 : ptarget->team;
+    return (nullptr == ptarget) ? 0 : ptarget->getTeamRef();
 }
 
 int32_t load_VARTARGETARMOR(script_state_t& scriptState, ai_state_t& aiState, Object *pobject, Object *ptarget, Object *powner, Object *pleader)
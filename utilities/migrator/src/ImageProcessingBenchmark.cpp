@@ -0,0 +1,77 @@
+#include "ImageProcessingBenchmark.hpp"
+
+#include "egolib/Image/ImageProcessing.hpp"
+
+namespace Editor {
+namespace Tools {
+
+using namespace Standard;
+using namespace CommandLine;
+
+ImageProcessingBenchmark::ImageProcessingBenchmark(std::shared_ptr<FileSystem> fileSystem)
+    : Tool("ImageProcessingBenchmark", fileSystem)
+{}
+
+ImageProcessingBenchmark::~ImageProcessingBenchmark()
+{}
+
+void ImageProcessingBenchmark::run(const std::vector<std::shared_ptr<Option>>& arguments)
+{
+    if (arguments.size() > 0)
+    {
+        StringBuffer sb;
+        sb << "wrong number of arguments" << EndOfLine;
+        throw RuntimeError(sb.str());
+    }
+    namespace IP = Ego::ImageProcessing;
+    // A 1024 x 1024 image of random pixels.
+    static const size_t width = 1024, height = 1024, repetitions = 20;
+    std::vector<uint32_t> source(width * height), target(width * height);
+    std::mt19937 generator(1);
+    for (auto& pixel : source)
+    {
+        pixel = generator();
+    }
+    const IP::ChannelLayout bgra = {16, 8, 0, 24, true},
+                            rgba = {0, 8, 16, 24, true},
+                            rgb = {0, 8, 16, 0, false};
+
+    // Print the throughput of a kernel in source pixels per second.
+    auto measure = [](const std::string& name, const std::function<void()>& kernel) {
+        auto start = std::chrono::high_resolution_clock::now();
+        for (size_t i = 0; i < repetitions; ++i)
+        {
+            kernel();
+        }
+        auto end = std::chrono::high_resolution_clock::now();
+        const double seconds = std::chrono::duration_cast<std::chrono::duration<double>>(end - start).count();
+        std::cout << "  " << std::left << std::setw(24) << name << std::right << std::setw(8) << std::fixed << std::setprecision(0)
+                  << (width * height * repetitions) / seconds / 1.0e6 << " MPixels/s" << std::endl;
+    };
+    std::cout << "image processing kernels (" << IP::getInstructionSet() << ")" << std::endl;
+    std::fill(source.begin(), source.end(), 0xff000000u);
+    measure("alpha test (opaque)", [&]() { IP::hasNonOpaquePixel(source.data(), width, height, width * 4, 0xff000000u); });
+    for (auto& pixel : source)
+    {
+        pixel = generator();
+    }
+    measure("BGRA to RGBA", [&]() { IP::convert(source.data(), width * 4, bgra, target.data(), width * 4, rgba, 4, width, height); });
+    measure("BGRA to RGB", [&]() { IP::convert(source.data(), width * 4, bgra, target.data(), width * 3, rgb, 3, width, height); });
+    measure("pad 1000 to 1024", [&]() { IP::pad(source.data(), width * 4, 1000, 1000, target.data(), width * 4, width, height, 4); });
+    measure("downsample RGBA", [&]() { IP::downsample(source.data(), width, height, 4, target.data()); });
+    measure("downsample RGB", [&]() { IP::downsample(source.data(), width, height, 3, target.data()); });
+}
+
+const std::string& ImageProcessingBenchmark::getHelp() const
+{
+    static const std::string help = "usage: ego-tools --tool=ImageProcessingBenchmark\n";
+    return help;
+}
+
+std::shared_ptr<Tool> ImageProcessingBenchmarkFactory::create(std::shared_ptr<FileSystem> fileSystem) const
+{
+    return std::make_shared<ImageProcessingBenchmark>(fileSystem);
+}
+
+} // namespace Tools
+} // namespace Editor
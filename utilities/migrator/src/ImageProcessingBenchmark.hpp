@@ -0,0 +1,36 @@
+#pragma once
+
+#include "Tool.hpp"
+
+namespace Editor {
+namespace Tools {
+
+/// @brief Measure the throughput of the image processing kernels.
+class ImageProcessingBenchmark : public Tool
+{
+public:
+    /// @brief Construct this tool.
+    /// @param fileSystem a pointer to the files system
+    ImageProcessingBenchmark(std::shared_ptr<FileSystem> fileSystem);
+
+    /// @brief Destruct this tool.
+    virtual ~ImageProcessingBenchmark();
+
+    /** @copydoc Tool::run */
+    void run(const std::vector<std::shared_ptr<CommandLine::Option>>& arguments) override;
+
+    /** @copydoc Tool:getHelp */
+    const std::string& getHelp() const override;
+
+}; // class ImageProcessingBenchmark
+
+class ImageProcessingBenchmarkFactory : public ToolFactory
+{
+public:
+    /** @copydoc Editor::ToolFactory::create */
+    std::shared_ptr<Tool> create(std::shared_ptr<FileSystem> fileSystem) const override;
+
+}; // class ImageProcessingBenchmarkFactory
+
+} // namespace Tools
+} // namespace Editor
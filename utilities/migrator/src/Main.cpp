@@ -8,7 +8,12 @@
 #include "DataMigrator.hpp"
 #include "EnchantMigrator.hpp"
 #include "EnvironmentMigrator.hpp"
+#include "ImageProcessingBenchmark.hpp"
+#include "MeshCooker.hpp"
+#include "ModulePacker.hpp"
 #include "ScriptMigrator.hpp"
+#include "SlotMapBenchmark.hpp"
+#include "TextureCacheBenchmark.hpp"
 
 int SDL_main(int argc, char **argv) {
 	try {
@@ -21,7 +26,12 @@ int SDL_main(int argc, char **argv) {
         factories.emplace("DataMigrator", make_shared<Editor::Tools::DataMigratorFactory>());
         factories.emplace("EnchantMigrator", make_shared<Editor::Tools::EnchantMigratorFactory>());
         factories.emplace("EnvironmentMigrator", make_shared<Editor::Tools::EnvironmentMigratorFactory>());
+        factories.emplace("ImageProcessingBenchmark", make_shared<Editor::Tools::ImageProcessingBenchmarkFactory>());
+        factories.emplace("MeshCooker", make_shared<Editor::Tools::MeshCookerFactory>());
+        factories.emplace("ModulePacker", make_shared<Editor::Tools::ModulePackerFactory>());
         factories.emplace("ScriptMigrator", make_shared<Editor::Tools::ScriptMigratorFactory>());
+        factories.emplace("SlotMapBenchmark", make_shared<Editor::Tools::SlotMapBenchmarkFactory>());
+        factories.emplace("TextureCacheBenchmark", make_shared<Editor::Tools::TextureCacheBenchmarkFactory>());
 
         // (2) Parse the argument list.
         auto args = CommandLine::parse(argc, argv);
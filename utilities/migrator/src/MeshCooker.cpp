@@ -0,0 +1,145 @@
+#include "MeshCooker.hpp"
+
+#include "Filters.hpp"
+#include "FileSystem.hpp"
+
+#include "egolib/Mesh/CookedMesh.hpp"
+#include "egolib/FileFormats/Globals.hpp"
+
+namespace Editor {
+namespace Tools {
+
+using namespace Standard;
+using namespace CommandLine;
+
+MeshCooker::MeshCooker(std::shared_ptr<FileSystem> fileSystem)
+    : Tool("MeshCooker", fileSystem)
+{}
+
+MeshCooker::~MeshCooker()
+{}
+
+void MeshCooker::run(const std::vector<std::shared_ptr<Option>>& arguments)
+{
+    if (arguments.size() < 1)
+    {
+        StringBuffer sb;
+        sb << "wrong number of arguments" << EndOfLine;
+        throw RuntimeError(sb.str());
+    }
+    std::vector<std::string> values;
+    for (const auto& argument : arguments)
+    {
+        if (argument->getType() != Option::Type::UnnamedValue)
+        {
+            StringBuffer sb;
+            sb << "unrecognized argument" << EndOfLine;
+            throw RuntimeError(sb.str());
+        }
+        values.emplace_back(std::static_pointer_cast<UnnamedValue>(argument)->getValue());
+    }
+    /// @todo Do *not* assume the path is relative. Ensure that it is absolute by a system function.
+    const std::string dataDirectory = getFileSystem()->sanitize(values[0]);
+    if (getFileSystem()->stat(dataDirectory) != FileSystem::PathStat::Directory)
+    {
+        StringBuffer sb;
+        sb << "'" << dataDirectory << "' is not a directory" << EndOfLine;
+        throw RuntimeError(sb.str());
+    }
+
+    // The modules to cook, all modules if none are specified.
+    std::vector<std::string> moduleNames(values.begin() + 1, values.end());
+    if (moduleNames.empty())
+    {
+        std::deque<std::string> queue;
+        getFileSystem()->recurDir(dataDirectory + getFileSystem()->getDirectorySeparator() + "modules", queue);
+        RegexFilter filter("^(?:.*" REGEX_DIRSEP ")?[^/\\\\]+\\.mod$");
+        for (const auto& path : queue)
+        {
+            if (filter(path) && getFileSystem()->stat(path) == FileSystem::PathStat::Directory)
+            {
+                moduleNames.emplace_back(path.substr(path.find_last_of("/\\") + 1));
+            }
+        }
+    }
+
+    // The sources are read through the virtual file system using the same mount points as the game.
+    if (vfs_init(nullptr, nullptr))
+    {
+        StringBuffer sb;
+        sb << "unable to initialize the virtual file system" << EndOfLine;
+        throw RuntimeError(sb.str());
+    }
+    Log::initialize("/debug/log.txt", Log::Level::Warning);
+
+    size_t failures = 0;
+    for (const auto& moduleName : moduleNames)
+    {
+        if (!cook(dataDirectory, moduleName))
+        {
+            failures++;
+        }
+    }
+    if (failures > 0)
+    {
+        StringBuffer sb;
+        sb << "unable to cook " << failures << " of " << moduleNames.size() << " meshes" << EndOfLine;
+        throw RuntimeError(sb.str());
+    }
+}
+
+bool MeshCooker::cook(const std::string& dataDirectory, const std::string& moduleName)
+{
+    const std::string gamedat = "modules" SLASH_STR + moduleName + SLASH_STR "gamedat";
+    // Same order as in the game: The global "basicdat" directory precedes the module directory.
+    vfs_add_mount_point(dataDirectory, Ego::FsPath("basicdat"), Ego::VfsPath("mp_data"), 1);
+    vfs_add_mount_point(dataDirectory, Ego::FsPath(gamedat), Ego::VfsPath("mp_data"), 1);
+
+    bool success = false;
+    map_t map;
+    if (!tile_dictionary_load_vfs("mp_data/fans.txt", tile_dict))
+    {
+        std::cerr << moduleName << ": unable to load fans.txt" << std::endl;
+    }
+    else if (!map.load("mp_data/level.mpd"))
+    {
+        std::cerr << moduleName << ": unable to load level.mpd" << std::endl;
+    }
+    else
+    {
+        const uint32_t sourceStamp = Ego::CookedMesh::stampSources({"mp_data/level.mpd", "mp_data/fans.txt"});
+        auto cooked = Ego::CookedMesh::cook(map, tile_dict, sourceStamp);
+        const std::string target = dataDirectory + SLASH_STR + gamedat + SLASH_STR "level.mpc";
+        if (!cooked)
+        {
+            std::cerr << moduleName << ": unable to cook level.mpd" << std::endl;
+        }
+        else if (!cooked->save(target))
+        {
+            std::cerr << moduleName << ": unable to write '" << target << "'" << std::endl;
+        }
+        else
+        {
+            std::cout << moduleName << ": cooked " << cooked->getTileCount() << " tiles and "
+                      << cooked->getVertexCount() << " vertices into '" << target << "'" << std::endl;
+            success = true;
+        }
+    }
+
+    vfs_remove_mount_point(Ego::VfsPath("mp_data"));
+    return success;
+}
+
+const std::string& MeshCooker::getHelp() const
+{
+    static const std::string help = "usage: ego-tools --tool=MeshCooker <data directory> [<module names>]\n";
+    return help;
+}
+
+std::shared_ptr<Tool> MeshCookerFactory::create(std::shared_ptr<FileSystem> fileSystem) const
+{
+    return std::make_shared<MeshCooker>(fileSystem);
+}
+
+} // namespace Tools
+} // namespace Editor
@@ -0,0 +1,43 @@
+#pragma once
+
+#include "Tool.hpp"
+
+namespace Editor {
+namespace Tools {
+
+/// @brief Cook the <c>level.mpd</c> files of modules into <c>level.mpc</c> files.
+class MeshCooker : public Tool
+{
+public:
+    /// @brief Construct this tool.
+    /// @param fileSystem a pointer to the files system
+    MeshCooker(std::shared_ptr<FileSystem> fileSystem);
+
+    /// @brief Destruct this tool.
+    virtual ~MeshCooker();
+
+    /** @copydoc Tool::run */
+    void run(const std::vector<std::shared_ptr<CommandLine::Option>>& arguments) override;
+
+    /** @copydoc Tool:getHelp */
+    const std::string& getHelp() const override;
+
+private:
+    /// @brief Cook the mesh of a module.
+    /// @param dataDirectory the pathname of the data directory
+    /// @param moduleName the name of the module e.g. <c>adventure.mod</c>
+    /// @return @a true on success, @a false on failure
+    bool cook(const std::string& dataDirectory, const std::string& moduleName);
+
+}; // class MeshCooker
+
+class MeshCookerFactory : public ToolFactory
+{
+public:
+    /** @copydoc Editor::ToolFactory::create */
+    std::shared_ptr<Tool> create(std::shared_ptr<FileSystem> fileSystem) const override;
+
+}; // class MeshCookerFactory
+
+} // namespace Tools
+} // namespace Editor
@@ -0,0 +1,123 @@
+#include "ModulePacker.hpp"
+
+#include "Filters.hpp"
+#include "FileSystem.hpp"
+
+#include "egolib/VFS/VfsArchive.hpp"
+
+namespace Editor {
+namespace Tools {
+
+using namespace Standard;
+using namespace CommandLine;
+
+ModulePacker::ModulePacker(std::shared_ptr<FileSystem> fileSystem)
+    : Tool("ModulePacker", fileSystem)
+{}
+
+ModulePacker::~ModulePacker()
+{}
+
+void ModulePacker::run(const std::vector<std::shared_ptr<Option>>& arguments)
+{
+    if (arguments.size() < 1)
+    {
+        StringBuffer sb;
+        sb << "wrong number of arguments" << EndOfLine;
+        throw RuntimeError(sb.str());
+    }
+    std::vector<std::string> values;
+    for (const auto& argument : arguments)
+    {
+        if (argument->getType() != Option::Type::UnnamedValue)
+        {
+            StringBuffer sb;
+            sb << "unrecognized argument" << EndOfLine;
+            throw RuntimeError(sb.str());
+        }
+        values.emplace_back(std::static_pointer_cast<UnnamedValue>(argument)->getValue());
+    }
+    const std::string dataDirectory = getFileSystem()->sanitize(values[0]);
+    if (getFileSystem()->stat(dataDirectory) != FileSystem::PathStat::Directory)
+    {
+        StringBuffer sb;
+        sb << "'" << dataDirectory << "' is not a directory" << EndOfLine;
+        throw RuntimeError(sb.str());
+    }
+
+    // The modules to pack, all modules if none are specified.
+    std::vector<std::string> moduleNames(values.begin() + 1, values.end());
+    if (moduleNames.empty())
+    {
+        std::deque<std::string> queue;
+        getFileSystem()->recurDir(dataDirectory + getFileSystem()->getDirectorySeparator() + "modules", queue);
+        RegexFilter filter("^(?:.*" REGEX_DIRSEP ")?[^/\\\\]+\\.mod$");
+        for (const auto& path : queue)
+        {
+            if (filter(path) && getFileSystem()->stat(path) == FileSystem::PathStat::Directory)
+            {
+                moduleNames.emplace_back(path.substr(path.find_last_of("/\\") + 1));
+            }
+        }
+    }
+
+    // Errors are logged using the same log as the game.
+    if (vfs_init(nullptr, nullptr))
+    {
+        StringBuffer sb;
+        sb << "unable to initialize the virtual file system" << EndOfLine;
+        throw RuntimeError(sb.str());
+    }
+    Log::initialize("/debug/log.txt", Log::Level::Warning);
+
+    size_t failures = 0;
+    for (const auto& moduleName : moduleNames)
+    {
+        if (!pack(dataDirectory, moduleName))
+        {
+            failures++;
+        }
+    }
+    Log::uninitialize();
+    vfs_exit();
+    if (failures > 0)
+    {
+        StringBuffer sb;
+        sb << "unable to pack " << failures << " of " << moduleNames.size() << " modules" << EndOfLine;
+        throw RuntimeError(sb.str());
+    }
+}
+
+bool ModulePacker::pack(const std::string& dataDirectory, const std::string& moduleName)
+{
+    const std::string source = dataDirectory + SLASH_STR "modules" SLASH_STR + moduleName;
+    const std::string target = source + ".pack";
+    if (!Ego::VfsArchive::pack(source, target))
+    {
+        std::cerr << moduleName << ": unable to write '" << target << "'" << std::endl;
+        return false;
+    }
+    // Read the archive back to ensure the game accepts it.
+    auto archive = Ego::VfsArchive::open(target);
+    if (!archive || !archive->verify())
+    {
+        std::cerr << moduleName << ": '" << target << "' is corrupted" << std::endl;
+        return false;
+    }
+    std::cout << moduleName << ": packed " << archive->getEntryCount() << " files into '" << target << "'" << std::endl;
+    return true;
+}
+
+const std::string& ModulePacker::getHelp() const
+{
+    static const std::string help = "usage: ego-tools --tool=ModulePacker <data directory> [<module names>]\n";
+    return help;
+}
+
+std::shared_ptr<Tool> ModulePackerFactory::create(std::shared_ptr<FileSystem> fileSystem) const
+{
+    return std::make_shared<ModulePacker>(fileSystem);
+}
+
+} // namespace Tools
+} // namespace Editor
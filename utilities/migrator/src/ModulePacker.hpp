@@ -0,0 +1,43 @@
+#pragma once
+
+#include "Tool.hpp"
+
+namespace Editor {
+namespace Tools {
+
+/// @brief Pack the directories of modules into <c>.mod.pack</c> archives which the game mounts in place of the directories.
+class ModulePacker : public Tool
+{
+public:
+    /// @brief Construct this tool.
+    /// @param fileSystem a pointer to the files system
+    ModulePacker(std::shared_ptr<FileSystem> fileSystem);
+
+    /// @brief Destruct this tool.
+    virtual ~ModulePacker();
+
+    /** @copydoc Tool::run */
+    void run(const std::vector<std::shared_ptr<CommandLine::Option>>& arguments) override;
+
+    /** @copydoc Tool:getHelp */
+    const std::string& getHelp() const override;
+
+private:
+    /// @brief Pack the directory of a module.
+    /// @param dataDirectory the pathname of the data directory
+    /// @param moduleName the name of the module e.g. <c>adventure.mod</c>
+    /// @return @a true on success, @a false on failure
+    bool pack(const std::string& dataDirectory, const std::string& moduleName);
+
+}; // class ModulePacker
+
+class ModulePackerFactory : public ToolFactory
+{
+public:
+    /** @copydoc Editor::ToolFactory::create */
+    std::shared_ptr<Tool> create(std::shared_ptr<FileSystem> fileSystem) const override;
+
+}; // class ModulePackerFactory
+
+} // namespace Tools
+} // namespace Editor
@@ -0,0 +1,114 @@
+#include "SlotMapBenchmark.hpp"
+
+#include "egolib/Core/SlotMap.hpp"
+#include <unordered_map>
+
+namespace Editor {
+namespace Tools {
+
+using namespace Standard;
+using namespace CommandLine;
+
+SlotMapBenchmark::SlotMapBenchmark(std::shared_ptr<FileSystem> fileSystem)
+    : Tool("SlotMapBenchmark", fileSystem)
+{}
+
+SlotMapBenchmark::~SlotMapBenchmark()
+{}
+
+void SlotMapBenchmark::run(const std::vector<std::shared_ptr<Option>>& arguments)
+{
+    if (arguments.size() > 0)
+    {
+        StringBuffer sb;
+        sb << "wrong number of arguments" << EndOfLine;
+        throw RuntimeError(sb.str());
+    }
+    using Clock = std::chrono::high_resolution_clock;
+    static const size_t count = 2048, rounds = 200;
+    // Return the time elapsed since the specified point in time in microseconds.
+    auto elapsed = [](Clock::time_point start) {
+        return std::chrono::duration_cast<std::chrono::microseconds>(Clock::now() - start).count();
+    };
+
+    using SlotMap = Ego::Core::SlotMap<std::shared_ptr<int>>;
+    SlotMap slotMap;
+    std::unordered_map<size_t, std::shared_ptr<int>> hashMap;
+    std::vector<SlotMap::Handle> slotHandles;
+    std::vector<size_t> hashHandles;
+    for (size_t i = 0; i < count; ++i)
+    {
+        slotHandles.push_back(slotMap.insert(std::make_shared<int>(static_cast<int>(i))));
+        hashMap[i] = std::make_shared<int>(static_cast<int>(i));
+        hashHandles.push_back(i);
+    }
+
+    // Resolve every reference, as the handlers do when iterating over the objects and particles.
+    size_t slotHits = 0, hashHits = 0;
+    auto start = Clock::now();
+    for (size_t round = 0; round < rounds; ++round)
+    {
+        for (auto handle : slotHandles)
+        {
+            slotHits += (nullptr != slotMap.find(handle)) ? 1 : 0;
+        }
+    }
+    const auto slotLookup = elapsed(start);
+    start = Clock::now();
+    for (size_t round = 0; round < rounds; ++round)
+    {
+        for (auto handle : hashHandles)
+        {
+            hashHits += (hashMap.end() != hashMap.find(handle)) ? 1 : 0;
+        }
+    }
+    const auto hashLookup = elapsed(start);
+
+    // Remove and respawn every other entry, as the particle handler does each frame.
+    size_t next = count;
+    start = Clock::now();
+    for (size_t round = 0; round < rounds; ++round)
+    {
+        for (size_t i = 0; i < count; i += 2)
+        {
+            slotMap.erase(slotHandles[i]);
+            slotHandles[i] = slotMap.insert(std::make_shared<int>(static_cast<int>(i)));
+        }
+    }
+    const auto slotChurn = elapsed(start);
+    start = Clock::now();
+    for (size_t round = 0; round < rounds; ++round)
+    {
+        for (size_t i = 0; i < count; i += 2)
+        {
+            hashMap.erase(hashHandles[i]);
+            hashHandles[i] = next++;
+            hashMap[hashHandles[i]] = std::make_shared<int>(static_cast<int>(i));
+        }
+    }
+    const auto hashChurn = elapsed(start);
+
+    if (slotHits != hashHits || slotMap.size() != hashMap.size())
+    {
+        StringBuffer sb;
+        sb << "slot map and hash map disagree" << EndOfLine;
+        throw RuntimeError(sb.str());
+    }
+    std::cout << count << " entries, " << rounds << " rounds" << std::endl
+              << "  lookup: slot map " << slotLookup << " us, hash map " << hashLookup << " us" << std::endl
+              << "  churn:  slot map " << slotChurn << " us, hash map " << hashChurn << " us" << std::endl;
+}
+
+const std::string& SlotMapBenchmark::getHelp() const
+{
+    static const std::string help = "usage: ego-tools --tool=SlotMapBenchmark\n";
+    return help;
+}
+
+std::shared_ptr<Tool> SlotMapBenchmarkFactory::create(std::shared_ptr<FileSystem> fileSystem) const
+{
+    return std::make_shared<SlotMapBenchmark>(fileSystem);
+}
+
+} // namespace Tools
+} // namespace Editor
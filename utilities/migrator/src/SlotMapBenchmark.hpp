@@ -0,0 +1,36 @@
+#pragma once
+
+#include "Tool.hpp"
+
+namespace Editor {
+namespace Tools {
+
+/// @brief Compare the slot map used by the object and particle handlers with a hash map.
+class SlotMapBenchmark : public Tool
+{
+public:
+    /// @brief Construct this tool.
+    /// @param fileSystem a pointer to the files system
+    SlotMapBenchmark(std::shared_ptr<FileSystem> fileSystem);
+
+    /// @brief Destruct this tool.
+    virtual ~SlotMapBenchmark();
+
+    /** @copydoc Tool::run */
+    void run(const std::vector<std::shared_ptr<CommandLine::Option>>& arguments) override;
+
+    /** @copydoc Tool:getHelp */
+    const std::string& getHelp() const override;
+
+}; // class SlotMapBenchmark
+
+class SlotMapBenchmarkFactory : public ToolFactory
+{
+public:
+    /** @copydoc Editor::ToolFactory::create */
+    std::shared_ptr<Tool> create(std::shared_ptr<FileSystem> fileSystem) const override;
+
+}; // class SlotMapBenchmarkFactory
+
+} // namespace Tools
+} // namespace Editor
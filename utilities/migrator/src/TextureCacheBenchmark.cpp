@@ -0,0 +1,157 @@
+#include "TextureCacheBenchmark.hpp"
+
+#include "FileSystem.hpp"
+
+#include "egolib/Graphics/TextureCache.hpp"
+#include "egolib/Image/ImageManager.hpp"
+#include "egolib/Image/ImageLoader.hpp"
+
+namespace Editor {
+namespace Tools {
+
+using namespace Standard;
+using namespace CommandLine;
+
+TextureCacheBenchmark::TextureCacheBenchmark(std::shared_ptr<FileSystem> fileSystem)
+    : Tool("TextureCacheBenchmark", fileSystem)
+{}
+
+TextureCacheBenchmark::~TextureCacheBenchmark()
+{}
+
+void TextureCacheBenchmark::findImages(const std::string& directory, const std::string& vfsDirectory, std::vector<std::string>& images)
+{
+    std::deque<std::string> queue;
+    getFileSystem()->recurDir(directory, queue);
+    for (const auto& path : queue)
+    {
+        const std::string name = path.substr(path.find_last_of("/\\") + 1);
+        switch (getFileSystem()->stat(path))
+        {
+            case FileSystem::PathStat::Directory:
+                findImages(path, vfsDirectory + "/" + name, images);
+                break;
+            case FileSystem::PathStat::File:
+            {
+                const size_t dot = name.find_last_of('.');
+                if (std::string::npos == dot)
+                {
+                    break;
+                }
+                const std::string extension = name.substr(dot);
+                for (const auto& loader : Ego::ImageManager::get())
+                {
+                    if (loader.getExtensions().count(extension))
+                    {
+                        images.emplace_back(vfsDirectory + "/" + name);
+                        break;
+                    }
+                }
+            }
+            break;
+            default:
+                break;
+        };
+    }
+}
+
+void TextureCacheBenchmark::run(const std::vector<std::shared_ptr<Option>>& arguments)
+{
+    if (arguments.size() != 3)
+    {
+        StringBuffer sb;
+        sb << "wrong number of arguments" << EndOfLine;
+        throw RuntimeError(sb.str());
+    }
+    std::vector<std::string> values;
+    for (const auto& argument : arguments)
+    {
+        if (argument->getType() != Option::Type::UnnamedValue)
+        {
+            StringBuffer sb;
+            sb << "unrecognized argument" << EndOfLine;
+            throw RuntimeError(sb.str());
+        }
+        values.emplace_back(std::static_pointer_cast<UnnamedValue>(argument)->getValue());
+    }
+    /// @todo Do *not* assume the path is relative. Ensure that it is absolute by a system function.
+    const std::string dataDirectory = getFileSystem()->sanitize(values[0]);
+    const std::string moduleName = values[1];
+    const std::string cacheDirectory = getFileSystem()->sanitize(values[2]);
+    const std::string moduleDirectory = "modules" SLASH_STR + moduleName;
+    if (getFileSystem()->stat(dataDirectory + SLASH_STR + moduleDirectory) != FileSystem::PathStat::Directory)
+    {
+        StringBuffer sb;
+        sb << "'" << dataDirectory + SLASH_STR + moduleDirectory << "' is not a directory" << EndOfLine;
+        throw RuntimeError(sb.str());
+    }
+
+    // The images are read through the virtual file system like in the game.
+    if (vfs_init(nullptr, nullptr))
+    {
+        StringBuffer sb;
+        sb << "unable to initialize the virtual file system" << EndOfLine;
+        throw RuntimeError(sb.str());
+    }
+    Log::initialize("/debug/log.txt", Log::Level::Warning);
+    Ego::ImageManager::initialize();
+    vfs_add_mount_point(dataDirectory, Ego::FsPath(moduleDirectory), Ego::VfsPath("mp_module"), 1);
+
+    std::vector<std::string> images;
+    findImages(dataDirectory + SLASH_STR + moduleDirectory, "mp_module", images);
+
+    // Load all images of the module through a texture cache, return the time in milliseconds.
+    auto loadAll = [&images](Ego::TextureCache& cache, size_t& failures) {
+        failures = 0;
+        auto start = std::chrono::high_resolution_clock::now();
+        for (const auto& image : images)
+        {
+            const std::string extension = image.substr(image.find_last_of('.'));
+            const auto it = Ego::ImageManager::get().find({extension});
+            if (it == Ego::ImageManager::get().end() || !cache.get(image, *it))
+            {
+                failures++;
+            }
+        }
+        auto end = std::chrono::high_resolution_clock::now();
+        return std::chrono::duration_cast<std::chrono::duration<double, std::milli>>(end - start).count();
+    };
+
+    size_t failures;
+    // Cold: Decode, convert and generate mipmaps, nothing is stored.
+    Ego::TextureCache uncached("", Ego::TextureCache::DefaultCapacity);
+    const double cold = loadAll(uncached, failures);
+    // Populate the cache directory, starting from an empty directory such that every image is cooked.
+    fs_removeDirectoryAndContents(cacheDirectory.c_str(), 1);
+    Ego::TextureCache populate(cacheDirectory, Ego::TextureCache::DefaultCapacity);
+    const double populating = loadAll(populate, failures);
+    // Warm: Map the cooked textures.
+    Ego::TextureCache cached(cacheDirectory, Ego::TextureCache::DefaultCapacity);
+    const double warm = loadAll(cached, failures);
+
+    std::cout << moduleName << ": " << images.size() << " images, " << failures << " failures" << std::endl
+              << "  cold (decode, convert, mipmaps): " << cold << " ms" << std::endl
+              << "  populating the cache:            " << populating << " ms (" << populate.getMissCount() << " cooked)" << std::endl
+              << "  warm (cooked textures):          " << warm << " ms (" << cached.getHitCount() << " hits, "
+              << cached.getMissCount() << " misses)" << std::endl;
+
+    vfs_remove_mount_point(Ego::VfsPath("mp_module"));
+    Ego::ImageManager::uninitialize();
+    Log::uninitialize();
+    vfs_exit();
+}
+
+const std::string& TextureCacheBenchmark::getHelp() const
+{
+    static const std::string help = "usage: ego-tools --tool=TextureCacheBenchmark <data directory> <module name> <cache directory>\n"
+                                    "  The times exclude the upload of the textures to the renderer.\n";
+    return help;
+}
+
+std::shared_ptr<Tool> TextureCacheBenchmarkFactory::create(std::shared_ptr<FileSystem> fileSystem) const
+{
+    return std::make_shared<TextureCacheBenchmark>(fileSystem);
+}
+
+} // namespace Tools
+} // namespace Editor
@@ -0,0 +1,43 @@
+#pragma once
+
+#include "Tool.hpp"
+
+namespace Editor {
+namespace Tools {
+
+/// @brief Measure the time to load the images of a module with and without the texture cache.
+class TextureCacheBenchmark : public Tool
+{
+public:
+    /// @brief Construct this tool.
+    /// @param fileSystem a pointer to the files system
+    TextureCacheBenchmark(std::shared_ptr<FileSystem> fileSystem);
+
+    /// @brief Destruct this tool.
+    virtual ~TextureCacheBenchmark();
+
+    /** @copydoc Tool::run */
+    void run(const std::vector<std::shared_ptr<CommandLine::Option>>& arguments) override;
+
+    /** @copydoc Tool:getHelp */
+    const std::string& getHelp() const override;
+
+private:
+    /// @brief Get the VFS pathnames of the images in a directory and its subdirectories.
+    /// @param directory the pathname of the directory
+    /// @param vfsDirectory the VFS pathname of the directory
+    /// @param [out] images the VFS pathnames of the images
+    void findImages(const std::string& directory, const std::string& vfsDirectory, std::vector<std::string>& images);
+
+}; // class TextureCacheBenchmark
+
+class TextureCacheBenchmarkFactory : public ToolFactory
+{
+public:
+    /** @copydoc Editor::ToolFactory::create */
+    std::shared_ptr<Tool> create(std::shared_ptr<FileSystem> fileSystem) const override;
+
+}; // class TextureCacheBenchmarkFactory
+
+} // namespace Tools
+} // namespace Editor